@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// 世代番号付きのハンドルで要素を引くコンテナ
+/// 要素は隙間なく配列に詰めて持つので、全要素の走査は配列をなめるだけで済む
+/// 追加・削除・ハンドルからの取得はすべてO(1)（削除は最後の要素を空いた位置へ移す）
+/// 削除したスロットは世代番号を進めてから使い回すので、削除済みの要素を指す古いハンドルはGetでnullptrになり、
+/// IsStaleで「削除済みのものを使おうとした」と判別できる
+/// 要素は削除や追加で配列内の位置が変わるので、ポインタを持ち続ける場合は要素をunique_ptrなどにする
+/// </summary>
+template<typename T>
+class SlotMap {
+public:
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	/// <summary>
+	/// 要素のハンドル（スロットの番号と、その時の世代番号）
+	/// </summary>
+	struct Handle {
+		uint32_t index = kInvalidIndex;
+		uint32_t generation = 0;	// 0は使わない（既定値のハンドルがどの要素にも一致しないように）
+
+		constexpr bool IsValid() const { return index != kInvalidIndex; }
+		constexpr bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		constexpr bool operator!=(const Handle& other) const { return !(*this == other); }
+	};
+
+	/// <summary>
+	/// 要素を追加
+	/// </summary>
+	/// <returns>追加した要素のハンドル</returns>
+	Handle Insert(T value) {
+		uint32_t slotIndex = freeHead_;
+		if (slotIndex != kInvalidIndex) {
+			// 空いているスロットを使い回す（世代番号は削除した時に進めてある）
+			freeHead_ = slots_[slotIndex].nextFree;
+		} else {
+			slotIndex = static_cast<uint32_t>(slots_.size());
+			slots_.push_back({});
+		}
+
+		Slot& slot = slots_[slotIndex];
+		slot.denseIndex = static_cast<uint32_t>(values_.size());
+		slot.nextFree = kInvalidIndex;
+		values_.push_back(std::move(value));
+		denseToSlot_.push_back(slotIndex);
+		return { slotIndex, slot.generation };
+	}
+
+	/// <summary>
+	/// 要素を削除
+	/// </summary>
+	/// <returns>削除したかどうか（無効・削除済みのハンドルならfalse）</returns>
+	bool Erase(Handle handle) {
+		if (!Contains(handle)) {
+			return false;
+		}
+
+		// 最後の要素を空いた位置へ移して詰める
+		Slot& slot = slots_[handle.index];
+		const uint32_t denseIndex = slot.denseIndex;
+		const uint32_t lastIndex = static_cast<uint32_t>(values_.size() - 1);
+		if (denseIndex != lastIndex) {
+			values_[denseIndex] = std::move(values_[lastIndex]);
+			denseToSlot_[denseIndex] = denseToSlot_[lastIndex];
+			slots_[denseToSlot_[denseIndex]].denseIndex = denseIndex;
+		}
+		values_.pop_back();
+		denseToSlot_.pop_back();
+
+		// 世代を進めて空きリストへ
+		ReleaseSlot(handle.index);
+		return true;
+	}
+
+	/// <summary>
+	/// 全ての要素を削除（今までのハンドルは全て古いものになる）
+	/// </summary>
+	void Clear() {
+		for (uint32_t slotIndex : denseToSlot_) {
+			ReleaseSlot(slotIndex);
+		}
+		values_.clear();
+		denseToSlot_.clear();
+	}
+
+	/// <summary>
+	/// ハンドルから要素を取得（無効・削除済みならnullptr）
+	/// </summary>
+	T* Get(Handle handle) {
+		return Contains(handle) ? &values_[slots_[handle.index].denseIndex] : nullptr;
+	}
+	const T* Get(Handle handle) const {
+		return Contains(handle) ? &values_[slots_[handle.index].denseIndex] : nullptr;
+	}
+
+	/// <summary>
+	/// ハンドルが今ある要素を指しているか
+	/// </summary>
+	bool Contains(Handle handle) const {
+		return handle.index < slots_.size() &&
+			slots_[handle.index].generation == handle.generation &&
+			slots_[handle.index].denseIndex != kInvalidIndex;
+	}
+
+	/// <summary>
+	/// 削除済みの要素を指すハンドルか（一度は有効だったが、今は別の世代になっている）
+	/// </summary>
+	bool IsStale(Handle handle) const {
+		return handle.IsValid() && handle.generation != 0 && !Contains(handle);
+	}
+
+	/// <summary>
+	/// 詰めた配列の位置から、その要素のハンドルを取得
+	/// </summary>
+	Handle GetHandle(size_t denseIndex) const {
+		const uint32_t slotIndex = denseToSlot_[denseIndex];
+		return { slotIndex, slots_[slotIndex].generation };
+	}
+
+	// 要素数
+	size_t GetSize() const { return values_.size(); }
+	bool IsEmpty() const { return values_.empty(); }
+
+	// 詰めた配列のまま走査する（順番は追加・削除で入れ替わる）
+	typename std::vector<T>::iterator begin() { return values_.begin(); }
+	typename std::vector<T>::iterator end() { return values_.end(); }
+	typename std::vector<T>::const_iterator begin() const { return values_.begin(); }
+	typename std::vector<T>::const_iterator end() const { return values_.end(); }
+
+private:
+	struct Slot {
+		uint32_t denseIndex = kInvalidIndex;	// values_での位置（空きならkInvalidIndex）
+		uint32_t generation = 1;				// 今の世代
+		uint32_t nextFree = kInvalidIndex;		// 空きリストの次のスロット
+	};
+
+	/// <summary>
+	/// スロットの世代を進めて空きリストに戻す
+	/// </summary>
+	void ReleaseSlot(uint32_t slotIndex) {
+		Slot& slot = slots_[slotIndex];
+		slot.denseIndex = kInvalidIndex;
+		// 一周したら0を飛ばす
+		if (++slot.generation == 0) {
+			slot.generation = 1;
+		}
+		slot.nextFree = freeHead_;
+		freeHead_ = slotIndex;
+	}
+
+private:
+	std::vector<Slot> slots_;
+	std::vector<T> values_;				// 要素（隙間なく詰める）
+	std::vector<uint32_t> denseToSlot_;	// values_の位置 → スロット
+	uint32_t freeHead_ = kInvalidIndex;	// 空きリストの先頭
+};
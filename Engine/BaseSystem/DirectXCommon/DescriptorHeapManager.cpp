@@ -11,42 +11,56 @@ void DescriptorHeapManager::Initialize(Microsoft::WRL::ComPtr<ID3D12Device> devi
 	// ディスクリプタヒープを作成
 	rtvHeap_ = CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, GraphicsConfig::kRTVHeapSize, false);
 	dsvHeap_ = CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, GraphicsConfig::kDSVHeapSize, false);
-	srvHeap_ = CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, GraphicsConfig::kSRVHeapSize, true);
+	// SRVヒープは後ろに1フレームだけ使うリングの分を足して作る
+	srvHeap_ = CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, GraphicsConfig::kSRVHeapSize + GraphicsConfig::kTransientSRVCount, true);
+	stagingSrvHeap_ = CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, GraphicsConfig::kStagingSRVHeapSize, false);
 
 
-	// 使用状況管理配列を初期化(生成したヒープの大きさだけフラグの数を持っておく)
-	rtvUsedFlags_.resize(GraphicsConfig::kRTVHeapSize, false);
-	dsvUsedFlags_.resize(GraphicsConfig::kDSVHeapSize, false);
-	srvUsedFlags_.resize(GraphicsConfig::kSRVHeapSize, false);
+	// 使用状況を初期化(生成したヒープの大きさだけインデックスを管理する)
+	rtvAllocator_.Initialize(GraphicsConfig::kRTVHeapSize);
+	dsvAllocator_.Initialize(GraphicsConfig::kDSVHeapSize);
+	srvAllocator_.Initialize(GraphicsConfig::kSRVHeapSize);
+	stagingSrvAllocator_.Initialize(GraphicsConfig::kStagingSRVHeapSize);
+	transientSrvAllocator_.Initialize(GraphicsConfig::kTransientSRVCount);
 
-	// 予約済みのもののUsedFlagを立てておく
+	// 予約済みのものを使用中にしておく
 	// スワップチェーンRTVを予約
-	rtvUsedFlags_[GraphicsConfig::kSwapChainRTV0Index] = true;
-	rtvUsedFlags_[GraphicsConfig::kSwapChainRTV1Index] = true;
+	rtvAllocator_.Reserve(GraphicsConfig::kSwapChainRTV0Index);
+	rtvAllocator_.Reserve(GraphicsConfig::kSwapChainRTV1Index);
 
 	// メインDSVを予約
-	dsvUsedFlags_[GraphicsConfig::kMainDSVIndex] = true;
+	dsvAllocator_.Reserve(GraphicsConfig::kMainDSVIndex);
 
 	// ImGui用SRVを予約
-	srvUsedFlags_[GraphicsConfig::kImGuiSRVIndex] = true;
+	srvAllocator_.Reserve(GraphicsConfig::kImGuiSRVIndex);
 
 	isInitialized_ = true;
 
+	// 使い続ける範囲を全てnullのSRVで埋めておく（ヒープ全体を1つのテーブルで渡すバインドレス描画では、
+	// 未使用のスロットも初期化済みである必要がある）
+	for (uint32_t index = 0; index < GraphicsConfig::kSRVHeapSize; ++index) {
+		WriteNullSRV(index);
+	}
+
 	Logger::Log(Logger::GetStream(), "DescriptorHeapManager initialized successfully!\n");
-	Logger::Log(Logger::GetStream(), std::format("RTV Heap Size: {}, DSV Heap Size: {}, SRV Heap Size: {}\n",
-		GraphicsConfig::kRTVHeapSize, GraphicsConfig::kDSVHeapSize, GraphicsConfig::kSRVHeapSize));
+	Logger::Log(Logger::GetStream(), std::format("RTV Heap Size: {}, DSV Heap Size: {}, SRV Heap Size: {} (+{} transient), Staging SRV Heap Size: {}\n",
+		GraphicsConfig::kRTVHeapSize, GraphicsConfig::kDSVHeapSize, GraphicsConfig::kSRVHeapSize,
+		GraphicsConfig::kTransientSRVCount, GraphicsConfig::kStagingSRVHeapSize));
 }
 
 void DescriptorHeapManager::Finalize() {
 	// 使用状況をクリア
-	rtvUsedFlags_.clear();
-	dsvUsedFlags_.clear();
-	srvUsedFlags_.clear();
+	rtvAllocator_.Finalize();
+	dsvAllocator_.Finalize();
+	srvAllocator_.Finalize();
+	stagingSrvAllocator_.Finalize();
+	transientSrvAllocator_.Finalize();
 
 	// ヒープをクリア（ComPtrが自動で解放）
 	rtvHeap_.Reset();
 	dsvHeap_.Reset();
 	srvHeap_.Reset();
+	stagingSrvHeap_.Reset();
 
 	device_.Reset();
 	isInitialized_ = false;
@@ -64,63 +78,80 @@ void DescriptorHeapManager::Finalize() {
 
 DescriptorHeapManager::DescriptorHandle DescriptorHeapManager::AllocateRTV() {
 	assert(isInitialized_);
-	///あいているインデックスを探す
-	auto indexOpt = FindAvailableIndex(rtvUsedFlags_);
-	if (!indexOpt.has_value()) {
+	///あいているインデックスを割り当てる
+	uint32_t index = rtvAllocator_.Allocate();
+	if (index == DescriptorIndexAllocator::kInvalidIndex) {
 		// 空きがない場合はログを出力
 		Logger::Log(Logger::GetStream(), "Failed to allocate RTV: No available slots\n");
 		return DescriptorHandle{};
 	}
 
-	uint32_t index = indexOpt.value();
-	rtvUsedFlags_[index] = true;	//空きが見つかればそこの使用フラグを立てる
-
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::RTV, index);
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {}; // RTVはGPUハンドル不要
 
 	// 生成できたとログを出力
-	Logger::Log(Logger::GetStream(), std::format("Allocated RTV at index: {}\n", index));
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Allocated RTV at index: {}\n", index));
+	}
 	return DescriptorHandle(cpuHandle, gpuHandle, index);
 }
 
 DescriptorHeapManager::DescriptorHandle DescriptorHeapManager::AllocateDSV() {
 	assert(isInitialized_);
-	///あいているインデックスを探す
-	auto indexOpt = FindAvailableIndex(dsvUsedFlags_);
-	if (!indexOpt.has_value()) {
+	///あいているインデックスを割り当てる
+	uint32_t index = dsvAllocator_.Allocate();
+	if (index == DescriptorIndexAllocator::kInvalidIndex) {
 		// 空きがない場合はログを出力
 		Logger::Log(Logger::GetStream(), "Failed to allocate DSV: No available slots\n");
 		return DescriptorHandle{};
 	}
 
-	uint32_t index = indexOpt.value();
-	dsvUsedFlags_[index] = true;//空きが見つかればそこの使用フラグを立てる
-
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::DSV, index);
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {}; // DSVはGPUハンドル不要
 
 	// 生成できたとログを出力
-	Logger::Log(Logger::GetStream(), std::format("Allocated DSV at index: {}\n", index));
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Allocated DSV at index: {}\n", index));
+	}
 	return DescriptorHandle(cpuHandle, gpuHandle, index);
 }
 
 DescriptorHeapManager::DescriptorHandle DescriptorHeapManager::AllocateSRV() {
 	assert(isInitialized_);
-	///あいているインデックスを探す
-	auto indexOpt = FindAvailableIndex(srvUsedFlags_);
-	if (!indexOpt.has_value()) {
+	///あいているインデックスを割り当てる
+	uint32_t index = srvAllocator_.Allocate();
+	if (index == DescriptorIndexAllocator::kInvalidIndex) {
 		// 空きがない場合はログを出力
 		Logger::Log(Logger::GetStream(), "Failed to allocate SRV: No available slots\n");
 		return DescriptorHandle{};
 	}
 
-	uint32_t index = indexOpt.value();
-	srvUsedFlags_[index] = true;//空きが見つかればそこの使用フラグを立てる
-
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::SRV, index);
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = GetGPUHandle(HeapType::SRV, index);
 	// 生成できたとログを出力
-	Logger::Log(Logger::GetStream(), std::format("Allocated SRV at index: {}\n", index));
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Allocated SRV at index: {}\n", index));
+	}
+	return DescriptorHandle(cpuHandle, gpuHandle, index);
+}
+
+DescriptorHeapManager::DescriptorHandle DescriptorHeapManager::AllocateStagingSRV() {
+	assert(isInitialized_);
+	///あいているインデックスを割り当てる
+	uint32_t index = stagingSrvAllocator_.Allocate();
+	if (index == DescriptorIndexAllocator::kInvalidIndex) {
+		// 空きがない場合はログを出力
+		Logger::Log(Logger::GetStream(), "Failed to allocate staging SRV: No available slots\n");
+		return DescriptorHandle{};
+	}
+
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::StagingSRV, index);
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {}; // シェーダーから見えないのでGPUハンドルはなし
+
+	// 生成できたとログを出力
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Allocated staging SRV at index: {}\n", index));
+	}
 	return DescriptorHandle(cpuHandle, gpuHandle, index);
 }
 
@@ -133,15 +164,17 @@ void DescriptorHeapManager::ReleaseRTV(uint32_t index) {
 		return;
 	}
 
-	if (!rtvUsedFlags_[index]) {
+	if (!rtvAllocator_.IsUsed(index)) {
 		// 既に解放されている場合は警告を出力
 		Logger::Log(Logger::GetStream(), std::format("Warning: RTV index {} is already released\n", index));
 		return;
 	}
 
 	// 実際の解放処理
-	rtvUsedFlags_[index] = false;
-	Logger::Log(Logger::GetStream(), std::format("Released RTV at index: {}\n", index));
+	rtvAllocator_.Release(index);
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Released RTV at index: {}\n", index));
+	}
 }
 
 void DescriptorHeapManager::ReleaseDSV(uint32_t index) {
@@ -153,15 +186,17 @@ void DescriptorHeapManager::ReleaseDSV(uint32_t index) {
 		return;
 	}
 
-	if (!dsvUsedFlags_[index]) {
+	if (!dsvAllocator_.IsUsed(index)) {
 		// 既に解放されている場合は警告を出力
 		Logger::Log(Logger::GetStream(), std::format("Warning: DSV index {} is already released\n", index));
 		return;
 	}
 
 	// 実際の解放処理
-	dsvUsedFlags_[index] = false;
-	Logger::Log(Logger::GetStream(), std::format("Released DSV at index: {}\n", index));
+	dsvAllocator_.Release(index);
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Released DSV at index: {}\n", index));
+	}
 }
 
 void DescriptorHeapManager::ReleaseSRV(uint32_t index) {
@@ -174,14 +209,95 @@ void DescriptorHeapManager::ReleaseSRV(uint32_t index) {
 	}
 	
 	// 既に解放されている場合は警告を出力
-	if (!srvUsedFlags_[index]) {
+	if (!srvAllocator_.IsUsed(index)) {
 		Logger::Log(Logger::GetStream(), std::format("Warning: SRV index {} is already released\n", index));
 		return;
 	}
 
 	// 実際の解放処理
-	srvUsedFlags_[index] = false;
-	Logger::Log(Logger::GetStream(), std::format("Released SRV at index: {}\n", index));
+	// 解放したリソースを指したままにしないよう、nullのSRVに戻しておく
+	WriteNullSRV(index);
+	srvAllocator_.Release(index);
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Released SRV at index: {}\n", index));
+	}
+}
+
+
+void DescriptorHeapManager::ReleaseStagingSRV(uint32_t index) {
+	assert(isInitialized_);
+
+	// 無効なインデックスの場合はログを出力
+	if (!IsValidIndex(HeapType::StagingSRV, index)) {
+		Logger::Log(Logger::GetStream(), std::format("Invalid staging SRV index for release: {}\n", index));
+		return;
+	}
+
+	// 既に解放されている場合は警告を出力
+	if (!stagingSrvAllocator_.IsUsed(index)) {
+		Logger::Log(Logger::GetStream(), std::format("Warning: staging SRV index {} is already released\n", index));
+		return;
+	}
+
+	// 実際の解放処理
+	stagingSrvAllocator_.Release(index);
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Released staging SRV at index: {}\n", index));
+	}
+}
+
+
+//																			//
+//						1フレームだけ使うSRV（リング）							//
+//																			//
+
+
+void DescriptorHeapManager::BeginTransientFrame(uint64_t fenceValue) {
+	assert(isInitialized_);
+	transientSrvAllocator_.BeginFrame(fenceValue);
+}
+
+void DescriptorHeapManager::ReclaimTransient(uint64_t completedFenceValue) {
+	assert(isInitialized_);
+	transientSrvAllocator_.Reclaim(completedFenceValue);
+}
+
+DescriptorHeapManager::DescriptorHandle DescriptorHeapManager::AllocateTransientSRV(uint32_t count) {
+	assert(isInitialized_);
+
+	uint32_t offset = transientSrvAllocator_.Allocate(count);
+	if (offset == DescriptorRingAllocator::kInvalidOffset) {
+		// 空きがない場合はログを出力
+		Logger::Log(Logger::GetStream(), std::format("Failed to allocate {} transient SRVs: ring is full ({} / {} in use)\n",
+			count, transientSrvAllocator_.GetUsedCount(), transientSrvAllocator_.GetCapacity()));
+		return DescriptorHandle{};
+	}
+
+	// リングは持ち続けるSRVの後ろにある
+	uint32_t index = GraphicsConfig::kSRVHeapSize + offset;
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = srvHeap_->GetCPUDescriptorHandleForHeapStart();
+	cpuHandle.ptr += (srvDescriptorSize_ * index);
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = srvHeap_->GetGPUDescriptorHandleForHeapStart();
+	gpuHandle.ptr += (srvDescriptorSize_ * index);
+	return DescriptorHandle(cpuHandle, gpuHandle, index);
+}
+
+DescriptorHeapManager::DescriptorHandle DescriptorHeapManager::CopyToTransientSRV(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count) {
+	assert(isInitialized_);
+	assert(sources != nullptr);
+
+	DescriptorHandle table = AllocateTransientSRV(count);
+	if (!table.isValid) {
+		return table;
+	}
+
+	// コピー元はばらばらなので1つずつ、コピー先は連続した範囲に並べる
+	D3D12_CPU_DESCRIPTOR_HANDLE destination = table.cpuHandle;
+	for (uint32_t i = 0; i < count; ++i) {
+		device_->CopyDescriptorsSimple(1, destination, sources[i], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		destination.ptr += srvDescriptorSize_;
+	}
+	return table;
 }
 
 
@@ -199,20 +315,22 @@ std::optional<DescriptorHeapManager::DescriptorHandle> DescriptorHeapManager::Re
 		return std::nullopt;
 	}
 
-	if (rtvUsedFlags_[index]) {
+	if (rtvAllocator_.IsUsed(index)) {
 		// 既に使用中の場合はログを出力
 		Logger::Log(Logger::GetStream(), std::format("RTV index {} is already in use\n", index));
 		return std::nullopt;
 	}
 
-	// 使用フラグを立てる
-	rtvUsedFlags_[index] = true;
+	// 使用中にする
+	rtvAllocator_.Reserve(index);
 
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::RTV, index);
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {};
 
 	// 予約できたとログを出力
-	Logger::Log(Logger::GetStream(), std::format("Reserved RTV at index: {}\n", index));
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Reserved RTV at index: {}\n", index));
+	}
 	return DescriptorHandle(cpuHandle, gpuHandle, index);
 }
 
@@ -225,20 +343,22 @@ std::optional<DescriptorHeapManager::DescriptorHandle> DescriptorHeapManager::Re
 		return std::nullopt;
 	}
 
-	if (dsvUsedFlags_[index]) {
+	if (dsvAllocator_.IsUsed(index)) {
 		// 既に使用中の場合はログを出力
 		Logger::Log(Logger::GetStream(), std::format("DSV index {} is already in use\n", index));
 		return std::nullopt;
 	}
 
-	// 使用フラグを立てる
-	dsvUsedFlags_[index] = true;
+	// 使用中にする
+	dsvAllocator_.Reserve(index);
 
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::DSV, index);
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {};
 
 	// 予約できたとログを出力
-	Logger::Log(Logger::GetStream(), std::format("Reserved DSV at index: {}\n", index));
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Reserved DSV at index: {}\n", index));
+	}
 	return DescriptorHandle(cpuHandle, gpuHandle, index);
 }
 
@@ -250,17 +370,19 @@ std::optional<DescriptorHeapManager::DescriptorHandle> DescriptorHeapManager::Re
 		return std::nullopt;
 	}
 
-	if (srvUsedFlags_[index]) {
+	if (srvAllocator_.IsUsed(index)) {
 		Logger::Log(Logger::GetStream(), std::format("SRV index {} is already in use\n", index));
 		return std::nullopt;
 	}
 
-	srvUsedFlags_[index] = true;
+	srvAllocator_.Reserve(index);
 
 	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = GetCPUHandle(HeapType::SRV, index);
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = GetGPUHandle(HeapType::SRV, index);
 
-	Logger::Log(Logger::GetStream(), std::format("Reserved SRV at index: {}\n", index));
+	if (isLoggingEnabled_) {
+		Logger::Log(Logger::GetStream(), std::format("Reserved SRV at index: {}\n", index));
+	}
 	return DescriptorHandle(cpuHandle, gpuHandle, index);
 }
 
@@ -291,6 +413,11 @@ D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeapManager::GetCPUHandle(HeapType type, u
 		handle = srvHeap_->GetCPUDescriptorHandleForHeapStart();
 		descriptorSize = srvDescriptorSize_;
 		break;
+	case HeapType::StagingSRV:
+		assert(IsValidIndex(type, index));
+		handle = stagingSrvHeap_->GetCPUDescriptorHandleForHeapStart();
+		descriptorSize = srvDescriptorSize_;
+		break;
 	default:
 		assert(false);
 		break;
@@ -315,49 +442,12 @@ D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeapManager::GetGPUHandle(HeapType type, u
 
 uint32_t DescriptorHeapManager::GetAvailableCount(HeapType type) const {
 	assert(isInitialized_);
-
-	const std::vector<bool>* usedFlags = nullptr;
-	switch (type) {
-	case HeapType::RTV: usedFlags = &rtvUsedFlags_; break;
-	case HeapType::DSV: usedFlags = &dsvUsedFlags_; break;
-	case HeapType::SRV: usedFlags = &srvUsedFlags_; break;
-	default: assert(false); return 0;
-	}
-
-	uint32_t availableCount = 0;
-	for (bool used : *usedFlags) {
-		if (!used) {
-			availableCount++;
-		}
-	}
-	return availableCount;
+	return GetAllocator(type).GetAvailableCount();
 }
 
 uint32_t DescriptorHeapManager::GetUsedCount(HeapType type) const {
 	assert(isInitialized_);
-
-	const std::vector<bool>* usedFlags = nullptr;
-	uint32_t totalCount = 0;
-
-	switch (type) {
-	case HeapType::RTV:
-		usedFlags = &rtvUsedFlags_;
-		totalCount = GraphicsConfig::kRTVHeapSize;
-		break;
-	case HeapType::DSV:
-		usedFlags = &dsvUsedFlags_;
-		totalCount = GraphicsConfig::kDSVHeapSize;
-		break;
-	case HeapType::SRV:
-		usedFlags = &srvUsedFlags_;
-		totalCount = GraphicsConfig::kSRVHeapSize;
-		break;
-	default:
-		assert(false);
-		return 0;
-	}
-
-	return totalCount - GetAvailableCount(type);
+	return GetAllocator(type).GetUsedCount();
 }
 
 bool DescriptorHeapManager::IsIndexUsed(HeapType type, uint32_t index) const {
@@ -366,13 +456,12 @@ bool DescriptorHeapManager::IsIndexUsed(HeapType type, uint32_t index) const {
 	if (!IsValidIndex(type, index)) {
 		return false;
 	}
+	return GetAllocator(type).IsUsed(index);
+}
 
-	switch (type) {
-	case HeapType::RTV: return rtvUsedFlags_[index];
-	case HeapType::DSV: return dsvUsedFlags_[index];
-	case HeapType::SRV: return srvUsedFlags_[index];
-	default: assert(false); return false;
-	}
+DescriptorIndexAllocator::Statistics DescriptorHeapManager::GetStatistics(HeapType type) const {
+	assert(isInitialized_);
+	return GetAllocator(type).GetStatistics();
 }
 
 //=============================================================================
@@ -406,15 +495,14 @@ Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> DescriptorHeapManager::CreateDescri
 	return descriptorHeap;
 }
 
-std::optional<uint32_t> DescriptorHeapManager::FindAvailableIndex(const std::vector<bool>& usedFlags) const {
-	
-	// 空いているインデックスを先頭から走査する
-	for (size_t i = 0; i < usedFlags.size(); ++i) {
-		if (!usedFlags[i]) {
-			return static_cast<uint32_t>(i);// 空いているインデックスを返す
-		}
+const DescriptorIndexAllocator& DescriptorHeapManager::GetAllocator(HeapType type) const {
+	switch (type) {
+	case HeapType::RTV: return rtvAllocator_;
+	case HeapType::DSV: return dsvAllocator_;
+	case HeapType::SRV: return srvAllocator_;
+	case HeapType::StagingSRV: return stagingSrvAllocator_;
+	default: assert(false); return srvAllocator_;
 	}
-	return std::nullopt;
 }
 
 bool DescriptorHeapManager::IsValidIndex(HeapType type, uint32_t index) const {
@@ -422,6 +510,16 @@ bool DescriptorHeapManager::IsValidIndex(HeapType type, uint32_t index) const {
 	case HeapType::RTV: return index < GraphicsConfig::kRTVHeapSize;
 	case HeapType::DSV: return index < GraphicsConfig::kDSVHeapSize;
 	case HeapType::SRV: return index < GraphicsConfig::kSRVHeapSize;
+	case HeapType::StagingSRV: return index < GraphicsConfig::kStagingSRVHeapSize;
 	default: return false;
 	}
+}
+
+void DescriptorHeapManager::WriteNullSRV(uint32_t index) {
+	D3D12_SHADER_RESOURCE_VIEW_DESC nullSrvDesc{};
+	nullSrvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	nullSrvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	nullSrvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	nullSrvDesc.Texture2D.MipLevels = 1;
+	device_->CreateShaderResourceView(nullptr, &nullSrvDesc, GetCPUHandle(HeapType::SRV, index));
 }
\ No newline at end of file
@@ -5,12 +5,17 @@
 #include <cassert>
 #include <optional>		//値がない可能性のある型を使用数かもしれない場合に使用std::optional
 
+#include "BaseSystem/DirectXCommon/DescriptorIndexAllocator.h"
+#include "BaseSystem/DirectXCommon/DescriptorRingAllocator.h"
 #include "BaseSystem/GraphicsConfig.h"
 #include "BaseSystem/Logger/Logger.h"
 
 /// <summary>
 /// ディスクリプタヒープの管理を行うクラス
 /// RTVヒープ、DSVヒープ、SRVヒープの統一管理を行う
+/// インデックスの割り当て・解放はDescriptorIndexAllocatorのビット列で行う（ヒープの大きさに依らずほぼ一定時間）
+/// SRVヒープは[0, kSRVHeapSize)を使い続けるもの、その後ろのkTransientSRVCount個を1フレームだけ使うもののリングに分ける
+/// リングにはCPU専用のステージングヒープに作ったSRVをコピーして使い、フェンス値でまとめて回収する
 /// </summary>
 class DescriptorHeapManager {
 public:
@@ -20,7 +25,8 @@ public:
 	enum class HeapType {
 		RTV,		// レンダーターゲットビュー
 		DSV,		// デプスステンシルビュー 
-		SRV			// シェーダーリソースビュー
+		SRV,		// シェーダーリソースビュー
+		StagingSRV	// リングへコピーする元のシェーダーリソースビュー（CPU専用、シェーダーからは見えない）
 	};
 
 	/// <summary>
@@ -75,6 +81,11 @@ public:
 	ID3D12DescriptorHeap* GetSRVHeap() const { return srvHeap_.Get(); }
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> GetSRVHeapComPtr() const { return srvHeap_; }
 
+	/// <summary>
+	/// ステージング用SRVヒープを取得（CPU専用）
+	/// </summary>
+	ID3D12DescriptorHeap* GetStagingSRVHeap() const { return stagingSrvHeap_.Get(); }
+
 	//																			//
 	//						ディスクリプタサイズ取得								//
 	//																			//
@@ -105,6 +116,12 @@ public:
 	/// <returns>割り当てられたディスクリプタハンドル（失敗時はisValid=false）</returns>
 	DescriptorHandle AllocateSRV();
 
+	/// <summary>
+	/// ステージング用SRVディスクリプタを割り当て（GPUハンドルはなし。使う時はCopyToTransientSRVでリングへコピーする）
+	/// </summary>
+	/// <returns>割り当てられたディスクリプタハンドル（失敗時はisValid=false）</returns>
+	DescriptorHandle AllocateStagingSRV();
+
 	/// <summary>
 	/// RTVディスクリプタを解放
 	/// </summary>
@@ -123,6 +140,48 @@ public:
 	/// <param name="index">解放するインデックス</param>
 	void ReleaseSRV(uint32_t index);
 
+	/// <summary>
+	/// ステージング用SRVディスクリプタを解放
+	/// </summary>
+	/// <param name="index">解放するインデックス</param>
+	void ReleaseStagingSRV(uint32_t index);
+
+	//																			//
+	//						1フレームだけ使うSRV（リング）							//
+	//																			//
+
+	/// <summary>
+	/// フレームの開始（これ以降にリングから割り当てた範囲はfenceValueが完了するまで使用中）
+	/// </summary>
+	/// <param name="fenceValue">このフレームの終わりにSignalするフェンス値</param>
+	void BeginTransientFrame(uint64_t fenceValue);
+
+	/// <summary>
+	/// GPUが完了したフェンス値までのフレームが使ったリングの範囲を回収
+	/// </summary>
+	/// <param name="completedFenceValue">完了したフェンス値</param>
+	void ReclaimTransient(uint64_t completedFenceValue);
+
+	/// <summary>
+	/// リングから連続したSRVを割り当て（解放は不要。このフレームの間だけ有効）
+	/// </summary>
+	/// <param name="count">ディスクリプタ数</param>
+	/// <returns>先頭のディスクリプタハンドル（indexはSRVヒープ内の位置。失敗時はisValid=false）</returns>
+	DescriptorHandle AllocateTransientSRV(uint32_t count);
+
+	/// <summary>
+	/// ステージング用SRVをリングの連続した範囲にコピーし、ディスクリプタテーブルとして使えるようにする
+	/// </summary>
+	/// <param name="sources">コピー元（ステージング用SRVのCPUハンドル）</param>
+	/// <param name="count">コピー元の数</param>
+	/// <returns>テーブル先頭のディスクリプタハンドル（失敗時はisValid=false）</returns>
+	DescriptorHandle CopyToTransientSRV(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count);
+
+	/// <summary>
+	/// リングの統計を取得
+	/// </summary>
+	DescriptorRingAllocator::Statistics GetTransientStatistics() const { return transientSrvAllocator_.GetStatistics(); }
+
 	//																			//
 	//						指定したインデックスを予約								//
 	//																			//
@@ -176,6 +235,15 @@ public:
 	/// </summary>
 	bool IsIndexUsed(HeapType type, uint32_t index) const;
 
+	/// <summary>
+	/// 割り当ての統計を取得（最大使用数・断片化など）
+	/// </summary>
+	DescriptorIndexAllocator::Statistics GetStatistics(HeapType type) const;
+
+	// 割り当て・解放・予約の成功時のログ出力（既定は無効。失敗時は常に出力する）
+	void SetLoggingEnabled(bool enabled) { isLoggingEnabled_ = enabled; }
+	bool IsLoggingEnabled() const { return isLoggingEnabled_; }
+
 private:
 	/// <summary>
 	/// ディスクリプタヒープを作成
@@ -186,15 +254,20 @@ private:
 		bool shaderVisible);
 
 	/// <summary>
-	/// 空いているインデックスを検索
+	/// ヒープの種別に対応するインデックス管理を取得
 	/// </summary>
-	std::optional<uint32_t> FindAvailableIndex(const std::vector<bool>& usedFlags) const;
+	const DescriptorIndexAllocator& GetAllocator(HeapType type) const;
 
 	/// <summary>
 	/// インデックスの有効性をチェック
 	/// </summary>
 	bool IsValidIndex(HeapType type, uint32_t index) const;
 
+	/// <summary>
+	/// SRVヒープのスロットにnullのSRVを書き込む（バインドレス描画で未使用のスロットを読んでも安全にする）
+	/// </summary>
+	void WriteNullSRV(uint32_t index);
+
 private:
 	// D3D12デバイス
 	Microsoft::WRL::ComPtr<ID3D12Device> device_;
@@ -203,18 +276,23 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> rtvHeap_;
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> dsvHeap_;
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> srvHeap_;
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> stagingSrvHeap_;
 
 	// ディスクリプタサイズ
 	uint32_t rtvDescriptorSize_ = 0;
 	uint32_t dsvDescriptorSize_ = 0;
 	uint32_t srvDescriptorSize_ = 0;
 
-	// 使用状況を管理するフラグ
-	//　使用されているものはTure
-	std::vector<bool> rtvUsedFlags_;
-	std::vector<bool> dsvUsedFlags_;
-	std::vector<bool> srvUsedFlags_;
+	// 使用状況の管理
+	DescriptorIndexAllocator rtvAllocator_;
+	DescriptorIndexAllocator dsvAllocator_;
+	DescriptorIndexAllocator srvAllocator_;
+	DescriptorIndexAllocator stagingSrvAllocator_;
+	// SRVヒープの後ろのリング
+	DescriptorRingAllocator transientSrvAllocator_;
 
 	// 初期化フラグ
 	bool isInitialized_ = false;
+	// 割り当て・解放のログを出すか
+	bool isLoggingEnabled_ = false;
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "DescriptorIndexAllocator.h"
+#include <algorithm>
+#include <bit>
+
+void DescriptorIndexAllocator::Initialize(uint32_t capacity) {
+	capacity_ = capacity;
+	usedCount_ = 0;
+
+	const uint32_t wordCount = (capacity + kBitsPerWord - 1) / kBitsPerWord;
+	const uint32_t summaryCount = (wordCount + kBitsPerWord - 1) / kBitsPerWord;
+	freeBits_.assign(wordCount, ~0ull);
+	summaryBits_.assign(summaryCount, 0ull);
+
+	// 最後の語の範囲外のビットは使用中扱い（空きとして見つからないように）
+	const uint32_t tailBits = capacity % kBitsPerWord;
+	if (tailBits != 0) {
+		freeBits_.back() = (1ull << tailBits) - 1;
+	}
+	for (uint32_t word = 0; word < wordCount; ++word) {
+		summaryBits_[word / kBitsPerWord] |= 1ull << (word % kBitsPerWord);
+	}
+
+	highWaterMark_ = 0;
+	allocateCount_ = 0;
+	releaseCount_ = 0;
+	failedCount_ = 0;
+}
+
+void DescriptorIndexAllocator::Finalize() {
+	freeBits_.clear();
+	summaryBits_.clear();
+	capacity_ = 0;
+	usedCount_ = 0;
+}
+
+uint32_t DescriptorIndexAllocator::Allocate() {
+	// 空きのある最初の語を要約から探し、その語の最下位の空きビットを取る
+	for (uint32_t summary = 0; summary < summaryBits_.size(); ++summary) {
+		if (summaryBits_[summary] == 0) {
+			continue;
+		}
+		const uint32_t word = summary * kBitsPerWord + std::countr_zero(summaryBits_[summary]);
+		const uint32_t index = word * kBitsPerWord + std::countr_zero(freeBits_[word]);
+		MarkUsed(index);
+		return index;
+	}
+
+	failedCount_++;
+	return kInvalidIndex;
+}
+
+bool DescriptorIndexAllocator::Reserve(uint32_t index) {
+	if (index >= capacity_ || IsUsed(index)) {
+		return false;
+	}
+	MarkUsed(index);
+	return true;
+}
+
+bool DescriptorIndexAllocator::Release(uint32_t index) {
+	if (index >= capacity_ || !IsUsed(index)) {
+		return false;
+	}
+
+	const uint32_t word = index / kBitsPerWord;
+	freeBits_[word] |= 1ull << (index % kBitsPerWord);
+	summaryBits_[word / kBitsPerWord] |= 1ull << (word % kBitsPerWord);
+
+	usedCount_--;
+	releaseCount_++;
+	return true;
+}
+
+bool DescriptorIndexAllocator::IsUsed(uint32_t index) const {
+	if (index >= capacity_) {
+		return false;
+	}
+	return (freeBits_[index / kBitsPerWord] & (1ull << (index % kBitsPerWord))) == 0;
+}
+
+DescriptorIndexAllocator::Statistics DescriptorIndexAllocator::GetStatistics() const {
+	Statistics statistics;
+	statistics.capacity = capacity_;
+	statistics.usedCount = usedCount_;
+	statistics.highWaterMark = highWaterMark_;
+	statistics.allocateCount = allocateCount_;
+	statistics.releaseCount = releaseCount_;
+	statistics.failedCount = failedCount_;
+
+	// 使用中で一番大きいインデックスを後ろの語から探す
+	for (uint32_t word = static_cast<uint32_t>(freeBits_.size()); word-- > 0;) {
+		uint64_t usedBits = ~freeBits_[word];
+		if (word == freeBits_.size() - 1 && capacity_ % kBitsPerWord != 0) {
+			usedBits &= (1ull << (capacity_ % kBitsPerWord)) - 1;
+		}
+		if (usedBits != 0) {
+			statistics.highestUsedIndex = word * kBitsPerWord + (kBitsPerWord - std::countl_zero(usedBits));
+			break;
+		}
+	}
+
+	// 連続した空きを数える（語ごとに、空きビットの塊を最下位から順に切り出す）
+	// 後ろが使用中で終わる塊だけを「使用中の範囲にある空き」として数える
+	uint32_t currentRun = 0;
+	for (uint32_t word = 0; word < freeBits_.size(); ++word) {
+		const uint32_t bitCount = (std::min)(kBitsPerWord, capacity_ - word * kBitsPerWord);
+		uint64_t bits = freeBits_[word];
+		uint32_t bit = 0;
+		while (bit < bitCount) {
+			if (bits & 1ull) {
+				// 空きが続く長さ
+				const uint32_t length = (std::min)(static_cast<uint32_t>(std::countr_one(bits)), bitCount - bit);
+				currentRun += length;
+				bit += length;
+				bits = (length < kBitsPerWord) ? bits >> length : 0;
+			} else {
+				// 使用中が続く長さ（ここで空きの塊が終わる）
+				const uint32_t length = (std::min)(static_cast<uint32_t>(std::countr_zero(bits)), bitCount - bit);
+				if (currentRun != 0) {
+					statistics.largestFreeRun = (std::max)(statistics.largestFreeRun, currentRun);
+					statistics.freeRunCount++;
+					currentRun = 0;
+				}
+				bit += length;
+				bits = (length < kBitsPerWord) ? bits >> length : 0;
+			}
+		}
+	}
+	// 末尾の空きは使用中の範囲の外なので、長さだけ見る
+	statistics.largestFreeRun = (std::max)(statistics.largestFreeRun, currentRun);
+
+	const uint32_t availableCount = capacity_ - usedCount_;
+	if (availableCount != 0) {
+		statistics.fragmentation = 1.0f - static_cast<float>(statistics.largestFreeRun) / static_cast<float>(availableCount);
+	}
+	return statistics;
+}
+
+void DescriptorIndexAllocator::MarkUsed(uint32_t index) {
+	const uint32_t word = index / kBitsPerWord;
+	freeBits_[word] &= ~(1ull << (index % kBitsPerWord));
+	if (freeBits_[word] == 0) {
+		summaryBits_[word / kBitsPerWord] &= ~(1ull << (word % kBitsPerWord));
+	}
+
+	usedCount_++;
+	allocateCount_++;
+	highWaterMark_ = (std::max)(highWaterMark_, usedCount_);
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ディスクリプタヒープのインデックス割り当て（D3Dに依存しない）
+/// 空きを64bitのビット列で持ち、さらに「空きのある語」を要約ビット列で持つ2段構成
+/// 割り当ては要約→語の順に最下位ビット探索（countr_zero）を2回行うだけなので、
+/// 4096個以下のヒープなら線形走査なしで一番小さい空きインデックスを返す
+/// </summary>
+class DescriptorIndexAllocator {
+public:
+	// 割り当て失敗時のインデックス
+	static const uint32_t kInvalidIndex = UINT32_MAX;
+
+	/// <summary>
+	/// 割り当ての統計
+	/// </summary>
+	struct Statistics {
+		uint32_t capacity = 0;			// 全体の数
+		uint32_t usedCount = 0;			// 使用中の数
+		uint32_t highWaterMark = 0;		// 同時に使用した最大数
+		uint32_t highestUsedIndex = 0;	// 使用中で一番大きいインデックス+1（使用中がなければ0）
+		uint32_t freeRunCount = 0;		// 使用中の範囲（0～highestUsedIndex）にある空きの塊の数
+		uint32_t largestFreeRun = 0;	// 一番長い連続した空きの長さ
+		uint64_t allocateCount = 0;		// 割り当て・予約の回数
+		uint64_t releaseCount = 0;		// 解放の回数
+		uint64_t failedCount = 0;		// 割り当てに失敗した回数
+		float fragmentation = 0.0f;		// 断片化率（1 - 一番長い連続した空き / 空きの合計、空きがなければ0）
+	};
+
+	DescriptorIndexAllocator() = default;
+	~DescriptorIndexAllocator() = default;
+
+	/// <summary>
+	/// 初期化（全て空きにして統計をリセット）
+	/// </summary>
+	/// <param name="capacity">管理するインデックスの数</param>
+	void Initialize(uint32_t capacity);
+
+	/// <summary>
+	/// 終了処理（管理しているインデックスを全て破棄）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 一番小さい空きインデックスを割り当て
+	/// </summary>
+	/// <returns>割り当てたインデックス（空きがなければkInvalidIndex）</returns>
+	uint32_t Allocate();
+
+	/// <summary>
+	/// 指定インデックスを割り当て済みにする
+	/// </summary>
+	/// <returns>範囲外か既に使用中ならfalse</returns>
+	bool Reserve(uint32_t index);
+
+	/// <summary>
+	/// インデックスを解放
+	/// </summary>
+	/// <returns>範囲外か既に解放済みならfalse</returns>
+	bool Release(uint32_t index);
+
+	/// <summary>
+	/// 指定インデックスが使用中か（範囲外はfalse）
+	/// </summary>
+	bool IsUsed(uint32_t index) const;
+
+	// Getter
+	uint32_t GetCapacity() const { return capacity_; }
+	uint32_t GetUsedCount() const { return usedCount_; }
+	uint32_t GetAvailableCount() const { return capacity_ - usedCount_; }
+
+	/// <summary>
+	/// 統計を取得（断片化はここで数えるので、毎フレーム呼ぶものではない）
+	/// </summary>
+	Statistics GetStatistics() const;
+
+private:
+	/// <summary>
+	/// 使用中にする（空きであることは呼び出し側で確認済み）
+	/// </summary>
+	void MarkUsed(uint32_t index);
+
+private:
+	static constexpr uint32_t kBitsPerWord = 64;
+
+	uint32_t capacity_ = 0;
+	uint32_t usedCount_ = 0;
+
+	// 空きなら1のビット列（範囲外の末尾ビットは0）
+	std::vector<uint64_t> freeBits_;
+	// freeBits_のうち空きが1つ以上ある語なら1のビット列
+	std::vector<uint64_t> summaryBits_;
+
+	// 統計
+	uint32_t highWaterMark_ = 0;
+	uint64_t allocateCount_ = 0;
+	uint64_t releaseCount_ = 0;
+	uint64_t failedCount_ = 0;
+};
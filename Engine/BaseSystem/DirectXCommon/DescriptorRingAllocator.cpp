@@ -0,0 +1,103 @@
+#include "DescriptorRingAllocator.h"
+#include <algorithm>
+
+void DescriptorRingAllocator::Initialize(uint32_t capacity) {
+	capacity_ = capacity;
+	head_ = 0;
+	tail_ = 0;
+	usedCount_ = 0;
+	frames_.clear();
+
+	highWaterMark_ = 0;
+	allocateCount_ = 0;
+	failedCount_ = 0;
+	wastedCount_ = 0;
+}
+
+void DescriptorRingAllocator::Finalize() {
+	frames_.clear();
+	capacity_ = 0;
+	head_ = 0;
+	tail_ = 0;
+	usedCount_ = 0;
+}
+
+void DescriptorRingAllocator::BeginFrame(uint64_t fenceValue) {
+	// 同じフェンス値で呼ばれた場合は同じフレームとして続ける
+	if (!frames_.empty() && frames_.back().fenceValue == fenceValue) {
+		return;
+	}
+	frames_.push_back({ fenceValue, head_, 0 });
+}
+
+uint32_t DescriptorRingAllocator::Allocate(uint32_t count) {
+	// BeginFrameの前の割り当ては回収できないので受け付けない
+	if (frames_.empty() || count == 0 || count > capacity_ - usedCount_) {
+		failedCount_++;
+		return kInvalidOffset;
+	}
+
+	// 全て空いていれば先頭から使い直す（折り返しを減らすため）
+	if (usedCount_ == 0) {
+		head_ = 0;
+		tail_ = 0;
+	}
+
+	uint32_t offset = kInvalidOffset;
+	uint32_t wasted = 0;
+	if (head_ >= tail_) {
+		// 空きは[head, capacity)と[0, tail)
+		if (head_ + count <= capacity_) {
+			offset = head_;
+		} else if (count <= tail_) {
+			wasted = capacity_ - head_;
+			offset = 0;
+		}
+	} else {
+		// 空きは[head, tail)
+		if (head_ + count <= tail_) {
+			offset = head_;
+		}
+	}
+
+	if (offset == kInvalidOffset) {
+		failedCount_++;
+		return kInvalidOffset;
+	}
+
+	head_ = (offset + count) % capacity_;
+	usedCount_ += wasted + count;
+
+	FrameRange& frame = frames_.back();
+	frame.end = head_;
+	frame.count += wasted + count;
+
+	allocateCount_++;
+	wastedCount_ += wasted;
+	highWaterMark_ = (std::max)(highWaterMark_, usedCount_);
+	return offset;
+}
+
+void DescriptorRingAllocator::Reclaim(uint64_t completedFenceValue) {
+	// 古いフレームから、GPUが使い終わったものを順に返す
+	while (!frames_.empty() && frames_.front().fenceValue <= completedFenceValue) {
+		const FrameRange& frame = frames_.front();
+		if (frame.count != 0) {
+			tail_ = frame.end;
+			usedCount_ -= frame.count;
+		}
+		frames_.pop_front();
+	}
+}
+
+DescriptorRingAllocator::Statistics DescriptorRingAllocator::GetStatistics() const {
+	Statistics statistics;
+	statistics.capacity = capacity_;
+	statistics.usedCount = usedCount_;
+	statistics.highWaterMark = highWaterMark_;
+	statistics.pendingFrameCount = static_cast<uint32_t>(frames_.size());
+	statistics.allocateCount = allocateCount_;
+	statistics.failedCount = failedCount_;
+	statistics.wastedCount = wastedCount_;
+	return statistics;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+/// <summary>
+/// 1フレームだけ使うディスクリプタの領域をリング状に切り出す（D3Dに依存しない）
+/// 割り当ては先頭から順に連続した範囲を切り出すだけで、個別の解放はしない
+/// BeginFrameで渡したフェンス値ごとに使った範囲を覚えておき、Reclaimで完了したフェンス値までの範囲をまとめて返す
+/// 末尾に収まらない割り当ては残りを捨てて先頭から切り出す（テーブルが途中で折り返さないように）
+/// </summary>
+class DescriptorRingAllocator {
+public:
+	// 割り当て失敗時のオフセット
+	static const uint32_t kInvalidOffset = UINT32_MAX;
+
+	/// <summary>
+	/// 割り当ての統計
+	/// </summary>
+	struct Statistics {
+		uint32_t capacity = 0;			// リング全体の数
+		uint32_t usedCount = 0;			// GPUが使い終わっていない数（折り返しで捨てた分を含む）
+		uint32_t highWaterMark = 0;		// usedCountの最大
+		uint32_t pendingFrameCount = 0;	// 回収待ちのフレーム数
+		uint64_t allocateCount = 0;		// 割り当ての回数
+		uint64_t failedCount = 0;		// 空きが足りず失敗した回数
+		uint64_t wastedCount = 0;		// 折り返しで捨てた数の合計
+	};
+
+	DescriptorRingAllocator() = default;
+	~DescriptorRingAllocator() = default;
+
+	/// <summary>
+	/// 初期化（全て空きにして統計をリセット）
+	/// </summary>
+	/// <param name="capacity">リングの大きさ</param>
+	void Initialize(uint32_t capacity);
+
+	/// <summary>
+	/// 終了処理
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// フレームの開始（これ以降の割り当てはfenceValueが完了するまで使用中になる）
+	/// </summary>
+	/// <param name="fenceValue">このフレームの終わりにSignalするフェンス値</param>
+	void BeginFrame(uint64_t fenceValue);
+
+	/// <summary>
+	/// 連続した範囲を割り当て
+	/// </summary>
+	/// <param name="count">ディスクリプタ数</param>
+	/// <returns>リング内の先頭オフセット（空きが足りなければkInvalidOffset）</returns>
+	uint32_t Allocate(uint32_t count);
+
+	/// <summary>
+	/// 完了したフェンス値までのフレームが使った範囲を回収
+	/// </summary>
+	/// <param name="completedFenceValue">GPUが完了したフェンス値</param>
+	void Reclaim(uint64_t completedFenceValue);
+
+	// Getter
+	uint32_t GetCapacity() const { return capacity_; }
+	uint32_t GetUsedCount() const { return usedCount_; }
+	uint32_t GetAvailableCount() const { return capacity_ - usedCount_; }
+	Statistics GetStatistics() const;
+
+private:
+	/// <summary>
+	/// 1フレーム分の使用範囲
+	/// </summary>
+	struct FrameRange {
+		uint64_t fenceValue = 0;
+		uint32_t end = 0;		// このフレームの最後の割り当ての次の位置
+		uint32_t count = 0;		// このフレームで使った数（折り返しで捨てた分を含む）
+	};
+
+	uint32_t capacity_ = 0;
+	uint32_t head_ = 0;			// 次に割り当てる位置
+	uint32_t tail_ = 0;			// 使用中の一番古い位置
+	uint32_t usedCount_ = 0;
+
+	// 回収待ちのフレーム（古い順、最後が今のフレーム）
+	std::deque<FrameRange> frames_;
+
+	// 統計
+	uint32_t highWaterMark_ = 0;
+	uint64_t allocateCount_ = 0;
+	uint64_t failedCount_ = 0;
+	uint64_t wastedCount_ = 0;
+};
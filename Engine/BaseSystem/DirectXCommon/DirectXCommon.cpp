@@ -1,5 +1,9 @@
 #include "DirectXCommon.h"
 #include<cassert>						//アサ―トを扱う
+#include"BaseSystem/DirectXCommon/ShaderCache/ShaderHasher.h"	//シェーダーキャッシュのキー計算
+#include"BaseSystem/DirectXCommon/ShaderCache/ShaderCache.h"	//コンパイル済みシェーダーのディスクキャッシュ
+#include"BaseSystem/DirectXCommon/ShaderCache/ShaderIncludeHandler.h"	//includeをVirtualFileSystemから読む
+#include"BaseSystem/FileSystem/VirtualFileSystem.h"	//シェーダーファイルの読み込み
 
 void DirectXCommon::Initialize(WinApp* winApp) {
 	///*-----------------------------------------------------------------------*///
@@ -97,14 +101,8 @@ void DirectXCommon::Initialize(WinApp* winApp) {
 	///								PSOを生成する									///
 	//																			//
 	///*-----------------------------------------------------------------------*///
-	// 3D用のPSO
-	MakePSO();
-
-	// スプライト用のPSO
-	MakeSpritePSO();
-
-	// 線分用のPSO
-	MakeLinePSO();
+	// 3D・スプライト・線分用のPSOをまとめて生成
+	MakeDefaultPSOs();
 
 	///*-----------------------------------------------------------------------*///
 	//																			//
@@ -279,6 +277,10 @@ void DirectXCommon::InitializeCommand()
 	assert(SUCCEEDED(hr));
 	Logger::Log(Logger::GetStream(), "Complete create commandList!!\n");//コマンドリスト生成完了のログを出す
 
+	// ステートキャッシュの対象に設定（描画コマンドはD3D12バックエンド経由で積む）
+	d3d12RenderCommandList_.SetCommandList(commandList.Get());
+	stateCache_.SetCommandList(&d3d12RenderCommandList_);
+
 }
 
 void DirectXCommon::MakeSwapChain(WinApp* winApp)
@@ -402,9 +404,9 @@ void DirectXCommon::InitalizeDXC()
 	hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler));
 	assert(SUCCEEDED(hr));
 
-	//現時点でincludeはしないが、includeに対応するための設定を行っておく
-	hr = dxcUtils->CreateDefaultIncludeHandler(&includeHandler);
-	assert(SUCCEEDED(hr));
+	//includeはVirtualFileSystemを通して読む（アーカイブに入れたhlsliも読めるように）
+	includeHandler = Microsoft::WRL::Make<ShaderIncludeHandler>(dxcUtils);
+	assert(includeHandler);
 	Logger::Log(Logger::GetStream(), "Complete: DXC compiler initialization.\n"); //DXC初期化完了
 
 }
@@ -416,81 +418,78 @@ void DirectXCommon::InitializePSOFactory()
 	Logger::Log(Logger::GetStream(), "DirectXCommon: PSOFactory initialized\n");
 }
 
-void DirectXCommon::MakePSO() {
-	// RootSignatureを構築
-	RootSignatureBuilder rsBuilder;
-	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// Material (b0)
+void DirectXCommon::MakeDefaultPSOs() {
+	///*-----------------------------------------------------------------------*///
+	///									3D用									///
+	///*-----------------------------------------------------------------------*///
+	RootSignatureBuilder rsBuilder3D;
+	rsBuilder3D.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)	// Material (b0)
 		.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX)			// Transform (b0)
 		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// Texture (t0)
 		.AddCBV(1, D3D12_SHADER_VISIBILITY_PIXEL)			// DirectionalLight (b1)
 		.AddStaticSampler(0);								// Sampler (s0)
 
-	// PSO設定を構築（プリセット使用）
-	auto psoDesc = PSODescriptor::Create3D()
+	auto psoDesc3D = PSODescriptor::Create3D()
 		.SetVertexShader(L"resources/Shader/Object3d/Object3d.VS.hlsl")
 		.SetPixelShader(L"resources/Shader/Object3d/Object3d.PS.hlsl");
 
-	// PSO生成
-	auto psoInfo = psoFactory_->CreatePSO(psoDesc, rsBuilder);
-	if (!psoInfo.IsValid()) {
-		Logger::Log(Logger::GetStream(), "DirectXCommon: Failed to create 3D PSO\n");
-		assert(false);
-	}
-
-	rootSignature = psoInfo.rootSignature;
-	graphicsPipelineState = psoInfo.pipelineState;
-
-	Logger::Log(Logger::GetStream(), "Complete create 3D PSO using PSOFactory!!\n");
-}
-
-void DirectXCommon::MakeSpritePSO() {
-	// RootSignatureを構築
-	RootSignatureBuilder rsBuilder;
-	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// Material (b0)
-		.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX)			// Transform (b0)  
+	///*-----------------------------------------------------------------------*///
+	///								スプライト用									///
+	///*-----------------------------------------------------------------------*///
+	RootSignatureBuilder rsBuilderSprite;
+	rsBuilderSprite.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)	// Material (b0)
+		.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX)			// Transform (b0)
 		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// Texture (t0)
 		.AddCBV(1, D3D12_SHADER_VISIBILITY_PIXEL)			// DirectionalLight (b1)
 		.AddStaticSampler(0);								// Sampler (s0)
 
-	// PSO設定を構築（プリセット使用）
-	auto psoDesc = PSODescriptor::CreateSprite()
+	auto psoDescSprite = PSODescriptor::CreateSprite()
 		.SetVertexShader(L"resources/Shader/Sprite/Sprite.VS.hlsl")
 		.SetPixelShader(L"resources/Shader/Sprite/Sprite.PS.hlsl");
 
-	// PSO生成
-	auto psoInfo = psoFactory_->CreatePSO(psoDesc, rsBuilder);
-	if (!psoInfo.IsValid()) {
-		Logger::Log(Logger::GetStream(), "DirectXCommon: Failed to create Sprite PSO\n");
-		assert(false);
-	}
-
-	spriteRootSignature = psoInfo.rootSignature;
-	spritePipelineState = psoInfo.pipelineState;
-
-	Logger::Log(Logger::GetStream(), "Complete create Sprite PSO using PSOFactory!!\n");
-}
-
-void DirectXCommon::MakeLinePSO() {
-	// RootSignatureを構築（線分は変換行列のみ）
-	RootSignatureBuilder rsBuilder;
-	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX);// Transform (b0)
+	///*-----------------------------------------------------------------------*///
+	///								線分用（変換行列のみ）							///
+	///*-----------------------------------------------------------------------*///
+	RootSignatureBuilder rsBuilderLine;
+	rsBuilderLine.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX);// Transform (b0)
 
-	// PSO設定を構築（プリセット使用）
-	auto psoDesc = PSODescriptor::CreateLine()
+	auto psoDescLine = PSODescriptor::CreateLine()
 		.SetVertexShader(L"resources/Shader/Line/Line.VS.hlsl")
 		.SetPixelShader(L"resources/Shader/Line/Line.PS.hlsl");
 
-	// PSO生成
-	auto psoInfo = psoFactory_->CreatePSO(psoDesc, rsBuilder);
-	if (!psoInfo.IsValid()) {
+	// まとめて生成（シェーダーのコンパイルとPSOの生成は並列に行われる）
+	auto psoInfos = psoFactory_->CreatePSOBatch({
+		{ &psoDesc3D, &rsBuilder3D },
+		{ &psoDescSprite, &rsBuilderSprite },
+		{ &psoDescLine, &rsBuilderLine },
+		});
+
+	if (!psoInfos[0].IsValid()) {
+		Logger::Log(Logger::GetStream(), "DirectXCommon: Failed to create 3D PSO\n");
+		assert(false);
+	}
+	if (!psoInfos[1].IsValid()) {
+		Logger::Log(Logger::GetStream(), "DirectXCommon: Failed to create Sprite PSO\n");
+		assert(false);
+	}
+	if (!psoInfos[2].IsValid()) {
 		Logger::Log(Logger::GetStream(), "DirectXCommon: Failed to create Line PSO\n");
 		assert(false);
 	}
 
-	lineRootSignature = psoInfo.rootSignature;
-	linePipelineState = psoInfo.pipelineState;
+	rootSignature = psoInfos[0].rootSignature;
+	graphicsPipelineState = psoInfos[0].pipelineState;
+	spriteRootSignature = psoInfos[1].rootSignature;
+	spritePipelineState = psoInfos[1].pipelineState;
+	lineRootSignature = psoInfos[2].rootSignature;
+	linePipelineState = psoInfos[2].pipelineState;
+
+	// シェーダーを書き換えたら作り直す（PSOFactoryはこのクラスが持っているので、外すのは不要）
+	psoFactory_->RegisterReload(psoDesc3D, rootSignature, rsBuilder3D.ComputeHash(), &graphicsPipelineState);
+	psoFactory_->RegisterReload(psoDescSprite, spriteRootSignature, rsBuilderSprite.ComputeHash(), &spritePipelineState);
+	psoFactory_->RegisterReload(psoDescLine, lineRootSignature, rsBuilderLine.ComputeHash(), &linePipelineState);
 
-	Logger::Log(Logger::GetStream(), "Complete create Line PSO using PSOFactory!!\n");
+	Logger::Log(Logger::GetStream(), "Complete create default PSOs using PSOFactory!!\n");
 }
 
 Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(
@@ -502,10 +501,39 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(
 	//「これからシェーダーをコンパイルする」とログに出す
 	Logger::Log(Logger::ConvertString(std::format(L"Begin CompileShader, path:{},profile:{}\n", filePath, profile)));
 
-	///hlslファイルを読み込む
-	IDxcBlobEncoding* shaderSource = nullptr;
-	HRESULT hr = dxcUtils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
+	///コンパイルオプション
+	// SRVヒープの持ち続ける範囲の数をシェーダーに渡す（バインドレス描画のテクスチャ配列の大きさ）
+	static const std::wstring srvHeapSizeDefine = std::format(L"SRV_HEAP_SIZE={}", GraphicsConfig::kSRVHeapSize);
+	LPCWSTR arguments[] = {
+		filePath.c_str(),		//コンパイル対象のhlslファイル名
+		L"-E",L"main",			//エントリーポイントの指定。基本的にmain以外にはしない
+		L"-T",profile,			//ShaderProfileの設定
+		L"-Zi",L"Qembed_debug"	//デバッグの情報を埋め込む	(L"-Qembed_debug"でエラー)
+		L"-Od",					//最適化を外しておく
+		L"-Zpr",				//メモリレイアウトは行優先
+		L"-D",srvHeapSizeDefine.c_str(),	//GraphicsConfig::kSRVHeapSize
+	};
+
+	///キャッシュを確認する
+	// ソース・include先・プロファイル・オプションからキーを作る（ファイル名はソース側でハッシュするので除く）
+	std::vector<std::wstring> keyArguments(std::begin(arguments) + 1, std::end(arguments));
+	ShaderHasher::Key cacheKey = ShaderHasher::ComputeKey(filePath, L"main", profile, keyArguments);
+	std::vector<uint8_t> cachedData;
+	if (cacheKey.isValid && ShaderCache::GetInstance()->Load(cacheKey.hash, cachedData)) {
+		// キャッシュにあればDXCを通さずにBlobを作って返す（コードページ0はバイナリ扱い）
+		Microsoft::WRL::ComPtr<IDxcBlobEncoding> cachedBlob;
+		HRESULT hr = dxcUtils->CreateBlob(cachedData.data(), static_cast<UINT32>(cachedData.size()), 0, &cachedBlob);
+		assert(SUCCEEDED(hr));
+		Logger::Log(Logger::ConvertString(std::format(L"Shader cache hit,path:{},profile:{}\n", filePath, profile)));
+		return cachedBlob;
+	}
+
+	///hlslファイルを読み込む（アーカイブにあればそこから。マップしたメモリをコピーせずにDXCに渡す）
+	const FileView shaderFile = VirtualFileSystem::GetInstance()->Open(Logger::ConvertString(filePath));
 	//読めなかったら停止する
+	assert(shaderFile.IsValid());
+	IDxcBlobEncoding* shaderSource = nullptr;
+	HRESULT hr = dxcUtils->CreateBlobFromPinned(shaderFile.GetData(), static_cast<UINT32>(shaderFile.GetSize()), DXC_CP_UTF8, &shaderSource);
 	assert(SUCCEEDED(hr));
 
 	//読み込んだファイルの内容を設定する
@@ -515,14 +543,6 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(
 	shaderSourceBuffer.Encoding = DXC_CP_UTF8;//UTF8の文字コードであることを通知
 
 	///Compileする
-	LPCWSTR arguments[] = {
-		filePath.c_str(),		//コンパイル対象のhlslファイル名
-		L"-E",L"main",			//エントリーポイントの指定。基本的にmain以外にはしない
-		L"-T",profile,			//ShaderProfileの設定
-		L"-Zi",L"Qembed_debug"	//デバッグの情報を埋め込む	(L"-Qembed_debug"でエラー)
-		L"-Od",					//最適化を外しておく
-		L"-Zpr",				//メモリレイアウトは行優先
-	};
 	//実際にShaderをコンパイルする
 	IDxcResult* shaderResult = nullptr;
 	hr = dxcCompiler->Compile(
@@ -537,12 +557,21 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(
 	assert(SUCCEEDED(hr));
 
 	///警告・エラーがでていないか確認する
-		//警告・エラーが出ていたらログに出して停止する
-	IDxcBlobUtf8* shaderError = nullptr;
+	//警告・エラーが出ていたらログに出す
+	Microsoft::WRL::ComPtr<IDxcBlobUtf8> shaderError;
+	shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
 	if (shaderError != nullptr && shaderError->GetStringLength() != 0)
 	{
 		Logger::Log(shaderError->GetStringPointer());
-		assert(false);
+	}
+	//コンパイルエラーの場合はnullptrを返す（起動時は呼び出し側でPSOを作れずに停止し、ホットリロード中は前のPSOを使い続ける）
+	HRESULT compileStatus = S_OK;
+	shaderResult->GetStatus(&compileStatus);
+	if (FAILED(compileStatus)) {
+		Logger::Log(Logger::ConvertString(std::format(L"Compile Failed,path:{},profile:{}\n", filePath, profile)));
+		shaderSource->Release();
+		shaderResult->Release();
+		return nullptr;
 	}
 	///Compile結果を受け取って返す
 	//コンパイル結果から実行用のバイナリ部分を取得
@@ -551,6 +580,12 @@ Microsoft::WRL::ComPtr<IDxcBlob> DirectXCommon::CompileShader(
 	assert(SUCCEEDED(hr));
 	//成功したログを出す
 	Logger::Log(Logger::ConvertString(std::format(L"Compile Succesed,path:{},profile:{}\n", filePath, profile)));
+
+	//コンパイルに成功したものだけキャッシュに保存する
+	if (cacheKey.isValid) {
+		ShaderCache::GetInstance()->Store(cacheKey.hash, shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+	}
+
 	//もう使わないリソースを開放
 	shaderSource->Release();
 	shaderResult->Release();
@@ -626,10 +661,10 @@ void DirectXCommon::PreDraw()
 	commandList->RSSetViewports(1, &viewport);						//Viewportを設定	
 	commandList->RSSetScissorRects(1, &scissorRect);				//Scissorを設定
 	// RootSignatureを設定。PSOに設定しているけど別途設定（PSOと同じもの）が必要
-	commandList->SetGraphicsRootSignature(rootSignature.Get());
-	commandList->SetPipelineState(graphicsPipelineState.Get());		//PSOを設定
+	stateCache_.SetGraphicsRootSignature(rootSignature.Get());
+	stateCache_.SetPipelineState(graphicsPipelineState.Get());		//PSOを設定
 	// 形状を設定。PSOに設定しているものとはまた別。RootSignatureと同じように同じものを設定すると考えておけばいい
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache_.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 }
 
@@ -647,7 +682,8 @@ void DirectXCommon::PostDraw()
 
 }
 void DirectXCommon::BeginFrame() {
-
+	// このフレームの終わりにSignalするフェンス値で、1フレームだけ使うSRVを記録する
+	descriptorManager_->BeginTransientFrame(fenceValue + 1);
 }
 
 void DirectXCommon::EndFrame() {
@@ -672,9 +708,25 @@ void DirectXCommon::EndFrame() {
 		WaitForSingleObject(fenceEvent, INFINITE);
 	}
 
+	// GPUが使い終わったフレームの1フレームだけ使うSRVを回収
+	descriptorManager_->ReclaimTransient(fence->GetCompletedValue());
+
+	// 次のフレームへ
+	++frameCount_;
+
 	// 次のフレーム用のコマンドリストを準備
 	hr = commandAllocator->Reset();
 	assert(SUCCEEDED(hr));
 	hr = commandList->Reset(commandAllocator.Get(), nullptr);
 	assert(SUCCEEDED(hr));
+
+	// リセットでステートは初期化されるので記録も破棄
+	lastFrameStateStatistics_ = stateCache_.GetStatistics();
+	stateCache_.ResetStatistics();
+	stateCache_.Invalidate();
+}
+
+void DirectXCommon::SetRenderCommandList(RenderCommandList* renderCommandList) {
+	// 発行先が変わるとステートの記録は当てにならないので破棄される
+	stateCache_.SetCommandList(renderCommandList ? renderCommandList : &d3d12RenderCommandList_);
 }
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include"BaseSystem/Logger/Logger.h"
 #include"BaseSystem/GraphicsConfig.h"	//ウィンドウサイズなど
 #include"BaseSystem/DirectXCommon/DescriptorHeapManager.h"		//ディスクリプタヒープ管理
+#include"BaseSystem/DirectXCommon/GraphicsStateCache.h"		//冗長なステート設定の省略
+#include"BaseSystem/DirectXCommon/RenderBackend/D3D12RenderCommandList.h"	//描画バックエンド
 
 ///PSO作成しやすいように作ったやつら
 #include "BaseSystem/DirectXCommon/PSOFactory/PSOFactory.h"
@@ -58,7 +60,7 @@ public:
 	void EndFrame();
 
 	/// <summary>
-	/// シェーダーをコンパイルする関数
+	/// シェーダーをコンパイルする関数（コンパイルエラーはログに出してnullptrを返す）
 	/// </summary>
 	static Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(
 		const std::wstring& filePath,
@@ -87,6 +89,20 @@ public:
 	///参照で返すゲッター？
 	const Microsoft::WRL::ComPtr<ID3D12Device>& GetDeviceComPtr() const { return device; }
 	const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& GetCommandListComPtr() const { return commandList; }
+	// ステートキャッシュ経由のコマンドリスト（PSOやルート引数の設定はこちらを通す）
+	GraphicsStateCache& GetStateCache() { return stateCache_; }
+	// 前フレームのステートキャッシュ統計（発行数/省略数）
+	const GraphicsStateCache::Statistics& GetLastFrameStateStatistics() const { return lastFrameStateStatistics_; }
+	// 描画コマンドの発行先（デフォルトはD3D12のコマンドリスト）
+	RenderCommandList* GetRenderCommandList() const { return stateCache_.GetCommandList(); }
+	// D3D12のコマンドリストに積むバックエンド（記録用バックエンドの転送先に使う）
+	RenderCommandList* GetD3D12RenderCommandList() { return &d3d12RenderCommandList_; }
+
+	/// <summary>
+	/// 描画コマンドの発行先を差し替える（RecordingRenderCommandListでの記録・計測用）
+	/// </summary>
+	/// <param name="renderCommandList">発行先（nullptrでD3D12に戻す）</param>
+	void SetRenderCommandList(RenderCommandList* renderCommandList);
 
 	// DXC関連のゲッター
 	IDxcUtils* GetDxcUtils() const { return dxcUtils.Get(); }
@@ -105,6 +121,14 @@ public:
 	// PSOFactory関連
 	PSOFactory* GetPSOFactory() const { return psoFactory_.get(); }
 
+	// フレーム関連
+	// 毎フレーム書き換えるリソースを何組持つか（スワップチェーンのバッファ数と同じ）
+	static const uint32_t kFrameCount = 2;
+	// EndFrameを呼んだ回数（フレームごとのリソースの切り替えに使う）
+	uint64_t GetFrameCount() const { return frameCount_; }
+	// 今のフレームが使う組の番号
+	uint32_t GetFrameIndex() const { return static_cast<uint32_t>(frameCount_ % kFrameCount); }
+
 private:
 
 
@@ -158,19 +182,9 @@ private:
 	void InitializePSOFactory();
 
 	/// <summary>
-	/// PSOを作成する
-	/// </summary>
-	void MakePSO();
-
-	/// <summary>
-	/// 2D用のPSOを作成する
-	/// </summary>
-	void MakeSpritePSO();
-
-	/// <summary>
-	/// 線分描画用のPSOを作成する
+	/// 3D・2D・線分描画用のPSOをまとめて作成する
 	/// </summary>
-	void MakeLinePSO();
+	void MakeDefaultPSOs();
 
 	/// <summary>
 	/// ViewportとScissor
@@ -193,6 +207,11 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue;
 	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+	// 描画コマンドの発行先（D3D12）
+	D3D12RenderCommandList d3d12RenderCommandList_;
+	// 冗長なステート設定を省くためのキャッシュ
+	GraphicsStateCache stateCache_;
+	GraphicsStateCache::Statistics lastFrameStateStatistics_;
 
 	Microsoft::WRL::ComPtr<IDXGISwapChain4> swapChain;
 	DXGI_SWAP_CHAIN_DESC1 swapChainDesc{};
@@ -211,6 +230,8 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
 	uint64_t fenceValue;
 	HANDLE fenceEvent;
+	// 提出したフレーム数
+	uint64_t frameCount_ = 0;
 
 	//DXC
 	Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils;
@@ -0,0 +1,262 @@
+#pragma once
+#include <d3d12.h>
+#include <cstdint>
+#include <cstring>
+#include "BaseSystem/DirectXCommon/RenderBackend/RenderCommandList.h"
+
+/// <summary>
+/// コマンドリストの冗長なステート設定を省くラッパー
+/// 現在のPSO・ルートシグネチャ・トポロジ・頂点/インデックスバッファ・ルート引数を記録し、
+/// 同じ値の再設定はコマンドリストに積まない
+/// CommandListTはID3D12GraphicsCommandListと同名のメソッドを持っていればよい
+/// </summary>
+template<typename CommandListT>
+class BasicGraphicsStateCache {
+public:
+	// 記録するルートパラメータの最大数
+	static const uint32_t kMaxRootParameters = 16;
+	// 記録する頂点バッファスロットの最大数
+	static const uint32_t kMaxVertexBufferSlots = 4;
+
+	/// <summary>
+	/// 発行・省略したコマンド数
+	/// </summary>
+	struct Statistics {
+		uint32_t issuedCount = 0;	// コマンドリストに積んだ数
+		uint32_t elidedCount = 0;	// 冗長のため省いた数
+	};
+
+	BasicGraphicsStateCache() = default;
+	~BasicGraphicsStateCache() = default;
+
+	/// <summary>
+	/// 対象のコマンドリストを設定（記録したステートは破棄）
+	/// </summary>
+	/// <param name="commandList">コマンドリスト</param>
+	void SetCommandList(CommandListT* commandList) {
+		commandList_ = commandList;
+		Invalidate();
+	}
+
+	/// <summary>
+	/// 記録したステートを全て不明扱いにする
+	/// コマンドリストのReset後や、キャッシュを通さずにステートを変更した後に呼ぶ
+	/// </summary>
+	void Invalidate() {
+		rootSignature_ = nullptr;
+		pipelineState_ = nullptr;
+		topology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+		for (uint32_t i = 0; i < kMaxVertexBufferSlots; ++i) {
+			vertexBufferValid_[i] = false;
+		}
+		indexBufferValid_ = false;
+		InvalidateRootArguments();
+	}
+
+	/// <summary>
+	/// ルート引数の記録のみ破棄する
+	/// </summary>
+	void InvalidateRootArguments() {
+		for (uint32_t i = 0; i < kMaxRootParameters; ++i) {
+			rootArguments_[i].type = RootArgumentType::None;
+		}
+	}
+
+	///*-----------------------------------------------------------------------*///
+	//								ステート設定									//
+	///*-----------------------------------------------------------------------*///
+
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) {
+		if (rootSignature_ == rootSignature) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->SetGraphicsRootSignature(rootSignature);
+		rootSignature_ = rootSignature;
+		// ルートシグネチャが変わるとルート引数は全て無効になる
+		InvalidateRootArguments();
+		++statistics_.issuedCount;
+	}
+
+	void SetPipelineState(ID3D12PipelineState* pipelineState) {
+		if (pipelineState_ == pipelineState) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->SetPipelineState(pipelineState);
+		pipelineState_ = pipelineState;
+		++statistics_.issuedCount;
+	}
+
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) {
+		if (topology_ == topology) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->IASetPrimitiveTopology(topology);
+		topology_ = topology;
+		++statistics_.issuedCount;
+	}
+
+	void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) {
+		// 記録範囲外のスロットは常に発行する
+		if (startSlot + numViews > kMaxVertexBufferSlots) {
+			commandList_->IASetVertexBuffers(startSlot, numViews, views);
+			for (UINT i = startSlot; i < kMaxVertexBufferSlots; ++i) {
+				vertexBufferValid_[i] = false;
+			}
+			++statistics_.issuedCount;
+			return;
+		}
+
+		bool isSame = true;
+		for (UINT i = 0; i < numViews; ++i) {
+			if (!vertexBufferValid_[startSlot + i] ||
+				std::memcmp(&vertexBuffers_[startSlot + i], &views[i], sizeof(D3D12_VERTEX_BUFFER_VIEW)) != 0) {
+				isSame = false;
+				break;
+			}
+		}
+		if (isSame) {
+			++statistics_.elidedCount;
+			return;
+		}
+
+		commandList_->IASetVertexBuffers(startSlot, numViews, views);
+		for (UINT i = 0; i < numViews; ++i) {
+			vertexBuffers_[startSlot + i] = views[i];
+			vertexBufferValid_[startSlot + i] = true;
+		}
+		++statistics_.issuedCount;
+	}
+
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) {
+		if (indexBufferValid_ && view &&
+			std::memcmp(&indexBuffer_, view, sizeof(D3D12_INDEX_BUFFER_VIEW)) == 0) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->IASetIndexBuffer(view);
+		indexBufferValid_ = (view != nullptr);
+		if (view) {
+			indexBuffer_ = *view;
+		}
+		++statistics_.issuedCount;
+	}
+
+	void SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) {
+		if (IsSameRootArgument(rootParameterIndex, RootArgumentType::CBV, address)) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->SetGraphicsRootConstantBufferView(rootParameterIndex, address);
+		RecordRootArgument(rootParameterIndex, RootArgumentType::CBV, address);
+		++statistics_.issuedCount;
+	}
+
+	void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) {
+		if (IsSameRootArgument(rootParameterIndex, RootArgumentType::DescriptorTable, handle.ptr)) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->SetGraphicsRootDescriptorTable(rootParameterIndex, handle);
+		RecordRootArgument(rootParameterIndex, RootArgumentType::DescriptorTable, handle.ptr);
+		++statistics_.issuedCount;
+	}
+
+	void SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) {
+		if (IsSameRootArgument(rootParameterIndex, RootArgumentType::SRV, address)) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->SetGraphicsRootShaderResourceView(rootParameterIndex, address);
+		RecordRootArgument(rootParameterIndex, RootArgumentType::SRV, address);
+		++statistics_.issuedCount;
+	}
+
+	void SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) {
+		// 1つのルート定数に複数の値を持つ場合は位置ごとに記録できないので、先頭の値だけ記録する
+		if (destOffsetIn32BitValues == 0 &&
+			IsSameRootArgument(rootParameterIndex, RootArgumentType::Constant, srcData)) {
+			++statistics_.elidedCount;
+			return;
+		}
+		commandList_->SetGraphicsRoot32BitConstant(rootParameterIndex, srcData, destOffsetIn32BitValues);
+		RecordRootArgument(rootParameterIndex,
+			destOffsetIn32BitValues == 0 ? RootArgumentType::Constant : RootArgumentType::None, srcData);
+		++statistics_.issuedCount;
+	}
+
+	///*-----------------------------------------------------------------------*///
+	//								描画（そのまま発行）							//
+	///*-----------------------------------------------------------------------*///
+
+	void DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance) {
+		commandList_->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+	}
+
+	void DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) {
+		commandList_->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+	}
+
+	///*-----------------------------------------------------------------------*///
+	//									ゲッター								//
+	///*-----------------------------------------------------------------------*///
+
+	CommandListT* GetCommandList() const { return commandList_; }
+	ID3D12RootSignature* GetRootSignature() const { return rootSignature_; }
+	ID3D12PipelineState* GetPipelineState() const { return pipelineState_; }
+	D3D12_PRIMITIVE_TOPOLOGY GetPrimitiveTopology() const { return topology_; }
+
+	const Statistics& GetStatistics() const { return statistics_; }
+	void ResetStatistics() { statistics_ = Statistics{}; }
+
+private:
+	enum class RootArgumentType {
+		None,
+		CBV,
+		SRV,
+		DescriptorTable,
+		Constant,
+	};
+
+	struct RootArgument {
+		RootArgumentType type = RootArgumentType::None;
+		uint64_t value = 0;
+	};
+
+	bool IsSameRootArgument(UINT index, RootArgumentType type, uint64_t value) const {
+		return index < kMaxRootParameters &&
+			rootArguments_[index].type == type &&
+			rootArguments_[index].value == value;
+	}
+
+	void RecordRootArgument(UINT index, RootArgumentType type, uint64_t value) {
+		if (index < kMaxRootParameters) {
+			rootArguments_[index].type = type;
+			rootArguments_[index].value = value;
+		}
+	}
+
+private:
+	CommandListT* commandList_ = nullptr;
+
+	// 現在のステート
+	ID3D12RootSignature* rootSignature_ = nullptr;
+	ID3D12PipelineState* pipelineState_ = nullptr;
+	D3D12_PRIMITIVE_TOPOLOGY topology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	D3D12_VERTEX_BUFFER_VIEW vertexBuffers_[kMaxVertexBufferSlots]{};
+	bool vertexBufferValid_[kMaxVertexBufferSlots]{};
+	D3D12_INDEX_BUFFER_VIEW indexBuffer_{};
+	bool indexBufferValid_ = false;
+	RootArgument rootArguments_[kMaxRootParameters]{};
+
+	// 統計
+	Statistics statistics_;
+};
+
+/// <summary>
+/// 描画バックエンド（RenderCommandList）用
+/// D3D12・記録用のどちらのバックエンドにも同じ描画コードから積める
+/// </summary>
+using GraphicsStateCache = BasicGraphicsStateCache<RenderCommandList>;
@@ -1,4 +1,5 @@
 #include "PSODescriptor.h"
+#include "BaseSystem/Hash/Hash.h"
 
 
 
@@ -47,6 +48,25 @@ PSODescriptor PSODescriptor::CreateSprite() {
 	return desc;
 }
 
+PSODescriptor PSODescriptor::CreateSpriteBatch() {
+	PSODescriptor desc;
+
+	// スプライトの一括描画用（深度テストなし、座標はCPU側で変換済み）
+	desc.SetVertexShader(L"resources/Shader/SpriteBatch/SpriteBatch.VS.hlsl", L"main")
+		.SetPixelShader(L"resources/Shader/SpriteBatch/SpriteBatch.PS.hlsl", L"main")
+		.SetBlendMode(BlendMode::AlphaBlend)
+		.SetCullMode(CullMode::Back)
+		.EnableDepth(false)
+		.SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE);
+
+	// 一括描画用頂点レイアウト（SpriteBatchVertexと合わせる）
+	desc.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT })
+		.AddInputElement({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT })
+		.AddInputElement({ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT });
+
+	return desc;
+}
+
 PSODescriptor PSODescriptor::CreateLine() {
 	PSODescriptor desc;
 
@@ -59,11 +79,9 @@ PSODescriptor PSODescriptor::CreateLine() {
 		.EnableDepthWrite(true)
 		.SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE);
 
-	// 線分用頂点レイアウト（色情報を含む）
-	desc.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT })
-		.AddInputElement({ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT })
-		.AddInputElement({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT })
-		.AddInputElement({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT });
+	// 線分用頂点レイアウト（座標と色だけ、LineVertexと合わせる）
+	desc.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT })
+		.AddInputElement({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM });
 
 	return desc;
 }
@@ -323,16 +341,12 @@ std::vector<D3D12_INPUT_ELEMENT_DESC> PSODescriptor::CreateInputElementDescs() c
 	std::vector<D3D12_INPUT_ELEMENT_DESC> descs;
 	descs.reserve(inputElements_.size());
 
-	// 文字列を保持するためのvectorをクリアして再構築
-	semanticNames_.clear();
-	semanticNames_.reserve(inputElements_.size());
-
 	// InputElementからD3D12_INPUT_ELEMENT_DESCに変換
+	// （文字列はinputElements_が保持しているので、このDescriptorが生きている間はポインタが有効）
+	// 内部状態を書き換えないので、複数スレッドから同時に呼んでもよい
 	for (const auto& element : inputElements_) {
-		semanticNames_.push_back(element.semanticName);
-
 		D3D12_INPUT_ELEMENT_DESC desc{};
-		desc.SemanticName = semanticNames_.back().c_str();  // 保持した文字列のポインタを使用
+		desc.SemanticName = element.semanticName.c_str();
 		desc.SemanticIndex = element.semanticIndex;
 		desc.Format = element.format;
 		desc.InputSlot = element.inputSlot;
@@ -344,4 +358,63 @@ std::vector<D3D12_INPUT_ELEMENT_DESC> PSODescriptor::CreateInputElementDescs() c
 	}
 
 	return descs;
-}
\ No newline at end of file
+}
+
+uint64_t PSODescriptor::ComputeHash() const {
+	uint64_t hash = Hash::kOffsetBasis;
+
+	// 文字列は長さも含めて積む（連結したときに区切りが曖昧にならないように）
+	auto hashShader = [&hash](const ShaderInfo& shader) {
+		hash = Hash::Combine(hash, shader.filePath.size());
+		hash = Hash::WString(shader.filePath, hash);
+		hash = Hash::Combine(hash, shader.entryPoint.size());
+		hash = Hash::WString(shader.entryPoint, hash);
+		hash = Hash::Combine(hash, shader.target.size());
+		hash = Hash::WString(shader.target, hash);
+	};
+	hashShader(vertexShader_);
+	hashShader(pixelShader_);
+
+	// ブレンド・ラスタライザ・深度
+	hash = Hash::Combine(hash, static_cast<uint64_t>(blendMode_));
+	hash = Hash::Combine(hash, static_cast<uint64_t>(cullMode_));
+	hash = Hash::Combine(hash, static_cast<uint64_t>(fillMode_));
+	hash = Hash::Combine(hash, depthEnable_ ? 1 : 0);
+	hash = Hash::Combine(hash, depthWriteEnable_ ? 1 : 0);
+	hash = Hash::Combine(hash, static_cast<uint64_t>(depthFunc_));
+
+	// トポロジとフォーマット
+	hash = Hash::Combine(hash, static_cast<uint64_t>(topologyType_));
+	hash = Hash::Combine(hash, static_cast<uint64_t>(renderTargetFormat_));
+	hash = Hash::Combine(hash, static_cast<uint64_t>(depthStencilFormat_));
+
+	// InputLayout
+	hash = Hash::Combine(hash, inputElements_.size());
+	for (const auto& element : inputElements_) {
+		hash = Hash::Combine(hash, element.semanticName.size());
+		hash = Hash::String(element.semanticName, hash);
+		hash = Hash::Combine(hash, element.semanticIndex);
+		hash = Hash::Combine(hash, static_cast<uint64_t>(element.format));
+		hash = Hash::Combine(hash, element.inputSlot);
+		hash = Hash::Combine(hash, element.alignedByteOffset);
+		hash = Hash::Combine(hash, static_cast<uint64_t>(element.inputSlotClass));
+		hash = Hash::Combine(hash, element.instanceDataStepRate);
+	}
+
+	return hash;
+}
+
+bool PSODescriptor::operator==(const PSODescriptor& other) const {
+	return vertexShader_ == other.vertexShader_ &&
+		pixelShader_ == other.pixelShader_ &&
+		blendMode_ == other.blendMode_ &&
+		cullMode_ == other.cullMode_ &&
+		fillMode_ == other.fillMode_ &&
+		depthEnable_ == other.depthEnable_ &&
+		depthWriteEnable_ == other.depthWriteEnable_ &&
+		depthFunc_ == other.depthFunc_ &&
+		topologyType_ == other.topologyType_ &&
+		renderTargetFormat_ == other.renderTargetFormat_ &&
+		depthStencilFormat_ == other.depthStencilFormat_ &&
+		inputElements_ == other.inputElements_;
+}
@@ -38,6 +38,8 @@ public:
 		std::wstring filePath;					// シェーダーファイルパス
 		std::wstring entryPoint = L"main";		// エントリーポイント名
 		std::wstring target;					// シェーダーターゲット（"vs_6_0", "ps_6_0"など）
+
+		bool operator==(const ShaderInfo& other) const = default;
 	};
 
 	/// <summary>
@@ -51,6 +53,8 @@ public:
 		uint32_t alignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT; // バイトオフセット
 		D3D12_INPUT_CLASSIFICATION inputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA; // 頂点データかインスタンスデータか
 		uint32_t instanceDataStepRate = 0;		// インスタンスデータのステップレート
+
+		bool operator==(const InputElement& other) const = default;
 	};
 
 public:
@@ -67,6 +71,11 @@ public:
 	/// </summary>
 	static PSODescriptor CreateSprite();
 
+	/// <summary>
+	/// スプライトの一括描画用のデフォルト設定を作成
+	/// </summary>
+	static PSODescriptor CreateSpriteBatch();
+
 	/// <summary>
 	/// 線分描画用のデフォルト設定を作成
 	/// </summary>
@@ -181,6 +190,17 @@ public:
 	DXGI_FORMAT GetDepthStencilFormat() const { return depthStencilFormat_; }
 	size_t GetInputElementCount() const { return inputElements_.size(); }
 
+	/// <summary>
+	/// 設定内容全体のハッシュ値を計算（同じ設定なら常に同じ値）
+	/// 実行ごとに変わる値（ポインタなど）は含めないので、ディスクキャッシュのキーに使える
+	/// </summary>
+	uint64_t ComputeHash() const;
+
+	/// <summary>
+	/// 設定内容が全て同じかどうか（ComputeHash()に含める項目と同じものを比較する）
+	/// </summary>
+	bool operator==(const PSODescriptor& other) const;
+
 private:
 	// シェーダー情報
 	ShaderInfo vertexShader_;
@@ -205,7 +225,4 @@ private:
 
 	// InputLayout要素
 	std::vector<InputElement> inputElements_;
-
-	// InputElement用の文字列を保持（D3D12_INPUT_ELEMENT_DESCが文字列ポインタを保持するため）
-	mutable std::vector<std::string> semanticNames_;
 };
\ No newline at end of file
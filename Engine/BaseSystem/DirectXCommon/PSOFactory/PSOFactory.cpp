@@ -2,6 +2,38 @@
 #include <format>
 #include <cassert>
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include "BaseSystem/Hash/Hash.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/DirectXCommon/ShaderCache/ShaderHasher.h"
+#include "BaseSystem/DirectXCommon/ShaderCache/ShaderIncludeHandler.h"
+#include "PipelineStateCache.h"
+#include <algorithm>
+
+namespace {
+	/// <summary>
+	/// スレッドごとのDXC（IDxcCompiler3とIncludeHandlerはスレッド間で共有できないため）
+	/// </summary>
+	struct ThreadDxc {
+		Microsoft::WRL::ComPtr<IDxcUtils> utils;
+		Microsoft::WRL::ComPtr<IDxcCompiler3> compiler;
+		Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler;
+	};
+
+	ThreadDxc& GetThreadDxc() {
+		thread_local ThreadDxc dxc;
+		if (!dxc.utils) {
+			HRESULT hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxc.utils));
+			assert(SUCCEEDED(hr));
+			hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxc.compiler));
+			assert(SUCCEEDED(hr));
+			// includeはメインスレッドと同じく、アーカイブも見るハンドラーで読む
+			dxc.includeHandler = Microsoft::WRL::Make<ShaderIncludeHandler>(dxc.utils);
+			assert(dxc.includeHandler);
+		}
+		return dxc;
+	}
+}
 
 void PSOFactory::Initialize(ID3D12Device* device,
 	IDxcUtils* dxcUtils,
@@ -39,7 +71,7 @@ PSOFactory::PSOInfo PSOFactory::CreatePSO(const PSODescriptor& descriptor,
 	}
 
 	// PipelineStateを作成
-	result.pipelineState = CreatePSO(descriptor, result.rootSignature.Get());
+	result.pipelineState = CreatePSO(descriptor, result.rootSignature.Get(), rootSignatureBuilder.ComputeHash());
 	if (!result.pipelineState) {
 		Logger::Log(Logger::GetStream(), "PSOFactory: Failed to create PipelineState\n");
 		result.rootSignature.Reset();  // 失敗時はRootSignatureも無効化
@@ -51,7 +83,8 @@ PSOFactory::PSOInfo PSOFactory::CreatePSO(const PSODescriptor& descriptor,
 
 Microsoft::WRL::ComPtr<ID3D12PipelineState> PSOFactory::CreatePSO(
 	const PSODescriptor& descriptor,
-	ID3D12RootSignature* existingRootSignature) {
+	ID3D12RootSignature* existingRootSignature,
+	uint64_t rootSignatureHash) {
 
 	if (!isInitialized_ || !existingRootSignature) {
 		Logger::Log(Logger::GetStream(), "PSOFactory: Error - Invalid parameters\n");
@@ -59,26 +92,24 @@ Microsoft::WRL::ComPtr<ID3D12PipelineState> PSOFactory::CreatePSO(
 	}
 
 	// シェーダーをコンパイル
-	auto vertexShaderBlob = DirectXCommon::CompileShader(
-		descriptor.GetVertexShader().filePath,
-		descriptor.GetVertexShader().target.c_str(),
-		dxcUtils_,
-		dxcCompiler_,
-		includeHandler_);
-
-	auto pixelShaderBlob = DirectXCommon::CompileShader(
-		descriptor.GetPixelShader().filePath,
-		descriptor.GetPixelShader().target.c_str(),
-		dxcUtils_,
-		dxcCompiler_,
-		includeHandler_);
-
+	auto vertexShaderBlob = CompileShader(descriptor.GetVertexShader(), dxcUtils_, dxcCompiler_, includeHandler_);
+	auto pixelShaderBlob = CompileShader(descriptor.GetPixelShader(), dxcUtils_, dxcCompiler_, includeHandler_);
 
 	if (!vertexShaderBlob || !pixelShaderBlob) {
 		Logger::Log(Logger::GetStream(), "PSOFactory: Failed to compile shaders\n");
 		return nullptr;
 	}
 
+	return CreatePipelineState(descriptor, existingRootSignature, rootSignatureHash, vertexShaderBlob.Get(), pixelShaderBlob.Get());
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> PSOFactory::CreatePipelineState(
+	const PSODescriptor& descriptor,
+	ID3D12RootSignature* rootSignature,
+	uint64_t rootSignatureHash,
+	IDxcBlob* vertexShaderBlob,
+	IDxcBlob* pixelShaderBlob) {
+
 	// InputLayoutを取得
 	auto inputElementDescs = descriptor.CreateInputElementDescs();
 	D3D12_INPUT_LAYOUT_DESC inputLayoutDesc{};
@@ -89,7 +120,7 @@ Microsoft::WRL::ComPtr<ID3D12PipelineState> PSOFactory::CreatePSO(
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
 
 	// RootSignature
-	pipelineDesc.pRootSignature = existingRootSignature;
+	pipelineDesc.pRootSignature = rootSignature;
 
 	// シェーダー
 	pipelineDesc.VS = {
@@ -126,18 +157,305 @@ Microsoft::WRL::ComPtr<ID3D12PipelineState> PSOFactory::CreatePSO(
 	pipelineDesc.CachedPSO = { nullptr, 0 };
 	pipelineDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
+	// ディスクキャッシュを探す（RootSignatureのハッシュが分からない場合は使わない）
+	PipelineStateCache* pipelineCache = PipelineStateCache::GetInstance();
+	const bool useDiskCache = (rootSignatureHash != 0) && pipelineCache->IsEnabled();
+	uint64_t cacheKey = 0;
+	std::vector<uint8_t> cachedData;
+	if (useDiskCache) {
+		cacheKey = PipelineStateCache::ComputeKey(descriptor.ComputeHash(), rootSignatureHash,
+			pipelineDesc.VS.pShaderBytecode, pipelineDesc.VS.BytecodeLength,
+			pipelineDesc.PS.pShaderBytecode, pipelineDesc.PS.BytecodeLength);
+		if (pipelineCache->Load(cacheKey, cachedData)) {
+			pipelineDesc.CachedPSO = { cachedData.data(), cachedData.size() };
+		}
+	}
+
 	// PipelineStateを作成
 	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
 	HRESULT hr = device_->CreateGraphicsPipelineState(
 		&pipelineDesc,
 		IID_PPV_ARGS(&pipelineState));
 
+	// キャッシュが弾かれた場合（ドライバやGPUが変わったなど）はキャッシュなしで作り直す
+	bool isFromCache = (pipelineDesc.CachedPSO.pCachedBlob != nullptr);
+	if (FAILED(hr) && isFromCache) {
+		Logger::Log(Logger::GetStream(),
+			std::format("PSOFactory: Cached PipelineState rejected (HRESULT: 0x{:08X}), rebuilding\n", hr));
+		pipelineCache->AddReject();
+		pipelineCache->Remove(cacheKey);
+		pipelineDesc.CachedPSO = { nullptr, 0 };
+		isFromCache = false;
+		hr = device_->CreateGraphicsPipelineState(
+			&pipelineDesc,
+			IID_PPV_ARGS(&pipelineState));
+	}
+
 	if (FAILED(hr)) {
 		Logger::Log(Logger::GetStream(),
 			std::format("PSOFactory: Failed to create PipelineState (HRESULT: 0x{:08X})\n", hr));
 		return nullptr;
 	}
 
-	Logger::Log(Logger::GetStream(), "PSOFactory: Successfully created PipelineState\n");
+	// 新しく作った場合はディスクに保存
+	if (useDiskCache && !isFromCache) {
+		Microsoft::WRL::ComPtr<ID3DBlob> cachedBlob;
+		if (SUCCEEDED(pipelineState->GetCachedBlob(&cachedBlob)) && cachedBlob) {
+			pipelineCache->Store(cacheKey, cachedBlob->GetBufferPointer(), cachedBlob->GetBufferSize());
+		}
+	}
+
+	Logger::Log(Logger::GetStream(), isFromCache ?
+		"PSOFactory: Successfully created PipelineState (from cache)\n" :
+		"PSOFactory: Successfully created PipelineState\n");
 	return pipelineState;
 }
+
+std::vector<PSOFactory::PSOInfo> PSOFactory::CreatePSOBatch(const std::vector<BatchRequest>& requests) {
+	std::vector<PSOInfo> results(requests.size());
+
+	if (!isInitialized_) {
+		Logger::Log(Logger::GetStream(), "PSOFactory: Error - Not initialized\n");
+		return results;
+	}
+
+	///*-----------------------------------------------------------------------*///
+	///						重複を取り除いた生成リストを作る						///
+	///*-----------------------------------------------------------------------*///
+
+	// RootSignature（設定が同じものは1つを共有）
+	std::vector<RootSignatureBuilder*> uniqueRootSignatures;
+	std::vector<uint64_t> rootSignatureHashes;
+	std::unordered_map<uint64_t, size_t> rootSignatureIndices;
+	// シェーダー（同じファイル・ターゲットは1度だけコンパイル）
+	std::vector<const PSODescriptor::ShaderInfo*> uniqueShaders;
+	std::unordered_map<uint64_t, size_t> shaderIndices;
+	// PSO（PSODescriptorとRootSignatureの両方が同じものは1つを共有）
+	struct UniquePSO {
+		const PSODescriptor* descriptor;
+		size_t rootSignatureIndex;
+		size_t vertexShaderIndex;
+		size_t pixelShaderIndex;
+	};
+	std::vector<UniquePSO> uniquePSOs;
+	std::unordered_map<uint64_t, size_t> psoIndices;
+	std::vector<size_t> requestToPSO(requests.size(), SIZE_MAX);
+
+	auto registerShader = [&](const PSODescriptor::ShaderInfo& shader) {
+		uint64_t key = ComputeShaderKey(shader);
+		auto it = shaderIndices.find(key);
+		if (it != shaderIndices.end()) {
+			return it->second;
+		}
+		uniqueShaders.push_back(&shader);
+		shaderIndices[key] = uniqueShaders.size() - 1;
+		return uniqueShaders.size() - 1;
+	};
+
+	for (size_t i = 0; i < requests.size(); ++i) {
+		const BatchRequest& request = requests[i];
+		if (!request.descriptor || !request.rootSignatureBuilder) {
+			Logger::Log(Logger::GetStream(), std::format("PSOFactory: Batch request {} is invalid\n", i));
+			continue;
+		}
+
+		const uint64_t rootSignatureHash = request.rootSignatureBuilder->ComputeHash();
+		const uint64_t psoHash = Hash::Combine(request.descriptor->ComputeHash(), rootSignatureHash);
+
+		auto psoIt = psoIndices.find(psoHash);
+		if (psoIt != psoIndices.end()) {
+			requestToPSO[i] = psoIt->second;
+			continue;
+		}
+
+		auto rootSignatureIt = rootSignatureIndices.find(rootSignatureHash);
+		size_t rootSignatureIndex = 0;
+		if (rootSignatureIt != rootSignatureIndices.end()) {
+			rootSignatureIndex = rootSignatureIt->second;
+		} else {
+			uniqueRootSignatures.push_back(request.rootSignatureBuilder);
+			rootSignatureHashes.push_back(rootSignatureHash);
+			rootSignatureIndex = uniqueRootSignatures.size() - 1;
+			rootSignatureIndices[rootSignatureHash] = rootSignatureIndex;
+		}
+
+		UniquePSO unique{};
+		unique.descriptor = request.descriptor;
+		unique.rootSignatureIndex = rootSignatureIndex;
+		unique.vertexShaderIndex = registerShader(request.descriptor->GetVertexShader());
+		unique.pixelShaderIndex = registerShader(request.descriptor->GetPixelShader());
+		uniquePSOs.push_back(unique);
+		psoIndices[psoHash] = uniquePSOs.size() - 1;
+		requestToPSO[i] = uniquePSOs.size() - 1;
+	}
+
+	Logger::Log(Logger::GetStream(), std::format(
+		"PSOFactory: Batch {} requests -> {} PSOs, {} RootSignatures, {} shaders\n",
+		requests.size(), uniquePSOs.size(), uniqueRootSignatures.size(), uniqueShaders.size()));
+
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+
+	///*-----------------------------------------------------------------------*///
+	///					シェーダーとRootSignatureを並列に生成						///
+	///*-----------------------------------------------------------------------*///
+	std::vector<Microsoft::WRL::ComPtr<IDxcBlob>> shaderBlobs(uniqueShaders.size());
+	std::vector<Microsoft::WRL::ComPtr<ID3D12RootSignature>> rootSignatures(uniqueRootSignatures.size());
+
+	const uint32_t stageOneCount = static_cast<uint32_t>(uniqueShaders.size() + uniqueRootSignatures.size());
+	threadPool->ParallelFor(stageOneCount, [&](uint32_t index) {
+		if (index < uniqueShaders.size()) {
+			ThreadDxc& dxc = GetThreadDxc();
+			shaderBlobs[index] = CompileShader(*uniqueShaders[index],
+				dxc.utils.Get(), dxc.compiler.Get(), dxc.includeHandler.Get());
+		} else {
+			size_t rootSignatureIndex = index - uniqueShaders.size();
+			rootSignatures[rootSignatureIndex] = uniqueRootSignatures[rootSignatureIndex]->Build(device_);
+		}
+	});
+
+	///*-----------------------------------------------------------------------*///
+	///							PSOを並列に生成									///
+	///*-----------------------------------------------------------------------*///
+	std::vector<PSOInfo> uniqueResults(uniquePSOs.size());
+	threadPool->ParallelFor(static_cast<uint32_t>(uniquePSOs.size()), [&](uint32_t index) {
+		const UniquePSO& unique = uniquePSOs[index];
+		ID3D12RootSignature* rootSignature = rootSignatures[unique.rootSignatureIndex].Get();
+		IDxcBlob* vertexShaderBlob = shaderBlobs[unique.vertexShaderIndex].Get();
+		IDxcBlob* pixelShaderBlob = shaderBlobs[unique.pixelShaderIndex].Get();
+
+		if (!rootSignature || !vertexShaderBlob || !pixelShaderBlob) {
+			Logger::Log(Logger::GetStream(), "PSOFactory: Failed to prepare batch PSO\n");
+			return;
+		}
+
+		PSOInfo info;
+		info.rootSignature = rootSignatures[unique.rootSignatureIndex];
+		info.pipelineState = CreatePipelineState(*unique.descriptor, rootSignature,
+			rootSignatureHashes[unique.rootSignatureIndex], vertexShaderBlob, pixelShaderBlob);
+		if (info.pipelineState) {
+			uniqueResults[index] = info;
+		}
+	});
+
+	// リクエストの順番に並べ直す
+	for (size_t i = 0; i < requests.size(); ++i) {
+		if (requestToPSO[i] != SIZE_MAX) {
+			results[i] = uniqueResults[requestToPSO[i]];
+		}
+	}
+
+	return results;
+}
+
+void PSOFactory::ClearShaderBlobs() {
+	std::lock_guard<std::mutex> lock(shaderBlobMutex_);
+	shaderBlobs_.clear();
+}
+
+///*-----------------------------------------------------------------------*///
+//						ホットリロード											//
+///*-----------------------------------------------------------------------*///
+
+void PSOFactory::RegisterReload(const PSODescriptor& descriptor,
+	const Microsoft::WRL::ComPtr<ID3D12RootSignature>& rootSignature,
+	uint64_t rootSignatureHash,
+	Microsoft::WRL::ComPtr<ID3D12PipelineState>* pipelineState) {
+	assert(pipelineState && "PipelineState must not be null");
+	UnregisterReload(pipelineState);
+	reloadEntries_.push_back({ descriptor, rootSignature, rootSignatureHash, pipelineState });
+}
+
+void PSOFactory::UnregisterReload(const Microsoft::WRL::ComPtr<ID3D12PipelineState>* pipelineState) {
+	std::erase_if(reloadEntries_, [pipelineState](const ReloadEntry& entry) {
+		return entry.pipelineState == pipelineState;
+	});
+}
+
+uint32_t PSOFactory::ReloadShaderFile(const std::string& filename,
+	std::vector<Microsoft::WRL::ComPtr<ID3D12PipelineState>>& retiredPipelineStates) {
+	if (!isInitialized_) {
+		return 0;
+	}
+
+	// シェーダーごとに、書き換えたファイルを使っているか（include先も含めて）を1度だけ調べる
+	const std::string normalizedPath = AssetPack::NormalizePath(filename);
+	std::unordered_map<std::wstring, bool> usesChangedFile;
+	auto isAffected = [&](const PSODescriptor::ShaderInfo& shader) {
+		auto it = usesChangedFile.find(shader.filePath);
+		if (it != usesChangedFile.end()) {
+			return it->second;
+		}
+		const ShaderHasher::Key key = ShaderHasher::ComputeKey(shader.filePath, shader.entryPoint, shader.target, {});
+		const bool isUsed = std::any_of(key.dependencies.begin(), key.dependencies.end(), [&normalizedPath](const std::filesystem::path& path) {
+			return AssetPack::NormalizePath(path.generic_string()) == normalizedPath;
+		});
+		usesChangedFile.emplace(shader.filePath, isUsed);
+		return isUsed;
+	};
+
+	std::vector<ReloadEntry*> affectedEntries;
+	for (ReloadEntry& entry : reloadEntries_) {
+		if (isAffected(entry.descriptor.GetVertexShader()) || isAffected(entry.descriptor.GetPixelShader())) {
+			affectedEntries.push_back(&entry);
+		}
+	}
+	if (affectedEntries.empty()) {
+		return 0;
+	}
+
+	// メモリ上のコンパイル結果を捨てて作り直す（ディスクのキャッシュは中身のハッシュで引くので、書き換えたものは当たらない）
+	ClearShaderBlobs();
+	uint32_t reloadedCount = 0;
+	for (ReloadEntry* entry : affectedEntries) {
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState =
+			CreatePSO(entry->descriptor, entry->rootSignature.Get(), entry->rootSignatureHash);
+		if (!pipelineState) {
+			Logger::Log(Logger::GetStream(), std::format("PSOFactory: Failed to reload PSO for {}, keeping the previous one\n", filename));
+			continue;
+		}
+		retiredPipelineStates.push_back(std::move(*entry->pipelineState));
+		*entry->pipelineState = std::move(pipelineState);
+		++reloadedCount;
+	}
+
+	Logger::Log(Logger::GetStream(), std::format("PSOFactory: Reloaded {} / {} PSOs using {}\n", reloadedCount, affectedEntries.size(), filename));
+	return reloadedCount;
+}
+
+Microsoft::WRL::ComPtr<IDxcBlob> PSOFactory::CompileShader(const PSODescriptor::ShaderInfo& shader,
+	IDxcUtils* dxcUtils,
+	IDxcCompiler3* dxcCompiler,
+	IDxcIncludeHandler* includeHandler) {
+
+	const uint64_t key = ComputeShaderKey(shader);
+	{
+		std::lock_guard<std::mutex> lock(shaderBlobMutex_);
+		auto it = shaderBlobs_.find(key);
+		if (it != shaderBlobs_.end()) {
+			return it->second;
+		}
+	}
+
+	// コンパイル中はロックしない（別スレッドの別シェーダーを止めないように）
+	Microsoft::WRL::ComPtr<IDxcBlob> blob = DirectXCommon::CompileShader(
+		shader.filePath,
+		shader.target.c_str(),
+		dxcUtils,
+		dxcCompiler,
+		includeHandler);
+
+	if (blob) {
+		std::lock_guard<std::mutex> lock(shaderBlobMutex_);
+		shaderBlobs_[key] = blob;
+	}
+	return blob;
+}
+
+uint64_t PSOFactory::ComputeShaderKey(const PSODescriptor::ShaderInfo& shader) {
+	uint64_t hash = Hash::WString(shader.filePath);
+	hash = Hash::String("|", hash);
+	hash = Hash::WString(shader.entryPoint, hash);
+	hash = Hash::String("|", hash);
+	hash = Hash::WString(shader.target, hash);
+	return hash;
+}
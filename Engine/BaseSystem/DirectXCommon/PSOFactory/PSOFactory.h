@@ -4,6 +4,9 @@
 #include <wrl.h>
 #include <memory>
 #include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
 
 #include "PSODescriptor.h"
 #include "RootSignatureBuilder.h"
@@ -26,6 +29,14 @@ public:
 		}
 	};
 
+	/// <summary>
+	/// まとめて生成するときの1件分の設定（中身は呼び出し側が保持する）
+	/// </summary>
+	struct BatchRequest {
+		const PSODescriptor* descriptor = nullptr;
+		RootSignatureBuilder* rootSignatureBuilder = nullptr;
+	};
+
 public:
 	PSOFactory() = default;
 	~PSOFactory() = default;
@@ -56,10 +67,89 @@ public:
 	/// </summary>
 	/// <param name="descriptor">PSO設定</param>
 	/// <param name="existingRootSignature">既存のRootSignature</param>
+	/// <param name="rootSignatureHash">RootSignatureBuilder::ComputeHash()の値（0の場合はディスクキャッシュを使わない）</param>
 	/// <returns>作成されたPipelineState</returns>
 	Microsoft::WRL::ComPtr<ID3D12PipelineState> CreatePSO(
 		const PSODescriptor& descriptor,
-		ID3D12RootSignature* existingRootSignature);
+		ID3D12RootSignature* existingRootSignature,
+		uint64_t rootSignatureHash = 0);
+
+	/// <summary>
+	/// 複数のPSOをまとめて作成
+	/// シェーダーのコンパイルとPSOの生成をスレッドプールで並列に行う
+	/// 同じ設定（ハッシュが一致するもの）は1度だけ生成して共有する
+	/// </summary>
+	/// <param name="requests">生成するPSOの設定一覧</param>
+	/// <returns>requestsと同じ順番のPSO情報</returns>
+	std::vector<PSOInfo> CreatePSOBatch(const std::vector<BatchRequest>& requests);
+
+	/// <summary>
+	/// メモリ上のコンパイル済みシェーダーを破棄（シェーダーを書き換えた後に呼ぶ）
+	/// </summary>
+	void ClearShaderBlobs();
+
+	///*-----------------------------------------------------------------------*///
+	//						ホットリロード											//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// シェーダーを書き換えた時に作り直すPSOとして登録する
+	/// 登録したpipelineStateは、ReloadShaderFileで作り直せた時だけ新しいものに置き換わる（コンパイルエラーの間は今のものを使い続ける）
+	/// RootSignatureとPSOの設定はそのまま使うので、ルート引数や入力レイアウトを変えた場合は再起動が必要
+	/// 同じpipelineStateを登録し直すと上書きする。持ち主を破棄する前にUnregisterReloadで外す
+	/// </summary>
+	/// <param name="descriptor">PSO設定（コピーして持つ）</param>
+	/// <param name="rootSignature">PSOを作ったRootSignature</param>
+	/// <param name="rootSignatureHash">RootSignatureBuilder::ComputeHash()の値</param>
+	/// <param name="pipelineState">作り直したPSOを入れる先</param>
+	void RegisterReload(const PSODescriptor& descriptor,
+		const Microsoft::WRL::ComPtr<ID3D12RootSignature>& rootSignature,
+		uint64_t rootSignatureHash,
+		Microsoft::WRL::ComPtr<ID3D12PipelineState>* pipelineState);
+
+	/// <summary>
+	/// 作り直すPSOの登録を外す
+	/// </summary>
+	void UnregisterReload(const Microsoft::WRL::ComPtr<ID3D12PipelineState>* pipelineState);
+
+	/// <summary>
+	/// 書き換えたシェーダーのファイルを使っている登録済みのPSOを作り直す（includeしているファイルも辿る）
+	/// </summary>
+	/// <param name="filename">書き換えたファイル（.hlsl・.hlsli）のパス</param>
+	/// <param name="retiredPipelineStates">置き換えた古いPSOの追加先（前のフレームの描画が使っているので、GPUが使い終わるまで呼び出し側で保持する）</param>
+	/// <returns>作り直したPSOの数</returns>
+	uint32_t ReloadShaderFile(const std::string& filename,
+		std::vector<Microsoft::WRL::ComPtr<ID3D12PipelineState>>& retiredPipelineStates);
+
+	/// <summary>
+	/// 作り直すPSOとして登録している数
+	/// </summary>
+	size_t GetReloadEntryCount() const { return reloadEntries_.size(); }
+
+private:
+	/// <summary>
+	/// シェーダーをコンパイル（同じシェーダーはメモリ上の結果を使い回す）
+	/// </summary>
+	Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const PSODescriptor::ShaderInfo& shader,
+		IDxcUtils* dxcUtils,
+		IDxcCompiler3* dxcCompiler,
+		IDxcIncludeHandler* includeHandler);
+
+	/// <summary>
+	/// コンパイル済みのシェーダーからPipelineStateを作成
+	/// PipelineStateCacheにキャッシュがあれば使い、無ければ作成後に保存する
+	/// </summary>
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> CreatePipelineState(
+		const PSODescriptor& descriptor,
+		ID3D12RootSignature* rootSignature,
+		uint64_t rootSignatureHash,
+		IDxcBlob* vertexShaderBlob,
+		IDxcBlob* pixelShaderBlob);
+
+	/// <summary>
+	/// シェーダーを識別するキー
+	/// </summary>
+	static uint64_t ComputeShaderKey(const PSODescriptor::ShaderInfo& shader);
 
 private:
 	// D3D12関連
@@ -70,6 +160,21 @@ private:
 	IDxcCompiler3* dxcCompiler_ = nullptr;
 	IDxcIncludeHandler* includeHandler_ = nullptr;
 
+	// コンパイル済みシェーダー（ファイル・エントリーポイント・ターゲットごと）
+	std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<IDxcBlob>> shaderBlobs_;
+	std::mutex shaderBlobMutex_;
+
+	/// <summary>
+	/// シェーダーを書き換えた時に作り直すPSO
+	/// </summary>
+	struct ReloadEntry {
+		PSODescriptor descriptor;
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+		uint64_t rootSignatureHash = 0;
+		Microsoft::WRL::ComPtr<ID3D12PipelineState>* pipelineState = nullptr;
+	};
+	std::vector<ReloadEntry> reloadEntries_;
+
 	// 初期化フラグ
 	bool isInitialized_ = false;
 };
\ No newline at end of file
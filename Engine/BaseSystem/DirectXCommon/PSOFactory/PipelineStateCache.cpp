@@ -0,0 +1,116 @@
+#include "PipelineStateCache.h"
+#include "BaseSystem/Hash/Hash.h"
+#include <fstream>
+#include <format>
+#include <thread>
+
+PipelineStateCache* PipelineStateCache::GetInstance() {
+	static PipelineStateCache instance;
+	return &instance;
+}
+
+uint64_t PipelineStateCache::ComputeKey(uint64_t descriptorHash,
+	uint64_t rootSignatureHash,
+	const void* vertexShader, size_t vertexShaderSize,
+	const void* pixelShader, size_t pixelShaderSize) {
+
+	// キー形式のバージョンから積む
+	uint64_t key = Hash::Value(kVersion);
+	key = Hash::Combine(key, descriptorHash);
+	key = Hash::Combine(key, rootSignatureHash);
+
+	// シェーダーはバイトコードそのものを積む（includeしたファイルの変更もここで拾える）
+	key = Hash::Combine(key, vertexShaderSize);
+	key = Hash::Bytes(vertexShader, vertexShaderSize, key);
+	key = Hash::Combine(key, pixelShaderSize);
+	key = Hash::Bytes(pixelShader, pixelShaderSize, key);
+	return key;
+}
+
+std::filesystem::path PipelineStateCache::GetFilePath(uint64_t key) const {
+	return directory_ / std::format("{:016x}.pso", key);
+}
+
+bool PipelineStateCache::Load(uint64_t key, std::vector<uint8_t>& outData) {
+	if (!isEnabled_) {
+		++missCount_;
+		return false;
+	}
+
+	std::ifstream file(GetFilePath(key), std::ios::binary);
+	if (!file.is_open()) {
+		++missCount_;
+		return false;
+	}
+
+	// ヘッダを検証（壊れたファイルや別形式のファイルはミス扱い）
+	FileHeader header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || header.magic != kMagic || header.version != kVersion || header.key != key || header.size == 0) {
+		++missCount_;
+		return false;
+	}
+
+	outData.resize(static_cast<size_t>(header.size));
+	file.read(reinterpret_cast<char*>(outData.data()), static_cast<std::streamsize>(header.size));
+	if (static_cast<uint64_t>(file.gcount()) != header.size) {
+		outData.clear();
+		++missCount_;
+		return false;
+	}
+
+	++hitCount_;
+	return true;
+}
+
+bool PipelineStateCache::Store(uint64_t key, const void* data, size_t size) {
+	if (!isEnabled_ || data == nullptr || size == 0) {
+		return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(directory_, ec);
+
+	// 一時ファイルに書いてから置き換える（書き込み途中のファイルを他スレッドに読ませない）
+	const std::filesystem::path finalPath = GetFilePath(key);
+	std::filesystem::path tempPath = finalPath;
+	tempPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		FileHeader header{ kMagic, kVersion, key, static_cast<uint64_t>(size) };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		if (!file) {
+			file.close();
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, finalPath, ec);
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
+
+void PipelineStateCache::Remove(uint64_t key) {
+	std::error_code ec;
+	std::filesystem::remove(GetFilePath(key), ec);
+}
+
+void PipelineStateCache::Clear() {
+	std::error_code ec;
+	if (!std::filesystem::is_directory(directory_, ec)) {
+		return;
+	}
+	for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+		if (entry.path().extension() == ".pso") {
+			std::filesystem::remove(entry.path(), ec);
+		}
+	}
+}
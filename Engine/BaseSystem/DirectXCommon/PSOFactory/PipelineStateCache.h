@@ -0,0 +1,115 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <filesystem>
+
+/// <summary>
+/// PipelineStateのキャッシュ済みバイナリ（GetCachedBlob）をディスクに保存するキャッシュ
+/// キーはPSODescriptor・RootSignature・シェーダーバイトコードのハッシュを合成したもの
+/// ドライバが変わった場合などはPSO生成時に弾かれるので、PSOFactory側で作り直して上書きする
+/// 複数スレッドから同時に読み書きしてもよい
+/// </summary>
+class PipelineStateCache {
+public:
+	// デフォルトの保存先（実行時のカレントディレクトリ基準）
+	static constexpr const char* kDefaultDirectory = "PipelineCache";
+
+	//シングルトン
+	static PipelineStateCache* GetInstance();
+
+	/// <summary>
+	/// キャッシュキーを計算
+	/// </summary>
+	/// <param name="descriptorHash">PSODescriptor::ComputeHash()の値</param>
+	/// <param name="rootSignatureHash">RootSignatureBuilder::ComputeHash()の値</param>
+	/// <param name="vertexShader">頂点シェーダーのバイトコード</param>
+	/// <param name="vertexShaderSize">頂点シェーダーのサイズ</param>
+	/// <param name="pixelShader">ピクセルシェーダーのバイトコード</param>
+	/// <param name="pixelShaderSize">ピクセルシェーダーのサイズ</param>
+	/// <returns>キャッシュキー</returns>
+	static uint64_t ComputeKey(uint64_t descriptorHash,
+		uint64_t rootSignatureHash,
+		const void* vertexShader, size_t vertexShaderSize,
+		const void* pixelShader, size_t pixelShaderSize);
+
+	/// <summary>
+	/// 保存先ディレクトリを設定
+	/// </summary>
+	void SetDirectory(const std::filesystem::path& directory) { directory_ = directory; }
+	const std::filesystem::path& GetDirectory() const { return directory_; }
+
+	/// <summary>
+	/// キャッシュの有効/無効（無効の時は常にミス扱い、保存もしない）
+	/// </summary>
+	void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+	bool IsEnabled() const { return isEnabled_; }
+
+	/// <summary>
+	/// キャッシュからバイナリを読み込む
+	/// </summary>
+	/// <param name="key">キャッシュキー</param>
+	/// <param name="outData">読み込んだバイナリ</param>
+	/// <returns>ヒットした場合true</returns>
+	bool Load(uint64_t key, std::vector<uint8_t>& outData);
+
+	/// <summary>
+	/// バイナリをキャッシュに保存
+	/// </summary>
+	/// <param name="key">キャッシュキー</param>
+	/// <param name="data">バイナリの先頭</param>
+	/// <param name="size">バイナリのサイズ</param>
+	/// <returns>保存に成功した場合true</returns>
+	bool Store(uint64_t key, const void* data, size_t size);
+
+	/// <summary>
+	/// 指定したキーのキャッシュを削除（ドライバに弾かれた時など）
+	/// </summary>
+	void Remove(uint64_t key);
+
+	/// <summary>
+	/// 保存されているキャッシュファイルを全て削除
+	/// </summary>
+	void Clear();
+
+	// 統計
+	uint32_t GetHitCount() const { return hitCount_.load(); }
+	uint32_t GetMissCount() const { return missCount_.load(); }
+	uint32_t GetRejectCount() const { return rejectCount_.load(); }
+
+	/// <summary>
+	/// ドライバに弾かれた回数を加算
+	/// </summary>
+	void AddReject() { ++rejectCount_; }
+
+	/// <summary>
+	/// キーに対応するファイルパス
+	/// </summary>
+	std::filesystem::path GetFilePath(uint64_t key) const;
+
+private:
+	// コンストラクタ
+	PipelineStateCache() = default;
+	~PipelineStateCache() = default;
+	PipelineStateCache(const PipelineStateCache&) = delete;
+	PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+	/// <summary>
+	/// キャッシュファイルのヘッダ
+	/// </summary>
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t key;
+		uint64_t size;
+	};
+	static const uint32_t kMagic = 0x31435350;	// "PSC1"
+	static const uint32_t kVersion = 1;
+
+	std::filesystem::path directory_ = kDefaultDirectory;
+	bool isEnabled_ = true;
+
+	std::atomic<uint32_t> hitCount_ = 0;
+	std::atomic<uint32_t> missCount_ = 0;
+	std::atomic<uint32_t> rejectCount_ = 0;
+};
@@ -1,5 +1,7 @@
 #include "RootSignatureBuilder.h"
 #include <format>
+#include <cstring>
+#include "BaseSystem/Hash/Hash.h"
 
 RootSignatureBuilder& RootSignatureBuilder::AddCBV(uint32_t shaderRegister,
 	D3D12_SHADER_VISIBILITY visibility) {
@@ -18,6 +20,43 @@ RootSignatureBuilder& RootSignatureBuilder::AddCBV(uint32_t shaderRegister,
 	return *this;
 }
 
+RootSignatureBuilder& RootSignatureBuilder::AddConstants(uint32_t shaderRegister,
+	uint32_t num32BitValues,
+	D3D12_SHADER_VISIBILITY visibility) {
+	D3D12_ROOT_PARAMETER param{};
+	param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	param.Constants.ShaderRegister = shaderRegister;
+	param.Constants.RegisterSpace = 0;
+	param.Constants.Num32BitValues = num32BitValues;
+	param.ShaderVisibility = visibility;
+
+	rootParameters_.push_back(param);
+
+	Logger::Log(Logger::GetStream(),
+		std::format("RootSignatureBuilder: Added Constants (b{}, count:{}) at parameter index {}\n",
+			shaderRegister, num32BitValues, rootParameters_.size() - 1));
+
+	return *this;
+}
+
+RootSignatureBuilder& RootSignatureBuilder::AddRootSRV(uint32_t shaderRegister,
+	D3D12_SHADER_VISIBILITY visibility,
+	uint32_t registerSpace) {
+	D3D12_ROOT_PARAMETER param{};
+	param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	param.Descriptor.ShaderRegister = shaderRegister;
+	param.Descriptor.RegisterSpace = registerSpace;
+	param.ShaderVisibility = visibility;
+
+	rootParameters_.push_back(param);
+
+	Logger::Log(Logger::GetStream(),
+		std::format("RootSignatureBuilder: Added Root SRV (t{}, space{}) at parameter index {}\n",
+			shaderRegister, registerSpace, rootParameters_.size() - 1));
+
+	return *this;
+}
+
 RootSignatureBuilder& RootSignatureBuilder::AddSRV(uint32_t baseShaderRegister,
 	uint32_t count,
 	D3D12_SHADER_VISIBILITY visibility) {
@@ -185,4 +224,68 @@ void RootSignatureBuilder::UpdateDescriptorTablePointers() {
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+uint64_t RootSignatureBuilder::ComputeHash() const {
+	uint64_t hash = Hash::kOffsetBasis;
+
+	// float値はビット列として積む
+	auto floatBits = [](float value) {
+		uint32_t bits = 0;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return static_cast<uint64_t>(bits);
+	};
+
+	// RootParameter（ポインタは含めず中身を積む）
+	hash = Hash::Combine(hash, rootParameters_.size());
+	for (const auto& param : rootParameters_) {
+		hash = Hash::Combine(hash, static_cast<uint64_t>(param.ParameterType));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(param.ShaderVisibility));
+
+		switch (param.ParameterType) {
+		case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+			hash = Hash::Combine(hash, param.DescriptorTable.NumDescriptorRanges);
+			for (UINT i = 0; i < param.DescriptorTable.NumDescriptorRanges; ++i) {
+				const D3D12_DESCRIPTOR_RANGE& range = param.DescriptorTable.pDescriptorRanges[i];
+				hash = Hash::Combine(hash, static_cast<uint64_t>(range.RangeType));
+				hash = Hash::Combine(hash, range.NumDescriptors);
+				hash = Hash::Combine(hash, range.BaseShaderRegister);
+				hash = Hash::Combine(hash, range.RegisterSpace);
+				hash = Hash::Combine(hash, range.OffsetInDescriptorsFromTableStart);
+			}
+			break;
+		case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+			hash = Hash::Combine(hash, param.Constants.ShaderRegister);
+			hash = Hash::Combine(hash, param.Constants.RegisterSpace);
+			hash = Hash::Combine(hash, param.Constants.Num32BitValues);
+			break;
+		default:
+			hash = Hash::Combine(hash, param.Descriptor.ShaderRegister);
+			hash = Hash::Combine(hash, param.Descriptor.RegisterSpace);
+			break;
+		}
+	}
+
+	// Static Sampler
+	hash = Hash::Combine(hash, staticSamplers_.size());
+	for (const auto& sampler : staticSamplers_) {
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.Filter));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.AddressU));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.AddressV));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.AddressW));
+		hash = Hash::Combine(hash, floatBits(sampler.MipLODBias));
+		hash = Hash::Combine(hash, sampler.MaxAnisotropy);
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.ComparisonFunc));
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.BorderColor));
+		hash = Hash::Combine(hash, floatBits(sampler.MinLOD));
+		hash = Hash::Combine(hash, floatBits(sampler.MaxLOD));
+		hash = Hash::Combine(hash, sampler.ShaderRegister);
+		hash = Hash::Combine(hash, sampler.RegisterSpace);
+		hash = Hash::Combine(hash, static_cast<uint64_t>(sampler.ShaderVisibility));
+	}
+
+	// フラグ
+	hash = Hash::Combine(hash, static_cast<uint64_t>(flags_));
+
+	return hash;
+}
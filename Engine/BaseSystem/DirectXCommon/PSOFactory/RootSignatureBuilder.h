@@ -22,6 +22,26 @@ public:
 	RootSignatureBuilder& AddCBV(uint32_t shaderRegister,
 		D3D12_SHADER_VISIBILITY visibility);
 
+	/// <summary>
+	/// ルート定数（32bit値をルート引数に直接置く）を追加
+	/// </summary>
+	/// <param name="shaderRegister">シェーダーレジスタ番号（b0, b1など）</param>
+	/// <param name="num32BitValues">32bit値の数</param>
+	/// <param name="visibility">シェーダーの可視性</param>
+	RootSignatureBuilder& AddConstants(uint32_t shaderRegister,
+		uint32_t num32BitValues,
+		D3D12_SHADER_VISIBILITY visibility);
+
+	/// <summary>
+	/// ShaderResourceViewをルート引数に直接追加（StructuredBufferなどのバッファ用、ディスクリプタ不要）
+	/// </summary>
+	/// <param name="shaderRegister">シェーダーレジスタ番号（t0, t1など）</param>
+	/// <param name="visibility">シェーダーの可視性</param>
+	/// <param name="registerSpace">レジスタスペース（テクスチャのテーブルと番号を分けたい時に使う）</param>
+	RootSignatureBuilder& AddRootSRV(uint32_t shaderRegister,
+		D3D12_SHADER_VISIBILITY visibility,
+		uint32_t registerSpace = 0);
+
 	/// <summary>
 	/// ShaderResourceViewのDescriptorTableを追加
 	/// </summary>
@@ -71,6 +91,11 @@ public:
 	/// </summary>
 	size_t GetParameterCount() const { return rootParameters_.size(); }
 
+	/// <summary>
+	/// 設定内容のハッシュ値を計算（同じ設定なら常に同じ値）
+	/// </summary>
+	uint64_t ComputeHash() const;
+
 private:
 	/// <summary>
 	/// DescriptorRangeを保持する構造体
@@ -0,0 +1,45 @@
+#include "D3D12RenderCommandList.h"
+
+void D3D12RenderCommandList::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) {
+	commandList_->SetGraphicsRootSignature(rootSignature);
+}
+
+void D3D12RenderCommandList::SetPipelineState(ID3D12PipelineState* pipelineState) {
+	commandList_->SetPipelineState(pipelineState);
+}
+
+void D3D12RenderCommandList::IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) {
+	commandList_->IASetPrimitiveTopology(topology);
+}
+
+void D3D12RenderCommandList::IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) {
+	commandList_->IASetVertexBuffers(startSlot, numViews, views);
+}
+
+void D3D12RenderCommandList::IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) {
+	commandList_->IASetIndexBuffer(view);
+}
+
+void D3D12RenderCommandList::SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) {
+	commandList_->SetGraphicsRootConstantBufferView(rootParameterIndex, address);
+}
+
+void D3D12RenderCommandList::SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) {
+	commandList_->SetGraphicsRootDescriptorTable(rootParameterIndex, handle);
+}
+
+void D3D12RenderCommandList::SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) {
+	commandList_->SetGraphicsRootShaderResourceView(rootParameterIndex, address);
+}
+
+void D3D12RenderCommandList::SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) {
+	commandList_->SetGraphicsRoot32BitConstant(rootParameterIndex, srcData, destOffsetIn32BitValues);
+}
+
+void D3D12RenderCommandList::DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance) {
+	commandList_->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+}
+
+void D3D12RenderCommandList::DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) {
+	commandList_->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "RenderCommandList.h"
+
+/// <summary>
+/// ID3D12GraphicsCommandListにそのまま積むバックエンド
+/// </summary>
+class D3D12RenderCommandList : public RenderCommandList {
+public:
+	D3D12RenderCommandList() = default;
+	~D3D12RenderCommandList() override = default;
+
+	/// <summary>
+	/// 積む先のコマンドリストを設定
+	/// </summary>
+	void SetCommandList(ID3D12GraphicsCommandList* commandList) { commandList_ = commandList; }
+	ID3D12GraphicsCommandList* GetCommandList() const { return commandList_; }
+
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) override;
+	void SetPipelineState(ID3D12PipelineState* pipelineState) override;
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) override;
+	void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) override;
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) override;
+	void SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) override;
+	void SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) override;
+	void DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance) override;
+	void DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) override;
+
+private:
+	ID3D12GraphicsCommandList* commandList_ = nullptr;
+};
@@ -0,0 +1,144 @@
+#include "RecordingRenderCommandList.h"
+#include "BaseSystem/Logger/Logger.h"
+#include <format>
+
+void RecordingRenderCommandList::Clear() {
+	commands_.clear();
+	statistics_ = Statistics{};
+}
+
+void RecordingRenderCommandList::Dump() const {
+	Logger::Log(Logger::GetStream(), std::format(
+		"RecordingRenderCommandList: {} commands, {} draws, {} vertices, {} pipeline changes\n",
+		statistics_.commandCount, statistics_.drawCount, statistics_.vertexCount, statistics_.pipelineChangeCount));
+	for (const Command& command : commands_) {
+		LogCommand(command);
+	}
+}
+
+const char* RecordingRenderCommandList::GetCommandName(CommandType type) {
+	switch (type) {
+	case CommandType::SetGraphicsRootSignature:				return "SetGraphicsRootSignature";
+	case CommandType::SetPipelineState:						return "SetPipelineState";
+	case CommandType::IASetPrimitiveTopology:				return "IASetPrimitiveTopology";
+	case CommandType::IASetVertexBuffers:					return "IASetVertexBuffers";
+	case CommandType::IASetIndexBuffer:						return "IASetIndexBuffer";
+	case CommandType::SetGraphicsRootConstantBufferView:	return "SetGraphicsRootConstantBufferView";
+	case CommandType::SetGraphicsRootDescriptorTable:		return "SetGraphicsRootDescriptorTable";
+	case CommandType::SetGraphicsRootShaderResourceView:	return "SetGraphicsRootShaderResourceView";
+	case CommandType::SetGraphicsRoot32BitConstant:			return "SetGraphicsRoot32BitConstant";
+	case CommandType::DrawInstanced:						return "DrawInstanced";
+	case CommandType::DrawIndexedInstanced:					return "DrawIndexedInstanced";
+	}
+	return "Unknown";
+}
+
+///*-----------------------------------------------------------------------*///
+//								コマンドの記録									//
+///*-----------------------------------------------------------------------*///
+
+void RecordingRenderCommandList::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) {
+	Record(CommandType::SetGraphicsRootSignature, reinterpret_cast<uint64_t>(rootSignature));
+	++statistics_.pipelineChangeCount;
+	if (forwardTarget_) {
+		forwardTarget_->SetGraphicsRootSignature(rootSignature);
+	}
+}
+
+void RecordingRenderCommandList::SetPipelineState(ID3D12PipelineState* pipelineState) {
+	Record(CommandType::SetPipelineState, reinterpret_cast<uint64_t>(pipelineState));
+	++statistics_.pipelineChangeCount;
+	if (forwardTarget_) {
+		forwardTarget_->SetPipelineState(pipelineState);
+	}
+}
+
+void RecordingRenderCommandList::IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) {
+	Record(CommandType::IASetPrimitiveTopology, static_cast<uint64_t>(topology));
+	if (forwardTarget_) {
+		forwardTarget_->IASetPrimitiveTopology(topology);
+	}
+}
+
+void RecordingRenderCommandList::IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) {
+	// 先頭のビューのみ記録（このエンジンでは1スロットしか使っていない）
+	const D3D12_VERTEX_BUFFER_VIEW first = (views && numViews > 0) ? views[0] : D3D12_VERTEX_BUFFER_VIEW{};
+	Record(CommandType::IASetVertexBuffers, startSlot, numViews, first.BufferLocation, first.SizeInBytes, first.StrideInBytes);
+	if (forwardTarget_) {
+		forwardTarget_->IASetVertexBuffers(startSlot, numViews, views);
+	}
+}
+
+void RecordingRenderCommandList::IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) {
+	const D3D12_INDEX_BUFFER_VIEW value = view ? *view : D3D12_INDEX_BUFFER_VIEW{};
+	Record(CommandType::IASetIndexBuffer, value.BufferLocation, value.SizeInBytes, static_cast<uint64_t>(value.Format));
+	if (forwardTarget_) {
+		forwardTarget_->IASetIndexBuffer(view);
+	}
+}
+
+void RecordingRenderCommandList::SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) {
+	Record(CommandType::SetGraphicsRootConstantBufferView, rootParameterIndex, address);
+	if (forwardTarget_) {
+		forwardTarget_->SetGraphicsRootConstantBufferView(rootParameterIndex, address);
+	}
+}
+
+void RecordingRenderCommandList::SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) {
+	Record(CommandType::SetGraphicsRootDescriptorTable, rootParameterIndex, handle.ptr);
+	if (forwardTarget_) {
+		forwardTarget_->SetGraphicsRootDescriptorTable(rootParameterIndex, handle);
+	}
+}
+
+void RecordingRenderCommandList::SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) {
+	Record(CommandType::SetGraphicsRootShaderResourceView, rootParameterIndex, address);
+	if (forwardTarget_) {
+		forwardTarget_->SetGraphicsRootShaderResourceView(rootParameterIndex, address);
+	}
+}
+
+void RecordingRenderCommandList::SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) {
+	Record(CommandType::SetGraphicsRoot32BitConstant, rootParameterIndex, srcData, destOffsetIn32BitValues);
+	if (forwardTarget_) {
+		forwardTarget_->SetGraphicsRoot32BitConstant(rootParameterIndex, srcData, destOffsetIn32BitValues);
+	}
+}
+
+void RecordingRenderCommandList::DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance) {
+	Record(CommandType::DrawInstanced, vertexCount, instanceCount, startVertex, startInstance);
+	++statistics_.drawCount;
+	statistics_.vertexCount += static_cast<uint64_t>(vertexCount) * instanceCount;
+	if (forwardTarget_) {
+		forwardTarget_->DrawInstanced(vertexCount, instanceCount, startVertex, startInstance);
+	}
+}
+
+void RecordingRenderCommandList::DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) {
+	Record(CommandType::DrawIndexedInstanced, indexCount, instanceCount, startIndex,
+		static_cast<uint64_t>(static_cast<int64_t>(baseVertex)), startInstance);
+	++statistics_.drawCount;
+	statistics_.vertexCount += static_cast<uint64_t>(indexCount) * instanceCount;
+	if (forwardTarget_) {
+		forwardTarget_->DrawIndexedInstanced(indexCount, instanceCount, startIndex, baseVertex, startInstance);
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//									内部処理									//
+///*-----------------------------------------------------------------------*///
+
+void RecordingRenderCommandList::Record(CommandType type, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t a4) {
+	Command command{ type, { a0, a1, a2, a3, a4 } };
+	commands_.push_back(command);
+	++statistics_.commandCount;
+	if (isLogEnabled_) {
+		LogCommand(command);
+	}
+}
+
+void RecordingRenderCommandList::LogCommand(const Command& command) {
+	Logger::Log(Logger::GetStream(), std::format("  {}(0x{:x}, 0x{:x}, 0x{:x}, 0x{:x}, 0x{:x})\n",
+		GetCommandName(command.type),
+		command.args[0], command.args[1], command.args[2], command.args[3], command.args[4]));
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "RenderCommandList.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 受け取ったコマンドを記録するバックエンド
+/// 転送先を設定しない場合はGPUに何も送らないヌルレンダラーになる
+/// 転送先を設定した場合は記録しつつそのまま渡す（実際の描画を保ったままコマンド列を調べられる）
+/// 記録したポインタやアドレスは値として比較するためだけのもので、参照はしない
+/// </summary>
+class RecordingRenderCommandList : public RenderCommandList {
+public:
+	/// <summary>
+	/// コマンドの種類
+	/// </summary>
+	enum class CommandType {
+		SetGraphicsRootSignature,
+		SetPipelineState,
+		IASetPrimitiveTopology,
+		IASetVertexBuffers,
+		IASetIndexBuffer,
+		SetGraphicsRootConstantBufferView,
+		SetGraphicsRootDescriptorTable,
+		SetGraphicsRootShaderResourceView,
+		SetGraphicsRoot32BitConstant,
+		DrawInstanced,
+		DrawIndexedInstanced,
+	};
+
+	/// <summary>
+	/// 記録した1コマンド（引数は種類ごとに並びが異なる）
+	/// </summary>
+	struct Command {
+		CommandType type;
+		uint64_t args[5];
+	};
+
+	/// <summary>
+	/// 記録の集計
+	/// </summary>
+	struct Statistics {
+		uint32_t commandCount = 0;		// 全コマンド数
+		uint32_t drawCount = 0;			// 描画コマンド数
+		uint64_t vertexCount = 0;		// 描画した頂点（インデックス）数×インスタンス数の合計
+		uint32_t pipelineChangeCount = 0;	// PSO・ルートシグネチャの切り替え数
+	};
+
+public:
+	RecordingRenderCommandList() = default;
+	~RecordingRenderCommandList() override = default;
+
+	/// <summary>
+	/// 記録後に渡す先を設定（nullptrならどこにも渡さない）
+	/// </summary>
+	void SetForwardTarget(RenderCommandList* target) { forwardTarget_ = target; }
+
+	/// <summary>
+	/// 受け取ったコマンドを1つずつログに出すかどうか
+	/// </summary>
+	void SetLogEnabled(bool enabled) { isLogEnabled_ = enabled; }
+
+	/// <summary>
+	/// 記録を破棄（フレームの頭などで呼ぶ）
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 記録したコマンドを順番にログへ出力
+	/// </summary>
+	void Dump() const;
+
+	const std::vector<Command>& GetCommands() const { return commands_; }
+	const Statistics& GetStatistics() const { return statistics_; }
+
+	/// <summary>
+	/// コマンドの名前を取得
+	/// </summary>
+	static const char* GetCommandName(CommandType type);
+
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) override;
+	void SetPipelineState(ID3D12PipelineState* pipelineState) override;
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) override;
+	void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) override;
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) override;
+	void SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) override;
+	void SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) override;
+	void SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) override;
+	void DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance) override;
+	void DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) override;
+
+private:
+	/// <summary>
+	/// コマンドを記録
+	/// </summary>
+	void Record(CommandType type, uint64_t a0 = 0, uint64_t a1 = 0, uint64_t a2 = 0, uint64_t a3 = 0, uint64_t a4 = 0);
+
+	/// <summary>
+	/// 1コマンドをログに出力
+	/// </summary>
+	static void LogCommand(const Command& command);
+
+private:
+	std::vector<Command> commands_;
+	Statistics statistics_;
+	RenderCommandList* forwardTarget_ = nullptr;
+	bool isLogEnabled_ = false;
+};
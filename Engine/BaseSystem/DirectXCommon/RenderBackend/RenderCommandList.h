@@ -0,0 +1,43 @@
+#pragma once
+#include <d3d12.h>
+
+/// <summary>
+/// 描画コマンドの発行先（バックエンド）の共通インターフェース
+/// パイプライン・バインド・描画のコマンドのみを扱う（リソースバリアやレンダーターゲットの設定は対象外）
+/// メソッド名はID3D12GraphicsCommandListに合わせている
+/// 実装：D3D12RenderCommandList（実際のコマンドリストに積む）
+///       RecordingRenderCommandList（コマンド列を記録する。GPUに送らないヌルレンダラーとしても使える）
+/// </summary>
+class RenderCommandList {
+public:
+	virtual ~RenderCommandList() = default;
+
+	///*-----------------------------------------------------------------------*///
+	//								パイプライン									//
+	///*-----------------------------------------------------------------------*///
+
+	virtual void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) = 0;
+	virtual void SetPipelineState(ID3D12PipelineState* pipelineState) = 0;
+	virtual void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology) = 0;
+
+	///*-----------------------------------------------------------------------*///
+	//								バッファ・バインド								//
+	///*-----------------------------------------------------------------------*///
+
+	virtual void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) = 0;
+	virtual void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) = 0;
+	virtual void SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+	virtual void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE handle) = 0;
+	virtual void SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS address) = 0;
+	virtual void SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) = 0;
+
+	///*-----------------------------------------------------------------------*///
+	//									描画									//
+	///*-----------------------------------------------------------------------*///
+
+	virtual void DrawInstanced(UINT vertexCount, UINT instanceCount, UINT startVertex, UINT startInstance) = 0;
+	virtual void DrawIndexedInstanced(UINT indexCount, UINT instanceCount, UINT startIndex, INT baseVertex, UINT startInstance) = 0;
+
+protected:
+	RenderCommandList() = default;
+};
@@ -0,0 +1,92 @@
+#include "ShaderCache.h"
+#include <fstream>
+#include <format>
+#include <thread>
+
+ShaderCache* ShaderCache::GetInstance() {
+	static ShaderCache instance;
+	return &instance;
+}
+
+std::filesystem::path ShaderCache::GetFilePath(uint64_t key) const {
+	return directory_ / std::format("{:016x}.cso", key);
+}
+
+bool ShaderCache::Load(uint64_t key, std::vector<uint8_t>& outData) {
+	if (!isEnabled_) {
+		++missCount_;
+		return false;
+	}
+
+	std::ifstream file(GetFilePath(key), std::ios::binary);
+	if (!file.is_open()) {
+		++missCount_;
+		return false;
+	}
+
+	// ヘッダを検証（壊れたファイルや別形式のファイルはミス扱い）
+	FileHeader header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || header.magic != kMagic || header.version != kVersion || header.key != key || header.size == 0) {
+		++missCount_;
+		return false;
+	}
+
+	outData.resize(static_cast<size_t>(header.size));
+	file.read(reinterpret_cast<char*>(outData.data()), static_cast<std::streamsize>(header.size));
+	if (static_cast<uint64_t>(file.gcount()) != header.size) {
+		outData.clear();
+		++missCount_;
+		return false;
+	}
+
+	++hitCount_;
+	return true;
+}
+
+bool ShaderCache::Store(uint64_t key, const void* data, size_t size) {
+	if (!isEnabled_ || data == nullptr || size == 0) {
+		return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(directory_, ec);
+
+	// 一時ファイルに書いてから置き換える（書き込み途中のファイルを他スレッドに読ませない）
+	const std::filesystem::path finalPath = GetFilePath(key);
+	std::filesystem::path tempPath = finalPath;
+	tempPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		FileHeader header{ kMagic, kVersion, key, static_cast<uint64_t>(size) };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		if (!file) {
+			file.close();
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, finalPath, ec);
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
+
+void ShaderCache::Clear() {
+	std::error_code ec;
+	if (!std::filesystem::is_directory(directory_, ec)) {
+		return;
+	}
+	for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+		if (entry.path().extension() == ".cso") {
+			std::filesystem::remove(entry.path(), ec);
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <filesystem>
+
+/// <summary>
+/// コンパイル済みシェーダーをディスクに保存するキャッシュ
+/// キーはShaderHasherで計算したハッシュ値、1キーにつき1ファイル
+/// 複数スレッドから同時に読み書きしてもよい
+/// </summary>
+class ShaderCache {
+public:
+	// デフォルトの保存先（実行時のカレントディレクトリ基準）
+	static constexpr const char* kDefaultDirectory = "ShaderCache";
+
+	//シングルトン
+	static ShaderCache* GetInstance();
+
+	/// <summary>
+	/// 保存先ディレクトリを設定
+	/// </summary>
+	void SetDirectory(const std::filesystem::path& directory) { directory_ = directory; }
+	const std::filesystem::path& GetDirectory() const { return directory_; }
+
+	/// <summary>
+	/// キャッシュの有効/無効（無効の時は常にミス扱い、保存もしない）
+	/// </summary>
+	void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+	bool IsEnabled() const { return isEnabled_; }
+
+	/// <summary>
+	/// キャッシュからバイナリを読み込む
+	/// </summary>
+	/// <param name="key">キャッシュキー</param>
+	/// <param name="outData">読み込んだバイナリ</param>
+	/// <returns>ヒットした場合true</returns>
+	bool Load(uint64_t key, std::vector<uint8_t>& outData);
+
+	/// <summary>
+	/// バイナリをキャッシュに保存
+	/// </summary>
+	/// <param name="key">キャッシュキー</param>
+	/// <param name="data">バイナリの先頭</param>
+	/// <param name="size">バイナリのサイズ</param>
+	/// <returns>保存に成功した場合true</returns>
+	bool Store(uint64_t key, const void* data, size_t size);
+
+	/// <summary>
+	/// 保存されているキャッシュファイルを全て削除
+	/// </summary>
+	void Clear();
+
+	// 統計
+	uint32_t GetHitCount() const { return hitCount_.load(); }
+	uint32_t GetMissCount() const { return missCount_.load(); }
+
+	/// <summary>
+	/// キーに対応するファイルパス
+	/// </summary>
+	std::filesystem::path GetFilePath(uint64_t key) const;
+
+private:
+	// コンストラクタ
+	ShaderCache() = default;
+	~ShaderCache() = default;
+	ShaderCache(const ShaderCache&) = delete;
+	ShaderCache& operator=(const ShaderCache&) = delete;
+
+	/// <summary>
+	/// キャッシュファイルのヘッダ
+	/// </summary>
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t key;
+		uint64_t size;
+	};
+	static const uint32_t kMagic = 0x31434853;	// "SHC1"
+	static const uint32_t kVersion = 1;
+
+	std::filesystem::path directory_ = kDefaultDirectory;
+	bool isEnabled_ = true;
+
+	std::atomic<uint32_t> hitCount_ = 0;
+	std::atomic<uint32_t> missCount_ = 0;
+};
@@ -0,0 +1,168 @@
+#include "ShaderHasher.h"
+#include "BaseSystem/Hash/Hash.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include <sstream>
+#include <algorithm>
+
+ShaderHasher::Key ShaderHasher::ComputeKey(
+	const std::filesystem::path& filePath,
+	const std::wstring& entryPoint,
+	const std::wstring& profile,
+	const std::vector<std::wstring>& arguments) {
+
+	Key key;
+
+	std::string source;
+	if (!ReadFile(filePath, source)) {
+		return key;
+	}
+
+	// キー形式のバージョン
+	key.hash = Hash::Value(kKeyVersion);
+
+	// ソースと依存ファイルを順に積む
+	HashFileRecursive(filePath, source, key);
+
+	// 見つからなかったincludeも名前だけ積んでおく（後から追加されたら別キーになる）
+	for (const std::string& missing : key.missingIncludes) {
+		key.hash = Hash::String("missing:", key.hash);
+		key.hash = Hash::String(missing, key.hash);
+	}
+
+	// コンパイル設定
+	key.hash = Hash::String("entry:", key.hash);
+	key.hash = Hash::WString(entryPoint, key.hash);
+	key.hash = Hash::String("profile:", key.hash);
+	key.hash = Hash::WString(profile, key.hash);
+	for (const std::wstring& argument : arguments) {
+		key.hash = Hash::String("arg:", key.hash);
+		key.hash = Hash::WString(argument, key.hash);
+	}
+
+	key.isValid = true;
+	return key;
+}
+
+void ShaderHasher::HashFileRecursive(const std::filesystem::path& path, const std::string& text, Key& key) {
+	// 同じファイルを2回積まない（インクルードガード付きの共有hlsliなど）
+	std::filesystem::path normalized = path.lexically_normal();
+	if (std::find(key.dependencies.begin(), key.dependencies.end(), normalized) != key.dependencies.end()) {
+		return;
+	}
+	key.dependencies.push_back(normalized);
+
+	// パスと本文をハッシュ
+	key.hash = Hash::String("file:", key.hash);
+	key.hash = Hash::String(normalized.generic_string(), key.hash);
+	key.hash = Hash::Value(text.size(), key.hash);
+	key.hash = Hash::Bytes(text.data(), text.size(), key.hash);
+
+	// includeを解決して再帰
+	const std::filesystem::path includerDirectory = normalized.parent_path();
+	for (const std::string& includeName : ParseIncludes(text)) {
+		std::filesystem::path includePath;
+		std::string includeText;
+		if (!ResolveInclude(includeName, includerDirectory, includePath) || !ReadFile(includePath, includeText)) {
+			if (std::find(key.missingIncludes.begin(), key.missingIncludes.end(), includeName) == key.missingIncludes.end()) {
+				key.missingIncludes.push_back(includeName);
+			}
+			continue;
+		}
+		HashFileRecursive(includePath, includeText, key);
+	}
+}
+
+std::vector<std::string> ShaderHasher::ParseIncludes(const std::string& source) {
+	std::vector<std::string> includes;
+
+	// コメントを取り除いたソースを作る（文字列リテラル内の//は考慮しない）
+	std::string stripped;
+	stripped.reserve(source.size());
+	for (size_t i = 0; i < source.size(); ++i) {
+		if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/') {
+			// 行コメント：改行まで飛ばす
+			while (i < source.size() && source[i] != '\n') {
+				++i;
+			}
+			if (i < source.size()) {
+				stripped.push_back('\n');
+			}
+		} else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*') {
+			// ブロックコメント：改行は残して行の区切りを保つ
+			i += 2;
+			while (i + 1 < source.size() && !(source[i] == '*' && source[i + 1] == '/')) {
+				if (source[i] == '\n') {
+					stripped.push_back('\n');
+				}
+				++i;
+			}
+			++i;
+		} else {
+			stripped.push_back(source[i]);
+		}
+	}
+
+	// 行ごとに#includeを探す
+	std::istringstream stream(stripped);
+	std::string line;
+	while (std::getline(stream, line)) {
+		size_t pos = line.find_first_not_of(" \t");
+		if (pos == std::string::npos || line[pos] != '#') {
+			continue;
+		}
+		pos = line.find_first_not_of(" \t", pos + 1);
+		if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) {
+			continue;
+		}
+		pos = line.find_first_not_of(" \t", pos + 7);
+		if (pos == std::string::npos) {
+			continue;
+		}
+
+		const char open = line[pos];
+		const char close = (open == '<') ? '>' : '"';
+		if (open != '"' && open != '<') {
+			continue;
+		}
+		const size_t end = line.find(close, pos + 1);
+		if (end == std::string::npos) {
+			continue;
+		}
+		includes.push_back(line.substr(pos + 1, end - pos - 1));
+	}
+
+	return includes;
+}
+
+bool ShaderHasher::ResolveInclude(const std::string& includeName,
+	const std::filesystem::path& includerDirectory,
+	std::filesystem::path& outPath) {
+
+	const std::filesystem::path name(includeName);
+
+	// カレントディレクトリ基準（このエンジンのシェーダーはプロジェクトルートからのパスで書いている）
+	// アーカイブに入っているものも見つかるようにVirtualFileSystemで確かめる
+	VirtualFileSystem* fileSystem = VirtualFileSystem::GetInstance();
+	if (fileSystem->Exists(name.generic_string())) {
+		outPath = name.lexically_normal();
+		return true;
+	}
+
+	// include元のディレクトリ基準
+	const std::filesystem::path relative = includerDirectory / name;
+	if (fileSystem->Exists(relative.generic_string())) {
+		outPath = relative.lexically_normal();
+		return true;
+	}
+
+	return false;
+}
+
+bool ShaderHasher::ReadFile(const std::filesystem::path& path, std::string& outText) {
+	const FileView file = VirtualFileSystem::GetInstance()->Open(path.generic_string());
+	if (!file.IsValid()) {
+		return false;
+	}
+	outText.assign(file.GetText());
+	return true;
+}
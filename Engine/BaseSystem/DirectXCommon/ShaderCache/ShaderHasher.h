@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+/// <summary>
+/// シェーダーキャッシュのキーを計算するクラス
+/// ソース本文、再帰的に解決したinclude、エントリーポイント、プロファイル、コンパイルオプションからハッシュを作る
+/// DXCには依存しないので単体で検証できる
+/// </summary>
+class ShaderHasher {
+public:
+	/// <summary>
+	/// キャッシュキー
+	/// </summary>
+	struct Key {
+		uint64_t hash = 0;
+		// 依存しているファイル（先頭がメインのファイル、以降はincludeを見つけた順）
+		std::vector<std::filesystem::path> dependencies;
+		// 見つからなかったinclude名
+		std::vector<std::string> missingIncludes;
+		bool isValid = false;
+	};
+
+	/// <summary>
+	/// キャッシュキーを計算
+	/// </summary>
+	/// <param name="filePath">シェーダーファイルのパス</param>
+	/// <param name="entryPoint">エントリーポイント</param>
+	/// <param name="profile">シェーダープロファイル</param>
+	/// <param name="arguments">コンパイルオプション</param>
+	/// <returns>キャッシュキー（ファイルが読めなければisValid=false）</returns>
+	static Key ComputeKey(
+		const std::filesystem::path& filePath,
+		const std::wstring& entryPoint,
+		const std::wstring& profile,
+		const std::vector<std::wstring>& arguments);
+
+	/// <summary>
+	/// ソースに書かれている#includeのファイル名を列挙（コメント内は無視）
+	/// </summary>
+	/// <param name="source">シェーダーのソース</param>
+	/// <returns>include名の一覧（書かれている順）</returns>
+	static std::vector<std::string> ParseIncludes(const std::string& source);
+
+	/// <summary>
+	/// include名を実際のファイルパスに解決
+	/// カレントディレクトリ基準、include元のディレクトリ基準の順に探す（DXCのデフォルトハンドラと同じ）
+	/// </summary>
+	/// <param name="includeName">include名</param>
+	/// <param name="includerDirectory">include元ファイルのディレクトリ</param>
+	/// <param name="outPath">解決したパス</param>
+	/// <returns>見つかった場合true</returns>
+	static bool ResolveInclude(const std::string& includeName,
+		const std::filesystem::path& includerDirectory,
+		std::filesystem::path& outPath);
+
+	/// <summary>
+	/// ファイルの中身を読み込む
+	/// </summary>
+	static bool ReadFile(const std::filesystem::path& path, std::string& outText);
+
+private:
+	/// <summary>
+	/// ファイルとそのincludeを再帰的にハッシュへ積む
+	/// </summary>
+	static void HashFileRecursive(const std::filesystem::path& path, const std::string& text, Key& key);
+
+	// キーの形式を変えたときに古いキャッシュを使わないためのバージョン
+	static const uint32_t kKeyVersion = 1;
+
+	// ::で呼び出すためにインスタンス化しないように設定
+	ShaderHasher() = delete;
+	~ShaderHasher() = delete;
+};
@@ -0,0 +1,24 @@
+#include "ShaderIncludeHandler.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/Logger/Logger.h"
+
+HRESULT STDMETHODCALLTYPE ShaderIncludeHandler::LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource) {
+	if (!pFilename || !ppIncludeSource) {
+		return E_INVALIDARG;
+	}
+	*ppIncludeSource = nullptr;
+
+	const FileView file = VirtualFileSystem::GetInstance()->Open(Logger::ConvertString(std::wstring(pFilename)));
+	if (!file.IsValid()) {
+		return E_FAIL;
+	}
+
+	// ビューはここで閉じるので、DXCに渡すBlobには中身をコピーする（includeは小さいので問題にならない）
+	Microsoft::WRL::ComPtr<IDxcBlobEncoding> blob;
+	HRESULT hr = dxcUtils_->CreateBlob(file.GetData(), static_cast<UINT32>(file.GetSize()), DXC_CP_UTF8, &blob);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	*ppIncludeSource = blob.Detach();
+	return S_OK;
+}
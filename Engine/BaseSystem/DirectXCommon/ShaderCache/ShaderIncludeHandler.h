@@ -0,0 +1,23 @@
+#pragma once
+#include <Windows.h>
+#include <dxcapi.h>
+#include <wrl.h>
+#include <wrl/implements.h>
+
+/// <summary>
+/// シェーダーのincludeをVirtualFileSystemを通して読むDXCのincludeハンドラー
+/// アーカイブに入れたhlsliもディスクのものと同じパスで読める
+/// </summary>
+class ShaderIncludeHandler : public Microsoft::WRL::RuntimeClass<
+	Microsoft::WRL::RuntimeClassFlags<Microsoft::WRL::ClassicCom>, IDxcIncludeHandler> {
+public:
+	explicit ShaderIncludeHandler(Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils) : dxcUtils_(dxcUtils) {}
+
+	/// <summary>
+	/// includeされたファイルを読む（見つからなければE_FAILを返し、DXCが次の候補を試す）
+	/// </summary>
+	HRESULT STDMETHODCALLTYPE LoadSource(LPCWSTR pFilename, IDxcBlob** ppIncludeSource) override;
+
+private:
+	Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils_;
+};
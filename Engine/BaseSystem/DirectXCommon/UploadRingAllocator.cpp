@@ -0,0 +1,108 @@
+#include "UploadRingAllocator.h"
+#include <algorithm>
+
+void UploadRingAllocator::Initialize(uint64_t capacity) {
+	capacity_ = capacity;
+	head_ = 0;
+	tail_ = 0;
+	usedBytes_ = 0;
+	batches_.clear();
+
+	highWaterMark_ = 0;
+	allocateCount_ = 0;
+	failedCount_ = 0;
+}
+
+void UploadRingAllocator::Finalize() {
+	batches_.clear();
+	capacity_ = 0;
+	head_ = 0;
+	tail_ = 0;
+	usedBytes_ = 0;
+}
+
+void UploadRingAllocator::BeginBatch(uint64_t fenceValue) {
+	// 同じフェンス値で呼ばれた場合は同じまとまりとして続ける
+	if (!batches_.empty() && batches_.back().fenceValue == fenceValue) {
+		return;
+	}
+	batches_.push_back({ fenceValue, head_, 0 });
+}
+
+uint64_t UploadRingAllocator::Allocate(uint64_t size, uint64_t alignment) {
+	// BeginBatchの前の割り当ては回収できないので受け付けない
+	if (batches_.empty() || size == 0 || size > capacity_ - usedBytes_) {
+		failedCount_++;
+		return kInvalidOffset;
+	}
+
+	// 全て空いていれば先頭から使い直す（折り返しを減らすため）
+	if (usedBytes_ == 0) {
+		head_ = 0;
+		tail_ = 0;
+	}
+
+	auto alignUp = [alignment](uint64_t value) { return (value + alignment - 1) & ~(alignment - 1); };
+
+	uint64_t offset = kInvalidOffset;
+	uint64_t wasted = 0;
+	const uint64_t alignedHead = alignUp(head_);
+	if (head_ >= tail_ && usedBytes_ < capacity_) {
+		// 空きは[head, capacity)と[0, tail)
+		if (alignedHead + size <= capacity_) {
+			offset = alignedHead;
+			wasted = alignedHead - head_;
+		} else if (size <= tail_) {
+			offset = 0;
+			wasted = capacity_ - head_;
+		}
+	} else {
+		// 空きは[head, tail)
+		if (alignedHead + size <= tail_) {
+			offset = alignedHead;
+			wasted = alignedHead - head_;
+		}
+	}
+
+	if (offset == kInvalidOffset) {
+		failedCount_++;
+		return kInvalidOffset;
+	}
+
+	head_ = offset + size;
+	if (head_ == capacity_) {
+		head_ = 0;
+	}
+	usedBytes_ += wasted + size;
+
+	BatchRange& batch = batches_.back();
+	batch.end = head_;
+	batch.bytes += wasted + size;
+
+	allocateCount_++;
+	highWaterMark_ = (std::max)(highWaterMark_, usedBytes_);
+	return offset;
+}
+
+void UploadRingAllocator::Reclaim(uint64_t completedFenceValue) {
+	// 古いまとまりから、GPUが使い終わったものを順に返す
+	while (!batches_.empty() && batches_.front().fenceValue <= completedFenceValue) {
+		const BatchRange& batch = batches_.front();
+		if (batch.bytes != 0) {
+			tail_ = batch.end;
+			usedBytes_ -= batch.bytes;
+		}
+		batches_.pop_front();
+	}
+}
+
+UploadRingAllocator::Statistics UploadRingAllocator::GetStatistics() const {
+	Statistics statistics;
+	statistics.capacity = capacity_;
+	statistics.usedBytes = usedBytes_;
+	statistics.highWaterMark = highWaterMark_;
+	statistics.pendingBatchCount = static_cast<uint32_t>(batches_.size());
+	statistics.allocateCount = allocateCount_;
+	statistics.failedCount = failedCount_;
+	return statistics;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+/// <summary>
+/// アップロード用のバッファをリング状に切り出す（D3Dに依存しない、単位はバイト）
+/// DescriptorRingAllocatorと同じく個別の解放はせず、BeginBatchで渡したフェンス値ごとに使った範囲を覚えておき、
+/// Reclaimで完了したフェンス値までの範囲をまとめて返す
+/// 末尾に収まらない割り当ては残りを捨てて先頭から切り出す（1回のコピー元が途中で折り返さないように）
+/// </summary>
+class UploadRingAllocator {
+public:
+	// 割り当て失敗時のオフセット
+	static const uint64_t kInvalidOffset = UINT64_MAX;
+
+	/// <summary>
+	/// 割り当ての統計
+	/// </summary>
+	struct Statistics {
+		uint64_t capacity = 0;			// リング全体のバイト数
+		uint64_t usedBytes = 0;			// GPUが使い終わっていないバイト数（折り返し・アラインメントで捨てた分を含む）
+		uint64_t highWaterMark = 0;		// usedBytesの最大
+		uint32_t pendingBatchCount = 0;	// 回収待ちのまとまりの数
+		uint64_t allocateCount = 0;		// 割り当ての回数
+		uint64_t failedCount = 0;		// 空きが足りず失敗した回数
+	};
+
+	UploadRingAllocator() = default;
+	~UploadRingAllocator() = default;
+
+	/// <summary>
+	/// 初期化（全て空きにして統計をリセット）
+	/// </summary>
+	/// <param name="capacity">リングのバイト数</param>
+	void Initialize(uint64_t capacity);
+
+	/// <summary>
+	/// 終了処理
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// まとまりの開始（これ以降の割り当てはfenceValueが完了するまで使用中になる）
+	/// </summary>
+	/// <param name="fenceValue">このまとまりを送った後にSignalするフェンス値</param>
+	void BeginBatch(uint64_t fenceValue);
+
+	/// <summary>
+	/// 連続した範囲を割り当て
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">先頭のアラインメント（2のべき乗）</param>
+	/// <returns>リング内の先頭オフセット（空きが足りなければkInvalidOffset）</returns>
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+	/// <summary>
+	/// 完了したフェンス値までのまとまりが使った範囲を回収
+	/// </summary>
+	/// <param name="completedFenceValue">GPUが完了したフェンス値</param>
+	void Reclaim(uint64_t completedFenceValue);
+
+	/// <summary>
+	/// 回収待ちで一番古いまとまりのフェンス値（なければ0）
+	/// </summary>
+	uint64_t GetOldestPendingFenceValue() const { return batches_.empty() ? 0 : batches_.front().fenceValue; }
+
+	// Getter
+	uint64_t GetCapacity() const { return capacity_; }
+	uint64_t GetUsedBytes() const { return usedBytes_; }
+	Statistics GetStatistics() const;
+
+private:
+	/// <summary>
+	/// 1まとまり分の使用範囲
+	/// </summary>
+	struct BatchRange {
+		uint64_t fenceValue = 0;
+		uint64_t end = 0;		// このまとまりの最後の割り当ての次の位置
+		uint64_t bytes = 0;		// このまとまりで使ったバイト数（捨てた分を含む）
+	};
+
+	uint64_t capacity_ = 0;
+	uint64_t head_ = 0;			// 次に割り当てる位置
+	uint64_t tail_ = 0;			// 使用中の一番古い位置
+	uint64_t usedBytes_ = 0;
+
+	// 回収待ちのまとまり（古い順、最後が今のまとまり）
+	std::deque<BatchRange> batches_;
+
+	// 統計
+	uint64_t highWaterMark_ = 0;
+	uint64_t allocateCount_ = 0;
+	uint64_t failedCount_ = 0;
+};
@@ -0,0 +1,128 @@
+#include "AssetPack.h"
+#include "BaseSystem/Hash/Hash.h"
+#include <algorithm>
+#include <vector>
+
+bool AssetPack::Open(const std::string& filePath, std::string& message) {
+	Close();
+
+	if (!file_.Open(filePath)) {
+		message = "failed to open " + filePath;
+		return false;
+	}
+	const uint64_t fileSize = file_.GetSize();
+	const uint8_t* data = file_.GetData();
+
+	// ヘッダー
+	if (fileSize < sizeof(Header)) {
+		message = "file is too small";
+		Close();
+		return false;
+	}
+	const Header* header = reinterpret_cast<const Header*>(data);
+	if (header->magic != kMagic || header->version != kVersion) {
+		message = "unknown format or version";
+		Close();
+		return false;
+	}
+
+	// 目次と文字列表がファイルに収まっているか
+	const uint64_t tocSize = static_cast<uint64_t>(header->entryCount) * sizeof(Entry);
+	if (header->tocOffset % alignof(Entry) != 0 || header->tocOffset > fileSize || tocSize > fileSize - header->tocOffset ||
+		header->stringsOffset > fileSize || header->stringsSize > fileSize - header->stringsOffset) {
+		message = "table of contents is out of range";
+		Close();
+		return false;
+	}
+	const Entry* entries = reinterpret_cast<const Entry*>(data + header->tocOffset);
+
+	// 各項目のデータとパスが範囲内で、目次がハッシュの順に並んでいるか
+	// 圧縮していないものは格納サイズと元のサイズが同じ（違うとマップした範囲の外を読むことになる）
+	for (uint32_t i = 0; i < header->entryCount; ++i) {
+		const Entry& entry = entries[i];
+		if (entry.offset > fileSize || entry.storedSize > fileSize - entry.offset ||
+			(entry.compression == static_cast<uint32_t>(Compression::None) && entry.size != entry.storedSize) ||
+			static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > header->stringsSize ||
+			(i > 0 && entries[i - 1].pathHash > entry.pathHash)) {
+			message = "broken entry " + std::to_string(i);
+			Close();
+			return false;
+		}
+	}
+
+	filePath_ = filePath;
+	header_ = header;
+	entries_ = entries;
+	strings_ = reinterpret_cast<const char*>(data + header->stringsOffset);
+	return true;
+}
+
+void AssetPack::Close() {
+	file_.Close();
+	filePath_.clear();
+	header_ = nullptr;
+	entries_ = nullptr;
+	strings_ = nullptr;
+}
+
+const AssetPack::Entry* AssetPack::Find(std::string_view normalizedPath) const {
+	if (!header_) {
+		return nullptr;
+	}
+
+	// 同じハッシュの範囲を二分探索で見つけ、パスの文字列で確かめる
+	const uint64_t pathHash = HashPath(normalizedPath);
+	const Entry* end = entries_ + header_->entryCount;
+	const Entry* it = std::lower_bound(entries_, end, pathHash, [](const Entry& entry, uint64_t hash) {
+		return entry.pathHash < hash;
+	});
+	for (; it != end && it->pathHash == pathHash; ++it) {
+		if (GetPath(*it) == normalizedPath) {
+			return it;
+		}
+	}
+	return nullptr;
+}
+
+std::string_view AssetPack::GetPath(const Entry& entry) const {
+	return std::string_view(strings_ + entry.pathOffset, entry.pathLength);
+}
+
+std::string AssetPack::NormalizePath(std::string_view path) {
+	// 区切りで分けて、.と空の要素を捨て、..は1つ前を消す
+	std::vector<std::string_view> parts;
+	size_t begin = 0;
+	while (begin <= path.size()) {
+		size_t end = path.find_first_of("/\\", begin);
+		if (end == std::string_view::npos) {
+			end = path.size();
+		}
+		const std::string_view part = path.substr(begin, end - begin);
+		if (part == "..") {
+			if (!parts.empty() && parts.back() != "..") {
+				parts.pop_back();
+			} else {
+				parts.push_back(part);
+			}
+		} else if (!part.empty() && part != ".") {
+			parts.push_back(part);
+		}
+		begin = end + 1;
+	}
+
+	std::string normalized;
+	normalized.reserve(path.size());
+	for (size_t i = 0; i < parts.size(); ++i) {
+		if (i > 0) {
+			normalized.push_back('/');
+		}
+		for (char c : parts[i]) {
+			normalized.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c);
+		}
+	}
+	return normalized;
+}
+
+uint64_t AssetPack::HashPath(std::string_view normalizedPath) {
+	return Hash::String(normalizedPath);
+}
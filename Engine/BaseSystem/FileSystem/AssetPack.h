@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "BaseSystem/FileSystem/MappedFile.h"
+
+/// <summary>
+/// 複数のファイルを1つにまとめたアーカイブ（.pak）の読み込み
+/// ファイル全体をメモリにマップし、目次もデータもコピーせずにそのまま参照する
+///
+/// 並び：[Header][Entry × entryCount（pathHashの昇順）][パスの文字列表][データ（各alignmentの倍数の位置）]
+/// パスはNormalizePathで正規化したものを64bit FNV-1aでハッシュし、目次を二分探索で引く
+/// 値は全てリトルエンディアン
+/// </summary>
+class AssetPack {
+public:
+	static constexpr uint32_t kMagic = 0x4B415041;	// "APAK"
+	static constexpr uint32_t kVersion = 1;
+
+	/// <summary>
+	/// 格納しているデータの圧縮方式
+	/// </summary>
+	enum class Compression : uint32_t {
+		None = 0,	// そのまま（マップしたものを直接参照できる）
+		LZ = 1,		// LZCompressorで圧縮したもの（開く時にブロックを並列に展開する）
+	};
+
+	/// <summary>
+	/// ファイルの先頭
+	/// </summary>
+	struct Header {
+		uint32_t magic = kMagic;
+		uint32_t version = kVersion;
+		uint32_t entryCount = 0;
+		uint32_t alignment = 0;		// データの位置の単位
+		uint64_t tocOffset = 0;		// 目次の位置
+		uint64_t stringsOffset = 0;	// パスの文字列表の位置
+		uint64_t stringsSize = 0;
+		uint64_t dataOffset = 0;	// 最初のデータの位置
+	};
+	static_assert(sizeof(Header) == 48, "AssetPack::Header layout");
+
+	/// <summary>
+	/// 目次の1項目
+	/// </summary>
+	struct Entry {
+		uint64_t pathHash = 0;		// 正規化したパスのハッシュ
+		uint64_t offset = 0;		// データの位置（ファイルの先頭から）
+		uint64_t storedSize = 0;	// 格納しているバイト数
+		uint64_t size = 0;			// 元のファイルのバイト数
+		uint32_t pathOffset = 0;	// 文字列表の中のパスの位置
+		uint32_t pathLength = 0;
+		uint32_t compression = 0;	// Compression
+		uint32_t reserved = 0;
+	};
+	static_assert(sizeof(Entry) == 48, "AssetPack::Entry layout");
+
+	AssetPack() = default;
+	~AssetPack() = default;
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+
+	/// <summary>
+	/// アーカイブを開く（ヘッダーと目次の範囲を確かめる）
+	/// </summary>
+	/// <param name="filePath">アーカイブのパス</param>
+	/// <param name="message">失敗した理由</param>
+	/// <returns>開けたかどうか</returns>
+	bool Open(const std::string& filePath, std::string& message);
+
+	/// <summary>
+	/// 閉じる（参照していたデータは使えなくなる）
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// パスの項目を探す
+	/// </summary>
+	/// <param name="normalizedPath">NormalizePathで正規化したパス</param>
+	/// <returns>項目（なければnullptr）</returns>
+	const Entry* Find(std::string_view normalizedPath) const;
+
+	/// <summary>
+	/// 項目のパス・格納しているデータ（マップしたメモリをそのまま指す）
+	/// </summary>
+	std::string_view GetPath(const Entry& entry) const;
+	const uint8_t* GetStoredData(const Entry& entry) const { return file_.GetData() + entry.offset; }
+
+	const Entry* GetEntries() const { return entries_; }
+	uint32_t GetEntryCount() const { return header_ ? header_->entryCount : 0; }
+	uint64_t GetFileSize() const { return file_.GetSize(); }
+	const std::string& GetFilePath() const { return filePath_; }
+	bool IsOpen() const { return header_ != nullptr; }
+
+	/// <summary>
+	/// パスを正規化する（\を/に、./や..を解決し、英字は小文字に。Windowsと同じく大文字小文字を区別しない）
+	/// </summary>
+	static std::string NormalizePath(std::string_view path);
+
+	/// <summary>
+	/// 正規化したパスのハッシュ
+	/// </summary>
+	static uint64_t HashPath(std::string_view normalizedPath);
+
+private:
+	MappedFile file_;
+	std::string filePath_;
+	const Header* header_ = nullptr;
+	const Entry* entries_ = nullptr;
+	const char* strings_ = nullptr;
+};
@@ -0,0 +1,191 @@
+#include "AssetPackBuilder.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+	uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// 次の書き込み位置まで0で埋める
+	void PadTo(std::ofstream& file, uint64_t& position, uint64_t target) {
+		static const char kZeros[4096] = {};
+		while (position < target) {
+			const uint64_t count = (std::min)(target - position, static_cast<uint64_t>(sizeof(kZeros)));
+			file.write(kZeros, static_cast<std::streamsize>(count));
+			position += count;
+		}
+	}
+}
+
+void AssetPackBuilder::AddFile(const std::string& virtualPath, const std::string& diskPath) {
+	files_.push_back({ AssetPack::NormalizePath(virtualPath), diskPath });
+}
+
+uint32_t AssetPackBuilder::AddDirectory(const std::string& directory) {
+	std::error_code errorCode;
+	uint32_t addedCount = 0;
+	for (std::filesystem::recursive_directory_iterator it(directory, errorCode), end; !errorCode && it != end; it.increment(errorCode)) {
+		if (!it->is_regular_file(errorCode)) {
+			continue;
+		}
+		const std::string path = it->path().generic_string();
+		AddFile(path, path);
+		++addedCount;
+	}
+	return addedCount;
+}
+
+bool AssetPackBuilder::Build(const std::string& outputPath, const Settings& settings, Result& result) const {
+	result = Result{};
+	const uint64_t alignment = settings.alignment;
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+		result.message = "alignment must be a power of two";
+		return false;
+	}
+	const bool isCompressionEnabled = settings.compression == AssetPack::Compression::LZ;
+	if (!isCompressionEnabled && settings.compression != AssetPack::Compression::None) {
+		result.message = "unsupported compression";
+		return false;
+	}
+
+	// データはパスの順に並べる
+	std::vector<const SourceFile*> files;
+	files.reserve(files_.size());
+	for (const SourceFile& file : files_) {
+		files.push_back(&file);
+	}
+	std::sort(files.begin(), files.end(), [](const SourceFile* a, const SourceFile* b) {
+		return a->virtualPath < b->virtualPath;
+	});
+	for (size_t i = 1; i < files.size(); ++i) {
+		if (files[i - 1]->virtualPath == files[i]->virtualPath) {
+			result.message = "duplicated path " + files[i]->virtualPath;
+			return false;
+		}
+	}
+
+	// 目次と文字列表を作る（データの位置と格納する大きさは書きながら決める）
+	std::vector<AssetPack::Entry> entries(files.size());
+	std::string strings;
+	for (size_t i = 0; i < files.size(); ++i) {
+		std::error_code errorCode;
+		const uint64_t size = std::filesystem::file_size(files[i]->diskPath, errorCode);
+		if (errorCode) {
+			result.message = "failed to read size of " + files[i]->diskPath;
+			return false;
+		}
+		AssetPack::Entry& entry = entries[i];
+		entry.pathHash = AssetPack::HashPath(files[i]->virtualPath);
+		entry.storedSize = size;
+		entry.size = size;
+		entry.pathOffset = static_cast<uint32_t>(strings.size());
+		entry.pathLength = static_cast<uint32_t>(files[i]->virtualPath.size());
+		entry.compression = static_cast<uint32_t>(AssetPack::Compression::None);
+		strings += files[i]->virtualPath;
+		result.sourceBytes += size;
+	}
+
+	AssetPack::Header header;
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.alignment = static_cast<uint32_t>(alignment);
+	header.tocOffset = sizeof(AssetPack::Header);
+	header.stringsOffset = header.tocOffset + entries.size() * sizeof(AssetPack::Entry);
+	header.stringsSize = strings.size();
+	header.dataOffset = AlignUp(header.stringsOffset + header.stringsSize, alignment);
+
+	// 途中のファイルを読まれないように別名で書いてから置き換える
+	const std::filesystem::path path(outputPath);
+	std::filesystem::path temporaryPath = path;
+	temporaryPath += ".tmp";
+	{
+		std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!output) {
+			result.message = "failed to open " + temporaryPath.generic_string();
+			return false;
+		}
+		auto fail = [&](const std::string& message) {
+			result.message = message;
+			output.close();
+			std::error_code errorCode;
+			std::filesystem::remove(temporaryPath, errorCode);
+			return false;
+		};
+
+		// 先頭と目次は格納する大きさが決まってから書くので、ひとまず0で埋めておく
+		uint64_t position = 0;
+		PadTo(output, position, header.dataOffset);
+
+		std::vector<char> buffer(1024 * 1024);
+		std::vector<uint8_t> contents;
+		std::vector<uint8_t> frame;
+		for (size_t i = 0; i < files.size(); ++i) {
+			AssetPack::Entry& entry = entries[i];
+			PadTo(output, position, AlignUp(position, alignment));
+			entry.offset = position;
+			std::ifstream input(files[i]->diskPath, std::ios::binary);
+
+			if (isCompressionEnabled) {
+				// 全体を読んで圧縮し、十分に縮んだ時だけ圧縮したものを格納する
+				contents.resize(static_cast<size_t>(entry.size));
+				input.read(reinterpret_cast<char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+				if (static_cast<uint64_t>(input.gcount()) != entry.size) {
+					return fail("failed to read " + files[i]->diskPath);
+				}
+				LZCompressor::Compress(contents.data(), contents.size(), settings.level, settings.blockSize, frame, settings.parallelFor);
+				if (entry.size > 0 && static_cast<double>(frame.size()) <= static_cast<double>(entry.size) * settings.maxCompressedRatio) {
+					entry.storedSize = frame.size();
+					entry.compression = static_cast<uint32_t>(AssetPack::Compression::LZ);
+					output.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(frame.size()));
+					++result.compressedFileCount;
+				} else {
+					output.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+				}
+				position += entry.storedSize;
+				continue;
+			}
+
+			uint64_t remaining = entry.storedSize;
+			while (input && remaining > 0) {
+				const uint64_t count = (std::min)(remaining, static_cast<uint64_t>(buffer.size()));
+				input.read(buffer.data(), static_cast<std::streamsize>(count));
+				output.write(buffer.data(), input.gcount());
+				remaining -= static_cast<uint64_t>(input.gcount());
+				position += static_cast<uint64_t>(input.gcount());
+			}
+			if (remaining != 0) {
+				return fail("failed to read " + files[i]->diskPath);
+			}
+		}
+		result.packBytes = position;
+		for (const AssetPack::Entry& entry : entries) {
+			result.storedBytes += entry.storedSize;
+		}
+
+		// 目次はハッシュの順（データの位置はパスの順のまま。ハッシュが重なってもFindがパスで確かめる）
+		std::vector<AssetPack::Entry> toc = entries;
+		std::sort(toc.begin(), toc.end(), [](const AssetPack::Entry& a, const AssetPack::Entry& b) {
+			return a.pathHash < b.pathHash;
+		});
+		output.seekp(0);
+		output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		output.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(AssetPack::Entry)));
+		output.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+		if (!output) {
+			return fail("failed to write " + temporaryPath.generic_string());
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode) {
+		std::filesystem::remove(temporaryPath, errorCode);
+		result.message = "failed to replace " + outputPath;
+		return false;
+	}
+
+	result.isSucceeded = true;
+	result.fileCount = static_cast<uint32_t>(files.size());
+	return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BaseSystem/FileSystem/AssetPack.h"
+#include "BaseSystem/FileSystem/LZCompressor.h"
+
+/// <summary>
+/// ファイルを集めてアーカイブ（AssetPack）を書き出す
+/// D3Dなどに依存しないので、Tools/AssetPackBuilderからビルドマシンでも使える
+/// データは元のパスの順に並べる（同じフォルダのものが隣り合うので、続けて読む時にシークが減る）
+/// 圧縮を有効にすると、縮むファイルだけLZCompressorで圧縮して格納する（PNGやMP3など圧縮済みのものはそのまま）
+/// </summary>
+class AssetPackBuilder {
+public:
+	// データの位置の既定の単位（ページの大きさにそろえるとマップしたデータがページをまたがずに始まる）
+	static const uint32_t kDefaultAlignment = 4096;
+
+	/// <summary>
+	/// 書き出しの設定
+	/// </summary>
+	struct Settings {
+		uint32_t alignment = kDefaultAlignment;	// 2の累乗
+		AssetPack::Compression compression = AssetPack::Compression::None;
+		LZCompressor::Level level = LZCompressor::Level::Fast;
+		uint32_t blockSize = LZCompressor::kDefaultBlockSize;
+		float maxCompressedRatio = 0.9f;		// 圧縮後がこの割合より大きいファイルはそのまま格納する
+		LZCompressor::ParallelFor parallelFor;	// ブロックを並列に圧縮する関数（空なら順に）
+	};
+
+	/// <summary>
+	/// 書き出しの結果
+	/// </summary>
+	struct Result {
+		bool isSucceeded = false;
+		uint32_t fileCount = 0;
+		uint32_t compressedFileCount = 0;
+		uint64_t sourceBytes = 0;	// 元のファイルの合計
+		uint64_t storedBytes = 0;	// 格納したデータの合計（圧縮したものは圧縮後）
+		uint64_t packBytes = 0;		// 書き出したアーカイブの大きさ
+		std::string message;		// 失敗した理由
+	};
+
+	/// <summary>
+	/// ファイルを追加する
+	/// </summary>
+	/// <param name="virtualPath">アーカイブの中のパス（読む時に指定するパス。正規化して格納する）</param>
+	/// <param name="diskPath">実際のファイルのパス</param>
+	void AddFile(const std::string& virtualPath, const std::string& diskPath);
+
+	/// <summary>
+	/// フォルダの下のファイルを全て追加する（アーカイブの中のパスは実際のパスと同じ）
+	/// </summary>
+	/// <param name="directory">フォルダ（resourcesなど）</param>
+	/// <returns>追加したファイルの数</returns>
+	uint32_t AddDirectory(const std::string& directory);
+
+	/// <summary>
+	/// 追加したファイルをアーカイブに書き出す（同じパスが2つあれば失敗）
+	/// </summary>
+	/// <param name="outputPath">書き出すパス</param>
+	/// <param name="settings">設定</param>
+	/// <param name="result">結果</param>
+	/// <returns>書き出せたかどうか</returns>
+	bool Build(const std::string& outputPath, const Settings& settings, Result& result) const;
+
+	/// <summary>
+	/// 追加したファイルの数
+	/// </summary>
+	size_t GetFileCount() const { return files_.size(); }
+
+private:
+	struct SourceFile {
+		std::string virtualPath;	// 正規化済み
+		std::string diskPath;
+	};
+	std::vector<SourceFile> files_;
+};
@@ -0,0 +1,276 @@
+#include "FileWatcher.h"
+#include <filesystem>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::~FileWatcher() {
+	Stop();
+}
+
+std::vector<std::string> FileWatcher::CollectChanges(std::chrono::milliseconds settleTime) {
+	std::vector<std::string> changes;
+	const Clock::time_point now = Clock::now();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto it = pendingChanges_.begin(); it != pendingChanges_.end();) {
+			if (now - it->second < settleTime) {
+				++it;
+				continue;
+			}
+			changes.push_back(it->first);
+			it = pendingChanges_.erase(it);
+		}
+	}
+
+	// フォルダの変更や、書いた後に消されたもの（一時ファイルなど）は返さない
+	std::error_code errorCode;
+	std::erase_if(changes, [&errorCode](const std::string& path) {
+		return !std::filesystem::is_regular_file(path, errorCode);
+	});
+	return changes;
+}
+
+void FileWatcher::AddChange(const std::string& relativePath) {
+	std::string path = directory_;
+	path += '/';
+	for (char c : relativePath) {
+		path.push_back(c == '\\' ? '/' : c);
+	}
+	++eventCount_;
+	std::lock_guard<std::mutex> lock(mutex_);
+	pendingChanges_[path] = Clock::now();
+}
+
+#ifdef _WIN32
+
+bool FileWatcher::Start(const std::string& directory) {
+	Stop();
+
+	directory_ = directory;
+	while (!directory_.empty() && (directory_.back() == '/' || directory_.back() == '\\')) {
+		directory_.pop_back();
+	}
+
+	const int wideLength = MultiByteToWideChar(CP_UTF8, 0, directory_.c_str(), -1, nullptr, 0);
+	if (wideLength <= 0) {
+		return false;
+	}
+	std::wstring directoryW(static_cast<size_t>(wideLength - 1), L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, directory_.c_str(), -1, directoryW.data(), wideLength);
+	HANDLE directoryHandle = CreateFileW(directoryW.c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (directoryHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	HANDLE stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!stopEvent) {
+		CloseHandle(directoryHandle);
+		return false;
+	}
+	directoryHandle_ = directoryHandle;
+	stopEvent_ = stopEvent;
+
+	isStopRequested_ = false;
+	isRunning_ = true;
+	thread_ = std::thread(&FileWatcher::WatchThread, this);
+	return true;
+}
+
+void FileWatcher::Stop() {
+	if (thread_.joinable()) {
+		isStopRequested_ = true;
+		SetEvent(static_cast<HANDLE>(stopEvent_));
+		thread_.join();
+	}
+	if (directoryHandle_) {
+		CloseHandle(static_cast<HANDLE>(directoryHandle_));
+		directoryHandle_ = nullptr;
+	}
+	if (stopEvent_) {
+		CloseHandle(static_cast<HANDLE>(stopEvent_));
+		stopEvent_ = nullptr;
+	}
+	isRunning_ = false;
+	std::lock_guard<std::mutex> lock(mutex_);
+	pendingChanges_.clear();
+}
+
+void FileWatcher::WatchThread() {
+	HANDLE directoryHandle = static_cast<HANDLE>(directoryHandle_);
+	HANDLE stopEvent = static_cast<HANDLE>(stopEvent_);
+	HANDLE completionEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!completionEvent) {
+		isRunning_ = false;
+		return;
+	}
+
+	// FILE_NOTIFY_INFORMATIONはDWORD境界に並ぶ
+	std::vector<DWORD> buffer(16 * 1024);
+	const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+
+	while (!isStopRequested_) {
+		OVERLAPPED overlapped{};
+		overlapped.hEvent = completionEvent;
+		ResetEvent(completionEvent);
+		if (!ReadDirectoryChangesW(directoryHandle, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)),
+			TRUE, filter, nullptr, &overlapped, nullptr)) {
+			break;
+		}
+
+		const HANDLE events[] = { completionEvent, stopEvent };
+		const DWORD waitResult = WaitForMultipleObjects(2, events, FALSE, INFINITE);
+		if (waitResult != WAIT_OBJECT_0) {
+			// 止める時は待っている読み込みを取り消してから抜ける
+			CancelIoEx(directoryHandle, &overlapped);
+			DWORD ignored = 0;
+			GetOverlappedResult(directoryHandle, &overlapped, &ignored, TRUE);
+			break;
+		}
+
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(directoryHandle, &overlapped, &bytes, FALSE)) {
+			break;
+		}
+		// 0バイトはバッファがあふれて変更を取りこぼした時（何が変わったか分からないので見送る）
+		if (bytes == 0) {
+			continue;
+		}
+
+		const uint8_t* cursor = reinterpret_cast<const uint8_t*>(buffer.data());
+		for (;;) {
+			const FILE_NOTIFY_INFORMATION* information = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+			if (information->Action == FILE_ACTION_MODIFIED || information->Action == FILE_ACTION_ADDED ||
+				information->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+				const int wideLength = static_cast<int>(information->FileNameLength / sizeof(WCHAR));
+				const int length = WideCharToMultiByte(CP_UTF8, 0, information->FileName, wideLength, nullptr, 0, nullptr, nullptr);
+				std::string relativePath(static_cast<size_t>(length), '\0');
+				WideCharToMultiByte(CP_UTF8, 0, information->FileName, wideLength, relativePath.data(), length, nullptr, nullptr);
+				AddChange(relativePath);
+			}
+			if (information->NextEntryOffset == 0) {
+				break;
+			}
+			cursor += information->NextEntryOffset;
+		}
+	}
+
+	CloseHandle(completionEvent);
+	isRunning_ = false;
+}
+
+#else
+
+bool FileWatcher::Start(const std::string& directory) {
+	Stop();
+
+	directory_ = directory;
+	while (!directory_.empty() && directory_.back() == '/') {
+		directory_.pop_back();
+	}
+
+	std::error_code errorCode;
+	if (!std::filesystem::is_directory(directory_, errorCode)) {
+		return false;
+	}
+	inotifyDescriptor_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyDescriptor_ < 0) {
+		return false;
+	}
+	AddWatchRecursive("");
+
+	isStopRequested_ = false;
+	isRunning_ = true;
+	thread_ = std::thread(&FileWatcher::WatchThread, this);
+	return true;
+}
+
+void FileWatcher::Stop() {
+	if (thread_.joinable()) {
+		isStopRequested_ = true;
+		thread_.join();
+	}
+	if (inotifyDescriptor_ >= 0) {
+		close(inotifyDescriptor_);
+		inotifyDescriptor_ = -1;
+	}
+	watchDirectories_.clear();
+	isRunning_ = false;
+	std::lock_guard<std::mutex> lock(mutex_);
+	pendingChanges_.clear();
+}
+
+void FileWatcher::AddWatchRecursive(const std::string& relativeDirectory) {
+	const std::string directory = relativeDirectory.empty() ? directory_ : directory_ + "/" + relativeDirectory;
+	// 書き終わって閉じた時と、別名から移してきた時だけ拾う（書いている途中の変更は拾わない）
+	const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+	const int watch = inotify_add_watch(inotifyDescriptor_, directory.c_str(), mask);
+	if (watch < 0) {
+		return;
+	}
+	watchDirectories_[watch] = relativeDirectory;
+
+	std::error_code errorCode;
+	for (const auto& child : std::filesystem::directory_iterator(directory, errorCode)) {
+		if (child.is_directory(errorCode)) {
+			const std::string name = child.path().filename().string();
+			AddWatchRecursive(relativeDirectory.empty() ? name : relativeDirectory + "/" + name);
+		}
+	}
+}
+
+void FileWatcher::WatchThread() {
+	// inotify_eventは可変長なので、境界を揃えたバッファにまとめて読む
+	alignas(inotify_event) char buffer[16 * 1024];
+
+	while (!isStopRequested_) {
+		// 止める要求を見るために、短い間隔で起きる
+		pollfd descriptor{ inotifyDescriptor_, POLLIN, 0 };
+		if (poll(&descriptor, 1, 100) <= 0) {
+			continue;
+		}
+
+		const ssize_t length = read(inotifyDescriptor_, buffer, sizeof(buffer));
+		if (length <= 0) {
+			continue;
+		}
+
+		for (ssize_t offset = 0; offset < length;) {
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+			auto it = watchDirectories_.find(event->wd);
+			if (it == watchDirectories_.end()) {
+				continue;
+			}
+			if (event->mask & IN_IGNORED) {
+				watchDirectories_.erase(it);
+				continue;
+			}
+			if (event->len == 0) {
+				continue;
+			}
+			const std::string relativePath = it->second.empty() ? std::string(event->name) : it->second + "/" + event->name;
+
+			if (event->mask & IN_ISDIR) {
+				// 作られた・移されてきたフォルダも見張る（中身は後から書かれたものを拾う）
+				if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+					AddWatchRecursive(relativePath);
+				}
+				continue;
+			}
+			if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+				AddChange(relativePath);
+			}
+		}
+	}
+	isRunning_ = false;
+}
+
+#endif
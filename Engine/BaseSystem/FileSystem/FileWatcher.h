@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// フォルダの下（サブフォルダを含む）で書き換えられたファイルを見張る（ホットリロード用）
+/// WindowsはReadDirectoryChangesW、それ以外はinotifyを別スレッドで待つ
+/// エディタは保存の時に何回かに分けて書いたり、別名で書いてから置き換えたりするので、
+/// 最後の変更から少し経ったものだけをCollectChangesで返す（書きかけのファイルを読まないように）
+/// D3Dに依存しないので単体で検証できる
+/// </summary>
+class FileWatcher {
+public:
+	// 最後の変更から、書き終わったとみなすまでの時間
+	static constexpr std::chrono::milliseconds kDefaultSettleTime{ 200 };
+
+	FileWatcher() = default;
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	/// <summary>
+	/// 見張りを始める（見張っていたものは止める）
+	/// </summary>
+	/// <param name="directory">見張るフォルダ（resourcesなど。返すパスはこれを先頭に付けたもの）</param>
+	/// <returns>始められたかどうか</returns>
+	bool Start(const std::string& directory);
+
+	/// <summary>
+	/// 見張りを止める（スレッドの終了を待つ）
+	/// </summary>
+	void Stop();
+
+	/// <summary>
+	/// 書き終わったファイルを取り出す（取り出したものは次から返さない）
+	/// </summary>
+	/// <param name="settleTime">最後の変更からこれだけ経ったものを返す</param>
+	/// <returns>書き換えられたファイルのパス（resources/Model/Axis/axis.objのように/区切り）</returns>
+	std::vector<std::string> CollectChanges(std::chrono::milliseconds settleTime = kDefaultSettleTime);
+
+	bool IsRunning() const { return isRunning_; }
+	const std::string& GetDirectory() const { return directory_; }
+
+	/// <summary>
+	/// 見つけた変更の数（同じファイルへの変更もまとめずに数える）
+	/// </summary>
+	uint64_t GetEventCount() const { return eventCount_; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>
+	/// 変更を待つスレッド
+	/// </summary>
+	void WatchThread();
+
+	/// <summary>
+	/// 変更があったファイルを記録する
+	/// </summary>
+	/// <param name="relativePath">見張っているフォルダからの相対パス</param>
+	void AddChange(const std::string& relativePath);
+
+	std::string directory_;
+	std::thread thread_;
+	std::atomic<bool> isRunning_ = false;
+	std::atomic<bool> isStopRequested_ = false;
+	std::atomic<uint64_t> eventCount_ = 0;
+
+	// 書き換えられたファイルと最後に変更があった時刻
+	std::unordered_map<std::string, Clock::time_point> pendingChanges_;
+	std::mutex mutex_;
+
+#ifdef _WIN32
+	void* directoryHandle_ = nullptr;	// HANDLE（windows.hをヘッダーに入れないようにvoid*で持つ）
+	void* stopEvent_ = nullptr;
+#else
+	int inotifyDescriptor_ = -1;
+	std::unordered_map<int, std::string> watchDirectories_;	// inotifyの見張りごとの相対フォルダ
+
+	/// <summary>
+	/// フォルダとその下のフォルダを全て見張る（inotifyはサブフォルダを見ないため）
+	/// </summary>
+	void AddWatchRecursive(const std::string& relativeDirectory);
+#endif
+};
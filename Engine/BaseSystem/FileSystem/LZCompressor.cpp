@@ -0,0 +1,468 @@
+#include "LZCompressor.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+namespace {
+	// LZ4のブロック形式の決まり
+	const size_t kMinMatch = 4;				// 一致の最短の長さ
+	const size_t kLastLiterals = 5;			// 最後の5バイトは必ずリテラル
+	const size_t kMatchFindLimit = 12;		// 最後の一致は末尾から12バイトより前で始まる
+	const size_t kMaxOffset = 65535;		// 一致を探す範囲（64KB）
+
+	// Fast：ハッシュ表だけ（16Kエントリ）
+	const uint32_t kFastHashLog = 14;
+	// High：ハッシュの先頭と、64KBの範囲の前の位置への距離の鎖
+	const uint32_t kHighHashLog = 16;
+	const size_t kWindowMask = 0xFFFF;
+	const uint32_t kHighMaxAttempts = 128;	// 鎖をたどる回数の上限
+
+	uint32_t Read32(const uint8_t* p) {
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint32_t HashSequence(uint32_t sequence, uint32_t hashLog) {
+		return (sequence * 2654435761u) >> (32 - hashLog);
+	}
+
+	/// <summary>
+	/// 2か所が何バイト一致するか（aがlimitに届くまで、8バイトずつ比べる）
+	/// </summary>
+	size_t CountMatch(const uint8_t* a, const uint8_t* b, const uint8_t* limit) {
+		const uint8_t* const start = a;
+		while (a + 8 <= limit) {
+			uint64_t valueA, valueB;
+			std::memcpy(&valueA, a, 8);
+			std::memcpy(&valueB, b, 8);
+			const uint64_t difference = valueA ^ valueB;
+			if (difference != 0) {
+				return static_cast<size_t>(a - start) + static_cast<size_t>(std::countr_zero(difference) / 8);
+			}
+			a += 8;
+			b += 8;
+		}
+		while (a < limit && *a == *b) {
+			++a;
+			++b;
+		}
+		return static_cast<size_t>(a - start);
+	}
+
+	/// <summary>
+	/// 15以上の長さの続きを書く（255を並べて最後に残り）
+	/// </summary>
+	void WriteLength(uint8_t*& op, size_t length) {
+		while (length >= 255) {
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = static_cast<uint8_t>(length);
+	}
+
+	/// <summary>
+	/// 15以上の長さの続きを読む
+	/// </summary>
+	bool ReadLength(const uint8_t*& ip, const uint8_t* ipEnd, size_t& length) {
+		uint8_t value;
+		do {
+			if (ip >= ipEnd) {
+				return false;
+			}
+			value = *ip++;
+			length += value;
+		} while (value == 255);
+		return true;
+	}
+
+	/// <summary>
+	/// 1つのシーケンス（リテラル＋一致）を書く
+	/// </summary>
+	/// <returns>書き込み先に収まったかどうか</returns>
+	bool WriteSequence(uint8_t*& op, const uint8_t* opEnd, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+		const size_t matchCode = matchLength - kMinMatch;
+		const size_t required = 1 + literalLength + literalLength / 255 + 1 + 2 + matchCode / 255 + 1;
+		if (required > static_cast<size_t>(opEnd - op)) {
+			return false;
+		}
+		uint8_t* token = op++;
+		if (literalLength >= 15) {
+			*token = 15 << 4;
+			WriteLength(op, literalLength - 15);
+		} else {
+			*token = static_cast<uint8_t>(literalLength << 4);
+		}
+		std::memcpy(op, literals, literalLength);
+		op += literalLength;
+		*op++ = static_cast<uint8_t>(offset);
+		*op++ = static_cast<uint8_t>(offset >> 8);
+		if (matchCode >= 15) {
+			*token |= 15;
+			WriteLength(op, matchCode - 15);
+		} else {
+			*token |= static_cast<uint8_t>(matchCode);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 最後のリテラルだけのシーケンスを書く
+	/// </summary>
+	bool WriteLastLiterals(uint8_t*& op, const uint8_t* opEnd, const uint8_t* literals, size_t literalLength) {
+		const size_t required = 1 + literalLength + literalLength / 255 + 1;
+		if (required > static_cast<size_t>(opEnd - op)) {
+			return false;
+		}
+		if (literalLength >= 15) {
+			*op++ = 15 << 4;
+			WriteLength(op, literalLength - 15);
+		} else {
+			*op++ = static_cast<uint8_t>(literalLength << 4);
+		}
+		std::memcpy(op, literals, literalLength);
+		op += literalLength;
+		return true;
+	}
+
+	/// <summary>
+	/// 16バイトずつまとめてコピーする（最後の端数も16バイト書くので、両方に余裕がある時だけ使う）
+	/// </summary>
+	void WildCopy16(uint8_t* destination, const uint8_t* source, size_t size) {
+		for (size_t i = 0; i < size; i += 16) {
+			std::memcpy(destination + i, source + i, 16);
+		}
+	}
+
+	/// <summary>
+	/// [0, count)を処理する（関数がなければ順に）
+	/// </summary>
+	void ForEachBlock(uint32_t count, const std::function<void(uint32_t)>& function, const LZCompressor::ParallelFor& parallelFor) {
+		if (parallelFor && count > 1) {
+			parallelFor(count, function);
+			return;
+		}
+		for (uint32_t i = 0; i < count; ++i) {
+			function(i);
+		}
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//																			//
+///								フレーム（ブロックの集まり）					   ///
+//																			//
+///*-----------------------------------------------------------------------*///
+
+void LZCompressor::Compress(const uint8_t* source, size_t size, Level level, uint32_t blockSize, std::vector<uint8_t>& frame,
+	const ParallelFor& parallelFor) {
+	blockSize = std::clamp(blockSize, kMinBlockSize, kMaxBlockSize);
+	const uint32_t blockCount = static_cast<uint32_t>((size + blockSize - 1) / blockSize);
+
+	// ブロックごとに圧縮する（元より縮まなければそのまま入れる）
+	std::vector<std::vector<uint8_t>> blocks(blockCount);
+	std::vector<uint32_t> storedSizes(blockCount);
+	ForEachBlock(blockCount, [&](uint32_t blockIndex) {
+		const size_t begin = static_cast<size_t>(blockIndex) * blockSize;
+		const size_t rawSize = (std::min)(static_cast<size_t>(blockSize), size - begin);
+		std::vector<uint8_t>& block = blocks[blockIndex];
+		block.resize(rawSize);
+		const size_t compressedSize = CompressBlock(source + begin, rawSize, block.data(), rawSize - 1, level);
+		if (compressedSize == 0) {
+			std::memcpy(block.data(), source + begin, rawSize);
+			storedSizes[blockIndex] = static_cast<uint32_t>(rawSize) | kStoredBlockFlag;
+		} else {
+			block.resize(compressedSize);
+			storedSizes[blockIndex] = static_cast<uint32_t>(compressedSize);
+		}
+	}, parallelFor);
+
+	FrameHeader header;
+	header.blockSize = blockSize;
+	header.blockCount = blockCount;
+	header.size = size;
+	size_t frameSize = sizeof(FrameHeader) + blockCount * sizeof(uint32_t);
+	for (const std::vector<uint8_t>& block : blocks) {
+		frameSize += block.size();
+	}
+
+	frame.resize(frameSize);
+	uint8_t* output = frame.data();
+	std::memcpy(output, &header, sizeof(header));
+	output += sizeof(header);
+	for (uint32_t storedSize : storedSizes) {
+		std::memcpy(output, &storedSize, sizeof(storedSize));
+		output += sizeof(storedSize);
+	}
+	for (const std::vector<uint8_t>& block : blocks) {
+		std::memcpy(output, block.data(), block.size());
+		output += block.size();
+	}
+}
+
+bool LZCompressor::Decompress(const uint8_t* frame, size_t frameSize, uint8_t* destination, size_t size,
+	const ParallelFor& parallelFor) {
+	// 先頭とブロックの表の範囲を確かめる
+	FrameHeader header;
+	if (frameSize < sizeof(header)) {
+		return false;
+	}
+	std::memcpy(&header, frame, sizeof(header));
+	if (header.magic != kMagic || header.size != size ||
+		header.blockSize < kMinBlockSize || header.blockSize > kMaxBlockSize ||
+		header.blockCount != (size + header.blockSize - 1) / header.blockSize) {
+		return false;
+	}
+	const size_t tableSize = static_cast<size_t>(header.blockCount) * sizeof(uint32_t);
+	if (frameSize - sizeof(header) < tableSize) {
+		return false;
+	}
+	if (header.blockCount == 0) {
+		return true;
+	}
+
+	// 各ブロックの位置を先に決めておく（ブロックどうしは独立しているので、どの順で展開してもよい）
+	std::vector<uint32_t> storedSizes(header.blockCount);
+	std::memcpy(storedSizes.data(), frame + sizeof(header), tableSize);
+	std::vector<size_t> offsets(header.blockCount);
+	size_t offset = sizeof(header) + tableSize;
+	for (uint32_t i = 0; i < header.blockCount; ++i) {
+		offsets[i] = offset;
+		offset += storedSizes[i] & ~kStoredBlockFlag;
+		if (offset > frameSize) {
+			return false;
+		}
+	}
+
+	std::atomic<bool> isSucceeded = true;
+	ForEachBlock(header.blockCount, [&](uint32_t blockIndex) {
+		const size_t begin = static_cast<size_t>(blockIndex) * header.blockSize;
+		const size_t rawSize = (std::min)(static_cast<size_t>(header.blockSize), size - begin);
+		const uint32_t storedSize = storedSizes[blockIndex] & ~kStoredBlockFlag;
+		const uint8_t* block = frame + offsets[blockIndex];
+		if ((storedSizes[blockIndex] & kStoredBlockFlag) != 0) {
+			if (storedSize != rawSize) {
+				isSucceeded = false;
+				return;
+			}
+			std::memcpy(destination + begin, block, rawSize);
+		} else if (!DecompressBlock(block, storedSize, destination + begin, rawSize)) {
+			isSucceeded = false;
+		}
+	}, parallelFor);
+	return isSucceeded;
+}
+
+///*-----------------------------------------------------------------------*///
+//																			//
+///									1ブロック								   ///
+//																			//
+///*-----------------------------------------------------------------------*///
+
+size_t LZCompressor::CompressBlock(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity, Level level) {
+	return level == Level::High ?
+		CompressBlockHigh(source, size, destination, capacity) :
+		CompressBlockFast(source, size, destination, capacity);
+}
+
+size_t LZCompressor::CompressBlockFast(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity) {
+	uint8_t* op = destination;
+	const uint8_t* const opEnd = destination + capacity;
+	size_t anchor = 0;
+
+	// 短すぎるものは一致を探さずにリテラルだけにする
+	if (size > kMatchFindLimit) {
+		const size_t matchLimit = size - kLastLiterals;
+		const size_t inputLimit = size - kMatchFindLimit;
+		std::vector<uint32_t> table(size_t(1) << kFastHashLog, 0);
+
+		size_t position = 1;
+		while (position <= inputLimit) {
+			const uint32_t sequence = Read32(source + position);
+			uint32_t& slot = table[HashSequence(sequence, kFastHashLog)];
+			const size_t candidate = slot;
+			slot = static_cast<uint32_t>(position);
+
+			if (candidate < position && position - candidate <= kMaxOffset && Read32(source + candidate) == sequence) {
+				// 前にも一致が伸ばせるならリテラルを減らす
+				size_t matchStart = position;
+				size_t reference = candidate;
+				while (matchStart > anchor && reference > 0 && source[matchStart - 1] == source[reference - 1]) {
+					--matchStart;
+					--reference;
+				}
+				const size_t matchLength = (position - matchStart) + kMinMatch +
+					CountMatch(source + position + kMinMatch, source + candidate + kMinMatch, source + matchLimit);
+				if (!WriteSequence(op, opEnd, source + anchor, matchStart - anchor, position - candidate, matchLength)) {
+					return 0;
+				}
+				position = matchStart + matchLength;
+				anchor = position;
+				// 一致の終わりの少し手前も登録しておくと、続く一致が見つかりやすい
+				if (position <= inputLimit) {
+					table[HashSequence(Read32(source + position - 2), kFastHashLog)] = static_cast<uint32_t>(position - 2);
+				}
+				continue;
+			}
+
+			// 一致しない所が続くほど大きく飛ばす（縮まないデータを早く通り過ぎる）
+			position += 1 + ((position - anchor) >> 6);
+		}
+	}
+
+	if (!WriteLastLiterals(op, opEnd, source + anchor, size - anchor)) {
+		return 0;
+	}
+	return static_cast<size_t>(op - destination);
+}
+
+size_t LZCompressor::CompressBlockHigh(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity) {
+	uint8_t* op = destination;
+	const uint8_t* const opEnd = destination + capacity;
+	size_t anchor = 0;
+
+	if (size > kMatchFindLimit) {
+		const size_t matchLimit = size - kLastLiterals;
+		const size_t inputLimit = size - kMatchFindLimit;
+		// ハッシュごとの最後の位置と、各位置から同じハッシュの1つ前の位置までの距離（64KBを超えたら打ち切り）
+		std::vector<int32_t> head(size_t(1) << kHighHashLog, -1);
+		std::vector<uint16_t> chain(kWindowMask + 1, 0);
+		size_t nextInsert = 0;
+
+		// positionより前の位置を全て鎖に入れてから、positionで始まる最長の一致を探す
+		auto findLongestMatch = [&](size_t position, size_t& matchPosition) {
+			for (; nextInsert < position; ++nextInsert) {
+				int32_t& last = head[HashSequence(Read32(source + nextInsert), kHighHashLog)];
+				const size_t distance = last < 0 ? kMaxOffset : nextInsert - static_cast<size_t>(last);
+				chain[nextInsert & kWindowMask] = static_cast<uint16_t>((std::min)(distance, kMaxOffset));
+				last = static_cast<int32_t>(nextInsert);
+			}
+
+			const uint32_t sequence = Read32(source + position);
+			const int32_t first = head[HashSequence(sequence, kHighHashLog)];
+			size_t bestLength = 0;
+			if (first < 0) {
+				return bestLength;
+			}
+			size_t candidate = static_cast<size_t>(first);
+			for (uint32_t attempt = 0; attempt < kHighMaxAttempts && position - candidate <= kMaxOffset; ++attempt) {
+				// 今の最長より長くなりうるものだけ比べる
+				if (source[candidate + bestLength] == source[position + bestLength] && Read32(source + candidate) == sequence) {
+					const size_t length = kMinMatch + CountMatch(source + position + kMinMatch, source + candidate + kMinMatch, source + matchLimit);
+					if (length > bestLength) {
+						bestLength = length;
+						matchPosition = candidate;
+						if (position + length >= matchLimit) {
+							break;
+						}
+					}
+				}
+				const size_t distance = chain[candidate & kWindowMask];
+				if (distance == 0 || distance > candidate) {
+					break;
+				}
+				candidate -= distance;
+			}
+			return bestLength;
+		};
+
+		size_t position = 0;
+		while (position <= inputLimit) {
+			size_t matchPosition = 0;
+			size_t matchLength = findLongestMatch(position, matchPosition);
+			if (matchLength < kMinMatch) {
+				++position;
+				continue;
+			}
+
+			// 1つ先から始めた方が長ければそちらを使う（遅延評価）
+			while (position + 1 <= inputLimit) {
+				size_t nextPosition = 0;
+				const size_t nextLength = findLongestMatch(position + 1, nextPosition);
+				if (nextLength <= matchLength) {
+					break;
+				}
+				++position;
+				matchLength = nextLength;
+				matchPosition = nextPosition;
+			}
+
+			if (!WriteSequence(op, opEnd, source + anchor, position - anchor, position - matchPosition, matchLength)) {
+				return 0;
+			}
+			position += matchLength;
+			anchor = position;
+		}
+	}
+
+	if (!WriteLastLiterals(op, opEnd, source + anchor, size - anchor)) {
+		return 0;
+	}
+	return static_cast<size_t>(op - destination);
+}
+
+bool LZCompressor::DecompressBlock(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size) {
+	const uint8_t* ip = source;
+	const uint8_t* const ipEnd = source + sourceSize;
+	uint8_t* op = destination;
+	uint8_t* const opEnd = destination + size;
+
+	for (;;) {
+		if (ip >= ipEnd) {
+			return false;
+		}
+		const uint8_t token = *ip++;
+
+		// リテラル
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(ip, ipEnd, literalLength)) {
+			return false;
+		}
+		if (literalLength > static_cast<size_t>(ipEnd - ip) || literalLength > static_cast<size_t>(opEnd - op)) {
+			return false;
+		}
+		if (static_cast<size_t>(ipEnd - ip) >= literalLength + 15 && static_cast<size_t>(opEnd - op) >= literalLength + 15) {
+			WildCopy16(op, ip, literalLength);
+		} else {
+			std::memcpy(op, ip, literalLength);
+		}
+		ip += literalLength;
+		op += literalLength;
+
+		// 最後のシーケンスはリテラルだけ
+		if (ip == ipEnd) {
+			break;
+		}
+
+		// 一致
+		if (ipEnd - ip < 2) {
+			return false;
+		}
+		const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<size_t>(op - destination)) {
+			return false;
+		}
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength)) {
+			return false;
+		}
+		matchLength += kMinMatch;
+		if (matchLength > static_cast<size_t>(opEnd - op)) {
+			return false;
+		}
+
+		// 離れていれば16バイトずつ（読む所は書き終えた所だけ）、近ければ重なるので1バイトずつ
+		const uint8_t* match = op - offset;
+		if (offset >= 16 && static_cast<size_t>(opEnd - op) >= matchLength + 15) {
+			WildCopy16(op, match, matchLength);
+		} else {
+			for (size_t i = 0; i < matchLength; ++i) {
+				op[i] = match[i];
+			}
+		}
+		op += matchLength;
+	}
+	return op == opEnd;
+}
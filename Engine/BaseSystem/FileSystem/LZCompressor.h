@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// LZ4と同じブロック形式の圧縮・展開（アーカイブに入れるファイルの圧縮用）
+/// データを独立したブロック（64～256KB）に分けて圧縮するので、ブロックごとに別のスレッドで展開できる
+/// D3D・ThreadPoolに依存しないので、Tools/AssetPackBuilderからも使える（並列に処理する関数は呼び出し側から渡す）
+///
+/// 圧縮したデータの並び：[FrameHeader][各ブロックの格納バイト数（uint32 × blockCount）][ブロック...]
+/// 格納バイト数の最上位ビットが立っているブロックは、縮まなかったのでそのまま入れたもの
+/// </summary>
+class LZCompressor {
+public:
+	static constexpr uint32_t kMagic = 0x31425A4C;			// "LZB1"
+	static constexpr uint32_t kDefaultBlockSize = 128 * 1024;
+	static constexpr uint32_t kMinBlockSize = 64 * 1024;
+	static constexpr uint32_t kMaxBlockSize = 256 * 1024;
+	static constexpr uint32_t kStoredBlockFlag = 0x80000000;
+
+	/// <summary>
+	/// 圧縮の強さ（展開の速さはどちらも同じ）
+	/// </summary>
+	enum class Level {
+		Fast,	// ハッシュ表を1回引くだけ（LZ4の既定と同じ考え方）
+		High,	// ハッシュの鎖を64KBの範囲でたどって最長の一致を探し、1つ先の方が長ければそちらを使う（遅いが縮む）
+	};
+
+	/// <summary>
+	/// 圧縮したデータの先頭
+	/// </summary>
+	struct FrameHeader {
+		uint32_t magic = kMagic;
+		uint32_t blockSize = 0;		// 最後以外のブロックの元のバイト数
+		uint32_t blockCount = 0;
+		uint32_t reserved = 0;
+		uint64_t size = 0;			// 元のバイト数
+	};
+	static_assert(sizeof(FrameHeader) == 24, "LZCompressor::FrameHeader layout");
+
+	/// <summary>
+	/// [0, count)を並列に処理して全て終わるまで待つ関数（ThreadPool::ParallelForなど。空なら順に処理する）
+	/// </summary>
+	using ParallelFor = std::function<void(uint32_t count, const std::function<void(uint32_t)>& function)>;
+
+	/// <summary>
+	/// データを圧縮する
+	/// </summary>
+	/// <param name="source">元のデータ</param>
+	/// <param name="size">元のバイト数</param>
+	/// <param name="level">圧縮の強さ</param>
+	/// <param name="blockSize">ブロックの大きさ（kMinBlockSize～kMaxBlockSizeに丸める）</param>
+	/// <param name="frame">圧縮したデータ</param>
+	/// <param name="parallelFor">ブロックを並列に圧縮する関数</param>
+	static void Compress(const uint8_t* source, size_t size, Level level, uint32_t blockSize, std::vector<uint8_t>& frame,
+		const ParallelFor& parallelFor = nullptr);
+
+	/// <summary>
+	/// 圧縮したデータを展開する（壊れたデータでも範囲外を読み書きしない）
+	/// </summary>
+	/// <param name="frame">圧縮したデータ</param>
+	/// <param name="frameSize">圧縮したデータのバイト数</param>
+	/// <param name="destination">展開先</param>
+	/// <param name="size">展開先のバイト数（元のバイト数と一致している必要がある）</param>
+	/// <param name="parallelFor">ブロックを並列に展開する関数</param>
+	/// <returns>展開できたかどうか</returns>
+	static bool Decompress(const uint8_t* frame, size_t frameSize, uint8_t* destination, size_t size,
+		const ParallelFor& parallelFor = nullptr);
+
+	/// <summary>
+	/// 1ブロックを圧縮する
+	/// </summary>
+	/// <returns>圧縮後のバイト数（capacityに収まらなければ0）</returns>
+	static size_t CompressBlock(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity, Level level);
+
+	/// <summary>
+	/// 1ブロックを展開する
+	/// </summary>
+	/// <returns>ちょうどsizeバイトに展開できたかどうか</returns>
+	static bool DecompressBlock(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size);
+
+	/// <summary>
+	/// 1ブロックを圧縮した時の最大のバイト数
+	/// </summary>
+	static size_t GetBlockBound(size_t size) { return size + size / 255 + 16; }
+
+	/// <summary>
+	/// 表示用の名前
+	/// </summary>
+	static const char* GetLevelName(Level level) { return level == Level::High ? "High" : "Fast"; }
+
+private:
+	LZCompressor() = delete;
+	~LZCompressor() = delete;
+
+	static size_t CompressBlockFast(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity);
+	static size_t CompressBlockHigh(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity);
+};
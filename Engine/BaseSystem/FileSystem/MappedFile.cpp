@@ -0,0 +1,152 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+	MoveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		Close();
+		MoveFrom(other);
+	}
+	return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& other) {
+	data_ = other.data_;
+	size_ = other.size_;
+	isOpen_ = other.isOpen_;
+#ifdef _WIN32
+	fileHandle_ = other.fileHandle_;
+	mappingHandle_ = other.mappingHandle_;
+	other.fileHandle_ = nullptr;
+	other.mappingHandle_ = nullptr;
+#else
+	fileDescriptor_ = other.fileDescriptor_;
+	other.fileDescriptor_ = -1;
+#endif
+	other.data_ = nullptr;
+	other.size_ = 0;
+	other.isOpen_ = false;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	const int wideLength = MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0);
+	if (wideLength <= 0) {
+		return false;
+	}
+	std::wstring filePathW(static_cast<size_t>(wideLength - 1), L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, filePathW.data(), wideLength);
+
+	HANDLE file = CreateFileW(filePathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle_ = file;
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	isOpen_ = true;
+
+	// 大きさ0のファイルはマップできないので、開いただけにする
+	if (size_ == 0) {
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		Close();
+		return false;
+	}
+	mappingHandle_ = mapping;
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!data_) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mappingHandle_) {
+		CloseHandle(static_cast<HANDLE>(mappingHandle_));
+	}
+	if (fileHandle_) {
+		CloseHandle(static_cast<HANDLE>(fileHandle_));
+	}
+	data_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+	fileHandle_ = nullptr;
+	mappingHandle_ = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	const int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) {
+		return false;
+	}
+	struct stat status {};
+	if (::fstat(fileDescriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+		::close(fileDescriptor);
+		return false;
+	}
+	fileDescriptor_ = fileDescriptor;
+	size_ = static_cast<size_t>(status.st_size);
+	isOpen_ = true;
+
+	// 大きさ0のファイルはマップできないので、開いただけにする
+	if (size_ == 0) {
+		return true;
+	}
+
+	void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (mapped == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	data_ = static_cast<const uint8_t*>(mapped);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		::munmap(const_cast<uint8_t*>(data_), size_);
+	}
+	if (fileDescriptor_ >= 0) {
+		::close(fileDescriptor_);
+	}
+	data_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+	fileDescriptor_ = -1;
+}
+
+#endif
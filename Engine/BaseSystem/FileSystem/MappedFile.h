@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// 読み取り専用でメモリにマップしたファイル（コピーせずにファイルの中身をそのまま参照する）
+/// WindowsはCreateFileMapping、それ以外はmmapを使う
+/// </summary>
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/// <summary>
+	/// ファイルを開いてマップする（開いていたものは閉じる）
+	/// </summary>
+	/// <param name="filePath">ファイルのパス（UTF-8）</param>
+	/// <returns>開けたかどうか（大きさ0のファイルも開けたものとして扱う）</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// マップを外してファイルを閉じる
+	/// </summary>
+	void Close();
+
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	bool IsOpen() const { return isOpen_; }
+
+private:
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+	bool isOpen_ = false;
+
+#ifdef _WIN32
+	void* fileHandle_ = nullptr;	// HANDLE（windows.hをヘッダーに入れないようにvoid*で持つ）
+	void* mappingHandle_ = nullptr;
+#else
+	int fileDescriptor_ = -1;
+#endif
+
+	void MoveFrom(MappedFile& other);
+};
@@ -0,0 +1,164 @@
+#include "VirtualFileSystem.h"
+#include "BaseSystem/FileSystem/LZCompressor.h"
+#include "BaseSystem/Logger/Logger.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+
+// シングルトンインスタンス
+VirtualFileSystem* VirtualFileSystem::GetInstance() {
+	static VirtualFileSystem instance;
+	return &instance;
+}
+
+bool VirtualFileSystem::MountPack(const std::string& packPath) {
+	auto pack = std::make_shared<AssetPack>();
+	std::string message;
+	if (!pack->Open(packPath, message)) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to mount asset pack: {} ({})\n", packPath, message));
+		return false;
+	}
+
+	const uint32_t entryCount = pack->GetEntryCount();
+	const uint64_t fileSize = pack->GetFileSize();
+	{
+		std::unique_lock lock(mutex_);
+		packs_.push_back(std::move(pack));
+	}
+	Logger::Log(Logger::GetStream(), std::format("Mounted asset pack: {} ({} files, {} KB)\n", packPath, entryCount, fileSize / 1024));
+	return true;
+}
+
+void VirtualFileSystem::UnmountAll() {
+	std::unique_lock lock(mutex_);
+	packs_.clear();
+	looseOverrides_.clear();
+}
+
+void VirtualFileSystem::AddLooseOverride(const std::string& path) {
+	std::unique_lock lock(mutex_);
+	looseOverrides_.insert(AssetPack::NormalizePath(path));
+}
+
+FileView VirtualFileSystem::Open(const std::string& path) {
+	FileView view;
+
+	// アーカイブにあればマップしたものをそのまま指す（圧縮したものは展開する）
+	std::shared_ptr<const AssetPack> pack;
+	const AssetPack::Entry* entry = nullptr;
+	if (FindPacked(AssetPack::NormalizePath(path), pack, entry)) {
+		if (entry->compression == static_cast<uint32_t>(AssetPack::Compression::LZ)) {
+			if (!Decompress(*pack, *entry, view)) {
+				Logger::Log(Logger::GetStream(), std::format("Failed to decompress from asset pack: {}\n", path));
+				++failedOpenCount_;
+				return FileView{};
+			}
+			++packedOpenCount_;
+			return view;
+		}
+		if (entry->compression != static_cast<uint32_t>(AssetPack::Compression::None)) {
+			Logger::Log(Logger::GetStream(), std::format("Unsupported compression {} in asset pack: {}\n", entry->compression, path));
+			++failedOpenCount_;
+			return view;
+		}
+		if (entry->size != entry->storedSize) {
+			// 開く時に確かめているが、範囲外を指さないようにここでも弾く
+			Logger::Log(Logger::GetStream(), std::format("Size mismatch of uncompressed entry in asset pack: {}\n", path));
+			++failedOpenCount_;
+			return view;
+		}
+		view.data_ = pack->GetStoredData(*entry);
+		view.size_ = static_cast<size_t>(entry->size);
+		view.isValid_ = true;
+		view.isPacked_ = true;
+		view.owner_ = std::move(pack);
+		++packedOpenCount_;
+		return view;
+	}
+
+	// なければディスクのファイルをマップする
+	auto file = std::make_shared<MappedFile>();
+	if (!file->Open(path)) {
+		++failedOpenCount_;
+		return view;
+	}
+	view.data_ = file->GetData();
+	view.size_ = file->GetSize();
+	view.isValid_ = true;
+	view.owner_ = std::move(file);
+	++looseOpenCount_;
+	return view;
+}
+
+bool VirtualFileSystem::Exists(const std::string& path) const {
+	if (IsPacked(path)) {
+		return true;
+	}
+	std::error_code errorCode;
+	return std::filesystem::is_regular_file(path, errorCode);
+}
+
+bool VirtualFileSystem::IsPacked(const std::string& path) const {
+	std::shared_ptr<const AssetPack> pack;
+	const AssetPack::Entry* entry = nullptr;
+	return FindPacked(AssetPack::NormalizePath(path), pack, entry);
+}
+
+VirtualFileSystem::Statistics VirtualFileSystem::GetStatistics() const {
+	Statistics statistics;
+	{
+		std::shared_lock lock(mutex_);
+		statistics.packCount = static_cast<uint32_t>(packs_.size());
+		for (const auto& pack : packs_) {
+			statistics.packedEntryCount += pack->GetEntryCount();
+		}
+	}
+	statistics.packedOpenCount = packedOpenCount_;
+	statistics.looseOpenCount = looseOpenCount_;
+	statistics.failedOpenCount = failedOpenCount_;
+	statistics.decompressedOpenCount = decompressedOpenCount_;
+	statistics.decompressedBytes = decompressedBytes_;
+	statistics.decompressMicroseconds = decompressMicroseconds_;
+	return statistics;
+}
+
+bool VirtualFileSystem::FindPacked(const std::string& normalizedPath, std::shared_ptr<const AssetPack>& pack, const AssetPack::Entry*& entry) const {
+	std::shared_lock lock(mutex_);
+	if (!looseOverrides_.empty() && looseOverrides_.contains(normalizedPath)) {
+		return false;
+	}
+	for (auto it = packs_.rbegin(); it != packs_.rend(); ++it) {
+		entry = (*it)->Find(normalizedPath);
+		if (entry) {
+			pack = *it;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool VirtualFileSystem::Decompress(const AssetPack& pack, const AssetPack::Entry& entry, FileView& view) {
+	const auto startTime = std::chrono::steady_clock::now();
+
+	// ブロックごとにワーカースレッドで展開する（呼び出し元がワーカーでもParallelForは入れ子にしてよい）
+	auto contents = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(entry.size));
+	const LZCompressor::ParallelFor parallelFor = [](uint32_t count, const std::function<void(uint32_t)>& function) {
+		ThreadPool::GetInstance()->ParallelFor(count, function);
+	};
+	if (!LZCompressor::Decompress(pack.GetStoredData(entry), static_cast<size_t>(entry.storedSize), contents->data(), contents->size(), parallelFor)) {
+		return false;
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+	++decompressedOpenCount_;
+	decompressedBytes_ += entry.size;
+	decompressMicroseconds_ += static_cast<uint64_t>(elapsed.count());
+
+	view.data_ = contents->data();
+	view.size_ = contents->size();
+	view.isValid_ = true;
+	view.isPacked_ = true;
+	view.owner_ = std::move(contents);
+	return true;
+}
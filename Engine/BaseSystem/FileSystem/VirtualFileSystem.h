@@ -0,0 +1,174 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "BaseSystem/FileSystem/AssetPack.h"
+
+/// <summary>
+/// 開いたファイルの中身（アーカイブや単体のファイルをマップしたメモリをそのまま指す）
+/// 中身はこのビューが生きている間だけ使える（アーカイブを外しても、ビューが持っている間はマップを残す）
+/// </summary>
+class FileView {
+public:
+	FileView() = default;
+
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	std::string_view GetText() const { return std::string_view(reinterpret_cast<const char*>(data_), size_); }
+
+	/// <summary>
+	/// 開けたかどうか（大きさ0のファイルも開けたものとして扱う）
+	/// </summary>
+	bool IsValid() const { return isValid_; }
+
+	/// <summary>
+	/// アーカイブから読んだかどうか
+	/// </summary>
+	bool IsPacked() const { return isPacked_; }
+
+private:
+	friend class VirtualFileSystem;
+
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+	bool isValid_ = false;
+	bool isPacked_ = false;
+	std::shared_ptr<const void> owner_;	// アーカイブか、単体で開いたファイルのマップか、展開したデータ
+};
+
+/// <summary>
+/// テキストを1行ずつ取り出す（行末の\r\nと\nのどちらにも対応、コピーしない）
+/// </summary>
+class TextLineReader {
+public:
+	explicit TextLineReader(std::string_view text) : text_(text) {}
+
+	/// <summary>
+	/// 次の行（改行は含まない）
+	/// </summary>
+	/// <returns>行があったかどうか</returns>
+	bool ReadLine(std::string_view& line) {
+		if (position_ >= text_.size()) {
+			return false;
+		}
+		size_t end = text_.find('\n', position_);
+		if (end == std::string_view::npos) {
+			end = text_.size();
+		}
+		line = text_.substr(position_, end - position_);
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		position_ = end + 1;
+		return true;
+	}
+
+private:
+	std::string_view text_;
+	size_t position_ = 0;
+};
+
+/// <summary>
+/// ファイルの読み込みを一か所にまとめる仮想ファイルシステム
+/// マウントしたアーカイブ（後からマウントしたものが優先）にあればそこから、なければディスクの単体のファイルを読む
+/// どちらもメモリにマップしたものをコピーせずに返す。アーカイブは起動時に1回開くだけなので、ファイルごとのオープンとシークがなくなる
+/// 圧縮して格納したものは、開く時にブロックをThreadPoolで並列に展開してビューに持たせる
+/// 読み込みはワーカースレッドからも呼んでよい（TextureManager::LoadTexturesのように別々のファイルを並列に開けば、展開と解析が重なる）
+/// </summary>
+class VirtualFileSystem {
+public:
+	// 起動時にマウントするアーカイブ（Tools/AssetPackBuilderでresourcesから作る。なければ単体のファイルを読む）
+	static constexpr const char* kDefaultPackPath = "resources.pak";
+
+	/// <summary>
+	/// 読み込みの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t packCount = 0;
+		uint32_t packedEntryCount = 0;	// マウントしたアーカイブの項目数の合計
+		uint64_t packedOpenCount = 0;	// アーカイブから開いた回数
+		uint64_t looseOpenCount = 0;	// 単体のファイルを開いた回数
+		uint64_t failedOpenCount = 0;	// どこにもなかった回数
+		uint64_t decompressedOpenCount = 0;	// アーカイブから開いたうち、展開した回数
+		uint64_t decompressedBytes = 0;		// 展開したバイト数の合計
+		uint64_t decompressMicroseconds = 0;	// 展開にかかった時間の合計
+	};
+
+	// シングルトン
+	static VirtualFileSystem* GetInstance();
+
+	/// <summary>
+	/// アーカイブをマウントする
+	/// </summary>
+	/// <param name="packPath">アーカイブのパス</param>
+	/// <returns>マウントできたかどうか</returns>
+	bool MountPack(const std::string& packPath);
+
+	/// <summary>
+	/// 全てのアーカイブを外す（開いているビューはそのまま使える）
+	/// </summary>
+	void UnmountAll();
+
+	/// <summary>
+	/// 単体のファイルをアーカイブより優先して読むようにする（ホットリロードで書き換えたファイル用）
+	/// </summary>
+	/// <param name="path">ファイルのパス（resources/...）</param>
+	void AddLooseOverride(const std::string& path);
+
+	/// <summary>
+	/// ファイルを開く（アーカイブ→ディスクの順に探す）
+	/// </summary>
+	/// <param name="path">ファイルのパス（resources/...）</param>
+	/// <returns>中身（見つからなければIsValidがfalse）</returns>
+	FileView Open(const std::string& path);
+
+	/// <summary>
+	/// ファイルがあるかどうか（アーカイブかディスクのどちらか）
+	/// </summary>
+	bool Exists(const std::string& path) const;
+
+	/// <summary>
+	/// マウントしたアーカイブに入っているかどうか
+	/// </summary>
+	bool IsPacked(const std::string& path) const;
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	Statistics GetStatistics() const;
+
+private:
+	VirtualFileSystem() = default;
+	~VirtualFileSystem() = default;
+	VirtualFileSystem(const VirtualFileSystem&) = delete;
+	VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+	/// <summary>
+	/// アーカイブから探す（後からマウントしたものから。単体のファイルを優先するものは探さない）
+	/// </summary>
+	bool FindPacked(const std::string& normalizedPath, std::shared_ptr<const AssetPack>& pack, const AssetPack::Entry*& entry) const;
+
+	/// <summary>
+	/// 圧縮して格納したものを展開してビューに持たせる
+	/// </summary>
+	bool Decompress(const AssetPack& pack, const AssetPack::Entry& entry, FileView& view);
+
+	// マウントしたアーカイブ（ビューが持っている間は外しても残る）
+	std::vector<std::shared_ptr<const AssetPack>> packs_;
+	// アーカイブより単体のファイルを優先するもの（正規化したパス）
+	std::unordered_set<std::string> looseOverrides_;
+	mutable std::shared_mutex mutex_;
+
+	std::atomic<uint64_t> packedOpenCount_ = 0;
+	std::atomic<uint64_t> looseOpenCount_ = 0;
+	std::atomic<uint64_t> failedOpenCount_ = 0;
+	std::atomic<uint64_t> decompressedOpenCount_ = 0;
+	std::atomic<uint64_t> decompressedBytes_ = 0;
+	std::atomic<uint64_t> decompressMicroseconds_ = 0;
+};
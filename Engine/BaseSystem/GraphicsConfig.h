@@ -19,6 +19,8 @@ public:
 	static const uint32_t kRTVHeapSize = 5;   // スワップチェーン2+ オフスクリーン描画1、+pingpong切り替えで2
 	static const uint32_t kDSVHeapSize = 2;   // メイン + オフスクリーン
 	static const uint32_t kSRVHeapSize = 128; // テクスチャ + ImGui
+	static const uint32_t kTransientSRVCount = 64;	// SRVヒープの後ろに置く、1フレームだけ使うディスクリプタのリング
+	static const uint32_t kStagingSRVHeapSize = 16;	// リングへコピーする元のSRVを置くCPU専用ヒープ（中間バッファなど）
 	///*-----------------------------------------------------------------------*///
 	///							ディスクリプタインデックス							///
 	///*-----------------------------------------------------------------------*///
@@ -36,6 +38,10 @@ public:
 	///								テクスチャ管理用								///
 	///*-----------------------------------------------------------------------*///
 	static const uint32_t kImGuiSRVIndex = 0;           // ImGui専用SRVインデックス
+	static const uint64_t kTextureMemoryBudget = 256ull * 1024 * 1024;	// テクスチャを常駐させるメモリの予算（超えたら使われていないものを粗いミップに落とす）
+	static const uint32_t kTextureTailSize = 64;		// 常に常駐させるミップの長辺（これ以下のミップは落とさない）
+	static const uint64_t kTextureStagingSize = 64ull * 1024 * 1024;	// テクスチャのアップロードに使うステージングバッファ（足りない時はコピーの完了を待って使い回す）
+	static const bool kUseCookedTextures = true;		// クック済みのDDS（Cookedフォルダ）が元の画像より新しければそちらを読む
 
 	/// <summary>
 	/// オフスクリーン用RTVインデックスを取得(これから複数実装する場合に何個目か入れれば特定できる)
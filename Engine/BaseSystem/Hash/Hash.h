@@ -0,0 +1,172 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/// <summary>
+/// 64bit FNV-1aハッシュ
+/// 実行環境やビルドに依存しない決定的な値を返すので、ディスクキャッシュのキーにも使える
+/// </summary>
+class Hash {
+public:
+	static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+	static constexpr uint64_t kPrime = 0x100000001b3ull;
+	static constexpr uint32_t kOffsetBasis32 = 0x811c9dc5u;
+	static constexpr uint32_t kPrime32 = 0x01000193u;
+
+	/// <summary>
+	/// バイト列のハッシュ（seedに続けて計算するので連結して使える）
+	/// </summary>
+	static uint64_t Bytes(const void* data, size_t size, uint64_t seed = kOffsetBasis) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash = seed;
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= kPrime;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// 文字列のハッシュ（コンパイル時にも計算できる）
+	/// </summary>
+	static constexpr uint64_t String(std::string_view str, uint64_t seed = kOffsetBasis) {
+		uint64_t hash = seed;
+		for (char c : str) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= kPrime;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// 文字列の32bitハッシュ（32bit FNV-1a、コンパイル時にも計算できる。StringIdで使う）
+	/// </summary>
+	static constexpr uint32_t String32(std::string_view str) {
+		uint32_t hash = kOffsetBasis32;
+		for (char c : str) {
+			hash ^= static_cast<uint8_t>(c);
+			hash *= kPrime32;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// ワイド文字列のハッシュ（1文字2バイトとして計算するので環境によらず同じ値になる）
+	/// </summary>
+	static uint64_t WString(std::wstring_view str, uint64_t seed = kOffsetBasis) {
+		uint64_t hash = seed;
+		for (wchar_t c : str) {
+			const uint16_t code = static_cast<uint16_t>(c);
+			hash ^= static_cast<uint8_t>(code & 0xff);
+			hash *= kPrime;
+			hash ^= static_cast<uint8_t>(code >> 8);
+			hash *= kPrime;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// 整数値のハッシュ（リトルエンディアンのバイト列として計算）
+	/// </summary>
+	static constexpr uint64_t Value(uint64_t value, uint64_t seed = kOffsetBasis) {
+		uint64_t hash = seed;
+		for (int i = 0; i < 8; ++i) {
+			hash ^= static_cast<uint8_t>(value >> (i * 8));
+			hash *= kPrime;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// 2つのハッシュ値を合成
+	/// </summary>
+	static constexpr uint64_t Combine(uint64_t seed, uint64_t value) {
+		return Value(value, seed);
+	}
+
+	/// <summary>
+	/// ファイルの中身のような大きなバイト列のハッシュ（xxHash64と同じ値）
+	/// FNV-1aは1バイトずつ掛け算するので遅い。こちらは8バイトずつ4列を並べて混ぜるので、読み込むファイル全体にかけても気にならない
+	/// 同じ中身のファイルを見分けるのに使う（Bytesとは別の値になる）
+	/// </summary>
+	static uint64_t Content(const void* data, size_t size, uint64_t seed = 0) {
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		const uint8_t* const end = p + size;
+		uint64_t hash;
+
+		if (size >= 32) {
+			uint64_t lanes[4] = { seed + kContentPrime1 + kContentPrime2, seed + kContentPrime2, seed, seed - kContentPrime1 };
+			const uint8_t* const limit = end - 32;
+			do {
+				for (uint64_t& lane : lanes) {
+					lane = ContentRound(lane, Read64(p));
+					p += 8;
+				}
+			} while (p <= limit);
+
+			hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+			for (uint64_t lane : lanes) {
+				hash = (hash ^ ContentRound(0, lane)) * kContentPrime1 + kContentPrime4;
+			}
+		} else {
+			hash = seed + kContentPrime5;
+		}
+		hash += static_cast<uint64_t>(size);
+
+		// 残りの端数
+		for (; p + 8 <= end; p += 8) {
+			hash ^= ContentRound(0, Read64(p));
+			hash = RotateLeft(hash, 27) * kContentPrime1 + kContentPrime4;
+		}
+		if (p + 4 <= end) {
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			hash ^= static_cast<uint64_t>(value) * kContentPrime1;
+			hash = RotateLeft(hash, 23) * kContentPrime2 + kContentPrime3;
+			p += 4;
+		}
+		for (; p < end; ++p) {
+			hash ^= static_cast<uint64_t>(*p) * kContentPrime5;
+			hash = RotateLeft(hash, 11) * kContentPrime1;
+		}
+
+		// 最後にビットを行き渡らせる
+		hash ^= hash >> 33;
+		hash *= kContentPrime2;
+		hash ^= hash >> 29;
+		hash *= kContentPrime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+private:
+	// Contentで使う素数（xxHash64と同じ）
+	static constexpr uint64_t kContentPrime1 = 0x9e3779b185ebca87ull;
+	static constexpr uint64_t kContentPrime2 = 0xc2b2ae3d27d4eb4full;
+	static constexpr uint64_t kContentPrime3 = 0x165667b19e3779f9ull;
+	static constexpr uint64_t kContentPrime4 = 0x85ebca77c2b2ae63ull;
+	static constexpr uint64_t kContentPrime5 = 0x27d4eb2f165667c5ull;
+
+	static constexpr uint64_t RotateLeft(uint64_t value, int shift) {
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	static constexpr uint64_t ContentRound(uint64_t lane, uint64_t input) {
+		lane += input * kContentPrime2;
+		return RotateLeft(lane, 31) * kContentPrime1;
+	}
+
+	// 境界に揃っていない位置からも読めるようにmemcpyで読む（リトルエンディアンの環境のみ）
+	static uint64_t Read64(const uint8_t* p) {
+		uint64_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	// ::で呼び出すためにインスタンス化しないように設定
+	Hash() = delete;
+	~Hash() = delete;
+};
@@ -0,0 +1,52 @@
+#include "StringId.h"
+#include "BaseSystem/Logger/Logger.h"
+#include <cassert>
+#include <format>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+	/// <summary>
+	/// 登録済みの文字列（識別子の値から元の文字列を引く）
+	/// </summary>
+	struct StringIdRegistry {
+		std::mutex mutex;
+		std::unordered_map<uint32_t, std::string> strings;
+	};
+
+	StringIdRegistry& GetRegistry() {
+		static StringIdRegistry registry;
+		return registry;
+	}
+}
+
+StringId StringId::Intern(std::string_view str) {
+	const StringId id(str);
+
+	StringIdRegistry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	auto [it, isInserted] = registry.strings.try_emplace(id.GetValue(), str);
+	if (!isInserted && it->second != str) {
+		// 32bitなので起こりにくいが、起きたら名前を変えてもらう
+		Logger::Log(Logger::GetStream(), std::format("StringId: '{}' and '{}' have the same id 0x{:08x}\n",
+			it->second, str, id.GetValue()));
+		assert(false && "StringId collision");
+	}
+	return id;
+}
+
+std::string StringId::GetString() const {
+	StringIdRegistry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	auto it = registry.strings.find(value_);
+	if (it != registry.strings.end()) {
+		return it->second;
+	}
+	return std::format("0x{:08x}", value_);
+}
+
+size_t StringId::GetInternedCount() {
+	StringIdRegistry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	return registry.strings.size();
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "BaseSystem/Hash/Hash.h"
+
+/// <summary>
+/// 文字列を32bitの値にした識別子（タグ名などの比較・検索を整数で行うため）
+/// 値は文字列の32bit FNV-1aなので、実行ごとに変わらず、リテラルならコンパイル時に計算できる
+///		constexpr StringId kWhite("white");
+/// 元の文字列はInternで登録したものだけGetStringで引ける（ログ・ImGui用）
+/// 登録時に別の文字列と同じ値になった場合はログを出してassertする
+/// </summary>
+class StringId {
+public:
+	// 無効な値（空文字列のハッシュとは別）
+	static constexpr uint32_t kInvalidValue = 0;
+
+	constexpr StringId() = default;
+	constexpr explicit StringId(std::string_view str) : value_(Hash::String32(str)) {}
+	constexpr explicit StringId(const char* str) : StringId(std::string_view(str)) {}
+	explicit StringId(const std::string& str) : StringId(std::string_view(str)) {}
+
+	/// <summary>
+	/// 文字列を登録して識別子を返す（GetStringで元の文字列を引けるようにする、スレッドセーフ）
+	/// </summary>
+	static StringId Intern(std::string_view str);
+
+	/// <summary>
+	/// 登録済みの元の文字列を取得（未登録なら値を16進数にしたもの）
+	/// </summary>
+	std::string GetString() const;
+
+	/// <summary>
+	/// 登録済みの文字列の数
+	/// </summary>
+	static size_t GetInternedCount();
+
+	constexpr uint32_t GetValue() const { return value_; }
+	constexpr bool IsValid() const { return value_ != kInvalidValue; }
+
+	constexpr bool operator==(const StringId& other) const { return value_ == other.value_; }
+	constexpr bool operator!=(const StringId& other) const { return value_ != other.value_; }
+	constexpr bool operator<(const StringId& other) const { return value_ < other.value_; }
+
+private:
+	uint32_t value_ = kInvalidValue;
+};
+
+// unordered_mapのキーに使えるように（値が既にハッシュなのでそのまま使う）
+template<>
+struct std::hash<StringId> {
+	size_t operator()(const StringId& id) const noexcept { return id.GetValue(); }
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BaseSystem/Hash/StringId.h"
+
+/// <summary>
+/// リソースのハンドル（StringIdTableの番号。Tagで種類ごとに別の型にして取り違えを防ぐ）
+/// </summary>
+template<typename Tag>
+struct ResourceHandle {
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	uint32_t index = kInvalidIndex;
+
+	constexpr bool IsValid() const { return index != kInvalidIndex; }
+	constexpr bool operator==(const ResourceHandle& other) const { return index == other.index; }
+	constexpr bool operator!=(const ResourceHandle& other) const { return index != other.index; }
+};
+
+/// <summary>
+/// StringIdから番号を割り当て、番号で値を引く表
+/// 番号は一度割り当てたら表を作り直すまで変わらないので、呼び出し側は番号を覚えておけば
+/// 以降は文字列もハッシュも使わず配列の添字だけで値を引ける
+/// まだ読み込まれていない名前にも番号を割り当てられ、値は後から設定・解除できる（解除しても番号は残る）
+/// </summary>
+template<typename T>
+class StringIdTable {
+public:
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	/// <summary>
+	/// 番号を取得（なければ割り当てる。値は空のまま）
+	/// </summary>
+	uint32_t Acquire(StringId id) {
+		auto [it, isInserted] = indices_.try_emplace(id, static_cast<uint32_t>(entries_.size()));
+		if (isInserted) {
+			entries_.push_back({ id, T{} });
+		}
+		return it->second;
+	}
+
+	/// <summary>
+	/// 番号を検索（なければkInvalidIndex）
+	/// </summary>
+	uint32_t Find(StringId id) const {
+		auto it = indices_.find(id);
+		return it != indices_.end() ? it->second : kInvalidIndex;
+	}
+
+	/// <summary>
+	/// 値を設定（番号がなければ割り当てる）
+	/// </summary>
+	uint32_t Set(StringId id, const T& value) {
+		const uint32_t index = Acquire(id);
+		entries_[index].value = value;
+		return index;
+	}
+
+	/// <summary>
+	/// 値を空に戻す（番号は残る）
+	/// </summary>
+	void Reset(StringId id) {
+		const uint32_t index = Find(id);
+		if (index != kInvalidIndex) {
+			entries_[index].value = T{};
+		}
+	}
+
+	/// <summary>
+	/// 全ての値を空に戻す（番号は残る）
+	/// </summary>
+	void ResetAll() {
+		for (Entry& entry : entries_) {
+			entry.value = T{};
+		}
+	}
+
+	/// <summary>
+	/// 番号から値を取得（範囲外なら空の値）
+	/// </summary>
+	T Get(uint32_t index) const {
+		return index < entries_.size() ? entries_[index].value : T{};
+	}
+
+	/// <summary>
+	/// 番号からStringIdを取得（範囲外なら無効なStringId）
+	/// </summary>
+	StringId GetId(uint32_t index) const {
+		return index < entries_.size() ? entries_[index].id : StringId{};
+	}
+
+	// 割り当て済みの番号の数
+	uint32_t GetSize() const { return static_cast<uint32_t>(entries_.size()); }
+
+private:
+	struct Entry {
+		StringId id;
+		T value{};
+	};
+
+	std::vector<Entry> entries_;
+	std::unordered_map<StringId, uint32_t> indices_;
+};
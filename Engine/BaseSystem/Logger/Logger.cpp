@@ -11,6 +11,7 @@
 //変数の定義
 std::ofstream Logger::logFileStream_;
 bool Logger::isEnabled_ = true;  // デフォルトで有効
+std::mutex Logger::mutex_;
 
 void Logger::Initalize()
 {
@@ -62,6 +63,8 @@ void Logger::Log(const std::string& message) {
 		return;
 	}
 
+	std::lock_guard<std::mutex> lock(mutex_);
+
 	// 出力ウィンドウに出力
 	OutputDebugStringA(message.c_str());
 
@@ -79,6 +82,8 @@ void Logger::Log(std::ostream& os, const std::string& message) {
 		return;
 	}
 
+	std::lock_guard<std::mutex> lock(mutex_);
+
 	// カスタムストリームに出力
 	os << message;
 	if (&os == &logFileStream_) {
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <ostream>
 #include<format>
@@ -8,6 +10,8 @@
 #include<fstream>
 //時間を扱うライブラリ
 #include<chrono>
+//複数スレッドからの出力を排他する
+#include<mutex>
 
 class Logger
 {
@@ -64,6 +68,9 @@ private:
 	//ログの出力先
 	static std::ofstream logFileStream_;
 
+	// 複数スレッドから同時に書き込まないための排他
+	static std::mutex mutex_;
+
 	// ログ有効フラグ
 	static bool isEnabled_;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "ThreadPool.h"
+#include "BaseSystem/Logger/Logger.h"
+#include <atomic>
+#include <algorithm>
+#include <memory>
+
+ThreadPool* ThreadPool::GetInstance() {
+	static ThreadPool instance;
+	return &instance;
+}
+
+ThreadPool::~ThreadPool() {
+	Finalize();
+}
+
+void ThreadPool::Initialize(uint32_t threadCount) {
+	if (IsInitialized()) {
+		return;
+	}
+
+	if (threadCount == 0) {
+		// メインスレッドの分を1つ残す
+		uint32_t hardwareCount = std::thread::hardware_concurrency();
+		threadCount = (hardwareCount > 1) ? hardwareCount - 1 : 1;
+	}
+
+	isStopping_ = false;
+	workers_.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		workers_.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	Logger::Log(Logger::GetStream(), std::format("ThreadPool: Started {} worker threads\n", threadCount));
+}
+
+void ThreadPool::Finalize() {
+	if (!IsInitialized()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isStopping_ = true;
+	}
+	condition_.notify_all();
+
+	for (std::thread& worker : workers_) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	workers_.clear();
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()> job) {
+	std::packaged_task<void()> task(std::move(job));
+	std::future<void> future = task.get_future();
+
+	// 起動していない場合はその場で実行
+	if (!IsInitialized()) {
+		task();
+		return future;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push(std::move(task));
+	}
+	condition_.notify_one();
+	return future;
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function) {
+	if (count == 0) {
+		return;
+	}
+
+	// 起動していない、または1件だけならその場で実行
+	if (!IsInitialized() || count == 1) {
+		for (uint32_t i = 0; i < count; ++i) {
+			function(i);
+		}
+		return;
+	}
+
+	// 処理の進み具合を共有する（呼び出し元が先に戻っても手伝いのジョブが安全に終われるように共有ポインタで持つ）
+	struct SharedState {
+		std::atomic<uint32_t> nextIndex = 0;
+		uint32_t completedCount = 0;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+	auto state = std::make_shared<SharedState>();
+
+	// インデックスを取り出しながら処理する
+	auto work = [state, count, &function]() {
+		uint32_t processed = 0;
+		for (uint32_t i = state->nextIndex++; i < count; i = state->nextIndex++) {
+			function(i);
+			++processed;
+		}
+		if (processed > 0) {
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->completedCount += processed;
+			if (state->completedCount == count) {
+				state->condition.notify_all();
+			}
+		}
+	};
+
+	// ワーカーに手伝いを頼む（呼び出し元も参加するので1つ少なくてよい）
+	const uint32_t helperCount = (std::min)(GetThreadCount(), count - 1);
+	for (uint32_t i = 0; i < helperCount; ++i) {
+		// functionの参照は全件完了までしか使われない（完了後に始まったジョブはすぐ抜ける）
+		Submit(work);
+	}
+
+	// 呼び出し元も処理
+	work();
+
+	// 全件の完了を待つ（手伝いのジョブの終了ではなく件数で待つのでワーカー内から呼んでも詰まらない）
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->condition.wait(lock, [&state, count]() { return state->completedCount == count; });
+}
+
+void ThreadPool::WorkerLoop() {
+	while (true) {
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return isStopping_ || !jobs_.empty(); });
+			if (isStopping_ && jobs_.empty()) {
+				return;
+			}
+			task = std::move(jobs_.front());
+			jobs_.pop();
+		}
+		task();
+	}
+}
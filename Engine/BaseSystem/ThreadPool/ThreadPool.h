@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+/// <summary>
+/// ワーカースレッドを使い回して処理を並列実行するクラス
+/// 起動時のシェーダーコンパイルやアセット読み込みなど、重い処理の並列化に使う
+/// </summary>
+class ThreadPool {
+public:
+	//シングルトン（エンジン全体で共有するプール）
+	static ThreadPool* GetInstance();
+
+	/// <summary>
+	/// ワーカースレッドを起動
+	/// </summary>
+	/// <param name="threadCount">スレッド数（0の場合は論理コア数-1、最低1）</param>
+	void Initialize(uint32_t threadCount = 0);
+
+	/// <summary>
+	/// 残っている処理を終わらせてワーカースレッドを終了
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 処理を追加
+	/// </summary>
+	/// <param name="job">実行する処理</param>
+	/// <returns>完了待ち用のfuture</returns>
+	std::future<void> Submit(std::function<void()> job);
+
+	/// <summary>
+	/// [0, count)の範囲を並列に処理して、全て終わるまで待つ
+	/// 呼び出し元のスレッドも処理に参加する
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="function">各インデックスに対して呼ばれる処理</param>
+	void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function);
+
+	/// <summary>
+	/// ワーカースレッド数を取得
+	/// </summary>
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+	/// <summary>
+	/// 起動済みかどうか
+	/// </summary>
+	bool IsInitialized() const { return !workers_.empty(); }
+
+private:
+	// コンストラクタ
+	ThreadPool() = default;
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// <summary>
+	/// ワーカースレッドの処理
+	/// </summary>
+	void WorkerLoop();
+
+private:
+	std::vector<std::thread> workers_;
+	std::queue<std::packaged_task<void()>> jobs_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	bool isStopping_ = false;
+};
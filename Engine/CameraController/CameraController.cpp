@@ -32,6 +32,11 @@ void CameraController::RegisterCamera(const std::string& cameraId, std::unique_p
 	}
 
 	registeredCameras_[cameraId] = { std::move(camera), false };
+
+	// アクティブなカメラを差し替えた場合は覚えているポインタも差し替える
+	if (activeCameraId_ == cameraId) {
+		activeCamera_ = registeredCameras_[cameraId].camera.get();
+	}
 }
 
 void CameraController::UnregisterCamera(const std::string& cameraId) {
@@ -46,11 +51,13 @@ void CameraController::UnregisterCamera(const std::string& cameraId) {
 	}
 
 	// 現在アクティブなカメラを削除する場合は、normalカメラに切り替え
-	if (activeCameraId_ == cameraId) {
+	const bool isActiveCamera = activeCameraId_ == cameraId;
+	registeredCameras_.erase(it);
+	if (isActiveCamera) {
 		activeCameraId_ = "normal";
+		auto normalIt = registeredCameras_.find(activeCameraId_);
+		activeCamera_ = (normalIt != registeredCameras_.end()) ? normalIt->second.camera.get() : nullptr;
 	}
-
-	registeredCameras_.erase(it);
 }
 
 void CameraController::SetActiveCamera(const std::string& cameraId) {
@@ -64,6 +71,7 @@ void CameraController::SetActiveCamera(const std::string& cameraId) {
 	}
 
 	activeCameraId_ = cameraId;
+	activeCamera_ = it->second.camera.get();
 }
 
 void CameraController::Update() {
@@ -108,8 +116,8 @@ void CameraController::ToggleDebugCamera() {
 
 
 BaseCamera* CameraController::GetActiveCamera() const {
-	auto it = registeredCameras_.find(activeCameraId_);
-	return (it != registeredCameras_.end()) ? it->second.camera.get() : nullptr;
+	// 行列の取得などで毎フレーム何度も呼ばれるので、IDから探さずに覚えているものを返す
+	return activeCamera_;
 }
 
 Matrix4x4 CameraController::GetViewProjectionMatrix() const {
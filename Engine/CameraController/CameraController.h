@@ -135,6 +135,8 @@ private:
 	std::string activeCameraId_ = "normal";
 	// デバッグカメラ切り替え前のカメラID（戻り先）
 	std::string lastActiveCameraId_ = "normal";
+	// 現在アクティブなカメラ（activeCameraId_を変える時に一緒に更新する）
+	BaseCamera* activeCamera_ = nullptr;
 
 
 	// 現在アクティブなカメラを取得
@@ -0,0 +1,384 @@
+#include "OcclusionCuller.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <emmintrin.h>
+
+namespace {
+	// これより小さいwは近クリップ面上とみなす
+	const float kMinW = 1.0e-5f;
+	// これより小さい面積の三角形は描かない
+	const float kMinArea = 1.0e-8f;
+}
+
+OcclusionCuller* OcclusionCuller::GetInstance() {
+	static OcclusionCuller instance;
+	return &instance;
+}
+
+void OcclusionCuller::Initialize(uint32_t width, uint32_t height) {
+	// タイルサイズの倍数に切り上げ
+	tileCountX_ = (std::max)(1u, (width + kTileWidth - 1) / kTileWidth);
+	tileCountY_ = (std::max)(1u, (height + kTileHeight - 1) / kTileHeight);
+	width_ = tileCountX_ * kTileWidth;
+	height_ = tileCountY_ * kTileHeight;
+
+	depthBuffer_.assign(static_cast<size_t>(width_) * height_, 1.0f);
+	tileMaxDepth_.assign(static_cast<size_t>(tileCountX_) * tileCountY_, 1.0f);
+	tileBins_.assign(static_cast<size_t>(tileCountX_) * tileCountY_, {});
+	triangles_.clear();
+	isRasterized_ = false;
+}
+
+void OcclusionCuller::BeginFrame(const Matrix4x4& viewProjectionMatrix) {
+	assert(width_ > 0 && height_ > 0 && "OcclusionCuller::Initialize must be called first");
+
+	isRasterized_ = false;
+	if (!isEnabled_) {
+		return;
+	}
+
+	viewProjectionMatrix_ = viewProjectionMatrix;
+	std::fill(depthBuffer_.begin(), depthBuffer_.end(), 1.0f);
+	std::fill(tileMaxDepth_.begin(), tileMaxDepth_.end(), 1.0f);
+	for (auto& bin : tileBins_) {
+		bin.clear();
+	}
+	triangles_.clear();
+}
+
+void OcclusionCuller::EndFrame() {
+	// 統計を確定
+	lastFrameStatistics_.occluderTriangleCount = occluderTriangleCount_;
+	lastFrameStatistics_.binnedTriangleCount = binnedTriangleCount_;
+	lastFrameStatistics_.testedCount = testedCount_.load();
+	lastFrameStatistics_.culledCount = culledCount_.load();
+	occluderTriangleCount_ = 0;
+	binnedTriangleCount_ = 0;
+	testedCount_ = 0;
+	culledCount_ = 0;
+
+	// 次のフレームでBeginFrameが呼ばれなくても古い深度で判定しないように
+	isRasterized_ = false;
+}
+
+///*-----------------------------------------------------------------------*///
+//								遮蔽物の登録									//
+///*-----------------------------------------------------------------------*///
+
+void OcclusionCuller::AddOccluder(const VertexData* vertices, size_t vertexCount,
+	const uint32_t* indices, size_t indexCount,
+	const Matrix4x4& worldMatrix) {
+
+	if (!isEnabled_ || vertices == nullptr || vertexCount == 0) {
+		return;
+	}
+
+	// 頂点をまとめてクリップ空間へ
+	const Matrix4x4 worldViewProjection = Matrix4x4Multiply(worldMatrix, viewProjectionMatrix_);
+	clipVertices_.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i) {
+		const Vector4& p = vertices[i].position;
+		clipVertices_[i] = ToClip({ p.x, p.y, p.z }, worldViewProjection);
+	}
+
+	const size_t triangleCount = (indices != nullptr) ? indexCount / 3 : vertexCount / 3;
+	for (size_t t = 0; t < triangleCount; ++t) {
+		uint32_t i0 = static_cast<uint32_t>(t * 3 + 0);
+		uint32_t i1 = static_cast<uint32_t>(t * 3 + 1);
+		uint32_t i2 = static_cast<uint32_t>(t * 3 + 2);
+		if (indices != nullptr) {
+			i0 = indices[i0];
+			i1 = indices[i1];
+			i2 = indices[i2];
+		}
+		if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+			continue;
+		}
+		++occluderTriangleCount_;
+
+		// 近クリップ面（z >= 0）でクリップ（結果は最大4頂点）
+		const ClipVertex input[3] = { clipVertices_[i0], clipVertices_[i1], clipVertices_[i2] };
+		ClipVertex output[4];
+		uint32_t outputCount = 0;
+		for (uint32_t i = 0; i < 3; ++i) {
+			const ClipVertex& current = input[i];
+			const ClipVertex& next = input[(i + 1) % 3];
+			const bool currentInside = current.z >= 0.0f;
+			const bool nextInside = next.z >= 0.0f;
+			if (currentInside) {
+				output[outputCount++] = current;
+			}
+			if (currentInside != nextInside) {
+				const float t = current.z / (current.z - next.z);
+				output[outputCount++] = {
+					current.x + (next.x - current.x) * t,
+					current.y + (next.y - current.y) * t,
+					0.0f,
+					current.w + (next.w - current.w) * t,
+				};
+			}
+		}
+
+		// 扇状に三角形へ分割
+		for (uint32_t i = 1; i + 1 < outputCount; ++i) {
+			AddScreenTriangle(output[0], output[i], output[i + 1]);
+		}
+	}
+}
+
+void OcclusionCuller::AddScreenTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2) {
+	if (v0.w < kMinW || v1.w < kMinW || v2.w < kMinW) {
+		return;
+	}
+
+	// スクリーン座標へ（yは下向き）
+	float sx[3], sy[3], sz[3];
+	const ClipVertex* v[3] = { &v0, &v1, &v2 };
+	for (uint32_t i = 0; i < 3; ++i) {
+		const float invW = 1.0f / v[i]->w;
+		sx[i] = (v[i]->x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+		sy[i] = (0.5f - v[i]->y * invW * 0.5f) * static_cast<float>(height_);
+		sz[i] = v[i]->z * invW;
+	}
+
+	// 遠クリップ面より奥なら描かない
+	if (sz[0] > 1.0f && sz[1] > 1.0f && sz[2] > 1.0f) {
+		return;
+	}
+
+	// 面積（向きはどちらでもよい、両面とも遮蔽物として扱う）
+	const float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+	if (std::fabs(area) < kMinArea) {
+		return;
+	}
+
+	// 画面内に切り詰めた範囲
+	ScreenTriangle triangle{};
+	triangle.minX = (std::max)(0, static_cast<int32_t>(std::floor((std::min)({ sx[0], sx[1], sx[2] }))));
+	triangle.minY = (std::max)(0, static_cast<int32_t>(std::floor((std::min)({ sy[0], sy[1], sy[2] }))));
+	triangle.maxX = (std::min)(static_cast<int32_t>(width_), static_cast<int32_t>(std::ceil((std::max)({ sx[0], sx[1], sx[2] }))));
+	triangle.maxY = (std::min)(static_cast<int32_t>(height_), static_cast<int32_t>(std::ceil((std::max)({ sy[0], sy[1], sy[2] }))));
+	if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY) {
+		return;
+	}
+
+	// 辺関数（辺iは頂点iの対辺）。内側が正になるように面積の符号で揃える
+	const float sign = (area > 0.0f) ? 1.0f : -1.0f;
+	const float invArea = 1.0f / std::fabs(area);
+	for (uint32_t i = 0; i < 3; ++i) {
+		const uint32_t a = (i + 1) % 3;
+		const uint32_t b = (i + 2) % 3;
+		triangle.edgeA[i] = (sy[a] - sy[b]) * sign;
+		triangle.edgeB[i] = (sx[b] - sx[a]) * sign;
+		triangle.edgeC[i] = -(triangle.edgeA[i] * sx[a] + triangle.edgeB[i] * sy[a]);
+	}
+
+	// 深度の平面式（辺関数を重心座標として補間）
+	triangle.depthA = (triangle.edgeA[0] * sz[0] + triangle.edgeA[1] * sz[1] + triangle.edgeA[2] * sz[2]) * invArea;
+	triangle.depthB = (triangle.edgeB[0] * sz[0] + triangle.edgeB[1] * sz[1] + triangle.edgeB[2] * sz[2]) * invArea;
+	triangle.depthC = (triangle.edgeC[0] * sz[0] + triangle.edgeC[1] * sz[1] + triangle.edgeC[2] * sz[2]) * invArea;
+
+	// タイルに振り分け
+	const uint32_t triangleIndex = static_cast<uint32_t>(triangles_.size());
+	triangles_.push_back(triangle);
+	const uint32_t tileMinX = triangle.minX / kTileWidth;
+	const uint32_t tileMaxX = (triangle.maxX - 1) / kTileWidth;
+	const uint32_t tileMinY = triangle.minY / kTileHeight;
+	const uint32_t tileMaxY = (triangle.maxY - 1) / kTileHeight;
+	for (uint32_t ty = tileMinY; ty <= tileMaxY; ++ty) {
+		for (uint32_t tx = tileMinX; tx <= tileMaxX; ++tx) {
+			tileBins_[ty * tileCountX_ + tx].push_back(triangleIndex);
+			++binnedTriangleCount_;
+		}
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//								ラスタライズ									//
+///*-----------------------------------------------------------------------*///
+
+void OcclusionCuller::Rasterize() {
+	if (!isEnabled_) {
+		return;
+	}
+
+	// タイル同士は書き込む範囲が重ならないのでそのまま並列に処理できる
+	const uint32_t tileCount = tileCountX_ * tileCountY_;
+	ThreadPool::GetInstance()->ParallelFor(tileCount, [this](uint32_t tileIndex) {
+		RasterizeTile(tileIndex);
+	});
+
+	isRasterized_ = true;
+}
+
+void OcclusionCuller::RasterizeTile(uint32_t tileIndex) {
+	const std::vector<uint32_t>& bin = tileBins_[tileIndex];
+	if (bin.empty()) {
+		return;
+	}
+
+	const int32_t tileX0 = static_cast<int32_t>((tileIndex % tileCountX_) * kTileWidth);
+	const int32_t tileY0 = static_cast<int32_t>((tileIndex / tileCountX_) * kTileHeight);
+	const int32_t tileX1 = tileX0 + static_cast<int32_t>(kTileWidth);
+	const int32_t tileY1 = tileY0 + static_cast<int32_t>(kTileHeight);
+
+	const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	for (uint32_t triangleIndex : bin) {
+		const ScreenTriangle& triangle = triangles_[triangleIndex];
+
+		// タイル内の範囲（xは4ピクセル単位に揃える）
+		const int32_t startX = (std::max)(triangle.minX, tileX0) & ~3;
+		const int32_t endX = (std::min)(triangle.maxX, tileX1);
+		const int32_t startY = (std::max)(triangle.minY, tileY0);
+		const int32_t endY = (std::min)(triangle.maxY, tileY1);
+
+		const __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]);
+		const __m128 edgeA1 = _mm_set1_ps(triangle.edgeA[1]);
+		const __m128 edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+		const __m128 depthA = _mm_set1_ps(triangle.depthA);
+
+		for (int32_t y = startY; y < endY; ++y) {
+			const float py = static_cast<float>(y) + 0.5f;
+			// 行ごとに定数部分をまとめる
+			const __m128 rowEdge0 = _mm_set1_ps(triangle.edgeB[0] * py + triangle.edgeC[0]);
+			const __m128 rowEdge1 = _mm_set1_ps(triangle.edgeB[1] * py + triangle.edgeC[1]);
+			const __m128 rowEdge2 = _mm_set1_ps(triangle.edgeB[2] * py + triangle.edgeC[2]);
+			const __m128 rowDepth = _mm_set1_ps(triangle.depthB * py + triangle.depthC);
+			float* row = &depthBuffer_[static_cast<size_t>(y) * width_];
+
+			for (int32_t x = startX; x < endX; x += 4) {
+				const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffset);
+
+				// 3辺全ての内側にあるピクセルのマスク
+				const __m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, px), rowEdge0);
+				const __m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, px), rowEdge1);
+				const __m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, px), rowEdge2);
+				const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+
+				// 深度を補間して手前なら書き込む
+				__m128 depth = _mm_add_ps(_mm_mul_ps(depthA, px), rowDepth);
+				depth = _mm_min_ps(_mm_max_ps(depth, zero), one);
+				const __m128 current = _mm_loadu_ps(row + x);
+				const __m128 nearest = _mm_min_ps(current, depth);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+			}
+		}
+	}
+
+	// タイル内の最も奥の深度を記録（判定時にタイルごと隠れているかを先に調べる）
+	__m128 maxDepth = zero;
+	for (int32_t y = tileY0; y < tileY1; ++y) {
+		const float* row = &depthBuffer_[static_cast<size_t>(y) * width_];
+		for (int32_t x = tileX0; x < tileX1; x += 4) {
+			maxDepth = _mm_max_ps(maxDepth, _mm_loadu_ps(row + x));
+		}
+	}
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, maxDepth);
+	tileMaxDepth_[tileIndex] = (std::max)((std::max)(lanes[0], lanes[1]), (std::max)(lanes[2], lanes[3]));
+}
+
+///*-----------------------------------------------------------------------*///
+//									判定										//
+///*-----------------------------------------------------------------------*///
+
+bool OcclusionCuller::IsVisible(const Vector3& boundsMin, const Vector3& boundsMax) const {
+	if (!IsActive()) {
+		return true;
+	}
+	++testedCount_;
+
+	// 8頂点をスクリーンへ投影して矩形と最も手前の深度を求める
+	float minX = static_cast<float>(width_), minY = static_cast<float>(height_);
+	float maxX = 0.0f, maxY = 0.0f;
+	float minZ = 1.0f;
+	for (uint32_t i = 0; i < 8; ++i) {
+		const Vector3 corner = {
+			(i & 1) ? boundsMax.x : boundsMin.x,
+			(i & 2) ? boundsMax.y : boundsMin.y,
+			(i & 4) ? boundsMax.z : boundsMin.z,
+		};
+		const ClipVertex clip = ToClip(corner, viewProjectionMatrix_);
+
+		// 近クリップ面をまたぐ場合は判定できない
+		if (clip.w < kMinW || clip.z < 0.0f) {
+			return true;
+		}
+
+		const float invW = 1.0f / clip.w;
+		const float sx = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+		const float sy = (0.5f - clip.y * invW * 0.5f) * static_cast<float>(height_);
+		minX = (std::min)(minX, sx);
+		maxX = (std::max)(maxX, sx);
+		minY = (std::min)(minY, sy);
+		maxY = (std::max)(maxY, sy);
+		minZ = (std::min)(minZ, clip.z * invW);
+	}
+
+	// 画面内に切り詰めた矩形（外側に丸めて保守的に判定）
+	const int32_t rectX0 = (std::max)(0, static_cast<int32_t>(std::floor(minX)));
+	const int32_t rectY0 = (std::max)(0, static_cast<int32_t>(std::floor(minY)));
+	const int32_t rectX1 = (std::min)(static_cast<int32_t>(width_), static_cast<int32_t>(std::ceil(maxX)));
+	const int32_t rectY1 = (std::min)(static_cast<int32_t>(height_), static_cast<int32_t>(std::ceil(maxY)));
+	if (rectX0 >= rectX1 || rectY0 >= rectY1) {
+		// 画面外
+		++culledCount_;
+		return false;
+	}
+
+	const __m128 boxDepth = _mm_set1_ps(minZ);
+	const __m128 laneIndex = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	const __m128 rectStart = _mm_set1_ps(static_cast<float>(rectX0));
+	const __m128 rectEnd = _mm_set1_ps(static_cast<float>(rectX1));
+
+	const uint32_t tileMinX = rectX0 / kTileWidth;
+	const uint32_t tileMaxX = (rectX1 - 1) / kTileWidth;
+	const uint32_t tileMinY = rectY0 / kTileHeight;
+	const uint32_t tileMaxY = (rectY1 - 1) / kTileHeight;
+	for (uint32_t ty = tileMinY; ty <= tileMaxY; ++ty) {
+		for (uint32_t tx = tileMinX; tx <= tileMaxX; ++tx) {
+			// タイル内の全ピクセルより奥にあるならこのタイルでは隠れている
+			if (minZ > tileMaxDepth_[ty * tileCountX_ + tx]) {
+				continue;
+			}
+
+			// ピクセル単位で調べる（遮蔽物の深度がAABBより奥のピクセルが1つでもあれば見える）
+			const int32_t x0 = (std::max)(rectX0, static_cast<int32_t>(tx * kTileWidth)) & ~3;
+			const int32_t x1 = (std::min)(rectX1, static_cast<int32_t>((tx + 1) * kTileWidth));
+			const int32_t y0 = (std::max)(rectY0, static_cast<int32_t>(ty * kTileHeight));
+			const int32_t y1 = (std::min)(rectY1, static_cast<int32_t>((ty + 1) * kTileHeight));
+			for (int32_t y = y0; y < y1; ++y) {
+				const float* row = &depthBuffer_[static_cast<size_t>(y) * width_];
+				for (int32_t x = x0; x < x1; x += 4) {
+					const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneIndex);
+					const __m128 inRect = _mm_and_ps(_mm_cmpge_ps(px, rectStart), _mm_cmplt_ps(px, rectEnd));
+					const __m128 behind = _mm_cmpge_ps(_mm_loadu_ps(row + x), boxDepth);
+					if (_mm_movemask_ps(_mm_and_ps(inRect, behind)) != 0) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	++culledCount_;
+	return false;
+}
+
+OcclusionCuller::ClipVertex OcclusionCuller::ToClip(const Vector3& position, const Matrix4x4& matrix) const {
+	// 行ベクトル×行列（MyMathのTransformと同じ並び、wで割らない）
+	return {
+		position.x * matrix.m[0][0] + position.y * matrix.m[1][0] + position.z * matrix.m[2][0] + matrix.m[3][0],
+		position.x * matrix.m[0][1] + position.y * matrix.m[1][1] + position.z * matrix.m[2][1] + matrix.m[3][1],
+		position.x * matrix.m[0][2] + position.y * matrix.m[1][2] + position.z * matrix.m[2][2] + matrix.m[3][2],
+		position.x * matrix.m[0][3] + position.y * matrix.m[1][3] + position.z * matrix.m[2][3] + matrix.m[3][3],
+	};
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include "MyMath/MyMath.h"
+
+/// <summary>
+/// CPUのソフトウェアラスタライザによるオクルージョンカリング
+/// 遮蔽物（大きな建物など）の三角形を低解像度の深度バッファに描き、
+/// 描画前のオブジェクトのAABBがその奥に完全に隠れているかを調べる
+/// 深度バッファはタイルに分割し、タイルごとにスレッドプールで並列にラスタライズする（SSEで4ピクセルずつ処理）
+/// 深度はD3Dと同じ0（手前）～1（奥）
+///
+/// 1フレームの流れ：
+///   BeginFrame(ビュープロジェクション) → AddOccluder(遮蔽物)を必要なだけ → Rasterize() → IsVisible(各オブジェクト)
+///   EndFrameはEngineがフレームの最後に呼ぶ
+/// </summary>
+class OcclusionCuller {
+public:
+	// タイルのサイズ（ピクセル）
+	static const uint32_t kTileWidth = 32;
+	static const uint32_t kTileHeight = 16;
+
+	/// <summary>
+	/// 1フレーム分の統計
+	/// </summary>
+	struct Statistics {
+		uint32_t occluderTriangleCount = 0;	// 登録された遮蔽物の三角形数
+		uint32_t binnedTriangleCount = 0;	// タイルに振り分けた三角形数（重複含む）
+		uint32_t testedCount = 0;			// 判定したオブジェクト数
+		uint32_t culledCount = 0;			// 隠れていると判定した数
+	};
+
+	//シングルトン
+	static OcclusionCuller* GetInstance();
+
+	/// <summary>
+	/// 深度バッファを確保（幅・高さはタイルサイズの倍数に切り上げる）
+	/// </summary>
+	/// <param name="width">深度バッファの幅</param>
+	/// <param name="height">深度バッファの高さ</param>
+	void Initialize(uint32_t width = 256, uint32_t height = 144);
+
+	/// <summary>
+	/// 有効/無効（無効の時はIsVisibleが常にtrue）
+	/// </summary>
+	void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+	bool IsEnabled() const { return isEnabled_; }
+
+	/// <summary>
+	/// 判定に使える状態か（有効かつ今フレームのRasterizeが終わっている）
+	/// </summary>
+	bool IsActive() const { return isEnabled_ && isRasterized_; }
+
+	/// <summary>
+	/// フレームの開始（深度バッファと遮蔽物をクリア）
+	/// </summary>
+	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
+	void BeginFrame(const Matrix4x4& viewProjectionMatrix);
+
+	/// <summary>
+	/// フレームの終了（統計を確定し、次のBeginFrameまで判定を止める）
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// 遮蔽物の三角形を登録
+	/// </summary>
+	/// <param name="vertices">頂点配列</param>
+	/// <param name="vertexCount">頂点数</param>
+	/// <param name="indices">インデックス配列（nullptrの場合は頂点を順に3つずつ使う）</param>
+	/// <param name="indexCount">インデックス数</param>
+	/// <param name="worldMatrix">ワールド行列</param>
+	void AddOccluder(const VertexData* vertices, size_t vertexCount,
+		const uint32_t* indices, size_t indexCount,
+		const Matrix4x4& worldMatrix);
+
+	/// <summary>
+	/// 登録した遮蔽物を深度バッファに描く（タイルごとに並列）
+	/// </summary>
+	void Rasterize();
+
+	/// <summary>
+	/// ワールド空間のAABBが見えるかどうか
+	/// 画面外、または全体が遮蔽物の奥にある場合はfalse
+	/// 近クリップ面をまたぐ場合は判定できないのでtrue
+	/// </summary>
+	/// <param name="boundsMin">AABBの最小点</param>
+	/// <param name="boundsMax">AABBの最大点</param>
+	bool IsVisible(const Vector3& boundsMin, const Vector3& boundsMax) const;
+
+	/// <summary>
+	/// 深度バッファの値を取得（デバッグ用）
+	/// </summary>
+	float GetDepth(uint32_t x, uint32_t y) const { return depthBuffer_[y * width_ + x]; }
+
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+
+	/// <summary>
+	/// タイル内の最も奥の深度を取得（デバッグ・テスト用）
+	/// </summary>
+	float GetTileMaxDepth(uint32_t tileX, uint32_t tileY) const { return tileMaxDepth_[tileY * tileCountX_ + tileX]; }
+
+	uint32_t GetTileCountX() const { return tileCountX_; }
+	uint32_t GetTileCountY() const { return tileCountY_; }
+
+	/// <summary>
+	/// 前フレームの統計（EndFrameで更新）
+	/// </summary>
+	const Statistics& GetLastFrameStatistics() const { return lastFrameStatistics_; }
+
+private:
+	// コンストラクタ
+	OcclusionCuller() = default;
+	~OcclusionCuller() = default;
+	OcclusionCuller(const OcclusionCuller&) = delete;
+	OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+	/// <summary>
+	/// クリップ空間の頂点
+	/// </summary>
+	struct ClipVertex {
+		float x, y, z, w;
+	};
+
+	/// <summary>
+	/// スクリーン空間の三角形（ラスタライズ用にセットアップ済み）
+	/// </summary>
+	struct ScreenTriangle {
+		float edgeA[3], edgeB[3], edgeC[3];	// 辺関数 A*x + B*y + C（内側が正）
+		float depthA, depthB, depthC;		// 深度の平面式 A*x + B*y + C
+		int32_t minX, minY, maxX, maxY;		// 画面内に切り詰めた範囲（maxは含まない）
+	};
+
+	/// <summary>
+	/// クリップ済みの三角形をスクリーン空間に変換して登録
+	/// </summary>
+	void AddScreenTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+
+	/// <summary>
+	/// 1タイル分をラスタライズ
+	/// </summary>
+	void RasterizeTile(uint32_t tileIndex);
+
+	/// <summary>
+	/// 点をクリップ空間へ変換（wで割らない）
+	/// </summary>
+	ClipVertex ToClip(const Vector3& position, const Matrix4x4& matrix) const;
+
+private:
+	// 深度バッファ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	std::vector<float> depthBuffer_;
+
+	// タイル
+	uint32_t tileCountX_ = 0;
+	uint32_t tileCountY_ = 0;
+	std::vector<float> tileMaxDepth_;					// タイル内の最も奥の深度（階層判定用）
+	std::vector<std::vector<uint32_t>> tileBins_;		// タイルごとの三角形インデックス
+
+	// 今フレームの遮蔽物
+	std::vector<ScreenTriangle> triangles_;
+	std::vector<ClipVertex> clipVertices_;				// AddOccluderの作業用
+	Matrix4x4 viewProjectionMatrix_{};
+
+	bool isEnabled_ = false;
+	bool isRasterized_ = false;
+
+	// 統計（IsVisibleはconstかつ複数スレッドから呼べるようにatomic）
+	uint32_t occluderTriangleCount_ = 0;
+	uint32_t binnedTriangleCount_ = 0;
+	mutable std::atomic<uint32_t> testedCount_ = 0;
+	mutable std::atomic<uint32_t> culledCount_ = 0;
+	Statistics lastFrameStatistics_;
+};
@@ -0,0 +1,389 @@
+#include "SceneOctree.h"
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+namespace {
+
+	/// <summary>
+	/// AABBとレイの交差（スラブ法）
+	/// </summary>
+	/// <returns>当たった場合はtrue、distanceに入った位置（0以上）</returns>
+	bool IntersectRayAABB(const Ray& ray, const AABB& aabb, float& distance) {
+		const float origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+		const float diff[3] = { ray.diff.x, ray.diff.y, ray.diff.z };
+		const float minValue[3] = { aabb.min.x, aabb.min.y, aabb.min.z };
+		const float maxValue[3] = { aabb.max.x, aabb.max.y, aabb.max.z };
+
+		float tMin = 0.0f;
+		float tMax = INFINITY;
+		for (int axis = 0; axis < 3; ++axis) {
+			if (std::fabs(diff[axis]) < 1e-8f) {
+				// 軸に平行な場合は範囲内にあるかだけ見る
+				if (origin[axis] < minValue[axis] || origin[axis] > maxValue[axis]) {
+					return false;
+				}
+				continue;
+			}
+			const float inverse = 1.0f / diff[axis];
+			float t0 = (minValue[axis] - origin[axis]) * inverse;
+			float t1 = (maxValue[axis] - origin[axis]) * inverse;
+			if (t0 > t1) {
+				std::swap(t0, t1);
+			}
+			tMin = (std::max)(tMin, t0);
+			tMax = (std::min)(tMax, t1);
+			if (tMin > tMax) {
+				return false;
+			}
+		}
+		distance = tMin;
+		return true;
+	}
+
+	/// <summary>
+	/// AABBと球の重なり（最近接点との距離）
+	/// </summary>
+	bool OverlapSphereAABB(const SphereMath& sphere, const AABB& aabb) {
+		const Vector3 closest = {
+			std::clamp(sphere.center.x, aabb.min.x, aabb.max.x),
+			std::clamp(sphere.center.y, aabb.min.y, aabb.max.y),
+			std::clamp(sphere.center.z, aabb.min.z, aabb.max.z),
+		};
+		const Vector3 diff = closest - sphere.center;
+		return Dot(diff, diff) <= sphere.radius * sphere.radius;
+	}
+
+	// 視錐台との関係
+	enum class FrustumResult {
+		Outside,
+		Intersect,
+		Inside,
+	};
+
+	/// <summary>
+	/// AABBと視錐台の6平面の判定
+	/// </summary>
+	FrustumResult TestFrustumAABB(const std::array<Vector4, 6>& planes, const AABB& aabb) {
+		const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+		const Vector3 extent = (aabb.max - aabb.min) * 0.5f;
+
+		FrustumResult result = FrustumResult::Inside;
+		for (const Vector4& plane : planes) {
+			// 中心の符号付き距離と、平面の法線方向へのAABBの半径
+			const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			const float radius = extent.x * std::fabs(plane.x) + extent.y * std::fabs(plane.y) + extent.z * std::fabs(plane.z);
+			if (distance + radius < 0.0f) {
+				return FrustumResult::Outside;
+			}
+			if (distance - radius < 0.0f) {
+				result = FrustumResult::Intersect;
+			}
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// ビュープロジェクション行列から視錐台の6平面を取り出す（内側が正、深度は0～1）
+	/// </summary>
+	std::array<Vector4, 6> ExtractFrustumPlanes(const Matrix4x4& m) {
+		// 行ベクトル(v * M)なので、クリップ座標の各成分は行列の列との内積
+		auto column = [&m](int c) { return Vector4{ m.m[0][c], m.m[1][c], m.m[2][c], m.m[3][c] }; };
+		const Vector4 x = column(0);
+		const Vector4 y = column(1);
+		const Vector4 z = column(2);
+		const Vector4 w = column(3);
+
+		return {
+			Vector4{ w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w },	// 左
+			Vector4{ w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w },	// 右
+			Vector4{ w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w },	// 下
+			Vector4{ w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w },	// 上
+			z,														// 近（z >= 0）
+			Vector4{ w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w },	// 遠
+		};
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//								登録・更新										//
+///*-----------------------------------------------------------------------*///
+
+void SceneOctree::Initialize(const Vector3& center, float halfSize, uint32_t maxDepth) {
+	assert(halfSize > 0.0f);
+
+	nodes_.clear();
+	proxies_.clear();
+	freeProxies_.clear();
+	maxDepth_ = maxDepth;
+
+	Node root;
+	root.center = center;
+	root.halfSize = halfSize;
+	nodes_.push_back(root);
+
+	statistics_ = {};
+	statistics_.nodeCount = 1;
+}
+
+uint32_t SceneOctree::Register(GameObject* object, const AABB& bounds) {
+	assert(!nodes_.empty() && "SceneOctree::Initialize must be called first");
+
+	uint32_t proxy;
+	if (!freeProxies_.empty()) {
+		proxy = freeProxies_.back();
+		freeProxies_.pop_back();
+	} else {
+		proxy = static_cast<uint32_t>(proxies_.size());
+		proxies_.emplace_back();
+	}
+
+	proxies_[proxy].object = object;
+	proxies_[proxy].bounds = bounds;
+	InsertToNode(proxy, FindNode(bounds));
+
+	++statistics_.objectCount;
+	return proxy;
+}
+
+void SceneOctree::Unregister(uint32_t proxy) {
+	if (proxy >= proxies_.size() || proxies_[proxy].node < 0) {
+		return;
+	}
+
+	RemoveFromNode(proxy);
+	proxies_[proxy].object = nullptr;
+	freeProxies_.push_back(proxy);
+
+	--statistics_.objectCount;
+}
+
+void SceneOctree::Refit(uint32_t proxy, const AABB& bounds) {
+	assert(proxy < proxies_.size() && proxies_[proxy].node >= 0);
+
+	proxies_[proxy].bounds = bounds;
+
+	// 入るノードが変わらなければAABBの更新だけで済む
+	const int32_t nodeIndex = FindNode(bounds);
+	if (nodeIndex == proxies_[proxy].node) {
+		return;
+	}
+	RemoveFromNode(proxy);
+	InsertToNode(proxy, nodeIndex);
+}
+
+const AABB& SceneOctree::GetBounds(uint32_t proxy) const {
+	assert(proxy < proxies_.size() && proxies_[proxy].node >= 0);
+	return proxies_[proxy].bounds;
+}
+
+int32_t SceneOctree::FindNode(const AABB& bounds) {
+	const Vector3 center = (bounds.min + bounds.max) * 0.5f;
+	const Vector3 extent = (bounds.max - bounds.min) * 0.5f;
+	const float maxExtent = (std::max)({ extent.x, extent.y, extent.z });
+
+	// 中心が全体の範囲外ならルート
+	const Node& root = nodes_[0];
+	if (std::fabs(center.x - root.center.x) > root.halfSize ||
+		std::fabs(center.y - root.center.y) > root.halfSize ||
+		std::fabs(center.z - root.center.z) > root.halfSize) {
+		return 0;
+	}
+
+	// ルーズな範囲は本来の2倍なので、半分の大きさがAABBの半径以上のノードならはみ出さない
+	int32_t nodeIndex = 0;
+	while (nodes_[nodeIndex].depth < maxDepth_) {
+		const float childHalfSize = nodes_[nodeIndex].halfSize * 0.5f;
+		if (childHalfSize < maxExtent) {
+			break;
+		}
+
+		// 中心が入っている子を選ぶ
+		const Vector3 nodeCenter = nodes_[nodeIndex].center;
+		const int octant =
+			(center.x >= nodeCenter.x ? 1 : 0) |
+			(center.y >= nodeCenter.y ? 2 : 0) |
+			(center.z >= nodeCenter.z ? 4 : 0);
+
+		int32_t child = nodes_[nodeIndex].children[octant];
+		if (child < 0) {
+			Node node;
+			node.center = {
+				nodeCenter.x + ((octant & 1) ? childHalfSize : -childHalfSize),
+				nodeCenter.y + ((octant & 2) ? childHalfSize : -childHalfSize),
+				nodeCenter.z + ((octant & 4) ? childHalfSize : -childHalfSize),
+			};
+			node.halfSize = childHalfSize;
+			node.depth = nodes_[nodeIndex].depth + 1;
+			node.parent = nodeIndex;
+
+			child = static_cast<int32_t>(nodes_.size());
+			nodes_.push_back(std::move(node));
+			nodes_[nodeIndex].children[octant] = child;
+			++statistics_.nodeCount;
+		}
+		nodeIndex = child;
+	}
+	return nodeIndex;
+}
+
+void SceneOctree::InsertToNode(uint32_t proxy, int32_t nodeIndex) {
+	Node& node = nodes_[nodeIndex];
+	proxies_[proxy].node = nodeIndex;
+	proxies_[proxy].indexInNode = static_cast<uint32_t>(node.proxies.size());
+	node.proxies.push_back(proxy);
+
+	for (int32_t i = nodeIndex; i >= 0; i = nodes_[i].parent) {
+		++nodes_[i].subtreeCount;
+	}
+}
+
+void SceneOctree::RemoveFromNode(uint32_t proxy) {
+	const int32_t nodeIndex = proxies_[proxy].node;
+	Node& node = nodes_[nodeIndex];
+
+	// 末尾と入れ替えて取り除く
+	const uint32_t index = proxies_[proxy].indexInNode;
+	const uint32_t last = node.proxies.back();
+	node.proxies[index] = last;
+	proxies_[last].indexInNode = index;
+	node.proxies.pop_back();
+	proxies_[proxy].node = -1;
+
+	for (int32_t i = nodeIndex; i >= 0; i = nodes_[i].parent) {
+		--nodes_[i].subtreeCount;
+	}
+}
+
+AABB SceneOctree::GetLooseBounds(const Node& node) const {
+	const float looseHalfSize = node.halfSize * 2.0f;
+	const Vector3 half = { looseHalfSize, looseHalfSize, looseHalfSize };
+	return { node.center - half, node.center + half };
+}
+
+///*-----------------------------------------------------------------------*///
+//								問い合わせ										//
+///*-----------------------------------------------------------------------*///
+
+void SceneOctree::QueryFrustum(const Matrix4x4& viewProjectionMatrix, std::vector<GameObject*>& result) const {
+	statistics_.visitedNodeCount = 0;
+	statistics_.testedObjectCount = 0;
+	const size_t startSize = result.size();
+
+	if (!nodes_.empty()) {
+		QueryFrustumNode(0, ExtractFrustumPlanes(viewProjectionMatrix), result);
+	}
+	statistics_.resultCount = static_cast<uint32_t>(result.size() - startSize);
+}
+
+void SceneOctree::QuerySphere(const SphereMath& sphere, std::vector<GameObject*>& result) const {
+	statistics_.visitedNodeCount = 0;
+	statistics_.testedObjectCount = 0;
+	const size_t startSize = result.size();
+
+	if (!nodes_.empty()) {
+		QuerySphereNode(0, sphere, result);
+	}
+	statistics_.resultCount = static_cast<uint32_t>(result.size() - startSize);
+}
+
+void SceneOctree::QueryRay(const Ray& ray, std::vector<RayHit>& result) const {
+	statistics_.visitedNodeCount = 0;
+	statistics_.testedObjectCount = 0;
+	result.clear();
+
+	if (!nodes_.empty()) {
+		QueryRayNode(0, ray, result);
+	}
+	std::sort(result.begin(), result.end(),
+		[](const RayHit& a, const RayHit& b) { return a.distance < b.distance; });
+	statistics_.resultCount = static_cast<uint32_t>(result.size());
+}
+
+void SceneOctree::CollectAll(int32_t nodeIndex, std::vector<GameObject*>& result) const {
+	const Node& node = nodes_[nodeIndex];
+	++statistics_.visitedNodeCount;
+
+	for (uint32_t proxy : node.proxies) {
+		result.push_back(proxies_[proxy].object);
+	}
+	for (int32_t child : node.children) {
+		if (child >= 0 && nodes_[child].subtreeCount > 0) {
+			CollectAll(child, result);
+		}
+	}
+}
+
+void SceneOctree::QueryFrustumNode(int32_t nodeIndex, const std::array<Vector4, 6>& planes, std::vector<GameObject*>& result) const {
+	const Node& node = nodes_[nodeIndex];
+
+	// ルートは範囲外のオブジェクトも持つので範囲判定しない
+	if (nodeIndex != 0) {
+		const FrustumResult nodeResult = TestFrustumAABB(planes, GetLooseBounds(node));
+		if (nodeResult == FrustumResult::Outside) {
+			++statistics_.visitedNodeCount;
+			return;
+		}
+		if (nodeResult == FrustumResult::Inside) {
+			// 完全に入っているノードは中身を判定せずに集める
+			CollectAll(nodeIndex, result);
+			return;
+		}
+	}
+	++statistics_.visitedNodeCount;
+
+	for (uint32_t proxy : node.proxies) {
+		++statistics_.testedObjectCount;
+		if (TestFrustumAABB(planes, proxies_[proxy].bounds) != FrustumResult::Outside) {
+			result.push_back(proxies_[proxy].object);
+		}
+	}
+	for (int32_t child : node.children) {
+		if (child >= 0 && nodes_[child].subtreeCount > 0) {
+			QueryFrustumNode(child, planes, result);
+		}
+	}
+}
+
+void SceneOctree::QuerySphereNode(int32_t nodeIndex, const SphereMath& sphere, std::vector<GameObject*>& result) const {
+	const Node& node = nodes_[nodeIndex];
+	++statistics_.visitedNodeCount;
+
+	if (nodeIndex != 0 && !OverlapSphereAABB(sphere, GetLooseBounds(node))) {
+		return;
+	}
+
+	for (uint32_t proxy : node.proxies) {
+		++statistics_.testedObjectCount;
+		if (OverlapSphereAABB(sphere, proxies_[proxy].bounds)) {
+			result.push_back(proxies_[proxy].object);
+		}
+	}
+	for (int32_t child : node.children) {
+		if (child >= 0 && nodes_[child].subtreeCount > 0) {
+			QuerySphereNode(child, sphere, result);
+		}
+	}
+}
+
+void SceneOctree::QueryRayNode(int32_t nodeIndex, const Ray& ray, std::vector<RayHit>& result) const {
+	const Node& node = nodes_[nodeIndex];
+	++statistics_.visitedNodeCount;
+
+	float distance = 0.0f;
+	if (nodeIndex != 0 && !IntersectRayAABB(ray, GetLooseBounds(node), distance)) {
+		return;
+	}
+
+	for (uint32_t proxy : node.proxies) {
+		++statistics_.testedObjectCount;
+		if (IntersectRayAABB(ray, proxies_[proxy].bounds, distance)) {
+			result.push_back({ proxies_[proxy].object, distance });
+		}
+	}
+	for (int32_t child : node.children) {
+		if (child >= 0 && nodes_[child].subtreeCount > 0) {
+			QueryRayNode(child, ray, result);
+		}
+	}
+}
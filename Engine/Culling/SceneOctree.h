@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <array>
+#include "MyMath/MyFunction.h"
+
+class GameObject;
+
+/// <summary>
+/// シーンのオブジェクトを空間分割で管理するルーズ八分木
+/// ノードの判定範囲を本来の2倍に広げているので、オブジェクトは大きさで決まる深さの
+/// 中心が入っているノード1つにだけ入る（少し動いただけでは入れ替えが起きない）
+/// 視錐台・球・レイで問い合わせて、該当するオブジェクトだけを集める
+/// 視錐台に完全に入っているノードは中身を判定せずにまとめて集めるので、処理量はほぼ見えている数に比例する
+///
+/// 範囲の外にあるオブジェクトはルートに入れる（ルートは範囲判定をせず常に調べる）
+/// スレッドセーフではない（登録・更新・問い合わせはメインスレッドから行う）
+/// </summary>
+class SceneOctree {
+public:
+	// 登録されていないことを表すID
+	static const uint32_t kInvalidProxy = 0xFFFFFFFF;
+
+	/// <summary>
+	/// レイの問い合わせ結果
+	/// </summary>
+	struct RayHit {
+		GameObject* object = nullptr;
+		float distance = 0.0f;	// レイの始点からAABBに当たるまでの距離（Ray::diffの長さを1とした割合）
+	};
+
+	/// <summary>
+	/// 統計（問い合わせの値は直前の問い合わせのもの）
+	/// </summary>
+	struct Statistics {
+		uint32_t nodeCount = 0;			// 作られたノード数
+		uint32_t objectCount = 0;		// 登録されているオブジェクト数
+		uint32_t visitedNodeCount = 0;	// 問い合わせで調べたノード数
+		uint32_t testedObjectCount = 0;	// 問い合わせで個別に判定したオブジェクト数
+		uint32_t resultCount = 0;		// 問い合わせで見つかったオブジェクト数
+	};
+
+	SceneOctree() = default;
+	~SceneOctree() = default;
+	SceneOctree(const SceneOctree&) = delete;
+	SceneOctree& operator=(const SceneOctree&) = delete;
+
+	/// <summary>
+	/// 初期化（登録済みのオブジェクトは全て外れる）
+	/// </summary>
+	/// <param name="center">全体の中心</param>
+	/// <param name="halfSize">全体の半分の大きさ（立方体）</param>
+	/// <param name="maxDepth">最大の深さ</param>
+	void Initialize(const Vector3& center = { 0.0f, 0.0f, 0.0f }, float halfSize = 512.0f, uint32_t maxDepth = 8);
+
+	/// <summary>
+	/// オブジェクトを登録
+	/// </summary>
+	/// <param name="object">オブジェクト</param>
+	/// <param name="bounds">ワールド空間のAABB</param>
+	/// <returns>登録ID（更新・解除に使う）</returns>
+	uint32_t Register(GameObject* object, const AABB& bounds);
+
+	/// <summary>
+	/// 登録を解除
+	/// </summary>
+	/// <param name="proxy">登録ID</param>
+	void Unregister(uint32_t proxy);
+
+	/// <summary>
+	/// AABBを更新（今のノードに収まる間はノードを移動しない）
+	/// </summary>
+	/// <param name="proxy">登録ID</param>
+	/// <param name="bounds">新しいワールド空間のAABB</param>
+	void Refit(uint32_t proxy, const AABB& bounds);
+
+	/// <summary>
+	/// 視錐台と重なるオブジェクトを集める
+	/// </summary>
+	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
+	/// <param name="result">結果の追加先（クリアはしない）</param>
+	void QueryFrustum(const Matrix4x4& viewProjectionMatrix, std::vector<GameObject*>& result) const;
+
+	/// <summary>
+	/// 球と重なるオブジェクトを集める
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <param name="result">結果の追加先（クリアはしない）</param>
+	void QuerySphere(const SphereMath& sphere, std::vector<GameObject*>& result) const;
+
+	/// <summary>
+	/// レイが当たるオブジェクト（AABB）を近い順に集める
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="result">結果（クリアしてから近い順に並べる）</param>
+	void QueryRay(const Ray& ray, std::vector<RayHit>& result) const;
+
+	/// <summary>
+	/// 登録されているAABBを取得
+	/// </summary>
+	const AABB& GetBounds(uint32_t proxy) const;
+
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	// ノード
+	struct Node {
+		Vector3 center{};
+		float halfSize = 0.0f;
+		uint32_t depth = 0;
+		int32_t parent = -1;
+		std::array<int32_t, 8> children{ -1, -1, -1, -1, -1, -1, -1, -1 };
+		std::vector<uint32_t> proxies;	// このノードに入っているオブジェクト
+		uint32_t subtreeCount = 0;		// 子孫も含めたオブジェクト数（0のノードは問い合わせで飛ばす）
+	};
+
+	// 登録されたオブジェクト
+	struct Proxy {
+		GameObject* object = nullptr;
+		AABB bounds{};
+		int32_t node = -1;			// 入っているノード（-1は未使用）
+		uint32_t indexInNode = 0;	// ノードのproxies内の位置
+	};
+
+	/// <summary>
+	/// AABBが入るノードを探す（無ければ作る）
+	/// </summary>
+	int32_t FindNode(const AABB& bounds);
+
+	/// <summary>
+	/// ノードに入れる/ノードから外す
+	/// </summary>
+	void InsertToNode(uint32_t proxy, int32_t nodeIndex);
+	void RemoveFromNode(uint32_t proxy);
+
+	/// <summary>
+	/// ノードのルーズな範囲（本来の2倍）を取得
+	/// </summary>
+	AABB GetLooseBounds(const Node& node) const;
+
+	/// <summary>
+	/// 子孫も含めた全オブジェクトを判定なしで集める
+	/// </summary>
+	void CollectAll(int32_t nodeIndex, std::vector<GameObject*>& result) const;
+
+	void QueryFrustumNode(int32_t nodeIndex, const std::array<Vector4, 6>& planes, std::vector<GameObject*>& result) const;
+	void QuerySphereNode(int32_t nodeIndex, const SphereMath& sphere, std::vector<GameObject*>& result) const;
+	void QueryRayNode(int32_t nodeIndex, const Ray& ray, std::vector<RayHit>& result) const;
+
+private:
+	std::vector<Node> nodes_;
+	std::vector<Proxy> proxies_;
+	std::vector<uint32_t> freeProxies_;
+	uint32_t maxDepth_ = 0;
+
+	// 問い合わせの統計（constの問い合わせから書き換える）
+	mutable Statistics statistics_;
+};
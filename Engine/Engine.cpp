@@ -24,6 +24,15 @@ void Engine::InitializeBase(const std::wstring& title) {
 	// ログ初期化
 	Logger::Initalize();
 
+	// スレッドプール初期化（PSOの並列生成などで使う）
+	ThreadPool::GetInstance()->Initialize();
+
+	// アセットのアーカイブがあればマウント（シェーダー・テクスチャ・モデル・音声はこれを通して読む）
+	VirtualFileSystem* fileSystem = VirtualFileSystem::GetInstance();
+	if (fileSystem->Exists(VirtualFileSystem::kDefaultPackPath)) {
+		fileSystem->MountPack(VirtualFileSystem::kDefaultPackPath);
+	}
+
 	// DirectX初期化
 	directXCommon_ = std::make_unique<DirectXCommon>();
 	directXCommon_->Initialize(winApp_.get());
@@ -34,6 +43,9 @@ void Engine::InitializeManagers() {
 	inputManager_ = InputManager::GetInstance();
 	inputManager_->Initialize(winApp_.get());
 
+	// テクスチャのアップロードキュー初期化（テクスチャを作る前に）
+	TextureUploadQueue::GetInstance()->Initialize(directXCommon_.get());
+
 	// テクスチャマネージャー初期化
 	textureManager_ = TextureManager::GetInstance();
 	textureManager_->Initialize(directXCommon_.get());
@@ -52,6 +64,9 @@ void Engine::InitializeManagers() {
 	// カメラコントローラー取得
 	cameraController_ = CameraController::GetInstance();
 
+	// オクルージョンカリング初期化（使うシーンで有効にする）
+	OcclusionCuller::GetInstance()->Initialize();
+
 	// ImGui初期化
 	imguiManager_ = ImGuiManager::GetInstance();
 	imguiManager_->Initialize(winApp_.get(), directXCommon_.get());
@@ -59,6 +74,18 @@ void Engine::InitializeManagers() {
 	// オフスクリーンレンダラー初期化
 	offscreenRenderer_ = std::make_unique<OffscreenRenderer>();
 	offscreenRenderer_->Initialize(directXCommon_.get());
+
+	// デバッグ描画初期化（リリースでは何もしない）
+	DebugDraw::GetInstance()->Initialize(directXCommon_.get());
+
+	// スプライトの一括描画初期化
+	SpriteBatch::GetInstance()->Initialize(directXCommon_.get());
+
+	// バインドレスのマテリアルテーブル初期化
+	BindlessMaterialTable::GetInstance()->Initialize(directXCommon_.get());
+
+	// ホットリロード初期化（デバッグではresourcesの書き換えを見張る。PSOを作るものを全て初期化した後に）
+	HotReloadManager::GetInstance()->Initialize(directXCommon_.get());
 }
 
 void Engine::LoadDefaultResources() {
@@ -67,9 +94,17 @@ void Engine::LoadDefaultResources() {
 	///*-----------------------------------------------------------------------*///
 	///								テクスチャの読み込み							///
 	///*-----------------------------------------------------------------------*///
-	textureManager_->LoadTexture("resources/Texture/uvChecker.png", "uvChecker");
-	textureManager_->LoadTexture("resources/Texture/monsterBall.png", "monsterBall");
-	textureManager_->LoadTexture("resources/Texture/white2x2.png", "white");
+	// ファイルの読み込みはワーカースレッドで並列に行う
+	textureManager_->LoadTextures({
+		{ "resources/Texture/uvChecker.png", "uvChecker" },
+		{ "resources/Texture/monsterBall.png", "monsterBall" },
+		{ "resources/Texture/white2x2.png", "white" },
+		});
+
+	// UI用の小さなテクスチャはアトラスにまとめる（スプライトの一括描画でテクスチャの切り替えが減る）
+	textureManager_->LoadTexturesToAtlas("ui", {
+		{ "resources/Texture/Reticle/reticle.png", "reticle" },
+		});
 
 	///*-----------------------------------------------------------------------*///
 	///								音声データの読み込み							///
@@ -111,6 +146,9 @@ void Engine::Update() {
 	// 入力更新
 	inputManager_->Update();
 
+	// 書き換えたファイルを読み込み直す（前のフレームの描画は終わっているので、シーンの更新より前に差し替える）
+	HotReloadManager::GetInstance()->Update();
+
 	/// ImGuiの受付開始
 	imguiManager_->Begin();
 
@@ -120,17 +158,35 @@ void Engine::Update() {
 
 
 void Engine::StartDrawOffscreen() {
+	// デバッグ描画のテキストマーカー（ImGuiの受付終了前に積む）
+	DebugDraw::GetInstance()->DrawTextMarkers(cameraController_->GetViewProjectionMatrix());
+
 	/// ImGuiの受付終了
 	imguiManager_->End();
 
 	// フレーム開始
 	directXCommon_->BeginFrame();
 
+	// 前のフレームまでに使われたテクスチャのミップを読み込み、予算を超える分は落とす（描画を積む前に）
+	textureManager_->UpdateResidency();
+
+	// 描画コマンドの記録開始（記録しつつD3D12にもそのまま流す）
+	if (isCaptureRequested_) {
+		isCaptureRequested_ = false;
+		isCapturing_ = true;
+		commandRecorder_.Clear();
+		commandRecorder_.SetForwardTarget(directXCommon_->GetD3D12RenderCommandList());
+		directXCommon_->SetRenderCommandList(&commandRecorder_);
+	}
+
 	/// オフスクリーンの描画準備（3D描画用）
 	offscreenRenderer_->PreDraw();
 }
 
 void Engine::EndDrawOffscreen() {
+	// デバッグ描画（3D描画の最後にまとめて描く）
+	DebugDraw::GetInstance()->Draw(cameraController_->GetViewProjectionMatrix());
+
 	/// オフスクリーンの描画終了
 	offscreenRenderer_->PostDraw();
 }
@@ -147,17 +203,47 @@ void Engine::StartDrawBackBuffer() {
 
 
 void Engine::EndDrawBackBuffer() {
+	// フレーム中に積まれたスプライトをまとめて描画（UIの最後、ImGuiの手前）
+	SpriteBatch::GetInstance()->Flush();
+
 	// ImGuiの画面への描画
 	imguiManager_->Draw(directXCommon_->GetCommandList());
+	// ImGuiはステートキャッシュを通さずに設定するので記録を破棄
+	directXCommon_->GetStateCache().Invalidate();
 
 	// 通常描画の終わり
 	directXCommon_->PostDraw();
 
+	// フレーム中に積んだテクスチャのアップロードをまとめて送る（描画用のキューはその完了を待ってから描画する）
+	TextureUploadQueue::GetInstance()->Submit();
+
 	// 描画そのもののEndFrame
 	directXCommon_->EndFrame();
+
+	// オクルージョンカリングのフレーム終了
+	OcclusionCuller::GetInstance()->EndFrame();
+
+	// デバッグ描画のフレーム終了（期限切れの形状を消す）
+	DebugDraw::GetInstance()->EndFrame(frameTimer_->GetDeltaTime());
+
+	// スプライトの一括描画のフレーム終了（統計を確定）
+	SpriteBatch::GetInstance()->EndFrame();
+
+	// バインドレスのマテリアルテーブルのフレーム終了（統計を確定）
+	BindlessMaterialTable::GetInstance()->EndFrame();
+
+	// 描画コマンドの記録終了
+	if (isCapturing_) {
+		isCapturing_ = false;
+		directXCommon_->SetRenderCommandList(nullptr);
+		commandRecorder_.Dump();
+	}
 }
 
 void Engine::Finalize() {
+	// ホットリロード終了処理（見張りを止め、差し替えた古いモデルとPSOを解放する）
+	HotReloadManager::GetInstance()->Finalize();
+
 	// ImGui終了処理
 	if (imguiManager_) {
 		imguiManager_->Finalize();
@@ -169,6 +255,15 @@ void Engine::Finalize() {
 		offscreenRenderer_.reset();
 	}
 
+	// デバッグ描画終了処理
+	DebugDraw::GetInstance()->Finalize();
+
+	// スプライトの一括描画終了処理
+	SpriteBatch::GetInstance()->Finalize();
+
+	// バインドレスのマテリアルテーブル終了処理
+	BindlessMaterialTable::GetInstance()->Finalize();
+
 	// オーディオ終了処理
 	if (audioManager_) {
 		audioManager_->Finalize();
@@ -184,6 +279,9 @@ void Engine::Finalize() {
 		modelManager_->Finalize();
 	}
 
+	// テクスチャのアップロードキュー終了処理（送ったコピーの完了を待つ）
+	TextureUploadQueue::GetInstance()->Finalize();
+
 	// テクスチャ終了処理
 	if (textureManager_) {
 		textureManager_->Finalize();
@@ -201,6 +299,12 @@ void Engine::Finalize() {
 		directXCommon_.reset();
 	}
 
+	// アーカイブを外す
+	VirtualFileSystem::GetInstance()->UnmountAll();
+
+	// スレッドプール終了処理
+	ThreadPool::GetInstance()->Finalize();
+
 	// COM終了処理
 	CoUninitialize();
 }
@@ -214,6 +318,75 @@ void Engine::ImGui() {
 	//FPS関連
 	frameTimer_->ImGui();
 
+	//ステートキャッシュの統計（前フレーム）
+	const auto& stateStatistics = directXCommon_->GetLastFrameStateStatistics();
+	ImGui::Text("State Commands: issued %u / elided %u", stateStatistics.issuedCount, stateStatistics.elidedCount);
+
+	//オクルージョンカリングの統計（前フレーム）
+	OcclusionCuller* occlusionCuller = OcclusionCuller::GetInstance();
+	bool isOcclusionEnabled = occlusionCuller->IsEnabled();
+	if (ImGui::Checkbox("Occlusion Culling", &isOcclusionEnabled)) {
+		occlusionCuller->SetEnabled(isOcclusionEnabled);
+	}
+	const auto& occlusionStatistics = occlusionCuller->GetLastFrameStatistics();
+	ImGui::Text("Occlusion: culled %u / tested %u (occluder tris %u)",
+		occlusionStatistics.culledCount, occlusionStatistics.testedCount, occlusionStatistics.occluderTriangleCount);
+
+	//描画コマンドの記録（次のフレームを記録してログに出す）
+	if (ImGui::Button("Capture Draw Commands")) {
+		isCaptureRequested_ = true;
+	}
+	const auto& captureStatistics = commandRecorder_.GetStatistics();
+	ImGui::Text("Captured: %u commands / %u draws / %llu vertices",
+		captureStatistics.commandCount, captureStatistics.drawCount,
+		static_cast<unsigned long long>(captureStatistics.vertexCount));
+
+	//SRVディスクリプタの割り当て状況
+	DescriptorHeapManager* descriptorManager = directXCommon_->GetDescriptorManager();
+	const auto srvStatistics = descriptorManager->GetStatistics(DescriptorHeapManager::HeapType::SRV);
+	ImGui::Text("SRV: used %u / %u (peak %u, holes %u, fragmentation %.0f%%)",
+		srvStatistics.usedCount, srvStatistics.capacity, srvStatistics.highWaterMark,
+		srvStatistics.freeRunCount, srvStatistics.fragmentation * 100.0f);
+	const auto transientStatistics = descriptorManager->GetTransientStatistics();
+	ImGui::Text("Transient SRV: in flight %u / %u (peak %u, failed %llu)",
+		transientStatistics.usedCount, transientStatistics.capacity, transientStatistics.highWaterMark,
+		static_cast<unsigned long long>(transientStatistics.failedCount));
+	bool isDescriptorLogging = descriptorManager->IsLoggingEnabled();
+	if (ImGui::Checkbox("Log Descriptor Allocation", &isDescriptorLogging)) {
+		descriptorManager->SetLoggingEnabled(isDescriptorLogging);
+	}
+
+	//ファイルの読み込み元（アーカイブ・単体のファイル）
+	const auto fileStatistics = VirtualFileSystem::GetInstance()->GetStatistics();
+	ImGui::Text("Files: packs %u (%u entries), opened packed %llu / loose %llu / failed %llu",
+		fileStatistics.packCount, fileStatistics.packedEntryCount,
+		static_cast<unsigned long long>(fileStatistics.packedOpenCount),
+		static_cast<unsigned long long>(fileStatistics.looseOpenCount),
+		static_cast<unsigned long long>(fileStatistics.failedOpenCount));
+	if (fileStatistics.decompressedOpenCount > 0) {
+		const double decompressSeconds = static_cast<double>(fileStatistics.decompressMicroseconds) / 1000000.0;
+		ImGui::Text("Files: decompressed %llu (%.2f MB, %.0f MB/s)",
+			static_cast<unsigned long long>(fileStatistics.decompressedOpenCount),
+			static_cast<double>(fileStatistics.decompressedBytes) / (1024.0 * 1024.0),
+			decompressSeconds > 0.0 ? static_cast<double>(fileStatistics.decompressedBytes) / (1024.0 * 1024.0) / decompressSeconds : 0.0);
+	}
+
+	/// ホットリロードのImGui
+	HotReloadManager::GetInstance()->ImGui();
+
+	/// デバッグ描画のImGui
+	DebugDraw::GetInstance()->ImGui();
+
+	/// スプライトの一括描画のImGui
+	SpriteBatch::GetInstance()->ImGui();
+
+	/// バインドレスのマテリアルテーブルのImGui
+	BindlessMaterialTable::GetInstance()->ImGui();
+
+	/// テクスチャの常駐メモリのImGui
+	textureManager_->ImGui();
+	TextureUploadQueue::GetInstance()->ImGui();
+
 	/// オフスクリーンレンダラー（グリッチエフェクト含む）のImGui
 	offscreenRenderer_->ImGui();
 
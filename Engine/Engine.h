@@ -7,20 +7,28 @@
 #include "BaseSystem/WinApp/WinApp.h"
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "BaseSystem/Logger/Dump.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/DirectXCommon/RenderBackend/RecordingRenderCommandList.h"
 
 ///Managers
 #include "Managers/Audio/AudioManager.h"
 #include "Managers/Texture/TextureManager.h"
+#include "Managers/Texture/TextureUploadQueue.h"
 #include "Managers/Model/ModelManager.h"
 #include "Managers/Input/inputManager.h"
 #include "Managers/ImGui/ImGuiManager.h" 
+#include "Managers/HotReload/HotReloadManager.h"
 #include "FrameTimer/FrameTimer.h"
 #include "OffscreenRenderer/OffscreenRenderer.h"
 
 ///Objects
 #include "CameraController/CameraController.h"
+#include "Culling/OcclusionCuller.h"
 #include "Objects/GameObject/GameObject.h"
 #include "Objects/Sprite/Sprite.h"
+#include "Objects/Sprite/SpriteBatch.h"
+#include "Objects/Line/DebugDraw.h"
 #include "Objects/Light/Light.h"
 
 class Engine {
@@ -119,6 +127,11 @@ private:
 	// カメラコントローラー
 	CameraController* cameraController_;
 
+	// 描画コマンドの記録（1フレーム分を記録してログに出す）
+	RecordingRenderCommandList commandRecorder_;
+	bool isCaptureRequested_ = false;
+	bool isCapturing_ = false;
+
 	//ウィンドウを閉じるか否か
 	bool ClosedWindow_ = false;
 };
\ No newline at end of file
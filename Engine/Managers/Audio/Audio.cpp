@@ -1,4 +1,16 @@
 #include "Audio.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/Logger/Logger.h"
+
+namespace {
+	/// <summary>
+	/// デコードに失敗したことをログに出す（LoadAudioの戻り値としてfalseを返す）
+	/// </summary>
+	bool LogDecodeFailure(const std::string& filename, HRESULT hr) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to decode audio file: {} (hr = 0x{:08x})\n", filename, static_cast<uint32_t>(hr)));
+		return false;
+	}
+}
 
 Audio::Audio() : pSourceVoice(nullptr), isPlaying(false), isPaused(false), isLooping(false), pausedSamplesPlayed(0) {
 	soundData = {};
@@ -8,7 +20,7 @@ Audio::~Audio() {
 	Unload();
 }
 
-void Audio::LoadAudio(const std::string& filename) {
+bool Audio::LoadAudio(const std::string& filename) {
 	HRESULT hr = S_OK;//S_OK入れるとなぜか1MBだけメモリ軽くなる??
 
 	///*-----------------------------------------------------------------------*///
@@ -20,9 +32,38 @@ void Audio::LoadAudio(const std::string& filename) {
 	std::wstring wfilename(wideLength - 1, L'\0'); // null終端文字を除く?
 	MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, &wfilename[0], wideLength);
 
+	// ファイルを開く（アーカイブにあればそこから）
+	FileView file = VirtualFileSystem::GetInstance()->Open(filename);
+	if (!file.IsValid()) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to open audio file: {}\n", filename));
+		return false;
+	}
+
+	// メモリ上のファイルをバイトストリームにする（Media Foundationはマップしたメモリを直接読めないので、ここで1回だけコピーされる）
+	Microsoft::WRL::ComPtr<IStream> pStream;
+	pStream.Attach(SHCreateMemStream(file.GetData(), static_cast<UINT>(file.GetSize())));
+	if (!pStream) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to create memory stream for audio file: {}\n", filename));
+		return false;
+	}
+	Microsoft::WRL::ComPtr<IMFByteStream> pMFByteStream;
+	hr = MFCreateMFByteStreamOnStream(pStream.Get(), &pMFByteStream);
+	if (FAILED(hr)) {
+		return LogDecodeFailure(filename, hr);
+	}
+
+	// URLがないので、元のファイル名から形式（wav・mp3）を判断させる
+	Microsoft::WRL::ComPtr<IMFAttributes> pByteStreamAttributes;
+	if (SUCCEEDED(pMFByteStream.As(&pByteStreamAttributes))) {
+		pByteStreamAttributes->SetString(MF_BYTESTREAM_ORIGIN_NAME, wfilename.c_str());
+	}
+
 	// ソースリーダーの実体作成
 	Microsoft::WRL::ComPtr<IMFSourceReader> pMFSourceReader;
-	hr = MFCreateSourceReaderFromURL(wfilename.c_str(), nullptr, &pMFSourceReader);
+	hr = MFCreateSourceReaderFromByteStream(pMFByteStream.Get(), nullptr, &pMFSourceReader);
+	if (FAILED(hr)) {
+		return LogDecodeFailure(filename, hr);
+	}
 
 	///*-----------------------------------------------------------------------*///
 	///								メディアタイプの取得							///
@@ -30,17 +71,24 @@ void Audio::LoadAudio(const std::string& filename) {
 	// 出力メディアタイプの設定（PCM形式）
 	Microsoft::WRL::ComPtr<IMFMediaType> pMFMediaType;
 	hr = MFCreateMediaType(&pMFMediaType);
+	if (FAILED(hr)) {
+		return LogDecodeFailure(filename, hr);
+	}
 	// PCMフォーマットを設定
 	pMFMediaType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio);
 	pMFMediaType->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_PCM);
 	hr = pMFSourceReader->SetCurrentMediaType(MF_SOURCE_READER_FIRST_AUDIO_STREAM, nullptr, pMFMediaType.Get());
-	assert(SUCCEEDED(hr));
+	if (FAILED(hr)) {
+		return LogDecodeFailure(filename, hr);
+	}
 	//ここでReleaseして生成しなおそうとして失敗したので別のを用意してそこに代入する形で解決する
 
 	// 実際のメディアタイプを取得
 	Microsoft::WRL::ComPtr<IMFMediaType> pActualMediaType;
 	hr = pMFSourceReader->GetCurrentMediaType(MF_SOURCE_READER_FIRST_AUDIO_STREAM, &pActualMediaType);
-	assert(SUCCEEDED(hr));
+	if (FAILED(hr)) {
+		return LogDecodeFailure(filename, hr);
+	}
 
 	///*-----------------------------------------------------------------------*///
 	///							オーディオデータ形式の作成							///
@@ -49,7 +97,9 @@ void Audio::LoadAudio(const std::string& filename) {
 	// WAVEFORMATEXを取得
 	WAVEFORMATEX* pWaveFormat{ nullptr };
 	hr = MFCreateWaveFormatExFromMFMediaType(pActualMediaType.Get(), &pWaveFormat, nullptr);
-	assert(SUCCEEDED(hr));
+	if (FAILED(hr)) {
+		return LogDecodeFailure(filename, hr);
+	}
 
 	// WAVEFORMATEXをコピー
 	soundData.wfex = *pWaveFormat;
@@ -103,10 +153,16 @@ void Audio::LoadAudio(const std::string& filename) {
 	///							データをメンバ変数に渡す							///
 	///*-----------------------------------------------------------------------*///
 
+	// 書き込み途中のファイルなどで1サンプルも読めなかったものは失敗にする
+	if (mediaData.empty()) {
+		Logger::Log(Logger::GetStream(), std::format("No audio samples decoded from: {}\n", filename));
+		return false;
+	}
+
 	soundData.bufferSize = static_cast<unsigned int>(mediaData.size());
 	soundData.pBuffer = new BYTE[soundData.bufferSize];
 	memcpy(soundData.pBuffer, mediaData.data(), soundData.bufferSize);
-
+	return true;
 }
 
 
@@ -205,6 +261,14 @@ void Audio::SetVolume(float volume) {
 	}
 }
 
+float Audio::GetVolume() const {
+	float volume = 1.0f;
+	if (pSourceVoice) {
+		pSourceVoice->GetVolume(&volume);
+	}
+	return volume;
+}
+
 void Audio::Pause() {
 	if (pSourceVoice && isPlaying && !isPaused) {
 		// 現在の再生位置を保存
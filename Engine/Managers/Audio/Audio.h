@@ -21,6 +21,10 @@
 #pragma comment(lib, "Mfreadwrite.lib")
 #pragma comment(lib, "mfuuid.lib")
 
+///メモリ上のファイルをMedia Foundationに渡す(SHCreateMemStream)
+#include <shlwapi.h>
+#pragma comment(lib, "Shlwapi.lib")
+
 /// <summary>
 /// 音声データ構造体
 /// </summary>
@@ -71,7 +75,8 @@ public:
 	/// 音声データの読み込み（WAV/MP3対応）
 	/// </summary>
 	/// <param name="filename">ファイルパス</param>
-	void LoadAudio(const std::string& filename);
+	/// <returns>読み込めたか（開けない・デコードできないファイルはログを出してfalse）</returns>
+	bool LoadAudio(const std::string& filename);
 
 	/// <summary>
 	/// 音声の再生（ループなし）
@@ -91,6 +96,11 @@ public:
 	/// <param name="volume"></param>
 	void SetVolume(float volume);
 
+	/// <summary>
+	/// 今の音量（再生していなければ1.0f）
+	/// </summary>
+	float GetVolume() const;
+
 	/// <summary>
 	/// 音声の一時停止
 	/// </summary>
@@ -1,5 +1,7 @@
 #include "AudioManager.h"
 #include "Managers/ImGui/ImGuiManager.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include <algorithm>
 
 // シングルトンインスタンス
 AudioManager* AudioManager::GetInstance() {
@@ -40,13 +42,11 @@ void AudioManager::Initialize() {
 
 void AudioManager::Finalize() {
 	// 全ての音声を解放
-	for (auto& pair : audios) {
-		if (pair.second) {
-			pair.second->Unload();
-			delete pair.second;
-		}
+	for (AudioEntry& entry : audios) {
+		entry.audio->Unload();
 	}
-	audios.clear();
+	// 全てのスロットの世代が進むので、表に残ったハンドルは全てnullptrになる
+	audios.Clear();
 
 	// マスターボイスの解放
 	if (masterVoice) {
@@ -67,99 +67,175 @@ void AudioManager::Finalize() {
 
 }
 
-void AudioManager::LoadAudio(const std::string& filename, const std::string& tagName) {
+bool AudioManager::LoadAudio(const std::string& filename, const std::string& tagName) {
+	// 新しい音声データを作成
+	auto audio = std::make_unique<Audio>();
+	//実際に読み込む（WAV/MP3自動判別して動かす）
+	if (!audio->LoadAudio(filename)) {
+		// 読めなければ同じタグ名の古いものはそのまま残す
+		Logger::Log(Logger::GetStream(), std::format("Failed to load audio '{}' from {}\n", tagName, filename));
+		return false;
+	}
+
 	// 既に同じタグ名で登録されていた場合は古いものを解放
-	if (audios.find(tagName) != audios.end()) {
-		if (audios[tagName]) {
-			audios[tagName]->Unload();
-			delete audios[tagName];
-		}
-		audios.erase(tagName);
+	const AudioSlot oldSlot = audioTable_.Get(audioTable_.Find(StringId(tagName)));
+	if (AudioEntry* entry = audios.Get(oldSlot)) {
+		entry->audio->Unload();
+		audios.Erase(oldSlot);
 	}
 
-	// 新しい音声データを作成
-	Audio* audio = new Audio();
-	//実際に読み込む（WAV/MP3自動判別して動かす）
-	audio->LoadAudio(filename);
-	audios[tagName] = audio;
+	const AudioSlot slot = audios.Insert({ tagName, std::move(audio), filename });
+	audioTable_.Set(StringId::Intern(tagName), slot);
+	return true;
+}
+
+uint32_t AudioManager::ReloadAudioFile(const std::string& filename) {
+	// 読み込んだ時のパスと書き方が違っても同じファイルとして扱う
+	const std::string normalizedPath = AssetPack::NormalizePath(filename);
+	uint32_t reloadedCount = 0;
+
+	for (AudioEntry& entry : audios) {
+		if (AssetPack::NormalizePath(entry.filename) != normalizedPath) {
+			continue;
+		}
+
+		// 読めなければ（書き込み途中など）古いものを鳴らし続け、次に書き換えられた時にまた試す
+		auto audio = std::make_unique<Audio>();
+		if (!audio->LoadAudio(entry.filename)) {
+			Logger::Log(Logger::GetStream(), std::format("Audio '{}' kept previous data; failed to reload {}\n", entry.tagName, filename));
+			continue;
+		}
+
+		// 鳴っていたかどうかを覚えてから古いものを止める
+		const bool isPlaying = entry.audio->IsPlaying() && !entry.audio->IsPaused();
+		const bool isLooping = entry.audio->IsLooping();
+		const float volume = entry.audio->GetVolume();
+		entry.audio->Unload();
+		entry.audio = std::move(audio);
+		++reloadedCount;
+
+		if (isPlaying) {
+			if (isLooping) {
+				entry.audio->PlayLoop(xAudio2.Get());
+			} else {
+				entry.audio->Play(xAudio2.Get());
+			}
+			entry.audio->SetVolume(volume);
+		}
+		Logger::Log(Logger::GetStream(), std::format("Audio '{}' reloaded from {}\n", entry.tagName, filename));
+	}
+	return reloadedCount;
 }
 
 void AudioManager::Play(const std::string& tagName) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+	Play(FindHandle(tagName));
+}
+
+void AudioManager::PlayLoop(const std::string& tagName) {
+	PlayLoop(FindHandle(tagName));
+}
+
+void AudioManager::Pause(const std::string& tagName) {
+	Pause(FindHandle(tagName));
+}
+
+void AudioManager::Resume(const std::string& tagName) {
+	Resume(FindHandle(tagName));
+}
+
+void AudioManager::Stop(const std::string& tagName) {
+	Stop(FindHandle(tagName));
+}
+
+void AudioManager::SetLoop(const std::string& tagName, bool loop) {
+	SetLoop(FindHandle(tagName), loop);
+}
+
+void AudioManager::SetVolume(const std::string& tagName, float volume) {
+	SetVolume(FindHandle(tagName), volume);
+}
+
+void AudioManager::Play(AudioHandle handle) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
-	audios[tagName]->Stop();
+	audio->Stop();
 	// 音声の再生
-	audios[tagName]->Play(xAudio2.Get());
+	audio->Play(xAudio2.Get());
 }
 
-void AudioManager::PlayLoop(const std::string& tagName) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+void AudioManager::PlayLoop(AudioHandle handle) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
 
 	// 音声の再生
-	audios[tagName]->PlayLoop(xAudio2.Get());
+	audio->PlayLoop(xAudio2.Get());
 }
 
-void AudioManager::Pause(const std::string& tagName) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+void AudioManager::Pause(AudioHandle handle) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
 
 	// 音声の一時停止
-	audios[tagName]->Pause();
+	audio->Pause();
 }
 
-void AudioManager::Resume(const std::string& tagName) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+void AudioManager::Resume(AudioHandle handle) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
 
 	// 音声の再開
-	audios[tagName]->Resume();
+	audio->Resume();
 }
 
-void AudioManager::Stop(const std::string& tagName) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+void AudioManager::Stop(AudioHandle handle) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
 
 	// 音声の停止
-	audios[tagName]->Stop();
+	audio->Stop();
 }
 
-void AudioManager::SetLoop(const std::string& tagName, bool loop) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+void AudioManager::SetLoop(AudioHandle handle, bool loop) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
 
 	// ループ設定の変更
-	audios[tagName]->SetLoop(loop);
+	audio->SetLoop(loop);
 }
 
-void AudioManager::SetVolume(const std::string& tagName, float volume) {
-	// 指定したタグ名の音声が見つからなければ何もしない
-	if (audios.find(tagName) == audios.end()) {
+void AudioManager::SetVolume(AudioHandle handle, float volume) {
+	// 指定した音声が読み込まれていなければ何もしない
+	Audio* audio = GetAudio(handle);
+	if (!audio) {
 		return;
 	}
 
 	// 音量の設定
-	audios[tagName]->SetVolume(volume);
+	audio->SetVolume(volume);
 }
 
 void AudioManager::StopAll() {
 	// 全ての音声を停止
-	for (auto& pair : audios) {
-		if (pair.second) {
-			pair.second->Stop();
-		}
+	for (AudioEntry& entry : audios) {
+		entry.audio->Stop();
 	}
 }
 
@@ -170,7 +246,7 @@ void AudioManager::ImGui()
 	if (ImGui::CollapsingHeader("AudioManager")) {
 
 		// 読み込まれている音声ファイル数を表示
-		ImGui::Text("Files: %zu", audios.size());
+		ImGui::Text("Files: %zu", audios.GetSize());
 
 		// 同じ行の右側に全停止ボタンを配置
 		// SameLine(100)で水平位置100pxに配置
@@ -181,7 +257,7 @@ void AudioManager::ImGui()
 		}
 
 		// 音声ファイルが1つも読み込まれていない場合の処理
-		if (audios.empty()) {
+		if (audios.IsEmpty()) {
 			// グレーアウトされたテキストで状態を表示
 			ImGui::TextDisabled("No audio loaded");
 			return; // 以降の処理をスキップ
@@ -201,10 +277,12 @@ void AudioManager::ImGui()
 
 		// 音声名リストを毎フレーム更新
 		// （動的に音声が追加/削除される可能性があるため）
+		// 詰めた配列の順番は追加・削除で入れ替わるので、名前順に並べて表示が動かないようにする
 		audioNames.clear();
-		for (const auto& pair : audios) {
-			audioNames.push_back(pair.first);
+		for (const AudioEntry& entry : audios) {
+			audioNames.push_back(entry.tagName);
 		}
+		std::sort(audioNames.begin(), audioNames.end());
 
 		// 選択インデックスの範囲チェック
 		// 音声ファイルが削除された場合などに配列外アクセスを防ぐ
@@ -225,7 +303,7 @@ void AudioManager::ImGui()
 			// 全ての音声ファイルをリスト表示
 			for (int i = 0; i < static_cast<int>(audioNames.size()); i++) {
 				bool isSelected = (selectedAudio == i);
-				Audio* audio = audios[audioNames[i]];
+				Audio* audio = GetAudio(FindHandle(audioNames[i]));
 
 				// 再生中の音声ファイルは緑色でハイライト表示
 				if (audio && audio->IsPlaying()) {
@@ -274,7 +352,7 @@ void AudioManager::ImGui()
 		// 有効な音声が選択されている場合のみコントロールを表示
 		if (!audioNames.empty() && selectedAudio < static_cast<int>(audioNames.size())) {
 			const std::string& currentTag = audioNames[selectedAudio];
-			Audio* currentAudio = audios[currentTag];
+			Audio* currentAudio = GetAudio(FindHandle(currentTag));
 
 			if (currentAudio) {
 				// 視覚的な間隔を追加
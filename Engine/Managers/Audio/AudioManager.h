@@ -2,11 +2,17 @@
 #include <xaudio2.h>
 #include <wrl.h>
 #include <map>
+#include <memory>
 #include <string>
 #include <cassert>
 
 #include "Managers/Audio/Audio.h"
 #include "BaseSystem/Logger/Logger.h"
+#include "BaseSystem/Hash/StringIdTable.h"
+#include "BaseSystem/Container/SlotMap.h"
+
+// 音声のハンドル（タグ名に割り当てた番号）
+using AudioHandle = ResourceHandle<struct AudioHandleTag>;
 
 
 /// <summary>
@@ -27,7 +33,17 @@ public:
 	/// </summary>
 	/// <param name="filename"></param>
 	/// <param name="tagName"></param>
-	void LoadAudio(const std::string& filename, const std::string& tagName);
+	/// <returns>読み込めたか（失敗した時は同じタグ名の古い音声を残す）</returns>
+	bool LoadAudio(const std::string& filename, const std::string& tagName);
+
+	/// <summary>
+	/// 書き換えたファイルから読み込んだ音声を読み込み直す（ホットリロード用）
+	/// 同じスロットの音声を差し替えるのでハンドルはそのまま使える。鳴っていたものは同じループ設定と音量で最初から鳴らし直す
+	/// 読み込めなかったもの（書き込み途中・壊れたファイル）は差し替えずに古い音声を使い続ける
+	/// </summary>
+	/// <param name="filename">書き換えたファイルのパス</param>
+	/// <returns>読み込み直した音声の数</returns>
+	uint32_t ReloadAudioFile(const std::string& filename);
 
 	/// <summary>
 	/// 音声の再生(ループなし)
@@ -73,6 +89,25 @@ public:
 	/// <param name="volume"></param>
 	void SetVolume(const std::string& tagName, float volume);
 
+	///*-----------------------------------------------------------------------*///
+	//						ハンドルでの操作（毎フレーム鳴らすもの用）					//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// タグ名のハンドルを取得（読み込み前のタグにも割り当てられ、読み込まれた時点で使えるようになる）
+	/// </summary>
+	AudioHandle AcquireHandle(StringId tagId) { return { audioTable_.Acquire(tagId) }; }
+	AudioHandle AcquireHandle(const std::string& tagName) { return AcquireHandle(StringId::Intern(tagName)); }
+
+	// タグ名の代わりにハンドルで操作する（配列の添字で引くだけ。読み込まれていない・解放済みなら何もしない）
+	void Play(AudioHandle handle);
+	void PlayLoop(AudioHandle handle);
+	void Pause(AudioHandle handle);
+	void Resume(AudioHandle handle);
+	void Stop(AudioHandle handle);
+	void SetLoop(AudioHandle handle, bool loop);
+	void SetVolume(AudioHandle handle, float volume);
+
 	/// <summary>
 	/// 全ての音声を停止
 	/// </summary>
@@ -97,7 +132,33 @@ private:
 	Microsoft::WRL::ComPtr<IXAudio2> xAudio2;
 	// マスターボイス
 	IXAudio2MasteringVoice* masterVoice;
-	// audio
-	std::map<std::string, Audio*> audios;
+
+	/// <summary>
+	/// 読み込んだ音声
+	/// </summary>
+	struct AudioEntry {
+		std::string tagName;
+		std::unique_ptr<Audio> audio;
+		std::string filename;	// 読み込んだファイルのパス（読み込み直す時に使う）
+	};
+	using AudioSlot = SlotMap<AudioEntry>::Handle;
+
+	// audio（詰めた配列で持ち、解放したものを指すハンドルは世代番号で判別される）
+	SlotMap<AudioEntry> audios;
+	// タグ名のハンドルの表（同じタグで読み込み直すとスロットの世代が進み、古いハンドルは引いてもnullptrになる）
+	StringIdTable<AudioSlot> audioTable_;
+
+	/// <summary>
+	/// ハンドルから音声を取得（読み込まれていない・解放済みならnullptr）
+	/// </summary>
+	Audio* GetAudio(AudioHandle handle) const {
+		const AudioEntry* entry = audios.Get(audioTable_.Get(handle.index));
+		return entry ? entry->audio.get() : nullptr;
+	}
+
+	/// <summary>
+	/// タグ名のハンドルを検索（登録がなければ無効なハンドル、新しく割り当てはしない）
+	/// </summary>
+	AudioHandle FindHandle(const std::string& tagName) const { return { audioTable_.Find(StringId(tagName)) }; }
 
 };
\ No newline at end of file
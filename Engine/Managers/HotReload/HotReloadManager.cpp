@@ -0,0 +1,164 @@
+#include "HotReloadManager.h"
+#include "BaseSystem/DirectXCommon/DirectXCommon.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/Logger/Logger.h"
+#include "Managers/Audio/AudioManager.h"
+#include "Managers/ImGui/ImGuiManager.h"
+#include "Managers/Model/ModelManager.h"
+#include "Managers/Texture/TextureManager.h"
+#include <chrono>
+#include <filesystem>
+
+// シングルトンインスタンス
+HotReloadManager* HotReloadManager::GetInstance() {
+	static HotReloadManager instance;
+	return &instance;
+}
+
+HotReloadManager::~HotReloadManager() {
+	Finalize();
+}
+
+void HotReloadManager::Initialize(DirectXCommon* dxCommon) {
+	dxCommon_ = dxCommon;
+
+	// 開発中だけ見張る（リリースではアーカイブから読むだけなので不要）
+#ifdef _DEBUG
+	SetEnabled(true);
+#endif
+
+	Logger::Log(Logger::GetStream(), "HotReloadManager initialized !!\n");
+}
+
+void HotReloadManager::Finalize() {
+	watcher_.Stop();
+	retiredObjects_.clear();
+	dxCommon_ = nullptr;
+}
+
+void HotReloadManager::SetEnabled(bool isEnabled) {
+	if (isEnabled == watcher_.IsRunning()) {
+		return;
+	}
+	if (!isEnabled) {
+		watcher_.Stop();
+		Logger::Log(Logger::GetStream(), "HotReloadManager: Stopped watching\n");
+		return;
+	}
+	if (!watcher_.Start(kWatchDirectory)) {
+		Logger::Log(Logger::GetStream(), std::format("HotReloadManager: Failed to watch {}\n", kWatchDirectory));
+		return;
+	}
+	Logger::Log(Logger::GetStream(), std::format("HotReloadManager: Watching {}\n", kWatchDirectory));
+}
+
+void HotReloadManager::Update() {
+	if (!dxCommon_) {
+		return;
+	}
+	ReleaseRetiredObjects();
+
+	for (const std::string& filename : watcher_.CollectChanges()) {
+		++statistics_.changedFileCount;
+		ReloadFile(filename);
+	}
+}
+
+uint32_t HotReloadManager::ReloadFile(const std::string& filename) {
+	const FileKind kind = GetFileKind(filename);
+	if (kind == FileKind::Unknown || !dxCommon_) {
+		return 0;
+	}
+
+	// 書き換えたものはアーカイブに入っていてもディスクのファイルを読む
+	VirtualFileSystem::GetInstance()->AddLooseOverride(filename);
+
+	const auto startTime = std::chrono::steady_clock::now();
+	RetiredObjects retired;
+	retired.frame = dxCommon_->GetFrameCount();
+	uint32_t reloadedCount = 0;
+
+	switch (kind) {
+	case FileKind::Model:
+		reloadedCount = ModelManager::GetInstance()->ReloadModelFile(filename, retired.models);
+		statistics_.modelCount += reloadedCount;
+		break;
+	case FileKind::Texture:
+		reloadedCount = TextureManager::GetInstance()->ReloadTextureFile(filename);
+		statistics_.textureCount += reloadedCount;
+		break;
+	case FileKind::Audio:
+		reloadedCount = AudioManager::GetInstance()->ReloadAudioFile(filename);
+		statistics_.audioCount += reloadedCount;
+		break;
+	case FileKind::Shader:
+		reloadedCount = dxCommon_->GetPSOFactory()->ReloadShaderFile(filename, retired.pipelineStates);
+		statistics_.pipelineStateCount += reloadedCount;
+		break;
+	default:
+		break;
+	}
+
+	if (!retired.models.empty() || !retired.pipelineStates.empty()) {
+		retiredObjects_.push_back(std::move(retired));
+	}
+	if (reloadedCount == 0) {
+		++statistics_.unusedFileCount;
+		return 0;
+	}
+
+	const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+	statistics_.lastReloadMilliseconds = elapsed.count();
+	statistics_.lastFile = filename;
+	Logger::Log(Logger::GetStream(), std::format("HotReloadManager: Reloaded {} ({} objects, {:.2f} ms)\n",
+		filename, reloadedCount, statistics_.lastReloadMilliseconds));
+	return reloadedCount;
+}
+
+HotReloadManager::FileKind HotReloadManager::GetFileKind(const std::string& filename) {
+	std::string extension = std::filesystem::path(filename).extension().string();
+	for (char& c : extension) {
+		c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+	if (extension == ".obj" || extension == ".mtl") {
+		return FileKind::Model;
+	}
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" ||
+		extension == ".tga" || extension == ".dds" || extension == ".hdr") {
+		return FileKind::Texture;
+	}
+	if (extension == ".wav" || extension == ".mp3") {
+		return FileKind::Audio;
+	}
+	if (extension == ".hlsl" || extension == ".hlsli") {
+		return FileKind::Shader;
+	}
+	return FileKind::Unknown;
+}
+
+void HotReloadManager::ReleaseRetiredObjects() {
+	// DirectXCommon::kFrameCountフレーム前のものはGPUが使い終わっている
+	const uint64_t frame = dxCommon_->GetFrameCount();
+	std::erase_if(retiredObjects_, [frame](const RetiredObjects& retired) {
+		return retired.frame + DirectXCommon::kFrameCount <= frame;
+	});
+}
+
+void HotReloadManager::ImGui() {
+#ifdef _DEBUG
+	bool isEnabled = IsEnabled();
+	if (ImGui::Checkbox("Hot Reload", &isEnabled)) {
+		SetEnabled(isEnabled);
+	}
+	ImGui::Text("Hot Reload: changed %llu, models %llu / textures %llu / audio %llu / PSOs %llu (unused %llu)",
+		static_cast<unsigned long long>(statistics_.changedFileCount),
+		static_cast<unsigned long long>(statistics_.modelCount),
+		static_cast<unsigned long long>(statistics_.textureCount),
+		static_cast<unsigned long long>(statistics_.audioCount),
+		static_cast<unsigned long long>(statistics_.pipelineStateCount),
+		static_cast<unsigned long long>(statistics_.unusedFileCount));
+	if (!statistics_.lastFile.empty()) {
+		ImGui::Text("Last reload: %s (%.2f ms)", statistics_.lastFile.c_str(), statistics_.lastReloadMilliseconds);
+	}
+#endif
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BaseSystem/FileSystem/FileWatcher.h"
+
+class DirectXCommon;
+class Model;
+
+/// <summary>
+/// resourcesの下で書き換えられたファイルを見張り、それを使っているものだけをその場で読み込み直す（ホットリロード）
+///  .obj・.mtl → ModelManagerのモデル（同じスロットで差し替えるので、GameObjectは次に引いた時から新しいモデルを描く）
+///  .png・.jpg・.dds など → TextureManagerのテクスチャ（SRVの番号はそのまま）
+///  .wav・.mp3 → AudioManagerの音声（鳴っていたものは鳴らし直す）
+///  .hlsl・.hlsli → PSOFactoryに登録したPSO（コンパイルエラーの間は前のPSOのまま）
+/// どのハンドルもそのまま使える。差し替えた古いモデルとPSOはGPUが使い終わるまで保持する
+/// 書き換えたファイルはアーカイブより優先して読むようにする（アーカイブをマウントしていても反映される）
+/// デバッグビルドでのみ既定で有効
+/// </summary>
+class HotReloadManager {
+public:
+	// 見張るフォルダ
+	static constexpr const char* kWatchDirectory = "resources";
+
+	/// <summary>
+	/// 読み込み直した数の統計
+	/// </summary>
+	struct Statistics {
+		uint64_t changedFileCount = 0;		// 書き終わったとみなしたファイルの数
+		uint64_t modelCount = 0;			// 読み込み直したモデルの数
+		uint64_t textureCount = 0;			// 読み込み直したテクスチャの数
+		uint64_t audioCount = 0;			// 読み込み直した音声の数
+		uint64_t pipelineStateCount = 0;	// 作り直したPSOの数
+		uint64_t unusedFileCount = 0;		// 対象の種類だが、読み込んでいるものがなかったファイルの数
+		double lastReloadMilliseconds = 0.0;	// 最後に読み込み直した時にかかった時間
+		std::string lastFile;				// 最後に読み込み直したファイル
+	};
+
+	// シングルトン
+	static HotReloadManager* GetInstance();
+
+	/// <summary>
+	/// 初期化（デバッグビルドでは見張りを始める）
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon);
+
+	/// <summary>
+	/// 終了処理（見張りを止め、保持している古いモデルとPSOを解放する）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 書き終わったファイルを読み込み直す
+	/// GPUが前のフレームを描き終わっている時（フレームの最初、描画を積む前）に呼ぶ
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// ファイルを使っているものを読み込み直す（見張りとは関係なく呼んでよい）
+	/// </summary>
+	/// <param name="filename">書き換えたファイルのパス（resources/...）</param>
+	/// <returns>読み込み直したものの数</returns>
+	uint32_t ReloadFile(const std::string& filename);
+
+	/// <summary>
+	/// 見張るかどうか
+	/// </summary>
+	void SetEnabled(bool isEnabled);
+	bool IsEnabled() const { return watcher_.IsRunning(); }
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+	/// <summary>
+	/// ImGui
+	/// </summary>
+	void ImGui();
+
+private:
+	HotReloadManager() = default;
+	~HotReloadManager();
+	HotReloadManager(const HotReloadManager&) = delete;
+	HotReloadManager& operator=(const HotReloadManager&) = delete;
+
+	/// <summary>
+	/// 読み込み直すファイルの種類
+	/// </summary>
+	enum class FileKind {
+		Unknown,
+		Model,
+		Texture,
+		Audio,
+		Shader,
+	};
+
+	/// <summary>
+	/// 拡張子からファイルの種類を判断
+	/// </summary>
+	static FileKind GetFileKind(const std::string& filename);
+
+	/// <summary>
+	/// GPUが使い終わった古いモデルとPSOを解放
+	/// </summary>
+	void ReleaseRetiredObjects();
+
+	DirectXCommon* dxCommon_ = nullptr;
+	FileWatcher watcher_;
+	Statistics statistics_;
+
+	/// <summary>
+	/// 差し替えた古いモデルとPSO（前のフレームの描画が使っているので、GPUが使い終わるまで保持）
+	/// </summary>
+	struct RetiredObjects {
+		std::vector<std::unique_ptr<Model>> models;
+		std::vector<Microsoft::WRL::ComPtr<ID3D12PipelineState>> pipelineStates;
+		uint64_t frame = 0;
+	};
+	std::vector<RetiredObjects> retiredObjects_;
+};
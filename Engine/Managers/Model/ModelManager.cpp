@@ -1,6 +1,30 @@
 #include "ModelManager.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/Hash/Hash.h"
+#include <algorithm>
+#include <iterator>
 #include <cassert>
 
+namespace {
+	/// <summary>
+	/// OBJ・MTLの1行が指定した命令なら、最初の引数（ファイル名）を取り出す
+	/// </summary>
+	bool ReadFileDirective(std::string_view line, std::string_view keyword, std::string_view& argument) {
+		// 字下げしてあるものもある（Model::LoadMaterialTemplateFileは>>で読むので先頭の空白を飛ばす）
+		line.remove_prefix((std::min)(line.find_first_not_of(" \t"), line.size()));
+		if (line.size() <= keyword.size() || !line.starts_with(keyword) ||
+			(line[keyword.size()] != ' ' && line[keyword.size()] != '\t')) {
+			return false;
+		}
+		const size_t begin = line.find_first_not_of(" \t", keyword.size());
+		if (begin == std::string_view::npos) {
+			return false;
+		}
+		argument = line.substr(begin, line.find_first_of(" \t", begin) - begin);
+		return true;
+	}
+}
+
 ModelManager* ModelManager::GetInstance() {
 	static ModelManager instance;
 	return &instance;
@@ -31,6 +55,13 @@ bool ModelManager::LoadModel(const std::string& directoryPath, const std::string
 		return true;
 	}
 
+	// 中身が同じモデルを読み込み済みならそれを共有する
+	ModelTag tag{ tagName, directoryPath, filename, {} };
+	const uint64_t contentHash = ComputeContentHash(directoryPath, filename, tag.sourceFilePaths);
+	if (ShareModel(tag, contentHash)) {
+		return true;
+	}
+
 	// 新しいモデルを作成
 	auto model = std::make_unique<Model>();
 
@@ -40,8 +71,8 @@ bool ModelManager::LoadModel(const std::string& directoryPath, const std::string
 		return false;
 	}
 
-	// マップに登録
-	models_[tagName] = std::move(model);
+	// 登録してタグ名と結び付ける
+	RegisterModel(tagName, std::move(model), directoryPath, filename, contentHash);
 
 	Logger::Log(Logger::GetStream(), std::format("Model '{}' loaded successfully with tag '{}'\n", filename, tagName));
 	return true;
@@ -63,18 +94,94 @@ bool ModelManager::LoadPrimitive(MeshType meshType, const std::string& tagName)
 		return false;
 	}
 
-	// マップに登録
-	models_[tagName] = std::move(model);
+	// 登録してタグ名と結び付ける
+	RegisterModel(tagName, std::move(model));
 
 	Logger::Log(Logger::GetStream(), std::format("Primitive model '{}' loaded successfully with tag '{}'\n",
 		Mesh::MeshTypeToString(meshType), tagName));
 	return true;
 }
 
+uint32_t ModelManager::ReloadModelFile(const std::string& filename, std::vector<std::unique_ptr<Model>>& retiredModels) {
+	// 読み込んだ時のパスと書き方が違っても同じファイルとして扱う
+	const std::string normalizedPath = AssetPack::NormalizePath(filename);
+	auto isChanged = [&normalizedPath](const ModelTag& tag) {
+		return std::any_of(tag.sourceFilePaths.begin(), tag.sourceFilePaths.end(), [&normalizedPath](const std::string& path) {
+			return AssetPack::NormalizePath(path) == normalizedPath;
+		});
+	};
+
+	// 書き換えたファイルのタグを持つものを先に集める（分ける時にモデルを追加するので、回しながらは変えない）
+	std::vector<ModelSlot> slots;
+	for (size_t i = 0; i < models_.GetSize(); ++i) {
+		const ModelSlot slot = models_.GetHandle(i);
+		const std::vector<ModelTag>& tags = models_.Get(slot)->tags;
+		if (std::any_of(tags.begin(), tags.end(), isChanged)) {
+			slots.push_back(slot);
+		}
+	}
+
+	uint32_t reloadedCount = 0;
+	for (const ModelSlot& slot : slots) {
+		ModelEntry* entry = models_.Get(slot);
+		std::vector<ModelTag> changedTags;
+		std::copy_if(entry->tags.begin(), entry->tags.end(), std::back_inserter(changedTags), isChanged);
+
+		// 同じパスだと読み込み済みとして飛ばされるので、書き換えたファイルを使うタグのOBJから新しいモデルに読み込む
+		auto model = std::make_unique<Model>();
+		if (!model->LoadFromOBJ(changedTags.front().directoryPath, changedTags.front().filename, dxCommon_)) {
+			Logger::Log(Logger::GetStream(), std::format("Failed to reload model '{}', keeping the previous one.\n", changedTags.front().tagName));
+			continue;
+		}
+		// MTLを足したり外したりしていることもあるので、読み込んだタグのファイルを取り直す
+		changedTags.front().sourceFilePaths = model->GetSourceFilePaths();
+
+		if (changedTags.size() < entry->tags.size()) {
+			// 別のファイルのタグと中身が同じで共有していた場合は、書き換えたファイルのタグだけを新しいモデルに分ける
+			// 残ったタグは元のモデルのまま（中身のハッシュも元のまま共有できる）
+			const ModelSlot newSlot = models_.Insert({ changedTags, std::move(model), 0 });
+			for (const ModelTag& tag : changedTags) {
+				modelTable_.Set(StringId::Intern(tag.tagName), newSlot);
+			}
+
+			// 追加で配列が動くので取り直す
+			entry = models_.Get(slot);
+			std::erase_if(entry->tags, isChanged);
+			++reloadedCount;
+
+			Logger::Log(Logger::GetStream(), std::format("Model file '{}' changed. Split {} tags from '{}' into a new model.\n",
+				filename, changedTags.size(), entry->tags.front().tagName));
+			continue;
+		}
+
+		// スロットはそのままなので、表に残ったハンドルは新しいモデルを引く
+		retiredModels.push_back(std::move(entry->model));
+		entry->model = std::move(model);
+		entry->tags = std::move(changedTags);
+
+		// 中身が変わったので、これから読み込む元の中身のものとは共有しない
+		if (entry->contentHash != 0) {
+			contentSlots_.erase(entry->contentHash);
+			entry->contentHash = 0;
+		}
+		++reloadedCount;
+
+		Logger::Log(Logger::GetStream(), std::format("Model '{}' reloaded from {}\n", entry->tags.front().tagName, filename));
+	}
+	return reloadedCount;
+}
+
 Model* ModelManager::GetModel(const std::string& tagName) {
-	auto it = models_.find(tagName);
-	if (it != models_.end()) {
-		return it->second.get();
+	const ModelSlot slot = modelTable_.Get(modelTable_.Find(StringId(tagName)));
+	ModelEntry* entry = models_.Get(slot);
+	if (entry) {
+		return entry->model.get();
+	}
+
+	// 解放済みのものを使おうとしている場合は区別してログを出す
+	if (models_.IsStale(slot)) {
+		Logger::Log(Logger::GetStream(), std::format("Model with tag '{}' was already unloaded.\n", tagName));
+		return nullptr;
 	}
 
 	// モデルが見つからない場合はnullptr
@@ -83,13 +190,29 @@ Model* ModelManager::GetModel(const std::string& tagName) {
 }
 
 void ModelManager::UnloadModel(const std::string& tagName) {
-	auto modelIt = models_.find(tagName);
-	if (modelIt != models_.end()) {
+	const StringId tagId(tagName);
+	const ModelSlot slot = modelTable_.Get(modelTable_.Find(tagId));
+	ModelEntry* entry = models_.Get(slot);
+	if (entry) {
+		// 中身が同じで共有している他のタグが残っていれば、このタグを外すだけ
+		if (entry->tags.size() > 1) {
+			std::erase_if(entry->tags, [&tagName](const ModelTag& tag) {
+				return tag.tagName == tagName;
+			});
+			modelTable_.Reset(tagId);
+			Logger::Log(Logger::GetStream(), std::format("Model with tag '{}' unloaded ({} tags still share it).\n",
+				tagName, entry->tags.size()));
+			return;
+		}
+
 		// モデルをアンロード
-		modelIt->second->Unload();
+		entry->model->Unload();
+		if (entry->contentHash != 0) {
+			contentSlots_.erase(entry->contentHash);
+		}
 
-		// マップから削除
-		models_.erase(modelIt);
+		// 削除（スロットの世代が進むので、表に残ったハンドルから引いてもnullptrになる）
+		models_.Erase(slot);
 
 		Logger::Log(Logger::GetStream(), std::format("Model with tag '{}' unloaded.\n", tagName));
 	}
@@ -97,16 +220,104 @@ void ModelManager::UnloadModel(const std::string& tagName) {
 
 void ModelManager::UnloadAll() {
 	// 全てのモデルを解放
-	for (const auto& pair : models_) {
-		Logger::Log(Logger::GetStream(), std::format("Unloading model: {}\n", pair.first));
-		pair.second->Unload();
+	for (const ModelEntry& entry : models_) {
+		Logger::Log(Logger::GetStream(), std::format("Unloading model: {}\n", entry.tags.front().tagName));
+		entry.model->Unload();
 	}
 
-	models_.clear();
+	// 全てのスロットの世代が進むので、表に残ったハンドルは全てnullptrになる
+	models_.Clear();
+	contentSlots_.clear();
 
 	Logger::Log(Logger::GetStream(), "All models unloaded.\n");
 }
 
 bool ModelManager::HasModel(const std::string& tagName) const {
-	return models_.find(tagName) != models_.end();
+	return models_.Contains(modelTable_.Get(modelTable_.Find(StringId(tagName))));
+}
+
+uint32_t ModelManager::GetReferenceCount(const std::string& tagName) const {
+	const ModelEntry* entry = models_.Get(modelTable_.Get(modelTable_.Find(StringId(tagName))));
+	return entry ? static_cast<uint32_t>(entry->tags.size()) : 0;
+}
+
+void ModelManager::RegisterModel(const std::string& tagName, std::unique_ptr<Model> model,
+	const std::string& directoryPath, const std::string& filename, uint64_t contentHash) {
+	ModelTag tag{ tagName, directoryPath, filename, model->GetSourceFilePaths() };
+	const ModelSlot slot = models_.Insert({ { std::move(tag) }, std::move(model), contentHash });
+	modelTable_.Set(StringId::Intern(tagName), slot);
+	if (contentHash != 0) {
+		contentSlots_[contentHash] = slot;
+	}
+}
+
+uint64_t ModelManager::ComputeContentHash(const std::string& directoryPath, const std::string& filename,
+	std::vector<std::string>& sourceFilePaths) {
+	// パスはModel::LoadFromOBJと同じ書き方にそろえる
+	sourceFilePaths.assign(1, directoryPath + "/" + filename);
+
+	VirtualFileSystem* fileSystem = VirtualFileSystem::GetInstance();
+	const FileView objFile = fileSystem->Open(sourceFilePaths.front());
+	if (!objFile.IsValid()) {
+		return 0;
+	}
+	uint64_t hash = Hash::Content(objFile.GetData(), objFile.GetSize());
+
+	// 参照しているMTLの中身も続けてかける
+	TextLineReader reader(objFile.GetText());
+	std::string_view line;
+	std::string_view materialFilename;
+	while (reader.ReadLine(line)) {
+		if (!ReadFileDirective(line, "mtllib", materialFilename)) {
+			continue;
+		}
+		sourceFilePaths.push_back(directoryPath + "/" + std::string(materialFilename));
+		const FileView mtlFile = fileSystem->Open(sourceFilePaths.back());
+		if (!mtlFile.IsValid()) {
+			continue;
+		}
+		hash = Hash::Content(mtlFile.GetData(), mtlFile.GetSize(), hash);
+
+		// MTLのテクスチャはフォルダからの相対パスなので、同じMTLでも別のフォルダなら別の画像を指す
+		// 指している画像の中身もかける（開けなければ解決したパスをかける）
+		TextLineReader materialReader(mtlFile.GetText());
+		std::string_view materialLine;
+		std::string_view textureFilename;
+		while (materialReader.ReadLine(materialLine)) {
+			if (!ReadFileDirective(materialLine, "map_Kd", textureFilename)) {
+				continue;
+			}
+			const std::string texturePath = directoryPath + "/" + std::string(textureFilename);
+			const FileView textureFile = fileSystem->Open(texturePath);
+			if (textureFile.IsValid()) {
+				hash = Hash::Content(textureFile.GetData(), textureFile.GetSize(), hash);
+			} else {
+				hash = Hash::Content(texturePath.data(), texturePath.size(), hash);
+			}
+		}
+	}
+	return hash;
+}
+
+bool ModelManager::ShareModel(const ModelTag& tag, uint64_t contentHash) {
+	if (contentHash == 0) {
+		return false;
+	}
+	auto it = contentSlots_.find(contentHash);
+	if (it == contentSlots_.end()) {
+		return false;
+	}
+	ModelEntry* entry = models_.Get(it->second);
+	if (!entry) {
+		return false;
+	}
+
+	// 同じスロットを指すので、どのタグのハンドルからも同じモデルを引く
+	// ファイルはタグごとに覚えておく（後でどちらかのファイルだけが書き換えられた時に分けられるように）
+	entry->tags.push_back(tag);
+	modelTable_.Set(StringId::Intern(tag.tagName), it->second);
+
+	Logger::Log(Logger::GetStream(), std::format("Model with tag '{}' has the same content as '{}'. Sharing it ({} tags).\n",
+		tag.tagName, entry->tags.front().tagName, entry->tags.size()));
+	return true;
 }
\ No newline at end of file
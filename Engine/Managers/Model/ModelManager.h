@@ -1,11 +1,17 @@
 #pragma once
 #include <string>
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "Objects/GameObject/Model.h"
 #include "Managers/Texture/TextureManager.h"
 #include "BaseSystem/Logger/Logger.h"
+#include "BaseSystem/Hash/StringIdTable.h"
+#include "BaseSystem/Container/SlotMap.h"
+
+// モデルのハンドル（タグ名に割り当てた番号）
+using ModelHandle = ResourceHandle<struct ModelHandleTag>;
 
 /// <summary>
 /// モデルリソースを管理する
@@ -27,6 +33,7 @@ public:
 
 	/// <summary>
 	/// OBJモデルの読み込み
+	/// OBJ・参照しているMTL・MTLが指すテクスチャの中身のハッシュが同じモデルを読み込み済みなら、読み込まずにそれを共有する
 	/// </summary>
 	/// <param name="directoryPath">ディレクトリパス</param>
 	/// <param name="filename">ファイル名</param>
@@ -42,6 +49,17 @@ public:
 	/// <returns>読み込み成功かどうか</returns>
 	bool LoadPrimitive(MeshType meshType, const std::string& tagName);
 
+	/// <summary>
+	/// 書き換えたファイル（.obj・.mtl）から読み込んだモデルを読み込み直す（ホットリロード用）
+	/// 同じスロットのモデルを新しいものに差し替えるので、ハンドルはそのまま使え、GameObjectは次に引いた時から新しいモデルを描く
+	/// 別のファイルのタグと中身が同じで共有していた場合は、書き換えたファイルのタグだけを新しいモデルに分ける
+	/// 読み込めなかった場合は今のモデルのまま
+	/// </summary>
+	/// <param name="filename">書き換えたファイルのパス</param>
+	/// <param name="retiredModels">差し替えた古いモデルの追加先（前のフレームの描画が使っているので、GPUが使い終わるまで呼び出し側で保持する）</param>
+	/// <returns>読み込み直したモデルの数</returns>
+	uint32_t ReloadModelFile(const std::string& filename, std::vector<std::unique_ptr<Model>>& retiredModels);
+
 	/// <summary>
 	/// モデルの取得
 	/// </summary>
@@ -49,12 +67,36 @@ public:
 	/// <returns>モデルのポインタ（存在しない場合はnullptr）</returns>
 	Model* GetModel(const std::string& tagName);
 
+	/// <summary>
+	/// タグ名のハンドルを取得（読み込み前のタグにも割り当てられ、読み込まれた時点で引けるようになる）
+	/// </summary>
+	/// <param name="tagId">識別用のタグ名のStringId</param>
+	/// <returns>ハンドル</returns>
+	ModelHandle AcquireHandle(StringId tagId) { return { modelTable_.Acquire(tagId) }; }
+	ModelHandle AcquireHandle(const std::string& tagName) { return AcquireHandle(StringId::Intern(tagName)); }
+
+	/// <summary>
+	/// ハンドルからモデルを取得（配列の添字で引くだけ。読み込まれていない・解放済みならnullptr）
+	/// </summary>
+	Model* GetModel(ModelHandle handle) const {
+		const ModelEntry* entry = models_.Get(modelTable_.Get(handle.index));
+		return entry ? entry->model.get() : nullptr;
+	}
+
 	/// <summary>
 	/// モデルの解放
+	/// 中身が同じで共有しているものは、最後のタグを解放した時にモデルを解放する
 	/// </summary>
 	/// <param name="tagName">識別用のタグ名</param>
 	void UnloadModel(const std::string& tagName);
 
+	/// <summary>
+	/// モデルを共有しているタグの数を取得
+	/// </summary>
+	/// <param name="tagName">識別用のタグ名</param>
+	/// <returns>参照しているタグの数（読み込まれていなければ0）</returns>
+	uint32_t GetReferenceCount(const std::string& tagName) const;
+
 	/// <summary>
 	/// 全てのモデルを解放
 	/// </summary>
@@ -71,7 +113,7 @@ public:
 	/// 読み込まれているモデルの数を取得
 	/// </summary>
 	/// <returns>モデル数</returns>
-	size_t GetModelCount() const { return models_.size(); }
+	size_t GetModelCount() const { return models_.GetSize(); }
 
 private:
 	ModelManager() = default;
@@ -82,8 +124,52 @@ private:
 	DirectXCommon* dxCommon_ = nullptr;
 	TextureManager* textureManager_ = nullptr;
 
-	// モデルの管理用マップ（tagNameからModelを見つける）
-	std::map<std::string, std::unique_ptr<Model>> models_;
+	/// <summary>
+	/// モデルに結び付けたタグと、そのタグで読み込んだファイル
+	/// </summary>
+	struct ModelTag {
+		std::string tagName;
+		std::string directoryPath;	// OBJのフォルダとファイル名（プリミティブは空。読み込み直す時に使う）
+		std::string filename;
+		std::vector<std::string> sourceFilePaths;	// OBJと参照しているMTLのパス（書き換えたファイルを使っているか調べる）
+	};
+
+	/// <summary>
+	/// 読み込んだモデル
+	/// </summary>
+	struct ModelEntry {
+		std::vector<ModelTag> tags;		// 結び付けたタグ（中身が同じで共有しているものも含む）
+		std::unique_ptr<Model> model;
+		uint64_t contentHash = 0;		// OBJ・MTL・テクスチャの中身のハッシュ（プリミティブは0）
+	};
+	using ModelSlot = SlotMap<ModelEntry>::Handle;
+
+	/// <summary>
+	/// モデルを登録してタグ名と結び付ける（タグのファイルはモデルが読み込んだOBJとMTL）
+	/// </summary>
+	void RegisterModel(const std::string& tagName, std::unique_ptr<Model> model,
+		const std::string& directoryPath = "", const std::string& filename = "", uint64_t contentHash = 0);
+
+	/// <summary>
+	/// OBJ・参照しているMTL・MTLが指すテクスチャの中身のハッシュ（OBJが読めなければ0）
+	/// </summary>
+	/// <param name="sourceFilePaths">OBJと参照しているMTLのパスの格納先</param>
+	static uint64_t ComputeContentHash(const std::string& directoryPath, const std::string& filename, std::vector<std::string>& sourceFilePaths);
+
+	/// <summary>
+	/// 中身が同じモデルを読み込み済みなら、タグをそれに結び付けて共有する
+	/// </summary>
+	/// <returns>共有したかどうか</returns>
+	bool ShareModel(const ModelTag& tag, uint64_t contentHash);
+
+	// 読み込んだモデル（詰めた配列で持ち、解放したものを指すハンドルは世代番号で判別される）
+	SlotMap<ModelEntry> models_;
+
+	// タグ名のハンドルの表（解放したモデルのスロットは世代が進むので、古いハンドルは引いてもnullptrになる）
+	StringIdTable<ModelSlot> modelTable_;
+
+	// OBJ・MTL・テクスチャの中身のハッシュからモデルを引く（同じ中身のものを共有する）
+	std::unordered_map<uint64_t, ModelSlot> contentSlots_;
 
 
 };
\ No newline at end of file
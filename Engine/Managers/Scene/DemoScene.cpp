@@ -12,6 +12,8 @@ DemoScene::DemoScene()
 	, viewProjectionMatrix{ MakeIdentity4x4() }
 	, viewProjectionMatrixSprite{ MakeIdentity4x4() }
 {
+	// 八分木はシーンと同じ寿命（シーンを作り直した時は古いオブジェクトの破棄で登録が外れる）
+	sceneOctree_.Initialize();
 }
 
 DemoScene::~DemoScene() = default;
@@ -99,6 +101,7 @@ void DemoScene::InitializeGameObjects() {
 	sphere_ = std::make_unique<Sphere>();
 	sphere_->Initialize(directXCommon_, "sphere", "monsterBall");
 	sphere_->SetTransform(transformSphere);
+	sphere_->SetSceneOctree(&sceneOctree_);
 
 	///*-----------------------------------------------------------------------*///
 	///									平面									///
@@ -112,6 +115,8 @@ void DemoScene::InitializeGameObjects() {
 	plane_ = std::make_unique<Plane>();
 	plane_->Initialize(directXCommon_, "plane", "uvChecker");
 	plane_->SetTransform(transformPlane);
+	plane_->SetSceneOctree(&sceneOctree_);
+	plane_->SetOccluder(true);
 
 	///*-----------------------------------------------------------------------*///
 	///								MultiMesh									///
@@ -125,6 +130,7 @@ void DemoScene::InitializeGameObjects() {
 	modelMultiMesh_ = std::make_unique<Model3D>();
 	modelMultiMesh_->Initialize(directXCommon_, "model_MultiMesh");
 	modelMultiMesh_->SetTransform(transformMultiMesh);
+	modelMultiMesh_->SetSceneOctree(&sceneOctree_);
 
 	///*-----------------------------------------------------------------------*///
 	///								MultiMaterial								///
@@ -138,6 +144,7 @@ void DemoScene::InitializeGameObjects() {
 	modelMultiMaterial_ = std::make_unique<Model3D>();
 	modelMultiMaterial_->Initialize(directXCommon_, "model_MultiMaterial");
 	modelMultiMaterial_->SetTransform(transformMultiMaterial);
+	modelMultiMaterial_->SetSceneOctree(&sceneOctree_);
 
 
 	///*-----------------------------------------------------------------------*///
@@ -204,6 +211,23 @@ void DemoScene::UpdateGameObjects() {
 	modelMultiMaterial_->Update(viewProjectionMatrix);
 	// グリッド線更新
 	gridLine_->Update(viewProjectionMatrix);
+
+	// 視錐台内のオブジェクトを集める
+	visibleObjects_.clear();
+	sceneOctree_.QueryFrustum(viewProjectionMatrix, visibleObjects_);
+
+	// 視錐台内のオブジェクトのAABBを表示（デバッグ用）
+	if (isShowBounds_) {
+		for (const GameObject* object : visibleObjects_) {
+			DebugDraw::GetInstance()->AddAABB(object->GetWorldBounds(), { 1.0f, 1.0f, 0.0f, 1.0f });
+		}
+	}
+
+	// オクルージョンカリング（EngineのImGuiで有効にした時のみ、平面を遮蔽物にする）
+	OcclusionCuller* occlusionCuller = OcclusionCuller::GetInstance();
+	occlusionCuller->BeginFrame(viewProjectionMatrix);
+	plane_->SubmitOccluder();
+	occlusionCuller->Rasterize();
 }
 
 void DemoScene::DrawOffscreen() {
@@ -211,14 +235,10 @@ void DemoScene::DrawOffscreen() {
 	gridLine_->Draw(viewProjectionMatrix);
 
 	// 3Dゲームオブジェクトの描画（オフスクリーンに描画）
-	// 球体の描画
-	sphere_->Draw(directionalLight_);
-	//平面の描画
-	plane_->Draw(directionalLight_);
-	//マルチメッシュモデルの描画
-	modelMultiMesh_->Draw(directionalLight_);
-	//マルチマテリアルモデルの描画
-	modelMultiMaterial_->Draw(directionalLight_);
+	// 八分木で視錐台内にあるものだけを描画
+	for (GameObject* object : visibleObjects_) {
+		object->Draw(directionalLight_);
+	}
 }
 
 void DemoScene::DrawBackBuffer() {
@@ -253,6 +273,14 @@ void DemoScene::ImGui() {
 	ImGui::Text("ModelMultiMaterial");
 	modelMultiMaterial_->ImGui();
 
+	ImGui::Spacing();
+	// 八分木の統計
+	const SceneOctree::Statistics& octreeStatistics = sceneOctree_.GetStatistics();
+	ImGui::Checkbox("Show Bounds", &isShowBounds_);
+	ImGui::Text("Octree: %u objects, %u nodes, visible %u (visited %u nodes, tested %u)",
+		octreeStatistics.objectCount, octreeStatistics.nodeCount, octreeStatistics.resultCount,
+		octreeStatistics.visitedNodeCount, octreeStatistics.testedObjectCount);
+
 	ImGui::Spacing();
 	// ライトのImGui
 	ImGui::Text("Lighting");
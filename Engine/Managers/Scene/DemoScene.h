@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <array>
+#include <vector>
 
 #include "Objects/Sprite/Sprite.h"
 #include "Objects/Light/Light.h"
@@ -58,6 +59,11 @@ private:
 	void InitializeGameObjects();
 	void UpdateGameObjects();
 
+	// 空間分割（ゲームオブジェクトより先に宣言して、後に破棄されるようにする）
+	SceneOctree sceneOctree_;
+	std::vector<GameObject*> visibleObjects_;	// 今フレームの視錐台内のオブジェクト
+	bool isShowBounds_ = false;					// 視錐台内のオブジェクトのAABBをデバッグ描画するか
+
 	// ゲームオブジェクト
 	std::unique_ptr<Sphere> sphere_;
 	std::unique_ptr<Plane> plane_;
@@ -0,0 +1,194 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <numeric>
+
+void AtlasPacker::Initialize(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding) {
+	pageWidth_ = pageWidth;
+	pageHeight_ = pageHeight;
+	padding_ = padding;
+	pages_.clear();
+}
+
+bool AtlasPacker::Pack(const std::vector<Item>& items, std::vector<Placement>& placements) {
+	placements.assign(items.size(), Placement{});
+
+	// 長辺 → 面積 → 幅の順に大きいものから詰める（サイズだけで並びが決まるので入力順に依らない）
+	std::vector<uint32_t> order(items.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::sort(order.begin(), order.end(), [&items](uint32_t a, uint32_t b) {
+		const uint32_t longA = (std::max)(items[a].width, items[a].height);
+		const uint32_t longB = (std::max)(items[b].width, items[b].height);
+		if (longA != longB) {
+			return longA > longB;
+		}
+		const uint64_t areaA = static_cast<uint64_t>(items[a].width) * items[a].height;
+		const uint64_t areaB = static_cast<uint64_t>(items[b].width) * items[b].height;
+		if (areaA != areaB) {
+			return areaA > areaB;
+		}
+		if (items[a].width != items[b].width) {
+			return items[a].width > items[b].width;
+		}
+		return a < b;
+	});
+
+	bool isAllPacked = true;
+	for (uint32_t index : order) {
+		const Item& item = items[index];
+		const uint32_t paddedWidth = item.width + padding_ * 2;
+		const uint32_t paddedHeight = item.height + padding_ * 2;
+
+		// ページより大きいものは詰められない
+		if (item.width == 0 || item.height == 0 || paddedWidth > pageWidth_ || paddedHeight > pageHeight_) {
+			isAllPacked = false;
+			continue;
+		}
+
+		// 入るページのうち最初のものに入れ、どこにも入らなければページを増やす
+		AtlasRect paddedRect;
+		uint32_t page = kInvalidPage;
+		for (uint32_t i = 0; i < pages_.size(); ++i) {
+			if (Insert(pages_[i], paddedWidth, paddedHeight, paddedRect)) {
+				page = i;
+				break;
+			}
+		}
+		if (page == kInvalidPage) {
+			Page& newPage = AddPage();
+			Insert(newPage, paddedWidth, paddedHeight, paddedRect);
+			page = static_cast<uint32_t>(pages_.size() - 1);
+		}
+
+		placements[index].page = page;
+		placements[index].rect = { paddedRect.x + padding_, paddedRect.y + padding_, item.width, item.height };
+	}
+
+	return isAllPacked;
+}
+
+float AtlasPacker::GetOccupancy(uint32_t page) const {
+	if (page >= pages_.size() || pageWidth_ == 0 || pageHeight_ == 0) {
+		return 0.0f;
+	}
+	return static_cast<float>(pages_[page].usedArea) / (static_cast<float>(pageWidth_) * static_cast<float>(pageHeight_));
+}
+
+bool AtlasPacker::Insert(Page& page, uint32_t width, uint32_t height, AtlasRect& result) {
+	// 余りの短辺が最小の空き領域を選ぶ（同じなら長辺、それも同じなら上・左のもの）
+	const AtlasRect* best = nullptr;
+	uint32_t bestShortSide = UINT32_MAX;
+	uint32_t bestLongSide = UINT32_MAX;
+	for (const AtlasRect& freeRect : page.freeRects) {
+		if (width > freeRect.width || height > freeRect.height) {
+			continue;
+		}
+		const uint32_t leftoverX = freeRect.width - width;
+		const uint32_t leftoverY = freeRect.height - height;
+		const uint32_t shortSide = (std::min)(leftoverX, leftoverY);
+		const uint32_t longSide = (std::max)(leftoverX, leftoverY);
+		bool isBetter = false;
+		if (!best || shortSide != bestShortSide) {
+			isBetter = !best || shortSide < bestShortSide;
+		} else if (longSide != bestLongSide) {
+			isBetter = longSide < bestLongSide;
+		} else if (freeRect.y != best->y) {
+			isBetter = freeRect.y < best->y;
+		} else {
+			isBetter = freeRect.x < best->x;
+		}
+		if (isBetter) {
+			best = &freeRect;
+			bestShortSide = shortSide;
+			bestLongSide = longSide;
+		}
+	}
+
+	if (!best) {
+		return false;
+	}
+
+	result = { best->x, best->y, width, height };
+	SplitFreeRects(page, result);
+	PruneFreeRects(page);
+	page.usedArea += static_cast<uint64_t>(width) * height;
+	return true;
+}
+
+void AtlasPacker::SplitFreeRects(Page& page, const AtlasRect& used) {
+	const uint32_t usedRight = used.x + used.width;
+	const uint32_t usedBottom = used.y + used.height;
+
+	std::vector<AtlasRect> newRects;
+	for (size_t i = 0; i < page.freeRects.size();) {
+		const AtlasRect freeRect = page.freeRects[i];
+		const uint32_t freeRight = freeRect.x + freeRect.width;
+		const uint32_t freeBottom = freeRect.y + freeRect.height;
+
+		// 重なっていなければそのまま
+		if (used.x >= freeRight || usedRight <= freeRect.x || used.y >= freeBottom || usedBottom <= freeRect.y) {
+			++i;
+			continue;
+		}
+
+		// 重なった部分を除いた最大4つの領域に分ける（互いに重なってよい）
+		if (used.y > freeRect.y) {
+			newRects.push_back({ freeRect.x, freeRect.y, freeRect.width, used.y - freeRect.y });
+		}
+		if (usedBottom < freeBottom) {
+			newRects.push_back({ freeRect.x, usedBottom, freeRect.width, freeBottom - usedBottom });
+		}
+		if (used.x > freeRect.x) {
+			newRects.push_back({ freeRect.x, freeRect.y, used.x - freeRect.x, freeRect.height });
+		}
+		if (usedRight < freeRight) {
+			newRects.push_back({ usedRight, freeRect.y, freeRight - usedRight, freeRect.height });
+		}
+
+		// 順番を保ったまま取り除く（配置を毎回同じにするため）
+		page.freeRects.erase(page.freeRects.begin() + i);
+	}
+
+	page.freeRects.insert(page.freeRects.end(), newRects.begin(), newRects.end());
+}
+
+void AtlasPacker::PruneFreeRects(Page& page) {
+	auto contains = [](const AtlasRect& outer, const AtlasRect& inner) {
+		return inner.x >= outer.x && inner.y >= outer.y &&
+			inner.x + inner.width <= outer.x + outer.width &&
+			inner.y + inner.height <= outer.y + outer.height;
+	};
+
+	std::vector<AtlasRect>& rects = page.freeRects;
+	std::vector<bool> isRemoved(rects.size(), false);
+	for (size_t i = 0; i < rects.size(); ++i) {
+		if (isRemoved[i]) {
+			continue;
+		}
+		for (size_t j = 0; j < rects.size(); ++j) {
+			if (i == j || isRemoved[j]) {
+				continue;
+			}
+			// 同じ矩形は後ろのものだけを消す
+			if (contains(rects[i], rects[j])) {
+				isRemoved[j] = true;
+			} else if (contains(rects[j], rects[i])) {
+				isRemoved[i] = true;
+				break;
+			}
+		}
+	}
+
+	size_t writeIndex = 0;
+	for (size_t i = 0; i < rects.size(); ++i) {
+		if (!isRemoved[i]) {
+			rects[writeIndex++] = rects[i];
+		}
+	}
+	rects.resize(writeIndex);
+}
+
+AtlasPacker::Page& AtlasPacker::AddPage() {
+	Page& page = pages_.emplace_back();
+	page.freeRects.push_back({ 0, 0, pageWidth_, pageHeight_ });
+	return page;
+}
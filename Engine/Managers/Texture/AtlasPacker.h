@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// アトラス上の矩形（ピクセル単位）
+/// </summary>
+struct AtlasRect {
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+
+	bool operator==(const AtlasRect& other) const = default;
+};
+
+/// <summary>
+/// 小さな画像をアトラスのページに詰める（MaxRects、Best Short Side Fit）
+/// 入力は大きい順に並べ替えてから詰めるので、同じサイズの組み合わせなら入力順に関わらず毎回同じ配置になる
+/// 各画像の周りにpadding分の余白を取る（ミップマップやバイリニア補間で隣の画像がにじまないように）
+/// 画像は回転しない（UVをそのまま使えるように）
+/// </summary>
+class AtlasPacker {
+public:
+	// 詰められなかった画像のページ番号
+	static const uint32_t kInvalidPage = UINT32_MAX;
+
+	/// <summary>
+	/// 詰める画像のサイズ
+	/// </summary>
+	struct Item {
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	/// <summary>
+	/// 詰めた結果（rectは余白を含まない画像そのものの位置）
+	/// </summary>
+	struct Placement {
+		uint32_t page = kInvalidPage;
+		AtlasRect rect;
+	};
+
+	AtlasPacker() = default;
+	~AtlasPacker() = default;
+
+	/// <summary>
+	/// 初期化（ページを全て空にする）
+	/// </summary>
+	/// <param name="pageWidth">ページの幅</param>
+	/// <param name="pageHeight">ページの高さ</param>
+	/// <param name="padding">画像の周りの余白</param>
+	void Initialize(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding = 2);
+
+	/// <summary>
+	/// 画像をまとめて詰める（入っているページに足りなければページを増やす）
+	/// </summary>
+	/// <param name="items">画像のサイズ一覧</param>
+	/// <param name="placements">itemsと同じ順番の配置結果</param>
+	/// <returns>全て詰められたか（ページより大きい画像があるとfalse、その画像はkInvalidPage）</returns>
+	bool Pack(const std::vector<Item>& items, std::vector<Placement>& placements);
+
+	// Getter
+	uint32_t GetPageCount() const { return static_cast<uint32_t>(pages_.size()); }
+	uint32_t GetPageWidth() const { return pageWidth_; }
+	uint32_t GetPageHeight() const { return pageHeight_; }
+	uint32_t GetPadding() const { return padding_; }
+
+	/// <summary>
+	/// ページの使用率（余白を含む使用面積 / ページ面積）
+	/// </summary>
+	float GetOccupancy(uint32_t page) const;
+
+private:
+	/// <summary>
+	/// 1ページ分の空き領域
+	/// </summary>
+	struct Page {
+		std::vector<AtlasRect> freeRects;
+		uint64_t usedArea = 0;
+	};
+
+	/// <summary>
+	/// ページに追加する（入らなければfalse）
+	/// </summary>
+	bool Insert(Page& page, uint32_t width, uint32_t height, AtlasRect& result);
+
+	/// <summary>
+	/// 使った領域と重なる空き領域を分割する
+	/// </summary>
+	static void SplitFreeRects(Page& page, const AtlasRect& used);
+
+	/// <summary>
+	/// 他の空き領域に含まれている空き領域を取り除く
+	/// </summary>
+	static void PruneFreeRects(Page& page);
+
+	/// <summary>
+	/// 新しいページを追加
+	/// </summary>
+	Page& AddPage();
+
+private:
+	uint32_t pageWidth_ = 0;
+	uint32_t pageHeight_ = 0;
+	uint32_t padding_ = 0;
+
+	std::vector<Page> pages_;
+};
@@ -0,0 +1,840 @@
+#include "BlockCompressor.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <emmintrin.h>
+
+namespace {
+
+	// BC1の番号ごとの端点1の重み（番号2は2/3*端点0+1/3*端点1）
+	const float kBC1Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+	// BC7の4bitの番号ごとの端点1の重み（/64）
+	const int kBC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	// 品質ごとの最小二乗での詰め直しの回数
+	uint32_t GetRefineCount(BlockCompressor::Quality quality) {
+		switch (quality) {
+		case BlockCompressor::Quality::High:
+			return 4;
+		case BlockCompressor::Quality::Normal:
+			return 2;
+		case BlockCompressor::Quality::Fast:
+		default:
+			return 0;
+		}
+	}
+
+	/// <summary>
+	/// ブロック内の画素を並べた配列（チャンネルごと）
+	/// </summary>
+	struct Channels {
+		const float* values[4];
+	};
+
+	/// <summary>
+	/// 各画素に一番近いパレットの番号を選び、誤差の合計を返す（4画素ずつSSEで比べる）
+	/// </summary>
+	float SelectIndices(const Channels& channels, const float (*palette)[4], uint32_t paletteCount, uint32_t channelCount, uint32_t* indices) {
+		__m128 total = _mm_setzero_ps();
+		for (uint32_t group = 0; group < 4; ++group) {
+			__m128 pixel[4];
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				pixel[c] = _mm_load_ps(channels.values[c] + group * 4);
+			}
+
+			__m128 bestDistance = _mm_set1_ps(FLT_MAX);
+			__m128i bestIndex = _mm_setzero_si128();
+			for (uint32_t k = 0; k < paletteCount; ++k) {
+				__m128 distance = _mm_setzero_ps();
+				for (uint32_t c = 0; c < channelCount; ++c) {
+					const __m128 difference = _mm_sub_ps(pixel[c], _mm_set1_ps(palette[k][c]));
+					distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+				}
+				// 近いものだけ番号を差し替える
+				const __m128i isCloser = _mm_castps_si128(_mm_cmplt_ps(distance, bestDistance));
+				bestDistance = _mm_min_ps(distance, bestDistance);
+				bestIndex = _mm_or_si128(_mm_and_si128(isCloser, _mm_set1_epi32(static_cast<int>(k))), _mm_andnot_si128(isCloser, bestIndex));
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(indices + group * 4), bestIndex);
+			total = _mm_add_ps(total, bestDistance);
+		}
+
+		alignas(16) float sums[4];
+		_mm_store_ps(sums, total);
+		return sums[0] + sums[1] + sums[2] + sums[3];
+	}
+
+	/// <summary>
+	/// 主成分の軸の両端を端点にする（画素が全て同じなら両端とも平均）
+	/// </summary>
+	void ComputePrincipalEndpoints(const Channels& channels, uint32_t channelCount, float endpoint0[4], float endpoint1[4]) {
+		float mean[4] = {};
+		float minimum[4];
+		float maximum[4];
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			minimum[c] = FLT_MAX;
+			maximum[c] = -FLT_MAX;
+			for (uint32_t i = 0; i < 16; ++i) {
+				const float value = channels.values[c][i];
+				mean[c] += value;
+				minimum[c] = (std::min)(minimum[c], value);
+				maximum[c] = (std::max)(maximum[c], value);
+			}
+			mean[c] /= 16.0f;
+		}
+
+		float covariance[4][4] = {};
+		for (uint32_t i = 0; i < 16; ++i) {
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				const float dc = channels.values[c][i] - mean[c];
+				for (uint32_t d = c; d < channelCount; ++d) {
+					covariance[c][d] += dc * (channels.values[d][i] - mean[d]);
+				}
+			}
+		}
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			for (uint32_t d = 0; d < c; ++d) {
+				covariance[c][d] = covariance[d][c];
+			}
+		}
+
+		// べき乗法で一番広がっている向きを求める（最初は範囲の大きさの向き）
+		float axis[4] = {};
+		float axisLength = 0.0f;
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			axis[c] = maximum[c] - minimum[c];
+			axisLength += axis[c];
+		}
+		if (axisLength == 0.0f) {
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				endpoint0[c] = mean[c];
+				endpoint1[c] = mean[c];
+			}
+			return;
+		}
+		for (int iteration = 0; iteration < 8; ++iteration) {
+			float next[4] = {};
+			float largest = 0.0f;
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				for (uint32_t d = 0; d < channelCount; ++d) {
+					next[c] += covariance[c][d] * axis[d];
+				}
+				largest = (std::max)(largest, std::fabs(next[c]));
+			}
+			if (largest == 0.0f) {
+				break;
+			}
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				axis[c] = next[c] / largest;
+			}
+		}
+		float lengthSquared = 0.0f;
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			lengthSquared += axis[c] * axis[c];
+		}
+		const float inverseLength = 1.0f / std::sqrt(lengthSquared);
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			axis[c] *= inverseLength;
+		}
+
+		// 軸に投影した範囲の両端
+		float minimumT = FLT_MAX;
+		float maximumT = -FLT_MAX;
+		for (uint32_t i = 0; i < 16; ++i) {
+			float t = 0.0f;
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				t += (channels.values[c][i] - mean[c]) * axis[c];
+			}
+			minimumT = (std::min)(minimumT, t);
+			maximumT = (std::max)(maximumT, t);
+		}
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			endpoint0[c] = std::clamp(mean[c] + minimumT * axis[c], 0.0f, 255.0f);
+			endpoint1[c] = std::clamp(mean[c] + maximumT * axis[c], 0.0f, 255.0f);
+		}
+	}
+
+	/// <summary>
+	/// 画素の範囲の箱の対角を端点にする（チャンネル同士が逆向きに変わる場合は向きをそろえる）
+	/// </summary>
+	void ComputeBoxEndpoints(const Channels& channels, uint32_t channelCount, float endpoint0[4], float endpoint1[4]) {
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			endpoint0[c] = FLT_MAX;
+			endpoint1[c] = -FLT_MAX;
+			for (uint32_t i = 0; i < 16; ++i) {
+				endpoint0[c] = (std::min)(endpoint0[c], channels.values[c][i]);
+				endpoint1[c] = (std::max)(endpoint1[c], channels.values[c][i]);
+			}
+		}
+
+		// 最初のチャンネルと逆向きに変わるチャンネルは端点を入れ替える
+		float mean[4] = {};
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			for (uint32_t i = 0; i < 16; ++i) {
+				mean[c] += channels.values[c][i];
+			}
+			mean[c] /= 16.0f;
+		}
+		for (uint32_t c = 1; c < channelCount; ++c) {
+			float covariance = 0.0f;
+			for (uint32_t i = 0; i < 16; ++i) {
+				covariance += (channels.values[0][i] - mean[0]) * (channels.values[c][i] - mean[c]);
+			}
+			if (covariance < 0.0f) {
+				std::swap(endpoint0[c], endpoint1[c]);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 端点を内側に寄せる（両端の色は番号が少ないので、範囲の端まで取ると誤差が増える）
+	/// </summary>
+	void InsetEndpoints(float endpoint0[4], float endpoint1[4], uint32_t channelCount, float amount) {
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			const float inset = (endpoint1[c] - endpoint0[c]) * amount;
+			endpoint0[c] = std::clamp(endpoint0[c] + inset, 0.0f, 255.0f);
+			endpoint1[c] = std::clamp(endpoint1[c] - inset, 0.0f, 255.0f);
+		}
+	}
+
+	/// <summary>
+	/// 番号を固定して、誤差が最小になる端点を最小二乗で求める
+	/// </summary>
+	/// <param name="weights">番号ごとの端点1の重み</param>
+	bool FitEndpoints(const Channels& channels, uint32_t channelCount, const uint32_t* indices, const float* weights,
+		float endpoint0[4], float endpoint1[4]) {
+		float aa = 0.0f;
+		float ab = 0.0f;
+		float bb = 0.0f;
+		float ax[4] = {};
+		float bx[4] = {};
+		for (uint32_t i = 0; i < 16; ++i) {
+			const float b = weights[indices[i]];
+			const float a = 1.0f - b;
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (uint32_t c = 0; c < channelCount; ++c) {
+				ax[c] += a * channels.values[c][i];
+				bx[c] += b * channels.values[c][i];
+			}
+		}
+
+		// 全ての画素が同じ番号だと解けない
+		const float determinant = aa * bb - ab * ab;
+		if (std::fabs(determinant) < 1e-6f) {
+			return false;
+		}
+		const float inverse = 1.0f / determinant;
+		for (uint32_t c = 0; c < channelCount; ++c) {
+			endpoint0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inverse, 0.0f, 255.0f);
+			endpoint1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inverse, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	///*-----------------------------------------------------------------------*///
+	//								BC1の色											//
+	///*-----------------------------------------------------------------------*///
+
+	uint16_t Pack565(const float color[4]) {
+		const uint32_t r = static_cast<uint32_t>(color[0] * 31.0f / 255.0f + 0.5f);
+		const uint32_t g = static_cast<uint32_t>(color[1] * 63.0f / 255.0f + 0.5f);
+		const uint32_t b = static_cast<uint32_t>(color[2] * 31.0f / 255.0f + 0.5f);
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	void Unpack565(uint16_t packed, int color[3]) {
+		const int r = (packed >> 11) & 0x1F;
+		const int g = (packed >> 5) & 0x3F;
+		const int b = packed & 0x1F;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	// 4色のパレット（端点の大小に関わらず4色として扱う。書く時に大小をそろえる）
+	void BuildBC1Palette(uint16_t color0, uint16_t color1, int palette[4][3]) {
+		Unpack565(color0, palette[0]);
+		Unpack565(color1, palette[1]);
+		for (int c = 0; c < 3; ++c) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+		}
+	}
+
+	///*-----------------------------------------------------------------------*///
+	//								BC4の1チャンネル									//
+	///*-----------------------------------------------------------------------*///
+
+	// a0 > a1なら間を7等分した8段、そうでなければ5等分した6段と0・255
+	void BuildBC4Palette(int value0, int value1, int palette[8]) {
+		palette[0] = value0;
+		palette[1] = value1;
+		if (value0 > value1) {
+			for (int i = 1; i <= 6; ++i) {
+				palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+			}
+		} else {
+			for (int i = 1; i <= 4; ++i) {
+				palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+	///*-----------------------------------------------------------------------*///
+	//								BC7（モード6）									//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// 7bitの値とpビット（値は(q << 1) | p）
+	/// </summary>
+	struct BC7Endpoint {
+		int q[4] = {};
+		int p = 0;
+
+		int Get(int channel) const { return (q[channel] << 1) | p; }
+	};
+
+	// pビットを決めて量子化（forcedPが負なら誤差の小さい方）
+	BC7Endpoint QuantizeBC7Endpoint(const float endpoint[4], int forcedP) {
+		BC7Endpoint best;
+		float bestError = FLT_MAX;
+		for (int p = 0; p <= 1; ++p) {
+			if (forcedP >= 0 && p != forcedP) {
+				continue;
+			}
+			BC7Endpoint candidate;
+			candidate.p = p;
+			float error = 0.0f;
+			for (int c = 0; c < 4; ++c) {
+				candidate.q[c] = std::clamp(static_cast<int>(std::lround((endpoint[c] - static_cast<float>(p)) * 0.5f)), 0, 127);
+				const float difference = static_cast<float>(candidate.Get(c)) - endpoint[c];
+				error += difference * difference;
+			}
+			if (error < bestError) {
+				bestError = error;
+				best = candidate;
+			}
+		}
+		return best;
+	}
+
+	void BuildBC7Palette(const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, int palette[16][4]) {
+		for (int k = 0; k < 16; ++k) {
+			for (int c = 0; c < 4; ++c) {
+				palette[k][c] = ((64 - kBC7Weights[k]) * endpoint0.Get(c) + kBC7Weights[k] * endpoint1.Get(c) + 32) >> 6;
+			}
+		}
+	}
+
+	/// <summary>
+	/// 下位ビットから順に詰める
+	/// </summary>
+	struct BitWriter {
+		uint8_t* output;
+		uint32_t position = 0;
+
+		void Write(uint32_t value, uint32_t bitCount) {
+			for (uint32_t i = 0; i < bitCount; ++i, ++position) {
+				if ((value >> i) & 1) {
+					output[position >> 3] |= static_cast<uint8_t>(1u << (position & 7));
+				}
+			}
+		}
+	};
+	struct BitReader {
+		const uint8_t* input;
+		uint32_t position = 0;
+
+		uint32_t Read(uint32_t bitCount) {
+			uint32_t value = 0;
+			for (uint32_t i = 0; i < bitCount; ++i, ++position) {
+				value |= static_cast<uint32_t>((input[position >> 3] >> (position & 7)) & 1) << i;
+			}
+			return value;
+		}
+	};
+}
+
+size_t BlockCompressor::ComputeCompressedSize(Format format, uint32_t width, uint32_t height) {
+	return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+}
+
+uint32_t BlockCompressor::GetChannelMask(Format format) {
+	switch (format) {
+	case Format::BC1:
+		return 0x7;
+	case Format::BC5:
+		return 0x3;
+	case Format::BC3:
+	case Format::BC7:
+	default:
+		return 0xF;
+	}
+}
+
+bool BlockCompressor::Compress(const SourceImage& source, const Settings& settings, std::vector<uint8_t>& blocks) {
+	if (!source.pixels || source.width == 0 || source.height == 0) {
+		return false;
+	}
+
+	const uint32_t blockCountX = (source.width + 3) / 4;
+	const uint32_t blockCountY = (source.height + 3) / 4;
+	const size_t blockSize = GetBlockSize(settings.format);
+	blocks.assign(static_cast<size_t>(blockCountX) * blockCountY * blockSize, 0);
+
+	// ブロックの1行ごとに処理する（行同士は独立）
+	auto encodeRow = [&](uint32_t blockY) {
+		Block block;
+		for (uint32_t blockX = 0; blockX < blockCountX; ++blockX) {
+			LoadBlock(source, blockX, blockY, block);
+			uint8_t* output = blocks.data() + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockSize;
+			switch (settings.format) {
+			case Format::BC1:
+				EncodeBC1(block, settings.quality, output);
+				break;
+			case Format::BC3:
+				EncodeBC4(block.a, settings.quality, output);
+				EncodeBC1(block, settings.quality, output + 8);
+				break;
+			case Format::BC5:
+				EncodeBC4(block.r, settings.quality, output);
+				EncodeBC4(block.g, settings.quality, output + 8);
+				break;
+			case Format::BC7:
+				EncodeBC7(block, settings.quality, output);
+				break;
+			}
+		}
+	};
+
+	if (settings.isParallel && blockCountY > 1) {
+		ThreadPool::GetInstance()->ParallelFor(blockCountY, encodeRow);
+	} else {
+		for (uint32_t blockY = 0; blockY < blockCountY; ++blockY) {
+			encodeRow(blockY);
+		}
+	}
+	return true;
+}
+
+void BlockCompressor::LoadBlock(const SourceImage& source, uint32_t blockX, uint32_t blockY, Block& block) {
+	for (uint32_t y = 0; y < 4; ++y) {
+		const uint32_t sourceY = (std::min)(blockY * 4 + y, source.height - 1);
+		const uint8_t* row = source.pixels + sourceY * source.rowPitch;
+		for (uint32_t x = 0; x < 4; ++x) {
+			const uint8_t* pixel = row + (std::min)(blockX * 4 + x, source.width - 1) * 4;
+			const uint32_t i = y * 4 + x;
+			block.r[i] = pixel[0];
+			block.g[i] = pixel[1];
+			block.b[i] = pixel[2];
+			block.a[i] = pixel[3];
+		}
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//								圧縮												//
+///*-----------------------------------------------------------------------*///
+
+void BlockCompressor::EncodeBC1(const Block& block, Quality quality, uint8_t* output) {
+	const Channels channels = { { block.r, block.g, block.b, block.a } };
+
+	struct Candidate {
+		uint16_t color0 = 0;
+		uint16_t color1 = 0;
+		uint32_t indices[16] = {};
+		float error = FLT_MAX;
+	};
+	auto evaluate = [&channels](const float endpoint0[4], const float endpoint1[4], Candidate& candidate) {
+		candidate.color0 = Pack565(endpoint0);
+		candidate.color1 = Pack565(endpoint1);
+		int palette[4][3];
+		BuildBC1Palette(candidate.color0, candidate.color1, palette);
+		float paletteFloat[4][4] = {};
+		for (int k = 0; k < 4; ++k) {
+			for (int c = 0; c < 3; ++c) {
+				paletteFloat[k][c] = static_cast<float>(palette[k][c]);
+			}
+		}
+		candidate.error = SelectIndices(channels, paletteFloat, 4, 3, candidate.indices);
+	};
+
+	// 主成分の軸の両端を少し内側に寄せたものから始める
+	float endpoint0[4];
+	float endpoint1[4];
+	ComputePrincipalEndpoints(channels, 3, endpoint0, endpoint1);
+	InsetEndpoints(endpoint0, endpoint1, 3, 1.0f / 16.0f);
+	Candidate best;
+	evaluate(endpoint0, endpoint1, best);
+
+	if (quality == Quality::High) {
+		Candidate candidate;
+		ComputeBoxEndpoints(channels, 3, endpoint0, endpoint1);
+		InsetEndpoints(endpoint0, endpoint1, 3, 1.0f / 16.0f);
+		evaluate(endpoint0, endpoint1, candidate);
+		if (candidate.error < best.error) {
+			best = candidate;
+		}
+	}
+
+	// 選んだ番号から端点を詰め直し、良くならなくなったらやめる
+	for (uint32_t refine = 0; refine < GetRefineCount(quality); ++refine) {
+		if (!FitEndpoints(channels, 3, best.indices, kBC1Weights, endpoint0, endpoint1)) {
+			break;
+		}
+		Candidate candidate;
+		evaluate(endpoint0, endpoint1, candidate);
+		if (candidate.error >= best.error) {
+			break;
+		}
+		best = candidate;
+	}
+
+	// 4色として読まれるようにcolor0 > color1にそろえる（入れ替えたら番号も0<->1、2<->3）
+	if (best.color0 < best.color1) {
+		std::swap(best.color0, best.color1);
+		for (uint32_t& index : best.indices) {
+			index ^= 1;
+		}
+	} else if (best.color0 == best.color1) {
+		std::fill(std::begin(best.indices), std::end(best.indices), 0u);
+	}
+
+	output[0] = static_cast<uint8_t>(best.color0 & 0xFF);
+	output[1] = static_cast<uint8_t>(best.color0 >> 8);
+	output[2] = static_cast<uint8_t>(best.color1 & 0xFF);
+	output[3] = static_cast<uint8_t>(best.color1 >> 8);
+	uint32_t bits = 0;
+	for (uint32_t i = 0; i < 16; ++i) {
+		bits |= best.indices[i] << (i * 2);
+	}
+	std::memcpy(output + 4, &bits, sizeof(bits));
+}
+
+void BlockCompressor::EncodeBC4(const float* values, Quality quality, uint8_t* output) {
+	int minimum = 255;
+	int maximum = 0;
+	for (uint32_t i = 0; i < 16; ++i) {
+		const int value = static_cast<int>(values[i]);
+		minimum = (std::min)(minimum, value);
+		maximum = (std::max)(maximum, value);
+	}
+
+	uint32_t bestIndices[16] = {};
+	int bestValue0 = maximum;
+	int bestValue1 = minimum;
+	int bestError = INT32_MAX;
+	auto evaluate = [&](int value0, int value1) {
+		int palette[8];
+		BuildBC4Palette(value0, value1, palette);
+		uint32_t indices[16];
+		int error = 0;
+		for (uint32_t i = 0; i < 16; ++i) {
+			const int value = static_cast<int>(values[i]);
+			int nearest = INT32_MAX;
+			for (uint32_t k = 0; k < 8; ++k) {
+				const int difference = std::abs(palette[k] - value);
+				if (difference < nearest) {
+					nearest = difference;
+					indices[i] = k;
+				}
+			}
+			error += nearest * nearest;
+		}
+		if (error < bestError) {
+			bestError = error;
+			bestValue0 = value0;
+			bestValue1 = value1;
+			std::memcpy(bestIndices, indices, sizeof(indices));
+		}
+	};
+
+	// 最大と最小を端点にした8段
+	evaluate(maximum, minimum);
+
+	if (quality != Quality::Fast && maximum - minimum > 2) {
+		// 端点を少し内側に寄せたもの
+		for (int inset0 = 0; inset0 <= 2; ++inset0) {
+			for (int inset1 = 0; inset1 <= 2; ++inset1) {
+				if (inset0 + inset1 > 0 && (quality == Quality::High || inset0 == inset1)) {
+					evaluate(maximum - inset0, minimum + inset1);
+				}
+			}
+		}
+	}
+
+	if (quality == Quality::High) {
+		// 0と255がそのまま出せる6段（両端の値を除いた範囲を端点にする）
+		int innerMinimum = 255;
+		int innerMaximum = 0;
+		for (uint32_t i = 0; i < 16; ++i) {
+			const int value = static_cast<int>(values[i]);
+			if (value != 0 && value != 255) {
+				innerMinimum = (std::min)(innerMinimum, value);
+				innerMaximum = (std::max)(innerMaximum, value);
+			}
+		}
+		if (innerMinimum <= innerMaximum) {
+			evaluate(innerMinimum, innerMaximum);
+		}
+	}
+
+	output[0] = static_cast<uint8_t>(bestValue0);
+	output[1] = static_cast<uint8_t>(bestValue1);
+	uint64_t bits = 0;
+	for (uint32_t i = 0; i < 16; ++i) {
+		bits |= static_cast<uint64_t>(bestIndices[i]) << (i * 3);
+	}
+	for (uint32_t i = 0; i < 6; ++i) {
+		output[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+	}
+}
+
+void BlockCompressor::EncodeBC7(const Block& block, Quality quality, uint8_t* output) {
+	const Channels channels = { { block.r, block.g, block.b, block.a } };
+	float weights[16];
+	for (int k = 0; k < 16; ++k) {
+		weights[k] = static_cast<float>(kBC7Weights[k]) / 64.0f;
+	}
+
+	struct Candidate {
+		BC7Endpoint endpoint0;
+		BC7Endpoint endpoint1;
+		uint32_t indices[16] = {};
+		float error = FLT_MAX;
+	};
+	auto evaluateQuantized = [&channels](const BC7Endpoint& endpoint0, const BC7Endpoint& endpoint1, Candidate& candidate) {
+		candidate.endpoint0 = endpoint0;
+		candidate.endpoint1 = endpoint1;
+		int palette[16][4];
+		BuildBC7Palette(endpoint0, endpoint1, palette);
+		float paletteFloat[16][4];
+		for (int k = 0; k < 16; ++k) {
+			for (int c = 0; c < 4; ++c) {
+				paletteFloat[k][c] = static_cast<float>(palette[k][c]);
+			}
+		}
+		candidate.error = SelectIndices(channels, paletteFloat, 16, 4, candidate.indices);
+	};
+	// 高品質ではpビットの組み合わせを全て試す
+	auto evaluate = [&](const float endpoint0[4], const float endpoint1[4], Candidate& candidate) {
+		evaluateQuantized(QuantizeBC7Endpoint(endpoint0, -1), QuantizeBC7Endpoint(endpoint1, -1), candidate);
+		if (quality == Quality::High) {
+			for (int p0 = 0; p0 <= 1; ++p0) {
+				for (int p1 = 0; p1 <= 1; ++p1) {
+					Candidate forced;
+					evaluateQuantized(QuantizeBC7Endpoint(endpoint0, p0), QuantizeBC7Endpoint(endpoint1, p1), forced);
+					if (forced.error < candidate.error) {
+						candidate = forced;
+					}
+				}
+			}
+		}
+	};
+
+	float endpoint0[4];
+	float endpoint1[4];
+	ComputePrincipalEndpoints(channels, 4, endpoint0, endpoint1);
+	Candidate best;
+	evaluate(endpoint0, endpoint1, best);
+
+	if (quality == Quality::High) {
+		Candidate candidate;
+		ComputeBoxEndpoints(channels, 4, endpoint0, endpoint1);
+		evaluate(endpoint0, endpoint1, candidate);
+		if (candidate.error < best.error) {
+			best = candidate;
+		}
+	}
+
+	for (uint32_t refine = 0; refine < GetRefineCount(quality); ++refine) {
+		if (!FitEndpoints(channels, 4, best.indices, weights, endpoint0, endpoint1)) {
+			break;
+		}
+		Candidate candidate;
+		evaluate(endpoint0, endpoint1, candidate);
+		if (candidate.error >= best.error) {
+			break;
+		}
+		best = candidate;
+	}
+
+	// 最初の画素の番号は最上位ビットを省くので、8以上なら端点を入れ替えて番号を反転する
+	if (best.indices[0] >= 8) {
+		std::swap(best.endpoint0, best.endpoint1);
+		for (uint32_t& index : best.indices) {
+			index = 15 - index;
+		}
+	}
+
+	std::memset(output, 0, 16);
+	BitWriter writer{ output };
+	writer.Write(1u << 6, 7);	// モード6
+	for (int c = 0; c < 4; ++c) {
+		writer.Write(static_cast<uint32_t>(best.endpoint0.q[c]), 7);
+		writer.Write(static_cast<uint32_t>(best.endpoint1.q[c]), 7);
+	}
+	writer.Write(static_cast<uint32_t>(best.endpoint0.p), 1);
+	writer.Write(static_cast<uint32_t>(best.endpoint1.p), 1);
+	writer.Write(best.indices[0], 3);
+	for (uint32_t i = 1; i < 16; ++i) {
+		writer.Write(best.indices[i], 4);
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//								展開と画質										//
+///*-----------------------------------------------------------------------*///
+
+void BlockCompressor::Decompress(Format format, const uint8_t* blocks, uint32_t width, uint32_t height, std::vector<uint8_t>& pixels) {
+	pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+	const uint32_t blockCountX = (width + 3) / 4;
+	const uint32_t blockCountY = (height + 3) / 4;
+	const size_t blockSize = GetBlockSize(format);
+
+	uint8_t decoded[16 * 4];
+	for (uint32_t blockY = 0; blockY < blockCountY; ++blockY) {
+		for (uint32_t blockX = 0; blockX < blockCountX; ++blockX) {
+			const uint8_t* input = blocks + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockSize;
+			switch (format) {
+			case Format::BC1:
+				DecodeBC1(input, decoded, false);
+				break;
+			case Format::BC3:
+				DecodeBC1(input + 8, decoded, true);
+				DecodeBC4(input, decoded, 3);
+				break;
+			case Format::BC5:
+				for (uint32_t i = 0; i < 16; ++i) {
+					decoded[i * 4 + 2] = 0;
+					decoded[i * 4 + 3] = 255;
+				}
+				DecodeBC4(input, decoded, 0);
+				DecodeBC4(input + 8, decoded, 1);
+				break;
+			case Format::BC7:
+				DecodeBC7(input, decoded);
+				break;
+			}
+
+			// 画像の外にはみ出した分は捨てる
+			for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; ++y) {
+				for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; ++x) {
+					std::memcpy(pixels.data() + ((static_cast<size_t>(blockY) * 4 + y) * width + blockX * 4 + x) * 4, decoded + (y * 4 + x) * 4, 4);
+				}
+			}
+		}
+	}
+}
+
+void BlockCompressor::DecodeBC1(const uint8_t* input, uint8_t* pixels, bool isFourColorOnly) {
+	const uint16_t color0 = static_cast<uint16_t>(input[0] | (input[1] << 8));
+	const uint16_t color1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+	int palette[4][4];
+	Unpack565(color0, palette[0]);
+	Unpack565(color1, palette[1]);
+	palette[0][3] = 255;
+	palette[1][3] = 255;
+	if (color0 > color1 || isFourColorOnly) {
+		for (int c = 0; c < 3; ++c) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+		}
+		palette[2][3] = 255;
+		palette[3][3] = 255;
+	} else {
+		// 3色と透明な黒
+		for (int c = 0; c < 3; ++c) {
+			palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+			palette[3][c] = 0;
+		}
+		palette[2][3] = 255;
+		palette[3][3] = 0;
+	}
+
+	uint32_t bits;
+	std::memcpy(&bits, input + 4, sizeof(bits));
+	for (uint32_t i = 0; i < 16; ++i) {
+		const uint32_t index = (bits >> (i * 2)) & 3;
+		for (int c = 0; c < 4; ++c) {
+			pixels[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+		}
+	}
+}
+
+void BlockCompressor::DecodeBC4(const uint8_t* input, uint8_t* pixels, uint32_t channel) {
+	int palette[8];
+	BuildBC4Palette(input[0], input[1], palette);
+	uint64_t bits = 0;
+	for (uint32_t i = 0; i < 6; ++i) {
+		bits |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+	}
+	for (uint32_t i = 0; i < 16; ++i) {
+		pixels[i * 4 + channel] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+	}
+}
+
+void BlockCompressor::DecodeBC7(const uint8_t* input, uint8_t* pixels) {
+	BitReader reader{ input };
+
+	// 最初に立っているビットの位置がモード
+	uint32_t mode = 0;
+	while (mode < 8 && reader.Read(1) == 0) {
+		++mode;
+	}
+	if (mode != 6) {
+		// このエンコーダーはモード6しか書かない
+		std::memset(pixels, 0, 16 * 4);
+		return;
+	}
+
+	BC7Endpoint endpoint0;
+	BC7Endpoint endpoint1;
+	for (int c = 0; c < 4; ++c) {
+		endpoint0.q[c] = static_cast<int>(reader.Read(7));
+		endpoint1.q[c] = static_cast<int>(reader.Read(7));
+	}
+	endpoint0.p = static_cast<int>(reader.Read(1));
+	endpoint1.p = static_cast<int>(reader.Read(1));
+
+	int palette[16][4];
+	BuildBC7Palette(endpoint0, endpoint1, palette);
+	for (uint32_t i = 0; i < 16; ++i) {
+		const uint32_t index = reader.Read(i == 0 ? 3 : 4);
+		for (int c = 0; c < 4; ++c) {
+			pixels[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+		}
+	}
+}
+
+double BlockCompressor::ComputePSNR(const uint8_t* a, size_t rowPitchA, const uint8_t* b, size_t rowPitchB,
+	uint32_t width, uint32_t height, uint32_t channelMask) {
+	uint64_t squaredError = 0;
+	uint64_t sampleCount = 0;
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* rowA = a + y * rowPitchA;
+		const uint8_t* rowB = b + y * rowPitchB;
+		for (uint32_t x = 0; x < width; ++x) {
+			for (uint32_t c = 0; c < 4; ++c) {
+				if (channelMask & (1u << c)) {
+					const int difference = static_cast<int>(rowA[x * 4 + c]) - static_cast<int>(rowB[x * 4 + c]);
+					squaredError += static_cast<uint64_t>(difference * difference);
+					++sampleCount;
+				}
+			}
+		}
+	}
+	if (squaredError == 0 || sampleCount == 0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	const double meanSquaredError = static_cast<double>(squaredError) / static_cast<double>(sampleCount);
+	return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// RGBA8の画像をBC1/BC3/BC5/BC7に圧縮する（D3D・DirectXTexに依存しないので、ビルドマシンなどでも単体で動かせる）
+/// 4x4のブロックごとに端点を選んで各画素の番号を決める。番号選びはSSEで4画素ずつまとめて距離を比べる
+/// ブロックの行をThreadPoolで並列に処理する
+/// BC7はモード6（1組の端点、RGBA各7bit+pビット、4bitの番号）だけを使う
+/// </summary>
+class BlockCompressor {
+public:
+	/// <summary>
+	/// 圧縮の形式
+	/// </summary>
+	enum class Format {
+		BC1,	// RGB、4bit/画素（アルファは捨てる）
+		BC3,	// RGBA、8bit/画素（RGBはBC1、アルファはBC4と同じ形）
+		BC5,	// RG、8bit/画素（法線マップ向け、BとAは捨てる）
+		BC7,	// RGBA、8bit/画素（BC1・BC3より高画質）
+	};
+
+	/// <summary>
+	/// 圧縮の品質（高いほど端点の候補と詰め直しの回数が増えて遅くなる）
+	/// </summary>
+	enum class Quality {
+		Fast,	// 主成分の軸の両端を端点にするだけ
+		Normal,	// Fastに加えて、最小二乗で2回まで詰め直す
+		High,	// Normalに加えて箱の対角やpビットの組み合わせも試し、詰め直しを4回まで増やす
+	};
+
+	/// <summary>
+	/// 圧縮する画像（RGBA8、sRGBかどうかは圧縮には関係しない）
+	/// </summary>
+	struct SourceImage {
+		const uint8_t* pixels = nullptr;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		size_t rowPitch = 0;
+	};
+
+	/// <summary>
+	/// 圧縮の設定
+	/// </summary>
+	struct Settings {
+		Format format = Format::BC7;
+		Quality quality = Quality::Normal;
+		bool isParallel = true;		// ThreadPoolでブロックの行を並列に処理するか
+	};
+
+	/// <summary>
+	/// 1ブロック（4x4画素）のバイト数
+	/// </summary>
+	static size_t GetBlockSize(Format format) { return format == Format::BC1 ? 8 : 16; }
+
+	/// <summary>
+	/// 圧縮後のバイト数
+	/// </summary>
+	static size_t ComputeCompressedSize(Format format, uint32_t width, uint32_t height);
+
+	/// <summary>
+	/// 比べる意味のあるチャンネル（ビットごとにR,G,B,A）
+	/// </summary>
+	static uint32_t GetChannelMask(Format format);
+
+	/// <summary>
+	/// 画像を圧縮する（端の足りない画素は端の画素を繰り返す）
+	/// </summary>
+	/// <param name="source">元の画像</param>
+	/// <param name="settings">設定</param>
+	/// <param name="blocks">圧縮したブロック（左上から行ごと）</param>
+	/// <returns>圧縮できたかどうか</returns>
+	static bool Compress(const SourceImage& source, const Settings& settings, std::vector<uint8_t>& blocks);
+
+	/// <summary>
+	/// 圧縮したブロックをRGBA8に戻す（画質の確認用。BC7はモード6のみ）
+	/// </summary>
+	/// <param name="format">形式</param>
+	/// <param name="blocks">圧縮したブロック</param>
+	/// <param name="width">画像の幅</param>
+	/// <param name="height">画像の高さ</param>
+	/// <param name="pixels">戻した画像（行は詰めて置く）</param>
+	static void Decompress(Format format, const uint8_t* blocks, uint32_t width, uint32_t height, std::vector<uint8_t>& pixels);
+
+	/// <summary>
+	/// 2つのRGBA8画像のPSNR（dB、channelMaskのチャンネルだけで比べる。一致していれば無限大）
+	/// </summary>
+	static double ComputePSNR(const uint8_t* a, size_t rowPitchA, const uint8_t* b, size_t rowPitchB,
+		uint32_t width, uint32_t height, uint32_t channelMask);
+
+private:
+	BlockCompressor() = delete;
+	~BlockCompressor() = delete;
+
+	/// <summary>
+	/// 4x4画素をチャンネルごとに並べたもの（SSEで4画素ずつ読めるように）
+	/// </summary>
+	struct Block {
+		alignas(16) float r[16];
+		alignas(16) float g[16];
+		alignas(16) float b[16];
+		alignas(16) float a[16];
+	};
+
+	/// <summary>
+	/// 画像からブロックを取り出す
+	/// </summary>
+	static void LoadBlock(const SourceImage& source, uint32_t blockX, uint32_t blockY, Block& block);
+
+	/// <summary>
+	/// ブロックを圧縮する
+	/// </summary>
+	static void EncodeBC1(const Block& block, Quality quality, uint8_t* output);
+	static void EncodeBC4(const float* values, Quality quality, uint8_t* output);
+	static void EncodeBC7(const Block& block, Quality quality, uint8_t* output);
+
+	/// <summary>
+	/// ブロックを戻す（RGBAを16画素分）
+	/// </summary>
+	static void DecodeBC1(const uint8_t* input, uint8_t* pixels, bool isFourColorOnly);
+	static void DecodeBC4(const uint8_t* input, uint8_t* pixels, uint32_t channel);
+	static void DecodeBC7(const uint8_t* input, uint8_t* pixels);
+};
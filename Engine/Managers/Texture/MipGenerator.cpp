@@ -0,0 +1,461 @@
+#include "MipGenerator.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+namespace {
+
+	// 1つの並列処理で受け持つ画素数の目安（小さい段は分けずにその場で処理する）
+	const uint32_t kPixelsPerBand = 64 * 1024;
+
+	// Kaiser窓の形（大きいほど裾が小さくなり、ぼやけ寄りになる）
+	const float kKaiserAlpha = 4.0f;
+
+	// sRGBに戻す表の細かさ（線形の値をこの段数に量子化して引く）
+	const uint32_t kSrgbEncodeTableSize = 16384;
+
+	const float kPi = 3.14159265358979f;
+
+	float Sinc(float x) {
+		if (std::fabs(x) < 1e-6f) {
+			return 1.0f;
+		}
+		const float px = kPi * x;
+		return std::sin(px) / px;
+	}
+
+	// 第1種変形ベッセル関数I0（級数で求める）
+	float BesselI0(float x) {
+		float sum = 1.0f;
+		float term = 1.0f;
+		const float halfX = x * 0.5f;
+		for (int k = 1; k < 32; ++k) {
+			term *= (halfX / static_cast<float>(k)) * (halfX / static_cast<float>(k));
+			sum += term;
+			if (term < sum * 1e-8f) {
+				break;
+			}
+		}
+		return sum;
+	}
+
+	// 8bitのsRGB → 線形
+	const float* GetSrgbDecodeTable() {
+		static const std::vector<float> table = []() {
+			std::vector<float> result(256);
+			for (uint32_t i = 0; i < 256; ++i) {
+				const float value = static_cast<float>(i) / 255.0f;
+				result[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+			}
+			return result;
+		}();
+		return table.data();
+	}
+
+	// 線形 → 8bitのsRGB
+	const uint8_t* GetSrgbEncodeTable() {
+		static const std::vector<uint8_t> table = []() {
+			std::vector<uint8_t> result(kSrgbEncodeTableSize);
+			for (uint32_t i = 0; i < kSrgbEncodeTableSize; ++i) {
+				const float value = static_cast<float>(i) / static_cast<float>(kSrgbEncodeTableSize - 1);
+				const float srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+				result[i] = static_cast<uint8_t>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+			}
+			return result;
+		}();
+		return table.data();
+	}
+
+	// 半精度 → 単精度
+	float HalfToFloat(uint16_t half) {
+		const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+		uint32_t exponent = (half >> 10) & 0x1F;
+		uint32_t mantissa = half & 0x3FF;
+		uint32_t bits = 0;
+		if (exponent == 0) {
+			if (mantissa != 0) {
+				// 非正規化数は正規化し直す
+				exponent = 127 - 15 + 1;
+				while ((mantissa & 0x400) == 0) {
+					mantissa <<= 1;
+					--exponent;
+				}
+				mantissa &= 0x3FF;
+				bits = sign | (exponent << 23) | (mantissa << 13);
+			} else {
+				bits = sign;
+			}
+		} else if (exponent == 0x1F) {
+			bits = sign | 0x7F800000 | (mantissa << 13);
+		} else {
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+		}
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	// 単精度 → 半精度（最近接偶数への丸め）
+	uint16_t FloatToHalf(float value) {
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		const uint32_t absolute = bits & 0x7FFFFFFF;
+
+		if (absolute >= 0x7F800000) {
+			// 無限大とNaN
+			return sign | 0x7C00 | (absolute > 0x7F800000 ? 0x200 : 0);
+		}
+		if (absolute >= 0x477FF000) {
+			// 半精度の最大値を超えるものは無限大
+			return sign | 0x7C00;
+		}
+		if (absolute < 0x38800000) {
+			// 非正規化数（小さすぎるものは0）
+			if (absolute < 0x33000000) {
+				return sign;
+			}
+			const uint32_t exponent = absolute >> 23;
+			const uint32_t mantissa = (absolute & 0x7FFFFF) | 0x800000;
+			const uint32_t shift = 126 - exponent;
+			uint32_t result = mantissa >> shift;
+			const uint32_t remainder = mantissa & ((1u << shift) - 1);
+			const uint32_t halfway = 1u << (shift - 1);
+			if (remainder > halfway || (remainder == halfway && (result & 1))) {
+				++result;
+			}
+			return sign | static_cast<uint16_t>(result);
+		}
+		uint32_t result = absolute - 0x38000000;
+		result = (result + 0x0FFF + ((result >> 13) & 1)) >> 13;
+		return sign | static_cast<uint16_t>(result);
+	}
+}
+
+uint32_t MipGenerator::ComputeMipLevels(uint32_t width, uint32_t height) {
+	uint32_t levels = 1;
+	while (width > 1 || height > 1) {
+		width = (std::max)(width >> 1, 1u);
+		height = (std::max)(height >> 1, 1u);
+		++levels;
+	}
+	return levels;
+}
+
+size_t MipGenerator::GetPixelSize(Format format) {
+	return format == Format::RGBA16Float ? 8 : 4;
+}
+
+template<typename Function>
+void MipGenerator::ForEachRowBand(uint32_t width, uint32_t height, bool isParallel, const Function& function) {
+	const uint32_t rowsPerBand = (std::max)(kPixelsPerBand / (std::max)(width, 1u), 1u);
+	const uint32_t bandCount = (height + rowsPerBand - 1) / rowsPerBand;
+	auto processBand = [&](uint32_t band) {
+		const uint32_t beginRow = band * rowsPerBand;
+		function(beginRow, (std::min)(beginRow + rowsPerBand, height));
+	};
+
+	if (isParallel && bandCount > 1) {
+		ThreadPool::GetInstance()->ParallelFor(bandCount, processBand);
+	} else {
+		for (uint32_t band = 0; band < bandCount; ++band) {
+			processBand(band);
+		}
+	}
+}
+
+bool MipGenerator::Generate(const SourceImage& source, const Options& options, MipChain& result) {
+	if (!source.pixels || source.width == 0 || source.height == 0) {
+		return false;
+	}
+
+	const size_t pixelSize = GetPixelSize(source.format);
+	const uint32_t maxLevels = ComputeMipLevels(source.width, source.height);
+	const uint32_t levelCount = options.mipLevels == 0 ? maxLevels : (std::min)(options.mipLevels, maxLevels);
+
+	// 全ての段の置き場所を先に決める（行は詰めて置く）
+	result.format = source.format;
+	result.levels.resize(levelCount);
+	size_t totalSize = 0;
+	uint32_t width = source.width;
+	uint32_t height = source.height;
+	for (Level& level : result.levels) {
+		level.width = width;
+		level.height = height;
+		level.rowPitch = width * pixelSize;
+		level.offset = totalSize;
+		totalSize += level.rowPitch * height;
+		width = (std::max)(width >> 1, 1u);
+		height = (std::max)(height >> 1, 1u);
+	}
+	result.pixels.resize(totalSize);
+
+	// 1段目は元の画像をそのまま
+	const Level& top = result.levels[0];
+	for (uint32_t y = 0; y < top.height; ++y) {
+		std::memcpy(result.GetPixels(0) + y * top.rowPitch, static_cast<const uint8_t*>(source.pixels) + y * source.rowPitch, top.rowPitch);
+	}
+	if (levelCount == 1) {
+		return true;
+	}
+
+	// 線形のfloat4に直す
+	LinearImage previous;
+	previous.width = source.width;
+	previous.height = source.height;
+	previous.pixels.resize(static_cast<size_t>(previous.width) * previous.height * 4);
+	ForEachRowBand(previous.width, previous.height, options.isParallel, [&](uint32_t beginRow, uint32_t endRow) {
+		DecodeRows(source, previous, beginRow, endRow);
+	});
+
+	// 1つ上の段から順に縮める
+	LinearImage current;
+	for (uint32_t levelIndex = 1; levelIndex < levelCount; ++levelIndex) {
+		const Level& level = result.levels[levelIndex];
+		current.width = level.width;
+		current.height = level.height;
+		current.pixels.resize(static_cast<size_t>(current.width) * current.height * 4);
+
+		// Boxでちょうど半分になる時は2x2の平均だけで済む
+		const bool isExactHalf = previous.width == current.width * 2 && previous.height == current.height * 2;
+		if (options.filter == Filter::Box && isExactHalf) {
+			ForEachRowBand(current.width, current.height, options.isParallel, [&](uint32_t beginRow, uint32_t endRow) {
+				HalveRows(previous, current, beginRow, endRow);
+			});
+		} else {
+			const FilterTable horizontal = BuildFilterTable(options.filter, previous.width, current.width);
+			const FilterTable vertical = BuildFilterTable(options.filter, previous.height, current.height);
+			ForEachRowBand(previous.width, current.height, options.isParallel, [&](uint32_t beginRow, uint32_t endRow) {
+				ResampleRows(previous, current, horizontal, vertical, beginRow, endRow);
+			});
+		}
+
+		// 出力の形式に直して書く
+		ForEachRowBand(current.width, current.height, options.isParallel, [&](uint32_t beginRow, uint32_t endRow) {
+			EncodeRows(current, result.format, result.GetPixels(levelIndex), level.rowPitch, beginRow, endRow);
+		});
+
+		std::swap(previous, current);
+	}
+	return true;
+}
+
+///*-----------------------------------------------------------------------*///
+//								フィルタ											//
+///*-----------------------------------------------------------------------*///
+
+float MipGenerator::GetFilterRadius(Filter filter) {
+	switch (filter) {
+	case Filter::Kaiser:
+	case Filter::Lanczos:
+		return 3.0f;
+	case Filter::Box:
+	default:
+		return 0.5f;
+	}
+}
+
+float MipGenerator::EvaluateFilter(Filter filter, float x) {
+	switch (filter) {
+	case Filter::Kaiser: {
+		const float t = x / 3.0f;
+		if (t <= -1.0f || t >= 1.0f) {
+			return 0.0f;
+		}
+		return Sinc(x) * BesselI0(kKaiserAlpha * std::sqrt(1.0f - t * t)) / BesselI0(kKaiserAlpha);
+	}
+	case Filter::Lanczos:
+		if (x <= -3.0f || x >= 3.0f) {
+			return 0.0f;
+		}
+		return Sinc(x) * Sinc(x / 3.0f);
+	case Filter::Box:
+	default:
+		// 境界の画素が2つの出力に重ならないように片側だけ含める
+		return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+	}
+}
+
+MipGenerator::FilterTable MipGenerator::BuildFilterTable(Filter filter, uint32_t sourceSize, uint32_t destinationSize) {
+	FilterTable table;
+	table.contributions.resize(destinationSize);
+
+	// 出力1画素が覆う入力の幅（縮小なので1以上）。フィルタはこの幅に引き伸ばして掛ける
+	const float scale = (std::max)(static_cast<float>(sourceSize) / static_cast<float>(destinationSize), 1.0f);
+	const float support = GetFilterRadius(filter) * scale;
+
+	for (uint32_t i = 0; i < destinationSize; ++i) {
+		const float center = (static_cast<float>(i) + 0.5f) * static_cast<float>(sourceSize) / static_cast<float>(destinationSize);
+		const int32_t begin = static_cast<int32_t>(std::floor(center - support));
+		const int32_t end = static_cast<int32_t>(std::ceil(center + support));
+
+		Contribution& contribution = table.contributions[i];
+		contribution.first = static_cast<uint32_t>(table.weights.size());
+		float totalWeight = 0.0f;
+		for (int32_t j = begin; j <= end; ++j) {
+			const float weight = EvaluateFilter(filter, (static_cast<float>(j) + 0.5f - center) / scale);
+			if (weight == 0.0f) {
+				continue;
+			}
+			// 端の外は端の画素を繰り返す
+			table.indices.push_back(static_cast<uint32_t>(std::clamp(j, 0, static_cast<int32_t>(sourceSize) - 1)));
+			table.weights.push_back(weight);
+			totalWeight += weight;
+		}
+		contribution.count = static_cast<uint32_t>(table.weights.size()) - contribution.first;
+
+		// 合計が1になるように（平らな画像を縮めても明るさが変わらないように）
+		if (totalWeight != 0.0f) {
+			for (uint32_t k = 0; k < contribution.count; ++k) {
+				table.weights[contribution.first + k] /= totalWeight;
+			}
+		}
+	}
+	return table;
+}
+
+///*-----------------------------------------------------------------------*///
+//								縮小												//
+///*-----------------------------------------------------------------------*///
+
+void MipGenerator::ResampleRows(const LinearImage& source, LinearImage& destination,
+	const FilterTable& horizontal, const FilterTable& vertical, uint32_t beginRow, uint32_t endRow) {
+	// 縦に重みを掛けた1行（スレッドごとに持つ）
+	std::vector<float> column(static_cast<size_t>(source.width) * 4);
+
+	for (uint32_t y = beginRow; y < endRow; ++y) {
+		// 縦: 入力の行を重み付きで足し合わせる（行ごとに連続したメモリを流す）
+		const Contribution& rowContribution = vertical.contributions[y];
+		std::fill(column.begin(), column.end(), 0.0f);
+		for (uint32_t k = 0; k < rowContribution.count; ++k) {
+			const __m128 weight = _mm_set1_ps(vertical.weights[rowContribution.first + k]);
+			const float* sourceRow = source.GetRow(vertical.indices[rowContribution.first + k]);
+			float* columnPixel = column.data();
+			for (uint32_t x = 0; x < source.width; ++x, sourceRow += 4, columnPixel += 4) {
+				_mm_storeu_ps(columnPixel, _mm_add_ps(_mm_loadu_ps(columnPixel), _mm_mul_ps(weight, _mm_loadu_ps(sourceRow))));
+			}
+		}
+
+		// 横: 縦に足した行から出力の画素ごとに足し合わせる
+		float* destinationPixel = destination.GetRow(y);
+		for (uint32_t x = 0; x < destination.width; ++x, destinationPixel += 4) {
+			const Contribution& pixelContribution = horizontal.contributions[x];
+			__m128 sum = _mm_setzero_ps();
+			for (uint32_t k = 0; k < pixelContribution.count; ++k) {
+				const __m128 weight = _mm_set1_ps(horizontal.weights[pixelContribution.first + k]);
+				sum = _mm_add_ps(sum, _mm_mul_ps(weight, _mm_loadu_ps(column.data() + horizontal.indices[pixelContribution.first + k] * 4)));
+			}
+			_mm_storeu_ps(destinationPixel, sum);
+		}
+	}
+}
+
+void MipGenerator::HalveRows(const LinearImage& source, LinearImage& destination, uint32_t beginRow, uint32_t endRow) {
+	const __m128 quarter = _mm_set1_ps(0.25f);
+	for (uint32_t y = beginRow; y < endRow; ++y) {
+		const float* row0 = source.GetRow(y * 2);
+		const float* row1 = source.GetRow(y * 2 + 1);
+		float* destinationPixel = destination.GetRow(y);
+		for (uint32_t x = 0; x < destination.width; ++x, row0 += 8, row1 += 8, destinationPixel += 4) {
+			const __m128 top = _mm_add_ps(_mm_loadu_ps(row0), _mm_loadu_ps(row0 + 4));
+			const __m128 bottom = _mm_add_ps(_mm_loadu_ps(row1), _mm_loadu_ps(row1 + 4));
+			_mm_storeu_ps(destinationPixel, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+		}
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//								形式の変換										//
+///*-----------------------------------------------------------------------*///
+
+void MipGenerator::DecodeRows(const SourceImage& source, LinearImage& destination, uint32_t beginRow, uint32_t endRow) {
+	const float* srgbTable = GetSrgbDecodeTable();
+	const __m128 inverse255 = _mm_set1_ps(1.0f / 255.0f);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (uint32_t y = beginRow; y < endRow; ++y) {
+		const uint8_t* sourceRow = static_cast<const uint8_t*>(source.pixels) + y * source.rowPitch;
+		float* destinationPixel = destination.GetRow(y);
+
+		switch (source.format) {
+		case Format::RGBA8UnormSrgb:
+			// RGBは表で線形に、アルファはそのまま
+			for (uint32_t x = 0; x < source.width; ++x, sourceRow += 4, destinationPixel += 4) {
+				destinationPixel[0] = srgbTable[sourceRow[0]];
+				destinationPixel[1] = srgbTable[sourceRow[1]];
+				destinationPixel[2] = srgbTable[sourceRow[2]];
+				destinationPixel[3] = static_cast<float>(sourceRow[3]) * (1.0f / 255.0f);
+			}
+			break;
+		case Format::RGBA8Unorm:
+			for (uint32_t x = 0; x < source.width; ++x, sourceRow += 4, destinationPixel += 4) {
+				// 4バイトを32bit整数4つに広げてからfloatに
+				int32_t packed;
+				std::memcpy(&packed, sourceRow, sizeof(packed));
+				const __m128i bytes = _mm_cvtsi32_si128(packed);
+				const __m128i words = _mm_unpacklo_epi8(bytes, zero);
+				const __m128i dwords = _mm_unpacklo_epi16(words, zero);
+				_mm_storeu_ps(destinationPixel, _mm_mul_ps(_mm_cvtepi32_ps(dwords), inverse255));
+			}
+			break;
+		case Format::RGBA16Float: {
+			const uint16_t* halfRow = reinterpret_cast<const uint16_t*>(sourceRow);
+			for (uint32_t x = 0; x < source.width * 4; ++x) {
+				destinationPixel[x] = HalfToFloat(halfRow[x]);
+			}
+			break;
+		}
+		}
+	}
+}
+
+void MipGenerator::EncodeRows(const LinearImage& source, Format format, uint8_t* destination, size_t rowPitch, uint32_t beginRow, uint32_t endRow) {
+	const uint8_t* srgbTable = GetSrgbEncodeTable();
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale255 = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 tableScale = _mm_set1_ps(static_cast<float>(kSrgbEncodeTableSize - 1));
+
+	for (uint32_t y = beginRow; y < endRow; ++y) {
+		const float* sourcePixel = source.GetRow(y);
+		uint8_t* destinationRow = destination + y * rowPitch;
+
+		switch (format) {
+		case Format::RGBA8UnormSrgb:
+			// Kaiser・Lanczosは負の重みで範囲をはみ出すので0～1に収めてから表を引く
+			for (uint32_t x = 0; x < source.width; ++x, sourcePixel += 4, destinationRow += 4) {
+				const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(sourcePixel), zero), one);
+				alignas(16) int32_t tableIndex[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(tableIndex), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, tableScale), half)));
+				alignas(16) int32_t alpha[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(alpha), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale255), half)));
+				destinationRow[0] = srgbTable[tableIndex[0]];
+				destinationRow[1] = srgbTable[tableIndex[1]];
+				destinationRow[2] = srgbTable[tableIndex[2]];
+				destinationRow[3] = static_cast<uint8_t>(alpha[3]);
+			}
+			break;
+		case Format::RGBA8Unorm:
+			for (uint32_t x = 0; x < source.width; ++x, sourcePixel += 4, destinationRow += 4) {
+				const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(sourcePixel), zero), one);
+				const __m128i dwords = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale255), half));
+				// 32bit整数4つを1バイトずつに詰める
+				const __m128i words = _mm_packs_epi32(dwords, dwords);
+				const __m128i bytes = _mm_packus_epi16(words, words);
+				const int32_t packed = _mm_cvtsi128_si32(bytes);
+				std::memcpy(destinationRow, &packed, sizeof(packed));
+			}
+			break;
+		case Format::RGBA16Float: {
+			uint16_t* halfRow = reinterpret_cast<uint16_t*>(destinationRow);
+			for (uint32_t x = 0; x < source.width * 4; ++x) {
+				halfRow[x] = FloatToHalf(sourcePixel[x]);
+			}
+			break;
+		}
+		}
+	}
+}
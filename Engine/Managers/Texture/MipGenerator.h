@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ミップマップを作る（D3D・DirectXTexに依存しないので単体で動かせる）
+/// 画素はfloat4の線形値に直してから縮小する（sRGBのものはガンマを外してから平均し、書き戻す時に掛け直す）
+/// 各段は1つ上の段から分離型のフィルタで縮小し、行をまとまりに分けてThreadPoolで並列に処理する
+/// 1画素をSSEの1レジスタ（RGBA）で扱う
+/// </summary>
+class MipGenerator {
+public:
+	/// <summary>
+	/// 縮小のフィルタ
+	/// </summary>
+	enum class Filter {
+		Box,		// 2x2の平均（奇数の大きさは覆う範囲の面積で重み付け）。速いがぼやける
+		Kaiser,		// Kaiser窓のsinc（半径3）。にじみが少なく、リンギングも控えめ
+		Lanczos,	// Lanczos3。一番くっきりするが、縁にリンギングが出やすい
+	};
+
+	/// <summary>
+	/// 画素の形式（RGBAの順で扱うが、フィルタは各チャンネル独立なのでBGRAもそのまま通る）
+	/// </summary>
+	enum class Format {
+		RGBA8Unorm,		// 8bit、線形
+		RGBA8UnormSrgb,	// 8bit、RGBはsRGB（アルファは線形）
+		RGBA16Float,	// 16bitの半精度浮動小数点、線形
+	};
+
+	/// <summary>
+	/// 元の画像（1段目になる）
+	/// </summary>
+	struct SourceImage {
+		const void* pixels = nullptr;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		size_t rowPitch = 0;	// 1行のバイト数
+		Format format = Format::RGBA8UnormSrgb;
+	};
+
+	/// <summary>
+	/// 作る時の設定
+	/// </summary>
+	struct Options {
+		Filter filter = Filter::Kaiser;
+		uint32_t mipLevels = 0;		// 段数（0なら1x1まで全て）
+		bool isParallel = true;		// ThreadPoolで行を並列に処理するか
+	};
+
+	/// <summary>
+	/// ミップの1段分（pixelsの中の位置）
+	/// </summary>
+	struct Level {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		size_t rowPitch = 0;
+		size_t offset = 0;
+	};
+
+	/// <summary>
+	/// 作ったミップマップ（全ての段を1つの配列に詰める）
+	/// </summary>
+	struct MipChain {
+		Format format = Format::RGBA8UnormSrgb;
+		std::vector<Level> levels;
+		std::vector<uint8_t> pixels;
+
+		uint8_t* GetPixels(size_t level) { return pixels.data() + levels[level].offset; }
+		const uint8_t* GetPixels(size_t level) const { return pixels.data() + levels[level].offset; }
+	};
+
+	/// <summary>
+	/// 1x1まで縮めた時の段数
+	/// </summary>
+	static uint32_t ComputeMipLevels(uint32_t width, uint32_t height);
+
+	/// <summary>
+	/// 1画素のバイト数
+	/// </summary>
+	static size_t GetPixelSize(Format format);
+
+	/// <summary>
+	/// ミップマップを作る（1段目は元の画像をそのままコピー）
+	/// </summary>
+	/// <param name="source">元の画像</param>
+	/// <param name="options">設定</param>
+	/// <param name="result">作ったミップマップ</param>
+	/// <returns>作れたかどうか（大きさ0やpixelsがnullptrならfalse）</returns>
+	static bool Generate(const SourceImage& source, const Options& options, MipChain& result);
+
+private:
+	MipGenerator() = delete;
+	~MipGenerator() = delete;
+
+	/// <summary>
+	/// 線形の画像（1画素がfloat4）
+	/// </summary>
+	struct LinearImage {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<float> pixels;
+
+		float* GetRow(uint32_t y) { return pixels.data() + static_cast<size_t>(y) * width * 4; }
+		const float* GetRow(uint32_t y) const { return pixels.data() + static_cast<size_t>(y) * width * 4; }
+	};
+
+	/// <summary>
+	/// 出力の1画素に掛かる入力の範囲と重み（分離型なので1軸分）
+	/// </summary>
+	struct Contribution {
+		uint32_t first = 0;		// weightsの先頭
+		uint32_t count = 0;		// タップ数
+	};
+	struct FilterTable {
+		std::vector<Contribution> contributions;	// 出力の画素ごと
+		std::vector<uint32_t> indices;				// 入力の画素（端はクランプ済み）
+		std::vector<float> weights;					// 合計が1になるように正規化済み
+	};
+
+	/// <summary>
+	/// 1軸分の重みの表を作る
+	/// </summary>
+	static FilterTable BuildFilterTable(Filter filter, uint32_t sourceSize, uint32_t destinationSize);
+
+	/// <summary>
+	/// フィルタの半径（出力の画素単位）と重み
+	/// </summary>
+	static float GetFilterRadius(Filter filter);
+	static float EvaluateFilter(Filter filter, float x);
+
+	/// <summary>
+	/// 元の画像の行を線形のfloat4に直す
+	/// </summary>
+	static void DecodeRows(const SourceImage& source, LinearImage& destination, uint32_t beginRow, uint32_t endRow);
+
+	/// <summary>
+	/// 線形の行を出力の形式に直して書く
+	/// </summary>
+	static void EncodeRows(const LinearImage& source, Format format, uint8_t* destination, size_t rowPitch, uint32_t beginRow, uint32_t endRow);
+
+	/// <summary>
+	/// 1つ上の段から縮小する（縦→横の順で重みを掛ける）
+	/// </summary>
+	static void ResampleRows(const LinearImage& source, LinearImage& destination,
+		const FilterTable& horizontal, const FilterTable& vertical, uint32_t beginRow, uint32_t endRow);
+
+	/// <summary>
+	/// ちょうど半分にする時の2x2の平均（Boxの速い経路）
+	/// </summary>
+	static void HalveRows(const LinearImage& source, LinearImage& destination, uint32_t beginRow, uint32_t endRow);
+
+	/// <summary>
+	/// 行をまとまりに分けて処理する（isParallelならThreadPoolで並列に）
+	/// </summary>
+	template<typename Function>
+	static void ForEachRowBand(uint32_t width, uint32_t height, bool isParallel, const Function& function);
+};
@@ -1,4 +1,8 @@
 #include "Texture.h"
+#include "Managers/Texture/TextureUploadQueue.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include <algorithm>
+#include <cstring>
 
 bool Texture::LoadTexture(const std::string& filePath, DirectXCommon* dxCommon, uint32_t srvIndex) {
 	// 既に読み込み済みの場合はスキップ
@@ -23,12 +27,12 @@ bool Texture::LoadTexture(const std::string& filePath, DirectXCommon* dxCommon,
 		return false;
 	}
 
-	// テクスチャデータをアップロード
-	intermediateResource_ = UploadTextureData(
-		textureResource_,
-		mipImages,
-		dxCommon->GetDeviceComPtr(),
-		dxCommon->GetCommandListComPtr());
+	// テクスチャデータをアップロード（ステージングに書き、フレームの終わりにまとめて送る）
+	if (!TextureUploadQueue::GetInstance()->UploadTexture(textureResource_.Get(), mipImages.GetImages(), mipImages.GetImageCount())) {
+		textureResource_.Reset();
+		return false;
+	}
+	residentMip_ = 0;
 
 	// DescriptorHeapManagerからSRVを割り当て
 	auto descriptorManager = dxCommon->GetDescriptorManager();
@@ -65,31 +69,27 @@ bool Texture::LoadTextureWithHandle(const std::string& filePath, DirectXCommon*
 		return true;
 	}
 
-	filePath_ = filePath;
-
 	// テクスチャファイルを読み込み
 	DirectX::ScratchImage mipImages = LoadTextureFile(filePath);
 	if (mipImages.GetImageCount() == 0) {
 		return false;
 	}
 
+	return CreateFromImage(filePath, mipImages, dxCommon, descriptorHandle);
+}
+
+bool Texture::CreateFromImage(const std::string& name, const DirectX::ScratchImage& mipImages, DirectXCommon* dxCommon,
+	const DescriptorHeapManager::DescriptorHandle& descriptorHandle, uint32_t mostDetailedMip) {
+	filePath_ = name;
+
 	// メタデータを保存
 	metadata_ = mipImages.GetMetadata();
 
-	// テクスチャリソースを作成
-	textureResource_ = CreateTextureResource(dxCommon->GetDeviceComPtr(), metadata_);
-	if (!textureResource_) {
+	// テクスチャリソースを作成し、CPU側のデータをGPUに転送
+	if (!CreateResidentResource(mipImages, mostDetailedMip, dxCommon)) {
 		return false;
 	}
 
-	// テクスチャデータをアップロード
-	//CPU側のデータをGPUに転送
-	intermediateResource_ = UploadTextureData(
-		textureResource_,
-		mipImages,
-		dxCommon->GetDeviceComPtr(),
-		dxCommon->GetCommandListComPtr());
-
 	// ハンドルを保存（既に割り当て済み）
 	// 既に割り当てられたハンドルを使用
 	descriptorHandle_ = descriptorHandle;
@@ -101,10 +101,176 @@ bool Texture::LoadTextureWithHandle(const std::string& filePath, DirectXCommon*
 	CreateSRV(dxCommon->GetDeviceComPtr(), cpuHandle_);
 
 	// ロード完了のログ
-	Logger::Log(Logger::GetStream(), std::format("Complete Texture loaded with handle : {} (SRV Index: {})\n", filePath, srvIndex_));
+	Logger::Log(Logger::GetStream(), std::format("Complete Texture loaded with handle : {} (SRV Index: {}, Mip: {})\n", name, srvIndex_, residentMip_));
+	return true;
+}
+
+bool Texture::ChangeResidentMip(uint32_t mostDetailedMip, DirectXCommon* dxCommon,
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>& retiredResources, const DirectX::ScratchImage* mipImages) {
+	if (!IsValid() || !CanStream(metadata_)) {
+		return false;
+	}
+	mostDetailedMip = (std::min)(mostDetailedMip, GetMaxResidentMip(metadata_));
+	if (mostDetailedMip == residentMip_) {
+		return true;
+	}
+
+	// 失敗したら元に戻せるように残しておく
+	Microsoft::WRL::ComPtr<ID3D12Resource> oldResource = textureResource_;
+	const uint32_t oldResidentMip = residentMip_;
+
+	bool isCreated = false;
+	if (mostDetailedMip > residentMip_) {
+		// 粗くする時は必要なミップが既にGPUにあるので、ファイルは読まずにコピーするだけ
+		textureResource_ = CreateReducedResource(mostDetailedMip, dxCommon);
+		residentMip_ = mostDetailedMip;
+		isCreated = textureResource_ != nullptr;
+	} else {
+		// 詳細にする時はファイルから読み直す（読み込み済みの画像を渡されればそれを使う。元の画像とミップの数が変わっていたら諦める）
+		DirectX::ScratchImage loadedImages;
+		if (!mipImages) {
+			loadedImages = LoadTextureFile(filePath_);
+			mipImages = &loadedImages;
+		}
+		if (mipImages->GetImageCount() != 0 && mipImages->GetMetadata().mipLevels == metadata_.mipLevels) {
+			isCreated = CreateResidentResource(*mipImages, mostDetailedMip, dxCommon);
+		}
+	}
+
+	if (!isCreated) {
+		textureResource_ = oldResource;
+		residentMip_ = oldResidentMip;
+		Logger::Log(Logger::GetStream(), std::format("Failed to change resident mip of texture: {} (Mip: {} -> {})\n",
+			filePath_, oldResidentMip, mostDetailedMip));
+		return false;
+	}
+
+	// 前のフレームまでの描画が古いリソースを参照しているので、解放はGPUが使い終わってから
+	retiredResources.push_back(std::move(oldResource));
+
+	// 同じ番号のSRVを作り直す（描画側のハンドルやバインドレスの番号は変わらない）
+	CreateSRV(dxCommon->GetDeviceComPtr(), cpuHandle_);
+	return true;
+}
+
+bool Texture::Reload(const DirectX::ScratchImage& mipImages, uint32_t mostDetailedMip, DirectXCommon* dxCommon,
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>& retiredResources) {
+	if (!IsValid() || mipImages.GetImageCount() == 0) {
+		return false;
+	}
+
+	// 失敗したら元に戻せるように残しておく
+	Microsoft::WRL::ComPtr<ID3D12Resource> oldResource = textureResource_;
+	const DirectX::TexMetadata oldMetadata = metadata_;
+	const uint32_t oldResidentMip = residentMip_;
+
+	metadata_ = mipImages.GetMetadata();
+	if (!CreateResidentResource(mipImages, mostDetailedMip, dxCommon)) {
+		textureResource_ = oldResource;
+		metadata_ = oldMetadata;
+		residentMip_ = oldResidentMip;
+		Logger::Log(Logger::GetStream(), std::format("Failed to reload texture: {}\n", filePath_));
+		return false;
+	}
+
+	// 前のフレームまでの描画が古いリソースを参照しているので、解放はGPUが使い終わってから
+	retiredResources.push_back(std::move(oldResource));
+
+	// 同じ番号のSRVを新しい形式で作り直す（描画側のハンドルやバインドレスの番号は変わらない）
+	CreateSRV(dxCommon->GetDeviceComPtr(), cpuHandle_);
+
+	Logger::Log(Logger::GetStream(), std::format("Texture reloaded: {} ({}x{}, SRV Index: {}, Mip: {})\n",
+		filePath_, metadata_.width, metadata_.height, srvIndex_, residentMip_));
 	return true;
 }
 
+std::vector<uint64_t> Texture::ComputeMipSizes(const DirectX::ScratchImage& mipImages) {
+	const DirectX::TexMetadata& metadata = mipImages.GetMetadata();
+	std::vector<uint64_t> mipSizes(metadata.mipLevels, 0);
+	for (size_t mip = 0; mip < metadata.mipLevels; ++mip) {
+		for (size_t item = 0; item < metadata.arraySize; ++item) {
+			const DirectX::Image* image = mipImages.GetImage(mip, item, 0);
+			if (image) {
+				mipSizes[mip] += image->slicePitch;
+			}
+		}
+	}
+	return mipSizes;
+}
+
+bool Texture::CanStream(const DirectX::TexMetadata& metadata) {
+	return metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D &&
+		metadata.arraySize == 1 && metadata.depth == 1 && metadata.mipLevels > 1 &&
+		!metadata.IsCubemap();
+}
+
+uint32_t Texture::GetMaxResidentMip(const DirectX::TexMetadata& metadata) {
+	const uint32_t lastMip = static_cast<uint32_t>(metadata.mipLevels - 1);
+	if (!DirectX::IsCompressed(metadata.format)) {
+		return lastMip;
+	}
+	uint32_t mip = 0;
+	while (mip < lastMip) {
+		const size_t width = metadata.width >> (mip + 1);
+		const size_t height = metadata.height >> (mip + 1);
+		if (width == 0 || height == 0 || width % 4 != 0 || height % 4 != 0) {
+			break;
+		}
+		++mip;
+	}
+	return mip;
+}
+
+bool Texture::CreateResidentResource(const DirectX::ScratchImage& mipImages, uint32_t mostDetailedMip, DirectXCommon* dxCommon) {
+	// ミップを一部だけ置けないものは全て置く
+	if (!CanStream(metadata_)) {
+		mostDetailedMip = 0;
+	}
+	mostDetailedMip = (std::min)(mostDetailedMip, GetMaxResidentMip(metadata_));
+
+	// 置くミップだけのメタデータ（2Dの単体テクスチャなら画像はミップの順に並んでいる）
+	DirectX::TexMetadata residentMetadata = metadata_;
+	residentMetadata.width = (std::max)(metadata_.width >> mostDetailedMip, size_t(1));
+	residentMetadata.height = (std::max)(metadata_.height >> mostDetailedMip, size_t(1));
+	residentMetadata.mipLevels = metadata_.mipLevels - mostDetailedMip;
+
+	// テクスチャリソースを作成
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource = CreateTextureResource(dxCommon->GetDeviceComPtr(), residentMetadata);
+	if (!resource) {
+		return false;
+	}
+
+	// テクスチャデータをアップロード（ステージングに書き、フレームの終わりにまとめて送る）
+	const size_t imageCount = mostDetailedMip == 0 ? mipImages.GetImageCount() : residentMetadata.mipLevels;
+	if (!TextureUploadQueue::GetInstance()->UploadTexture(resource.Get(), mipImages.GetImages() + mostDetailedMip, imageCount)) {
+		return false;
+	}
+
+	textureResource_ = resource;
+	residentMip_ = mostDetailedMip;
+	return true;
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> Texture::CreateReducedResource(uint32_t mostDetailedMip, DirectXCommon* dxCommon) {
+	DirectX::TexMetadata reducedMetadata = metadata_;
+	reducedMetadata.width = (std::max)(metadata_.width >> mostDetailedMip, size_t(1));
+	reducedMetadata.height = (std::max)(metadata_.height >> mostDetailedMip, size_t(1));
+	reducedMetadata.mipLevels = metadata_.mipLevels - mostDetailedMip;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource = CreateTextureResource(dxCommon->GetDeviceComPtr(), reducedMetadata);
+	if (!resource) {
+		return nullptr;
+	}
+
+	// 残すミップをコピー用のキューでコピー（2Dの単体テクスチャなのでサブリソースの番号はミップの番号）
+	// 今のリソースはコピーが終わるまでアップロードキューが保持する
+	const uint32_t skippedMipCount = mostDetailedMip - residentMip_;
+	TextureUploadQueue::GetInstance()->CopyTextureSubresources(resource.Get(), textureResource_.Get(),
+		skippedMipCount, static_cast<uint32_t>(reducedMetadata.mipLevels));
+
+	return resource;
+}
+
 void Texture::Unload(DirectXCommon* dxCommon) {
 	if (!IsValid()) {
 		return;	//すでに向こうなら何もしない
@@ -121,7 +287,6 @@ void Texture::Unload(DirectXCommon* dxCommon) {
 
 	// リソースをクリア
 	textureResource_.Reset();
-	intermediateResource_.Reset();
 
 	// ハンドルをクリア
 	cpuHandle_ = {};
@@ -131,16 +296,34 @@ void Texture::Unload(DirectXCommon* dxCommon) {
 	// その他の情報をクリア
 	metadata_ = {};
 	filePath_.clear();
+	residentMip_ = 0;
 
 	// ログ出力
 	Logger::Log(Logger::GetStream(), std::format("Texture unloaded: {}\n", filePath_));
 }
 
 DirectX::ScratchImage Texture::LoadTextureFile(const std::string& filePath) {
-	// テクスチャファイルを読んでプログラムで扱えるようにする
+	VirtualFileSystem* fileSystem = VirtualFileSystem::GetInstance();
+
+	// クック済みのファイルがあればそのまま使う（ミップマップ込みで圧縮済み。アーカイブに入っているものは常に使う）
+	if (GraphicsConfig::kUseCookedTextures) {
+		const std::string cookedPath = TextureCooker::GetCookedPath(filePath);
+		if (fileSystem->IsPacked(cookedPath) || TextureCooker::IsCookedFileUpToDate(filePath, cookedPath)) {
+			DirectX::ScratchImage cookedImages{};
+			const FileView cookedFile = fileSystem->Open(cookedPath);
+			if (cookedFile.IsValid() &&
+				SUCCEEDED(DirectX::LoadFromDDSMemory(cookedFile.GetData(), cookedFile.GetSize(), DirectX::DDS_FLAGS_NONE, nullptr, cookedImages))) {
+				return cookedImages;
+			}
+			Logger::Log(Logger::GetStream(), std::format("Failed to load cooked texture: {} (loading {} instead)\n", cookedPath, filePath));
+		}
+	}
+
+	// テクスチャファイルを読んでプログラムで扱えるようにする（アーカイブにあればそこから、マップしたものをそのままデコードする）
 	DirectX::ScratchImage image{};
-	std::wstring filePathW = Logger::ConvertString(filePath);
-	HRESULT hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+	const FileView file = fileSystem->Open(filePath);
+	HRESULT hr = file.IsValid() ?
+		DirectX::LoadFromWICMemory(file.GetData(), file.GetSize(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image) : E_FAIL;
 
 	if (FAILED(hr)) {
 		// ロード失敗のログ
@@ -150,15 +333,7 @@ DirectX::ScratchImage Texture::LoadTextureFile(const std::string& filePath) {
 
 	// ミップマップ生成
 	DirectX::ScratchImage mipImages{};
-	hr = DirectX::GenerateMipMaps(
-		image.GetImages(),
-		image.GetImageCount(),
-		image.GetMetadata(),
-		DirectX::TEX_FILTER_SRGB,
-		0,
-		mipImages);
-
-	if (FAILED(hr)) {
+	if (!GenerateMipChain(image, kMipFilter, 0, mipImages)) {
 		// ミップマップ生成失敗のログ
 		Logger::Log(Logger::GetStream(), std::format("Failed to generate mipmaps for: {}\n", filePath));
 		return image; // ミップマップ生成に失敗しても元の画像を返す
@@ -167,6 +342,68 @@ DirectX::ScratchImage Texture::LoadTextureFile(const std::string& filePath) {
 	return mipImages;
 }
 
+bool Texture::GenerateMipChain(const DirectX::ScratchImage& image, MipGenerator::Filter filter, size_t mipLevels, DirectX::ScratchImage& mipImages) {
+	const DirectX::TexMetadata& metadata = image.GetMetadata();
+
+	// MipGeneratorで扱える形式か（フィルタはチャンネルごとなのでBGRAもRGBAと同じに扱える）
+	bool isSupported = metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D &&
+		metadata.arraySize == 1 && metadata.depth == 1 && metadata.mipLevels == 1;
+	MipGenerator::Format format = MipGenerator::Format::RGBA8UnormSrgb;
+	switch (metadata.format) {
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_B8G8R8A8_UNORM:
+		format = MipGenerator::Format::RGBA8Unorm;
+		break;
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+	case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+		format = MipGenerator::Format::RGBA8UnormSrgb;
+		break;
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		format = MipGenerator::Format::RGBA16Float;
+		break;
+	default:
+		isSupported = false;
+		break;
+	}
+
+	// それ以外の形式はDirectXTexで作る
+	if (!isSupported) {
+		return SUCCEEDED(DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), metadata,
+			DirectX::TEX_FILTER_SRGB, mipLevels, mipImages));
+	}
+
+	const DirectX::Image& sourceImage = *image.GetImage(0, 0, 0);
+	MipGenerator::SourceImage source;
+	source.pixels = sourceImage.pixels;
+	source.width = static_cast<uint32_t>(sourceImage.width);
+	source.height = static_cast<uint32_t>(sourceImage.height);
+	source.rowPitch = sourceImage.rowPitch;
+	source.format = format;
+
+	MipGenerator::Options options;
+	options.filter = filter;
+	options.mipLevels = static_cast<uint32_t>(mipLevels);
+
+	MipGenerator::MipChain chain;
+	if (!MipGenerator::Generate(source, options, chain)) {
+		return false;
+	}
+
+	// DirectXTexの画像に詰め直す（行のピッチが違うことがあるので1行ずつ）
+	if (FAILED(mipImages.Initialize2D(metadata.format, metadata.width, metadata.height, 1, chain.levels.size()))) {
+		return false;
+	}
+	for (size_t level = 0; level < chain.levels.size(); ++level) {
+		const MipGenerator::Level& sourceLevel = chain.levels[level];
+		const DirectX::Image* destination = mipImages.GetImage(level, 0, 0);
+		const size_t rowSize = (std::min)(sourceLevel.rowPitch, destination->rowPitch);
+		for (uint32_t y = 0; y < sourceLevel.height; ++y) {
+			std::memcpy(destination->pixels + y * destination->rowPitch, chain.GetPixels(level) + y * sourceLevel.rowPitch, rowSize);
+		}
+	}
+	return true;
+}
+
 Microsoft::WRL::ComPtr<ID3D12Resource> Texture::CreateTextureResource(
 	const Microsoft::WRL::ComPtr<ID3D12Device>& device,
 	const DirectX::TexMetadata& metadata) {
@@ -191,7 +428,7 @@ Microsoft::WRL::ComPtr<ID3D12Resource> Texture::CreateTextureResource(
 		&heapProperties,						// heapの設定
 		D3D12_HEAP_FLAG_NONE,					// heapの特殊な設定。特になし
 		&resourceDesc,							// resourceの設定
-		D3D12_RESOURCE_STATE_COPY_DEST,			// 初回のresourceState。textureは基本読むだけ
+		D3D12_RESOURCE_STATE_COMMON,			// 初回のresourceState。コピー用のキューで書き、描画では読むだけ（どちらも暗黙の状態遷移に任せる）
 		nullptr,								// clear最適値。使わないのでnullptr
 		IID_PPV_ARGS(&resource));				// 作成するResourceポインタへのポインタ
 
@@ -204,40 +441,13 @@ Microsoft::WRL::ComPtr<ID3D12Resource> Texture::CreateTextureResource(
 	return resource;
 }
 
-Microsoft::WRL::ComPtr<ID3D12Resource> Texture::UploadTextureData(
-	Microsoft::WRL::ComPtr<ID3D12Resource> texture,
-	const DirectX::ScratchImage& mipImages,
-	const Microsoft::WRL::ComPtr<ID3D12Device>& device,
-	const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList) {
-
-	std::vector<D3D12_SUBRESOURCE_DATA> subresource;
-	DirectX::PrepareUpload(device.Get(), mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), subresource);
-
-	uint64_t intermediateSize = GetRequiredIntermediateSize(texture.Get(), 0, UINT(subresource.size()));
-	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = CreateBufferResource(device.Get(), intermediateSize);
-
-	UpdateSubresources(commandList.Get(), texture.Get(), intermediateResource.Get(), 0, 0, UINT(subresource.size()), subresource.data());
-
-	// textureへの転送後は利用できるよう、D3D12_RESOURCE_STATE_COPY_DESTからD3D12_RESOURCE_STATE_GENERIC_READへResourceStateを変更する
-	D3D12_RESOURCE_BARRIER barrier{};
-	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-	barrier.Transition.pResource = texture.Get();
-	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
-	commandList->ResourceBarrier(1, &barrier);
-
-	return intermediateResource;
-}
-
 void Texture::CreateSRV(const Microsoft::WRL::ComPtr<ID3D12Device>& device, D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle) {
 	// SRV設定
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
 	srvDesc.Format = metadata_.format;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MipLevels = UINT(metadata_.mipLevels);
+	srvDesc.Texture2D.MipLevels = UINT(metadata_.mipLevels - residentMip_);	// GPUに置いているミップだけ
 
 	// SRVの生成
 	device->CreateShaderResourceView(textureResource_.Get(), &srvDesc, cpuHandle);
@@ -1,11 +1,14 @@
 #pragma once
 #include <wrl.h>
 #include <string>
+#include <vector>
 #include <cassert>
 
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "BaseSystem/Logger/Logger.h"
 #include "MyMath/MyFunction.h" // CreateBufferResource用
+#include "Managers/Texture/MipGenerator.h"
+#include "Managers/Texture/TextureCooker.h"
 
 class DirectXCommon; // 前方宣言
 
@@ -15,6 +18,8 @@ class DirectXCommon; // 前方宣言
 class Texture {
 public:
 	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+	// ファイルから読んだテクスチャのミップマップのフィルタ
+	static constexpr MipGenerator::Filter kMipFilter = MipGenerator::Filter::Kaiser;
 
 	Texture() = default;
 	~Texture() = default;
@@ -38,6 +43,76 @@ public:
 	bool LoadTextureWithHandle(const std::string& filePath, DirectXCommon* dxCommon,
 		const DescriptorHeapManager::DescriptorHandle& descriptorHandle);
 
+	/// <summary>
+	/// メモリ上の画像からテクスチャを作る（アトラスのページなど、ファイルから直接読まないもの）
+	/// </summary>
+	/// <param name="name">識別用の名前（GetFilePathで返す）</param>
+	/// <param name="mipImages">ミップマップを含む画像</param>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	/// <param name="descriptorHandle">既に割り当て済みのディスクリプタハンドル</param>
+	/// <param name="mostDetailedMip">GPUに置く一番詳細なミップ（それより詳細なものは後からChangeResidentMipで読み込む）</param>
+	/// <returns>作成成功かどうか</returns>
+	bool CreateFromImage(const std::string& name, const DirectX::ScratchImage& mipImages, DirectXCommon* dxCommon,
+		const DescriptorHeapManager::DescriptorHandle& descriptorHandle, uint32_t mostDetailedMip = 0);
+
+	/// <summary>
+	/// GPUに置くミップを変えてリソースを作り直す（SRVの番号はそのまま）
+	/// 粗くする時は今のリソースからGPU上でコピーし、詳細にする時はファイルから読み直す
+	/// 古いリソースはGPUが使い終わるまで解放できないので、retiredResourcesに移す
+	/// </summary>
+	/// <param name="mostDetailedMip">GPUに置く一番詳細なミップ</param>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	/// <param name="retiredResources">GPUが使い終わってから解放するリソースの追加先</param>
+	/// <param name="mipImages">ワーカースレッドで読み込み済みの画像（nullptrならここでファイルを読む）</param>
+	/// <returns>作り直せたかどうか</returns>
+	bool ChangeResidentMip(uint32_t mostDetailedMip, DirectXCommon* dxCommon,
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>& retiredResources, const DirectX::ScratchImage* mipImages = nullptr);
+
+	/// <summary>
+	/// 読み込み直した画像でリソースを作り直す（ホットリロード用。SRVの番号はそのまま）
+	/// 大きさや形式が変わっていてもよい。古いリソースはGPUが使い終わるまで解放できないので、retiredResourcesに移す
+	/// </summary>
+	/// <param name="mipImages">読み込み直した画像</param>
+	/// <param name="mostDetailedMip">GPUに置く一番詳細なミップ</param>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	/// <param name="retiredResources">GPUが使い終わってから解放するリソースの追加先</param>
+	/// <returns>作り直せたかどうか（失敗したら今のリソースのまま）</returns>
+	bool Reload(const DirectX::ScratchImage& mipImages, uint32_t mostDetailedMip, DirectXCommon* dxCommon,
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>& retiredResources);
+
+	/// <summary>
+	/// テクスチャファイルを読み込む（ミップマップも作る）
+	/// クック済みのファイルが元の画像より新しければ、ミップマップ込みで圧縮済みのそちらを読む
+	/// GPUに触らないので、ワーカースレッドから呼んでよい
+	/// </summary>
+	static DirectX::ScratchImage LoadTextureFile(const std::string& filePath);
+
+	/// <summary>
+	/// ミップマップを作る（RGBA8・BGRA8・RGBA16Fの2D画像はMipGeneratorで線形空間で並列に作り、それ以外はDirectXTexで作る）
+	/// </summary>
+	/// <param name="image">1段だけの画像</param>
+	/// <param name="filter">縮小のフィルタ</param>
+	/// <param name="mipLevels">段数（0なら1x1まで全て）</param>
+	/// <param name="mipImages">作ったミップマップ</param>
+	/// <returns>作れたかどうか</returns>
+	static bool GenerateMipChain(const DirectX::ScratchImage& image, MipGenerator::Filter filter, size_t mipLevels, DirectX::ScratchImage& mipImages);
+
+	/// <summary>
+	/// ミップごとのバイト数（配列テクスチャは全要素の合計）
+	/// </summary>
+	static std::vector<uint64_t> ComputeMipSizes(const DirectX::ScratchImage& mipImages);
+
+	/// <summary>
+	/// ミップを一部だけGPUに置けるか（ミップを持つ2Dの単体テクスチャのみ）
+	/// </summary>
+	static bool CanStream(const DirectX::TexMetadata& metadata);
+
+	/// <summary>
+	/// GPUに置く一番詳細なミップとして選べる一番粗いもの
+	/// ブロック圧縮の形式は一番上の段の幅と高さが4の倍数でないとリソースを作れないので、それを満たす段まで
+	/// </summary>
+	static uint32_t GetMaxResidentMip(const DirectX::TexMetadata& metadata);
+
 	/// <summary>
 	/// テクスチャをアンロード
 	/// </summary>
@@ -65,7 +140,12 @@ public:
 	uint32_t GetSRVIndex() const { return srvIndex_; }
 
 	/// <summary>
-	/// テクスチャのメタデータ取得
+	/// GPUに置いている一番詳細なミップ（0なら全て）
+	/// </summary>
+	uint32_t GetResidentMip() const { return residentMip_; }
+
+	/// <summary>
+	/// テクスチャのメタデータ取得（GPUに置いているミップに関わらず元の画像のもの）
 	/// </summary>
 	const DirectX::TexMetadata& GetMetadata() const { return metadata_; }
 
@@ -79,11 +159,14 @@ public:
 	/// </summary>
 	const std::string& GetFilePath() const { return filePath_; }
 
+	/// <summary>
+	/// ファイルパスの付け替え（共有していたタグを外した時に、残ったタグのファイルから読み直せるようにする）
+	/// </summary>
+	void SetFilePath(const std::string& filePath) { filePath_ = filePath; }
+
 private:
 	// テクスチャリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> textureResource_;
-	// アップロード用の中間リソース（転送完了まで保持が必要）
-	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource_;
 
 	// ディスクリプタハンドル情報
 	DescriptorHeapManager::DescriptorHandle descriptorHandle_;
@@ -94,27 +177,24 @@ private:
 	// テクスチャの情報
 	DirectX::TexMetadata metadata_{};
 	std::string filePath_;
+	uint32_t residentMip_ = 0;	// GPUに置いている一番詳細なミップ
 
 	/// <summary>
-	/// テクスチャファイルを読み込む
+	/// mostDetailedMipから下のミップだけでリソースを作り、アップロードキューに積む
 	/// </summary>
-	DirectX::ScratchImage LoadTextureFile(const std::string& filePath);
+	bool CreateResidentResource(const DirectX::ScratchImage& mipImages, uint32_t mostDetailedMip, DirectXCommon* dxCommon);
 
 	/// <summary>
-	/// テクスチャリソースを作成する
+	/// 今のリソースの粗いミップだけをコピー用のキューでコピーした、小さいリソースを作る
 	/// </summary>
-	Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureResource(
-		const Microsoft::WRL::ComPtr<ID3D12Device>& device,
-		const DirectX::TexMetadata& metadata);
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateReducedResource(uint32_t mostDetailedMip, DirectXCommon* dxCommon);
 
 	/// <summary>
-	/// テクスチャデータをアップロードする
+	/// テクスチャリソースを作成する
 	/// </summary>
-	Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(
-		Microsoft::WRL::ComPtr<ID3D12Resource> texture,
-		const DirectX::ScratchImage& mipImages,
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureResource(
 		const Microsoft::WRL::ComPtr<ID3D12Device>& device,
-		const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList);
+		const DirectX::TexMetadata& metadata);
 
 	/// <summary>
 	/// SRVを作成する
@@ -0,0 +1,206 @@
+#include "TextureCooker.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+	// DDSのヘッダーの値（DirectXTexのDDS.hと同じもの）
+	const uint32_t kDDSMagic = 0x20534444;				// "DDS "
+	const uint32_t kDDSHeaderSize = 124;
+	const uint32_t kDDSPixelFormatSize = 32;
+	const uint32_t kDDSFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;	// CAPS|HEIGHT|WIDTH|PIXELFORMAT|MIPMAPCOUNT|LINEARSIZE
+	const uint32_t kDDSPixelFormatFourCC = 0x4;
+	const uint32_t kDDSFourCCDX10 = 0x30315844;			// "DX10"
+	const uint32_t kDDSCaps = 0x8 | 0x1000 | 0x400000;	// COMPLEX|TEXTURE|MIPMAP
+	const uint32_t kResourceDimensionTexture2D = 3;
+
+	/// <summary>
+	/// DDSのファイルの先頭（マジック、ヘッダー、DX10の拡張ヘッダー）を作る
+	/// </summary>
+	std::vector<uint32_t> BuildDDSHeader(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t linearSize, uint32_t dxgiFormat) {
+		std::vector<uint32_t> header(1 + kDDSHeaderSize / 4 + 5, 0);
+		uint32_t* words = header.data();
+		words[0] = kDDSMagic;
+
+		uint32_t* ddsHeader = words + 1;
+		ddsHeader[0] = kDDSHeaderSize;
+		ddsHeader[1] = kDDSFlags;
+		ddsHeader[2] = height;
+		ddsHeader[3] = width;
+		ddsHeader[4] = linearSize;
+		ddsHeader[5] = 0;		// depth
+		ddsHeader[6] = mipLevels;
+		// [7]～[17]は予約
+		uint32_t* pixelFormat = ddsHeader + 18;
+		pixelFormat[0] = kDDSPixelFormatSize;
+		pixelFormat[1] = kDDSPixelFormatFourCC;
+		pixelFormat[2] = kDDSFourCCDX10;
+		ddsHeader[26] = kDDSCaps;
+
+		uint32_t* dx10Header = words + 1 + kDDSHeaderSize / 4;
+		dx10Header[0] = dxgiFormat;
+		dx10Header[1] = kResourceDimensionTexture2D;
+		dx10Header[2] = 0;		// miscFlag
+		dx10Header[3] = 1;		// arraySize
+		dx10Header[4] = 0;		// miscFlags2（アルファの扱いは不明のまま）
+		return header;
+	}
+}
+
+bool TextureCooker::Cook(const SourceImage& source, const Settings& settings, const std::string& outputPath, Result& result) {
+	result = Result{};
+	if (!source.pixels || source.width == 0 || source.height == 0) {
+		result.message = "empty source image";
+		return false;
+	}
+	// ブロック圧縮のテクスチャは1段目の大きさが4の倍数でないと作れない
+	if (source.width % 4 != 0 || source.height % 4 != 0) {
+		result.message = "width and height must be multiples of 4";
+		return false;
+	}
+
+	// ミップマップを作る（BC5は法線マップなどの線形の値として扱う）
+	const bool isSrgb = settings.isSrgb && settings.format != BlockCompressor::Format::BC5;
+	MipGenerator::SourceImage mipSource;
+	mipSource.pixels = source.pixels;
+	mipSource.width = source.width;
+	mipSource.height = source.height;
+	mipSource.rowPitch = source.rowPitch;
+	mipSource.format = isSrgb ? MipGenerator::Format::RGBA8UnormSrgb : MipGenerator::Format::RGBA8Unorm;
+	MipGenerator::Options mipOptions;
+	mipOptions.filter = settings.mipFilter;
+	MipGenerator::MipChain mipChain;
+	if (!MipGenerator::Generate(mipSource, mipOptions, mipChain)) {
+		result.message = "failed to generate mipmaps";
+		return false;
+	}
+
+	// 各段を圧縮してミップの順に並べる
+	BlockCompressor::Settings compressSettings;
+	compressSettings.format = settings.format;
+	compressSettings.quality = settings.quality;
+	std::vector<uint8_t> cookedData;
+	std::vector<uint8_t> levelBlocks;
+	size_t level0Size = 0;
+	for (size_t level = 0; level < mipChain.levels.size(); ++level) {
+		const MipGenerator::Level& mip = mipChain.levels[level];
+		BlockCompressor::SourceImage levelSource;
+		levelSource.pixels = mipChain.GetPixels(level);
+		levelSource.width = mip.width;
+		levelSource.height = mip.height;
+		levelSource.rowPitch = mip.rowPitch;
+		if (!BlockCompressor::Compress(levelSource, compressSettings, levelBlocks)) {
+			result.message = "failed to compress";
+			return false;
+		}
+
+		// 1段目は戻して元の画像と比べる
+		if (level == 0) {
+			level0Size = levelBlocks.size();
+			std::vector<uint8_t> decoded;
+			BlockCompressor::Decompress(settings.format, levelBlocks.data(), mip.width, mip.height, decoded);
+			result.psnr = BlockCompressor::ComputePSNR(source.pixels, source.rowPitch, decoded.data(), static_cast<size_t>(mip.width) * 4,
+				mip.width, mip.height, BlockCompressor::GetChannelMask(settings.format));
+		}
+		cookedData.insert(cookedData.end(), levelBlocks.begin(), levelBlocks.end());
+	}
+
+	// 書き出し先のフォルダを作り、途中のファイルを読まれないように別名で書いてから置き換える
+	std::error_code errorCode;
+	const std::filesystem::path path(outputPath);
+	if (path.has_parent_path()) {
+		std::filesystem::create_directories(path.parent_path(), errorCode);
+	}
+	std::filesystem::path temporaryPath = path;
+	temporaryPath += ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			result.message = "failed to open " + temporaryPath.generic_string();
+			return false;
+		}
+		const std::vector<uint32_t> header = BuildDDSHeader(source.width, source.height, static_cast<uint32_t>(mipChain.levels.size()),
+			static_cast<uint32_t>(level0Size), GetDXGIFormat(settings.format, isSrgb));
+		file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size() * sizeof(uint32_t)));
+		file.write(reinterpret_cast<const char*>(cookedData.data()), static_cast<std::streamsize>(cookedData.size()));
+		if (!file) {
+			result.message = "failed to write " + temporaryPath.generic_string();
+			return false;
+		}
+		result.cookedBytes = header.size() * sizeof(uint32_t) + cookedData.size();
+	}
+	std::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode) {
+		std::filesystem::remove(temporaryPath, errorCode);
+		result.message = "failed to replace " + outputPath;
+		return false;
+	}
+
+	result.isSucceeded = true;
+	result.sourceBytes = mipChain.pixels.size();
+	result.mipLevels = static_cast<uint32_t>(mipChain.levels.size());
+	return true;
+}
+
+std::string TextureCooker::GetCookedPath(const std::string& sourcePath) {
+	const std::filesystem::path source(sourcePath);
+	std::filesystem::path cooked = source.parent_path() / kCookedDirectory / source.stem();
+	cooked += ".dds";
+	return cooked.generic_string();
+}
+
+bool TextureCooker::IsCookedFileUpToDate(const std::string& sourcePath, const std::string& cookedPath) {
+	std::error_code errorCode;
+	const auto cookedTime = std::filesystem::last_write_time(cookedPath, errorCode);
+	if (errorCode) {
+		return false;
+	}
+	// 元の画像がない（クックしたものだけを配る）場合はそのまま使う
+	const auto sourceTime = std::filesystem::last_write_time(sourcePath, errorCode);
+	if (errorCode) {
+		return true;
+	}
+	return cookedTime >= sourceTime;
+}
+
+uint32_t TextureCooker::GetDXGIFormat(BlockCompressor::Format format, bool isSrgb) {
+	// DXGI_FORMATの値（D3Dのヘッダーに依存しないように数値で持つ）
+	switch (format) {
+	case BlockCompressor::Format::BC1:
+		return isSrgb ? 72 : 71;	// BC1_UNORM_SRGB : BC1_UNORM
+	case BlockCompressor::Format::BC3:
+		return isSrgb ? 78 : 77;	// BC3_UNORM_SRGB : BC3_UNORM
+	case BlockCompressor::Format::BC5:
+		return 83;					// BC5_UNORM
+	case BlockCompressor::Format::BC7:
+	default:
+		return isSrgb ? 99 : 98;	// BC7_UNORM_SRGB : BC7_UNORM
+	}
+}
+
+const char* TextureCooker::GetFormatName(BlockCompressor::Format format) {
+	switch (format) {
+	case BlockCompressor::Format::BC1:
+		return "BC1";
+	case BlockCompressor::Format::BC3:
+		return "BC3";
+	case BlockCompressor::Format::BC5:
+		return "BC5";
+	case BlockCompressor::Format::BC7:
+	default:
+		return "BC7";
+	}
+}
+
+const char* TextureCooker::GetQualityName(BlockCompressor::Quality quality) {
+	switch (quality) {
+	case BlockCompressor::Quality::Fast:
+		return "Fast";
+	case BlockCompressor::Quality::High:
+		return "High";
+	case BlockCompressor::Quality::Normal:
+	default:
+		return "Normal";
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Managers/Texture/BlockCompressor.h"
+#include "Managers/Texture/MipGenerator.h"
+
+/// <summary>
+/// テクスチャを事前に変換して、ミップマップ込みのブロック圧縮したDDSファイルに書き出す（クック）
+/// 実行時はTextureがこのファイルを優先して読むので、デコード・ミップマップ生成・圧縮を毎回しなくて済む
+/// D3D・DirectXTexに依存しないので、画像のデコードさえ用意すればビルドマシンなどでも単体で動かせる
+/// </summary>
+class TextureCooker {
+public:
+	// クックしたファイルを置くフォルダ（元の画像と同じフォルダの下）
+	static constexpr const char* kCookedDirectory = "Cooked";
+
+	/// <summary>
+	/// テクスチャごとのクックの設定
+	/// </summary>
+	struct Settings {
+		BlockCompressor::Format format = BlockCompressor::Format::BC7;
+		BlockCompressor::Quality quality = BlockCompressor::Quality::Normal;
+		bool isSrgb = true;		// RGBをsRGBとして扱うか（BC5は常に線形）
+		MipGenerator::Filter mipFilter = MipGenerator::Filter::Kaiser;
+	};
+
+	/// <summary>
+	/// クックする画像（RGBA8、1段だけ）
+	/// </summary>
+	struct SourceImage {
+		const uint8_t* pixels = nullptr;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		size_t rowPitch = 0;
+	};
+
+	/// <summary>
+	/// クックの結果
+	/// </summary>
+	struct Result {
+		bool isSucceeded = false;
+		double psnr = 0.0;			// 1段目の元の画像と圧縮後のPSNR（dB、圧縮の形式で意味のあるチャンネルだけ）
+		uint64_t sourceBytes = 0;	// 元の画像（ミップマップ込み）のバイト数
+		uint64_t cookedBytes = 0;	// 書き出したファイルのバイト数
+		uint32_t mipLevels = 0;
+		std::string message;		// 失敗した理由
+	};
+
+	/// <summary>
+	/// 画像をクックしてファイルに書き出す（書き出し先のフォルダがなければ作る）
+	/// </summary>
+	/// <param name="source">元の画像（幅と高さは4の倍数）</param>
+	/// <param name="settings">設定</param>
+	/// <param name="outputPath">書き出すファイルのパス</param>
+	/// <param name="result">結果</param>
+	/// <returns>書き出せたかどうか</returns>
+	static bool Cook(const SourceImage& source, const Settings& settings, const std::string& outputPath, Result& result);
+
+	/// <summary>
+	/// 元の画像のパスからクックしたファイルのパスを作る（resources/uvChecker.png → resources/Cooked/uvChecker.dds）
+	/// </summary>
+	static std::string GetCookedPath(const std::string& sourcePath);
+
+	/// <summary>
+	/// クックしたファイルがあり、元の画像より新しいかどうか
+	/// </summary>
+	static bool IsCookedFileUpToDate(const std::string& sourcePath, const std::string& cookedPath);
+
+	/// <summary>
+	/// 書き出すDDSのDXGI_FORMATの値
+	/// </summary>
+	static uint32_t GetDXGIFormat(BlockCompressor::Format format, bool isSrgb);
+
+	/// <summary>
+	/// 表示用の名前
+	/// </summary>
+	static const char* GetFormatName(BlockCompressor::Format format);
+	static const char* GetQualityName(BlockCompressor::Quality quality);
+
+private:
+	TextureCooker() = delete;
+	~TextureCooker() = delete;
+};
@@ -1,4 +1,14 @@
 #include "TextureManager.h"
+#include "Managers/ImGui/ImGuiManager.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
+#include "BaseSystem/Hash/Hash.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <set>
 
 // シングルトンインスタンス
 TextureManager* TextureManager::GetInstance() {
@@ -13,6 +23,12 @@ TextureManager::~TextureManager() {
 void TextureManager::Initialize(DirectXCommon* dxCommon) {
 	dxCommon_ = dxCommon;
 
+	// 既定のテクスチャのハンドルは読み込む前に割り当てておく
+	defaultHandle_ = AcquireHandle(kDefaultTextureTag);
+
+	// 常駐させるテクスチャのメモリの予算
+	residency_.SetBudget(GraphicsConfig::kTextureMemoryBudget);
+
 	// 初期化できたらログを出す
 	Logger::Log(Logger::GetStream(), "Complete TextureManager initialized !!\n");
 }
@@ -30,12 +46,104 @@ bool TextureManager::LoadTexture(const std::string& filename, const std::string&
 		return true; // 既存のテクスチャを使用
 	}
 
+	// 中身が同じテクスチャを読み込み済みならそれを共有する
+	const uint64_t contentHash = ComputeContentHash(filename);
+	if (ShareTexture(tagName, filename, contentHash)) {
+		return true;
+	}
+
+	// テクスチャファイルを読み込み
+	DirectX::ScratchImage mipImages = Texture::LoadTextureFile(filename);
+	return CreateTexture(filename, tagName, mipImages, contentHash);
+}
+
+bool TextureManager::LoadTextures(const std::vector<TextureLoadDesc>& textures) {
+	// 読み込み済みのタグは飛ばす（ワーカースレッドからはマネージャーの中身を見ないように先に決めておく）
+	std::vector<uint8_t> needsLoad(textures.size(), 0);
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (HasTexture(textures[i].tagName)) {
+			Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' already exists. Skipping load.\n", textures[i].tagName));
+			continue;
+		}
+		needsLoad[i] = 1;
+	}
+
+	// 中身のハッシュもワーカースレッドで並列に計算する
+	std::vector<uint64_t> contentHashes(textures.size(), 0);
+	ThreadPool::GetInstance()->ParallelFor(static_cast<uint32_t>(textures.size()), [&](uint32_t i) {
+		if (needsLoad[i]) {
+			contentHashes[i] = ComputeContentHash(textures[i].filename);
+		}
+	});
+
+	// 読み込み済みのものと中身が同じなら共有し、まとまりの中で同じ中身のものは先のものだけを読み込む
+	constexpr size_t kNoSource = SIZE_MAX;
+	std::vector<size_t> sameContentSources(textures.size(), kNoSource);
+	std::unordered_map<uint64_t, size_t> firstIndices;
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (!needsLoad[i] || contentHashes[i] == 0) {
+			continue;
+		}
+		if (ShareTexture(textures[i].tagName, textures[i].filename, contentHashes[i])) {
+			needsLoad[i] = 0;
+			continue;
+		}
+		auto [it, isInserted] = firstIndices.try_emplace(contentHashes[i], i);
+		if (!isInserted) {
+			sameContentSources[i] = it->second;
+			needsLoad[i] = 0;
+		}
+	}
+
+	// ファイルの読み込みとミップマップ生成はCPUだけの重い処理なので、ワーカースレッドで並列に行う
+	std::vector<DirectX::ScratchImage> mipImages(textures.size());
+	ThreadPool::GetInstance()->ParallelFor(static_cast<uint32_t>(textures.size()), [&](uint32_t i) {
+		if (needsLoad[i]) {
+			mipImages[i] = Texture::LoadTextureFile(textures[i].filename);
+		}
+	});
+
+	// GPUのリソースとSRVはこのスレッドで作る（アップロードはまとめてフレームの終わりに送られる）
+	bool isAllLoaded = true;
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (sameContentSources[i] != kNoSource) {
+			// 先に作ったものを共有する（同じタグが重なっていた場合は先のものを使う）
+			if (!HasTexture(textures[i].tagName) && !ShareTexture(textures[i].tagName, textures[i].filename, contentHashes[i])) {
+				isAllLoaded = false;
+			}
+			continue;
+		}
+		if (needsLoad[i] && !CreateTexture(textures[i].filename, textures[i].tagName, mipImages[i], contentHashes[i])) {
+			isAllLoaded = false;
+		}
+	}
+	return isAllLoaded;
+}
+
+bool TextureManager::CreateTexture(const std::string& filename, const std::string& tagName, const DirectX::ScratchImage& mipImages,
+	uint64_t contentHash) {
+	// 読み込みに失敗した画像
+	if (mipImages.GetImageCount() == 0) {
+		return false;
+	}
+
+	// 同じまとまりの中で同じタグが重なっていた場合も先のものを使う
+	if (HasTexture(tagName)) {
+		Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' already exists. Skipping load.\n", tagName));
+		return true;
+	}
+
+	return CreateTextureEntry(filename, tagName, mipImages, contentHash).IsValid();
+}
+
+TextureManager::TextureSlot TextureManager::CreateTextureEntry(const std::string& filename, const std::string& tagName,
+	const DirectX::ScratchImage& mipImages, uint64_t contentHash) {
 	// DescriptorHeapManagerからSRVを割り当て
 	auto descriptorManager = dxCommon_->GetDescriptorManager();
 	if (!descriptorManager) {
 		// DescriptorManagerが無効な場合はログを出力
 		Logger::Log(Logger::GetStream(), "DescriptorManager is null\n");
-		return false;
+		return {};
 	}
 
 	// 使用可能なSRVスロットを割り当て
@@ -44,29 +152,72 @@ bool TextureManager::LoadTexture(const std::string& filename, const std::string&
 	if (!descriptorHandle.isValid) {
 		// SRVのヒープが最大値の場合はログを出力して失敗
 		Logger::Log(Logger::GetStream(), std::format("Failed to allocate SRV for texture '{}': No available slots.\n", filename));
-		return false;
+		return {};
 	}
 
 	// 新しいテクスチャを作成し、既に割り当てられたハンドルを使用
+	// 予算に収まるミップからGPUに置き、収まらない分は使われた時に読み込む
 	auto texture = std::make_unique<Texture>();
-	// テクスチャをロード
-	if (!texture->LoadTextureWithHandle(filename, dxCommon_, descriptorHandle)) {
-		// ロードに失敗した場合はSRVを解放
+	const TextureResidency::Handle residencyHandle = RegisterResidency(texture.get(), mipImages, true);
+	if (!texture->CreateFromImage(filename, mipImages, dxCommon_, descriptorHandle, residency_.GetResidentMip(residencyHandle))) {
+		// 作成に失敗した場合はSRVを解放
+		residency_.Unregister(residencyHandle);
 		descriptorManager->ReleaseSRV(descriptorHandle.index);
-		return false;
+		return {};
 	}
 
-	// マップに登録
-	textures_[tagName] = std::move(texture);
+	// 登録してタグ名と結び付ける
+	const TextureSlot slot = RegisterTexture(tagName, std::move(texture), residencyHandle, contentHash);
 
 	Logger::Log(Logger::GetStream(), std::format("Texture '{}' loaded successfully with tag '{}' (SRV Index: {})\n",filename, tagName, descriptorHandle.index));
+	return slot;
+}
+
+uint64_t TextureManager::ComputeContentHash(const std::string& filename) {
+	// マップしたものをそのままハッシュにかける（デコードより十分に速い）
+	const FileView file = VirtualFileSystem::GetInstance()->Open(filename);
+	if (!file.IsValid()) {
+		return 0;
+	}
+	return Hash::Content(file.GetData(), file.GetSize());
+}
+
+bool TextureManager::ShareTexture(const std::string& tagName, const std::string& filename, uint64_t contentHash) {
+	if (contentHash == 0) {
+		return false;
+	}
+	auto it = contentSlots_.find(contentHash);
+	if (it == contentSlots_.end()) {
+		return false;
+	}
+	TextureEntry* entry = textures_.Get(it->second);
+	if (!entry) {
+		return false;
+	}
+
+	// 同じスロットを指すので、どのタグのハンドルからも同じテクスチャとSRVを引く
+	// ファイルはタグごとに覚えておく（後でどちらかのファイルだけが書き換えられた時に分けられるように）
+	entry->tags.push_back({ tagName, filename });
+	textureTable_.Set(StringId::Intern(tagName), it->second);
+
+	Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' has the same content as '{}'. Sharing it ({} tags).\n",
+		tagName, entry->tags.front().tagName, entry->tags.size()));
 	return true;
 }
 
 Texture* TextureManager::GetTexture(const std::string& tagName) {
-	auto it = textures_.find(tagName);
-	if (it != textures_.end()) {
-		return it->second.get();
+	// ハンドルの表から引く（アトラスにまとめたものはページのテクスチャが入っている）
+	const StringId tagId(tagName);
+	TextureEntry* entry = FindEntry(tagId);
+	if (entry) {
+		return entry->texture.get();
+	}
+
+	// 解放済みのものを使おうとしている場合は区別してログを出す
+	if (textures_.IsStale(textureTable_.Get(textureTable_.Find(tagId)))) {
+		Logger::Log(Logger::GetStream(),
+			std::format("Texture with tag '{}' was already unloaded.\n", tagName));
+		return nullptr;
 	}
 
 	// テクスチャが見つからない場合はnullptr
@@ -78,6 +229,7 @@ Texture* TextureManager::GetTexture(const std::string& tagName) {
 D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetTextureHandle(const std::string& tagName) {
 	Texture* texture = GetTexture(tagName);
 	if (texture) {
+		MarkUsed(*FindEntry(StringId(tagName)));
 		return texture->GetGPUHandle();
 	}
 
@@ -86,42 +238,417 @@ D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetTextureHandle(const std::string&
 	return invalidHandle;
 }
 
+uint32_t TextureManager::GetTextureIndex(const std::string& tagName) {
+	Texture* texture = GetTexture(tagName);
+	if (texture) {
+		MarkUsed(*FindEntry(StringId(tagName)));
+		return texture->GetSRVIndex();
+	}
+	return UINT32_MAX;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetTextureHandle(TextureHandle handle) {
+	const TextureEntry* entry = textures_.Get(textureTable_.Get(handle.index));
+	if (entry) {
+		MarkUsed(*entry);
+		return entry->texture->GetGPUHandle();
+	}
+	return D3D12_GPU_DESCRIPTOR_HANDLE{};
+}
+
+uint32_t TextureManager::GetTextureIndex(TextureHandle handle) {
+	const TextureEntry* entry = textures_.Get(textureTable_.Get(handle.index));
+	if (entry) {
+		MarkUsed(*entry);
+		return entry->texture->GetSRVIndex();
+	}
+	return UINT32_MAX;
+}
+
+///*-----------------------------------------------------------------------*///
+//						常駐メモリの管理（ストリーミング）							//
+///*-----------------------------------------------------------------------*///
+
+void TextureManager::UpdateResidency() {
+	const uint64_t frame = dxCommon_->GetFrameCount();
+	ReleaseRetiredResources();
+
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> retiredResources;
+
+	// ワーカースレッドで読み終わったものは、読み込んだ画像で詳細なミップを置いたリソースに作り直す
+	std::erase_if(pendingStreamIns_, [this, &retiredResources](PendingStreamIn& pending) {
+		if (pending.decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return false;
+		}
+		pending.texture->ChangeResidentMip(pending.residentMip, dxCommon_, retiredResources, pending.mipImages.get());
+		residency_.SetResidentMip(pending.residencyHandle, pending.texture->GetResidentMip());
+		return true;
+	});
+
+	for (const TextureResidency::Change& change : residency_.Update(frame)) {
+		// 登録時にテクスチャのポインタを識別子にしている（解放時に登録を外すので必ず生きている）
+		Texture* texture = reinterpret_cast<Texture*>(change.key);
+
+		// 読み込み中のものは新しい判断を優先して取りやめる
+		CancelStreamIn(texture);
+
+		if (change.residentMip < texture->GetResidentMip()) {
+			// 詳細にする時はファイルの読み込みとミップマップ生成をワーカースレッドで行い、読み終わったフレームで作り直す
+			// それまでは常駐しているものとして数えておく（読み込み中に同じテクスチャを何度も要求しないように）
+			auto mipImages = std::make_shared<DirectX::ScratchImage>();
+			std::future<void> decoded = ThreadPool::GetInstance()->Submit([mipImages, filePath = texture->GetFilePath()]() {
+				*mipImages = Texture::LoadTextureFile(filePath);
+			});
+			pendingStreamIns_.push_back({ texture, change.handle, change.residentMip, std::move(mipImages), std::move(decoded) });
+			continue;
+		}
+
+		// 粗くする時はGPU上のコピーだけなのでその場で作り直す
+		texture->ChangeResidentMip(change.residentMip, dxCommon_, retiredResources);
+
+		// 作り直せなかった場合は実際に置いているミップに合わせる
+		residency_.SetResidentMip(change.handle, texture->GetResidentMip());
+	}
+
+	for (auto& resource : retiredResources) {
+		retiredResources_.push_back({ std::move(resource), frame });
+	}
+}
+
+TextureResidency::Handle TextureManager::RegisterResidency(const Texture* texture, const DirectX::ScratchImage& mipImages, bool isStreamable) {
+	const DirectX::TexMetadata& metadata = mipImages.GetMetadata();
+	uint32_t tailMip = 0;
+	if (isStreamable && Texture::CanStream(metadata)) {
+		tailMip = TextureResidency::ComputeTailMip(static_cast<uint32_t>(metadata.width), static_cast<uint32_t>(metadata.height),
+			static_cast<uint32_t>(metadata.mipLevels), GraphicsConfig::kTextureTailSize);
+		// ブロック圧縮のものは4の倍数の大きさの段までしか落とせない
+		tailMip = (std::min)(tailMip, Texture::GetMaxResidentMip(metadata));
+	}
+	return residency_.Register(reinterpret_cast<uint64_t>(texture), Texture::ComputeMipSizes(mipImages), tailMip);
+}
+
+void TextureManager::CancelStreamIn(const Texture* texture) {
+	// 読み込み中のジョブは止められないので結果を捨てるだけ（画像はジョブが持っているので先に消してよい）
+	std::erase_if(pendingStreamIns_, [texture](const PendingStreamIn& pending) {
+		return pending.texture == texture;
+	});
+}
+
+void TextureManager::ReleaseRetiredResources() {
+	// DirectXCommon::kFrameCountフレーム前のものはGPUが使い終わっている
+	const uint64_t frame = dxCommon_->GetFrameCount();
+	std::erase_if(retiredResources_, [frame](const RetiredResource& retired) {
+		return retired.frame + DirectXCommon::kFrameCount <= frame;
+	});
+}
+
+///*-----------------------------------------------------------------------*///
+//						ホットリロード											//
+///*-----------------------------------------------------------------------*///
+
+uint32_t TextureManager::ReloadTextureFile(const std::string& filename) {
+	// 読み込んだ時のパスと書き方が違っても同じファイルとして扱う
+	const std::string normalizedPath = AssetPack::NormalizePath(filename);
+	auto isChanged = [&normalizedPath](const TextureTag& tag) {
+		return AssetPack::NormalizePath(tag.filePath) == normalizedPath;
+	};
+
+	// 書き換えたファイルのタグを持つものを先に集める（分ける時にテクスチャを追加するので、回しながらは変えない）
+	std::vector<TextureSlot> slots;
+	std::string filePath;
+	for (size_t i = 0; i < textures_.GetSize(); ++i) {
+		const TextureSlot slot = textures_.GetHandle(i);
+		const std::vector<TextureTag>& tags = textures_.Get(slot)->tags;
+		auto it = std::find_if(tags.begin(), tags.end(), isChanged);
+		if (it != tags.end()) {
+			slots.push_back(slot);
+			filePath = it->filePath;
+		}
+	}
+	if (slots.empty()) {
+		return 0;
+	}
+
+	// 同じファイルを別のタグで読み込んでいる場合も、読むのは1回だけ
+	const DirectX::ScratchImage mipImages = Texture::LoadTextureFile(filePath);
+	if (mipImages.GetImageCount() == 0) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to reload texture file: {}\n", filename));
+		return 0;
+	}
+
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> retiredResources;
+	uint32_t reloadedCount = 0;
+
+	for (const TextureSlot& slot : slots) {
+		TextureEntry* entry = textures_.Get(slot);
+		if (!std::all_of(entry->tags.begin(), entry->tags.end(), isChanged)) {
+			// 別のファイルのタグと中身が同じで共有していた場合は、書き換えたファイルのタグだけを新しいテクスチャに分ける
+			std::vector<TextureTag> changedTags;
+			std::copy_if(entry->tags.begin(), entry->tags.end(), std::back_inserter(changedTags), isChanged);
+			const TextureSlot newSlot = CreateTextureEntry(changedTags.front().filePath, changedTags.front().tagName, mipImages, 0);
+			if (!newSlot.IsValid()) {
+				continue;
+			}
+			TextureEntry* newEntry = textures_.Get(newSlot);
+			for (size_t i = 1; i < changedTags.size(); ++i) {
+				newEntry->tags.push_back(changedTags[i]);
+				textureTable_.Set(StringId::Intern(changedTags[i].tagName), newSlot);
+			}
+
+			// 追加で配列が動くので取り直してから、残ったタグのファイルを読むようにする
+			entry = textures_.Get(slot);
+			std::erase_if(entry->tags, isChanged);
+			if (entry->texture->GetFilePath() != entry->tags.front().filePath) {
+				// 書き換えたファイルから詳細なミップを読み込み中なら結果を捨てる
+				CancelStreamIn(entry->texture.get());
+				residency_.SetResidentMip(entry->residencyHandle, entry->texture->GetResidentMip());
+				entry->texture->SetFilePath(entry->tags.front().filePath);
+			}
+
+			Logger::Log(Logger::GetStream(), std::format("Texture file '{}' changed. Split {} tags from '{}' into a new texture.\n",
+				filename, changedTags.size(), entry->tags.front().tagName));
+			++reloadedCount;
+			continue;
+		}
+
+		// 古い画像の詳細なミップを読み込み中なら結果を捨てる
+		Texture* texture = entry->texture.get();
+		CancelStreamIn(texture);
+
+		// 大きさが変わることもあるので常駐メモリの管理に登録し直し、置くミップを決め直す
+		const TextureResidency::Handle residencyHandle = RegisterResidency(texture, mipImages, true);
+		if (!texture->Reload(mipImages, residency_.GetResidentMip(residencyHandle), dxCommon_, retiredResources)) {
+			residency_.Unregister(residencyHandle);
+			continue;
+		}
+		residency_.Unregister(entry->residencyHandle);
+		entry->residencyHandle = residencyHandle;
+		residency_.SetResidentMip(residencyHandle, texture->GetResidentMip());
+
+		// 中身が変わったので、これから読み込む元の中身のものとは共有しない
+		if (entry->contentHash != 0) {
+			contentSlots_.erase(entry->contentHash);
+			entry->contentHash = 0;
+		}
+		++reloadedCount;
+	}
+
+	const uint64_t frame = dxCommon_->GetFrameCount();
+	for (auto& resource : retiredResources) {
+		retiredResources_.push_back({ std::move(resource), frame });
+	}
+	return reloadedCount;
+}
+
+///*-----------------------------------------------------------------------*///
+//						クック（事前のブロック圧縮）								//
+///*-----------------------------------------------------------------------*///
+
+bool TextureManager::CookTextures(const std::vector<TextureCookDesc>& textures) {
+	// 画像のデコードはワーカースレッドで並列に行う
+	std::vector<DirectX::ScratchImage> images(textures.size());
+	std::vector<uint8_t> isDecoded(textures.size(), 0);
+	ThreadPool::GetInstance()->ParallelFor(static_cast<uint32_t>(textures.size()), [&](uint32_t i) {
+		isDecoded[i] = LoadSourceImageRGBA8(textures[i].filename, images[i]) ? 1 : 0;
+	});
+
+	// 圧縮は1枚ずつ（ブロックの行をワーカースレッドで分け合う）
+	bool isAllCooked = true;
+	cookRecords_.clear();
+	for (size_t i = 0; i < textures.size(); ++i) {
+		const TextureCookDesc& desc = textures[i];
+		SetCookSettings(desc.filename, desc.settings);
+
+		CookRecord record{ desc.filename, desc.settings, {} };
+		if (!isDecoded[i]) {
+			record.result.message = "failed to load source image";
+		} else {
+			const DirectX::Image& image = *images[i].GetImage(0, 0, 0);
+			TextureCooker::SourceImage source;
+			source.pixels = image.pixels;
+			source.width = static_cast<uint32_t>(image.width);
+			source.height = static_cast<uint32_t>(image.height);
+			source.rowPitch = image.rowPitch;
+			TextureCooker::Cook(source, desc.settings, TextureCooker::GetCookedPath(desc.filename), record.result);
+		}
+
+		if (record.result.isSucceeded) {
+			Logger::Log(Logger::GetStream(), std::format("Cooked texture: {} ({} {}, PSNR {:.2f} dB, {} KB -> {} KB)\n",
+				desc.filename, TextureCooker::GetFormatName(desc.settings.format), TextureCooker::GetQualityName(desc.settings.quality),
+				record.result.psnr, record.result.sourceBytes / 1024, record.result.cookedBytes / 1024));
+		} else {
+			Logger::Log(Logger::GetStream(), std::format("Failed to cook texture: {} ({})\n", desc.filename, record.result.message));
+			isAllCooked = false;
+		}
+		cookRecords_.push_back(std::move(record));
+	}
+	return isAllCooked;
+}
+
+bool TextureManager::CookLoadedTextures() {
+	// ファイルから読んだもの（アトラスのページはファイルがない）を、同じファイルは1回だけ
+	std::set<std::string> filenames;
+	for (const TextureEntry& entry : textures_) {
+		for (const TextureTag& tag : entry.tags) {
+			std::error_code errorCode;
+			if (std::filesystem::is_regular_file(tag.filePath, errorCode)) {
+				filenames.insert(tag.filePath);
+			}
+		}
+	}
+
+	std::vector<TextureCookDesc> textures;
+	textures.reserve(filenames.size());
+	for (const std::string& filename : filenames) {
+		textures.push_back({ filename, GetCookSettings(filename) });
+	}
+	return CookTextures(textures);
+}
+
+TextureCooker::Settings TextureManager::GetCookSettings(const std::string& filename) const {
+	auto it = cookSettings_.find(filename);
+	if (it != cookSettings_.end()) {
+		return it->second;
+	}
+	return defaultCookSettings_;
+}
+
+void TextureManager::ImGui() {
+#ifdef _DEBUG
+	if (ImGui::TreeNode("Texture Residency")) {
+		constexpr uint64_t kMegabyte = 1024 * 1024;
+		const TextureResidency::Statistics statistics = residency_.GetStatistics();
+
+		int budgetMegabytes = static_cast<int>(statistics.budgetBytes / kMegabyte);
+		if (ImGui::SliderInt("Budget (MB)", &budgetMegabytes, 1, 2048)) {
+			SetMemoryBudget(static_cast<uint64_t>(budgetMegabytes) * kMegabyte);
+		}
+		ImGui::Text("Resident: %.1f / %.1f MB", static_cast<double>(statistics.residentBytes) / kMegabyte,
+			static_cast<double>(statistics.budgetBytes) / kMegabyte);
+		ImGui::Text("Textures: %u (reduced %u)", statistics.textureCount, statistics.reducedCount);
+		ImGui::Text("Last update: streamed in %u / evicted %u", statistics.streamedInCount, statistics.evictedCount);
+		ImGui::Text("Loading on workers: %u", static_cast<uint32_t>(pendingStreamIns_.size()));
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Texture Cook")) {
+		// 設定していないテクスチャに使う設定
+		int format = static_cast<int>(defaultCookSettings_.format);
+		if (ImGui::Combo("Format", &format, "BC1\0BC3\0BC5\0BC7\0")) {
+			defaultCookSettings_.format = static_cast<BlockCompressor::Format>(format);
+		}
+		int quality = static_cast<int>(defaultCookSettings_.quality);
+		if (ImGui::Combo("Quality", &quality, "Fast\0Normal\0High\0")) {
+			defaultCookSettings_.quality = static_cast<BlockCompressor::Quality>(quality);
+		}
+		ImGui::Checkbox("sRGB", &defaultCookSettings_.isSrgb);
+
+		// 反映されるのは次に読み込んだ時から
+		if (ImGui::Button("Cook loaded textures")) {
+			CookLoadedTextures();
+		}
+
+		for (const CookRecord& record : cookRecords_) {
+			if (record.result.isSucceeded) {
+				ImGui::Text("%s: %s %s, PSNR %.2f dB, %llu KB -> %llu KB", record.filename.c_str(),
+					TextureCooker::GetFormatName(record.settings.format), TextureCooker::GetQualityName(record.settings.quality),
+					record.result.psnr, static_cast<unsigned long long>(record.result.sourceBytes / 1024),
+					static_cast<unsigned long long>(record.result.cookedBytes / 1024));
+			} else {
+				ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s: %s", record.filename.c_str(), record.result.message.c_str());
+			}
+		}
+		ImGui::TreePop();
+	}
+#endif
+}
+
 void TextureManager::UnloadTexture(const std::string& tagName) {
-	auto textureIt = textures_.find(tagName);
-	if (textureIt != textures_.end()) {
-		// テクスチャをアンロード（内部でSRVも解放される）
-		textureIt->second->Unload(dxCommon_);
+	const StringId tagId(tagName);
 
-		// マップから削除
-		textures_.erase(textureIt);
+	// アトラスの領域は登録を消すだけ（ページは他の領域が使っている）
+	if (atlasRegions_.erase(tagName) > 0) {
+		textureTable_.Reset(tagId);
+		Logger::Log(Logger::GetStream(), std::format("Atlas region with tag '{}' unloaded.\n", tagName));
+		return;
+	}
+
+	TextureEntry* entry = FindEntry(tagId);
+	if (!entry) {
+		return;
+	}
 
-		Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' unloaded.\n", tagName));
+	// 中身が同じで共有している他のタグが残っていれば、このタグを外すだけ
+	if (entry->tags.size() > 1) {
+		std::erase_if(entry->tags, [&tagName](const TextureTag& tag) {
+			return tag.tagName == tagName;
+		});
+		// 先頭のタグを外した場合は、詳細なミップを残ったタグのファイルから読む
+		entry->texture->SetFilePath(entry->tags.front().filePath);
+		textureTable_.Reset(tagId);
+		Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' unloaded ({} tags still share it).\n",
+			tagName, entry->tags.size()));
+		return;
 	}
+
+	// テクスチャをアンロード（内部でSRVも解放される）
+	CancelStreamIn(entry->texture.get());
+	entry->texture->Unload(dxCommon_);
+	residency_.Unregister(entry->residencyHandle);
+	if (entry->contentHash != 0) {
+		contentSlots_.erase(entry->contentHash);
+	}
+
+	// 削除（スロットの世代が進むので、表に残ったハンドルやアトラスの領域から引いてもnullptrになる）
+	textures_.Erase(textureTable_.Get(textureTable_.Find(tagId)));
+
+	// アトラスのページならそこにまとめていた領域も消す
+	std::erase_if(atlasRegions_, [&tagName](const auto& pair) {
+		return pair.second.pageTag == tagName;
+	});
+
+	Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' unloaded.\n", tagName));
+}
+
+uint32_t TextureManager::GetReferenceCount(const std::string& tagName) const {
+	const TextureEntry* entry = FindEntry(StringId(tagName));
+	return entry ? static_cast<uint32_t>(entry->tags.size()) : 0;
 }
 
 void TextureManager::UnloadAll() {
 	// 全てのテクスチャを解放
-	for (const auto& pair : textures_) {
+	for (const TextureEntry& entry : textures_) {
 		Logger::Log(Logger::GetStream(),
-			std::format("Unloading texture: {}\n", pair.first));
-		pair.second->Unload(dxCommon_);
+			std::format("Unloading texture: {}\n", entry.tags.front().tagName));
+		entry.texture->Unload(dxCommon_);
 	}
 
-	textures_.clear();
+	// 全てのスロットの世代が進むので、表に残ったハンドルは全てnullptrになる
+	pendingStreamIns_.clear();
+	textures_.Clear();
+	contentSlots_.clear();
+	atlasRegions_.clear();
+	residency_.Clear();
+	retiredResources_.clear();
 
 	Logger::Log(Logger::GetStream(), "All textures unloaded.\n");
 }
 
 bool TextureManager::HasTexture(const std::string& tagName) const {
-	// 指定されたタグ名のテクスチャが存在するかチェック
-	return textures_.find(tagName) != textures_.end();
+	// 指定されたタグ名のテクスチャが存在するかチェック（アトラスの領域も表に入っている）
+	return FindEntry(StringId(tagName)) != nullptr;
 }
 
 std::vector<std::string> TextureManager::GetTextureTagList() const {
 	std::vector<std::string> tagList;
-	tagList.reserve(textures_.size()); // メモリの効率化
+	tagList.reserve(textures_.GetSize() + atlasRegions_.size()); // メモリの効率化
 
-	for (const auto& pair : textures_) {
+	for (const TextureEntry& entry : textures_) {
+		for (const TextureTag& tag : entry.tags) {
+			tagList.push_back(tag.tagName);
+		}
+	}
+	for (const auto& pair : atlasRegions_) {
 		tagList.push_back(pair.first);
 	}
 	// アルファベット順にソート
@@ -131,6 +658,211 @@ std::vector<std::string> TextureManager::GetTextureTagList() const {
 }
 
 
+///*-----------------------------------------------------------------------*///
+//								アトラス											//
+///*-----------------------------------------------------------------------*///
+
+bool TextureManager::LoadTexturesToAtlas(const std::string& atlasName, const std::vector<AtlasTextureDesc>& textures,
+	uint32_t pageSize, uint32_t padding) {
+	bool isAllLoaded = true;
+
+	// 画像をCPU側に読み込む（読み込み済みのタグと読めなかったものは大きさ0にして詰めない）
+	std::vector<uint8_t> needsLoad(textures.size(), 0);
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (HasTexture(textures[i].tagName)) {
+			Logger::Log(Logger::GetStream(), std::format("Texture with tag '{}' already exists. Skipping load.\n", textures[i].tagName));
+			continue;
+		}
+		needsLoad[i] = 1;
+	}
+
+	// ファイルの読み込みと形式の変換はワーカースレッドで並列に行う
+	std::vector<DirectX::ScratchImage> images(textures.size());
+	std::vector<uint8_t> isDecoded(textures.size(), 0);
+	ThreadPool::GetInstance()->ParallelFor(static_cast<uint32_t>(textures.size()), [&](uint32_t i) {
+		if (needsLoad[i]) {
+			isDecoded[i] = LoadSourceImageRGBA8(textures[i].filename, images[i]) ? 1 : 0;
+		}
+	});
+
+	std::vector<AtlasPacker::Item> items(textures.size());
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (!needsLoad[i]) {
+			continue;
+		}
+		if (!isDecoded[i]) {
+			isAllLoaded = false;
+			continue;
+		}
+		const DirectX::TexMetadata& metadata = images[i].GetMetadata();
+		items[i] = { static_cast<uint32_t>(metadata.width), static_cast<uint32_t>(metadata.height) };
+	}
+
+	// ページに詰める（同じ画像の組なら毎回同じ配置になる）
+	AtlasPacker packer;
+	packer.Initialize(pageSize, pageSize, padding);
+	std::vector<AtlasPacker::Placement> placements;
+	packer.Pack(items, placements);
+
+	// ページの画像を作ってコピー
+	std::vector<DirectX::ScratchImage> pages(packer.GetPageCount());
+	for (DirectX::ScratchImage& page : pages) {
+		page.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, pageSize, pageSize, 1, 1);
+		std::memset(page.GetPixels(), 0, page.GetPixelsSize());
+	}
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (placements[i].page != AtlasPacker::kInvalidPage) {
+			CopyToAtlasPage(*images[i].GetImage(0, 0, 0), *pages[placements[i].page].GetImage(0, 0, 0), placements[i].rect, padding);
+		} else if (items[i].width > 0) {
+			// ページに入らないものは単体で読み込む
+			Logger::Log(Logger::GetStream(), std::format("Atlas '{}': '{}' does not fit in a page. Loading it as a single texture.\n", atlasName, textures[i].tagName));
+			if (!LoadTexture(textures[i].filename, textures[i].tagName)) {
+				isAllLoaded = false;
+			}
+		}
+	}
+
+	// 同じ名前のアトラスに後から足した場合は続きの番号のページにする
+	uint32_t pageBase = 0;
+	while (HasTexture(std::format("{}_page{}", atlasName, pageBase))) {
+		++pageBase;
+	}
+
+	// ページごとにテクスチャを作る
+	// ミップマップは余白で隣の画像が混ざらない段数まで（余白2ピクセルなら2段）
+	const size_t mipLevels = 1 + static_cast<size_t>(std::floor(std::log2(static_cast<float>((std::max)(padding, 1u)))));
+	std::vector<bool> isPageCreated(pages.size(), false);
+	for (uint32_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+		const std::string pageTag = std::format("{}_page{}", atlasName, pageBase + pageIndex);
+		// 余白より外に広がらないように2x2の平均で作る
+		DirectX::ScratchImage mipImages{};
+		if (!Texture::GenerateMipChain(pages[pageIndex], MipGenerator::Filter::Box, mipLevels, mipImages)) {
+			Logger::Log(Logger::GetStream(), std::format("Failed to generate mipmaps for atlas page: {}\n", pageTag));
+			isAllLoaded = false;
+			continue;
+		}
+		isPageCreated[pageIndex] = CreateAtlasPageTexture(pageTag, mipImages);
+		if (!isPageCreated[pageIndex]) {
+			isAllLoaded = false;
+		}
+	}
+
+	// 領域を登録
+	const float inversePageSize = 1.0f / static_cast<float>(pageSize);
+	uint32_t regionCount = 0;
+	for (size_t i = 0; i < textures.size(); ++i) {
+		const AtlasPacker::Placement& placement = placements[i];
+		if (placement.page == AtlasPacker::kInvalidPage || !isPageCreated[placement.page]) {
+			continue;
+		}
+		AtlasRegion& region = atlasRegions_[textures[i].tagName];
+		region.pageTag = std::format("{}_page{}", atlasName, pageBase + placement.page);
+		region.uvOffset = { static_cast<float>(placement.rect.x) * inversePageSize, static_cast<float>(placement.rect.y) * inversePageSize };
+		region.uvScale = { static_cast<float>(placement.rect.width) * inversePageSize, static_cast<float>(placement.rect.height) * inversePageSize };
+		region.width = placement.rect.width;
+		region.height = placement.rect.height;
+		textureTable_.Set(StringId::Intern(textures[i].tagName), textureTable_.Get(textureTable_.Find(StringId(region.pageTag))));
+		++regionCount;
+	}
+
+	Logger::Log(Logger::GetStream(), std::format("Atlas '{}': packed {} textures into {} pages ({}x{})\n",
+		atlasName, regionCount, pages.size(), pageSize, pageSize));
+	return isAllLoaded;
+}
+
+const AtlasRegion* TextureManager::GetAtlasRegion(const std::string& tagName) const {
+	auto it = atlasRegions_.find(tagName);
+	if (it != atlasRegions_.end()) {
+		return &it->second;
+	}
+	return nullptr;
+}
+
+bool TextureManager::LoadSourceImageRGBA8(const std::string& filename, DirectX::ScratchImage& image) {
+	const FileView file = VirtualFileSystem::GetInstance()->Open(filename);
+	HRESULT hr = file.IsValid() ?
+		DirectX::LoadFromWICMemory(file.GetData(), file.GetSize(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image) : E_FAIL;
+	if (FAILED(hr)) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to load texture: {}\n", filename));
+		return false;
+	}
+
+	// ページ・クックで扱う形式にそろえる
+	if (image.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) {
+		DirectX::ScratchImage converted{};
+		hr = DirectX::Convert(*image.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+			DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+		if (FAILED(hr)) {
+			Logger::Log(Logger::GetStream(), std::format("Failed to convert texture to RGBA8: {}\n", filename));
+			return false;
+		}
+		image = std::move(converted);
+	}
+	return true;
+}
+
+void TextureManager::CopyToAtlasPage(const DirectX::Image& source, const DirectX::Image& page, const AtlasRect& rect, uint32_t padding) {
+	const size_t kPixelSize = 4;
+	auto pagePixel = [&page](uint32_t x, uint32_t y) {
+		return page.pixels + y * page.rowPitch + x * kPixelSize;
+	};
+
+	// 画像本体と左右の余白（端のピクセルを伸ばす）
+	for (uint32_t y = 0; y < rect.height; ++y) {
+		const uint8_t* sourceRow = source.pixels + y * source.rowPitch;
+		std::memcpy(pagePixel(rect.x, rect.y + y), sourceRow, rect.width * kPixelSize);
+		for (uint32_t i = 1; i <= padding; ++i) {
+			std::memcpy(pagePixel(rect.x - i, rect.y + y), sourceRow, kPixelSize);
+			std::memcpy(pagePixel(rect.x + rect.width - 1 + i, rect.y + y), sourceRow + (rect.width - 1) * kPixelSize, kPixelSize);
+		}
+	}
+
+	// 上下の余白（余白込みの端の行をコピー）
+	const uint32_t left = rect.x - padding;
+	const size_t paddedRowSize = (rect.width + padding * 2) * kPixelSize;
+	for (uint32_t i = 1; i <= padding; ++i) {
+		std::memcpy(pagePixel(left, rect.y - i), pagePixel(left, rect.y), paddedRowSize);
+		std::memcpy(pagePixel(left, rect.y + rect.height - 1 + i), pagePixel(left, rect.y + rect.height - 1), paddedRowSize);
+	}
+}
+
+bool TextureManager::CreateAtlasPageTexture(const std::string& pageTag, const DirectX::ScratchImage& mipImages) {
+	auto descriptorManager = dxCommon_->GetDescriptorManager();
+	if (!descriptorManager) {
+		Logger::Log(Logger::GetStream(), "DescriptorManager is null\n");
+		return false;
+	}
+
+	auto descriptorHandle = descriptorManager->AllocateSRV();
+	if (!descriptorHandle.isValid) {
+		Logger::Log(Logger::GetStream(), std::format("Failed to allocate SRV for atlas page '{}': No available slots.\n", pageTag));
+		return false;
+	}
+
+	// ページはファイルから読み直せないので、常に全てのミップを置く（メモリの集計には入れる）
+	auto texture = std::make_unique<Texture>();
+	const TextureResidency::Handle residencyHandle = RegisterResidency(texture.get(), mipImages, false);
+	if (!texture->CreateFromImage(pageTag, mipImages, dxCommon_, descriptorHandle)) {
+		residency_.Unregister(residencyHandle);
+		descriptorManager->ReleaseSRV(descriptorHandle.index);
+		return false;
+	}
+
+	RegisterTexture(pageTag, std::move(texture), residencyHandle);
+	return true;
+}
+
+TextureManager::TextureSlot TextureManager::RegisterTexture(const std::string& tagName, std::unique_ptr<Texture> texture,
+	TextureResidency::Handle residencyHandle, uint64_t contentHash) {
+	const std::string filePath = texture->GetFilePath();
+	const TextureSlot slot = textures_.Insert({ { { tagName, filePath } }, std::move(texture), residencyHandle, contentHash });
+	textureTable_.Set(StringId::Intern(tagName), slot);
+	if (contentHash != 0) {
+		contentSlots_[contentHash] = slot;
+	}
+	return slot;
+}
+
 uint32_t TextureManager::GetAvailableSRVCount() const {
 	auto descriptorManager = dxCommon_->GetDescriptorManager();
 	if (descriptorManager) {
@@ -2,22 +2,66 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <memory>
+#include <future>
 #include <vector>
 #include <cassert>
 #include <algorithm>
 
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "BaseSystem/Logger/Logger.h"
+#include "BaseSystem/Hash/StringIdTable.h"
+#include "BaseSystem/Container/SlotMap.h"
 #include "Managers/Texture/Texture.h"
+#include "Managers/Texture/AtlasPacker.h"
+#include "Managers/Texture/TextureResidency.h"
+#include "Managers/Texture/TextureCooker.h"
 
 class DirectXCommon;
 
+// テクスチャのハンドル（タグ名に割り当てた番号。描画ではこれで引く）
+using TextureHandle = ResourceHandle<struct TextureHandleTag>;
+
+/// <summary>
+/// アトラスにまとめたテクスチャのページ上の領域
+/// </summary>
+struct AtlasRegion {
+	std::string pageTag;			// 実際のテクスチャ（アトラスのページ）のタグ名
+	Vector2 uvOffset{ 0.0f, 0.0f };	// ページ上の左上のUV
+	Vector2 uvScale{ 1.0f, 1.0f };	// ページ上の大きさ（UV）
+	uint32_t width = 0;				// 元の画像の幅（ピクセル）
+	uint32_t height = 0;			// 元の画像の高さ（ピクセル）
+};
+
+/// <summary>
+/// まとめて読み込むテクスチャ（LoadTextures・LoadTexturesToAtlas用）
+/// </summary>
+struct TextureLoadDesc {
+	std::string filename;	// テクスチャファイルのパス
+	std::string tagName;	// 識別用のタグ名
+};
+using AtlasTextureDesc = TextureLoadDesc;
+
+/// <summary>
+/// クックするテクスチャ（CookTextures用）
+/// </summary>
+struct TextureCookDesc {
+	std::string filename;				// 元の画像のパス
+	TextureCooker::Settings settings;	// 圧縮の形式と品質
+};
+
 /// <summary>
 /// テクスチャを管理する管理クラス
 /// </summary>
 class TextureManager {
 public:
+	// テクスチャがない時に使うテクスチャのタグ名（Engineが最初に読み込む）
+	static constexpr const char* kDefaultTextureTag = "white";
+	// アトラスのページの大きさと画像の周りの余白の既定値
+	static const uint32_t kDefaultAtlasPageSize = 1024;
+	static const uint32_t kDefaultAtlasPadding = 2;
+
 	//シングルトン
 	static TextureManager* GetInstance();
 
@@ -34,6 +78,7 @@ public:
 
 	/// <summary>
 	/// テクスチャの読み込み
+	/// ファイルの中身のハッシュが同じテクスチャを読み込み済みなら、読み込まずにそれを共有する（別のフォルダに同じ画像がある場合など）
 	/// </summary>
 	/// <param name="filename">テクスチャファイルのパス</param>
 	/// <param name="tagName">識別用のタグ名</param>
@@ -41,7 +86,37 @@ public:
 	bool LoadTexture(const std::string& filename, const std::string& tagName);
 
 	/// <summary>
-	/// テクスチャの取得
+	/// 複数のテクスチャをまとめて読み込む
+	/// ファイルの読み込みとミップマップ生成はワーカースレッドで並列に行い、GPUのリソースはこのスレッドで作る
+	/// 中身が同じものは（まとまりの中同士でも）1回だけ読み込んで共有する
+	/// </summary>
+	/// <param name="textures">読み込むテクスチャ一覧</param>
+	/// <returns>全て読み込めたかどうか</returns>
+	bool LoadTextures(const std::vector<TextureLoadDesc>& textures);
+
+	/// <summary>
+	/// 小さなテクスチャをアトラスのページにまとめて読み込む（UIのアイコンなど）
+	/// 各タグはGetTextureHandleでページのハンドルを返し、GetAtlasRegionでページ上のUV矩形を返す
+	/// ページはatlasName_page0, atlasName_page1...のタグで登録される
+	/// ページに入らない大きさのものは単体のテクスチャとして読み込む
+	/// </summary>
+	/// <param name="atlasName">アトラスの名前</param>
+	/// <param name="textures">読み込むテクスチャ一覧</param>
+	/// <param name="pageSize">ページの一辺（ピクセル）</param>
+	/// <param name="padding">画像の周りの余白（端のピクセルで埋める）</param>
+	/// <returns>全て読み込めたかどうか</returns>
+	bool LoadTexturesToAtlas(const std::string& atlasName, const std::vector<AtlasTextureDesc>& textures,
+		uint32_t pageSize = kDefaultAtlasPageSize, uint32_t padding = kDefaultAtlasPadding);
+
+	/// <summary>
+	/// アトラス上の領域を取得
+	/// </summary>
+	/// <param name="tagName">識別用のタグ名</param>
+	/// <returns>アトラスにまとめたものなら領域、単体のテクスチャならnullptr</returns>
+	const AtlasRegion* GetAtlasRegion(const std::string& tagName) const;
+
+	/// <summary>
+	/// テクスチャの取得（アトラスにまとめたものはページのテクスチャを返す）
 	/// </summary>
 	/// <param name="tagName">識別用のタグ名</param>
 	/// <returns>テクスチャのポインタ（存在しない場合はnullptr）</returns>
@@ -54,12 +129,134 @@ public:
 	/// <returns>GPUハンドル</returns>
 	D3D12_GPU_DESCRIPTOR_HANDLE GetTextureHandle(const std::string& tagName);
 
+	/// <summary>
+	/// テクスチャのSRVヒープ内の番号を取得（バインドレス描画でシェーダーに渡す）
+	/// </summary>
+	/// <param name="tagName">識別用のタグ名</param>
+	/// <returns>SRVインデックス（存在しない場合はUINT32_MAX）</returns>
+	uint32_t GetTextureIndex(const std::string& tagName);
+
+	///*-----------------------------------------------------------------------*///
+	//						ハンドルでの取得（毎フレームの描画用）					//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// タグ名のハンドルを取得（読み込み前のタグにも割り当てられ、読み込まれた時点で引けるようになる）
+	/// 解放しても同じタグのハンドルはそのまま使え、読み込み直せばまた引ける
+	/// </summary>
+	/// <param name="tagId">識別用のタグ名のStringId</param>
+	/// <returns>ハンドル</returns>
+	TextureHandle AcquireHandle(StringId tagId) { return { textureTable_.Acquire(tagId) }; }
+	TextureHandle AcquireHandle(const std::string& tagName) { return AcquireHandle(StringId::Intern(tagName)); }
+
+	/// <summary>
+	/// ハンドルからテクスチャを取得（配列の添字で引くだけ。読み込まれていない・解放済みならnullptr）
+	/// </summary>
+	Texture* GetTexture(TextureHandle handle) const {
+		const TextureEntry* entry = textures_.Get(textureTable_.Get(handle.index));
+		return entry ? entry->texture.get() : nullptr;
+	}
+
+	/// <summary>
+	/// ハンドルからGPUハンドルを取得（読み込まれていなければ無効な値）
+	/// 描画で使われたものとして記録し、常駐させるミップの判断に使う
+	/// </summary>
+	D3D12_GPU_DESCRIPTOR_HANDLE GetTextureHandle(TextureHandle handle);
+
+	/// <summary>
+	/// ハンドルからSRVヒープ内の番号を取得（読み込まれていなければUINT32_MAX）
+	/// 描画で使われたものとして記録し、常駐させるミップの判断に使う
+	/// </summary>
+	uint32_t GetTextureIndex(TextureHandle handle);
+
+	/// <summary>
+	/// テクスチャがない時に使うテクスチャ（kDefaultTextureTag）のハンドル
+	/// </summary>
+	TextureHandle GetDefaultHandle() const { return defaultHandle_; }
+
+	///*-----------------------------------------------------------------------*///
+	//						常駐メモリの管理（ストリーミング）							//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// 前のフレームまでに使われたテクスチャを見て、詳細なミップを読み込み、予算を超える分は使われていないものを落とす
+	/// 詳細なミップのファイルはワーカースレッドで読み、読み終わった後のフレームで作り直す
+	/// フレームの最初（まだ描画を積んでいない時）に呼ぶ
+	/// </summary>
+	void UpdateResidency();
+
+	/// <summary>
+	/// テクスチャを常駐させるメモリの予算を設定
+	/// </summary>
+	void SetMemoryBudget(uint64_t budgetBytes) { residency_.SetBudget(budgetBytes); }
+
+	/// <summary>
+	/// 常駐メモリの統計を取得
+	/// </summary>
+	TextureResidency::Statistics GetResidencyStatistics() const { return residency_.GetStatistics(); }
+
+	///*-----------------------------------------------------------------------*///
+	//						ホットリロード											//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// 書き換えた画像のファイルから作ったテクスチャを読み込み直す
+	/// 同じテクスチャとSRVの番号のままリソースだけを作り直すので、ハンドルやバインドレスの番号はそのまま使える
+	/// 別のファイルのタグと中身が同じで共有していた場合は、書き換えたファイルのタグだけを新しいテクスチャに分ける
+	/// （分けたタグのハンドルはそのまま使えるが、バインドレスの番号は変わる）
+	/// アトラスのページは元の画像から作り直せないので対象外（読み込み直すには再起動が必要）
+	/// GPUが前のフレームを描き終わっている時（フレームの最初）に呼ぶ
+	/// </summary>
+	/// <param name="filename">書き換えたファイルのパス</param>
+	/// <returns>読み込み直したテクスチャの数</returns>
+	uint32_t ReloadTextureFile(const std::string& filename);
+
+	///*-----------------------------------------------------------------------*///
+	//						クック（事前のブロック圧縮）								//
+	///*-----------------------------------------------------------------------*///
+
+	/// <summary>
+	/// テクスチャをクックしてCookedフォルダにDDSを書き出す（次に読み込んだ時からそちらが使われる）
+	/// 画像のデコードはワーカースレッドで並列に行い、圧縮は1枚ずつ（中でブロックの行を並列に処理する）
+	/// 結果（PSNRと大きさ）はログとImGuiに出す
+	/// </summary>
+	/// <param name="textures">クックするテクスチャ一覧（設定はSetCookSettingsと同じように覚えておく）</param>
+	/// <returns>全て書き出せたかどうか</returns>
+	bool CookTextures(const std::vector<TextureCookDesc>& textures);
+
+	/// <summary>
+	/// 読み込み済みのファイルのテクスチャを、それぞれの設定でクックする
+	/// </summary>
+	/// <returns>全て書き出せたかどうか</returns>
+	bool CookLoadedTextures();
+
+	/// <summary>
+	/// テクスチャごとのクックの設定（設定していないものはImGuiで選べる既定の設定を使う）
+	/// </summary>
+	/// <param name="filename">元の画像のパス</param>
+	/// <param name="settings">設定</param>
+	void SetCookSettings(const std::string& filename, const TextureCooker::Settings& settings) { cookSettings_[filename] = settings; }
+	TextureCooker::Settings GetCookSettings(const std::string& filename) const;
+
+	/// <summary>
+	/// ImGui
+	/// </summary>
+	void ImGui();
+
 	/// <summary>
 	/// テクスチャの解放
+	/// 中身が同じで共有しているものは、最後のタグを解放した時にテクスチャを解放する
 	/// </summary>
 	/// <param name="tagName">識別用のタグ名</param>
 	void UnloadTexture(const std::string& tagName);
 
+	/// <summary>
+	/// テクスチャを共有しているタグの数を取得
+	/// </summary>
+	/// <param name="tagName">識別用のタグ名</param>
+	/// <returns>参照しているタグの数（読み込まれていなければ0）</returns>
+	uint32_t GetReferenceCount(const std::string& tagName) const;
+
 	/// <summary>
 	/// 全てのテクスチャを解放
 	/// </summary>
@@ -76,7 +273,7 @@ public:
 	/// 読み込まれているテクスチャの数を取得
 	/// </summary>
 	/// <returns>テクスチャ数</returns>
-	size_t GetTextureCount() const { return textures_.size(); }
+	size_t GetTextureCount() const { return textures_.GetSize(); }
 
 	/// <summary>
 	/// 読み込まれているテクスチャのタグ名リストを取得
@@ -103,9 +300,151 @@ private:
 	TextureManager(const TextureManager&) = delete;
 	TextureManager& operator=(const TextureManager&) = delete;
 
+	/// <summary>
+	/// 画像をCPU側にRGBA8(sRGB)で読み込む（ミップマップは作らない。アトラスのページとクックの元の画像用）
+	/// </summary>
+	static bool LoadSourceImageRGBA8(const std::string& filename, DirectX::ScratchImage& image);
+
+	/// <summary>
+	/// 画像をページにコピーし、周りの余白を端のピクセルで埋める
+	/// </summary>
+	static void CopyToAtlasPage(const DirectX::Image& source, const DirectX::Image& page, const AtlasRect& rect, uint32_t padding);
+
+	/// <summary>
+	/// 読み込んだ画像からテクスチャを作って登録（SRVの割り当てと常駐メモリの管理への登録も行う）
+	/// </summary>
+	bool CreateTexture(const std::string& filename, const std::string& tagName, const DirectX::ScratchImage& mipImages, uint64_t contentHash);
+
+	/// <summary>
+	/// ファイルの中身のハッシュ（読めなければ0）
+	/// </summary>
+	static uint64_t ComputeContentHash(const std::string& filename);
+
+	/// <summary>
+	/// 中身が同じテクスチャを読み込み済みなら、タグをそれに結び付けて共有する
+	/// </summary>
+	/// <returns>共有したかどうか</returns>
+	bool ShareTexture(const std::string& tagName, const std::string& filename, uint64_t contentHash);
+
+	/// <summary>
+	/// ページの画像からテクスチャを作って登録
+	/// </summary>
+	bool CreateAtlasPageTexture(const std::string& pageTag, const DirectX::ScratchImage& mipImages);
+
 	// DirectXCommonへのポインタ
 	DirectXCommon* dxCommon_ = nullptr;
 
-	// テクスチャの管理用マップ（tagNameからTextureを見つける）
-	std::map<std::string, std::unique_ptr<Texture>> textures_;
+	/// <summary>
+	/// テクスチャに結び付けたタグと、そのタグで読み込んだファイル
+	/// </summary>
+	struct TextureTag {
+		std::string tagName;
+		std::string filePath;	// アトラスのページはページのタグ名
+	};
+
+	/// <summary>
+	/// 読み込んだテクスチャ（アトラスのページも1枚のテクスチャとして入る）
+	/// </summary>
+	struct TextureEntry {
+		std::vector<TextureTag> tags;				// 結び付けたタグ（中身が同じで共有しているものも含む。テクスチャは先頭のタグのファイルから読む）
+		std::unique_ptr<Texture> texture;
+		TextureResidency::Handle residencyHandle;	// 常駐させるミップの管理
+		uint64_t contentHash = 0;					// 元のファイルの中身のハッシュ（アトラスのページは0）
+	};
+	using TextureSlot = SlotMap<TextureEntry>::Handle;
+
+	/// <summary>
+	/// タグ名から読み込んだテクスチャを探す（アトラスにまとめたものはページ、なければnullptr）
+	/// </summary>
+	TextureEntry* FindEntry(StringId tagId) { return textures_.Get(textureTable_.Get(textureTable_.Find(tagId))); }
+	const TextureEntry* FindEntry(StringId tagId) const { return textures_.Get(textureTable_.Get(textureTable_.Find(tagId))); }
+
+	/// <summary>
+	/// テクスチャを登録してタグ名と結び付ける（タグのファイルはテクスチャのファイルパス）
+	/// </summary>
+	/// <returns>登録したスロット</returns>
+	TextureSlot RegisterTexture(const std::string& tagName, std::unique_ptr<Texture> texture, TextureResidency::Handle residencyHandle,
+		uint64_t contentHash = 0);
+
+	/// <summary>
+	/// 画像からテクスチャを作って登録（タグが登録済みかは呼び出し側で確かめる）
+	/// </summary>
+	/// <returns>登録したスロット（作れなければ無効なハンドル）</returns>
+	TextureSlot CreateTextureEntry(const std::string& filename, const std::string& tagName, const DirectX::ScratchImage& mipImages,
+		uint64_t contentHash);
+
+	/// <summary>
+	/// 常駐メモリの管理に登録（GetResidentMipで最初にGPUに置くミップを引く）
+	/// </summary>
+	/// <param name="texture">テクスチャ（作る前のものでよい）</param>
+	/// <param name="mipImages">ミップマップを含む画像</param>
+	/// <param name="isStreamable">ファイルから読み直せるか（できなければ全てのミップを置いたままにする）</param>
+	TextureResidency::Handle RegisterResidency(const Texture* texture, const DirectX::ScratchImage& mipImages, bool isStreamable);
+
+	/// <summary>
+	/// 描画で使われたことを記録
+	/// </summary>
+	void MarkUsed(const TextureEntry& entry) { residency_.Touch(entry.residencyHandle, dxCommon_->GetFrameCount()); }
+
+	/// <summary>
+	/// ワーカースレッドでの詳細なミップの読み込みを取りやめる
+	/// </summary>
+	void CancelStreamIn(const Texture* texture);
+
+	/// <summary>
+	/// GPUが使い終わった古いリソースを解放
+	/// </summary>
+	void ReleaseRetiredResources();
+
+	// 読み込んだテクスチャ（詰めた配列で持ち、解放したものを指すハンドルは世代番号で判別される）
+	SlotMap<TextureEntry> textures_;
+
+	// アトラスにまとめたテクスチャの領域（tagNameからページと領域を見つける）
+	std::map<std::string, AtlasRegion> atlasRegions_;
+
+	// タグ名のハンドルの表（アトラスにまとめたものはページのテクスチャを指す）
+	// 解放したテクスチャのスロットは世代が進むので、表に残った古いハンドルは引いてもnullptrになる
+	StringIdTable<TextureSlot> textureTable_;
+	TextureHandle defaultHandle_;
+
+	// 元のファイルの中身のハッシュからテクスチャを引く（同じ中身のものを共有する）
+	std::unordered_map<uint64_t, TextureSlot> contentSlots_;
+
+	// 常駐させるミップの判断
+	TextureResidency residency_;
+
+	/// <summary>
+	/// ミップを変えて作り直した時の古いリソース（GPUが使い終わるまで保持）
+	/// </summary>
+	struct RetiredResource {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t frame = 0;
+	};
+	std::vector<RetiredResource> retiredResources_;
+
+	/// <summary>
+	/// ワーカースレッドで読み込み中の詳細なミップ
+	/// </summary>
+	struct PendingStreamIn {
+		Texture* texture = nullptr;
+		TextureResidency::Handle residencyHandle;
+		uint32_t residentMip = 0;								// 読み終わったら置く一番詳細なミップ
+		std::shared_ptr<DirectX::ScratchImage> mipImages;		// 読み込み先（ジョブと共有）
+		std::future<void> decoded;
+	};
+	std::vector<PendingStreamIn> pendingStreamIns_;
+
+	// テクスチャごとのクックの設定（元の画像のパスから引く）と、設定していないものに使う設定
+	std::map<std::string, TextureCooker::Settings> cookSettings_;
+	TextureCooker::Settings defaultCookSettings_;
+
+	/// <summary>
+	/// 最後にクックした結果（ImGuiで表示）
+	/// </summary>
+	struct CookRecord {
+		std::string filename;
+		TextureCooker::Settings settings;
+		TextureCooker::Result result;
+	};
+	std::vector<CookRecord> cookRecords_;
 };
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "TextureResidency.h"
+#include <algorithm>
+
+uint32_t TextureResidency::ComputeTailMip(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t maxTailSize) {
+	if (mipLevels == 0) {
+		return 0;
+	}
+	uint32_t mip = 0;
+	while (mip + 1 < mipLevels && (std::max)(width >> mip, height >> mip) > maxTailSize) {
+		++mip;
+	}
+	return mip;
+}
+
+TextureResidency::Handle TextureResidency::Register(uint64_t key, const std::vector<uint64_t>& mipSizes, uint32_t tailMip) {
+	Entry entry;
+	entry.key = key;
+
+	// 後ろから足して、各ミップから末尾までのバイト数にしておく
+	entry.bytesFromMip.assign(mipSizes.size() + 1, 0);
+	for (size_t i = mipSizes.size(); i > 0; --i) {
+		entry.bytesFromMip[i - 1] = entry.bytesFromMip[i] + mipSizes[i - 1];
+	}
+	entry.tailMip = mipSizes.empty() ? 0 : (std::min)(tailMip, static_cast<uint32_t>(mipSizes.size() - 1));
+
+	// 予算に収まる一番詳細なミップから（収まらなければ末尾のミップだけ、使われた時にUpdateで読み込む）
+	entry.residentMip = 0;
+	while (entry.residentMip < entry.tailMip && residentBytes_ + entry.GetResidentBytes() > budgetBytes_) {
+		++entry.residentMip;
+	}
+	residentBytes_ += entry.GetResidentBytes();
+
+	return entries_.Insert(std::move(entry));
+}
+
+void TextureResidency::Unregister(Handle handle) {
+	const Entry* entry = entries_.Get(handle);
+	if (!entry) {
+		return;
+	}
+	residentBytes_ -= entry->GetResidentBytes();
+	entries_.Erase(handle);
+}
+
+void TextureResidency::Clear() {
+	entries_.Clear();
+	changes_.clear();
+	residentBytes_ = 0;
+}
+
+void TextureResidency::Touch(Handle handle, uint64_t frame) {
+	Entry* entry = entries_.Get(handle);
+	if (entry && entry->lastUsedFrame < frame) {
+		entry->lastUsedFrame = frame;
+	}
+}
+
+const std::vector<TextureResidency::Change>& TextureResidency::Update(uint64_t frame) {
+	changes_.clear();
+	lastStreamedInCount_ = 0;
+	lastEvictedCount_ = 0;
+
+	// 使用中で詳細なミップが足りないもの（読み込む候補）と、使われていないもの（落とす候補）に分ける
+	std::vector<Handle> requests;
+	std::vector<Handle> victims;
+	for (size_t i = 0; i < entries_.GetSize(); ++i) {
+		const Handle handle = entries_.GetHandle(i);
+		const Entry& entry = *entries_.Get(handle);
+		if (entry.lastUsedFrame + kInUseFrames >= frame) {
+			if (entry.residentMip > 0) {
+				requests.push_back(handle);
+			}
+		} else if (entry.residentMip < entry.tailMip) {
+			victims.push_back(handle);
+		}
+	}
+
+	// 落とすのは長く使われていないものから
+	std::sort(victims.begin(), victims.end(), [this](Handle a, Handle b) {
+		return entries_.Get(a)->lastUsedFrame < entries_.Get(b)->lastUsedFrame;
+	});
+	size_t victimCursor = 0;
+	auto evictOne = [this, &victims, &victimCursor]() {
+		if (victimCursor >= victims.size()) {
+			return false;
+		}
+		const Handle handle = victims[victimCursor++];
+		Entry& entry = *entries_.Get(handle);
+		ApplyChange(handle, entry, entry.tailMip);
+		++lastEvictedCount_;
+		return true;
+	};
+
+	// 予算を下げた場合などで超えていれば、まず使われていないものを落とす
+	while (residentBytes_ > budgetBytes_ && evictOne()) {
+	}
+
+	// 読み込むのは最近使われたものから
+	std::sort(requests.begin(), requests.end(), [this](Handle a, Handle b) {
+		return entries_.Get(a)->lastUsedFrame > entries_.Get(b)->lastUsedFrame;
+	});
+	if (requests.size() > maxStreamInPerUpdate_) {
+		requests.resize(maxStreamInPerUpdate_);
+	}
+
+	for (Handle handle : requests) {
+		Entry& entry = *entries_.Get(handle);
+
+		// 一番詳細なミップを目指し、予算に収まらなければ使われていないものを落とし、それでも足りなければ粗いミップで妥協する
+		uint32_t targetMip = 0;
+		while (targetMip < entry.residentMip) {
+			const uint64_t requiredBytes = entry.bytesFromMip[targetMip] - entry.GetResidentBytes();
+			if (residentBytes_ + requiredBytes <= budgetBytes_) {
+				break;
+			}
+			if (!evictOne()) {
+				++targetMip;
+			}
+		}
+
+		if (targetMip < entry.residentMip) {
+			ApplyChange(handle, entry, targetMip);
+			++lastStreamedInCount_;
+		}
+	}
+
+	return changes_;
+}
+
+void TextureResidency::SetResidentMip(Handle handle, uint32_t residentMip) {
+	Entry* entry = entries_.Get(handle);
+	if (!entry) {
+		return;
+	}
+	residentMip = (std::min)(residentMip, static_cast<uint32_t>(entry->bytesFromMip.size() - 1));
+	residentBytes_ = residentBytes_ - entry->GetResidentBytes() + entry->bytesFromMip[residentMip];
+	entry->residentMip = residentMip;
+}
+
+uint32_t TextureResidency::GetResidentMip(Handle handle) const {
+	const Entry* entry = entries_.Get(handle);
+	return entry ? entry->residentMip : 0;
+}
+
+TextureResidency::Statistics TextureResidency::GetStatistics() const {
+	Statistics statistics;
+	statistics.residentBytes = residentBytes_;
+	statistics.budgetBytes = budgetBytes_;
+	statistics.textureCount = static_cast<uint32_t>(entries_.GetSize());
+	for (const Entry& entry : entries_) {
+		if (entry.residentMip > 0 && entry.residentMip == entry.tailMip) {
+			++statistics.reducedCount;
+		}
+	}
+	statistics.streamedInCount = lastStreamedInCount_;
+	statistics.evictedCount = lastEvictedCount_;
+	return statistics;
+}
+
+void TextureResidency::ApplyChange(Handle handle, Entry& entry, uint32_t residentMip) {
+	residentBytes_ = residentBytes_ - entry.GetResidentBytes() + entry.bytesFromMip[residentMip];
+	entry.residentMip = residentMip;
+	changes_.push_back({ handle, entry.key, residentMip });
+}
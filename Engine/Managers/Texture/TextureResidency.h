@@ -0,0 +1,140 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "BaseSystem/Container/SlotMap.h"
+
+/// <summary>
+/// テクスチャの常駐メモリを予算内に収めるための判断をする（GPUには触らないので単体で動かせる）
+/// 各テクスチャは「どのミップから下を常駐させるか」だけを持ち、
+/// 最近使われたものは詳細なミップを読み込み、予算が足りなければ長く使われていないものを末尾のミップだけに落とす
+/// 末尾のミップ（tailMip以降）は常に常駐させるので、落としたテクスチャもぼやけるだけで描画は続けられる
+/// 実際の作り直しは呼び出し側がUpdateの結果を見て行う
+/// </summary>
+class TextureResidency {
+private:
+	struct Entry;
+
+public:
+	using Handle = SlotMap<Entry>::Handle;
+
+	// 前のフレームまでに使われたものを「使用中」とみなすフレーム数（1フレームおきに描くものを落とさないように）
+	static const uint64_t kInUseFrames = 2;
+	// 1回のUpdateで詳細なミップを読み込むテクスチャの数の既定値（読み込みは重いので分散させる）
+	static const uint32_t kDefaultMaxStreamInPerUpdate = 2;
+
+	/// <summary>
+	/// 常駐させるミップの変更（residentMipより詳細なミップは解放、residentMipから下を常駐させる）
+	/// </summary>
+	struct Change {
+		Handle handle;
+		uint64_t key = 0;			// Registerで渡した呼び出し側の識別子（テクスチャのポインタなど）
+		uint32_t residentMip = 0;	// 新しく常駐させる一番詳細なミップ
+	};
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		uint64_t residentBytes = 0;		// 常駐しているバイト数
+		uint64_t budgetBytes = 0;		// 予算
+		uint32_t textureCount = 0;		// 登録数
+		uint32_t reducedCount = 0;		// 末尾のミップだけにしている数
+		uint32_t streamedInCount = 0;	// 直前のUpdateで詳細なミップを読み込んだ数
+		uint32_t evictedCount = 0;		// 直前のUpdateで末尾のミップだけに落とした数
+	};
+
+	TextureResidency() = default;
+	~TextureResidency() = default;
+
+	/// <summary>
+	/// 末尾のミップ（常に常駐させる一番詳細なミップ）を求める
+	/// 長辺がmaxTailSize以下になる最初のミップ（なければ最後のミップ）
+	/// </summary>
+	static uint32_t ComputeTailMip(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t maxTailSize);
+
+	/// <summary>
+	/// テクスチャを登録（予算に収まる一番詳細なミップから常駐させる）
+	/// </summary>
+	/// <param name="key">呼び出し側の識別子（Changeで返す）</param>
+	/// <param name="mipSizes">ミップごとのバイト数（0が一番詳細）</param>
+	/// <param name="tailMip">常に常駐させる一番詳細なミップ（0なら落とせない）</param>
+	/// <returns>ハンドル（GetResidentMipで最初に常駐させるミップを引く）</returns>
+	Handle Register(uint64_t key, const std::vector<uint64_t>& mipSizes, uint32_t tailMip);
+
+	/// <summary>
+	/// 登録を解除
+	/// </summary>
+	void Unregister(Handle handle);
+
+	/// <summary>
+	/// 全ての登録を解除
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 使われたことを記録（描画でテクスチャを引くたびに呼ぶ）
+	/// </summary>
+	void Touch(Handle handle, uint64_t frame);
+
+	/// <summary>
+	/// 使われたフレームを見て、読み込むもの・落とすものを決める
+	/// 結果は内部の状態にも反映済みなので、作り直しに失敗した場合はSetResidentMipで戻す
+	/// </summary>
+	/// <param name="frame">今のフレーム番号</param>
+	/// <returns>常駐させるミップの変更一覧（次のUpdateまで有効）</returns>
+	const std::vector<Change>& Update(uint64_t frame);
+
+	/// <summary>
+	/// 常駐しているミップを設定（作り直しに失敗した場合など）
+	/// </summary>
+	void SetResidentMip(Handle handle, uint32_t residentMip);
+
+	/// <summary>
+	/// 常駐している一番詳細なミップを取得（未登録なら0）
+	/// </summary>
+	uint32_t GetResidentMip(Handle handle) const;
+
+	// 予算
+	void SetBudget(uint64_t budgetBytes) { budgetBytes_ = budgetBytes; }
+	uint64_t GetBudget() const { return budgetBytes_; }
+
+	// 1回のUpdateで詳細なミップを読み込むテクスチャの数
+	void SetMaxStreamInPerUpdate(uint32_t count) { maxStreamInPerUpdate_ = count; }
+
+	// 常駐しているバイト数
+	uint64_t GetResidentBytes() const { return residentBytes_; }
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	Statistics GetStatistics() const;
+
+private:
+	/// <summary>
+	/// 登録したテクスチャ
+	/// </summary>
+	struct Entry {
+		uint64_t key = 0;
+		std::vector<uint64_t> bytesFromMip;	// そのミップから末尾までのバイト数
+		uint32_t tailMip = 0;
+		uint32_t residentMip = 0;
+		uint64_t lastUsedFrame = 0;			// 最後に使われたフレーム（使われていなければ0）
+
+		uint64_t GetResidentBytes() const { return bytesFromMip[residentMip]; }
+	};
+
+	/// <summary>
+	/// 常駐させるミップを変えてバイト数を付け替え、変更一覧に積む
+	/// </summary>
+	void ApplyChange(Handle handle, Entry& entry, uint32_t residentMip);
+
+private:
+	SlotMap<Entry> entries_;
+	std::vector<Change> changes_;
+	uint64_t budgetBytes_ = UINT64_MAX;	// SetBudgetするまでは制限なし
+	uint64_t residentBytes_ = 0;
+	uint32_t maxStreamInPerUpdate_ = kDefaultMaxStreamInPerUpdate;
+	uint32_t lastStreamedInCount_ = 0;
+	uint32_t lastEvictedCount_ = 0;
+};
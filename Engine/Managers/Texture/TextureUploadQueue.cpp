@@ -0,0 +1,327 @@
+#include "TextureUploadQueue.h"
+#include "Managers/ImGui/ImGuiManager.h"
+#include "BaseSystem/Logger/Logger.h"
+#include "MyMath/MyFunction.h" // CreateBufferResource用
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+TextureUploadQueue* TextureUploadQueue::GetInstance() {
+	static TextureUploadQueue instance;
+	return &instance;
+}
+
+void TextureUploadQueue::Initialize(DirectXCommon* dxCommon, uint64_t stagingSize) {
+	directXCommon_ = dxCommon;
+	ID3D12Device* device = directXCommon_->GetDevice();
+
+	// コピー専用のキュー（描画用のキューと並行して転送できる）
+	D3D12_COMMAND_QUEUE_DESC queueDesc{};
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	HRESULT hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&copyQueue_));
+	assert(SUCCEEDED(hr));
+
+	// コマンドリストは閉じておき、積む時にResetで開く
+	hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&currentAllocator_));
+	assert(SUCCEEDED(hr));
+	hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, currentAllocator_.Get(), nullptr, IID_PPV_ARGS(&commandList_));
+	assert(SUCCEEDED(hr));
+	commandList_->Close();
+
+	// コピーの完了を知るフェンス
+	hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+	assert(SUCCEEDED(hr));
+	fenceEvent_ = CreateEvent(NULL, FALSE, FALSE, NULL);
+	assert(fenceEvent_ != nullptr);
+	submittedFenceValue_ = 0;
+
+	// ステージングバッファは作りっぱなしでMapしたままにする
+	stagingBuffer_ = CreateBufferResource(directXCommon_->GetDeviceComPtr(), static_cast<size_t>(stagingSize));
+	stagingBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&stagingData_));
+	stagingRing_.Initialize(stagingSize);
+
+	statistics_ = Statistics{};
+	isInitialized_ = SUCCEEDED(hr) && stagingData_ != nullptr;
+	Logger::Log(Logger::GetStream(), std::format("TextureUploadQueue: Initialized !! (Staging: {} MB)\n", stagingSize / (1024 * 1024)));
+}
+
+void TextureUploadQueue::Finalize() {
+	if (!isInitialized_) {
+		return;
+	}
+
+	// 積んだままのものを送り、全て終わってから解放
+	Submit();
+	WaitIdle();
+
+	pendingResources_.clear();
+	pendingAllocators_.clear();
+	stagingRing_.Finalize();
+	if (stagingBuffer_) {
+		stagingBuffer_->Unmap(0, nullptr);
+	}
+	stagingData_ = nullptr;
+	stagingBuffer_.Reset();
+
+	commandList_.Reset();
+	currentAllocator_.Reset();
+	copyQueue_.Reset();
+	fence_.Reset();
+	if (fenceEvent_) {
+		CloseHandle(fenceEvent_);
+		fenceEvent_ = nullptr;
+	}
+
+	directXCommon_ = nullptr;
+	isInitialized_ = false;
+}
+
+///*-----------------------------------------------------------------------*///
+//								コピーを積む										//
+///*-----------------------------------------------------------------------*///
+
+bool TextureUploadQueue::UploadTexture(ID3D12Resource* texture, const DirectX::Image* images, size_t imageCount) {
+	if (!isInitialized_ || !texture || imageCount == 0) {
+		return false;
+	}
+
+	// サブリソースごとの配置（行のピッチは256バイト境界にそろえる必要がある）
+	const D3D12_RESOURCE_DESC desc = texture->GetDesc();
+	const UINT subresourceCount = static_cast<UINT>(imageCount);
+	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(subresourceCount);
+	std::vector<UINT> rowCounts(subresourceCount);
+	std::vector<UINT64> rowSizes(subresourceCount);
+	UINT64 totalBytes = 0;
+	directXCommon_->GetDevice()->GetCopyableFootprints(&desc, 0, subresourceCount, 0,
+		layouts.data(), rowCounts.data(), rowSizes.data(), &totalBytes);
+
+	ID3D12Resource* stagingBuffer = nullptr;
+	uint64_t stagingOffset = 0;
+	uint8_t* stagingData = AllocateStaging(totalBytes, stagingBuffer, stagingOffset);
+	if (!stagingData) {
+		Logger::Log(Logger::GetStream(), std::format("TextureUploadQueue: Failed to allocate {} bytes of staging memory\n", totalBytes));
+		return false;
+	}
+
+	for (UINT i = 0; i < subresourceCount; ++i) {
+		// 画像の行を配置に合わせて詰め直す
+		const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[i];
+		const DirectX::Image& image = images[i];
+		uint8_t* destination = stagingData + layout.Offset;
+		for (UINT z = 0; z < layout.Footprint.Depth; ++z) {
+			for (UINT row = 0; row < rowCounts[i]; ++row) {
+				std::memcpy(destination + (static_cast<uint64_t>(z) * rowCounts[i] + row) * layout.Footprint.RowPitch,
+					image.pixels + z * image.slicePitch + row * image.rowPitch,
+					static_cast<size_t>(rowSizes[i]));
+			}
+		}
+
+		D3D12_TEXTURE_COPY_LOCATION destinationLocation{};
+		destinationLocation.pResource = texture;
+		destinationLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+		destinationLocation.SubresourceIndex = i;
+
+		D3D12_TEXTURE_COPY_LOCATION sourceLocation{};
+		sourceLocation.pResource = stagingBuffer;
+		sourceLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+		sourceLocation.PlacedFootprint = layout;
+		sourceLocation.PlacedFootprint.Offset += stagingOffset;
+
+		commandList_->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+	}
+
+	KeepAlive(texture);
+	recordedUploadCount_++;
+	recordedCopyCount_ += subresourceCount;
+	recordedBytes_ += totalBytes;
+	return true;
+}
+
+bool TextureUploadQueue::UploadBuffer(ID3D12Resource* buffer, const void* data, uint64_t size) {
+	if (!isInitialized_ || !buffer || !data || size == 0) {
+		return false;
+	}
+
+	ID3D12Resource* stagingBuffer = nullptr;
+	uint64_t stagingOffset = 0;
+	uint8_t* stagingData = AllocateStaging(size, stagingBuffer, stagingOffset);
+	if (!stagingData) {
+		Logger::Log(Logger::GetStream(), std::format("TextureUploadQueue: Failed to allocate {} bytes of staging memory\n", size));
+		return false;
+	}
+	std::memcpy(stagingData, data, static_cast<size_t>(size));
+
+	// バッファは行の配置がないので、そのまま1回でコピーする
+	commandList_->CopyBufferRegion(buffer, 0, stagingBuffer, stagingOffset, size);
+
+	KeepAlive(buffer);
+	recordedCopyCount_++;
+	recordedBytes_ += size;
+	return true;
+}
+
+void TextureUploadQueue::CopyTextureSubresources(ID3D12Resource* destination, ID3D12Resource* source,
+	uint32_t sourceFirstSubresource, uint32_t count) {
+	if (!isInitialized_ || !destination || !source || count == 0) {
+		return;
+	}
+	BeginRecording();
+
+	for (uint32_t i = 0; i < count; ++i) {
+		D3D12_TEXTURE_COPY_LOCATION destinationLocation{};
+		destinationLocation.pResource = destination;
+		destinationLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+		destinationLocation.SubresourceIndex = i;
+
+		D3D12_TEXTURE_COPY_LOCATION sourceLocation{};
+		sourceLocation.pResource = source;
+		sourceLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+		sourceLocation.SubresourceIndex = sourceFirstSubresource + i;
+
+		commandList_->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+	}
+
+	// コピー元は呼び出し側がすぐに手放すことがあるので、両方とも終わるまで保持
+	KeepAlive(destination);
+	KeepAlive(source);
+	recordedCopyCount_ += count;
+}
+
+///*-----------------------------------------------------------------------*///
+//								送信と完了待ち									//
+///*-----------------------------------------------------------------------*///
+
+void TextureUploadQueue::Submit() {
+	if (!isRecording_) {
+		statistics_.uploadCount = 0;
+		statistics_.copyCount = 0;
+		statistics_.uploadedBytes = 0;
+		statistics_.staging = stagingRing_.GetStatistics();
+		return;
+	}
+
+	// 積んだコピーをまとめて送る
+	commandList_->Close();
+	ID3D12CommandList* commandLists[] = { commandList_.Get() };
+	copyQueue_->ExecuteCommandLists(1, commandLists);
+
+	submittedFenceValue_++;
+	copyQueue_->Signal(fence_.Get(), submittedFenceValue_);
+
+	// 描画用のキューはコピーの完了を待ってから、この後に送るコマンドを実行する
+	directXCommon_->GetCommandQueue()->Wait(fence_.Get(), submittedFenceValue_);
+
+	pendingAllocators_.push_back({ std::move(currentAllocator_), submittedFenceValue_ });
+	isRecording_ = false;
+
+	statistics_.uploadCount = recordedUploadCount_;
+	statistics_.copyCount = recordedCopyCount_;
+	statistics_.uploadedBytes = recordedBytes_;
+	statistics_.submitCount++;
+	recordedUploadCount_ = 0;
+	recordedCopyCount_ = 0;
+	recordedBytes_ = 0;
+
+	Reclaim();
+	statistics_.staging = stagingRing_.GetStatistics();
+}
+
+void TextureUploadQueue::WaitIdle() {
+	WaitForFence(submittedFenceValue_);
+}
+
+void TextureUploadQueue::BeginRecording() {
+	if (isRecording_) {
+		return;
+	}
+	Reclaim();
+
+	// 一番古いアロケータのコピーが終わっていれば使い回し、まだなら新しく作る
+	if (!pendingAllocators_.empty() && pendingAllocators_.front().fenceValue <= fence_->GetCompletedValue()) {
+		currentAllocator_ = std::move(pendingAllocators_.front().allocator);
+		pendingAllocators_.pop_front();
+	} else {
+		HRESULT hr = directXCommon_->GetDevice()->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&currentAllocator_));
+		assert(SUCCEEDED(hr));
+	}
+	currentAllocator_->Reset();
+	commandList_->Reset(currentAllocator_.Get(), nullptr);
+
+	// ここから切り出すステージングは、このまとまりを送った時のフェンス値で回収する
+	stagingRing_.BeginBatch(submittedFenceValue_ + 1);
+	isRecording_ = true;
+}
+
+uint8_t* TextureUploadQueue::AllocateStaging(uint64_t size, ID3D12Resource*& buffer, uint64_t& offset) {
+	BeginRecording();
+
+	// リングより大きいものは専用のバッファを作り、コピーが終わったら捨てる
+	if (size > stagingRing_.GetCapacity()) {
+		Microsoft::WRL::ComPtr<ID3D12Resource> dedicated = CreateBufferResource(directXCommon_->GetDeviceComPtr(), static_cast<size_t>(size));
+		uint8_t* data = nullptr;
+		if (!dedicated || FAILED(dedicated->Map(0, nullptr, reinterpret_cast<void**>(&data)))) {
+			return nullptr;
+		}
+		KeepAlive(dedicated.Get());
+		statistics_.dedicatedCount++;
+		buffer = dedicated.Get();
+		offset = 0;
+		return data;
+	}
+
+	for (;;) {
+		offset = stagingRing_.Allocate(size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+		if (offset != UploadRingAllocator::kInvalidOffset) {
+			buffer = stagingBuffer_.Get();
+			return stagingData_ + offset;
+		}
+
+		// 空きが足りなければ、積んだ分を送ってから一番古いまとまりの完了を待って回収する
+		if (recordedCopyCount_ > 0) {
+			Submit();
+		}
+		const uint64_t oldestFenceValue = stagingRing_.GetOldestPendingFenceValue();
+		if (oldestFenceValue == 0 || oldestFenceValue > submittedFenceValue_) {
+			// 送っていないまとまりしか残っていない（ここには来ないはず）
+			return nullptr;
+		}
+		WaitForFence(oldestFenceValue);
+		statistics_.stallCount++;
+		BeginRecording();
+	}
+}
+
+void TextureUploadQueue::Reclaim() {
+	const uint64_t completedFenceValue = fence_->GetCompletedValue();
+	stagingRing_.Reclaim(completedFenceValue);
+	std::erase_if(pendingResources_, [completedFenceValue](const PendingResource& pending) {
+		return pending.fenceValue <= completedFenceValue;
+	});
+}
+
+void TextureUploadQueue::WaitForFence(uint64_t fenceValue) {
+	if (fence_->GetCompletedValue() < fenceValue) {
+		fence_->SetEventOnCompletion(fenceValue, fenceEvent_);
+		WaitForSingleObject(fenceEvent_, INFINITE);
+	}
+	Reclaim();
+}
+
+void TextureUploadQueue::KeepAlive(ID3D12Resource* resource) {
+	pendingResources_.push_back({ resource, submittedFenceValue_ + 1 });
+}
+
+void TextureUploadQueue::ImGui() {
+#ifdef _DEBUG
+	if (ImGui::TreeNode("Texture Upload")) {
+		constexpr double kMegabyte = 1024.0 * 1024.0;
+		const UploadRingAllocator::Statistics& staging = statistics_.staging;
+		ImGui::Text("Last submit: %u textures / %u copies / %.2f MB", statistics_.uploadCount, statistics_.copyCount,
+			static_cast<double>(statistics_.uploadedBytes) / kMegabyte);
+		ImGui::Text("Staging: %.1f / %.1f MB (peak %.1f MB)", static_cast<double>(staging.usedBytes) / kMegabyte,
+			static_cast<double>(staging.capacity) / kMegabyte, static_cast<double>(staging.highWaterMark) / kMegabyte);
+		ImGui::Text("Submits: %u  Stalls: %u  Dedicated: %u", statistics_.submitCount, statistics_.stallCount, statistics_.dedicatedCount);
+		ImGui::TreePop();
+	}
+#endif
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "BaseSystem/DirectXCommon/DirectXCommon.h"
+#include "BaseSystem/DirectXCommon/UploadRingAllocator.h"
+
+/// <summary>
+/// テクスチャ（と一度書いたら変えない頂点バッファなど）のアップロードをまとめてコピー専用のキューで送る
+/// CPU側の画像は1本の常にMapしたステージングバッファ（UploadRingAllocatorで切り出す）に書き、
+/// フレーム中に積んだ全てのコピーをSubmitで1回のExecuteCommandListsにまとめる
+/// 描画用のキューにはコピーのフェンスをWaitさせるので、同じフレームの描画からそのまま使える
+/// ステージングの範囲は送った時のフェンス値が完了したら回収する（テクスチャごとの中間リソースは作らない）
+/// テクスチャはCOMMONで作り、コピーと描画での状態は暗黙の昇格・減衰に任せる（バリアは張らない）
+/// </summary>
+class TextureUploadQueue {
+public:
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		uint32_t uploadCount = 0;		// 直前のSubmitで送ったテクスチャの数
+		uint32_t copyCount = 0;			// 直前のSubmitで送ったコピーの数（サブリソース単位）
+		uint64_t uploadedBytes = 0;		// 直前のSubmitでステージングから送ったバイト数
+		uint32_t submitCount = 0;		// Submitで実際に送った回数の累計
+		uint32_t stallCount = 0;		// ステージングが足りずCPUでコピーの完了を待った回数の累計
+		uint32_t dedicatedCount = 0;	// ステージングに収まらず専用のバッファを作った回数の累計
+		UploadRingAllocator::Statistics staging;
+	};
+
+	//シングルトン
+	static TextureUploadQueue* GetInstance();
+
+	/// <summary>
+	/// 初期化（コピー用のキューとステージングバッファの作成）
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	/// <param name="stagingSize">ステージングバッファのバイト数</param>
+	void Initialize(DirectXCommon* dxCommon, uint64_t stagingSize = GraphicsConfig::kTextureStagingSize);
+
+	/// <summary>
+	/// 終了処理（積んだものを送り、全てのコピーの完了を待ってから解放）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// テクスチャのサブリソースを先頭から順にアップロードする（実際に送るのはSubmit）
+	/// </summary>
+	/// <param name="texture">コピー先（COMMONの状態で作ったもの）</param>
+	/// <param name="images">サブリソースの順に並んだ画像</param>
+	/// <param name="imageCount">画像の数</param>
+	/// <returns>積めたかどうか</returns>
+	bool UploadTexture(ID3D12Resource* texture, const DirectX::Image* images, size_t imageCount);
+
+	/// <summary>
+	/// バッファの先頭へデータをアップロードする（頂点バッファなど、一度書いたら変えないもの。実際に送るのはSubmit）
+	/// </summary>
+	/// <param name="buffer">コピー先（DEFAULTのヒープにCOMMONの状態で作ったもの）</param>
+	/// <param name="data">書き込むデータ</param>
+	/// <param name="size">バイト数</param>
+	/// <returns>積めたかどうか</returns>
+	bool UploadBuffer(ID3D12Resource* buffer, const void* data, uint64_t size);
+
+	/// <summary>
+	/// テクスチャのサブリソースを別のテクスチャへコピーする（ミップを減らして作り直す時など）
+	/// destinationの0番からcount個へ、sourceのsourceFirstSubresource番から順にコピー
+	/// </summary>
+	void CopyTextureSubresources(ID3D12Resource* destination, ID3D12Resource* source,
+		uint32_t sourceFirstSubresource, uint32_t count);
+
+	/// <summary>
+	/// 積んだコピーをまとめて送り、描画用のキューにその完了を待たせる
+	/// 描画用のコマンドリストを実行する前（DirectXCommon::EndFrameの前）に呼ぶ
+	/// </summary>
+	void Submit();
+
+	/// <summary>
+	/// 送ったコピーが全て終わるまでCPUで待つ
+	/// </summary>
+	void WaitIdle();
+
+	/// <summary>
+	/// ImGui表示
+	/// </summary>
+	void ImGui();
+
+	// Getter
+	const Statistics& GetStatistics() const { return statistics_; }
+	bool IsInitialized() const { return isInitialized_; }
+
+private:
+	TextureUploadQueue() = default;
+	~TextureUploadQueue() = default;
+	TextureUploadQueue(const TextureUploadQueue&) = delete;
+	TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+
+	/// <summary>
+	/// コマンドリストを開く（既に開いていれば何もしない）
+	/// </summary>
+	void BeginRecording();
+
+	/// <summary>
+	/// ステージングから切り出す（空きがなければ送って待ち、リングより大きければ専用のバッファを作る）
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="buffer">コピー元のバッファ</param>
+	/// <param name="offset">バッファ内の先頭</param>
+	/// <returns>書き込み先（失敗したらnullptr）</returns>
+	uint8_t* AllocateStaging(uint64_t size, ID3D12Resource*& buffer, uint64_t& offset);
+
+	/// <summary>
+	/// 完了したコピーのステージング・アロケータ・保持しているリソースを回収
+	/// </summary>
+	void Reclaim();
+
+	/// <summary>
+	/// コピーのフェンスが指定値に達するまでCPUで待つ
+	/// </summary>
+	void WaitForFence(uint64_t fenceValue);
+
+	/// <summary>
+	/// コピーが終わるまで解放できないリソースを保持
+	/// </summary>
+	void KeepAlive(ID3D12Resource* resource);
+
+private:
+	// DirectXCommon参照
+	DirectXCommon* directXCommon_ = nullptr;
+	bool isInitialized_ = false;
+
+	// コピー用のキューとコマンドリスト
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> copyQueue_;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList_;
+	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> currentAllocator_;
+	bool isRecording_ = false;
+
+	/// <summary>
+	/// 送ったコマンドのアロケータ（フェンスが完了したら使い回す）
+	/// </summary>
+	struct PendingAllocator {
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+		uint64_t fenceValue = 0;
+	};
+	std::deque<PendingAllocator> pendingAllocators_;
+
+	// コピーの完了を知るフェンス
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence_;
+	HANDLE fenceEvent_ = nullptr;
+	uint64_t submittedFenceValue_ = 0;	// 最後に送ったまとまりのフェンス値
+
+	// ステージングバッファ（常にMapしたまま）
+	Microsoft::WRL::ComPtr<ID3D12Resource> stagingBuffer_;
+	uint8_t* stagingData_ = nullptr;
+	UploadRingAllocator stagingRing_;
+
+	/// <summary>
+	/// コピーが終わるまで保持するリソース（コピー先・コピー元のテクスチャと専用のバッファ）
+	/// </summary>
+	struct PendingResource {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t fenceValue = 0;
+	};
+	std::vector<PendingResource> pendingResources_;
+
+	// 今のまとまりで積んだもの
+	uint32_t recordedUploadCount_ = 0;
+	uint32_t recordedCopyCount_ = 0;
+	uint64_t recordedBytes_ = 0;
+
+	// 統計
+	Statistics statistics_;
+};
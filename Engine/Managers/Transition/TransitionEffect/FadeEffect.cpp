@@ -33,6 +33,7 @@ void FadeEffect::Initialize(DirectXCommon* directXCommon) {
 
 	// 初期状態は完全に透明
 	fadeSprite_->SetColor({ fadeColor_.x, fadeColor_.y, fadeColor_.z, 0.0f });
+	fadeSprite_->SetLayer(SpriteBatch::kTopLayer); // 全てのUIより手前
 }
 
 void FadeEffect::Update(float deltaTime) {
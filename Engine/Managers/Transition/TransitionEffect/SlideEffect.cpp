@@ -33,6 +33,7 @@ void SlideEffect::Initialize(DirectXCommon* directXCommon) {
 	slideSprite_ = std::make_unique<Sprite>();
 	slideSprite_->Initialize(directXCommon_, "white", position, size);
 	slideSprite_->SetColor({ 0.0f, 0.0f, 0.0f, 1.0f }); // 黒色
+	slideSprite_->SetLayer(SpriteBatch::kTopLayer); // 全てのUIより手前
 
 	// 方向に応じた開始・終了位置を設定
 	switch (direction_) {
@@ -40,6 +40,34 @@ Microsoft::WRL::ComPtr <ID3D12Resource> CreateBufferResource(Microsoft::WRL::Com
 	return Resource;
 }
 
+Microsoft::WRL::ComPtr <ID3D12Resource> CreateDefaultBufferResource(Microsoft::WRL::ComPtr <ID3D12Device> device, size_t sizeInBytes)
+{
+	//VRAM上に作る
+	D3D12_HEAP_PROPERTIES defaultHeapProperties{};
+	defaultHeapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+	//バッファの設定はCreateBufferResourceと同じ
+	D3D12_RESOURCE_DESC ResourceDesc{};
+	ResourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	ResourceDesc.Width = sizeInBytes;
+	ResourceDesc.Height = 1;
+	ResourceDesc.DepthOrArraySize = 1;
+	ResourceDesc.MipLevels = 1;
+	ResourceDesc.SampleDesc.Count = 1;
+	ResourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+	Microsoft::WRL::ComPtr<ID3D12Resource> Resource = nullptr;
+	HRESULT hr = device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&ResourceDesc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		IID_PPV_ARGS(&Resource)
+	);
+	assert(SUCCEEDED(hr));
+
+	return Resource;
+}
+
 //	正射影ベクトルを求める関数
 Vector3 Project(const Vector3& v1, const Vector3& v2) {
 	Vector3 project = Multiply(Normalize(v2), Dot(v1, Normalize(v2)));
@@ -77,6 +77,12 @@ struct AABB {
 
 Microsoft::WRL::ComPtr <ID3D12Resource> CreateBufferResource(Microsoft::WRL::ComPtr <ID3D12Device> device, size_t sizeInBytes);
 
+/// <summary>
+/// VRAM（DEFAULTのヒープ）にバッファを作る。CPUからは書けないので、中身はTextureUploadQueue::UploadBufferで送る
+/// COMMONで作るので、コピーや描画での読み取りには暗黙に昇格する
+/// </summary>
+Microsoft::WRL::ComPtr <ID3D12Resource> CreateDefaultBufferResource(Microsoft::WRL::ComPtr <ID3D12Device> device, size_t sizeInBytes);
+
 /*-----------------------------------------------------------------------*/
 //
 //								計算関数
@@ -278,8 +278,8 @@ Vector2 Perpendicular(const Vector2& v) {
 // 回転
 Vector2 Rotate(const Vector2& v, float radian) {
 	Vector2 result;
-	float cosTheta = std::cosf(radian);
-	float sinTheta = std::sinf(radian);
+	float cosTheta = std::cos(radian);
+	float sinTheta = std::sin(radian);
 
 	result.x = v.x * cosTheta - v.y * sinTheta;
 	result.y = v.x * sinTheta + v.y * cosTheta;
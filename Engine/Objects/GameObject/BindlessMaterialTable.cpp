@@ -0,0 +1,164 @@
+#include "BindlessMaterialTable.h"
+#include "Managers/ImGui/ImGuiManager.h"
+#include "BaseSystem/Logger/Logger.h"
+#include <algorithm>
+#include <cassert>
+
+BindlessMaterialTable* BindlessMaterialTable::GetInstance() {
+	static BindlessMaterialTable instance;
+	return &instance;
+}
+
+void BindlessMaterialTable::Initialize(DirectXCommon* dxCommon) {
+	directXCommon_ = dxCommon;
+
+	CreatePipelineState();
+
+	// フレームごとのマテリアルバッファを作成
+	for (FrameBuffer& frameBuffer : frameBuffers_) {
+		CreateFrameBuffer(frameBuffer, kInitialMaterialCapacity);
+	}
+
+	isInitialized_ = rootSignature_ != nullptr && pipelineState_ != nullptr;
+	Logger::Log(Logger::GetStream(), "BindlessMaterialTable: Initialized !!\n");
+}
+
+void BindlessMaterialTable::Finalize() {
+	// シェーダーを書き換えた時に作り直すPSOから外す
+	if (directXCommon_) {
+		directXCommon_->GetPSOFactory()->UnregisterReload(&pipelineState_);
+	}
+	retiredBuffers_.clear();
+	for (FrameBuffer& frameBuffer : frameBuffers_) {
+		frameBuffer = FrameBuffer{};
+	}
+	pipelineState_.Reset();
+	rootSignature_.Reset();
+	directXCommon_ = nullptr;
+	isInitialized_ = false;
+}
+
+void BindlessMaterialTable::CreatePipelineState() {
+	// 描画ごとに変わるのはマテリアルの番号だけ
+	RootSignatureBuilder rsBuilder;
+	rsBuilder.AddConstants(2, 1, D3D12_SHADER_VISIBILITY_PIXEL)							// 0: Material index (b2)
+		.AddCBV(0, D3D12_SHADER_VISIBILITY_VERTEX)										// 1: Transform (b0)
+		.AddSRV(0, GraphicsConfig::kSRVHeapSize, D3D12_SHADER_VISIBILITY_PIXEL)			// 2: Textures (t0～)
+		.AddCBV(1, D3D12_SHADER_VISIBILITY_PIXEL)										// 3: Light (b1)
+		.AddRootSRV(0, D3D12_SHADER_VISIBILITY_PIXEL, 1)								// 4: Materials (t0, space1)
+		.AddStaticSampler(0);															// Sampler (s0)
+
+	PSODescriptor descriptor = PSODescriptor::Create3D()
+		.SetPixelShader(L"resources/Shader/Object3d/Object3dBindless.PS.hlsl");
+
+	auto psoInfos = directXCommon_->GetPSOFactory()->CreatePSOBatch({ { &descriptor, &rsBuilder } });
+	if (!psoInfos[0].IsValid()) {
+		Logger::Log(Logger::GetStream(), "BindlessMaterialTable: Failed to create PSO\n");
+		assert(false);
+		return;
+	}
+	rootSignature_ = psoInfos[0].rootSignature;
+	pipelineState_ = psoInfos[0].pipelineState;
+
+	// シェーダーを書き換えたら作り直す
+	directXCommon_->GetPSOFactory()->RegisterReload(descriptor, rootSignature_, rsBuilder.ComputeHash(), &pipelineState_);
+}
+
+///*-----------------------------------------------------------------------*///
+//								設定とマテリアルの追加							//
+///*-----------------------------------------------------------------------*///
+
+void BindlessMaterialTable::Bind(GraphicsStateCache& stateCache) {
+	stateCache.SetGraphicsRootSignature(rootSignature_.Get());
+	stateCache.SetPipelineState(pipelineState_.Get());
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	// SRVヒープの先頭から使い続ける範囲全体（シェーダーはテクスチャの番号でそのまま引く）
+	stateCache.SetGraphicsRootDescriptorTable(kRootTextures,
+		directXCommon_->GetDescriptorManager()->GetGPUHandle(DescriptorHeapManager::HeapType::SRV, 0));
+}
+
+uint32_t BindlessMaterialTable::PushMaterial(const MaterialData& materialData, uint32_t textureIndex) {
+	const uint32_t index = AllocateMaterial();
+	FrameBuffer& frameBuffer = frameBuffers_[directXCommon_->GetFrameIndex()];
+
+	// Map先は書き込み専用のメモリなので、組み立ててから1回で書く
+	BindlessMaterialData data;
+	data.color = materialData.color;
+	data.enableLighting = materialData.enableLighting;
+	data.useLambertianReflectance = materialData.useLambertianReflectance;
+	data.textureIndex = textureIndex;
+	data.padding = 0;
+	data.uvTransform = materialData.uvTransform;
+	frameBuffer.mappedData[index] = data;
+
+	// 作り直した直後だけ実際に発行される（同じアドレスはステートキャッシュで省かれる）
+	directXCommon_->GetStateCache().SetGraphicsRootShaderResourceView(kRootMaterials,
+		frameBuffer.resource->GetGPUVirtualAddress());
+
+	++statistics_.materialCount;
+	return index;
+}
+
+void BindlessMaterialTable::EndFrame() {
+	lastFrameStatistics_ = statistics_;
+	statistics_ = {};
+}
+
+void BindlessMaterialTable::ImGui() {
+#ifdef _DEBUG
+	if (ImGui::TreeNode("Bindless Materials")) {
+		ImGui::Checkbox("Enabled", &isEnabled_);
+		ImGui::Text("Materials: %u", lastFrameStatistics_.materialCount);
+		if (directXCommon_) {
+			ImGui::Text("Capacity: %u materials", frameBuffers_[directXCommon_->GetFrameIndex()].capacity);
+		}
+		ImGui::TreePop();
+	}
+#endif
+}
+
+///*-----------------------------------------------------------------------*///
+//								バッファ管理										//
+///*-----------------------------------------------------------------------*///
+
+uint32_t BindlessMaterialTable::AllocateMaterial() {
+	const uint64_t frame = directXCommon_->GetFrameCount();
+	FrameBuffer& frameBuffer = frameBuffers_[directXCommon_->GetFrameIndex()];
+
+	// この組を前に使ったフレームのGPU処理は終わっているので先頭から書き直せる
+	if (frameBuffer.frame != frame) {
+		frameBuffer.frame = frame;
+		frameBuffer.writeOffset = 0;
+		ReleaseRetiredBuffers();
+	}
+
+	if (frameBuffer.writeOffset >= frameBuffer.capacity) {
+		// このフレームで既に積んだ描画が古いバッファを参照しているので、解放はGPUが使い終わってから
+		retiredBuffers_.push_back({ frameBuffer.resource, frame });
+
+		// 2倍に広げる（古い内容は古いバッファを参照する描画だけが使うので写さない）
+		const uint32_t newCapacity = (std::max)(frameBuffer.capacity * 2, kInitialMaterialCapacity);
+		CreateFrameBuffer(frameBuffer, newCapacity);
+		frameBuffer.frame = frame;
+		Logger::Log(Logger::GetStream(), std::format("BindlessMaterialTable: Grew material buffer to {} materials\n", newCapacity));
+	}
+
+	return frameBuffer.writeOffset++;
+}
+
+void BindlessMaterialTable::CreateFrameBuffer(FrameBuffer& frameBuffer, uint32_t materialCapacity) {
+	frameBuffer.resource = CreateBufferResource(directXCommon_->GetDevice(),
+		sizeof(BindlessMaterialData) * materialCapacity);
+	frameBuffer.resource->Map(0, nullptr, reinterpret_cast<void**>(&frameBuffer.mappedData));
+	frameBuffer.capacity = materialCapacity;
+	frameBuffer.writeOffset = 0;
+}
+
+void BindlessMaterialTable::ReleaseRetiredBuffers() {
+	// DirectXCommon::kFrameCountフレーム前のものはGPUが使い終わっている
+	const uint64_t frame = directXCommon_->GetFrameCount();
+	std::erase_if(retiredBuffers_, [frame](const RetiredBuffer& retired) {
+		return retired.frame + DirectXCommon::kFrameCount <= frame;
+	});
+}
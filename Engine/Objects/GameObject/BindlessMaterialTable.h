@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "BaseSystem/DirectXCommon/DirectXCommon.h"
+#include "MyMath/MyFunction.h"
+
+/// <summary>
+/// バインドレス描画用のマテリアルデータ（MaterialDataのpaddingにテクスチャの番号を入れたもの）
+/// </summary>
+struct BindlessMaterialData {
+	Vector4 color;
+	int32_t enableLighting;
+	int32_t useLambertianReflectance;
+	uint32_t textureIndex;		// SRVヒープ内のテクスチャの番号
+	uint32_t padding;
+	Matrix4x4 uvTransform;
+};
+static_assert(sizeof(BindlessMaterialData) == 96, "BindlessMaterialData must match Material in Object3dBindless.PS.hlsl");
+
+/// <summary>
+/// バインドレスのマテリアルテーブル
+/// フレーム中に描くメッシュのマテリアルを1つのStructuredBufferに積み、テクスチャはSRVヒープ全体を1つのテーブルで渡す
+/// 描画ごとの設定はマテリアルの番号（ルート定数1つ）だけになり、マテリアルのCBVとテクスチャのテーブルを切り替えずに済む
+/// バッファはフレームごとに別のもの（DirectXCommon::kFrameCount組）を使い、足りなければ2倍に作り直す
+/// </summary>
+class BindlessMaterialTable {
+public:
+	// ルート引数の番号（トランスフォームとライトは通常の3D描画と同じ番号）
+	static const UINT kRootMaterialIndex = 0;	// マテリアルの番号（b2、ルート定数）
+	static const UINT kRootTransform = 1;		// トランスフォーム（b0、VS）
+	static const UINT kRootTextures = 2;		// SRVヒープ全体（t0～）
+	static const UINT kRootLight = 3;			// 平行光源（b1、PS）
+	static const UINT kRootMaterials = 4;		// マテリアルのStructuredBuffer（t0, space1）
+	// マテリアルバッファの最初の容量
+	static const uint32_t kInitialMaterialCapacity = 1024;
+
+	/// <summary>
+	/// 前フレームの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t materialCount = 0;	// 積まれたマテリアル数（=バインドレスで描いたメッシュ数）
+	};
+
+	//シングルトン
+	static BindlessMaterialTable* GetInstance();
+
+	/// <summary>
+	/// 初期化（PSOとバッファの作成）
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon);
+
+	/// <summary>
+	/// 終了処理（GPUリソースを解放）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// バインドレス描画用のRootSignature・PSO・テクスチャのテーブルを設定
+	/// </summary>
+	/// <param name="stateCache">ステートキャッシュ</param>
+	void Bind(GraphicsStateCache& stateCache);
+
+	/// <summary>
+	/// マテリアルを積んで、その番号を返す（Bindの後に呼ぶ。バッファを作り直した時はルート引数も設定し直す）
+	/// </summary>
+	/// <param name="materialData">マテリアルデータ</param>
+	/// <param name="textureIndex">SRVヒープ内のテクスチャの番号</param>
+	/// <returns>シェーダーに渡すマテリアルの番号</returns>
+	uint32_t PushMaterial(const MaterialData& materialData, uint32_t textureIndex);
+
+	/// <summary>
+	/// フレームの終了（統計を確定する）
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// ImGui表示
+	/// </summary>
+	void ImGui();
+
+	// 有効/無効（無効の間はGameObject::Drawがメッシュごとにマテリアルとテクスチャを設定する）
+	void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+	bool IsEnabled() const { return isEnabled_ && isInitialized_; }
+
+	// Getter
+	const Statistics& GetLastFrameStatistics() const { return lastFrameStatistics_; }
+
+private:
+	BindlessMaterialTable() = default;
+	~BindlessMaterialTable() = default;
+	BindlessMaterialTable(const BindlessMaterialTable&) = delete;
+	BindlessMaterialTable& operator=(const BindlessMaterialTable&) = delete;
+
+	/// <summary>
+	/// フレームごとのマテリアルバッファ
+	/// </summary>
+	struct FrameBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		BindlessMaterialData* mappedData = nullptr;
+		uint32_t capacity = 0;			// マテリアル数
+		uint32_t writeOffset = 0;		// 今のフレームで次に書く位置
+		uint64_t frame = UINT64_MAX;	// 最後に使ったフレーム
+	};
+
+	/// <summary>
+	/// PSOを作成
+	/// </summary>
+	void CreatePipelineState();
+
+	/// <summary>
+	/// 今のフレームのバッファから1つ確保（足りなければ作り直す）
+	/// </summary>
+	/// <returns>確保した位置</returns>
+	uint32_t AllocateMaterial();
+
+	/// <summary>
+	/// マテリアルバッファを作成
+	/// </summary>
+	void CreateFrameBuffer(FrameBuffer& frameBuffer, uint32_t materialCapacity);
+
+	/// <summary>
+	/// 作り直した古いバッファのうち、GPUが使い終わったものを解放
+	/// </summary>
+	void ReleaseRetiredBuffers();
+
+private:
+	// DirectXCommon参照
+	DirectXCommon* directXCommon_ = nullptr;
+
+	bool isEnabled_ = true;
+	bool isInitialized_ = false;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+
+	// フレームごとのマテリアルバッファ
+	FrameBuffer frameBuffers_[DirectXCommon::kFrameCount];
+
+	// 作り直した古いバッファ（このフレームの描画が終わるまで残す）
+	struct RetiredBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t frame = 0;
+	};
+	std::vector<RetiredBuffer> retiredBuffers_;
+
+	// 統計
+	Statistics statistics_;
+	Statistics lastFrameStatistics_;
+};
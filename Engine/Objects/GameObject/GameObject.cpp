@@ -4,12 +4,18 @@
 // 静的メンバの定義
 Material GameObject::dummyMaterial_;
 
+GameObject::~GameObject() {
+	// 八分木に残らないように登録を解除
+	SetSceneOctree(nullptr);
+}
+
 void GameObject::Initialize(DirectXCommon* dxCommon, const std::string& modelTag, const std::string& textureName) {
 	directXCommon_ = dxCommon;
 	modelTag_ = modelTag;
-	textureName_ = textureName;
+	SetTexture(textureName);
 
-	// 共有モデルを取得
+	// 共有モデルを取得（解放後に古いポインタを使わないよう、以降はハンドルから引き直す）
+	modelHandle_ = modelManager_->AcquireHandle(modelTag);
 	sharedModel_ = modelManager_->GetModel(modelTag);
 	if (sharedModel_ == nullptr) {
 		Logger::Log(Logger::GetStream(), std::format("Model '{}' not found! Call ModelManager::LoadModel first.\n", modelTag));
@@ -37,7 +43,16 @@ void GameObject::Initialize(DirectXCommon* dxCommon, const std::string& modelTag
 	hasIndividualMaterials_ = false;
 }
 
+void GameObject::SetTexture(const std::string& textureName) {
+	textureName_ = textureName;
+	// 描画で毎回タグ名から探さないようにハンドルにしておく
+	textureHandle_ = textureName.empty() ? TextureHandle{} : textureManager_->AcquireHandle(textureName);
+}
+
 void GameObject::Update(const Matrix4x4& viewProjectionMatrix) {
+	// モデルが解放されていたらnullptrになり、以降の描画などは止まる
+	sharedModel_ = modelManager_->GetModel(modelHandle_);
+
 	// アクティブでない場合は更新を止める
 	if (!isActive_) {
 		return;
@@ -46,6 +61,11 @@ void GameObject::Update(const Matrix4x4& viewProjectionMatrix) {
 	// トランスフォーム行列の更新
 	transform_.UpdateMatrix(viewProjectionMatrix);
 
+	// 動いた時だけ八分木のAABBを更新
+	if (sceneOctree_ && transform_.IsWorldMatrixChanged()) {
+		sceneOctree_->Refit(sceneOctreeProxy_, GetWorldBounds());
+	}
+
 	// 個別マテリアルがある場合は更新
 	if (hasIndividualMaterials_) {
 		individualMaterials_.UpdateAllUVTransforms();
@@ -57,18 +77,44 @@ void GameObject::Update(const Matrix4x4& viewProjectionMatrix) {
 }
 
 void GameObject::Draw(const Light& directionalLight) {
+	// Update後に解放された場合に備えて引き直す（配列の添字で引くだけ）
+	sharedModel_ = modelManager_->GetModel(modelHandle_);
+
 	// 非表示、アクティブでない場合、または共有モデルがない場合は描画しない
 	if (!isVisible_ || !isActive_ || !sharedModel_ || !sharedModel_->IsValid()) {
 		return;
 	}
 
-	ID3D12GraphicsCommandList* commandList = directXCommon_->GetCommandList();
+	// 遮蔽物の奥に隠れている場合は描画しない（遮蔽物自身は判定しない）
+	OcclusionCuller* occlusionCuller = OcclusionCuller::GetInstance();
+	if (!isOccluder_ && occlusionCuller->IsActive()) {
+		const AABB worldBounds = GetWorldBounds();
+		if (!occlusionCuller->IsVisible(worldBounds.min, worldBounds.max)) {
+			return;
+		}
+	}
+
+	// ステートキャッシュ経由で設定（前のオブジェクトと同じ設定は省かれる）
+	GraphicsStateCache& stateCache = directXCommon_->GetStateCache();
+
+	// バインドレスの場合はマテリアルとテクスチャを描画ごとに切り替えず、番号だけ渡す
+	BindlessMaterialTable* bindlessTable = BindlessMaterialTable::GetInstance();
+	const bool isBindless = bindlessTable->IsEnabled();
+
+	// 3D用のPSOを設定（線分やスプライトの後でも正しく描画できるように）
+	if (isBindless) {
+		bindlessTable->Bind(stateCache);
+	} else {
+		stateCache.SetGraphicsRootSignature(directXCommon_->GetRootSignature());
+		stateCache.SetPipelineState(directXCommon_->GetPipelineState());
+		stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	}
 
 	// ライトを設定
-	commandList->SetGraphicsRootConstantBufferView(3, directionalLight.GetResource()->GetGPUVirtualAddress());
+	stateCache.SetGraphicsRootConstantBufferView(3, directionalLight.GetResource()->GetGPUVirtualAddress());
 
 	// トランスフォームを設定（全メッシュ共通）
-	commandList->SetGraphicsRootConstantBufferView(1, transform_.GetResource()->GetGPUVirtualAddress());
+	stateCache.SetGraphicsRootConstantBufferView(1, transform_.GetResource()->GetGPUVirtualAddress());
 
 	// 全メッシュを描画（マルチマテリアル対応）
 	const auto& meshes = sharedModel_->GetMeshes();
@@ -85,28 +131,103 @@ void GameObject::Draw(const Light& directionalLight) {
 			materialIndex = 0; // フォールバック
 		}
 
-		// マテリアルを設定（個別マテリアルがあれば優先使用）
-		if (hasIndividualMaterials_) {
-			commandList->SetGraphicsRootConstantBufferView(0,
-				individualMaterials_.GetMaterial(materialIndex).GetResource()->GetGPUVirtualAddress());
+		// マテリアル（個別マテリアルがあれば優先使用）
+		const Material& material = hasIndividualMaterials_ ?
+			individualMaterials_.GetMaterial(materialIndex) : sharedModel_->GetMaterial(materialIndex);
+
+		// テクスチャ（カスタムテクスチャ → モデル付属のテクスチャの順、ハンドルなので配列を引くだけ）
+		const TextureHandle textureHandle = textureHandle_.IsValid() ?
+			textureHandle_ : sharedModel_->GetTextureHandle(materialIndex);
+
+		if (isBindless) {
+			// テクスチャがなければ白を使う
+			uint32_t textureIndex = textureManager_->GetTextureIndex(textureHandle);
+			if (textureIndex == UINT32_MAX) {
+				textureIndex = textureManager_->GetTextureIndex(textureManager_->GetDefaultHandle());
+			}
+			stateCache.SetGraphicsRoot32BitConstant(BindlessMaterialTable::kRootMaterialIndex,
+				bindlessTable->PushMaterial(material.GetData(), textureIndex), 0);
 		} else {
-			commandList->SetGraphicsRootConstantBufferView(0,
-				sharedModel_->GetMaterial(materialIndex).GetResource()->GetGPUVirtualAddress());
-		}
+			// マテリアルを設定
+			stateCache.SetGraphicsRootConstantBufferView(0, material.GetResource()->GetGPUVirtualAddress());
 
-		// テクスチャの設定
-		if (!textureName_.empty()) {
-			// カスタムテクスチャが設定されている場合
-			commandList->SetGraphicsRootDescriptorTable(2, textureManager_->GetTextureHandle(textureName_));
-		} else if (sharedModel_->HasTexture(materialIndex)) {
-			// モデル付属のテクスチャがある場合
-			commandList->SetGraphicsRootDescriptorTable(2,
-				textureManager_->GetTextureHandle(sharedModel_->GetTextureTagName(materialIndex)));
+			// テクスチャの設定
+			if (textureHandle.IsValid()) {
+				stateCache.SetGraphicsRootDescriptorTable(2, textureManager_->GetTextureHandle(textureHandle));
+			}
 		}
 
 		// メッシュをバインドして描画
-		const_cast<Mesh&>(mesh).Bind(commandList);
-		const_cast<Mesh&>(mesh).Draw(commandList);
+		const_cast<Mesh&>(mesh).Bind(stateCache);
+		const_cast<Mesh&>(mesh).Draw(stateCache);
+	}
+}
+
+void GameObject::SubmitOccluder() const {
+	if (!isOccluder_ || !isVisible_ || !isActive_ || !sharedModel_ || !sharedModel_->IsValid()) {
+		return;
+	}
+
+	OcclusionCuller* occlusionCuller = OcclusionCuller::GetInstance();
+	if (!occlusionCuller->IsEnabled()) {
+		return;
+	}
+
+	const Matrix4x4 worldMatrix = transform_.GetWorldMatrix();
+	for (const Mesh& mesh : sharedModel_->GetMeshes()) {
+		const auto& vertices = mesh.GetVertices();
+		const auto& indices = mesh.GetIndices();
+		occlusionCuller->AddOccluder(vertices.data(), vertices.size(),
+			indices.empty() ? nullptr : indices.data(), indices.size(),
+			worldMatrix);
+	}
+}
+
+AABB GameObject::GetWorldBounds() const {
+	if (!sharedModel_) {
+		const Vector3 position = transform_.GetPosition();
+		return { position, position };
+	}
+
+	// ローカルAABBの8頂点を変換して囲み直す
+	const AABB localBounds = sharedModel_->GetLocalBounds();
+	const Matrix4x4 worldMatrix = transform_.GetWorldMatrix();
+	AABB worldBounds{};
+	for (uint32_t i = 0; i < 8; ++i) {
+		const Vector3 corner = {
+			(i & 1) ? localBounds.max.x : localBounds.min.x,
+			(i & 2) ? localBounds.max.y : localBounds.min.y,
+			(i & 4) ? localBounds.max.z : localBounds.min.z,
+		};
+		const Vector3 world = Transform(corner, worldMatrix);
+		if (i == 0) {
+			worldBounds.min = world;
+			worldBounds.max = world;
+			continue;
+		}
+		worldBounds.min.x = (std::min)(worldBounds.min.x, world.x);
+		worldBounds.min.y = (std::min)(worldBounds.min.y, world.y);
+		worldBounds.min.z = (std::min)(worldBounds.min.z, world.z);
+		worldBounds.max.x = (std::max)(worldBounds.max.x, world.x);
+		worldBounds.max.y = (std::max)(worldBounds.max.y, world.y);
+		worldBounds.max.z = (std::max)(worldBounds.max.z, world.z);
+	}
+	return worldBounds;
+}
+
+void GameObject::SetSceneOctree(SceneOctree* sceneOctree) {
+	if (sceneOctree_ == sceneOctree) {
+		return;
+	}
+
+	if (sceneOctree_) {
+		sceneOctree_->Unregister(sceneOctreeProxy_);
+		sceneOctreeProxy_ = SceneOctree::kInvalidProxy;
+	}
+
+	sceneOctree_ = sceneOctree;
+	if (sceneOctree_) {
+		sceneOctreeProxy_ = sceneOctree_->Register(this, GetWorldBounds());
 	}
 }
 
@@ -3,10 +3,13 @@
 #include <memory>
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "Objects/GameObject/Transform3D.h"
+#include "Objects/GameObject/BindlessMaterialTable.h"
 #include "Objects/Light/Light.h"
 #include "Managers/Texture/TextureManager.h"
 #include "Managers/Model/ModelManager.h"
 #include "Managers/ObjectID/ObjectIDManager.h"
+#include "Culling/OcclusionCuller.h"
+#include "Culling/SceneOctree.h"
 
 /// <summary>
 /// ゲームオブジェクト - 共有モデルと個別Transform、個別マテリアルを使用
@@ -15,7 +18,7 @@ class GameObject
 {
 public:
 	GameObject() = default;
-	virtual ~GameObject() = default;
+	virtual ~GameObject();
 
 	/// <summary>
 	/// 初期化（共有モデルを使用）
@@ -42,6 +45,26 @@ public:
 	/// </summary>
 	virtual void ImGui();
 
+	/// <summary>
+	/// 遮蔽物としてOcclusionCullerに登録（遮蔽物フラグが立っている場合のみ）
+	/// Updateの後、OcclusionCuller::Rasterizeの前に呼ぶ
+	/// </summary>
+	void SubmitOccluder() const;
+
+	/// <summary>
+	/// ワールド空間のAABBを取得（Updateで計算した行列を使う）
+	/// </summary>
+	AABB GetWorldBounds() const;
+
+	/// <summary>
+	/// シーンの八分木に登録する（nullptrで登録解除）
+	/// 登録中はUpdateでワールド行列が変わった時だけAABBを更新する
+	/// 八分木はこのオブジェクトより後に破棄すること
+	/// </summary>
+	/// <param name="sceneOctree">登録先の八分木</param>
+	void SetSceneOctree(SceneOctree* sceneOctree);
+	SceneOctree* GetSceneOctree() const { return sceneOctree_; }
+
 	// Transform関連のGetter/Setter
 	Vector3 GetPosition() const { return transform_.GetPosition(); }
 	Vector3 GetRotation() const { return transform_.GetRotation(); }
@@ -134,8 +157,12 @@ public:
 	void SetActive(bool active) { isActive_ = active; }
 	void SetName(const std::string& name) { name_ = name; }
 
+	// オクルージョンカリングの遮蔽物にするか（建物などの大きなモデル向け）
+	bool IsOccluder() const { return isOccluder_; }
+	void SetOccluder(bool occluder) { isOccluder_ = occluder; }
+
 	// テクスチャ操作（プリミティブ用）
-	void SetTexture(const std::string& textureName) { textureName_ = textureName; }
+	void SetTexture(const std::string& textureName);
 	const std::string& GetTextureName() const { return textureName_; }
 	bool HasCustomTexture() const { return !textureName_.empty(); }
 
@@ -144,7 +171,8 @@ protected:
 	Transform3D transform_;					// 個別のトランスフォーム（位置、回転、スケール）
 
 	// 共有リソースへの参照
-	Model* sharedModel_ = nullptr;			// 共有モデルへのポインタ
+	Model* sharedModel_ = nullptr;			// 共有モデルへのポインタ（毎フレームmodelHandle_から引き直す）
+	ModelHandle modelHandle_;				// 共有モデルのハンドル（モデルが解放されたら引いてもnullptrになる）
 
 	// 個別マテリアルシステム
 	MaterialGroup individualMaterials_;		// 個別のマテリアルグループ
@@ -153,9 +181,15 @@ protected:
 	// オブジェクトの状態
 	bool isVisible_ = true;
 	bool isActive_ = true;
+	bool isOccluder_ = false;				// オクルージョンカリングの遮蔽物かどうか
 	std::string name_ = "GameObject";
 	std::string modelTag_ = "";
 	std::string textureName_ = "";			// プリミティブ用のテクスチャ名
+	TextureHandle textureHandle_;			// textureName_のハンドル（空なら無効）
+
+	// 空間分割
+	SceneOctree* sceneOctree_ = nullptr;	// 登録先の八分木
+	uint32_t sceneOctreeProxy_ = SceneOctree::kInvalidProxy;	// 八分木での登録ID
 
 	// システム参照
 	DirectXCommon* directXCommon_ = nullptr;
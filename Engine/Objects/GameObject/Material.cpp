@@ -11,23 +11,25 @@ void Material::Initialize(DirectXCommon* dxCommon) {
 void Material::SetDefaultSettings() {
 	// デフォルト設定
 	// ライティング無効、白色、UV変換は単位行列
-	materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	data_.color = { 1.0f, 1.0f, 1.0f, 1.0f };
 	lightingMode_ = LightingMode::None;
-	materialData_->enableLighting = false;
-	materialData_->useLambertianReflectance = false;
-	materialData_->padding[0] = 0.0f;
-	materialData_->padding[1] = 0.0f;
-	materialData_->uvTransform = MakeIdentity4x4();
+	data_.enableLighting = false;
+	data_.useLambertianReflectance = false;
+	data_.padding[0] = 0.0f;
+	data_.padding[1] = 0.0f;
+	data_.uvTransform = MakeIdentity4x4();
+	Upload();
 }
 
 void Material::SetLitObjectSettings() {
 	// ライト付きオブジェクト用設定
 	// ライティング有効、白色、UV変換は単位行列
-	materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	data_.color = { 1.0f, 1.0f, 1.0f, 1.0f };
 	SetLightingMode(LightingMode::HalfLambert);
-	materialData_->padding[0] = 0.0f;
-	materialData_->padding[1] = 0.0f;
-	materialData_->uvTransform = MakeIdentity4x4();
+	data_.padding[0] = 0.0f;
+	data_.padding[1] = 0.0f;
+	data_.uvTransform = MakeIdentity4x4();
+	Upload();
 }
 
 void Material::SetLightingMode(LightingMode mode) {
@@ -37,29 +39,31 @@ void Material::SetLightingMode(LightingMode mode) {
 	switch (mode) {
 		//ライティングなし
 	case LightingMode::None:
-		materialData_->enableLighting = false;
-		materialData_->useLambertianReflectance = false;
+		data_.enableLighting = false;
+		data_.useLambertianReflectance = false;
 		break;
 
 		// ランバート反射
 	case LightingMode::Lambert:
-		materialData_->enableLighting = true;
-		materialData_->useLambertianReflectance = true;
+		data_.enableLighting = true;
+		data_.useLambertianReflectance = true;
 		break;
 
 		// ハーフランバート反射
 	case LightingMode::HalfLambert:
-		materialData_->enableLighting = true;
-		materialData_->useLambertianReflectance = false;
+		data_.enableLighting = true;
+		data_.useLambertianReflectance = false;
 		break;
 	}
+	Upload();
 }
 
 void Material::UpdateUVTransform() {
 	Matrix4x4 uvTransformMatrix = MakeScaleMatrix({ uvScale_.x, uvScale_.y, 0.0f });
 	uvTransformMatrix = Matrix4x4Multiply(uvTransformMatrix, MakeRotateZMatrix(uvRotateZ_));
 	uvTransformMatrix = Matrix4x4Multiply(uvTransformMatrix, MakeTranslateMatrix({ uvTranslate_.x, uvTranslate_.y, 0.0f }));
-	materialData_->uvTransform = uvTransformMatrix;
+	data_.uvTransform = uvTransformMatrix;
+	Upload();
 }
 
 void Material::CopyFrom(const Material& source) {
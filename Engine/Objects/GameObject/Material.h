@@ -54,29 +54,38 @@ public:
 	/// <param name="source">コピー元のマテリアル</param>
 	void CopyFrom(const Material& source);
 
-	// Getter
-	Vector4 GetColor() const { return materialData_->color; }
+	// Getter（Map先は書き込み専用のメモリなので、CPU側の写しから読む）
+	Vector4 GetColor() const { return data_.color; }
 	LightingMode GetLightingMode() const { return lightingMode_; }
-	Matrix4x4 GetUVTransform() const { return materialData_->uvTransform; }
+	Matrix4x4 GetUVTransform() const { return data_.uvTransform; }
 	Vector2 GetUVTransformScale() const { return uvScale_; }
 	float GetUVTransformRotateZ() const { return uvRotateZ_; }
 	Vector2 GetUVTransformTranslate() const { return uvTranslate_; }
 	ID3D12Resource* GetResource() const { return materialResource_.Get(); }
 	MaterialData* GetMaterialDataPtr() const { return materialData_; }
+	const MaterialData& GetData() const { return data_; }
 
 	// Setter
-	void SetColor(const Vector4& color) { materialData_->color = color; }
+	void SetColor(const Vector4& color) { data_.color = color; Upload(); }
 	void SetLightingMode(LightingMode mode);
-	void SetUVTransform(const Matrix4x4& uvTransform) { materialData_->uvTransform = uvTransform; }
+	void SetUVTransform(const Matrix4x4& uvTransform) { data_.uvTransform = uvTransform; Upload(); }
 	void SetUVTransformScale(const Vector2& uvScale) { uvScale_ = uvScale; UpdateUVTransform(); }
 	void SetUVTransformRotateZ(float uvRotateZ) { uvRotateZ_ = uvRotateZ; UpdateUVTransform(); }
 	void SetUVTransformTranslate(const Vector2& uvTranslate) { uvTranslate_ = uvTranslate; UpdateUVTransform(); }
 
+private:
+	/// <summary>
+	/// CPU側の写しをMap先に書き込む
+	/// </summary>
+	void Upload() { if (materialData_) { *materialData_ = data_; } }
+
 private:
 	// マテリアルリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
 	// マテリアルデータへのポインタ（Map済み）
 	MaterialData* materialData_ = nullptr;
+	// マテリアルデータのCPU側の写し（Getterとバインドレス描画はこちらを読む）
+	MaterialData data_{};
 
 	// ライティングモード
 	LightingMode lightingMode_ = LightingMode::None;
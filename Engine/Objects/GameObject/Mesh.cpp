@@ -281,6 +281,28 @@ void Mesh::Draw(ID3D12GraphicsCommandList* commandList, uint32_t instanceCount)
 	}
 }
 
+void Mesh::Bind(GraphicsStateCache& stateCache)
+{
+	// 頂点バッファをバインド
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView_);
+
+	// インデックスバッファがあればバインド
+	if (HasIndices()) {
+		stateCache.IASetIndexBuffer(&indexBufferView_);
+	}
+}
+
+void Mesh::Draw(GraphicsStateCache& stateCache, uint32_t instanceCount)
+{
+	if (HasIndices()) {
+		// インデックス描画
+		stateCache.DrawIndexedInstanced(GetIndexCount(), instanceCount, 0, 0, 0);
+	} else {
+		// 通常描画
+		stateCache.DrawInstanced(GetVertexCount(), instanceCount, 0, 0);
+	}
+}
+
 void Mesh::UpdateBuffers()
 {
 	CreateVertexBuffer();
@@ -312,7 +334,28 @@ void Mesh::CreateVertexBuffer()
 	vertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(VertexData) * vertices_.size());
 	vertexBufferView_.StrideInBytes = sizeof(VertexData);
 
+	// 頂点が変わったのでローカルAABBも更新
+	UpdateLocalBounds();
+}
 
+void Mesh::UpdateLocalBounds()
+{
+	if (vertices_.empty()) {
+		localBounds_ = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+		return;
+	}
+
+	const Vector4& first = vertices_[0].position;
+	localBounds_.min = { first.x, first.y, first.z };
+	localBounds_.max = localBounds_.min;
+	for (const VertexData& vertex : vertices_) {
+		localBounds_.min.x = (std::min)(localBounds_.min.x, vertex.position.x);
+		localBounds_.min.y = (std::min)(localBounds_.min.y, vertex.position.y);
+		localBounds_.min.z = (std::min)(localBounds_.min.z, vertex.position.z);
+		localBounds_.max.x = (std::max)(localBounds_.max.x, vertex.position.x);
+		localBounds_.max.y = (std::max)(localBounds_.max.y, vertex.position.y);
+		localBounds_.max.z = (std::max)(localBounds_.max.z, vertex.position.z);
+	}
 }
 
 void Mesh::CreateIndexBuffer()
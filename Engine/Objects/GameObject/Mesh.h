@@ -103,6 +103,19 @@ public:
 	/// <param name="instanceCount">インスタンス数（デフォルト：1）</param>
 	void Draw(ID3D12GraphicsCommandList* commandList, uint32_t instanceCount = 1);
 
+	/// <summary>
+	/// バッファをステートキャッシュ経由でバインド（同じバッファの再設定は省かれる）
+	/// </summary>
+	/// <param name="stateCache">ステートキャッシュ</param>
+	void Bind(GraphicsStateCache& stateCache);
+
+	/// <summary>
+	/// ステートキャッシュ経由で描画
+	/// </summary>
+	/// <param name="stateCache">ステートキャッシュ</param>
+	/// <param name="instanceCount">インスタンス数（デフォルト：1）</param>
+	void Draw(GraphicsStateCache& stateCache, uint32_t instanceCount = 1);
+
 	//Getter
 	MeshType GetMeshType() const { return meshType_; }
 	uint32_t GetVertexCount() const { return static_cast<uint32_t>(vertices_.size()); }
@@ -110,6 +123,7 @@ public:
 	bool HasIndices() const { return !indices_.empty(); }
 	const std::vector<VertexData>& GetVertices() const { return vertices_; }
 	const std::vector<uint32_t>& GetIndices() const { return indices_; }
+	const AABB& GetLocalBounds() const { return localBounds_; }							//ローカル空間のAABB
 
 	// マテリアル情報取得（TextureManagerで使用）
 	const std::string& GetTextureFilePath() const { return material_.textureFilePath; }	//ファイルパス
@@ -138,6 +152,11 @@ private:
 	/// </summary>
 	void CreateIndexBuffer();
 
+	/// <summary>
+	/// 頂点からローカルAABBを計算
+	/// </summary>
+	void UpdateLocalBounds();
+
 private:
 	// DirectXCommon参照
 	DirectXCommon* directXCommon_ = nullptr;
@@ -149,6 +168,9 @@ private:
 	std::vector<VertexData> vertices_;
 	std::vector<uint32_t> indices_;
 
+	// ローカル空間のAABB（カリング用、頂点バッファ作成時に更新）
+	AABB localBounds_{};
+
 	// バッファリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
 	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
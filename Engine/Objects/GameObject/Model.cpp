@@ -1,7 +1,7 @@
 #define NOMINMAX
 #include "Model.h"
 #include "Objects/GameObject/MaterialGroup.h"
-#include <fstream>
+#include "BaseSystem/FileSystem/VirtualFileSystem.h"
 #include <sstream>
 
 void Model::Initialize(DirectXCommon* dxCommon, const MeshType meshType, const std::string& directoryPath, const std::string& filename)
@@ -67,6 +67,7 @@ void Model::Initialize(DirectXCommon* dxCommon, const MeshType meshType, const s
 			}
 			materialIndex++;
 		}
+		UpdateTextureHandles();
 
 		filePath_ = directoryPath + "/" + filename;
 	} else {
@@ -84,6 +85,7 @@ void Model::Initialize(DirectXCommon* dxCommon, const MeshType meshType, const s
 
 		textureTagNames_.clear();
 		textureTagNames_.push_back("");
+		UpdateTextureHandles();
 
 		meshMaterialIndices_.clear();
 		meshMaterialIndices_.push_back(0); // 最初のマテリアルを使用
@@ -159,6 +161,7 @@ bool Model::LoadFromOBJ(const std::string& directoryPath, const std::string& fil
 		}
 		materialIndex++;
 	}
+	UpdateTextureHandles();
 
 	Logger::Log(Logger::GetStream(), std::format("Model loaded from OBJ: {} ({} meshes, {} materials)\n",
 		filename, meshes_.size(), materialGroup_.GetMaterialCount()));
@@ -183,17 +186,29 @@ bool Model::LoadFromPrimitive(MeshType meshType, DirectXCommon* dxCommon) {
 
 	textureTagNames_.clear();
 	textureTagNames_.push_back("");
+	UpdateTextureHandles();
 
 	meshMaterialIndices_.clear();
 	meshMaterialIndices_.push_back(0); // 最初のマテリアルを使用
 
 	// プリミティブにはテクスチャは無い
 	filePath_ = "primitive_" + Mesh::MeshTypeToString(meshType);
+	sourceFilePaths_.clear();
 
 	Logger::Log(Logger::GetStream(), std::format("Model loaded from primitive: {}\n", Mesh::MeshTypeToString(meshType)));
 	return true;
 }
 
+void Model::UpdateTextureHandles() {
+	TextureManager* textureManager = TextureManager::GetInstance();
+	textureHandles_.assign(textureTagNames_.size(), TextureHandle{});
+	for (size_t i = 0; i < textureTagNames_.size(); ++i) {
+		if (!textureTagNames_[i].empty()) {
+			textureHandles_[i] = textureManager->AcquireHandle(textureTagNames_[i]);
+		}
+	}
+}
+
 void Model::UpdateMaterials() {
 	materialGroup_.UpdateAllUVTransforms();
 }
@@ -205,6 +220,7 @@ void Model::Unload() {
 	textureTagNames_.clear();
 	meshMaterialIndices_.clear();
 	filePath_.clear();
+	sourceFilePaths_.clear();
 	modelDataList_.clear(); // モデルデータリストをクリア
 }
 
@@ -246,11 +262,14 @@ std::map<std::string, MaterialDataModel> Model::LoadMaterialTemplateFile(const s
 	MaterialDataModel currentMaterial;	//現在処理中のマテリアルデータ
 
 	//2.ファイルを開く
-	std::ifstream file(directoryPath + "/" + filename);//ファイルを開く
-	assert(file.is_open());//開けなかった場合は停止する
+	FileView file = VirtualFileSystem::GetInstance()->Open(directoryPath + "/" + filename);//ファイルを開く（アーカイブにあればそこから）
+	assert(file.IsValid());//開けなかった場合は停止する
 
 	//3.実際にファイルを読み、MaterialDataを構築していく
-	while (std::getline(file, line)) {
+	TextLineReader reader(file.GetText());
+	std::string_view lineView;
+	while (reader.ReadLine(lineView)) {
+		line.assign(lineView);
 		std::string identifier;
 		std::istringstream s(line);
 		s >> identifier;	//先頭の識別子を読む
@@ -310,11 +329,15 @@ std::vector<ModelData> Model::LoadObjFileMulti(const std::string& directoryPath,
 	bool hasExplicitObjects = false;		//明示的にオブジェクト名が指定されているか
 
 	//2.ファイルを開く
-	std::ifstream file(directoryPath + "/" + filename);
-	assert(file.is_open());
+	FileView file = VirtualFileSystem::GetInstance()->Open(directoryPath + "/" + filename);
+	assert(file.IsValid());
+	sourceFilePaths_.assign(1, directoryPath + "/" + filename);
 
 	//3.実際にファイルを読み、ModelDataを構築していく
-	while (std::getline(file, line)) {
+	TextLineReader reader(file.GetText());
+	std::string_view lineView;
+	while (reader.ReadLine(lineView)) {
+		line.assign(lineView);
 		std::string identifier;
 		std::istringstream s(line);
 		s >> identifier;
@@ -412,6 +435,7 @@ std::vector<ModelData> Model::LoadObjFileMulti(const std::string& directoryPath,
 			std::string materialFilename;
 			s >> materialFilename;
 			materials = LoadMaterialTemplateFile(directoryPath, materialFilename);
+			sourceFilePaths_.push_back(directoryPath + "/" + materialFilename);
 		}
 	}
 
@@ -101,6 +101,7 @@ public:
 	void SetTextureTagName(const std::string& tagName, size_t index = 0) {
 		if (index < textureTagNames_.size()) {
 			textureTagNames_[index] = tagName;
+			textureHandles_[index] = tagName.empty() ? TextureHandle{} : TextureManager::GetInstance()->AcquireHandle(tagName);
 		}
 	}
 
@@ -112,6 +113,11 @@ public:
 		return empty;
 	}
 
+	// テクスチャのハンドル（描画ではタグ名ではなくこちらで引く。テクスチャがなければ無効なハンドル）
+	TextureHandle GetTextureHandle(size_t index = 0) const {
+		return index < textureHandles_.size() ? textureHandles_[index] : TextureHandle{};
+	}
+
 	bool HasTexture(size_t index = 0) const {
 		return index < textureTagNames_.size() && !textureTagNames_[index].empty();
 	}
@@ -137,12 +143,38 @@ public:
 	/// <returns>有効かどうか</returns>
 	bool IsValid() const { return !meshes_.empty() && meshes_[0].GetVertexCount() > 0; }
 
+	/// <summary>
+	/// 全メッシュを囲むローカル空間のAABBを取得
+	/// </summary>
+	/// <returns>ローカルAABB</returns>
+	AABB GetLocalBounds() const {
+		if (meshes_.empty()) {
+			return AABB{};
+		}
+		AABB bounds = meshes_[0].GetLocalBounds();
+		for (const Mesh& mesh : meshes_) {
+			const AABB& meshBounds = mesh.GetLocalBounds();
+			bounds.min.x = (std::min)(bounds.min.x, meshBounds.min.x);
+			bounds.min.y = (std::min)(bounds.min.y, meshBounds.min.y);
+			bounds.min.z = (std::min)(bounds.min.z, meshBounds.min.z);
+			bounds.max.x = (std::max)(bounds.max.x, meshBounds.max.x);
+			bounds.max.y = (std::max)(bounds.max.y, meshBounds.max.y);
+			bounds.max.z = (std::max)(bounds.max.z, meshBounds.max.z);
+		}
+		return bounds;
+	}
+
 	/// <summary>
 	/// ファイルパスを取得
 	/// </summary>
 	/// <returns>ファイルパス</returns>
 	const std::string& GetFilePath() const { return filePath_; }
 
+	/// <summary>
+	/// 読み込んだファイルのパス（OBJとMTL。ホットリロードで書き換えたファイルを使っているか調べる）
+	/// </summary>
+	const std::vector<std::string>& GetSourceFilePaths() const { return sourceFilePaths_; }
+
 	/// <summary>
 	/// オブジェクト名のリストを取得
 	/// </summary>
@@ -166,9 +198,18 @@ private:
 
 	// マルチテクスチャ対応
 	std::vector<std::string> textureTagNames_;
+	// textureTagNames_と同じ並びのハンドル
+	std::vector<TextureHandle> textureHandles_;
 
 	// ファイルパス（デバッグ用）
 	std::string filePath_;
+	// 読み込んだファイルのパス（OBJと、そこから読んだMTL）
+	std::vector<std::string> sourceFilePaths_;
+
+	/// <summary>
+	/// textureTagNames_からハンドルを作り直す
+	/// </summary>
+	void UpdateTextureHandles();
 
 	/// <summary>
 	/// OBJファイルを読み込む
@@ -1,4 +1,5 @@
 #include "Transform3D.h"
+#include <cstring>
 
 void Transform3D::Initialize(DirectXCommon* dxCommon)
 {
@@ -15,15 +16,20 @@ void Transform3D::Initialize(DirectXCommon* dxCommon)
 void Transform3D::UpdateMatrix(const Matrix4x4& viewProjectionMatrix)
 {
 	// トランスフォームデータを更新（ローカル→ワールド変換行列）
-	transformData_->World = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+	Matrix4x4 worldMatrix = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
 
 	// 親があれば親のワールド行列を掛ける
 	if (parent_) {
-		transformData_->World = Matrix4x4Multiply(transformData_->World, parent_->GetWorldMatrix());
+		worldMatrix = Matrix4x4Multiply(worldMatrix, parent_->GetWorldMatrix());
 	}
 
+	// 変化したかを記録してから書き込む（GPU用のメモリは読むと遅いのでCPU側の写しと比べる）
+	isWorldMatrixChanged_ = std::memcmp(&worldMatrix, &worldMatrix_, sizeof(Matrix4x4)) != 0;
+	worldMatrix_ = worldMatrix;
+	transformData_->World = worldMatrix;
+
 	// ビュープロジェクション行列を掛け算してWVP行列を計算
-	transformData_->WVP = Matrix4x4Multiply(transformData_->World, viewProjectionMatrix);
+	transformData_->WVP = Matrix4x4Multiply(worldMatrix_, viewProjectionMatrix);
 }
 
 void Transform3D::SetDefaultTransform() {
@@ -36,6 +42,8 @@ void Transform3D::SetDefaultTransform() {
 	// GPU側のデータも単位行列で初期化
 	transformData_->World = MakeIdentity4x4();
 	transformData_->WVP = MakeIdentity4x4();
+	worldMatrix_ = MakeIdentity4x4();
+	isWorldMatrixChanged_ = true;
 }
 
 void Transform3D::AddPosition(const Vector3& Position)
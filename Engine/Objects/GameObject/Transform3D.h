@@ -38,9 +38,11 @@ public:
 	Vector3 GetRotation() const { return transform_.rotate; }
 	Vector3 GetScale() const { return transform_.scale; }
 
-	Matrix4x4 GetWorldMatrix() const { return transformData_->World; };
+	Matrix4x4 GetWorldMatrix() const { return worldMatrix_; };
 	Matrix4x4 GetWVPMatrix() const { return transformData_->WVP; };
 	ID3D12Resource* GetResource() const { return transformResource_.Get(); }
+	///直前のUpdateMatrixでワールド行列が変わったか（空間分割の更新判定用）
+	bool IsWorldMatrixChanged() const { return isWorldMatrixChanged_; }
 	///トランスフォームデータの直接取得（ImGui用）
 	TransformationMatrix* GetTransformDataPtr() const { return transformData_; }
 
@@ -82,4 +84,9 @@ private:
 
 	// 親となるTransform3Dへのポインタ
 	const Transform3D* parent_ = nullptr;
+
+	// ワールド行列のCPU側の写し
+	Matrix4x4 worldMatrix_ = MakeIdentity4x4();
+	// 直前のUpdateMatrixでワールド行列が変わったか
+	bool isWorldMatrixChanged_ = true;
 };
\ No newline at end of file
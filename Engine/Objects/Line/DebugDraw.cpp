@@ -0,0 +1,516 @@
+#include "DebugDraw.h"
+
+DebugDraw* DebugDraw::GetInstance() {
+	static DebugDraw instance;
+	return &instance;
+}
+
+#ifdef DEBUG_DRAW_ENABLED
+#include "Managers/ImGui/ImGuiManager.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <numbers>
+
+namespace {
+
+	// xyzだけを残すマスク（wには色を入れる）
+	const __m128 kMaskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+	inline __m128 LoadVector3(const Vector3& v) {
+		return _mm_set_ps(0.0f, v.z, v.y, v.x);
+	}
+
+	// 色をwに入れたベクトル（LineVertexの4つ目のuint32_t）
+	inline __m128 MakeColorLane(uint32_t color) {
+		return _mm_castsi128_ps(_mm_set_epi32(static_cast<int>(color), 0, 0, 0));
+	}
+
+	// LineVertex（16バイト）を1命令で書き込む
+	inline void StoreVertex(LineVertex* destination, __m128 position, __m128 colorLane) {
+		_mm_storeu_ps(reinterpret_cast<float*>(destination), _mm_or_ps(_mm_and_ps(position, kMaskXYZ), colorLane));
+	}
+
+	inline LineVertex* StoreLine(LineVertex* destination, __m128 start, __m128 end, __m128 colorLane) {
+		StoreVertex(destination, start, colorLane);
+		StoreVertex(destination + 1, end, colorLane);
+		return destination + 2;
+	}
+
+	// 単位円のcos/sin表（円周の分割数+1）
+	struct CircleTable {
+		std::array<float, DebugDraw::kCircleSegments + 1> cosTable;
+		std::array<float, DebugDraw::kCircleSegments + 1> sinTable;
+
+		CircleTable() {
+			for (uint32_t i = 0; i <= DebugDraw::kCircleSegments; ++i) {
+				const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(DebugDraw::kCircleSegments);
+				cosTable[i] = std::cos(angle);
+				sinTable[i] = std::sin(angle);
+			}
+		}
+	};
+	const CircleTable& GetCircleTable() {
+		static const CircleTable table;
+		return table;
+	}
+
+	// 軸に垂直な2軸を作る
+	void MakePerpendicularBasis(const Vector3& axis, Vector3& u, Vector3& v) {
+		const Vector3 reference = (std::fabs(axis.y) < 0.99f) ? Vector3{ 0.0f, 1.0f, 0.0f } : Vector3{ 1.0f, 0.0f, 0.0f };
+		u = Normalize(Cross(reference, axis));
+		v = Cross(axis, u);
+	}
+
+	// AABBの12辺（角の番号はビット0:x 1:y 2:z）
+	const uint8_t kBoxEdges[12][2] = {
+		{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },	// x方向
+		{ 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },	// y方向
+		{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },	// z方向
+	};
+	const uint32_t kBoxLineCount = 12;
+	const uint32_t kSphereLineCount = DebugDraw::kCircleSegments * 3;
+}
+
+///*-----------------------------------------------------------------------*///
+//								フレームの流れ									//
+///*-----------------------------------------------------------------------*///
+
+void DebugDraw::Initialize(DirectXCommon* dxCommon) {
+	lineRenderer_ = std::make_unique<LineRenderer>();
+	lineRenderer_->Initialize(dxCommon);
+
+	persistentVertices_.reserve(LineRenderer::kInitialLineCapacity * LineRenderer::kVertexCountPerLine);
+	persistentRanges_.reserve(256);
+	textMarkers_.reserve(256);
+}
+
+void DebugDraw::Finalize() {
+	lineRenderer_.reset();
+	persistentVertices_.clear();
+	persistentRanges_.clear();
+	textMarkers_.clear();
+}
+
+void DebugDraw::Draw(const Matrix4x4& viewProjectionMatrix) {
+	if (!lineRenderer_) {
+		return;
+	}
+
+	// 残している形状を今フレームの線分の後ろにまとめてコピー
+	if (isEnabled_ && !persistentVertices_.empty()) {
+		const size_t lineCount = persistentVertices_.size() / LineRenderer::kVertexCountPerLine;
+		LineVertex* destination = lineRenderer_->AppendLines(lineCount);
+		std::memcpy(destination, persistentVertices_.data(), sizeof(LineVertex) * persistentVertices_.size());
+	}
+
+	lastFrameLineCount_ = lineRenderer_->GetLineCount();
+	lineRenderer_->Draw(viewProjectionMatrix);
+}
+
+void DebugDraw::DrawTextMarkers(const Matrix4x4& viewProjectionMatrix) {
+	if (!isEnabled_ || textMarkers_.empty()) {
+		return;
+	}
+
+	ImDrawList* drawList = ImGui::GetForegroundDrawList();
+	for (const TextMarker& marker : textMarkers_) {
+		// カメラの後ろは描かない
+		const Vector3& p = marker.position;
+		const float w = p.x * viewProjectionMatrix.m[0][3] + p.y * viewProjectionMatrix.m[1][3] +
+			p.z * viewProjectionMatrix.m[2][3] + viewProjectionMatrix.m[3][3];
+		if (w <= 0.0f) {
+			continue;
+		}
+
+		const Vector3 screen = ConvertWorldToScreenPosition(p, viewProjectionMatrix);
+		// ImGuiの色もR8G8B8A8の並びなのでそのまま渡せる
+		drawList->AddText(ImVec2(screen.x + 4.0f, screen.y - 16.0f), marker.color, marker.text);
+	}
+}
+
+void DebugDraw::EndFrame(float deltaTime) {
+	if (lineRenderer_) {
+		lineRenderer_->Reset();
+	}
+
+	// 期限切れの形状を取り除いて詰める
+	uint32_t writeVertex = 0;
+	size_t writeRange = 0;
+	for (const PersistentRange& range : persistentRanges_) {
+		PersistentRange next = range;
+		if (next.remainingSeconds > 0.0f) {
+			next.remainingSeconds -= deltaTime;
+			if (next.remainingSeconds <= 0.0f) {
+				continue;
+			}
+		} else if (--next.remainingFrames == 0) {
+			continue;
+		}
+
+		if (next.vertexOffset != writeVertex) {
+			std::memmove(persistentVertices_.data() + writeVertex, persistentVertices_.data() + next.vertexOffset,
+				sizeof(LineVertex) * next.vertexCount);
+			next.vertexOffset = writeVertex;
+		}
+		writeVertex += next.vertexCount;
+		persistentRanges_[writeRange++] = next;
+	}
+	persistentVertices_.resize(writeVertex);
+	persistentRanges_.resize(writeRange);
+
+	// テキストマーカーも同様
+	std::erase_if(textMarkers_, [deltaTime](TextMarker& marker) {
+		if (marker.remainingSeconds > 0.0f) {
+			marker.remainingSeconds -= deltaTime;
+			return marker.remainingSeconds <= 0.0f;
+		}
+		return --marker.remainingFrames == 0;
+	});
+}
+
+void DebugDraw::ImGui() {
+	if (ImGui::TreeNode("Debug Draw")) {
+		ImGui::Checkbox("Enabled", &isEnabled_);
+		ImGui::Text("Lines: %u (persistent shapes: %zu, text markers: %zu)",
+			lastFrameLineCount_, persistentRanges_.size(), textMarkers_.size());
+		if (lineRenderer_) {
+			lineRenderer_->ImGui();
+		}
+		ImGui::TreePop();
+	}
+}
+
+LineVertex* DebugDraw::AllocateLines(uint32_t lineCount, const DebugDrawLifetime& lifetime) {
+	if (!isEnabled_ || !lineRenderer_ || lineCount == 0) {
+		return nullptr;
+	}
+
+	// 今のフレームだけのものは描画用の配列に直接書く
+	if (lifetime.seconds <= 0.0f && lifetime.frames <= 1) {
+		return lineRenderer_->AppendLines(lineCount);
+	}
+
+	PersistentRange range;
+	range.vertexOffset = static_cast<uint32_t>(persistentVertices_.size());
+	range.vertexCount = lineCount * LineRenderer::kVertexCountPerLine;
+	range.remainingFrames = (std::max)(lifetime.frames, 1u);
+	range.remainingSeconds = lifetime.seconds;
+	persistentRanges_.push_back(range);
+
+	persistentVertices_.resize(persistentVertices_.size() + range.vertexCount);
+	return persistentVertices_.data() + range.vertexOffset;
+}
+
+///*-----------------------------------------------------------------------*///
+//								頂点の生成										//
+///*-----------------------------------------------------------------------*///
+
+LineVertex* DebugDraw::WriteAABB(LineVertex* destination, const AABB& aabb, uint32_t color) {
+	const __m128 colorLane = MakeColorLane(color);
+	const __m128 minValue = LoadVector3(aabb.min);
+	const __m128 maxValue = LoadVector3(aabb.max);
+
+	// 8つの角をビットでmin/maxから選ぶ
+	__m128 corners[8];
+	for (int i = 0; i < 8; ++i) {
+		const __m128 select = _mm_castsi128_ps(_mm_set_epi32(0, (i & 4) ? -1 : 0, (i & 2) ? -1 : 0, (i & 1) ? -1 : 0));
+		corners[i] = _mm_or_ps(_mm_and_ps(select, maxValue), _mm_andnot_ps(select, minValue));
+	}
+
+	for (const auto& edge : kBoxEdges) {
+		destination = StoreLine(destination, corners[edge[0]], corners[edge[1]], colorLane);
+	}
+	return destination;
+}
+
+LineVertex* DebugDraw::WriteSphere(LineVertex* destination, const SphereMath& sphere, uint32_t color) {
+	const CircleTable& table = GetCircleTable();
+	const __m128 colorLane = MakeColorLane(color);
+	const __m128 center = LoadVector3(sphere.center);
+	const __m128 radius = _mm_set1_ps(sphere.radius);
+
+	// XY、YZ、ZXの3つの大円
+	const __m128 axes[3][2] = {
+		{ _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f), _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f) },
+		{ _mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f), _mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f) },
+		{ _mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f), _mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f) },
+	};
+	for (const auto& axis : axes) {
+		const __m128 u = _mm_mul_ps(axis[0], radius);
+		const __m128 v = _mm_mul_ps(axis[1], radius);
+		__m128 previous = _mm_add_ps(center, u);
+		for (uint32_t i = 1; i <= kCircleSegments; ++i) {
+			const __m128 current = _mm_add_ps(center,
+				_mm_add_ps(_mm_mul_ps(u, _mm_set1_ps(table.cosTable[i])), _mm_mul_ps(v, _mm_set1_ps(table.sinTable[i]))));
+			destination = StoreLine(destination, previous, current, colorLane);
+			previous = current;
+		}
+	}
+	return destination;
+}
+
+LineVertex* DebugDraw::WriteCircle(LineVertex* destination, const Vector3& center, const Vector3& axisU, const Vector3& axisV,
+	float radius, uint32_t segments, float startAngle, float endAngle, uint32_t color) {
+	const __m128 colorLane = MakeColorLane(color);
+	const __m128 centerVector = LoadVector3(center);
+	const __m128 u = _mm_mul_ps(LoadVector3(axisU), _mm_set1_ps(radius));
+	const __m128 v = _mm_mul_ps(LoadVector3(axisV), _mm_set1_ps(radius));
+
+	// 角度は回転の漸化式で進める（分割ごとにcos/sinを呼ばない）
+	const float step = (endAngle - startAngle) / static_cast<float>(segments);
+	const float stepCos = std::cos(step);
+	const float stepSin = std::sin(step);
+	float c = std::cos(startAngle);
+	float s = std::sin(startAngle);
+
+	__m128 previous = _mm_add_ps(centerVector, _mm_add_ps(_mm_mul_ps(u, _mm_set1_ps(c)), _mm_mul_ps(v, _mm_set1_ps(s))));
+	for (uint32_t i = 0; i < segments; ++i) {
+		const float nextC = c * stepCos - s * stepSin;
+		s = s * stepCos + c * stepSin;
+		c = nextC;
+		const __m128 current = _mm_add_ps(centerVector, _mm_add_ps(_mm_mul_ps(u, _mm_set1_ps(c)), _mm_mul_ps(v, _mm_set1_ps(s))));
+		destination = StoreLine(destination, previous, current, colorLane);
+		previous = current;
+	}
+	return destination;
+}
+
+///*-----------------------------------------------------------------------*///
+//								形状の追加										//
+///*-----------------------------------------------------------------------*///
+
+void DebugDraw::AddLine(const Vector3& start, const Vector3& end, const Vector4& color, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(1, lifetime);
+	if (!destination) {
+		return;
+	}
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	destination[0] = { start, packedColor };
+	destination[1] = { end, packedColor };
+}
+
+void DebugDraw::AddAABB(const AABB& aabb, const Vector4& color, DebugDrawLifetime lifetime) {
+	AddAABBs(&aabb, 1, color, lifetime);
+}
+
+void DebugDraw::AddSphere(const SphereMath& sphere, const Vector4& color, DebugDrawLifetime lifetime) {
+	AddSpheres(&sphere, 1, color, lifetime);
+}
+
+void DebugDraw::AddAABBs(const AABB* aabbs, size_t count, const Vector4& color, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(static_cast<uint32_t>(count) * kBoxLineCount, lifetime);
+	if (!destination) {
+		return;
+	}
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	for (size_t i = 0; i < count; ++i) {
+		destination = WriteAABB(destination, aabbs[i], packedColor);
+	}
+}
+
+void DebugDraw::AddSpheres(const SphereMath* spheres, size_t count, const Vector4& color, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(static_cast<uint32_t>(count) * kSphereLineCount, lifetime);
+	if (!destination) {
+		return;
+	}
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	for (size_t i = 0; i < count; ++i) {
+		destination = WriteSphere(destination, spheres[i], packedColor);
+	}
+}
+
+void DebugDraw::AddFrustum(const Matrix4x4& viewProjectionMatrix, const Vector4& color, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(kBoxLineCount, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	// NDCの8つの角（深度0～1）をワールドに戻す
+	const Matrix4x4 inverse = Matrix4x4Inverse(viewProjectionMatrix);
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	const __m128 colorLane = MakeColorLane(packedColor);
+	__m128 corners[8];
+	for (int i = 0; i < 8; ++i) {
+		const Vector3 ndc = { (i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : 0.0f };
+		corners[i] = LoadVector3(Transform(ndc, inverse));
+	}
+	for (const auto& edge : kBoxEdges) {
+		destination = StoreLine(destination, corners[edge[0]], corners[edge[1]], colorLane);
+	}
+}
+
+void DebugDraw::AddAxes(const Matrix4x4& worldMatrix, float size, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(3, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	// 行ベクトルなので0～2行目が各軸、3行目が位置
+	const Vector3 origin = { worldMatrix.m[3][0], worldMatrix.m[3][1], worldMatrix.m[3][2] };
+	const uint32_t colors[3] = {
+		LineRenderer::PackColor({ 1.0f, 0.0f, 0.0f, 1.0f }),
+		LineRenderer::PackColor({ 0.0f, 1.0f, 0.0f, 1.0f }),
+		LineRenderer::PackColor({ 0.0f, 0.0f, 1.0f, 1.0f }),
+	};
+	for (int axis = 0; axis < 3; ++axis) {
+		const Vector3 direction = Normalize(Vector3{ worldMatrix.m[axis][0], worldMatrix.m[axis][1], worldMatrix.m[axis][2] });
+		destination[axis * 2] = { origin, colors[axis] };
+		destination[axis * 2 + 1] = { origin + direction * size, colors[axis] };
+	}
+}
+
+void DebugDraw::AddArrow(const Vector3& start, const Vector3& end, const Vector4& color, float headSize, DebugDrawLifetime lifetime) {
+	const Vector3 diff = end - start;
+	const float length = Length(diff);
+	if (length <= 0.0f) {
+		return;
+	}
+
+	LineVertex* destination = AllocateLines(5, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	const Vector3 direction = diff / length;
+	Vector3 u, v;
+	MakePerpendicularBasis(direction, u, v);
+
+	// 軸と、先端から後ろに広がる4本
+	const Vector3 headBase = end - direction * headSize;
+	const float headRadius = headSize * 0.5f;
+	destination[0] = { start, packedColor };
+	destination[1] = { end, packedColor };
+	const Vector3 spokes[4] = { u, -u, v, -v };
+	for (int i = 0; i < 4; ++i) {
+		destination[2 + i * 2] = { end, packedColor };
+		destination[3 + i * 2] = { headBase + spokes[i] * headRadius, packedColor };
+	}
+}
+
+void DebugDraw::AddCapsule(const Vector3& start, const Vector3& end, float radius, const Vector4& color, DebugDrawLifetime lifetime) {
+	// 両端の円、側面の4本、両端の半球の弧（2方向ずつ）
+	const uint32_t halfSegments = kCircleSegments / 2;
+	const uint32_t lineCount = kCircleSegments * 2 + 4 + halfSegments * 4;
+	LineVertex* destination = AllocateLines(lineCount, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	const Vector3 diff = end - start;
+	const float length = Length(diff);
+	const Vector3 axis = (length > 0.0f) ? diff / length : Vector3{ 0.0f, 1.0f, 0.0f };
+	Vector3 u, v;
+	MakePerpendicularBasis(axis, u, v);
+
+	const float pi = std::numbers::pi_v<float>;
+	destination = WriteCircle(destination, start, u, v, radius, kCircleSegments, 0.0f, 2.0f * pi, packedColor);
+	destination = WriteCircle(destination, end, u, v, radius, kCircleSegments, 0.0f, 2.0f * pi, packedColor);
+
+	const Vector3 sides[4] = { u, -u, v, -v };
+	for (const Vector3& side : sides) {
+		destination[0] = { start + side * radius, packedColor };
+		destination[1] = { end + side * radius, packedColor };
+		destination += 2;
+	}
+
+	// 半球はendから外側（axis方向）、startから外側（-axis方向）に膨らむ弧
+	destination = WriteCircle(destination, end, u, axis, radius, halfSegments, 0.0f, pi, packedColor);
+	destination = WriteCircle(destination, end, v, axis, radius, halfSegments, 0.0f, pi, packedColor);
+	destination = WriteCircle(destination, start, u, -axis, radius, halfSegments, 0.0f, pi, packedColor);
+	WriteCircle(destination, start, v, -axis, radius, halfSegments, 0.0f, pi, packedColor);
+}
+
+void DebugDraw::AddSpline(const std::vector<Vector3>& points, const Vector4& color, uint32_t segmentsPerSpan, DebugDrawLifetime lifetime) {
+	if (points.size() < 4 || segmentsPerSpan == 0) {
+		return;
+	}
+
+	const uint32_t lineCount = static_cast<uint32_t>(points.size() - 1) * segmentsPerSpan;
+	LineVertex* destination = AllocateLines(lineCount, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	Vector3 previous = CatmullRomPosition(points, 0.0f);
+	for (uint32_t i = 1; i <= lineCount; ++i) {
+		const Vector3 current = CatmullRomPosition(points, static_cast<float>(i) / static_cast<float>(lineCount));
+		destination[0] = { previous, packedColor };
+		destination[1] = { current, packedColor };
+		destination += 2;
+		previous = current;
+	}
+}
+
+void DebugDraw::AddTextMarker(const Vector3& position, const char* text, const Vector4& color, DebugDrawLifetime lifetime) {
+	if (!isEnabled_) {
+		return;
+	}
+
+	// 位置がわかるように小さな十字も描く
+	const float size = 0.1f;
+	AddLine(position - Vector3{ size, 0.0f, 0.0f }, position + Vector3{ size, 0.0f, 0.0f }, color, lifetime);
+	AddLine(position - Vector3{ 0.0f, size, 0.0f }, position + Vector3{ 0.0f, size, 0.0f }, color, lifetime);
+	AddLine(position - Vector3{ 0.0f, 0.0f, size }, position + Vector3{ 0.0f, 0.0f, size }, color, lifetime);
+
+	TextMarker marker;
+	marker.position = position;
+	marker.color = LineRenderer::PackColor(color);
+	std::snprintf(marker.text, sizeof(marker.text), "%s", text ? text : "");
+	marker.remainingFrames = (std::max)(lifetime.frames, 1u);
+	marker.remainingSeconds = lifetime.seconds;
+	textMarkers_.push_back(marker);
+}
+
+void DebugDraw::AddSegment(const Segment& segment, const Vector4& color, DebugDrawLifetime lifetime) {
+	AddLine(segment.origin, segment.origin + segment.diff, color, lifetime);
+}
+
+void DebugDraw::AddPlane(const PlaneMath& plane, float size, const Vector4& color, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(7, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	const Vector3 normal = Normalize(plane.normal);
+	const Vector3 center = normal * plane.distance;
+	Vector3 u, v;
+	MakePerpendicularBasis(normal, u, v);
+	u = u * size;
+	v = v * size;
+
+	// 四角形の外周、対角線2本、法線
+	const Vector3 corners[4] = { center + u + v, center - u + v, center - u - v, center + u - v };
+	for (int i = 0; i < 4; ++i) {
+		destination[i * 2] = { corners[i], packedColor };
+		destination[i * 2 + 1] = { corners[(i + 1) % 4], packedColor };
+	}
+	destination[8] = { corners[0], packedColor };
+	destination[9] = { corners[2], packedColor };
+	destination[10] = { corners[1], packedColor };
+	destination[11] = { corners[3], packedColor };
+	destination[12] = { center, packedColor };
+	destination[13] = { center + normal * size, packedColor };
+}
+
+void DebugDraw::AddTriangle(const TriangleMath& triangle, const Vector4& color, DebugDrawLifetime lifetime) {
+	LineVertex* destination = AllocateLines(3, lifetime);
+	if (!destination) {
+		return;
+	}
+
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	for (int i = 0; i < 3; ++i) {
+		destination[i * 2] = { triangle.vertices[i], packedColor };
+		destination[i * 2 + 1] = { triangle.vertices[(i + 1) % 3], packedColor };
+	}
+}
+
+#endif
@@ -0,0 +1,173 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include "Objects/Line/LineRenderer.h"
+#include "MyMath/MyFunction.h"
+
+// デバッグビルドの時だけ有効（リリースでは全ての関数が空のインライン関数になり、呼び出しごと消える）
+#ifdef _DEBUG
+#define DEBUG_DRAW_ENABLED
+#endif
+
+#ifdef DEBUG_DRAW_ENABLED
+#define DEBUG_DRAW_BODY ;
+#else
+#define DEBUG_DRAW_BODY {}
+#endif
+
+/// <summary>
+/// デバッグ描画の表示期間
+/// </summary>
+struct DebugDrawLifetime {
+	uint32_t frames = 1;	// 表示するフレーム数（1で今のフレームだけ）
+	float seconds = 0.0f;	// 表示する秒数（0より大きい時はこちらを使う）
+
+	static DebugDrawLifetime Frames(uint32_t frameCount) { return { frameCount, 0.0f }; }
+	static DebugDrawLifetime Seconds(float time) { return { 1, time }; }
+};
+
+/// <summary>
+/// 即時モードのデバッグ描画
+/// どこからでも形状を追加でき、Engineが3D描画の最後にLineRendererでまとめて描画する
+/// 頂点はSSEで生成して描画用の配列に直接書き込むので、形状ごとのメモリ確保は起きない
+/// 複数フレーム残す形状は別の配列に溜めておき、期限が切れたら詰めて取り除く
+/// </summary>
+class DebugDraw {
+public:
+	// 円を何本の線分で描くか
+	static const uint32_t kCircleSegments = 24;
+
+	//シングルトン
+	static DebugDraw* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	void Initialize(DirectXCommon* dxCommon) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// 終了処理（GPUリソースと溜まった形状を解放）
+	/// </summary>
+	void Finalize() DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// 溜まった線分を描画（Engineがオフスクリーン描画の最後に呼ぶ）
+	/// </summary>
+	void Draw(const Matrix4x4& viewProjectionMatrix) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// テキストマーカーをImGuiの最前面に描画（EngineがImGuiの受付終了前に呼ぶ）
+	/// </summary>
+	void DrawTextMarkers(const Matrix4x4& viewProjectionMatrix) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// フレームの終了（期限切れの形状を取り除く）
+	/// </summary>
+	/// <param name="deltaTime">経過時間（秒）</param>
+	void EndFrame(float deltaTime) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// ImGui表示
+	/// </summary>
+	void ImGui() DEBUG_DRAW_BODY
+
+	///*-----------------------------------------------------------------------*///
+	//								形状の追加										//
+	///*-----------------------------------------------------------------------*///
+
+	void AddLine(const Vector3& start, const Vector3& end, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+	void AddAABB(const AABB& aabb, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+	void AddSphere(const SphereMath& sphere, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// まとめて追加（大量の当たり判定の可視化用）
+	/// </summary>
+	void AddAABBs(const AABB* aabbs, size_t count, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+	void AddSpheres(const SphereMath* spheres, size_t count, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// ビュープロジェクション行列の視錐台（深度0～1）
+	/// </summary>
+	void AddFrustum(const Matrix4x4& viewProjectionMatrix, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// ワールド行列の軸（X:赤 Y:緑 Z:青）
+	/// </summary>
+	void AddAxes(const Matrix4x4& worldMatrix, float size, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	void AddArrow(const Vector3& start, const Vector3& end, const Vector4& color, float headSize = 0.2f, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+	void AddCapsule(const Vector3& start, const Vector3& end, float radius, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// CatmullRomスプライン（制御点は4点以上）
+	/// </summary>
+	void AddSpline(const std::vector<Vector3>& points, const Vector4& color, uint32_t segmentsPerSpan = 8, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	/// <summary>
+	/// 位置に小さな十字と文字を表示
+	/// </summary>
+	void AddTextMarker(const Vector3& position, const char* text, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	// MyFunction.hの形状
+	void AddSegment(const Segment& segment, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+	void AddPlane(const PlaneMath& plane, float size, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+	void AddTriangle(const TriangleMath& triangle, const Vector4& color, DebugDrawLifetime lifetime = {}) DEBUG_DRAW_BODY
+
+	// 有効/無効（無効の間は追加しても捨てる）
+	void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+	bool IsEnabled() const { return isEnabled_; }
+
+private:
+	DebugDraw() = default;
+	~DebugDraw() = default;
+	DebugDraw(const DebugDraw&) = delete;
+	DebugDraw& operator=(const DebugDraw&) = delete;
+
+	bool isEnabled_ = true;
+
+#ifdef DEBUG_DRAW_ENABLED
+	// 複数フレーム残す形状の頂点範囲
+	struct PersistentRange {
+		uint32_t vertexOffset = 0;
+		uint32_t vertexCount = 0;
+		uint32_t remainingFrames = 0;
+		float remainingSeconds = 0.0f;
+	};
+
+	// テキストマーカー
+	struct TextMarker {
+		Vector3 position{};
+		uint32_t color = 0;
+		char text[64]{};
+		uint32_t remainingFrames = 0;
+		float remainingSeconds = 0.0f;
+	};
+
+	/// <summary>
+	/// 線分の書き込み先を確保（1フレームだけならLineRendererに直接、残すものは別の配列に）
+	/// </summary>
+	LineVertex* AllocateLines(uint32_t lineCount, const DebugDrawLifetime& lifetime);
+
+	/// <summary>
+	/// 形状ごとの頂点生成（書き込んだ頂点の次の位置を返す）
+	/// </summary>
+	static LineVertex* WriteAABB(LineVertex* destination, const AABB& aabb, uint32_t color);
+	static LineVertex* WriteSphere(LineVertex* destination, const SphereMath& sphere, uint32_t color);
+	static LineVertex* WriteCircle(LineVertex* destination, const Vector3& center, const Vector3& axisU, const Vector3& axisV,
+		float radius, uint32_t segments, float startAngle, float endAngle, uint32_t color);
+
+	// 線分の描画先
+	std::unique_ptr<LineRenderer> lineRenderer_;
+
+	// 複数フレーム残す形状
+	std::vector<LineVertex> persistentVertices_;
+	std::vector<PersistentRange> persistentRanges_;
+
+	// テキストマーカー
+	std::vector<TextMarker> textMarkers_;
+
+	// 前フレームの線分数（ImGui表示用）
+	uint32_t lastFrameLineCount_ = 0;
+#endif
+};
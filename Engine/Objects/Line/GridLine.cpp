@@ -2,8 +2,10 @@
 #include "GridLine.h"
 #include "Managers/ImGui/ImGuiManager.h"
 #include "Managers/Texture/TextureManager.h"
+#include "Managers/Texture/TextureUploadQueue.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 void GridLine::Initialize(DirectXCommon* dxCommon,
 	const GridLineType& GridLineType,
@@ -19,10 +21,6 @@ void GridLine::Initialize(DirectXCommon* dxCommon,
 	// Transformを初期化
 	transform_.Initialize(dxCommon);
 
-	// LineRendererを初期化
-	lineRenderer_ = std::make_unique<LineRenderer>();
-	lineRenderer_->Initialize(dxCommon);
-
 	// デフォルトでグリッドを作成
 	CreateGrid(GridLineType,
 		size,
@@ -43,6 +41,7 @@ void GridLine::CreateGrid(
 	Clear();
 
 	// 設定を保存
+	gridType_ = GridLineType;
 	gridSize_ = size;
 	gridInterval_ = interval;
 	gridMajorInterval_ = majorInterval;
@@ -69,16 +68,16 @@ void GridLine::CreateGrid(
 
 void GridLine::AddLine(const Vector3& start, const Vector3& end, const Vector4& color)
 {
-	if (lineRenderer_) {
-		lineRenderer_->AddLine(start, end, color);
-	}
+	const uint32_t packedColor = LineRenderer::PackColor(color);
+	vertices_.push_back({ start, packedColor });
+	vertices_.push_back({ end, packedColor });
+	isDirty_ = true;
 }
 
 void GridLine::Clear()
 {
-	if (lineRenderer_) {
-		lineRenderer_->Reset();
-	}
+	vertices_.clear();
+	isDirty_ = true;
 }
 
 void GridLine::Update(const Matrix4x4& viewProjectionMatrix)
@@ -97,10 +96,70 @@ void GridLine::Draw(const Matrix4x4& viewProjectionMatrix)
 		return;
 	}
 
-	// LineRendererで一括描画
-	if (lineRenderer_ && !lineRenderer_->IsEmpty()) {
-		lineRenderer_->Draw(viewProjectionMatrix);
+	// 線分が変わっていれば頂点バッファを作り直す
+	if (isDirty_) {
+		RebuildVertexBuffer();
+	}
+	if (vertexCount_ == 0) {
+		return;
+	}
+
+	// ステートキャッシュ経由で設定（同じ設定の再発行は省かれる）
+	GraphicsStateCache& stateCache = directXCommon_->GetStateCache();
+
+	// 線分用のPSOを設定
+	stateCache.SetGraphicsRootSignature(directXCommon_->GetLineRootSignature());
+	stateCache.SetPipelineState(directXCommon_->GetLinePipelineState());
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+
+	// 頂点バッファとトランスフォーム（RootParameter[0]: VertexShader用）
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView_);
+	stateCache.SetGraphicsRootConstantBufferView(0, transform_.GetResource()->GetGPUVirtualAddress());
+
+	// 一括描画
+	stateCache.DrawInstanced(vertexCount_, 1, 0, 0);
+}
+
+void GridLine::RebuildVertexBuffer()
+{
+	isDirty_ = false;
+	const uint64_t frame = directXCommon_->GetFrameCount();
+
+	// 前に作り直した頂点バッファはGPUが使い終わっていれば解放
+	std::erase_if(retiredVertexBuffers_, [frame](const RetiredVertexBuffer& retired) {
+		return retired.frame + DirectXCommon::kFrameCount <= frame;
+	});
+
+	// 今の頂点バッファは前のフレームの描画で使われているかもしれないので、すぐには解放しない
+	if (vertexBuffer_) {
+		retiredVertexBuffers_.push_back({ vertexBuffer_, frame });
+		vertexBuffer_.Reset();
+	}
+
+	vertexCount_ = static_cast<uint32_t>(vertices_.size());
+	if (vertexCount_ == 0) {
+		return;
+	}
+
+	// 線分数ぴったりの頂点バッファをVRAMに作り、コピー用のキューで一度だけ送る
+	// 描画用のキューはコピーの完了を待つので、このフレームの描画からそのまま使える
+	const size_t bufferSize = sizeof(LineVertex) * vertexCount_;
+	vertexBuffer_ = CreateDefaultBufferResource(directXCommon_->GetDevice(), bufferSize);
+	if (!TextureUploadQueue::GetInstance()->UploadBuffer(vertexBuffer_.Get(), vertices_.data(), bufferSize)) {
+		// 送れなければ（アップロードのキューを使わない構成など）、CPUから書けるヒープに作り直して直接書き込む
+		Logger::Log(Logger::GetStream(), "GridLine: Failed to upload vertex buffer, falling back to upload heap\n");
+		vertexBuffer_ = CreateBufferResource(directXCommon_->GetDevice(), bufferSize);
+		LineVertex* mappedData = nullptr;
+		vertexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
+		std::memcpy(mappedData, vertices_.data(), bufferSize);
+		vertexBuffer_->Unmap(0, nullptr);
 	}
+
+	vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
+	vertexBufferView_.SizeInBytes = static_cast<UINT>(bufferSize);
+	vertexBufferView_.StrideInBytes = sizeof(LineVertex);
+
+	++rebuildCount_;
 }
 
 void GridLine::ImGui()
@@ -111,7 +170,7 @@ void GridLine::ImGui()
 		ImGui::Checkbox("Visible", &isVisible_);
 		ImGui::Checkbox("Active", &isActive_);
 
-		ImGui::Text("Line Count: %zu", GetLineCount());
+		ImGui::Text("Line Count: %zu (rebuilt %u times)", GetLineCount(), rebuildCount_);
 
 		// Transform
 		if (ImGui::CollapsingHeader("Transform")) {
@@ -155,15 +214,10 @@ void GridLine::ImGui()
 			}
 
 			if (ImGui::Button("Regenerate Grid") || gridChanged) {
-				CreateGrid(GridLineType::XZ, gridSize_, gridInterval_, gridMajorInterval_, gridNormalColor_, gridMajorColor_);
+				CreateGrid(gridType_, gridSize_, gridInterval_, gridMajorInterval_, gridNormalColor_, gridMajorColor_);
 			}
 		}
 
-		// LineRendererの詳細情報
-		if (lineRenderer_) {
-			lineRenderer_->ImGui();
-		}
-
 		ImGui::TreePop();
 	}
 #endif
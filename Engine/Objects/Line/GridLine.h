@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <vector>
 #include <d3d12.h>
 #include <wrl.h>
 
@@ -20,6 +21,7 @@ enum class GridLineType {
 /// <summary>
 /// グリッド描画専用クラス
 ///　グリッド線の生成・管理・描画
+/// 線分は設定が変わった時だけ作り直して専用の頂点バッファに一度だけ書き込み、毎フレームは1回の描画命令だけで描く
 /// </summary>
 class GridLine
 {
@@ -77,7 +79,7 @@ public:
 	void Update(const Matrix4x4& viewProjectionMatrix);
 
 	/// <summary>
-	/// 描画処理
+	/// 描画処理（Updateで計算したTransformの行列で描く）
 	/// </summary>
 	/// <param name="viewProjectionMatrix">ビュープロジェクション行列</param>
 	void Draw(const Matrix4x4& viewProjectionMatrix);
@@ -91,7 +93,7 @@ public:
 	bool IsVisible() const { return isVisible_; }
 	bool IsActive() const { return isActive_; }
 	const std::string& GetName() const { return name_; }
-	size_t GetLineCount() const { return lineRenderer_ ? lineRenderer_->GetLineCount() : 0; }
+	size_t GetLineCount() const { return vertices_.size() / LineRenderer::kVertexCountPerLine; }
 
 	// Setter
 	void SetVisible(bool visible) { isVisible_ = visible; }
@@ -111,6 +113,11 @@ private:
 	void CreateXYGrid(float halfSize);
 	void CreateYZGrid(float halfSize);
 
+	/// <summary>
+	/// 頂点バッファを作り直して線分を書き込む（線分が変わった時だけ）
+	/// </summary>
+	void RebuildVertexBuffer();
+
 	// 基本情報
 	DirectXCommon* directXCommon_ = nullptr;
 	bool isVisible_ = true;
@@ -120,10 +127,25 @@ private:
 	// Transform
 	Transform3D transform_;
 
-	// 線描画システム
-	std::unique_ptr<LineRenderer> lineRenderer_;
+	// 線分の頂点（LineRendererと同じ形式）
+	std::vector<LineVertex> vertices_;
+	bool isDirty_ = false;		// 頂点バッファの作り直しが必要か
+
+	// 書き込み済みの頂点バッファ（VRAMに置き、作った後は書き換えない）
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+	uint32_t vertexCount_ = 0;
+	uint32_t rebuildCount_ = 0;	// 作り直した回数（ImGui表示用）
+
+	// 作り直す前の頂点バッファ（GPUが使い終わるまで残す）
+	struct RetiredVertexBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t frame = 0;
+	};
+	std::vector<RetiredVertexBuffer> retiredVertexBuffers_;
 
 	// グリッド設定（ImGui用）
+	GridLineType gridType_ = GridLineType::XZ;
 	float gridSize_ = 50.0f;
 	float gridInterval_ = 1.0f;
 	float gridMajorInterval_ = 10.0f;
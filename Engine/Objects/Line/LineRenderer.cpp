@@ -2,34 +2,32 @@
 #include "Managers/ImGui/ImGuiManager.h"
 #include "BaseSystem/Logger/Logger.h"
 #include <algorithm>
+#include <cstring>
 
 void LineRenderer::Initialize(DirectXCommon* dxCommon) {
 	directXCommon_ = dxCommon;
 
-	// 最大線分数分の頂点バッファを作成（線分1本につき2頂点）
-	const size_t totalVertexCount = kMaxLineCount * kVertexCountPerLine;
-	const size_t vertexBufferSize = sizeof(LineVertex) * totalVertexCount;
-
-	// 頂点バッファ作成
-	vertexBuffer_ = CreateBufferResource(directXCommon_->GetDevice(), vertexBufferSize);
-
-	// 頂点バッファをマップ
-	vertexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&vertexData_));
-
-	// 頂点バッファビューを設定
-	vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
-	vertexBufferView_.SizeInBytes = static_cast<UINT>(vertexBufferSize);
-	vertexBufferView_.StrideInBytes = sizeof(LineVertex);
+	// フレームごとの頂点バッファを作成（線分1本につき2頂点）
+	for (FrameBuffer& frameBuffer : frameBuffers_) {
+		CreateFrameBuffer(frameBuffer, kInitialLineCapacity * kVertexCountPerLine);
+	}
 
 	// トランスフォームバッファ作成
 	transformBuffer_ = CreateBufferResource(directXCommon_->GetDevice(), sizeof(TransformationMatrix));
 	transformBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&transformData_));
 
 	// 線分データの初期化
-	lineData_.reserve(kMaxLineCount);
+	vertices_.reserve(kInitialLineCapacity * kVertexCountPerLine);
 
 	isInitialized_ = true;
-	Logger::Log(Logger::GetStream(), "LineRenderer: Initialized with max lines !!\n");
+	Logger::Log(Logger::GetStream(), "LineRenderer: Initialized !!\n");
+}
+
+uint32_t LineRenderer::PackColor(const Vector4& color) {
+	auto toByte = [](float value) {
+		return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+	return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) | (toByte(color.w) << 24);
 }
 
 void LineRenderer::AddLine(const Vector3& start, const Vector3& end, const Vector4& color) {
@@ -38,26 +36,44 @@ void LineRenderer::AddLine(const Vector3& start, const Vector3& end, const Vecto
 		return;
 	}
 
-	// 最大数チェック
-	if (IsFull()) {
-		Logger::Log(Logger::GetStream(), "LineRenderer: Maximum line reached!\n");
+	// GPUと同じ形式で追加（描画時は変換せずにコピーするだけ）
+	const uint32_t packedColor = PackColor(color);
+	vertices_.push_back({ start, packedColor });
+	vertices_.push_back({ end, packedColor });
+	++version_;
+}
+
+void LineRenderer::AddLines(const LineData* lines, size_t count) {
+	if (!isInitialized_) {
+		Logger::Log(Logger::GetStream(), "LineRenderer: Not initialized!\n");
 		return;
 	}
 
-	// 線分データを追加
-	LineData lineData;
-	lineData.start = start;
-	lineData.end = end;
-	lineData.color = color;
-	lineData_.push_back(lineData);
+	const size_t offset = vertices_.size();
+	vertices_.resize(offset + count * kVertexCountPerLine);
+	LineVertex* destination = vertices_.data() + offset;
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t packedColor = PackColor(lines[i].color);
+		destination[i * kVertexCountPerLine] = { lines[i].start, packedColor };
+		destination[i * kVertexCountPerLine + 1] = { lines[i].end, packedColor };
+	}
+	++version_;
+}
+
+LineVertex* LineRenderer::AppendLines(size_t lineCount) {
+	const size_t offset = vertices_.size();
+	vertices_.resize(offset + lineCount * kVertexCountPerLine);
+	++version_;
+	return vertices_.data() + offset;
+}
 
-	// 頂点バッファの更新が必要
-	needsVertexUpdate_ = true;
+void LineRenderer::Reserve(size_t lineCount) {
+	vertices_.reserve(lineCount * kVertexCountPerLine);
 }
 
 void LineRenderer::Reset() {
-	lineData_.clear();
-	needsVertexUpdate_ = true;
+	vertices_.clear();
+	++version_;
 }
 
 void LineRenderer::Draw(const Matrix4x4& viewProjectionMatrix) {
@@ -65,10 +81,20 @@ void LineRenderer::Draw(const Matrix4x4& viewProjectionMatrix) {
 		return;
 	}
 
-	// 頂点バッファ更新
-	if (needsVertexUpdate_) {
-		UpdateVertexBuffer();
-		needsVertexUpdate_ = false;
+	ReleaseRetiredBuffers();
+
+	// 今のフレームの頂点バッファに書き込む（前に同じ線分を書いていればそのまま使う）
+	FrameBuffer& frameBuffer = GetCurrentFrameBuffer();
+	const uint32_t vertexCount = static_cast<uint32_t>(vertices_.size());
+	uint32_t baseVertex = 0;
+	if (frameBuffer.hasCache && frameBuffer.cachedVersion == version_) {
+		baseVertex = frameBuffer.cachedOffset;
+	} else {
+		baseVertex = AllocateVertices(frameBuffer, vertexCount);
+		std::memcpy(frameBuffer.mappedData + baseVertex, vertices_.data(), sizeof(LineVertex) * vertexCount);
+		frameBuffer.cachedVersion = version_;
+		frameBuffer.cachedOffset = baseVertex;
+		frameBuffer.hasCache = true;
 	}
 
 	// トランスフォーム更新
@@ -77,53 +103,92 @@ void LineRenderer::Draw(const Matrix4x4& viewProjectionMatrix) {
 		transformData_->World = MakeIdentity4x4();
 	}
 
-	ID3D12GraphicsCommandList* commandList = directXCommon_->GetCommandList();
+	// ステートキャッシュ経由で設定（同じ設定の再発行は省かれる）
+	GraphicsStateCache& stateCache = directXCommon_->GetStateCache();
 
 	// 線分用のPSOを設定
-	commandList->SetGraphicsRootSignature(directXCommon_->GetLineRootSignature());
-	commandList->SetPipelineState(directXCommon_->GetLinePipelineState());
+	stateCache.SetGraphicsRootSignature(directXCommon_->GetLineRootSignature());
+	stateCache.SetPipelineState(directXCommon_->GetLinePipelineState());
 
 	// プリミティブトポロジを線分に設定
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
 
 	// 頂点バッファをバインド
-	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+	vertexBufferView.BufferLocation = frameBuffer.resource->GetGPUVirtualAddress();
+	vertexBufferView.SizeInBytes = sizeof(LineVertex) * frameBuffer.capacity;
+	vertexBufferView.StrideInBytes = sizeof(LineVertex);
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView);
 
 	// トランスフォーム設定（RootParameter[0]: VertexShader用）
-	commandList->SetGraphicsRootConstantBufferView(0, transformBuffer_->GetGPUVirtualAddress());
+	stateCache.SetGraphicsRootConstantBufferView(0, transformBuffer_->GetGPUVirtualAddress());
 
 	// 一括描画（線分数 * 2頂点）
-	const uint32_t vertexCount = GetLineCount() * kVertexCountPerLine;
-	commandList->DrawInstanced(vertexCount, 1, 0, 0);
+	stateCache.DrawInstanced(vertexCount, 1, baseVertex, 0);
 
-	// 3D用のPSOに戻す
-	commandList->SetGraphicsRootSignature(directXCommon_->GetRootSignature());
-	commandList->SetPipelineState(directXCommon_->GetPipelineState());
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	// 3D用のPSOへの復帰は行わない（各描画側が必要なステートをキャッシュ経由で設定する）
 }
 
-void LineRenderer::UpdateVertexBuffer() {
-	if (!vertexData_ || lineData_.empty()) {
-		return;
+uint32_t LineRenderer::GetLineCapacity() const {
+	if (!directXCommon_) {
+		return 0;
 	}
+	return frameBuffers_[directXCommon_->GetFrameIndex()].capacity / kVertexCountPerLine;
+}
 
-	// 線分データを頂点データに変換
-	for (size_t i = 0; i < lineData_.size(); ++i) {
-		const LineData& line = lineData_[i];
-
-		// 開始点の頂点
-		size_t vertexIndex = i * kVertexCountPerLine;
-		vertexData_[vertexIndex].position = { line.start.x, line.start.y, line.start.z, 1.0f };
-		vertexData_[vertexIndex].color = line.color;
-		vertexData_[vertexIndex].texcoord = { 0.0f, 0.0f };  // 未使用
-		vertexData_[vertexIndex].normal = { 0.0f, 1.0f, 0.0f };  // 未使用
-
-		// 終了点の頂点
-		vertexData_[vertexIndex + 1].position = { line.end.x, line.end.y, line.end.z, 1.0f };
-		vertexData_[vertexIndex + 1].color = line.color;
-		vertexData_[vertexIndex + 1].texcoord = { 1.0f, 1.0f };  // 未使用
-		vertexData_[vertexIndex + 1].normal = { 0.0f, 1.0f, 0.0f };  // 未使用
+LineRenderer::FrameBuffer& LineRenderer::GetCurrentFrameBuffer() {
+	const uint64_t frame = directXCommon_->GetFrameCount();
+	FrameBuffer& frameBuffer = frameBuffers_[directXCommon_->GetFrameIndex()];
+
+	if (frameBuffer.frame != frame) {
+		// この組を前に使ったフレームのGPU処理は終わっているので先頭から書き直せる
+		// ただし先頭にある前回の内容はそのまま再利用できるように残す
+		frameBuffer.frame = frame;
+		if (frameBuffer.hasCache && frameBuffer.cachedOffset == 0 && frameBuffer.cachedVersion == version_) {
+			frameBuffer.writeOffset = static_cast<uint32_t>(vertices_.size());
+		} else {
+			frameBuffer.writeOffset = 0;
+			frameBuffer.hasCache = false;
+		}
 	}
+	return frameBuffer;
+}
+
+uint32_t LineRenderer::AllocateVertices(FrameBuffer& frameBuffer, uint32_t vertexCount) {
+	if (frameBuffer.writeOffset + vertexCount > frameBuffer.capacity) {
+		// このフレームで既に積んだ描画が古いバッファを参照しているので、解放はGPUが使い終わってから
+		if (frameBuffer.writeOffset > 0) {
+			retiredBuffers_.push_back({ frameBuffer.resource, directXCommon_->GetFrameCount() });
+		}
+
+		// 2倍ずつ広げる
+		uint32_t newCapacity = (std::max)(frameBuffer.capacity, kInitialLineCapacity * kVertexCountPerLine);
+		while (newCapacity < frameBuffer.writeOffset + vertexCount) {
+			newCapacity *= 2;
+		}
+		CreateFrameBuffer(frameBuffer, newCapacity);
+		Logger::Log(Logger::GetStream(), std::format("LineRenderer: Grew vertex buffer to {} lines\n", newCapacity / kVertexCountPerLine));
+	}
+
+	const uint32_t offset = frameBuffer.writeOffset;
+	frameBuffer.writeOffset += vertexCount;
+	return offset;
+}
+
+void LineRenderer::CreateFrameBuffer(FrameBuffer& frameBuffer, uint32_t vertexCapacity) {
+	frameBuffer.resource = CreateBufferResource(directXCommon_->GetDevice(), sizeof(LineVertex) * vertexCapacity);
+	frameBuffer.resource->Map(0, nullptr, reinterpret_cast<void**>(&frameBuffer.mappedData));
+	frameBuffer.capacity = vertexCapacity;
+	frameBuffer.writeOffset = 0;
+	frameBuffer.hasCache = false;
+}
+
+void LineRenderer::ReleaseRetiredBuffers() {
+	// DirectXCommon::kFrameCountフレーム前のものはGPUが使い終わっている
+	const uint64_t frame = directXCommon_->GetFrameCount();
+	std::erase_if(retiredBuffers_, [frame](const RetiredBuffer& retired) {
+		return retired.frame + DirectXCommon::kFrameCount <= frame;
+	});
 }
 
 void LineRenderer::ImGui() {
@@ -131,18 +196,17 @@ void LineRenderer::ImGui() {
 	if (ImGui::TreeNode("Line Renderer")) {
 		// 基本情報
 		ImGui::Checkbox("Visible", &isVisible_);
-		ImGui::Text("Line Count: %d / %d", GetLineCount(), kMaxLineCount);
+		ImGui::Text("Line Count: %u / %u", GetLineCount(), GetLineCapacity());
 
-		// 使用率表示
-		float usage = static_cast<float>(GetLineCount()) / static_cast<float>(kMaxLineCount);
+		// 使用率表示（容量は足りなければ自動で広がる）
+		const uint32_t capacity = (std::max)(GetLineCapacity(), 1u);
+		float usage = (std::min)(static_cast<float>(GetLineCount()) / static_cast<float>(capacity), 1.0f);
 		ImGui::ProgressBar(usage, ImVec2(0.0f, 0.0f),
 			std::format("{:.1f}%", usage * 100.0f).c_str());
 
 		// 状態表示
 		if (IsEmpty()) {
 			ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Status: Empty");
-		} else if (IsFull()) {
-			ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Status: Full");
 		} else {
 			ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Status: Normal");
 		}
@@ -155,4 +219,4 @@ void LineRenderer::ImGui() {
 		ImGui::TreePop();
 	}
 #endif
-}
\ No newline at end of file
+}
@@ -7,14 +7,13 @@
 #include "MyMath/MyFunction.h"
 
 /// <summary>
-/// 線分用の頂点データ構造体
+/// 線分用の頂点データ構造体（16バイト）
 /// </summary>
 struct LineVertex {
-	Vector4 position;  // xyz座標 + w
-	Vector4 color;     // RGBA色
-	Vector2 texcoord;  // テクスチャ座標（未使用だが互換性のため）
-	Vector3 normal;    // 法線（未使用だが互換性のため）
+	Vector3 position;	// xyz座標
+	uint32_t color;		// RGBA色（R8G8B8A8_UNORM）
 };
+static_assert(sizeof(LineVertex) == 16, "LineVertex must match the Line input layout");
 
 /// <summary>
 /// 線分描画データ
@@ -28,13 +27,17 @@ struct LineData {
 /// <summary>
 /// 複数線分の一括描画システム
 /// KamataEngineのPrimitiveDrawerを参考にした実装
+/// 線分はGPUと同じ頂点形式でCPU側に溜め、Drawで今のフレームの頂点バッファに一度にコピーする
+/// 頂点バッファはフレームごとに別のもの（DirectXCommon::kFrameCount組）を使い回すので、GPUが読んでいる最中のものは書き換えない
+/// 容量が足りなければ自動で広げる（上限なし）
+/// 線分が変わっていなければ、前に同じ組へ書いた内容をそのまま使う（グリッドのように作りっぱなしの線はコピーも起きない）
 /// </summary>
 class LineRenderer {
 public:
-	// 線分の最大数（KamataEngineと同じ）
-	static const uint32_t kMaxLineCount = 4096;
 	// 線分の頂点数
 	static const uint32_t kVertexCountPerLine = 2;
+	// 頂点バッファの最初の容量（線分数）
+	static const uint32_t kInitialLineCapacity = 4096;
 
 	LineRenderer() = default;
 	~LineRenderer() = default;
@@ -53,6 +56,27 @@ public:
 	/// <param name="color">色</param>
 	void AddLine(const Vector3& start, const Vector3& end, const Vector4& color);
 
+	/// <summary>
+	/// 線分をまとめて追加
+	/// </summary>
+	/// <param name="lines">線分の配列</param>
+	/// <param name="count">線分数</param>
+	void AddLines(const LineData* lines, size_t count);
+
+	/// <summary>
+	/// 線分の頂点を末尾に確保して書き込み先を返す（呼び出し側が直接書き込む）
+	/// 返したポインタは次に線分を追加するまで有効
+	/// </summary>
+	/// <param name="lineCount">線分数</param>
+	/// <returns>lineCount * 2頂点分の書き込み先</returns>
+	LineVertex* AppendLines(size_t lineCount);
+
+	/// <summary>
+	/// 線分の容量を確保（大量に追加する前に呼ぶと再確保が減る）
+	/// </summary>
+	/// <param name="lineCount">線分数</param>
+	void Reserve(size_t lineCount);
+
 	/// <summary>
 	/// 線分リストをクリア
 	/// </summary>
@@ -69,10 +93,16 @@ public:
 	/// </summary>
 	void ImGui();
 
+	/// <summary>
+	/// 色をR8G8B8A8_UNORMに詰める
+	/// </summary>
+	static uint32_t PackColor(const Vector4& color);
+
 	// Getter
-	uint32_t GetLineCount() const { return static_cast<uint32_t>(lineData_.size()); }
-	bool IsEmpty() const { return lineData_.empty(); }
-	bool IsFull() const { return lineData_.size() >= kMaxLineCount; }
+	uint32_t GetLineCount() const { return static_cast<uint32_t>(vertices_.size() / kVertexCountPerLine); }
+	bool IsEmpty() const { return vertices_.empty(); }
+	// 今のフレームの頂点バッファの容量（線分数）
+	uint32_t GetLineCapacity() const;
 
 	// Setter
 	void SetVisible(bool visible) { isVisible_ = visible; }
@@ -80,35 +110,66 @@ public:
 
 private:
 	/// <summary>
-	/// 頂点バッファを更新
+	/// フレームごとの頂点バッファ
 	/// </summary>
-	void UpdateVertexBuffer();
+	struct FrameBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		LineVertex* mappedData = nullptr;
+		uint32_t capacity = 0;			// 頂点数
+		uint32_t writeOffset = 0;		// 今のフレームで次に書く位置（頂点）
+		uint64_t frame = UINT64_MAX;	// 最後に使ったフレーム
+		// 最後に書いた線分の版と位置（同じ版なら再利用）
+		uint64_t cachedVersion = 0;
+		uint32_t cachedOffset = 0;
+		bool hasCache = false;
+	};
 
 	/// <summary>
-	/// マテリアルバッファを更新
+	/// 今のフレームの頂点バッファを取得（フレームが変わっていれば書き込み位置を戻す）
 	/// </summary>
-	void UpdateMaterialBuffer();
+	FrameBuffer& GetCurrentFrameBuffer();
+
+	/// <summary>
+	/// 頂点バッファから領域を確保（足りなければ作り直す）
+	/// </summary>
+	/// <returns>確保した先頭の頂点位置</returns>
+	uint32_t AllocateVertices(FrameBuffer& frameBuffer, uint32_t vertexCount);
+
+	/// <summary>
+	/// 頂点バッファを作成
+	/// </summary>
+	void CreateFrameBuffer(FrameBuffer& frameBuffer, uint32_t vertexCapacity);
+
+	/// <summary>
+	/// 作り直した古い頂点バッファのうち、GPUが使い終わったものを解放
+	/// </summary>
+	void ReleaseRetiredBuffers();
 
 private:
 	// DirectXCommon参照
 	DirectXCommon* directXCommon_ = nullptr;
 
-	// 線分データ
-	std::vector<LineData> lineData_;
+	// 線分の頂点（GPUと同じ形式）
+	std::vector<LineVertex> vertices_;
+	// 線分が変わるたびに増やす版
+	uint64_t version_ = 1;
 
 	// 表示フラグ
 	bool isVisible_ = true;
 
 	// DirectX12リソース
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+	FrameBuffer frameBuffers_[DirectXCommon::kFrameCount];
 	Microsoft::WRL::ComPtr<ID3D12Resource> transformBuffer_;
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+
+	// 作り直した古い頂点バッファ（このフレームの描画が終わるまで残す）
+	struct RetiredBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t frame = 0;
+	};
+	std::vector<RetiredBuffer> retiredBuffers_;
 
 	// マップされたデータ
-	LineVertex* vertexData_ = nullptr;
 	TransformationMatrix* transformData_ = nullptr;
 
-	// 更新フラグ
-	bool needsVertexUpdate_ = false;
 	bool isInitialized_ = false;
-};
\ No newline at end of file
+};
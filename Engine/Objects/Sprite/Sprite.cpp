@@ -27,6 +27,9 @@ void Sprite::Initialize(DirectXCommon* dxCommon, const std::string& textureName,
 	};
 	transform_.SetTransform(initialTransform);
 
+	// テクスチャのハンドルと、アトラスにまとめたものなら領域を取得
+	ResolveTexture();
+
 	// スプライト専用のマテリアルリソースを作成
 	CreateBuffers();
 
@@ -34,7 +37,7 @@ void Sprite::Initialize(DirectXCommon* dxCommon, const std::string& textureName,
 	imguiPosition_ = transform_.GetPosition();
 	imguiRotation_ = transform_.GetRotation();
 	imguiScale_ = transform_.GetScale();
-	imguiColor_ = materialData_->color;
+	imguiColor_ = color_;
 	imguiUvPosition_ = uvTranslate_;
 	imguiUvScale_ = uvScale_;
 	imguiUvRotateZ_ = uvRotateZ_;
@@ -65,6 +68,9 @@ void Sprite::Initialize(DirectXCommon* dxCommon, const Vector2& center, const Ve
 	};
 	transform_.SetTransform(initialTransform);
 
+	// テクスチャのハンドルと、アトラスにまとめたものなら領域を取得
+	ResolveTexture();
+
 	// スプライト専用のマテリアルリソースを作成
 	CreateBuffers();
 
@@ -72,7 +78,7 @@ void Sprite::Initialize(DirectXCommon* dxCommon, const Vector2& center, const Ve
 	imguiPosition_ = transform_.GetPosition();
 	imguiRotation_ = transform_.GetRotation();
 	imguiScale_ = transform_.GetScale();
-	imguiColor_ = materialData_->color;
+	imguiColor_ = color_;
 	imguiUvPosition_ = uvTranslate_;
 	imguiUvScale_ = uvScale_;
 	imguiUvRotateZ_ = uvRotateZ_;
@@ -97,36 +103,52 @@ void Sprite::Draw()
 		return;
 	}
 
+	SpriteBatch* spriteBatch = SpriteBatch::GetInstance();
+	if (!spriteBatch->IsEnabled()) {
+		DrawImmediate();
+		return;
+	}
+
+	// テクスチャ未設定の時は白テクスチャで描く
+	const D3D12_GPU_DESCRIPTOR_HANDLE texture = textureManager_->GetTextureHandle(textureHandle_);
+
+	// バッチに積む（頂点はCPU側の行列で変換して書き込まれる）
+	spriteBatch->AddSprite(transform_.GetWVPMatrix(), anchor_, uvTransform_, color_, texture, blendMode_, layer_);
+}
+
+void Sprite::DrawImmediate()
+{
+	// 非表示、アクティブでない場合は描画しない
+	if (!isVisible_ || !isActive_) {
+		return;
+	}
+
 	// 通常のUI用スプライト描画処理
-	ID3D12GraphicsCommandList* commandList = directXCommon_->GetCommandList();
+	// ステートキャッシュ経由で設定（スプライトを連続で描画する場合PSOなどの再設定は省かれる）
+	GraphicsStateCache& stateCache = directXCommon_->GetStateCache();
 
 	// スプライト専用のPSOを設定
-	commandList->SetGraphicsRootSignature(directXCommon_->GetSpriteRootSignature());
-	commandList->SetPipelineState(directXCommon_->GetSpritePipelineState());
+	stateCache.SetGraphicsRootSignature(directXCommon_->GetSpriteRootSignature());
+	stateCache.SetPipelineState(directXCommon_->GetSpritePipelineState());
 
 	// プリミティブトポロジを設定
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	//マテリアル
-	commandList->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+	stateCache.SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
 	//トランスフォーム（Transform2Dを使用）
-	commandList->SetGraphicsRootConstantBufferView(1, transform_.GetResource()->GetGPUVirtualAddress());
+	stateCache.SetGraphicsRootConstantBufferView(1, transform_.GetResource()->GetGPUVirtualAddress());
 	// テクスチャをバインド
 	if (!textureName_.empty()) {
-		commandList->SetGraphicsRootDescriptorTable(2, textureManager_->GetTextureHandle(textureName_));
+		stateCache.SetGraphicsRootDescriptorTable(2, textureManager_->GetTextureHandle(textureHandle_));
 	}
 
 	// 頂点バッファをバインド
-	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
-	commandList->IASetIndexBuffer(&indexBufferView_);
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView_);
+	stateCache.IASetIndexBuffer(&indexBufferView_);
 
 	// 描画
-	commandList->DrawIndexedInstanced(static_cast<UINT>(indices_.size()), 1, 0, 0, 0);
-
-	// 3Dの描画設定に戻す
-	commandList->SetGraphicsRootSignature(directXCommon_->GetRootSignature());
-	commandList->SetPipelineState(directXCommon_->GetPipelineState());
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache.DrawIndexedInstanced(static_cast<UINT>(indices_.size()), 1, 0, 0, 0);
 }
 
 void Sprite::ImGui()
@@ -177,7 +199,7 @@ void Sprite::ImGui()
 
 		// Color & UVTransform（SpriteMaterial構造体）
 		if (ImGui::CollapsingHeader("Material")) {
-			imguiColor_ = materialData_->color;
+			imguiColor_ = color_;
 
 			if (ImGui::ColorEdit4("Color", reinterpret_cast<float*>(&imguiColor_.x))) {
 				SetColor(imguiColor_);
@@ -233,6 +255,16 @@ void Sprite::ImGui()
 			}
 		}
 
+		// バッチ描画の設定
+		if (ImGui::CollapsingHeader("Batch")) {
+			ImGui::DragInt("Layer", &layer_);
+			const char* blendModeNames[] = { "None", "AlphaBlend", "Add", "Subtract", "Multiply" };
+			int blendModeIndex = static_cast<int>(blendMode_);
+			if (ImGui::Combo("BlendMode", &blendModeIndex, blendModeNames, IM_ARRAYSIZE(blendModeNames))) {
+				blendMode_ = static_cast<BlendMode>(blendModeIndex);
+			}
+		}
+
 		ImGui::TreePop();
 	}
 #endif
@@ -256,6 +288,7 @@ void Sprite::AddSize(const Vector2& deltaSize)
 
 void Sprite::SetColor(const Vector4& color)
 {
+	color_ = color;
 	if (materialData_) {
 		materialData_->color = color;
 	}
@@ -273,6 +306,13 @@ void Sprite::SetAnchor(const Vector2& anchor)
 	std::memcpy(vertexData, vertices_.data(), sizeof(VertexData) * vertices_.size());
 }
 
+void Sprite::SetTexture(const std::string& textureName)
+{
+	textureName_ = textureName;
+	ResolveTexture();
+	UpdateUVTransform();
+}
+
 void Sprite::SetUVTransformScale(const Vector2& uvScale)
 {
 	uvScale_ = uvScale;
@@ -355,7 +395,8 @@ void Sprite::CreateBuffers()
 	materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
 
 	// SpriteMaterial初期化
-	materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };	// 白色
+	color_ = { 1.0f, 1.0f, 1.0f, 1.0f };				// 白色
+	materialData_->color = color_;
 	UpdateUVTransform();								// UVTransformを初期化
 }
 
@@ -367,5 +408,25 @@ void Sprite::UpdateUVTransform()
 	uvTransformMatrix = Matrix4x4Multiply(uvTransformMatrix, MakeRotateZMatrix(uvRotateZ_));
 	uvTransformMatrix = Matrix4x4Multiply(uvTransformMatrix, MakeTranslateMatrix({ uvTranslate_.x, uvTranslate_.y, 0.0f }));
 
-	materialData_->uvTransform = uvTransformMatrix;
+	// アトラスの領域へ写す（設定したUV変換は画像1枚分の0～1の範囲に掛かる）
+	uvTransformMatrix = Matrix4x4Multiply(uvTransformMatrix, MakeScaleMatrix({ atlasUvScale_.x, atlasUvScale_.y, 1.0f }));
+	uvTransformMatrix = Matrix4x4Multiply(uvTransformMatrix, MakeTranslateMatrix({ atlasUvOffset_.x, atlasUvOffset_.y, 0.0f }));
+
+	uvTransform_ = uvTransformMatrix;
+	materialData_->uvTransform = uvTransform_;
+}
+
+void Sprite::ResolveTexture()
+{
+	// 描画で毎回タグ名から探さないようにハンドルにしておく（未設定なら白）
+	textureHandle_ = textureName_.empty() ? textureManager_->GetDefaultHandle() : textureManager_->AcquireHandle(textureName_);
+
+	const AtlasRegion* region = textureManager_->GetAtlasRegion(textureName_);
+	if (region) {
+		atlasUvOffset_ = region->uvOffset;
+		atlasUvScale_ = region->uvScale;
+	} else {
+		atlasUvOffset_ = { 0.0f, 0.0f };
+		atlasUvScale_ = { 1.0f, 1.0f };
+	}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "MyMath/MyFunction.h"
 #include "Objects/Sprite/Transform2D.h"  // Transform2D
+#include "Objects/Sprite/SpriteBatch.h"  // SpriteBatch
 
 #include "Managers/Texture/TextureManager.h"
 #include "Managers/ObjectID/ObjectIDManager.h"
@@ -67,9 +68,15 @@ public:
 
 	/// <summary>
 	/// 通常の描画処理（UI用スプライト専用）
+	/// SpriteBatchが有効な時はバッチに積み、EngineがUI描画の最後にまとめて描く（オフスクリーン内で描く時はDrawImmediateを使う）
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// バッチを通さずにこのスプライトだけを描画する
+	/// </summary>
+	void DrawImmediate();
+
 	/// <summary>
 	/// ImGui用のデバッグ表示
 	/// </summary>
@@ -93,12 +100,14 @@ public:
 	Vector3 GetScale3D() const { return transform_.GetScale3D(); }
 
 	// Sprite固有のGetter
-	Vector4 GetColor() const { return materialData_->color; }
+	const Vector4& GetColor() const { return color_; }
 	bool IsVisible() const { return isVisible_; }
 	bool IsActive() const { return isActive_; }
 	const std::string& GetName() const { return name_; }
 	const std::string& GetTextureName() const { return textureName_; }
 	Vector2 GetAnchor() const { return anchor_; }
+	int32_t GetLayer() const { return layer_; }
+	BlendMode GetBlendMode() const { return blendMode_; }
 
 	// Transform関連のSetter（2D用）
 	void SetTransform(const Vector2Transform& newTransform) { transform_.SetTransform(newTransform); }
@@ -124,8 +133,13 @@ public:
 	void SetVisible(bool visible) { isVisible_ = visible; }
 	void SetActive(bool active) { isActive_ = active; }
 	void SetName(const std::string& name) { name_ = name; }
-	void SetTexture(const std::string& textureName) { textureName_ = textureName; }
+	// アトラスにまとめたテクスチャなら、ページ上の領域がUV変換に自動で掛かる（UVの繰り返しはできない）
+	void SetTexture(const std::string& textureName);
 	void SetAnchor(const Vector2& anchor);
+	// バッチ描画時の描画順（小さいほど先に描く）
+	void SetLayer(int32_t layer) { layer_ = layer; }
+	// バッチ描画時のブレンドモード（1枚ずつ描く時は常にアルファブレンド）
+	void SetBlendMode(BlendMode blendMode) { blendMode_ = blendMode; }
 
 	// Transform操作（2D用）
 	void AddPosition(const Vector2& deltaPosition) { transform_.AddPosition(deltaPosition); }
@@ -168,6 +182,11 @@ private:
 	/// </summary>
 	void UpdateUVTransform();
 
+	/// <summary>
+	/// テクスチャ名からハンドルを取得し、アトラスにまとめたものならその領域も取得（単体なら全体）
+	/// </summary>
+	void ResolveTexture();
+
 private:
 	// 基本情報
 	DirectXCommon* directXCommon_ = nullptr;
@@ -178,6 +197,7 @@ private:
 	bool isActive_ = true;
 	std::string name_ = "Sprite";
 	std::string textureName_ = "";
+	TextureHandle textureHandle_;	// textureName_のハンドル（描画ではこちらで引く）
 
 	// アンカーポイント（0.0-1.0の範囲）
 	Vector2 anchor_{ 0.5f, 0.5f };
@@ -189,11 +209,23 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
 	SpriteMaterial* materialData_ = nullptr;
 
+	// マテリアルのCPU側の写し（SpriteBatchが頂点に書き込む）
+	Vector4 color_{ 1.0f, 1.0f, 1.0f, 1.0f };
+	Matrix4x4 uvTransform_ = MakeIdentity4x4();
+
+	// バッチ描画用の設定
+	int32_t layer_ = 0;
+	BlendMode blendMode_ = BlendMode::AlphaBlend;
+
 	// UV変換用のローカル変数（ImGuiとの連携用）
 	Vector2 uvTranslate_{ 0.0f, 0.0f };
 	Vector2 uvScale_{ 1.0f, 1.0f };
 	float uvRotateZ_ = 0.0f;
 
+	// アトラス上の領域（UV変換の後に掛ける、単体のテクスチャなら全体）
+	Vector2 atlasUvOffset_{ 0.0f, 0.0f };
+	Vector2 atlasUvScale_{ 1.0f, 1.0f };
+
 	// メッシュデータ
 	std::vector<VertexData> vertices_;
 	std::vector<uint32_t> indices_;
@@ -0,0 +1,328 @@
+#include "SpriteBatch.h"
+#include "Managers/ImGui/ImGuiManager.h"
+#include "BaseSystem/Logger/Logger.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+SpriteBatch* SpriteBatch::GetInstance() {
+	static SpriteBatch instance;
+	return &instance;
+}
+
+void SpriteBatch::Initialize(DirectXCommon* dxCommon) {
+	directXCommon_ = dxCommon;
+
+	// ブレンドモードごとのPSOを作成
+	CreatePipelineStates();
+
+	// フレームごとの頂点バッファと共有のインデックスバッファを作成
+	for (FrameBuffer& frameBuffer : frameBuffers_) {
+		CreateFrameBuffer(frameBuffer, kInitialSpriteCapacity);
+	}
+	CreateIndexBuffer(kInitialSpriteCapacity);
+
+	sprites_.reserve(kInitialSpriteCapacity);
+	sortedIndices_.reserve(kInitialSpriteCapacity);
+
+	isInitialized_ = true;
+	Logger::Log(Logger::GetStream(), "SpriteBatch: Initialized !!\n");
+}
+
+void SpriteBatch::Finalize() {
+	// シェーダーを書き換えた時に作り直すPSOから外す
+	if (directXCommon_) {
+		for (const auto& pipelineState : pipelineStates_) {
+			directXCommon_->GetPSOFactory()->UnregisterReload(&pipelineState);
+		}
+	}
+	sprites_.clear();
+	sortedIndices_.clear();
+	retiredBuffers_.clear();
+	for (FrameBuffer& frameBuffer : frameBuffers_) {
+		frameBuffer = FrameBuffer{};
+	}
+	indexBuffer_.Reset();
+	indexCapacity_ = 0;
+	for (auto& pipelineState : pipelineStates_) {
+		pipelineState.Reset();
+	}
+	rootSignature_.Reset();
+	directXCommon_ = nullptr;
+	isInitialized_ = false;
+}
+
+void SpriteBatch::CreatePipelineStates() {
+	// テクスチャとサンプラーだけ（行列と色は頂点に入っている）
+	RootSignatureBuilder rsBuilder;
+	rsBuilder.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)	// Texture (t0)
+		.AddStaticSampler(0);								// Sampler (s0)
+
+	// BlendModeの並び順で作る
+	const BlendMode blendModes[kBlendModeCount] = {
+		BlendMode::None, BlendMode::AlphaBlend, BlendMode::Add, BlendMode::Subtract, BlendMode::Multiply
+	};
+	PSODescriptor descriptors[kBlendModeCount];
+	std::vector<PSOFactory::BatchRequest> requests;
+	for (uint32_t i = 0; i < kBlendModeCount; ++i) {
+		descriptors[i] = PSODescriptor::CreateSpriteBatch().SetBlendMode(blendModes[i]);
+		requests.push_back({ &descriptors[i], &rsBuilder });
+	}
+
+	// まとめて生成（シェーダーは1度だけコンパイルされ、RootSignatureも共有される）
+	auto psoInfos = directXCommon_->GetPSOFactory()->CreatePSOBatch(requests);
+	for (uint32_t i = 0; i < kBlendModeCount; ++i) {
+		if (!psoInfos[i].IsValid()) {
+			Logger::Log(Logger::GetStream(), std::format("SpriteBatch: Failed to create PSO (blend mode {})\n", i));
+			assert(false);
+			continue;
+		}
+		pipelineStates_[i] = psoInfos[i].pipelineState;
+	}
+	rootSignature_ = psoInfos[0].rootSignature;
+
+	// シェーダーを書き換えたら作り直す（RootSignatureは全て共有している）
+	const uint64_t rootSignatureHash = rsBuilder.ComputeHash();
+	for (uint32_t i = 0; i < kBlendModeCount; ++i) {
+		if (pipelineStates_[i]) {
+			directXCommon_->GetPSOFactory()->RegisterReload(descriptors[i], rootSignature_, rootSignatureHash, &pipelineStates_[i]);
+		}
+	}
+}
+
+///*-----------------------------------------------------------------------*///
+//								スプライトの追加と描画							//
+///*-----------------------------------------------------------------------*///
+
+void SpriteBatch::AddSprite(const Matrix4x4& wvpMatrix, const Vector2& anchor, const Matrix4x4& uvTransform,
+	const Vector4& color, D3D12_GPU_DESCRIPTOR_HANDLE texture, BlendMode blendMode, int32_t layer) {
+	if (!isInitialized_ || texture.ptr == 0) {
+		return;
+	}
+
+	SpriteEntry& entry = sprites_.emplace_back();
+	entry.texture = texture;
+	entry.blendMode = blendMode;
+	entry.layer = layer;
+
+	// Spriteのメッシュと同じ並び（左下・左上・右下・右上）
+	const float left = -anchor.x;
+	const float right = 1.0f - anchor.x;
+	const float top = anchor.y - 1.0f;
+	const float bottom = anchor.y;
+	const float localPositions[kVertexCountPerSprite][2] = {
+		{ left, bottom }, { left, top }, { right, bottom }, { right, top }
+	};
+	const float localTexcoords[kVertexCountPerSprite][2] = {
+		{ 0.0f, 1.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }
+	};
+
+	const auto& m = wvpMatrix.m;
+	const auto& uv = uvTransform.m;
+	for (uint32_t i = 0; i < kVertexCountPerSprite; ++i) {
+		// (x, y, 0, 1) * WVP
+		const float x = localPositions[i][0];
+		const float y = localPositions[i][1];
+		entry.vertices[i].position = {
+			x * m[0][0] + y * m[1][0] + m[3][0],
+			x * m[0][1] + y * m[1][1] + m[3][1],
+			x * m[0][2] + y * m[1][2] + m[3][2],
+			x * m[0][3] + y * m[1][3] + m[3][3]
+		};
+
+		// (u, v, 0, 1) * uvTransform（アフィン変換なので頂点で変換しても補間結果は同じ）
+		const float u = localTexcoords[i][0];
+		const float v = localTexcoords[i][1];
+		entry.vertices[i].texcoord = {
+			u * uv[0][0] + v * uv[1][0] + uv[3][0],
+			u * uv[0][1] + v * uv[1][1] + uv[3][1]
+		};
+
+		entry.vertices[i].color = color;
+	}
+}
+
+void SpriteBatch::Flush() {
+	if (!isInitialized_ || sprites_.empty()) {
+		return;
+	}
+
+	ReleaseRetiredBuffers();
+
+	// レイヤー → ブレンドモード → テクスチャの順に並べる（同じなら積んだ順）
+	const uint32_t spriteCount = static_cast<uint32_t>(sprites_.size());
+	sortedIndices_.resize(spriteCount);
+	for (uint32_t i = 0; i < spriteCount; ++i) {
+		sortedIndices_[i] = i;
+	}
+	std::sort(sortedIndices_.begin(), sortedIndices_.end(), [this](uint32_t a, uint32_t b) {
+		const SpriteEntry& lhs = sprites_[a];
+		const SpriteEntry& rhs = sprites_[b];
+		if (lhs.layer != rhs.layer) {
+			return lhs.layer < rhs.layer;
+		}
+		if (lhs.blendMode != rhs.blendMode) {
+			return lhs.blendMode < rhs.blendMode;
+		}
+		if (lhs.texture.ptr != rhs.texture.ptr) {
+			return lhs.texture.ptr < rhs.texture.ptr;
+		}
+		return a < b;
+	});
+
+	// 並べた順に今のフレームの頂点バッファへ書き込む
+	const uint32_t baseSprite = AllocateSprites(spriteCount);
+	FrameBuffer& frameBuffer = frameBuffers_[directXCommon_->GetFrameIndex()];
+	SpriteBatchVertex* destination = frameBuffer.mappedData + static_cast<size_t>(baseSprite) * kVertexCountPerSprite;
+	for (uint32_t index : sortedIndices_) {
+		std::memcpy(destination, sprites_[index].vertices, sizeof(SpriteEntry::vertices));
+		destination += kVertexCountPerSprite;
+	}
+
+	// ステートキャッシュ経由で設定（同じ設定の再発行は省かれる）
+	GraphicsStateCache& stateCache = directXCommon_->GetStateCache();
+	stateCache.SetGraphicsRootSignature(rootSignature_.Get());
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+	vertexBufferView.BufferLocation = frameBuffer.resource->GetGPUVirtualAddress();
+	vertexBufferView.SizeInBytes = static_cast<UINT>(sizeof(SpriteBatchVertex) * kVertexCountPerSprite * frameBuffer.capacity);
+	vertexBufferView.StrideInBytes = sizeof(SpriteBatchVertex);
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView);
+	stateCache.IASetIndexBuffer(&indexBufferView_);
+
+	// テクスチャとブレンドモードが続く範囲ごとに1回で描く
+	uint32_t runStart = 0;
+	while (runStart < spriteCount) {
+		const SpriteEntry& first = sprites_[sortedIndices_[runStart]];
+		uint32_t runEnd = runStart + 1;
+		while (runEnd < spriteCount) {
+			const SpriteEntry& entry = sprites_[sortedIndices_[runEnd]];
+			if (entry.blendMode != first.blendMode || entry.texture.ptr != first.texture.ptr) {
+				break;
+			}
+			++runEnd;
+		}
+
+		stateCache.SetPipelineState(pipelineStates_[static_cast<uint32_t>(first.blendMode)].Get());
+		stateCache.SetGraphicsRootDescriptorTable(0, first.texture);
+
+		// インデックスは範囲の先頭から、頂点は今回書いた位置からの相対
+		stateCache.DrawIndexedInstanced((runEnd - runStart) * kIndexCountPerSprite, 1,
+			runStart * kIndexCountPerSprite, static_cast<INT>(baseSprite * kVertexCountPerSprite), 0);
+		++statistics_.drawCount;
+
+		runStart = runEnd;
+	}
+
+	statistics_.spriteCount += spriteCount;
+	++statistics_.flushCount;
+	sprites_.clear();
+}
+
+void SpriteBatch::EndFrame() {
+	// 描かれずに残ったものは次のフレームに持ち越さない
+	sprites_.clear();
+
+	lastFrameStatistics_ = statistics_;
+	statistics_ = {};
+}
+
+void SpriteBatch::ImGui() {
+#ifdef _DEBUG
+	if (ImGui::TreeNode("Sprite Batch")) {
+		ImGui::Checkbox("Enabled", &isEnabled_);
+		ImGui::Text("Sprites: %u / Draws: %u (flush %u)",
+			lastFrameStatistics_.spriteCount, lastFrameStatistics_.drawCount, lastFrameStatistics_.flushCount);
+		if (directXCommon_) {
+			ImGui::Text("Capacity: %u sprites", frameBuffers_[directXCommon_->GetFrameIndex()].capacity);
+		}
+		ImGui::TreePop();
+	}
+#endif
+}
+
+///*-----------------------------------------------------------------------*///
+//								バッファ管理										//
+///*-----------------------------------------------------------------------*///
+
+uint32_t SpriteBatch::AllocateSprites(uint32_t spriteCount) {
+	const uint64_t frame = directXCommon_->GetFrameCount();
+	FrameBuffer& frameBuffer = frameBuffers_[directXCommon_->GetFrameIndex()];
+
+	// この組を前に使ったフレームのGPU処理は終わっているので先頭から書き直せる
+	if (frameBuffer.frame != frame) {
+		frameBuffer.frame = frame;
+		frameBuffer.writeOffset = 0;
+	}
+
+	if (frameBuffer.writeOffset + spriteCount > frameBuffer.capacity) {
+		// このフレームで既に積んだ描画が古いバッファを参照しているので、解放はGPUが使い終わってから
+		if (frameBuffer.writeOffset > 0) {
+			retiredBuffers_.push_back({ frameBuffer.resource, frame });
+		}
+
+		// 2倍ずつ広げる
+		uint32_t newCapacity = (std::max)(frameBuffer.capacity, kInitialSpriteCapacity);
+		while (newCapacity < frameBuffer.writeOffset + spriteCount) {
+			newCapacity *= 2;
+		}
+		CreateFrameBuffer(frameBuffer, newCapacity);
+		frameBuffer.frame = frame;
+		Logger::Log(Logger::GetStream(), std::format("SpriteBatch: Grew vertex buffer to {} sprites\n", newCapacity));
+	}
+
+	// インデックスは1回の描画で使う数だけあればよい
+	if (spriteCount > indexCapacity_) {
+		retiredBuffers_.push_back({ indexBuffer_, frame });
+		uint32_t newCapacity = (std::max)(indexCapacity_, kInitialSpriteCapacity);
+		while (newCapacity < spriteCount) {
+			newCapacity *= 2;
+		}
+		CreateIndexBuffer(newCapacity);
+	}
+
+	const uint32_t offset = frameBuffer.writeOffset;
+	frameBuffer.writeOffset += spriteCount;
+	return offset;
+}
+
+void SpriteBatch::CreateFrameBuffer(FrameBuffer& frameBuffer, uint32_t spriteCapacity) {
+	frameBuffer.resource = CreateBufferResource(directXCommon_->GetDevice(),
+		sizeof(SpriteBatchVertex) * kVertexCountPerSprite * spriteCapacity);
+	frameBuffer.resource->Map(0, nullptr, reinterpret_cast<void**>(&frameBuffer.mappedData));
+	frameBuffer.capacity = spriteCapacity;
+	frameBuffer.writeOffset = 0;
+}
+
+void SpriteBatch::CreateIndexBuffer(uint32_t spriteCapacity) {
+	// 四角形ごとに { 0, 1, 2, 1, 3, 2 } を頂点位置をずらして並べる（Spriteと同じ巻き順）
+	const size_t indexCount = static_cast<size_t>(spriteCapacity) * kIndexCountPerSprite;
+	indexBuffer_ = CreateBufferResource(directXCommon_->GetDevice(), sizeof(uint32_t) * indexCount);
+	uint32_t* indexData = nullptr;
+	indexBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&indexData));
+	for (uint32_t i = 0; i < spriteCapacity; ++i) {
+		const uint32_t vertex = i * kVertexCountPerSprite;
+		uint32_t* destination = indexData + static_cast<size_t>(i) * kIndexCountPerSprite;
+		destination[0] = vertex + 0;
+		destination[1] = vertex + 1;
+		destination[2] = vertex + 2;
+		destination[3] = vertex + 1;
+		destination[4] = vertex + 3;
+		destination[5] = vertex + 2;
+	}
+	indexBuffer_->Unmap(0, nullptr);
+
+	indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+	indexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(uint32_t) * indexCount);
+	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+	indexCapacity_ = spriteCapacity;
+}
+
+void SpriteBatch::ReleaseRetiredBuffers() {
+	// DirectXCommon::kFrameCountフレーム前のものはGPUが使い終わっている
+	const uint64_t frame = directXCommon_->GetFrameCount();
+	std::erase_if(retiredBuffers_, [frame](const RetiredBuffer& retired) {
+		return retired.frame + DirectXCommon::kFrameCount <= frame;
+	});
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "BaseSystem/DirectXCommon/DirectXCommon.h"
+#include "MyMath/MyFunction.h"
+
+/// <summary>
+/// 一括描画用の頂点データ構造体（座標はクリップ空間、UVは変換済み）
+/// </summary>
+struct SpriteBatchVertex {
+	Vector4 position;	// クリップ空間の座標（WVP変換済み）
+	Vector2 texcoord;	// UV変換済みのテクスチャ座標
+	Vector4 color;		// 色
+};
+static_assert(sizeof(SpriteBatchVertex) == 40, "SpriteBatchVertex must match the SpriteBatch input layout");
+
+/// <summary>
+/// スプライトの一括描画
+/// フレーム中にSprite::Drawで積まれたスプライトを、レイヤー・ブレンドモード・テクスチャの順に並べ替え、
+/// 頂点を1つの動的頂点バッファに書き込んで、同じテクスチャとブレンドモードが続く範囲ごとに1回の描画命令で描く
+/// 頂点バッファはフレームごとに別のもの（DirectXCommon::kFrameCount組）を使い、インデックスバッファは全フレームで共有する
+/// 同じレイヤー内では描画順がテクスチャ順に入れ替わるので、重なり順が必要なものはレイヤーを分ける
+/// </summary>
+class SpriteBatch {
+public:
+	// 1つのスプライトの頂点数・インデックス数
+	static const uint32_t kVertexCountPerSprite = 4;
+	static const uint32_t kIndexCountPerSprite = 6;
+	// 頂点バッファの最初の容量（スプライト数）
+	static const uint32_t kInitialSpriteCapacity = 1024;
+	// トランジションなど最前面に描くもののレイヤー
+	static const int32_t kTopLayer = INT32_MAX;
+
+	/// <summary>
+	/// 前フレームの統計
+	/// </summary>
+	struct Statistics {
+		uint32_t spriteCount = 0;	// 積まれたスプライト数
+		uint32_t drawCount = 0;		// 発行した描画命令数
+		uint32_t flushCount = 0;	// Flushで実際に描いた回数
+	};
+
+	//シングルトン
+	static SpriteBatch* GetInstance();
+
+	/// <summary>
+	/// 初期化（PSOとバッファの作成）
+	/// </summary>
+	/// <param name="dxCommon">DirectXCommonのポインタ</param>
+	void Initialize(DirectXCommon* dxCommon);
+
+	/// <summary>
+	/// 終了処理（GPUリソースを解放）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// スプライトを積む
+	/// </summary>
+	/// <param name="wvpMatrix">スプライトのWVP行列</param>
+	/// <param name="anchor">アンカーポイント（0.0-1.0）</param>
+	/// <param name="uvTransform">UV変換行列</param>
+	/// <param name="color">色</param>
+	/// <param name="texture">テクスチャのGPUハンドル</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">レイヤー（小さいほど先に描く）</param>
+	void AddSprite(const Matrix4x4& wvpMatrix, const Vector2& anchor, const Matrix4x4& uvTransform,
+		const Vector4& color, D3D12_GPU_DESCRIPTOR_HANDLE texture, BlendMode blendMode, int32_t layer);
+
+	/// <summary>
+	/// 積んだスプライトを並べ替えて描画し、空にする（EngineがUI描画の最後に呼ぶ）
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// フレームの終了（統計を確定する）
+	/// </summary>
+	void EndFrame();
+
+	/// <summary>
+	/// ImGui表示
+	/// </summary>
+	void ImGui();
+
+	// 有効/無効（無効の間はSprite::Drawが1枚ずつ描く）
+	void SetEnabled(bool enabled) { isEnabled_ = enabled; }
+	bool IsEnabled() const { return isEnabled_ && isInitialized_; }
+
+	// Getter
+	const Statistics& GetLastFrameStatistics() const { return lastFrameStatistics_; }
+	uint32_t GetPendingSpriteCount() const { return static_cast<uint32_t>(sprites_.size()); }
+
+private:
+	SpriteBatch() = default;
+	~SpriteBatch() = default;
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	// ブレンドモードの数（BlendMode::None～Multiply）
+	static const uint32_t kBlendModeCount = 5;
+
+	/// <summary>
+	/// 積まれたスプライト（頂点は積んだ時点で変換済み）
+	/// </summary>
+	struct SpriteEntry {
+		SpriteBatchVertex vertices[kVertexCountPerSprite];
+		D3D12_GPU_DESCRIPTOR_HANDLE texture{};
+		BlendMode blendMode = BlendMode::AlphaBlend;
+		int32_t layer = 0;
+	};
+
+	/// <summary>
+	/// フレームごとの頂点バッファ
+	/// </summary>
+	struct FrameBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		SpriteBatchVertex* mappedData = nullptr;
+		uint32_t capacity = 0;			// スプライト数
+		uint32_t writeOffset = 0;		// 今のフレームで次に書く位置（スプライト）
+		uint64_t frame = UINT64_MAX;	// 最後に使ったフレーム
+	};
+
+	/// <summary>
+	/// ブレンドモードごとのPSOを作成
+	/// </summary>
+	void CreatePipelineStates();
+
+	/// <summary>
+	/// 今のフレームの頂点バッファから領域を確保（足りなければ作り直す）
+	/// </summary>
+	/// <returns>確保した先頭のスプライト位置</returns>
+	uint32_t AllocateSprites(uint32_t spriteCount);
+
+	/// <summary>
+	/// 頂点バッファを作成
+	/// </summary>
+	void CreateFrameBuffer(FrameBuffer& frameBuffer, uint32_t spriteCapacity);
+
+	/// <summary>
+	/// インデックスバッファを作成（全スプライト分の四角形を並べたもの）
+	/// </summary>
+	void CreateIndexBuffer(uint32_t spriteCapacity);
+
+	/// <summary>
+	/// 作り直した古いバッファのうち、GPUが使い終わったものを解放
+	/// </summary>
+	void ReleaseRetiredBuffers();
+
+private:
+	// DirectXCommon参照
+	DirectXCommon* directXCommon_ = nullptr;
+
+	bool isEnabled_ = true;
+	bool isInitialized_ = false;
+
+	// ブレンドモードごとのPSO（RootSignatureは共有）
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineStates_[kBlendModeCount];
+
+	// 今のフレームで積まれたスプライトと、並べ替え用の番号
+	std::vector<SpriteEntry> sprites_;
+	std::vector<uint32_t> sortedIndices_;
+
+	// フレームごとの頂点バッファ
+	FrameBuffer frameBuffers_[DirectXCommon::kFrameCount];
+
+	// 共有のインデックスバッファ
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
+	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+	uint32_t indexCapacity_ = 0;	// スプライト数
+
+	// 作り直した古いバッファ（このフレームの描画が終わるまで残す）
+	struct RetiredBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t frame = 0;
+	};
+	std::vector<RetiredBuffer> retiredBuffers_;
+
+	// 統計
+	Statistics statistics_;
+	Statistics lastFrameStatistics_;
+};
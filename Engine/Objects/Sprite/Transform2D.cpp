@@ -25,11 +25,15 @@ void Transform2D::UpdateMatrix(const Matrix4x4& viewProjectionMatrix)
 	Matrix4x4 translateMatrix = MakeTranslateMatrix({ transform_.translate.x, transform_.translate.y, 0.0f });
 
 	// ワールド行列を計算（S * R * T の順番）
-	transformData_->World = Matrix4x4Multiply(scaleMatrix, rotateMatrix);
-	transformData_->World = Matrix4x4Multiply(transformData_->World, translateMatrix);
+	worldMatrix_ = Matrix4x4Multiply(scaleMatrix, rotateMatrix);
+	worldMatrix_ = Matrix4x4Multiply(worldMatrix_, translateMatrix);
 
 	// ビュープロジェクション行列を掛け算してWVP行列を計算
-	transformData_->WVP = Matrix4x4Multiply(transformData_->World, viewProjectionMatrix);
+	wvpMatrix_ = Matrix4x4Multiply(worldMatrix_, viewProjectionMatrix);
+
+	// GPU側へ書き込む
+	transformData_->World = worldMatrix_;
+	transformData_->WVP = wvpMatrix_;
 }
 
 void Transform2D::SetDefaultTransform()
@@ -40,8 +44,10 @@ void Transform2D::SetDefaultTransform()
 	transform_.translate = { 0.0f, 0.0f };
 
 	// GPU側のデータも単位行列で初期化
-	transformData_->World = MakeIdentity4x4();
-	transformData_->WVP = MakeIdentity4x4();
+	worldMatrix_ = MakeIdentity4x4();
+	wvpMatrix_ = MakeIdentity4x4();
+	transformData_->World = worldMatrix_;
+	transformData_->WVP = wvpMatrix_;
 }
 
 void Transform2D::AddPosition(const Vector2& position)
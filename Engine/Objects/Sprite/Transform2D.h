@@ -53,8 +53,9 @@ public:
 	Vector2 GetScale() const { return transform_.scale; }
 	float GetDepth() const { return 0.0f; }  // 互換性のため常に0を返す
 
-	Matrix4x4 GetWorldMatrix() const { return transformData_->World; }
-	Matrix4x4 GetWVPMatrix() const { return transformData_->WVP; }
+	// CPU側の写しを返す（書き込み専用のアップロードメモリからは読まない）
+	const Matrix4x4& GetWorldMatrix() const { return worldMatrix_; }
+	const Matrix4x4& GetWVPMatrix() const { return wvpMatrix_; }
 	ID3D12Resource* GetResource() const { return transformResource_.Get(); }
 
 	/// トランスフォームデータの直接取得（ImGui用）
@@ -88,6 +89,9 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> transformResource_;
 	// トランスフォームデータへのポインタ
 	TransformationMatrix* transformData_ = nullptr;
+	// 最後に計算した行列のCPU側の写し（SpriteBatchが頂点変換に使う）
+	Matrix4x4 worldMatrix_ = MakeIdentity4x4();
+	Matrix4x4 wvpMatrix_ = MakeIdentity4x4();
 
 	// CPU側のトランスフォーム値（2D用）
 	Vector2Transform transform_{
@@ -13,7 +13,6 @@ void OffscreenRenderer::Initialize(DirectXCommon* dxCommon, uint32_t width, uint
 	CreateDSV();
 	CreateSRV();
 	CreateDepthSRV();  // 深度用SRV作成を追加
-	CreatePSO();
 
 	// ビューポート設定
 	viewport_.Width = static_cast<float>(width_);
@@ -57,6 +56,9 @@ void OffscreenRenderer::Initialize(DirectXCommon* dxCommon, uint32_t width, uint
 	// ダメージエフェクトを追加
 	damageEffect_ = postProcessChain_->AddEffect<VignettePostEffect>();
 
+	// オフスクリーン描画用とエフェクト用のPSOをまとめて作る
+	CreatePSO();
+
 
 
 	// 初期化完了のログを出す
@@ -64,6 +66,9 @@ void OffscreenRenderer::Initialize(DirectXCommon* dxCommon, uint32_t width, uint
 }
 
 void OffscreenRenderer::Finalize() {
+	// シェーダーを書き換えた時に作り直すPSOから外す
+	dxCommon_->GetPSOFactory()->UnregisterReload(&offscreenPipelineState_);
+
 	// ポストプロセスチェーンの終了処理
 	if (postProcessChain_) {
 		postProcessChain_->Finalize();
@@ -167,9 +172,10 @@ void OffscreenRenderer::PreDraw() {
 	commandList->SetDescriptorHeaps(1, descriptorHeaps->GetAddressOf());
 
 	// 通常の描画設定を適用（既存のPSOを使用）
-	commandList->SetGraphicsRootSignature(dxCommon_->GetRootSignature());
-	commandList->SetPipelineState(dxCommon_->GetPipelineState());
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	GraphicsStateCache& stateCache = dxCommon_->GetStateCache();
+	stateCache.SetGraphicsRootSignature(dxCommon_->GetRootSignature());
+	stateCache.SetPipelineState(dxCommon_->GetPipelineState());
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
 void OffscreenRenderer::PostDraw() {
@@ -251,9 +257,10 @@ void OffscreenRenderer::DrawOffscreenTexture() {
 	);
 
 	// オフスクリーン用PSOから通常描画用PSOに戻す
-	commandList->SetGraphicsRootSignature(dxCommon_->GetRootSignature());
-	commandList->SetPipelineState(dxCommon_->GetPipelineState());
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	GraphicsStateCache& stateCache = dxCommon_->GetStateCache();
+	stateCache.SetGraphicsRootSignature(dxCommon_->GetRootSignature());
+	stateCache.SetPipelineState(dxCommon_->GetPipelineState());
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
 void OffscreenRenderer::InitializeOffscreenTriangle() {
@@ -454,15 +461,19 @@ void OffscreenRenderer::CreatePSO() {
 		.SetPixelShader(L"resources/Shader/FullscreenTriangle/FullscreenTriangle.PS.hlsl")
 		.SetBlendMode(BlendMode::AlphaBlend);// アルファブレンドを有効化
 
-	// PSOFactory経由で生成
-	auto psoInfo = dxCommon_->GetPSOFactory()->CreatePSO(psoDesc, rsBuilder);
-	if (!psoInfo.IsValid()) {
+	// ポストプロセスチェーンのエフェクトのPSOと一緒に、1回のCreatePSOBatchで生成
+	std::vector<PSOFactory::PSOInfo> psoInfos;
+	postProcessChain_->CreatePipelineStates({ { &psoDesc, &rsBuilder } }, &psoInfos);
+	if (!psoInfos[0].IsValid()) {
 		Logger::Log(Logger::GetStream(), "OffscreenRenderer: Failed to create PSO\n");
 		assert(false);
 	}
 
-	offscreenRootSignature_ = psoInfo.rootSignature;
-	offscreenPipelineState_ = psoInfo.pipelineState;
+	offscreenRootSignature_ = psoInfos[0].rootSignature;
+	offscreenPipelineState_ = psoInfos[0].pipelineState;
+
+	// シェーダーを書き換えたら作り直す
+	dxCommon_->GetPSOFactory()->RegisterReload(psoDesc, offscreenRootSignature_, rsBuilder.ComputeHash(), &offscreenPipelineState_);
 
 	Logger::Log(Logger::GetStream(), "Complete create offscreen PipelineState (PSOFactory version)!!\n");
 }
@@ -30,29 +30,30 @@ void OffscreenTriangle::DrawWithCustomPSO(
 		return;
 	}
 
-	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+	// ステートキャッシュ経由で設定（同じエフェクトを連続で適用する場合PSOの再設定は省かれる）
+	GraphicsStateCache& stateCache = dxCommon_->GetStateCache();
 
 	// 外部で指定されたPSOを設定
-	commandList->SetGraphicsRootSignature(rootSignature);
-	commandList->SetPipelineState(pipelineState);
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache.SetGraphicsRootSignature(rootSignature);
+	stateCache.SetPipelineState(pipelineState);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// パラメータ設定（ルートパラメータの順序に注意）
 	int parameterIndex = 0;
 
 	// マテリアルバッファが指定されていれば設定
 	if (materialBufferGPUAddress != 0) {
-		commandList->SetGraphicsRootConstantBufferView(parameterIndex++, materialBufferGPUAddress);
+		stateCache.SetGraphicsRootConstantBufferView(parameterIndex++, materialBufferGPUAddress);
 	}
 
 	// テクスチャを設定
-	commandList->SetGraphicsRootDescriptorTable(parameterIndex, textureHandle);
+	stateCache.SetGraphicsRootDescriptorTable(parameterIndex, textureHandle);
 
 	// 頂点バッファをバインド
-	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView_);
 
 	// 大きな三角形を描画（3頂点）
-	commandList->DrawInstanced(3, 1, 0, 0);
+	stateCache.DrawInstanced(3, 1, 0, 0);
 }
 
 void OffscreenTriangle::DrawWithCustomPSOAndDepth(
@@ -66,29 +67,30 @@ void OffscreenTriangle::DrawWithCustomPSOAndDepth(
 		return;
 	}
 
-	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+	// ステートキャッシュ経由で設定（同じエフェクトを連続で適用する場合PSOの再設定は省かれる）
+	GraphicsStateCache& stateCache = dxCommon_->GetStateCache();
 
 	// 外部で指定されたPSOを設定
-	commandList->SetGraphicsRootSignature(rootSignature);
-	commandList->SetPipelineState(pipelineState);
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache.SetGraphicsRootSignature(rootSignature);
+	stateCache.SetPipelineState(pipelineState);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 	// マテリアルバッファが指定されていれば設定
 	if (materialBufferGPUAddress != 0) {
-		commandList->SetGraphicsRootConstantBufferView(0, materialBufferGPUAddress);
+		stateCache.SetGraphicsRootConstantBufferView(0, materialBufferGPUAddress);
 	}
 
 	// カラーテクスチャを設定（RootParameter 1番目）
-	commandList->SetGraphicsRootDescriptorTable(1, colorTextureHandle);
+	stateCache.SetGraphicsRootDescriptorTable(1, colorTextureHandle);
 
 	// 深度テクスチャを設定（RootParameter 2番目）
-	commandList->SetGraphicsRootDescriptorTable(2, depthTextureHandle);
+	stateCache.SetGraphicsRootDescriptorTable(2, depthTextureHandle);
 
 	// 頂点バッファをバインド
-	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView_);
 
 	// 大きな三角形を描画（3頂点）
-	commandList->DrawInstanced(3, 1, 0, 0);
+	stateCache.DrawInstanced(3, 1, 0, 0);
 }
 
 void OffscreenTriangle::Draw(D3D12_GPU_DESCRIPTOR_HANDLE textureHandle) {
@@ -96,19 +98,19 @@ void OffscreenTriangle::Draw(D3D12_GPU_DESCRIPTOR_HANDLE textureHandle) {
 		return;
 	}
 
-	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+	GraphicsStateCache& stateCache = dxCommon_->GetStateCache();
 
 	// デフォルトのオフスクリーンPSOを使用
 	// TODO：この部分は後でOffscreenRendererから適切なPSOを取得するように修正予定
 
 	// 頂点バッファをバインド
-	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+	stateCache.IASetVertexBuffers(0, 1, &vertexBufferView_);
 
 	// テクスチャを設定
-	commandList->SetGraphicsRootDescriptorTable(2, textureHandle);
+	stateCache.SetGraphicsRootDescriptorTable(2, textureHandle);
 
 	// 大きな三角形を描画（3頂点）
-	commandList->DrawInstanced(3, 1, 0, 0);
+	stateCache.DrawInstanced(3, 1, 0, 0);
 }
 
 void OffscreenTriangle::CreateFullscreenTriangle() {
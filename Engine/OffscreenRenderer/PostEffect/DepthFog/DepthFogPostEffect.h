@@ -53,6 +53,7 @@ public:
 	void SetEnabled(bool enabled) override { isEnabled_ = enabled; }
 	void ImGui() override;
 	const std::string& GetName() const override { return name_; }
+	void BuildPipelineRequest(PipelineRequest& request) const override;
 	// 深度が必要なのでtrueでオーバーライド
 	bool RequiresDepthTexture() const override { return true; }
 
@@ -67,7 +68,6 @@ public:
 	Vector4 GetFogColor() const { return parameters_.fogColor; }
 
 private:
-	void CreatePSO();
 	void CreateParameterBuffer();
 	Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile);
 	void UpdateParameterBuffer();
@@ -80,8 +80,6 @@ private:
 	DepthFogParameters parameters_;
 
 	// 深度フォグエフェクト用PSO
-	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
 	Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob_;
 	Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob_;
 
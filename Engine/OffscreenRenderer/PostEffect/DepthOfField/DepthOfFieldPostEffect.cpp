@@ -4,9 +4,6 @@
 void DepthOfFieldPostEffect::Initialize(DirectXCommon* dxCommon) {
 	dxCommon_ = dxCommon;
 
-	// PSOを作成
-	CreatePSO();
-
 	// パラメータバッファを作成
 	CreateParameterBuffer();
 
@@ -16,6 +13,9 @@ void DepthOfFieldPostEffect::Initialize(DirectXCommon* dxCommon) {
 }
 
 void DepthOfFieldPostEffect::Finalize() {
+	// シェーダーを書き換えた時に作り直すPSOから外す
+	dxCommon_->GetPSOFactory()->UnregisterReload(&pipelineState_);
+
 	// パラメータデータのマッピング解除
 	if (mappedParameters_) {
 		parameterBuffer_->Unmap(0, nullptr);
@@ -72,29 +72,16 @@ void DepthOfFieldPostEffect::Apply(D3D12_GPU_DESCRIPTOR_HANDLE inputSRV, D3D12_G
 		parameterBuffer_->GetGPUVirtualAddress()	// パラメータバッファをマテリアルとして使用
 	);
 }
-void DepthOfFieldPostEffect::CreatePSO() {
+void DepthOfFieldPostEffect::BuildPipelineRequest(PipelineRequest& request) const {
 	// RootSignatureを構築
-	RootSignatureBuilder rsBuilder;
-	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// DepthOfFieldParameters (b0)
+	request.rootSignatureBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// DepthOfFieldParameters (b0)
 		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// ColorTexture (t0)
 		.AddSRV(1, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// DepthTexture (t1)
 		.AddStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
 
 	// PSO設定を構築
-	auto psoDesc = PSODescriptor::CreatePostEffectWithDepth()
+	request.descriptor = PSODescriptor::CreatePostEffectWithDepth()
 		.SetPixelShader(L"resources/Shader/DepthOfField/DepthOfField.PS.hlsl");
-
-	// PSOFactory経由で生成
-	auto psoInfo = dxCommon_->GetPSOFactory()->CreatePSO(psoDesc, rsBuilder);
-	if (!psoInfo.IsValid()) {
-		Logger::Log(Logger::GetStream(), "DepthOfFieldPostEffect: Failed to create PSO\n");
-		assert(false);
-	}
-
-	rootSignature_ = psoInfo.rootSignature;
-	pipelineState_ = psoInfo.pipelineState;
-
-	Logger::Log(Logger::GetStream(), "Complete create DepthOfField PSO (PSOFactory version)!!\n");
 }
 
 
@@ -56,6 +56,7 @@ public:
 	void SetEnabled(bool enabled) override { isEnabled_ = enabled; }
 	void ImGui() override;
 	const std::string& GetName() const override { return name_; }
+	void BuildPipelineRequest(PipelineRequest& request) const override;
 	// 深度が必要なのでtrueでオーバーライド
 	bool RequiresDepthTexture() const override { return true; }
 
@@ -70,7 +71,6 @@ public:
 	float GetBlurStrength() const { return parameters_.blurStrength; }
 
 private:
-	void CreatePSO();
 	void CreateParameterBuffer();
 	Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile);
 	void UpdateParameterBuffer();
@@ -83,8 +83,6 @@ private:
 	DepthOfFieldParameters parameters_;
 
 	// 被写界深度エフェクト用PSO
-	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
 	Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob_;
 	Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob_;
 
@@ -45,6 +45,7 @@ public:
 	void SetEnabled(bool enabled) override { isEnabled_ = enabled; }
 	void ImGui() override;
 	const std::string& GetName() const override { return name_; }
+	void BuildPipelineRequest(PipelineRequest& request) const override;
 
 	// 固有メソッド
 	void ApplyPreset(EffectPreset preset);
@@ -52,7 +53,6 @@ public:
 	float GetGrayIntensity() const { return parameters_.grayIntensity; }
 
 private:
-	void CreatePSO();
 	void CreateParameterBuffer();
 	Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile);
 	void UpdateParameterBuffer();
@@ -65,8 +65,6 @@ private:
 	GrayscaleParameters parameters_;
 
 	// グレースケールエフェクト用PSO
-	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
 	Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob_;
 	Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob_;
 
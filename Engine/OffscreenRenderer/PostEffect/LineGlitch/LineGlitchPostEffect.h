@@ -41,6 +41,7 @@ public:
 	void SetEnabled(bool enabled) override { isEnabled_ = enabled; }
 	void ImGui() override;
 	const std::string& GetName() const override { return name_; }
+	void BuildPipelineRequest(PipelineRequest& request) const override;
 
 	// 固有メソッド
 	void ApplyPreset(EffectPreset preset);
@@ -48,7 +49,6 @@ public:
 	void SetNoiseInterval(float interval);
 
 private:
-	void CreatePSO();
 	void CreateParameterBuffer();
 	Microsoft::WRL::ComPtr<IDxcBlob> CompileShader(const std::wstring& filePath, const wchar_t* profile);
 	void UpdateParameterBuffer();
@@ -61,8 +61,6 @@ private:
 	LineGlitchParameters parameters_;
 
 	// グリッチエフェクト用PSO
-	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
 	Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob_;
 	Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob_;
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <d3d12.h>
 #include <wrl.h>
+#include <cassert>
 #include <string>
 #include "BaseSystem/DirectXCommon/DirectXCommon.h"
 #include "OffscreenRenderer/OffscreenTriangle/OffscreenTriangle.h"
@@ -11,6 +12,15 @@
 /// OffscreenTriangle使用版
 /// </summary>
 class PostEffect {
+public:
+	/// <summary>
+	/// PSOの設定（PostProcessChainが全てのエフェクトから集め、PSOFactory::CreatePSOBatchでまとめて作る）
+	/// </summary>
+	struct PipelineRequest {
+		PSODescriptor descriptor;
+		RootSignatureBuilder rootSignatureBuilder;
+	};
+
 public:
 	virtual ~PostEffect() = default;
 
@@ -82,8 +92,42 @@ public:
 	/// </summary>
 	virtual const std::string& GetName() const = 0;
 
+	/// <summary>
+	/// PSOの設定を作る（Initializeの後にPostProcessChainから呼ばれる）
+	/// </summary>
+	/// <param name="request">設定の書き込み先</param>
+	virtual void BuildPipelineRequest(PipelineRequest& request) const = 0;
+
+	/// <summary>
+	/// まとめて作ったPSOを受け取り、シェーダーを書き換えた時に作り直すように登録する
+	/// </summary>
+	/// <param name="request">BuildPipelineRequestで作った設定</param>
+	/// <param name="psoInfo">作ったPSO</param>
+	void SetPipeline(const PipelineRequest& request, const PSOFactory::PSOInfo& psoInfo) {
+		if (!psoInfo.IsValid()) {
+			Logger::Log(Logger::GetStream(), std::format("{}: Failed to create PSO\n", GetName()));
+			assert(false);
+			return;
+		}
+
+		rootSignature_ = psoInfo.rootSignature;
+		pipelineState_ = psoInfo.pipelineState;
+
+		// シェーダーを書き換えたら作り直す
+		dxCommon_->GetPSOFactory()->RegisterReload(request.descriptor, rootSignature_, request.rootSignatureBuilder.ComputeHash(), &pipelineState_);
+	}
+
+	/// <summary>
+	/// PSOを受け取り済みかどうか
+	/// </summary>
+	bool HasPipeline() const { return pipelineState_ != nullptr; }
+
 protected:
 	DirectXCommon* dxCommon_ = nullptr;
 	bool isEnabled_ = false;
 	std::string name_ = "Unknown Effect";
+
+	// エフェクト用PSO（PostProcessChainがまとめて作って渡す）
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
 };
\ No newline at end of file
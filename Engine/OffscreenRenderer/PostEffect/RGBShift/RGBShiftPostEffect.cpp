@@ -4,9 +4,6 @@
 void RGBShiftPostEffect::Initialize(DirectXCommon* dxCommon) {
 	dxCommon_ = dxCommon;
 
-	// PSOを作成
-	CreatePSO();
-
 	// パラメータバッファを作成
 	CreateParameterBuffer();
 
@@ -16,6 +13,9 @@ void RGBShiftPostEffect::Initialize(DirectXCommon* dxCommon) {
 }
 
 void RGBShiftPostEffect::Finalize() {
+	// シェーダーを書き換えた時に作り直すPSOから外す
+	dxCommon_->GetPSOFactory()->UnregisterReload(&pipelineState_);
+
 	// パラメータデータのマッピング解除
 	if (mappedParameters_) {
 		parameterBuffer_->Unmap(0, nullptr);
@@ -67,28 +67,15 @@ void RGBShiftPostEffect::Apply(D3D12_GPU_DESCRIPTOR_HANDLE inputSRV, D3D12_CPU_D
 	);
 }
 
-void RGBShiftPostEffect::CreatePSO() {
+void RGBShiftPostEffect::BuildPipelineRequest(PipelineRequest& request) const {
 	// RootSignatureを構築
-	RootSignatureBuilder rsBuilder;
-	rsBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// RGBShiftParameters (b0)
+	request.rootSignatureBuilder.AddCBV(0, D3D12_SHADER_VISIBILITY_PIXEL)		// RGBShiftParameters (b0)
 		.AddSRV(0, 1, D3D12_SHADER_VISIBILITY_PIXEL)		// Texture (t0)
 		.AddStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
 
 	// PSO設定を構築
-	auto psoDesc = PSODescriptor::CreatePostEffectColorOnly()
+	request.descriptor = PSODescriptor::CreatePostEffectColorOnly()
 		.SetPixelShader(L"resources/Shader/RGBShift/RGBShift.PS.hlsl");
-
-	// PSOFactory経由で生成
-	auto psoInfo = dxCommon_->GetPSOFactory()->CreatePSO(psoDesc, rsBuilder);
-	if (!psoInfo.IsValid()) {
-		Logger::Log(Logger::GetStream(), "RGBShiftPostEffect: Failed to create PSO\n");
-		assert(false);
-	}
-
-	rootSignature_ = psoInfo.rootSignature;
-	pipelineState_ = psoInfo.pipelineState;
-
-	Logger::Log(Logger::GetStream(), "Complete create RGB Shift PSO (PSOFactory version)!!\n");
 }
 
 void RGBShiftPostEffect::CreateParameterBuffer() {
@@ -39,7 +39,7 @@ void PostProcessChain::Finalize() {
 	if (descriptorManager) {
 		for (int i = 0; i < 2; ++i) {
 			if (intermediateSRVHandles_[i].isValid) {
-				descriptorManager->ReleaseSRV(intermediateSRVHandles_[i].index);
+				descriptorManager->ReleaseStagingSRV(intermediateSRVHandles_[i].index);
 			}
 			if (intermediateRTVHandles_[i].isValid) {
 				descriptorManager->ReleaseRTV(intermediateRTVHandles_[i].index);
@@ -66,6 +66,40 @@ void PostProcessChain::Update(float deltaTime) {
 	// OffscreenTriangleの更新は特に不要（状態を持たないため）
 }
 
+void PostProcessChain::CreatePipelineStates(const std::vector<PSOFactory::BatchRequest>& extraRequests,
+	std::vector<PSOFactory::PSOInfo>* extraResults) {
+	// PSOを持っていないエフェクトの設定を集める（設定は生成が終わるまでここで持つ）
+	std::vector<PostEffect*> pendingEffects;
+	for (const auto& effect : effects_) {
+		if (effect && !effect->HasPipeline()) {
+			pendingEffects.push_back(effect.get());
+		}
+	}
+	std::vector<PostEffect::PipelineRequest> effectRequests(pendingEffects.size());
+	std::vector<PSOFactory::BatchRequest> requests = extraRequests;
+	for (size_t i = 0; i < pendingEffects.size(); ++i) {
+		pendingEffects[i]->BuildPipelineRequest(effectRequests[i]);
+		requests.push_back({ &effectRequests[i].descriptor, &effectRequests[i].rootSignatureBuilder });
+	}
+
+	// まとめて生成（同じシェーダーは1度だけコンパイルされ、同じ設定のRootSignatureは共有される）
+	std::vector<PSOFactory::PSOInfo> psoInfos;
+	if (!requests.empty()) {
+		psoInfos = dxCommon_->GetPSOFactory()->CreatePSOBatch(requests);
+	}
+
+	// 呼び出し側の分を返し、残りを各エフェクトに渡す
+	if (extraResults) {
+		extraResults->assign(psoInfos.begin(), psoInfos.begin() + extraRequests.size());
+	}
+	for (size_t i = 0; i < pendingEffects.size(); ++i) {
+		pendingEffects[i]->SetPipeline(effectRequests[i], psoInfos[extraRequests.size() + i]);
+	}
+	isPipelineCreated_ = true;
+
+	Logger::Log(Logger::GetStream(), std::format("PostProcessChain: Created {} effect PSOs in one batch\n", pendingEffects.size()));
+}
+
 D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::ApplyEffects(D3D12_GPU_DESCRIPTOR_HANDLE inputSRV) {
 	if (!isInitialized_ || effects_.empty() || !offscreenTriangle_) {
 		return inputSRV;
@@ -85,6 +119,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::ApplyEffects(D3D12_GPU_DESCRIPTOR_
 	}
 
 	auto commandList = dxCommon_->GetCommandList();
+	auto descriptorManager = dxCommon_->GetDescriptorManager();
 	D3D12_GPU_DESCRIPTOR_HANDLE currentInput = inputSRV;
 	int bufferIndex = 0;
 
@@ -121,8 +156,13 @@ D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::ApplyEffects(D3D12_GPU_DESCRIPTOR_
 		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 		commandList->ResourceBarrier(1, &barrier);
 
-		// 次の入力として今回の出力を設定
-		currentInput = intermediateSRVHandles_[bufferIndex].gpuHandle;
+		// 次の入力として今回の出力を設定（このフレームだけ使うSRVとしてリングにコピー）
+		auto transientSRV = descriptorManager->CopyToTransientSRV(&intermediateSRVHandles_[bufferIndex].cpuHandle, 1);
+		if (!transientSRV.isValid) {
+			// リングが足りなければ残りのエフェクトは飛ばす
+			break;
+		}
+		currentInput = transientSRV.gpuHandle;
 		bufferIndex = (bufferIndex + 1) % 2;
 	}
 
@@ -148,6 +188,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::ApplyEffectsWithDepth(D3D12_GPU_DE
 	}
 
 	auto commandList = dxCommon_->GetCommandList();
+	auto descriptorManager = dxCommon_->GetDescriptorManager();
 	D3D12_GPU_DESCRIPTOR_HANDLE currentInput = inputSRV;
 	int bufferIndex = 0;
 
@@ -184,8 +225,13 @@ D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::ApplyEffectsWithDepth(D3D12_GPU_DE
 		barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 		commandList->ResourceBarrier(1, &barrier);
 
-		// 次の入力として今回の出力を設定
-		currentInput = intermediateSRVHandles_[bufferIndex].gpuHandle;
+		// 次の入力として今回の出力を設定（このフレームだけ使うSRVとしてリングにコピー）
+		auto transientSRV = descriptorManager->CopyToTransientSRV(&intermediateSRVHandles_[bufferIndex].cpuHandle, 1);
+		if (!transientSRV.isValid) {
+			// リングが足りなければ残りのエフェクトは飛ばす
+			break;
+		}
+		currentInput = transientSRV.gpuHandle;
 		bufferIndex = (bufferIndex + 1) % 2;
 	}
 
@@ -244,8 +290,8 @@ void PostProcessChain::CreateIntermediateSRVs() {
 	auto descriptorManager = dxCommon_->GetDescriptorManager();
 
 	for (int i = 0; i < 2; ++i) {
-		// SRVを割り当て
-		intermediateSRVHandles_[i] = descriptorManager->AllocateSRV();
+		// SRVを割り当て（ステージング用。使う時にリングへコピーする）
+		intermediateSRVHandles_[i] = descriptorManager->AllocateStagingSRV();
 		assert(intermediateSRVHandles_[i].isValid);
 
 		// SRV作成
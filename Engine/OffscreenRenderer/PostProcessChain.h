@@ -64,6 +64,7 @@ public:
 
 	/// <summary>
 	/// エフェクトを追加（自動初期化付き）
+	/// PSOは追加し終わった後のCreatePipelineStatesでまとめて作る（それより後に追加したものはその場で作る）
 	/// </summary>
 	template<typename T>
 	T* AddEffect() {
@@ -75,9 +76,20 @@ public:
 		}
 
 		effects_.push_back(std::move(effect));
+		if (isPipelineCreated_) {
+			CreatePipelineStates();
+		}
 		return ptr;
 	}
 
+	/// <summary>
+	/// PSOを持っていないエフェクトのPSOをまとめて作る（1回のPSOFactory::CreatePSOBatchで、呼び出し側のPSOも一緒に作れる）
+	/// </summary>
+	/// <param name="extraRequests">一緒に作る呼び出し側のPSOの設定</param>
+	/// <param name="extraResults">extraRequestsと同じ順番のPSO情報の書き込み先（不要ならnullptr）</param>
+	void CreatePipelineStates(const std::vector<PSOFactory::BatchRequest>& extraRequests = {},
+		std::vector<PSOFactory::PSOInfo>* extraResults = nullptr);
+
 	/// <summary>
 	/// ImGui表示
 	/// </summary>
@@ -138,7 +150,7 @@ private:
 	// 中間バッファ（2つのバッファを交互に使用してピンポン処理）
 	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateBuffers_[2];
 
-	// 中間バッファ用のハンドル
+	// 中間バッファ用のハンドル（SRVはステージング用。描画に使う時はリングへコピーする）
 	DescriptorHeapManager::DescriptorHandle intermediateSRVHandles_[2];
 	DescriptorHeapManager::DescriptorHandle intermediateRTVHandles_[2];
 
@@ -147,4 +159,7 @@ private:
 
 	// 初期化フラグ
 	bool isInitialized_ = false;
+
+	// CreatePipelineStatesを呼んだか（後から追加したエフェクトはその場でPSOを作る）
+	bool isPipelineCreated_ = false;
 };
\ No newline at end of file
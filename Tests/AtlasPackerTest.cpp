@@ -0,0 +1,136 @@
+#include "TestFramework.h"
+#include "Managers/Texture/AtlasPacker.h"
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+namespace {
+
+const uint32_t kPageSize = 512;
+const uint32_t kPadding = 2;
+
+/// <summary>
+/// 乱数で画像のサイズ一覧を作る（毎回同じになるようにシードを固定）
+/// </summary>
+std::vector<AtlasPacker::Item> CreateRandomItems(std::mt19937& random) {
+	std::vector<AtlasPacker::Item> items;
+	const uint32_t count = 20 + static_cast<uint32_t>(random() % 200);
+	for (uint32_t i = 0; i < count; ++i) {
+		items.push_back({ 1 + static_cast<uint32_t>(random() % 120), 1 + static_cast<uint32_t>(random() % 120) });
+	}
+	return items;
+}
+
+/// <summary>
+/// 配置を比較しやすい形にする
+/// </summary>
+std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t> ToKey(const AtlasPacker::Placement& placement) {
+	return { placement.page, placement.rect.x, placement.rect.y, placement.rect.width, placement.rect.height };
+}
+
+} // namespace
+
+TEST_CASE(AtlasPacker_PlacementsStayInsidePage) {
+	std::mt19937 random(1);
+	for (int trial = 0; trial < 20; ++trial) {
+		const std::vector<AtlasPacker::Item> items = CreateRandomItems(random);
+		AtlasPacker packer;
+		packer.Initialize(kPageSize, kPageSize, kPadding);
+		std::vector<AtlasPacker::Placement> placements;
+		CHECK(packer.Pack(items, placements));
+		CHECK_EQ(placements.size(), items.size());
+
+		// 画像の大きさはそのままで、余白を含めてページに収まる
+		for (size_t i = 0; i < items.size(); ++i) {
+			const AtlasRect& rect = placements[i].rect;
+			CHECK(placements[i].page < packer.GetPageCount());
+			CHECK_EQ(rect.width, items[i].width);
+			CHECK_EQ(rect.height, items[i].height);
+			CHECK(rect.x >= kPadding && rect.y >= kPadding);
+			CHECK(rect.x + rect.width + kPadding <= kPageSize);
+			CHECK(rect.y + rect.height + kPadding <= kPageSize);
+		}
+		for (uint32_t page = 0; page < packer.GetPageCount(); ++page) {
+			CHECK(packer.GetOccupancy(page) > 0.0f && packer.GetOccupancy(page) <= 1.0f);
+		}
+	}
+}
+
+TEST_CASE(AtlasPacker_PaddedRectsDoNotOverlap) {
+	std::mt19937 random(2);
+	for (int trial = 0; trial < 20; ++trial) {
+		const std::vector<AtlasPacker::Item> items = CreateRandomItems(random);
+		AtlasPacker packer;
+		packer.Initialize(kPageSize, kPageSize, kPadding);
+		std::vector<AtlasPacker::Placement> placements;
+		packer.Pack(items, placements);
+
+		// 同じページの画像同士は、余白を含めた矩形が重ならない
+		for (size_t i = 0; i < placements.size(); ++i) {
+			const AtlasRect& a = placements[i].rect;
+			for (size_t j = i + 1; j < placements.size(); ++j) {
+				if (placements[i].page != placements[j].page) {
+					continue;
+				}
+				const AtlasRect& b = placements[j].rect;
+				const bool isSeparated =
+					a.x + a.width + kPadding <= b.x - kPadding || b.x + b.width + kPadding <= a.x - kPadding ||
+					a.y + a.height + kPadding <= b.y - kPadding || b.y + b.height + kPadding <= a.y - kPadding;
+				CHECK(isSeparated);
+			}
+		}
+	}
+}
+
+TEST_CASE(AtlasPacker_OversizedItemIsRejected) {
+	AtlasPacker packer;
+	packer.Initialize(kPageSize, kPageSize, kPadding);
+	std::vector<AtlasPacker::Placement> placements;
+	// 余白を足すとページに入らないものも詰められない
+	const std::vector<AtlasPacker::Item> items = { { 64, 64 }, { 600, 10 }, { kPageSize, 8 }, { 32, 32 } };
+	CHECK(!packer.Pack(items, placements));
+	CHECK(placements[0].page != AtlasPacker::kInvalidPage);
+	CHECK_EQ(placements[1].page, AtlasPacker::kInvalidPage);
+	CHECK_EQ(placements[2].page, AtlasPacker::kInvalidPage);
+	CHECK(placements[3].page != AtlasPacker::kInvalidPage);
+	CHECK_EQ(packer.GetPageCount(), 1u);
+}
+
+TEST_CASE(AtlasPacker_ResultDoesNotDependOnInputOrder) {
+	std::mt19937 random(3);
+	for (int trial = 0; trial < 20; ++trial) {
+		const std::vector<AtlasPacker::Item> items = CreateRandomItems(random);
+		AtlasPacker packer;
+		packer.Initialize(kPageSize, kPageSize, kPadding);
+		std::vector<AtlasPacker::Placement> placements;
+		packer.Pack(items, placements);
+
+		// 同じ入力なら同じ配置
+		AtlasPacker repeated;
+		repeated.Initialize(kPageSize, kPageSize, kPadding);
+		std::vector<AtlasPacker::Placement> repeatedPlacements;
+		repeated.Pack(items, repeatedPlacements);
+		for (size_t i = 0; i < placements.size(); ++i) {
+			CHECK(ToKey(placements[i]) == ToKey(repeatedPlacements[i]));
+		}
+
+		// 並べ替えた入力でも、配置の組み合わせは同じ
+		std::vector<AtlasPacker::Item> shuffled = items;
+		std::shuffle(shuffled.begin(), shuffled.end(), random);
+		AtlasPacker shuffledPacker;
+		shuffledPacker.Initialize(kPageSize, kPageSize, kPadding);
+		std::vector<AtlasPacker::Placement> shuffledPlacements;
+		shuffledPacker.Pack(shuffled, shuffledPlacements);
+		CHECK_EQ(shuffledPacker.GetPageCount(), packer.GetPageCount());
+
+		std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>> keys;
+		std::vector<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>> shuffledKeys;
+		for (size_t i = 0; i < placements.size(); ++i) {
+			keys.push_back(ToKey(placements[i]));
+			shuffledKeys.push_back(ToKey(shuffledPlacements[i]));
+		}
+		std::sort(keys.begin(), keys.end());
+		std::sort(shuffledKeys.begin(), shuffledKeys.end());
+		CHECK(keys == shuffledKeys);
+	}
+}
@@ -0,0 +1,208 @@
+#include "TestFramework.h"
+#include "Managers/Texture/BlockCompressor.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+
+using Format = BlockCompressor::Format;
+using Quality = BlockCompressor::Quality;
+
+/// <summary>
+/// なめらかなグラデーションに少しノイズを乗せた画像を作る（実際のテクスチャに近いもの）
+/// </summary>
+std::vector<uint8_t> MakeGradientImage(uint32_t width, uint32_t height) {
+	std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+	std::mt19937 random(1);
+	std::uniform_int_distribution<int> noise(-6, 6);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const float u = static_cast<float>(x) / static_cast<float>(width);
+			const float v = static_cast<float>(y) / static_cast<float>(height);
+			const float values[4] = {
+				255.0f * u,
+				255.0f * v,
+				127.5f + 127.5f * std::sin(6.0f * (u + v)),
+				255.0f * (1.0f - 0.5f * u * v),
+			};
+			uint8_t* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+			for (int channel = 0; channel < 4; ++channel) {
+				const int value = static_cast<int>(values[channel] + 0.5f) + noise(random);
+				pixel[channel] = static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+			}
+		}
+	}
+	return pixels;
+}
+
+/// <summary>
+/// 圧縮して戻し、元の画像とのPSNRを返す
+/// </summary>
+double RoundTripPSNR(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, Format format, Quality quality) {
+	const BlockCompressor::SourceImage source{ pixels.data(), width, height, static_cast<size_t>(width) * 4 };
+	BlockCompressor::Settings settings;
+	settings.format = format;
+	settings.quality = quality;
+	std::vector<uint8_t> blocks;
+	CHECK(BlockCompressor::Compress(source, settings, blocks));
+	CHECK_EQ(blocks.size(), BlockCompressor::ComputeCompressedSize(format, width, height));
+
+	std::vector<uint8_t> decoded;
+	BlockCompressor::Decompress(format, blocks.data(), width, height, decoded);
+	CHECK_EQ(decoded.size(), pixels.size());
+	return BlockCompressor::ComputePSNR(pixels.data(), static_cast<size_t>(width) * 4, decoded.data(), static_cast<size_t>(width) * 4,
+		width, height, BlockCompressor::GetChannelMask(format));
+}
+
+} // namespace
+
+TEST_CASE(BlockCompressor_ComputeCompressedSize) {
+	// 端の足りないブロックも1ブロックとして数える
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC1, 4, 4), 8u);
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC7, 4, 4), 16u);
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC1, 256, 128), 64u * 32u * 8u);
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC3, 256, 128), 64u * 32u * 16u);
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC5, 1, 1), 16u);
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC7, 5, 9), 2u * 3u * 16u);
+	CHECK_EQ(BlockCompressor::ComputeCompressedSize(Format::BC1, 7, 3), 2u * 1u * 8u);
+}
+
+TEST_CASE(BlockCompressor_RoundTripKeepsQuality) {
+	// 品質ごとにPSNRの下限を確かめる（上の品質ほど下がらない）
+	const uint32_t size = 64;
+	const std::vector<uint8_t> pixels = MakeGradientImage(size, size);
+	struct Expectation {
+		Format format;
+		double minimumPSNR;
+	};
+	const Expectation expectations[] = {
+		{ Format::BC1, 32.0 },
+		{ Format::BC3, 33.0 },
+		{ Format::BC5, 45.0 },
+		{ Format::BC7, 34.0 },
+	};
+	for (const Expectation& expectation : expectations) {
+		const double fast = RoundTripPSNR(pixels, size, size, expectation.format, Quality::Fast);
+		const double normal = RoundTripPSNR(pixels, size, size, expectation.format, Quality::Normal);
+		const double high = RoundTripPSNR(pixels, size, size, expectation.format, Quality::High);
+		CHECK(fast >= expectation.minimumPSNR - 2.0);
+		CHECK(normal >= expectation.minimumPSNR);
+		CHECK(high >= expectation.minimumPSNR);
+		CHECK(high >= normal - 0.1);
+	}
+}
+
+TEST_CASE(BlockCompressor_FlatBlocksAreNearlyExact) {
+	// 1色だけのブロックは端点の量子化の誤差しか出ない
+	const uint32_t size = 8;
+	const uint8_t colors[][4] = {
+		{ 0, 0, 0, 255 },
+		{ 255, 255, 255, 255 },
+		{ 200, 64, 31, 128 },
+		{ 17, 230, 99, 0 },
+	};
+	for (const uint8_t* color : colors) {
+		std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+		for (size_t i = 0; i < pixels.size(); i += 4) {
+			std::memcpy(pixels.data() + i, color, 4);
+		}
+		for (Format format : { Format::BC1, Format::BC3, Format::BC5, Format::BC7 }) {
+			const BlockCompressor::SourceImage source{ pixels.data(), size, size, size * 4 };
+			BlockCompressor::Settings settings;
+			settings.format = format;
+			std::vector<uint8_t> blocks;
+			CHECK(BlockCompressor::Compress(source, settings, blocks));
+			std::vector<uint8_t> decoded;
+			BlockCompressor::Decompress(format, blocks.data(), size, size, decoded);
+
+			// BC1はRGB565の量子化で最大4ずれる。他は2まで
+			const int tolerance = (format == Format::BC1 || format == Format::BC3) ? 4 : 2;
+			const uint32_t channelMask = BlockCompressor::GetChannelMask(format);
+			bool isClose = true;
+			for (size_t i = 0; i < decoded.size(); i += 4) {
+				for (int channel = 0; channel < 4; ++channel) {
+					if (channelMask & (1u << channel)) {
+						isClose = isClose && std::abs(decoded[i + channel] - color[channel]) <= tolerance;
+					}
+				}
+			}
+			CHECK(isClose);
+		}
+	}
+}
+
+TEST_CASE(BlockCompressor_NonMultipleOfFourSize) {
+	// 大きな画像の左上を切り出して、4の倍数でない大きさの画像にする
+	const uint32_t width = 13;
+	const uint32_t height = 6;
+	const std::vector<uint8_t> image = MakeGradientImage(64, 64);
+	std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+	for (uint32_t y = 0; y < height; ++y) {
+		std::memcpy(pixels.data() + static_cast<size_t>(y) * width * 4, image.data() + static_cast<size_t>(y) * 64 * 4, width * 4);
+	}
+	for (Format format : { Format::BC1, Format::BC3, Format::BC5, Format::BC7 }) {
+		CHECK(RoundTripPSNR(pixels, width, height, format, Quality::Normal) >= 30.0);
+	}
+
+	// 端の足りない画素は端の画素を繰り返すので、自分で端を繰り返して16x8にした画像と同じブロックになる
+	const uint32_t paddedWidth = 16;
+	const uint32_t paddedHeight = 8;
+	std::vector<uint8_t> padded(static_cast<size_t>(paddedWidth) * paddedHeight * 4);
+	for (uint32_t y = 0; y < paddedHeight; ++y) {
+		for (uint32_t x = 0; x < paddedWidth; ++x) {
+			const uint32_t sourceX = (std::min)(x, width - 1);
+			const uint32_t sourceY = (std::min)(y, height - 1);
+			std::memcpy(padded.data() + (static_cast<size_t>(y) * paddedWidth + x) * 4, pixels.data() + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+		}
+	}
+	for (Format format : { Format::BC1, Format::BC3, Format::BC5, Format::BC7 }) {
+		BlockCompressor::Settings settings;
+		settings.format = format;
+		std::vector<uint8_t> blocks;
+		CHECK(BlockCompressor::Compress({ pixels.data(), width, height, width * 4 }, settings, blocks));
+		std::vector<uint8_t> paddedBlocks;
+		CHECK(BlockCompressor::Compress({ padded.data(), paddedWidth, paddedHeight, paddedWidth * 4 }, settings, paddedBlocks));
+		CHECK(blocks == paddedBlocks);
+	}
+
+	// 1画素だけの画像も1ブロックとして圧縮できる
+	const uint8_t pixel[4] = { 10, 200, 90, 255 };
+	const BlockCompressor::SourceImage source{ pixel, 1, 1, 4 };
+	BlockCompressor::Settings settings;
+	settings.format = Format::BC7;
+	std::vector<uint8_t> blocks;
+	CHECK(BlockCompressor::Compress(source, settings, blocks));
+	CHECK_EQ(blocks.size(), 16u);
+	std::vector<uint8_t> decoded;
+	BlockCompressor::Decompress(Format::BC7, blocks.data(), 1, 1, decoded);
+	CHECK_EQ(decoded.size(), 4u);
+	for (int channel = 0; channel < 4; ++channel) {
+		CHECK(std::abs(decoded[channel] - pixel[channel]) <= 2);
+	}
+
+	// 空の画像は圧縮できない
+	const BlockCompressor::SourceImage empty{ nullptr, 0, 0, 0 };
+	CHECK(!BlockCompressor::Compress(empty, settings, blocks));
+}
+
+TEST_CASE(BlockCompressor_ParallelMatchesSerial) {
+	// ブロックの行を並列に処理しても、1スレッドと同じ結果になる
+	ThreadPool::GetInstance()->Initialize(4);
+	const uint32_t size = 128;
+	const std::vector<uint8_t> pixels = MakeGradientImage(size, size);
+	const BlockCompressor::SourceImage source{ pixels.data(), size, size, size * 4 };
+	for (Format format : { Format::BC1, Format::BC3, Format::BC5, Format::BC7 }) {
+		BlockCompressor::Settings settings;
+		settings.format = format;
+		std::vector<uint8_t> parallel;
+		CHECK(BlockCompressor::Compress(source, settings, parallel));
+		settings.isParallel = false;
+		std::vector<uint8_t> serial;
+		CHECK(BlockCompressor::Compress(source, settings, serial));
+		CHECK(parallel == serial);
+	}
+	ThreadPool::GetInstance()->Finalize();
+}
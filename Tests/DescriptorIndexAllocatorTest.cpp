@@ -0,0 +1,159 @@
+#include "TestFramework.h"
+#include "BaseSystem/DirectXCommon/DescriptorIndexAllocator.h"
+#include <algorithm>
+#include <random>
+
+namespace {
+
+/// <summary>
+/// 使用中のフラグから、一番小さい空きインデックスを線形に探す（比較用）
+/// </summary>
+uint32_t FindLowestFree(const std::vector<bool>& used) {
+	for (uint32_t index = 0; index < used.size(); ++index) {
+		if (!used[index]) {
+			return index;
+		}
+	}
+	return DescriptorIndexAllocator::kInvalidIndex;
+}
+
+} // namespace
+
+TEST_CASE(DescriptorIndexAllocator_AllocatesLowestFirst) {
+	DescriptorIndexAllocator allocator;
+	allocator.Initialize(200);
+	for (uint32_t i = 0; i < 200; ++i) {
+		CHECK_EQ(allocator.Allocate(), i);
+	}
+	CHECK_EQ(allocator.Allocate(), DescriptorIndexAllocator::kInvalidIndex);
+
+	// 空いた所のうち一番小さいものから埋める
+	CHECK(allocator.Release(150));
+	CHECK(allocator.Release(7));
+	CHECK(allocator.Release(64));
+	CHECK_EQ(allocator.Allocate(), 7u);
+	CHECK_EQ(allocator.Allocate(), 64u);
+	CHECK_EQ(allocator.Allocate(), 150u);
+	CHECK_EQ(allocator.Allocate(), DescriptorIndexAllocator::kInvalidIndex);
+
+	const DescriptorIndexAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK_EQ(statistics.usedCount, 200u);
+	CHECK_EQ(statistics.highWaterMark, 200u);
+	CHECK_EQ(statistics.allocateCount, 203u);
+	CHECK_EQ(statistics.releaseCount, 3u);
+	CHECK_EQ(statistics.failedCount, 2u);
+}
+
+TEST_CASE(DescriptorIndexAllocator_WordBoundaries) {
+	// 1語（64）と要約1語分（64 * 64 = 4096）の前後で、末尾の範囲外ビットを空きとして返さない
+	for (uint32_t capacity : { 1u, 63u, 64u, 65u, 127u, 128u, 129u, 4095u, 4096u, 4097u, 8192u, 8193u }) {
+		DescriptorIndexAllocator allocator;
+		allocator.Initialize(capacity);
+		for (uint32_t i = 0; i < capacity; ++i) {
+			CHECK_EQ(allocator.Allocate(), i);
+		}
+		CHECK_EQ(allocator.Allocate(), DescriptorIndexAllocator::kInvalidIndex);
+		CHECK_EQ(allocator.GetAvailableCount(), 0u);
+		CHECK_EQ(allocator.GetStatistics().highestUsedIndex, capacity);
+		CHECK(!allocator.IsUsed(capacity));
+
+		// 語が埋まる→1つ空く→また埋まる、の切り替わりで要約ビットが正しく戻る
+		for (uint32_t index : { 0u, 63u, 64u, 4095u, 4096u, capacity - 1 }) {
+			if (index >= capacity) {
+				continue;
+			}
+			CHECK(allocator.Release(index));
+			CHECK(!allocator.IsUsed(index));
+			CHECK_EQ(allocator.Allocate(), index);
+			CHECK(allocator.IsUsed(index));
+			CHECK_EQ(allocator.Allocate(), DescriptorIndexAllocator::kInvalidIndex);
+		}
+	}
+}
+
+TEST_CASE(DescriptorIndexAllocator_DoubleReleaseAndReserve) {
+	DescriptorIndexAllocator allocator;
+	allocator.Initialize(130);
+	CHECK(allocator.Reserve(65));
+	CHECK(!allocator.Reserve(65));
+	CHECK(!allocator.Reserve(130));
+	CHECK_EQ(allocator.GetUsedCount(), 1u);
+
+	// 予約した所は飛ばして割り当てる
+	for (uint32_t i = 0; i < 65; ++i) {
+		CHECK_EQ(allocator.Allocate(), i);
+	}
+	CHECK_EQ(allocator.Allocate(), 66u);
+
+	// 二重解放と範囲外の解放は失敗し、数は変わらない
+	CHECK(allocator.Release(65));
+	CHECK(!allocator.Release(65));
+	CHECK(!allocator.Release(129));
+	CHECK(!allocator.Release(130));
+	CHECK(!allocator.Release(DescriptorIndexAllocator::kInvalidIndex));
+	CHECK_EQ(allocator.GetUsedCount(), 66u);
+	CHECK_EQ(allocator.GetStatistics().releaseCount, 1u);
+	CHECK_EQ(allocator.Allocate(), 65u);
+}
+
+TEST_CASE(DescriptorIndexAllocator_MatchesLinearReference) {
+	// 乱数で割り当て・解放・予約をして、線形に探した結果と統計を比べる
+	for (uint32_t capacity : { 5u, 64u, 65u, 4096u, 4097u, 10000u }) {
+		DescriptorIndexAllocator allocator;
+		allocator.Initialize(capacity);
+		std::vector<bool> used(capacity, false);
+		std::mt19937 random(capacity);
+		for (int step = 0; step < 20000; ++step) {
+			const uint32_t operation = static_cast<uint32_t>(random() % 3);
+			const uint32_t index = static_cast<uint32_t>(random() % (capacity + 2));
+			if (operation == 0) {
+				const uint32_t expected = FindLowestFree(used);
+				const uint32_t allocated = allocator.Allocate();
+				CHECK_EQ(allocated, expected);
+				if (allocated != DescriptorIndexAllocator::kInvalidIndex) {
+					used[allocated] = true;
+				}
+			} else if (operation == 1) {
+				const bool expected = index < capacity && used[index];
+				CHECK_EQ(allocator.Release(index), expected);
+				if (expected) {
+					used[index] = false;
+				}
+			} else {
+				const bool expected = index < capacity && !used[index];
+				CHECK_EQ(allocator.Reserve(index), expected);
+				if (expected) {
+					used[index] = true;
+				}
+			}
+
+			if (step % 97 != 0) {
+				continue;
+			}
+			uint32_t usedCount = 0;
+			uint32_t highestUsedIndex = 0;
+			uint32_t freeRunCount = 0;
+			uint32_t largestFreeRun = 0;
+			uint32_t currentRun = 0;
+			for (uint32_t i = 0; i < capacity; ++i) {
+				if (used[i]) {
+					++usedCount;
+					highestUsedIndex = i + 1;
+					if (currentRun != 0) {
+						++freeRunCount;
+						largestFreeRun = (std::max)(largestFreeRun, currentRun);
+						currentRun = 0;
+					}
+				} else {
+					++currentRun;
+				}
+			}
+			largestFreeRun = (std::max)(largestFreeRun, currentRun);
+			const DescriptorIndexAllocator::Statistics statistics = allocator.GetStatistics();
+			CHECK_EQ(statistics.usedCount, usedCount);
+			CHECK_EQ(statistics.highestUsedIndex, highestUsedIndex);
+			CHECK_EQ(statistics.freeRunCount, freeRunCount);
+			CHECK_EQ(statistics.largestFreeRun, largestFreeRun);
+		}
+	}
+}
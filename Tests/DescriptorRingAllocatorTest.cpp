@@ -0,0 +1,105 @@
+#include "TestFramework.h"
+#include "BaseSystem/DirectXCommon/DescriptorRingAllocator.h"
+
+TEST_CASE(DescriptorRingAllocator_FailsBeforeBeginFrame) {
+	DescriptorRingAllocator allocator;
+	allocator.Initialize(10);
+
+	// BeginFrameの前と数0の割り当ては失敗する
+	CHECK_EQ(allocator.Allocate(1), DescriptorRingAllocator::kInvalidOffset);
+	allocator.BeginFrame(1);
+	CHECK_EQ(allocator.Allocate(0), DescriptorRingAllocator::kInvalidOffset);
+	CHECK_EQ(allocator.Allocate(11), DescriptorRingAllocator::kInvalidOffset);
+	CHECK_EQ(allocator.Allocate(10), 0u);
+	CHECK_EQ(allocator.GetAvailableCount(), 0u);
+
+	// 同じフェンス値で呼ぶと同じフレームとして続ける
+	allocator.BeginFrame(1);
+	CHECK_EQ(allocator.GetStatistics().pendingFrameCount, 1u);
+
+	const DescriptorRingAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK_EQ(statistics.allocateCount, 1u);
+	CHECK_EQ(statistics.failedCount, 3u);
+}
+
+TEST_CASE(DescriptorRingAllocator_WrapAroundCountsTailWaste) {
+	DescriptorRingAllocator allocator;
+	allocator.Initialize(10);
+	allocator.BeginFrame(1);
+	CHECK_EQ(allocator.Allocate(4), 0u);
+	CHECK_EQ(allocator.Allocate(3), 4u);
+	allocator.BeginFrame(2);
+	CHECK_EQ(allocator.Allocate(2), 7u);
+	CHECK_EQ(allocator.GetUsedCount(), 9u);
+
+	// フレーム1が終わると[0, 7)が空く
+	allocator.Reclaim(1);
+	CHECK_EQ(allocator.GetUsedCount(), 2u);
+
+	// 末尾の残り1つには収まらないので、捨てて先頭から切り出す
+	allocator.BeginFrame(3);
+	CHECK_EQ(allocator.Allocate(3), 0u);
+	CHECK_EQ(allocator.GetUsedCount(), 6u);
+	CHECK_EQ(allocator.GetStatistics().wastedCount, 1u);
+
+	// 残りは[3, 7)の4つだけ
+	CHECK_EQ(allocator.Allocate(5), DescriptorRingAllocator::kInvalidOffset);
+	CHECK_EQ(allocator.Allocate(4), 3u);
+	CHECK_EQ(allocator.GetAvailableCount(), 0u);
+	CHECK_EQ(allocator.Allocate(1), DescriptorRingAllocator::kInvalidOffset);
+
+	const DescriptorRingAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK_EQ(statistics.usedCount, 10u);
+	CHECK_EQ(statistics.highWaterMark, 10u);
+	CHECK_EQ(statistics.pendingFrameCount, 2u);
+	CHECK_EQ(statistics.allocateCount, 5u);
+	CHECK_EQ(statistics.failedCount, 2u);
+}
+
+TEST_CASE(DescriptorRingAllocator_ReclaimByFenceValue) {
+	DescriptorRingAllocator allocator;
+	allocator.Initialize(100);
+	for (uint64_t fenceValue = 1; fenceValue <= 4; ++fenceValue) {
+		allocator.BeginFrame(fenceValue);
+		CHECK_EQ(allocator.Allocate(10), static_cast<uint32_t>((fenceValue - 1) * 10));
+	}
+	CHECK_EQ(allocator.GetStatistics().pendingFrameCount, 4u);
+
+	// 完了していないフェンス値では何も返さない
+	allocator.Reclaim(0);
+	CHECK_EQ(allocator.GetUsedCount(), 40u);
+
+	// 完了したフェンス値までのフレームをまとめて返す
+	allocator.Reclaim(2);
+	CHECK_EQ(allocator.GetUsedCount(), 20u);
+	CHECK_EQ(allocator.GetStatistics().pendingFrameCount, 2u);
+
+	// 何も割り当てなかったフレームも順番通りに返す
+	allocator.BeginFrame(5);
+	allocator.Reclaim(4);
+	CHECK_EQ(allocator.GetUsedCount(), 0u);
+	CHECK_EQ(allocator.GetStatistics().pendingFrameCount, 1u);
+	allocator.Reclaim(5);
+	CHECK_EQ(allocator.GetStatistics().pendingFrameCount, 0u);
+	CHECK_EQ(allocator.GetStatistics().highWaterMark, 40u);
+}
+
+TEST_CASE(DescriptorRingAllocator_ResetsToStartWhenEmpty) {
+	DescriptorRingAllocator allocator;
+	allocator.Initialize(10);
+	allocator.BeginFrame(1);
+	CHECK_EQ(allocator.Allocate(6), 0u);
+	allocator.Reclaim(1);
+	CHECK_EQ(allocator.GetUsedCount(), 0u);
+
+	// 全て空いていれば先頭から使い直すので、末尾に収まらない大きさでも捨てずに割り当てる
+	allocator.BeginFrame(2);
+	CHECK_EQ(allocator.Allocate(8), 0u);
+	CHECK_EQ(allocator.GetStatistics().wastedCount, 0u);
+
+	// Initializeで全て空きに戻る
+	allocator.Initialize(10);
+	CHECK_EQ(allocator.GetUsedCount(), 0u);
+	CHECK_EQ(allocator.GetStatistics().allocateCount, 0u);
+	CHECK_EQ(allocator.Allocate(1), DescriptorRingAllocator::kInvalidOffset);
+}
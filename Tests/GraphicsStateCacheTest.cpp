@@ -0,0 +1,210 @@
+#include "TestFramework.h"
+#include "BaseSystem/DirectXCommon/GraphicsStateCache.h"
+
+namespace {
+
+/// <summary>
+/// 呼ばれた回数だけを数えるコマンドリスト（GraphicsStateCacheのテンプレート引数に使う）
+/// </summary>
+struct MockCommandList {
+	uint32_t rootSignatureCount = 0;
+	uint32_t pipelineStateCount = 0;
+	uint32_t topologyCount = 0;
+	uint32_t vertexBufferCount = 0;
+	uint32_t indexBufferCount = 0;
+	uint32_t constantBufferViewCount = 0;
+	uint32_t descriptorTableCount = 0;
+	uint32_t shaderResourceViewCount = 0;
+	uint32_t constantCount = 0;
+	uint32_t drawCount = 0;
+
+	void SetGraphicsRootSignature(ID3D12RootSignature*) { ++rootSignatureCount; }
+	void SetPipelineState(ID3D12PipelineState*) { ++pipelineStateCount; }
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY) { ++topologyCount; }
+	void IASetVertexBuffers(UINT, UINT, const D3D12_VERTEX_BUFFER_VIEW*) { ++vertexBufferCount; }
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW*) { ++indexBufferCount; }
+	void SetGraphicsRootConstantBufferView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) { ++constantBufferViewCount; }
+	void SetGraphicsRootDescriptorTable(UINT, D3D12_GPU_DESCRIPTOR_HANDLE) { ++descriptorTableCount; }
+	void SetGraphicsRootShaderResourceView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) { ++shaderResourceViewCount; }
+	void SetGraphicsRoot32BitConstant(UINT, UINT, UINT) { ++constantCount; }
+	void DrawInstanced(UINT, UINT, UINT, UINT) { ++drawCount; }
+	void DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) { ++drawCount; }
+};
+
+using MockStateCache = BasicGraphicsStateCache<MockCommandList>;
+
+// 値として比べるだけなので、指す先はなくてよい
+ID3D12RootSignature* const kRootSignatureA = reinterpret_cast<ID3D12RootSignature*>(0x100);
+ID3D12RootSignature* const kRootSignatureB = reinterpret_cast<ID3D12RootSignature*>(0x200);
+ID3D12PipelineState* const kPipelineStateA = reinterpret_cast<ID3D12PipelineState*>(0x300);
+ID3D12PipelineState* const kPipelineStateB = reinterpret_cast<ID3D12PipelineState*>(0x400);
+
+const D3D12_VERTEX_BUFFER_VIEW kVertexBufferA{ 0x1000, 256, 32 };
+const D3D12_VERTEX_BUFFER_VIEW kVertexBufferB{ 0x2000, 256, 32 };
+const D3D12_INDEX_BUFFER_VIEW kIndexBufferA{ 0x3000, 64, DXGI_FORMAT_R32_UINT };
+const D3D12_INDEX_BUFFER_VIEW kIndexBufferB{ 0x4000, 64, DXGI_FORMAT_R32_UINT };
+
+/// <summary>
+/// 全ての種類のステートを1回ずつ設定する
+/// </summary>
+void SetAllStates(MockStateCache& stateCache) {
+	stateCache.SetGraphicsRootSignature(kRootSignatureA);
+	stateCache.SetPipelineState(kPipelineStateA);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache.IASetVertexBuffers(0, 1, &kVertexBufferA);
+	stateCache.IASetIndexBuffer(&kIndexBufferA);
+	stateCache.SetGraphicsRootConstantBufferView(0, 0x5000);
+	stateCache.SetGraphicsRootDescriptorTable(2, D3D12_GPU_DESCRIPTOR_HANDLE{ 0x6000 });
+	stateCache.SetGraphicsRootShaderResourceView(4, 0x7000);
+	stateCache.SetGraphicsRoot32BitConstant(5, 3, 0);
+}
+
+} // namespace
+
+TEST_CASE(GraphicsStateCache_ElidesRepeatedStates) {
+	MockCommandList commandList;
+	MockStateCache stateCache;
+	stateCache.SetCommandList(&commandList);
+
+	// 1回目は全て発行し、同じ値の2回目は全て省く
+	SetAllStates(stateCache);
+	SetAllStates(stateCache);
+	CHECK_EQ(commandList.rootSignatureCount, 1u);
+	CHECK_EQ(commandList.pipelineStateCount, 1u);
+	CHECK_EQ(commandList.topologyCount, 1u);
+	CHECK_EQ(commandList.vertexBufferCount, 1u);
+	CHECK_EQ(commandList.indexBufferCount, 1u);
+	CHECK_EQ(commandList.constantBufferViewCount, 1u);
+	CHECK_EQ(commandList.descriptorTableCount, 1u);
+	CHECK_EQ(commandList.shaderResourceViewCount, 1u);
+	CHECK_EQ(commandList.constantCount, 1u);
+	CHECK_EQ(stateCache.GetStatistics().issuedCount, 9u);
+	CHECK_EQ(stateCache.GetStatistics().elidedCount, 9u);
+
+	// 違う値は発行する
+	stateCache.SetPipelineState(kPipelineStateB);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+	stateCache.IASetVertexBuffers(0, 1, &kVertexBufferB);
+	stateCache.IASetIndexBuffer(&kIndexBufferB);
+	stateCache.SetGraphicsRootConstantBufferView(0, 0x5100);
+	stateCache.SetGraphicsRootDescriptorTable(2, D3D12_GPU_DESCRIPTOR_HANDLE{ 0x6100 });
+	CHECK_EQ(commandList.pipelineStateCount, 2u);
+	CHECK_EQ(commandList.topologyCount, 2u);
+	CHECK_EQ(commandList.vertexBufferCount, 2u);
+	CHECK_EQ(commandList.indexBufferCount, 2u);
+	CHECK_EQ(commandList.constantBufferViewCount, 2u);
+	CHECK_EQ(commandList.descriptorTableCount, 2u);
+	CHECK(stateCache.GetPipelineState() == kPipelineStateB);
+	CHECK_EQ(stateCache.GetPrimitiveTopology(), D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+
+	// 同じルート番号でも種類が違えば発行する
+	stateCache.SetGraphicsRootShaderResourceView(0, 0x5100);
+	CHECK_EQ(commandList.shaderResourceViewCount, 2u);
+
+	// 描画は省かずにそのまま発行し、統計にも数えない
+	stateCache.DrawInstanced(3, 1, 0, 0);
+	stateCache.DrawIndexedInstanced(6, 1, 0, 0, 0);
+	CHECK_EQ(commandList.drawCount, 2u);
+	CHECK_EQ(stateCache.GetStatistics().issuedCount, 16u);
+	CHECK_EQ(stateCache.GetStatistics().elidedCount, 9u);
+}
+
+TEST_CASE(GraphicsStateCache_RootSignatureChangeResetsRootArguments) {
+	MockCommandList commandList;
+	MockStateCache stateCache;
+	stateCache.SetCommandList(&commandList);
+	SetAllStates(stateCache);
+
+	// ルートシグネチャが変わるとルート引数は同じ値でも発行し直す（PSOなどはそのまま）
+	stateCache.SetGraphicsRootSignature(kRootSignatureB);
+	SetAllStates(stateCache);
+	CHECK_EQ(commandList.rootSignatureCount, 3u);
+	CHECK_EQ(commandList.pipelineStateCount, 1u);
+	CHECK_EQ(commandList.topologyCount, 1u);
+	CHECK_EQ(commandList.vertexBufferCount, 1u);
+	CHECK_EQ(commandList.indexBufferCount, 1u);
+	CHECK_EQ(commandList.constantBufferViewCount, 2u);
+	CHECK_EQ(commandList.descriptorTableCount, 2u);
+	CHECK_EQ(commandList.shaderResourceViewCount, 2u);
+	CHECK_EQ(commandList.constantCount, 2u);
+}
+
+TEST_CASE(GraphicsStateCache_InvalidateForcesReissue) {
+	MockCommandList commandList;
+	MockStateCache stateCache;
+	stateCache.SetCommandList(&commandList);
+	SetAllStates(stateCache);
+
+	// ルート引数だけを破棄すると、ルート引数だけを発行し直す
+	stateCache.InvalidateRootArguments();
+	SetAllStates(stateCache);
+	CHECK_EQ(commandList.rootSignatureCount, 1u);
+	CHECK_EQ(commandList.pipelineStateCount, 1u);
+	CHECK_EQ(commandList.topologyCount, 1u);
+	CHECK_EQ(commandList.vertexBufferCount, 1u);
+	CHECK_EQ(commandList.indexBufferCount, 1u);
+	CHECK_EQ(commandList.constantBufferViewCount, 2u);
+	CHECK_EQ(commandList.descriptorTableCount, 2u);
+	CHECK_EQ(commandList.shaderResourceViewCount, 2u);
+	CHECK_EQ(commandList.constantCount, 2u);
+	CHECK_EQ(stateCache.GetStatistics().issuedCount, 13u);
+	CHECK_EQ(stateCache.GetStatistics().elidedCount, 5u);
+
+	// 全て破棄すると全て発行し直す
+	stateCache.Invalidate();
+	SetAllStates(stateCache);
+	CHECK_EQ(commandList.rootSignatureCount, 2u);
+	CHECK_EQ(commandList.pipelineStateCount, 2u);
+	CHECK_EQ(commandList.topologyCount, 2u);
+	CHECK_EQ(commandList.vertexBufferCount, 2u);
+	CHECK_EQ(commandList.indexBufferCount, 2u);
+	CHECK_EQ(commandList.constantCount, 3u);
+	CHECK_EQ(stateCache.GetStatistics().issuedCount, 22u);
+
+	// コマンドリストを設定し直した時も全て破棄する
+	MockCommandList nextCommandList;
+	stateCache.SetCommandList(&nextCommandList);
+	stateCache.ResetStatistics();
+	SetAllStates(stateCache);
+	CHECK_EQ(nextCommandList.rootSignatureCount, 1u);
+	CHECK_EQ(nextCommandList.pipelineStateCount, 1u);
+	CHECK_EQ(stateCache.GetStatistics().issuedCount, 9u);
+	CHECK_EQ(stateCache.GetStatistics().elidedCount, 0u);
+}
+
+TEST_CASE(GraphicsStateCache_UntrackedArgumentsAreAlwaysIssued) {
+	MockCommandList commandList;
+	MockStateCache stateCache;
+	stateCache.SetCommandList(&commandList);
+
+	// 記録範囲外の頂点バッファスロットとルート番号は毎回発行する
+	const D3D12_VERTEX_BUFFER_VIEW views[2] = { kVertexBufferA, kVertexBufferB };
+	stateCache.IASetVertexBuffers(MockStateCache::kMaxVertexBufferSlots - 1, 2, views);
+	stateCache.IASetVertexBuffers(MockStateCache::kMaxVertexBufferSlots - 1, 2, views);
+	CHECK_EQ(commandList.vertexBufferCount, 2u);
+	stateCache.SetGraphicsRootConstantBufferView(MockStateCache::kMaxRootParameters, 0x5000);
+	stateCache.SetGraphicsRootConstantBufferView(MockStateCache::kMaxRootParameters, 0x5000);
+	CHECK_EQ(commandList.constantBufferViewCount, 2u);
+
+	// 複数スロットは全て同じ時だけ省く
+	stateCache.IASetVertexBuffers(0, 2, views);
+	stateCache.IASetVertexBuffers(0, 2, views);
+	stateCache.IASetVertexBuffers(1, 1, &kVertexBufferB);
+	CHECK_EQ(commandList.vertexBufferCount, 3u);
+	const D3D12_VERTEX_BUFFER_VIEW swapped[2] = { kVertexBufferA, kVertexBufferA };
+	stateCache.IASetVertexBuffers(0, 2, swapped);
+	CHECK_EQ(commandList.vertexBufferCount, 4u);
+
+	// 2番目以降の位置のルート定数は記録できないので、先頭の値も発行し直す
+	stateCache.SetGraphicsRoot32BitConstant(1, 7, 0);
+	stateCache.SetGraphicsRoot32BitConstant(1, 8, 1);
+	stateCache.SetGraphicsRoot32BitConstant(1, 7, 0);
+	stateCache.SetGraphicsRoot32BitConstant(1, 7, 0);
+	CHECK_EQ(commandList.constantCount, 3u);
+
+	// インデックスバッファを外した後は同じビューでも発行する
+	stateCache.IASetIndexBuffer(&kIndexBufferA);
+	stateCache.IASetIndexBuffer(nullptr);
+	stateCache.IASetIndexBuffer(&kIndexBufferA);
+	CHECK_EQ(commandList.indexBufferCount, 3u);
+}
@@ -0,0 +1,54 @@
+#include "Managers/Texture/MipGenerator.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+/// <summary>
+/// MipGeneratorの速さを測る（ctestには登録しない。Releaseでビルドして手で実行する）
+/// 2048x2048のsRGB画像から1x1までを、フィルタごとに並列と1スレッドで作る
+/// </summary>
+int main() {
+	ThreadPool::GetInstance()->Initialize();
+
+	const uint32_t size = 2048;
+	const int repeatCount = 5;
+	std::vector<uint8_t> image(static_cast<size_t>(size) * size * 4);
+	std::mt19937 random(1);
+	for (uint8_t& value : image) {
+		value = static_cast<uint8_t>(random());
+	}
+	const MipGenerator::SourceImage source{ image.data(), size, size, size * 4, MipGenerator::Format::RGBA8UnormSrgb };
+
+	const struct {
+		MipGenerator::Filter filter;
+		const char* name;
+	} filters[] = {
+		{ MipGenerator::Filter::Box, "Box" },
+		{ MipGenerator::Filter::Kaiser, "Kaiser" },
+		{ MipGenerator::Filter::Lanczos, "Lanczos" },
+	};
+
+	std::printf("%ux%u RGBA8 sRGB, %u worker threads, best of %d\n", size, size, ThreadPool::GetInstance()->GetThreadCount(), repeatCount);
+	for (const auto& [filter, name] : filters) {
+		for (bool isParallel : { false, true }) {
+			MipGenerator::Options options;
+			options.filter = filter;
+			options.isParallel = isParallel;
+			double bestMilliseconds = 0.0;
+			for (int repeat = 0; repeat < repeatCount; ++repeat) {
+				MipGenerator::MipChain chain;
+				const auto begin = std::chrono::steady_clock::now();
+				MipGenerator::Generate(source, options, chain);
+				const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+				if (repeat == 0 || milliseconds < bestMilliseconds) {
+					bestMilliseconds = milliseconds;
+				}
+			}
+			std::printf("%-8s %-8s %8.2f ms\n", name, isParallel ? "parallel" : "serial", bestMilliseconds);
+		}
+	}
+
+	ThreadPool::GetInstance()->Finalize();
+	return 0;
+}
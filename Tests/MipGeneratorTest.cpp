@@ -0,0 +1,149 @@
+#include "TestFramework.h"
+#include "Managers/Texture/MipGenerator.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+
+using Filter = MipGenerator::Filter;
+using Format = MipGenerator::Format;
+
+} // namespace
+
+TEST_CASE(MipGenerator_BoxAveragesTwoByTwo) {
+	uint8_t pixels[4 * 4 * 4];
+	for (int i = 0; i < 64; ++i) {
+		pixels[i] = static_cast<uint8_t>(i * 4);
+	}
+	const MipGenerator::SourceImage source{ pixels, 4, 4, 16, Format::RGBA8Unorm };
+	MipGenerator::Options options;
+	options.filter = Filter::Box;
+	MipGenerator::MipChain chain;
+	CHECK(MipGenerator::Generate(source, options, chain));
+	CHECK_EQ(chain.levels.size(), 3u);
+
+	// 1段目は元の画像そのまま
+	CHECK(std::memcmp(chain.GetPixels(0), pixels, sizeof(pixels)) == 0);
+
+	// 2段目は2x2の平均（丸めの差は1まで）
+	const uint8_t* level1 = chain.GetPixels(1);
+	for (int y = 0; y < 2; ++y) {
+		for (int x = 0; x < 2; ++x) {
+			for (int channel = 0; channel < 4; ++channel) {
+				int sum = 0;
+				for (int dy = 0; dy < 2; ++dy) {
+					for (int dx = 0; dx < 2; ++dx) {
+						sum += pixels[((y * 2 + dy) * 4 + (x * 2 + dx)) * 4 + channel];
+					}
+				}
+				const int expected = static_cast<int>(sum / 4.0 + 0.5);
+				CHECK(std::abs(expected - level1[(y * 2 + x) * 4 + channel]) <= 1);
+			}
+		}
+	}
+}
+
+TEST_CASE(MipGenerator_SrgbIsAveragedInLinearSpace) {
+	// 黒と白の市松模様は線形で0.5になり、sRGBに戻すと188（ガンマのまま平均すると128になる）
+	const uint8_t pixels[2 * 2 * 4] = {
+		0, 0, 0, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 0, 0, 0, 255,
+	};
+	const MipGenerator::SourceImage source{ pixels, 2, 2, 8, Format::RGBA8UnormSrgb };
+	MipGenerator::Options options;
+	options.filter = Filter::Box;
+	MipGenerator::MipChain chain;
+	CHECK(MipGenerator::Generate(source, options, chain));
+	const uint8_t* level1 = chain.GetPixels(1);
+	for (int channel = 0; channel < 3; ++channel) {
+		CHECK(std::abs(level1[channel] - 188) <= 1);
+	}
+	// アルファは線形のまま
+	CHECK_EQ(level1[3], 255);
+
+	// 線形の形式なら128
+	const MipGenerator::SourceImage linearSource{ pixels, 2, 2, 8, Format::RGBA8Unorm };
+	CHECK(MipGenerator::Generate(linearSource, options, chain));
+	CHECK(std::abs(chain.GetPixels(1)[0] - 128) <= 1);
+}
+
+TEST_CASE(MipGenerator_ConstantImageStaysConstant) {
+	// どのフィルタ・形式・大きさでも、一色の画像は全ての段で同じ色（重みの合計が1）
+	const uint16_t halfPixel[4] = { 0x3C00, 0x3800, 0x0000, 0x4000 };	// 1, 0.5, 0, 2
+	const uint8_t bytePixel[4] = { 200, 17, 90, 128 };
+	for (Filter filter : { Filter::Box, Filter::Kaiser, Filter::Lanczos }) {
+		for (Format format : { Format::RGBA8Unorm, Format::RGBA8UnormSrgb, Format::RGBA16Float }) {
+			for (const auto& [width, height] : { std::pair<uint32_t, uint32_t>{ 37, 13 }, { 64, 64 }, { 1, 9 }, { 256, 3 } }) {
+				const size_t pixelSize = MipGenerator::GetPixelSize(format);
+				const void* pixel = pixelSize == 4 ? static_cast<const void*>(bytePixel) : static_cast<const void*>(halfPixel);
+				std::vector<uint8_t> image(static_cast<size_t>(width) * height * pixelSize);
+				for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+					std::memcpy(&image[i * pixelSize], pixel, pixelSize);
+				}
+
+				const MipGenerator::SourceImage source{ image.data(), width, height, width * pixelSize, format };
+				MipGenerator::Options options;
+				options.filter = filter;
+				options.isParallel = false;
+				MipGenerator::MipChain chain;
+				CHECK(MipGenerator::Generate(source, options, chain));
+				CHECK_EQ(chain.levels.size(), static_cast<size_t>(MipGenerator::ComputeMipLevels(width, height)));
+				CHECK_EQ(chain.levels.back().width, 1u);
+				CHECK_EQ(chain.levels.back().height, 1u);
+
+				bool isConstant = true;
+				for (size_t level = 1; level < chain.levels.size(); ++level) {
+					const uint8_t* levelPixels = chain.GetPixels(level);
+					for (uint32_t i = 0; i < chain.levels[level].width * chain.levels[level].height; ++i) {
+						isConstant = isConstant && std::memcmp(levelPixels + i * pixelSize, pixel, pixelSize) == 0;
+					}
+				}
+				CHECK(isConstant);
+			}
+		}
+	}
+}
+
+TEST_CASE(MipGenerator_ParallelMatchesSerial) {
+	// 行のまとまりを並列に処理しても、1スレッドと同じ結果になる
+	ThreadPool::GetInstance()->Initialize(4);
+	const uint32_t size = 256;
+	std::vector<uint8_t> image(static_cast<size_t>(size) * size * 4);
+	std::mt19937 random(1);
+	for (uint8_t& value : image) {
+		value = static_cast<uint8_t>(random());
+	}
+	const MipGenerator::SourceImage source{ image.data(), size, size, size * 4, Format::RGBA8UnormSrgb };
+	for (Filter filter : { Filter::Box, Filter::Kaiser, Filter::Lanczos }) {
+		MipGenerator::Options options;
+		options.filter = filter;
+		MipGenerator::MipChain parallel;
+		CHECK(MipGenerator::Generate(source, options, parallel));
+		options.isParallel = false;
+		MipGenerator::MipChain serial;
+		CHECK(MipGenerator::Generate(source, options, serial));
+		CHECK(parallel.pixels == serial.pixels);
+	}
+	ThreadPool::GetInstance()->Finalize();
+}
+
+TEST_CASE(MipGenerator_LevelLimitAndInvalidInput) {
+	uint8_t pixels[8 * 8 * 4] = {};
+	MipGenerator::SourceImage source{ pixels, 8, 8, 32, Format::RGBA8Unorm };
+	MipGenerator::Options options;
+	options.mipLevels = 2;
+	MipGenerator::MipChain chain;
+	CHECK(MipGenerator::Generate(source, options, chain));
+	CHECK_EQ(chain.levels.size(), 2u);
+	CHECK_EQ(MipGenerator::ComputeMipLevels(8, 8), 4u);
+	CHECK_EQ(MipGenerator::ComputeMipLevels(37, 13), 6u);
+
+	// 大きさ0やpixelsがnullptrは作れない
+	source.width = 0;
+	CHECK(!MipGenerator::Generate(source, options, chain));
+	source.width = 8;
+	source.pixels = nullptr;
+	CHECK(!MipGenerator::Generate(source, options, chain));
+}
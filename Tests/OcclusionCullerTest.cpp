@@ -0,0 +1,177 @@
+#include "TestFramework.h"
+#include "Culling/OcclusionCuller.h"
+#include "BaseSystem/ThreadPool/ThreadPool.h"
+#include <cmath>
+
+namespace {
+
+const float kDepthTolerance = 1.0e-4f;
+
+/// <summary>
+/// 画面上の位置と深度（OcclusionCullerと同じ変換）
+/// </summary>
+struct ScreenPoint {
+	float x, y, depth;
+};
+
+ScreenPoint Project(const Vector3& position, const Matrix4x4& m, uint32_t width, uint32_t height) {
+	const float x = position.x * m.m[0][0] + position.y * m.m[1][0] + position.z * m.m[2][0] + m.m[3][0];
+	const float y = position.x * m.m[0][1] + position.y * m.m[1][1] + position.z * m.m[2][1] + m.m[3][1];
+	const float z = position.x * m.m[0][2] + position.y * m.m[1][2] + position.z * m.m[2][2] + m.m[3][2];
+	const float w = position.x * m.m[0][3] + position.y * m.m[1][3] + position.z * m.m[2][3] + m.m[3][3];
+	return {
+		(x / w * 0.5f + 0.5f) * static_cast<float>(width),
+		(0.5f - y / w * 0.5f) * static_cast<float>(height),
+		z / w,
+	};
+}
+
+/// <summary>
+/// z=0に置いた正方形の壁（カメラはz=-10から+zを向く）
+/// </summary>
+struct WallScene {
+	static constexpr float kHalfSize = 3.0f;
+
+	Matrix4x4 viewProjection;
+	ScreenPoint topLeft, bottomRight, center;
+
+	explicit WallScene(OcclusionCuller* culler) {
+		const Vector3Transform camera{ { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -10.0f } };
+		viewProjection = MakeViewProjectionMatrix(camera, 16.0f / 9.0f);
+
+		// 前のテストのフレームを終えて統計を数え直す
+		culler->EndFrame();
+		culler->Initialize(256, 144);
+		culler->SetEnabled(true);
+		culler->BeginFrame(viewProjection);
+		const VertexData vertices[4] = {
+			{ { -kHalfSize, -kHalfSize, 0.0f, 1.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } },
+			{ { -kHalfSize, kHalfSize, 0.0f, 1.0f }, { 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } },
+			{ { kHalfSize, -kHalfSize, 0.0f, 1.0f }, { 1.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } },
+			{ { kHalfSize, kHalfSize, 0.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } },
+		};
+		const uint32_t indices[6] = { 0, 1, 2, 1, 3, 2 };
+		culler->AddOccluder(vertices, 4, indices, 6, MakeIdentity4x4());
+		culler->Rasterize();
+
+		topLeft = Project({ -kHalfSize, kHalfSize, 0.0f }, viewProjection, culler->GetWidth(), culler->GetHeight());
+		bottomRight = Project({ kHalfSize, -kHalfSize, 0.0f }, viewProjection, culler->GetWidth(), culler->GetHeight());
+		center = Project({ 0.0f, 0.0f, 0.0f }, viewProjection, culler->GetWidth(), culler->GetHeight());
+	}
+};
+
+} // namespace
+
+TEST_CASE(OcclusionCuller_OccluderCoversProjectedRect) {
+	OcclusionCuller* culler = OcclusionCuller::GetInstance();
+	const WallScene scene(culler);
+
+	// 投影した矩形の内側（端から1ピクセル離れたところ）は壁の深度、外側は奥（1）のまま
+	uint32_t insideCount = 0;
+	uint32_t outsideCount = 0;
+	for (uint32_t y = 0; y < culler->GetHeight(); ++y) {
+		for (uint32_t x = 0; x < culler->GetWidth(); ++x) {
+			const float px = static_cast<float>(x) + 0.5f;
+			const float py = static_cast<float>(y) + 0.5f;
+			const float depth = culler->GetDepth(x, y);
+			if (px > scene.topLeft.x + 1.0f && px < scene.bottomRight.x - 1.0f &&
+				py > scene.topLeft.y + 1.0f && py < scene.bottomRight.y - 1.0f) {
+				CHECK(std::fabs(depth - scene.center.depth) < kDepthTolerance);
+				++insideCount;
+			} else if (px < scene.topLeft.x - 1.0f || px > scene.bottomRight.x + 1.0f ||
+				py < scene.topLeft.y - 1.0f || py > scene.bottomRight.y + 1.0f) {
+				CHECK_EQ(depth, 1.0f);
+				++outsideCount;
+			}
+		}
+	}
+	CHECK(insideCount > 0);
+	CHECK(outsideCount > 0);
+}
+
+TEST_CASE(OcclusionCuller_TileMaxDepth) {
+	OcclusionCuller* culler = OcclusionCuller::GetInstance();
+	const WallScene scene(culler);
+
+	// 全て壁に覆われたタイルは壁の深度、一部でも覆われていないタイルは奥（1）
+	uint32_t coveredTileCount = 0;
+	for (uint32_t ty = 0; ty < culler->GetTileCountY(); ++ty) {
+		for (uint32_t tx = 0; tx < culler->GetTileCountX(); ++tx) {
+			const float x0 = static_cast<float>(tx * OcclusionCuller::kTileWidth);
+			const float y0 = static_cast<float>(ty * OcclusionCuller::kTileHeight);
+			const float x1 = x0 + static_cast<float>(OcclusionCuller::kTileWidth);
+			const float y1 = y0 + static_cast<float>(OcclusionCuller::kTileHeight);
+			const bool isCovered = x0 > scene.topLeft.x + 1.0f && x1 < scene.bottomRight.x - 1.0f &&
+				y0 > scene.topLeft.y + 1.0f && y1 < scene.bottomRight.y - 1.0f;
+			const bool isPartlyUncovered = x0 < scene.topLeft.x - 1.0f || x1 > scene.bottomRight.x + 1.0f ||
+				y0 < scene.topLeft.y - 1.0f || y1 > scene.bottomRight.y + 1.0f;
+			const float tileMaxDepth = culler->GetTileMaxDepth(tx, ty);
+			if (isCovered) {
+				CHECK(std::fabs(tileMaxDepth - scene.center.depth) < kDepthTolerance);
+				++coveredTileCount;
+			} else if (isPartlyUncovered) {
+				CHECK_EQ(tileMaxDepth, 1.0f);
+			}
+		}
+	}
+	CHECK(coveredTileCount > 0);
+}
+
+TEST_CASE(OcclusionCuller_VisibilityVerdicts) {
+	OcclusionCuller* culler = OcclusionCuller::GetInstance();
+	const WallScene scene(culler);
+	CHECK(culler->IsActive());
+
+	// 壁の真後ろに収まる箱は隠れている
+	CHECK(!culler->IsVisible({ -0.5f, -0.5f, 3.0f }, { 0.5f, 0.5f, 4.0f }));
+	// 壁の手前は見える
+	CHECK(culler->IsVisible({ -0.5f, -0.5f, -3.0f }, { 0.5f, 0.5f, -2.0f }));
+	// 壁より大きくはみ出す箱は見える
+	CHECK(culler->IsVisible({ -5.0f, -5.0f, 3.0f }, { 5.0f, 5.0f, 4.0f }));
+	// 壁の横にずれた箱は見える
+	CHECK(culler->IsVisible({ 3.5f, -0.5f, 3.0f }, { 4.5f, 0.5f, 4.0f }));
+	// 画面外は見えない
+	CHECK(!culler->IsVisible({ 100.0f, 100.0f, 3.0f }, { 101.0f, 101.0f, 4.0f }));
+	// 近クリップ面をまたぐものは判定できないので見える
+	CHECK(culler->IsVisible({ -1.0f, -1.0f, -20.0f }, { 1.0f, 1.0f, 0.0f }));
+
+	// 統計は判定した数と隠れていた数を数える
+	culler->EndFrame();
+	const OcclusionCuller::Statistics& statistics = culler->GetLastFrameStatistics();
+	CHECK_EQ(statistics.occluderTriangleCount, 2u);
+	CHECK_EQ(statistics.testedCount, 6u);
+	CHECK_EQ(statistics.culledCount, 2u);
+
+	// フレームが終わった後と、無効の時は常に見える
+	CHECK(culler->IsVisible({ -0.5f, -0.5f, 3.0f }, { 0.5f, 0.5f, 4.0f }));
+	culler->SetEnabled(false);
+	culler->BeginFrame(scene.viewProjection);
+	CHECK(culler->IsVisible({ -0.5f, -0.5f, 3.0f }, { 0.5f, 0.5f, 4.0f }));
+	culler->SetEnabled(true);
+}
+
+TEST_CASE(OcclusionCuller_ParallelRasterizeIsDeterministic) {
+	// 1スレッドで描いた深度バッファと、スレッドプールでタイルを並列に描いたものが同じになる
+	OcclusionCuller* culler = OcclusionCuller::GetInstance();
+	const WallScene serialScene(culler);
+	std::vector<float> serialDepth;
+	for (uint32_t y = 0; y < culler->GetHeight(); ++y) {
+		for (uint32_t x = 0; x < culler->GetWidth(); ++x) {
+			serialDepth.push_back(culler->GetDepth(x, y));
+		}
+	}
+
+	ThreadPool::GetInstance()->Initialize(4);
+	for (int repeat = 0; repeat < 4; ++repeat) {
+		const WallScene parallelScene(culler);
+		size_t index = 0;
+		bool isSame = true;
+		for (uint32_t y = 0; y < culler->GetHeight(); ++y) {
+			for (uint32_t x = 0; x < culler->GetWidth(); ++x) {
+				isSame = isSame && culler->GetDepth(x, y) == serialDepth[index++];
+			}
+		}
+		CHECK(isSame);
+	}
+	ThreadPool::GetInstance()->Finalize();
+}
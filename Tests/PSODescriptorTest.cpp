@@ -0,0 +1,114 @@
+#include "TestFramework.h"
+#include "BaseSystem/DirectXCommon/PSOFactory/PSODescriptor.h"
+#include <set>
+
+namespace {
+
+/// <summary>
+/// エンジンが実際に作るPSOの設定（DirectXCommon・SpriteBatch・ポストエフェクトなどと同じ組み合わせ）
+/// </summary>
+std::vector<PSODescriptor> CreateEnginePermutations() {
+	std::vector<PSODescriptor> descriptors = {
+		PSODescriptor::Create3D(),
+		PSODescriptor::Create3D().SetPixelShader(L"resources/Shader/Object3d/Object3dBindless.PS.hlsl"),
+		PSODescriptor::CreateSprite(),
+		PSODescriptor::CreateLine(),
+		PSODescriptor::CreatePostEffect(),
+		PSODescriptor::CreatePostEffectColorOnly()
+			.SetPixelShader(L"resources/Shader/FullscreenTriangle/FullscreenTriangle.PS.hlsl")
+			.SetBlendMode(BlendMode::AlphaBlend),
+		PSODescriptor::CreatePostEffectWithDepth().SetPixelShader(L"resources/Shader/DepthFog/DepthFog.PS.hlsl"),
+		PSODescriptor::CreatePostEffectWithDepth().SetPixelShader(L"resources/Shader/DepthOfField/DepthOfField.PS.hlsl"),
+		PSODescriptor::CreatePostEffectColorOnly().SetPixelShader(L"resources/Shader/LineGlitch/LineGlitch.PS.hlsl"),
+		PSODescriptor::CreatePostEffectColorOnly().SetPixelShader(L"resources/Shader/Vignette/Vignette.PS.hlsl"),
+		PSODescriptor::CreatePostEffectColorOnly().SetPixelShader(L"resources/Shader/RGBShift/RGBShift.PS.hlsl"),
+		PSODescriptor::CreatePostEffectColorOnly().SetPixelShader(L"resources/Shader/Grayscale/Grayscale.PS.hlsl"),
+	};
+	for (BlendMode blendMode : { BlendMode::None, BlendMode::AlphaBlend, BlendMode::Add, BlendMode::Subtract, BlendMode::Multiply }) {
+		descriptors.push_back(PSODescriptor::CreateSpriteBatch().SetBlendMode(blendMode));
+	}
+	return descriptors;
+}
+
+} // namespace
+
+TEST_CASE(PSODescriptor_SameSettingsHaveSameHash) {
+	const std::vector<PSODescriptor> first = CreateEnginePermutations();
+	const std::vector<PSODescriptor> second = CreateEnginePermutations();
+	for (size_t i = 0; i < first.size(); ++i) {
+		CHECK(first[i] == second[i]);
+		CHECK_EQ(first[i].ComputeHash(), second[i].ComputeHash());
+		// 何度計算しても同じ値（ディスクキャッシュのキーに使う）
+		CHECK_EQ(first[i].ComputeHash(), first[i].ComputeHash());
+	}
+}
+
+TEST_CASE(PSODescriptor_EnginePermutationsDoNotCollide) {
+	const std::vector<PSODescriptor> descriptors = CreateEnginePermutations();
+	std::set<uint64_t> hashes;
+	for (size_t i = 0; i < descriptors.size(); ++i) {
+		hashes.insert(descriptors[i].ComputeHash());
+		for (size_t j = i + 1; j < descriptors.size(); ++j) {
+			CHECK(!(descriptors[i] == descriptors[j]));
+		}
+	}
+	CHECK_EQ(hashes.size(), descriptors.size());
+}
+
+TEST_CASE(PSODescriptor_PostEffectPresetsDifferOnlyByPixelShader) {
+	// 深度ありとカラーのみのプリセットは、ルートシグネチャが違うだけで設定は同じ
+	CHECK(PSODescriptor::CreatePostEffectWithDepth() == PSODescriptor::CreatePostEffectColorOnly());
+	CHECK_EQ(PSODescriptor::CreatePostEffectWithDepth().ComputeHash(), PSODescriptor::CreatePostEffectColorOnly().ComputeHash());
+
+	PSODescriptor depthFog = PSODescriptor::CreatePostEffectWithDepth().SetPixelShader(L"resources/Shader/DepthFog/DepthFog.PS.hlsl");
+	PSODescriptor depthOfField = PSODescriptor::CreatePostEffectWithDepth().SetPixelShader(L"resources/Shader/DepthOfField/DepthOfField.PS.hlsl");
+	CHECK(!(depthFog == depthOfField));
+	CHECK(depthFog.ComputeHash() != depthOfField.ComputeHash());
+
+	// エントリーポイントだけが違うものも区別する
+	PSODescriptor otherEntry = PSODescriptor::CreatePostEffectWithDepth().SetPixelShader(L"resources/Shader/DepthFog/DepthFog.PS.hlsl", L"mainFog");
+	CHECK(!(depthFog == otherEntry));
+	CHECK(depthFog.ComputeHash() != otherEntry.ComputeHash());
+}
+
+TEST_CASE(PSODescriptor_EachSettingChangesHashAndEquality) {
+	const PSODescriptor base = PSODescriptor::Create3D();
+	std::vector<PSODescriptor> variants = {
+		PSODescriptor::Create3D().SetVertexShader(L"resources/Shader/Object3d/Other.VS.hlsl"),
+		PSODescriptor::Create3D().SetBlendMode(BlendMode::Add),
+		PSODescriptor::Create3D().SetCullMode(CullMode::Front),
+		PSODescriptor::Create3D().EnableDepth(false),
+		PSODescriptor::Create3D().EnableDepth(true, D3D12_COMPARISON_FUNC_LESS),
+		PSODescriptor::Create3D().EnableDepthWrite(false),
+		PSODescriptor::Create3D().SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE),
+		PSODescriptor::Create3D().SetRenderTargetFormat(DXGI_FORMAT_R16G16B16A16_FLOAT),
+		PSODescriptor::Create3D().SetDepthStencilFormat(DXGI_FORMAT_UNKNOWN),
+		PSODescriptor::Create3D().ClearInputElements(),
+		PSODescriptor::Create3D().AddInputElement({ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT }),
+		PSODescriptor::Create3D().ClearInputElements()
+			.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT })
+			.AddInputElement({ "TEXCOORD", 1, DXGI_FORMAT_R32G32_FLOAT })
+			.AddInputElement({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT }),
+		PSODescriptor::Create3D().ClearInputElements()
+			.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT })
+			.AddInputElement({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT })
+			.AddInputElement({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1 }),
+		PSODescriptor::Create3D().ClearInputElements()
+			.AddInputElement({ "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT })
+			.AddInputElement({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT })
+			.AddInputElement({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+				D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 }),
+	};
+	for (const PSODescriptor& variant : variants) {
+		CHECK(!(variant == base));
+		CHECK(variant.ComputeHash() != base.ComputeHash());
+	}
+}
+
+TEST_CASE(PSODescriptor_StringBoundariesAreHashed) {
+	// 文字列の区切りが変わっただけのもの（連結すると同じになる）を区別する
+	PSODescriptor a = PSODescriptor::CreatePostEffect().SetPixelShader(L"ab", L"c");
+	PSODescriptor b = PSODescriptor::CreatePostEffect().SetPixelShader(L"a", L"bc");
+	CHECK(!(a == b));
+	CHECK(a.ComputeHash() != b.ComputeHash());
+}
@@ -0,0 +1,170 @@
+#include "TestFramework.h"
+#include "BaseSystem/DirectXCommon/GraphicsStateCache.h"
+#include "BaseSystem/DirectXCommon/RenderBackend/RecordingRenderCommandList.h"
+
+namespace {
+
+using CommandType = RecordingRenderCommandList::CommandType;
+
+// 値として比べるだけなので、指す先はなくてよい
+ID3D12RootSignature* const kObjectRootSignature = reinterpret_cast<ID3D12RootSignature*>(0x100);
+ID3D12PipelineState* const kObjectPipelineState = reinterpret_cast<ID3D12PipelineState*>(0x200);
+ID3D12RootSignature* const kLineRootSignature = reinterpret_cast<ID3D12RootSignature*>(0x300);
+ID3D12PipelineState* const kLinePipelineState = reinterpret_cast<ID3D12PipelineState*>(0x400);
+
+const D3D12_GPU_VIRTUAL_ADDRESS kLightAddress = 0x10000;
+const D3D12_GPU_VIRTUAL_ADDRESS kMaterialAddress = 0x20000;
+const D3D12_GPU_DESCRIPTOR_HANDLE kTextureHandle{ 0x30000 };
+const D3D12_VERTEX_BUFFER_VIEW kMeshVertexBuffer{ 0x40000, 24 * 32, 32 };
+const D3D12_INDEX_BUFFER_VIEW kMeshIndexBuffer{ 0x50000, 36 * 4, DXGI_FORMAT_R32_UINT };
+const D3D12_VERTEX_BUFFER_VIEW kLineVertexBuffer{ 0x60000, 1024 * 32, 32 };
+const UINT kMeshIndexCount = 36;
+
+/// <summary>
+/// GameObject::Draw（バインドレスでない時）と同じ順番でモデルを1つ描く
+/// </summary>
+void DrawObject(GraphicsStateCache& stateCache, D3D12_GPU_VIRTUAL_ADDRESS transformAddress) {
+	stateCache.SetGraphicsRootSignature(kObjectRootSignature);
+	stateCache.SetPipelineState(kObjectPipelineState);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	stateCache.SetGraphicsRootConstantBufferView(3, kLightAddress);
+	stateCache.SetGraphicsRootConstantBufferView(1, transformAddress);
+	stateCache.SetGraphicsRootConstantBufferView(0, kMaterialAddress);
+	stateCache.SetGraphicsRootDescriptorTable(2, kTextureHandle);
+	stateCache.IASetVertexBuffers(0, 1, &kMeshVertexBuffer);
+	stateCache.IASetIndexBuffer(&kMeshIndexBuffer);
+	stateCache.DrawIndexedInstanced(kMeshIndexCount, 1, 0, 0, 0);
+}
+
+/// <summary>
+/// LineRenderer::Drawと同じ順番で線分をまとめて描く
+/// </summary>
+void DrawLines(GraphicsStateCache& stateCache, UINT vertexCount) {
+	stateCache.SetGraphicsRootSignature(kLineRootSignature);
+	stateCache.SetPipelineState(kLinePipelineState);
+	stateCache.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+	stateCache.IASetVertexBuffers(0, 1, &kLineVertexBuffer);
+	stateCache.SetGraphicsRootConstantBufferView(0, 0x70000);
+	stateCache.DrawInstanced(vertexCount, 1, 0, 0);
+}
+
+/// <summary>
+/// 同じモデルを10個描いて線分を描き、最後にもう1つモデルを描く1フレーム
+/// </summary>
+void DrawFrame(GraphicsStateCache& stateCache) {
+	for (uint32_t i = 0; i < 10; ++i) {
+		DrawObject(stateCache, 0x80000 + i * 0x100);
+	}
+	DrawLines(stateCache, 24);
+	DrawObject(stateCache, 0x90000);
+}
+
+/// <summary>
+/// 記録した中から指定した種類のコマンドを数える
+/// </summary>
+uint32_t CountCommands(const RecordingRenderCommandList& recorder, CommandType type) {
+	uint32_t count = 0;
+	for (const RecordingRenderCommandList::Command& command : recorder.GetCommands()) {
+		if (command.type == type) {
+			++count;
+		}
+	}
+	return count;
+}
+
+} // namespace
+
+TEST_CASE(RecordingRenderCommandList_CountsFrameThroughStateCache) {
+	// 転送先なし（ヌルレンダラー）で1フレームを記録する
+	RecordingRenderCommandList recorder;
+	GraphicsStateCache stateCache;
+	stateCache.SetCommandList(&recorder);
+	DrawFrame(stateCache);
+
+	// 1つ目のモデルは10コマンド、同じモデルの続きはトランスフォームと描画だけ
+	// 線分は6コマンド、その後のモデルは同じインデックスバッファ以外を設定し直して9コマンド
+	const RecordingRenderCommandList::Statistics& statistics = recorder.GetStatistics();
+	CHECK_EQ(statistics.commandCount, 10u + 9u * 2u + 6u + 9u);
+	CHECK_EQ(statistics.drawCount, 12u);
+	CHECK_EQ(statistics.vertexCount, 11u * kMeshIndexCount + 24u);
+	CHECK_EQ(statistics.pipelineChangeCount, 6u);
+	CHECK_EQ(recorder.GetCommands().size(), static_cast<size_t>(statistics.commandCount));
+	CHECK_EQ(CountCommands(recorder, CommandType::DrawIndexedInstanced), 11u);
+	CHECK_EQ(CountCommands(recorder, CommandType::DrawInstanced), 1u);
+	CHECK_EQ(CountCommands(recorder, CommandType::IASetIndexBuffer), 1u);
+	CHECK_EQ(CountCommands(recorder, CommandType::IASetVertexBuffers), 3u);
+	CHECK_EQ(CountCommands(recorder, CommandType::SetGraphicsRootDescriptorTable), 2u);
+	CHECK_EQ(CountCommands(recorder, CommandType::SetGraphicsRootConstantBufferView), 3u + 9u + 1u + 3u);
+
+	// 省いた分はステートキャッシュの統計に入る（描画は数えない）
+	CHECK_EQ(stateCache.GetStatistics().issuedCount, statistics.commandCount - statistics.drawCount);
+	CHECK_EQ(stateCache.GetStatistics().elidedCount, 9u * 8u + 1u);
+
+	// 記録した引数は呼び出した値のまま
+	const RecordingRenderCommandList::Command& first = recorder.GetCommands().front();
+	CHECK(first.type == CommandType::SetGraphicsRootSignature);
+	CHECK_EQ(first.args[0], reinterpret_cast<uint64_t>(kObjectRootSignature));
+	const RecordingRenderCommandList::Command& draw = recorder.GetCommands()[9];
+	CHECK(draw.type == CommandType::DrawIndexedInstanced);
+	CHECK_EQ(draw.args[0], static_cast<uint64_t>(kMeshIndexCount));
+	CHECK_EQ(draw.args[1], 1u);
+}
+
+TEST_CASE(RecordingRenderCommandList_ClearStartsNextFrame) {
+	RecordingRenderCommandList recorder;
+	GraphicsStateCache stateCache;
+	stateCache.SetCommandList(&recorder);
+	DrawFrame(stateCache);
+	const uint32_t firstFrameCount = recorder.GetStatistics().commandCount;
+
+	// フレームの頭では記録もステートも捨てるので、次のフレームも同じコマンド列になる
+	recorder.Clear();
+	CHECK(recorder.GetCommands().empty());
+	CHECK_EQ(recorder.GetStatistics().drawCount, 0u);
+	stateCache.Invalidate();
+	DrawFrame(stateCache);
+	CHECK_EQ(recorder.GetStatistics().commandCount, firstFrameCount);
+	CHECK_EQ(recorder.GetStatistics().drawCount, 12u);
+
+	// ステートを捨てなければ、前のフレームの最後の設定が残っている分だけ減る
+	recorder.Clear();
+	DrawFrame(stateCache);
+	CHECK(recorder.GetStatistics().commandCount < firstFrameCount);
+	CHECK_EQ(recorder.GetStatistics().drawCount, 12u);
+
+	// ログに出しても記録は変わらない
+	const uint32_t commandCount = recorder.GetStatistics().commandCount;
+	recorder.Dump();
+	CHECK_EQ(recorder.GetStatistics().commandCount, commandCount);
+}
+
+TEST_CASE(RecordingRenderCommandList_ForwardsToTarget) {
+	// 記録しつつ渡す先にも同じコマンドが同じ順番で届く
+	RecordingRenderCommandList target;
+	RecordingRenderCommandList recorder;
+	recorder.SetForwardTarget(&target);
+	GraphicsStateCache stateCache;
+	stateCache.SetCommandList(&recorder);
+	DrawFrame(stateCache);
+
+	CHECK_EQ(target.GetStatistics().commandCount, recorder.GetStatistics().commandCount);
+	CHECK_EQ(target.GetStatistics().drawCount, recorder.GetStatistics().drawCount);
+	CHECK_EQ(target.GetStatistics().vertexCount, recorder.GetStatistics().vertexCount);
+	bool isSame = target.GetCommands().size() == recorder.GetCommands().size();
+	for (size_t i = 0; isSame && i < recorder.GetCommands().size(); ++i) {
+		const RecordingRenderCommandList::Command& a = recorder.GetCommands()[i];
+		const RecordingRenderCommandList::Command& b = target.GetCommands()[i];
+		isSame = a.type == b.type;
+		for (int arg = 0; arg < 5; ++arg) {
+			isSame = isSame && a.args[arg] == b.args[arg];
+		}
+	}
+	CHECK(isSame);
+
+	// 渡す先を外すと記録だけになる
+	recorder.SetForwardTarget(nullptr);
+	recorder.DrawInstanced(3, 2, 0, 0);
+	CHECK_EQ(recorder.GetStatistics().drawCount, 13u);
+	CHECK_EQ(target.GetStatistics().drawCount, 12u);
+	CHECK_EQ(recorder.GetStatistics().vertexCount, 11u * kMeshIndexCount + 24u + 6u);
+}
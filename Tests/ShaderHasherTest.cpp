@@ -0,0 +1,125 @@
+#include "TestFramework.h"
+#include "BaseSystem/DirectXCommon/ShaderCache/ShaderHasher.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+/// <summary>
+/// テスト用のシェーダーのフォルダ（テストごとに作り直す）
+/// </summary>
+class ShaderTree {
+public:
+	ShaderTree() {
+		root_ = std::filesystem::temp_directory_path() / "CG2_2025_ShaderHasherTest";
+		std::filesystem::remove_all(root_);
+		std::filesystem::create_directories(root_ / "Nested");
+
+		// コメントの中のincludeと見つからないincludeを含むメインのファイル
+		Write("Main.hlsl",
+			"#include \"Common.hlsli\"\n"
+			"// #include \"LineComment.hlsli\"\n"
+			"/* #include \"BlockComment.hlsli\"\n"
+			"#include \"BlockComment2.hlsli\" */\n"
+			"  #  include \"Missing.hlsli\"\n"
+			"float4 main() : SV_TARGET { return kColor; }\n");
+		Write("Common.hlsli",
+			"#include \"Nested/Inner.hlsli\"\n"
+			"#include \"Nested/Inner.hlsli\"\n");
+		Write("Nested/Inner.hlsli", "static const float4 kColor = float4(1, 0, 0, 1);\n");
+	}
+
+	~ShaderTree() {
+		std::error_code errorCode;
+		std::filesystem::remove_all(root_, errorCode);
+	}
+
+	void Write(const std::string& name, const std::string& text) {
+		std::ofstream stream(root_ / name, std::ios::binary | std::ios::trunc);
+		stream << text;
+	}
+
+	ShaderHasher::Key ComputeKey(const std::wstring& entryPoint = L"main", const std::vector<std::wstring>& arguments = {}) const {
+		return ShaderHasher::ComputeKey(root_ / "Main.hlsl", entryPoint, L"ps_6_0", arguments);
+	}
+
+	const std::filesystem::path& GetRoot() const { return root_; }
+
+private:
+	std::filesystem::path root_;
+};
+
+} // namespace
+
+TEST_CASE(ShaderHasher_KeyIsDeterministic) {
+	ShaderTree tree;
+	const ShaderHasher::Key key = tree.ComputeKey();
+	CHECK(key.isValid);
+	CHECK_EQ(tree.ComputeKey().hash, key.hash);
+
+	// メイン・include・その中のincludeの順に1回ずつ（2回includeしても1回だけ積む）
+	CHECK_EQ(key.dependencies.size(), 3u);
+	CHECK(key.dependencies[0] == (tree.GetRoot() / "Main.hlsl").lexically_normal());
+	CHECK(key.dependencies[1] == (tree.GetRoot() / "Common.hlsli").lexically_normal());
+	CHECK(key.dependencies[2] == (tree.GetRoot() / "Nested/Inner.hlsli").lexically_normal());
+
+	// コンパイルの設定が違えば別のキー
+	CHECK(tree.ComputeKey(L"mainPS").hash != key.hash);
+	CHECK(tree.ComputeKey(L"main", { L"-Zi" }).hash != key.hash);
+
+	// 読めないファイルは無効
+	const ShaderHasher::Key missingKey = ShaderHasher::ComputeKey(tree.GetRoot() / "None.hlsl", L"main", L"ps_6_0", {});
+	CHECK(!missingKey.isValid);
+}
+
+TEST_CASE(ShaderHasher_NestedIncludeChangesKey) {
+	ShaderTree tree;
+	const uint64_t hash = tree.ComputeKey().hash;
+
+	// 2段目のincludeを書き換えるとキーが変わり、戻すと元のキーになる
+	tree.Write("Nested/Inner.hlsli", "static const float4 kColor = float4(0, 1, 0, 1);\n");
+	const uint64_t editedHash = tree.ComputeKey().hash;
+	CHECK(editedHash != hash);
+	tree.Write("Nested/Inner.hlsli", "static const float4 kColor = float4(1, 0, 0, 1);\n");
+	CHECK_EQ(tree.ComputeKey().hash, hash);
+
+	// 見つからなかったincludeを後から作ってもキーが変わる
+	tree.Write("Missing.hlsli", "\n");
+	const ShaderHasher::Key addedKey = tree.ComputeKey();
+	CHECK(addedKey.hash != hash);
+	CHECK(addedKey.missingIncludes.empty());
+	CHECK_EQ(addedKey.dependencies.size(), 4u);
+}
+
+TEST_CASE(ShaderHasher_CommentedIncludesAreIgnored) {
+	ShaderTree tree;
+	const ShaderHasher::Key key = tree.ComputeKey();
+
+	// コメントの中のincludeは探さず、見つからないincludeだけを報告する
+	CHECK_EQ(key.missingIncludes.size(), 1u);
+	CHECK(std::find(key.missingIncludes.begin(), key.missingIncludes.end(), "Missing.hlsli") != key.missingIncludes.end());
+
+	const std::vector<std::string> includes = ShaderHasher::ParseIncludes(
+		"#include \"A.hlsli\" // #include \"B.hlsli\"\n"
+		"/* #include \"C.hlsli\" */ #include \"D.hlsli\"\n"
+		"/*\n#include \"E.hlsli\"\n*/\n"
+		"\t#include <F.hlsli>\n"
+		"#define INCLUDE \"G.hlsli\"\n"
+		"#include \"Unterminated.hlsli\n");
+	CHECK((includes == std::vector<std::string>{ "A.hlsli", "D.hlsli", "F.hlsli" }));
+
+	// コメントの中で指しているファイルを作っても、依存には入らずキーも変わらない
+	tree.Write("LineComment.hlsli", "\n");
+	tree.Write("BlockComment.hlsli", "\n");
+	const ShaderHasher::Key commentedKey = tree.ComputeKey();
+	CHECK_EQ(commentedKey.dependencies.size(), 3u);
+	CHECK_EQ(commentedKey.hash, key.hash);
+}
+
+TEST_CASE(ShaderHasher_ResolveIncludeRelativeToIncluder) {
+	ShaderTree tree;
+	std::filesystem::path resolved;
+	CHECK(ShaderHasher::ResolveInclude("Inner.hlsli", tree.GetRoot() / "Nested", resolved));
+	CHECK(resolved == (tree.GetRoot() / "Nested/Inner.hlsli").lexically_normal());
+	CHECK(!ShaderHasher::ResolveInclude("Inner.hlsli", tree.GetRoot(), resolved));
+}
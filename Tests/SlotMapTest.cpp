@@ -0,0 +1,89 @@
+#include "TestFramework.h"
+#include "BaseSystem/Container/SlotMap.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+
+TEST_CASE(SlotMap_InsertEraseReuse) {
+	SlotMap<std::string> slotMap;
+	const SlotMap<std::string>::Handle a = slotMap.Insert("a");
+	const SlotMap<std::string>::Handle b = slotMap.Insert("b");
+	const SlotMap<std::string>::Handle c = slotMap.Insert("c");
+	CHECK_EQ(slotMap.GetSize(), 3u);
+	CHECK(*slotMap.Get(a) == "a");
+	CHECK(*slotMap.Get(b) == "b");
+	CHECK(*slotMap.Get(c) == "c");
+
+	// 削除したスロットを使い回し、世代が進む
+	CHECK(slotMap.Erase(b));
+	CHECK(!slotMap.Erase(b));
+	CHECK_EQ(slotMap.GetSize(), 2u);
+	const SlotMap<std::string>::Handle d = slotMap.Insert("d");
+	CHECK_EQ(d.index, b.index);
+	CHECK(d.generation != b.generation);
+	CHECK(d != b);
+	CHECK(*slotMap.Get(d) == "d");
+
+	// 他のハンドルは削除や使い回しの影響を受けない
+	CHECK(*slotMap.Get(a) == "a");
+	CHECK(*slotMap.Get(c) == "c");
+}
+
+TEST_CASE(SlotMap_StaleHandleIsRejected) {
+	SlotMap<std::unique_ptr<int>> slotMap;
+	const SlotMap<std::unique_ptr<int>>::Handle handle = slotMap.Insert(std::make_unique<int>(1));
+	CHECK(slotMap.Contains(handle));
+	CHECK(!slotMap.IsStale(handle));
+
+	// 削除した後は同じスロットに別の要素が入っても、古いハンドルからは引けない
+	slotMap.Erase(handle);
+	CHECK(slotMap.Get(handle) == nullptr);
+	CHECK(slotMap.IsStale(handle));
+	const SlotMap<std::unique_ptr<int>>::Handle reused = slotMap.Insert(std::make_unique<int>(2));
+	CHECK_EQ(reused.index, handle.index);
+	CHECK(slotMap.Get(handle) == nullptr);
+	CHECK(slotMap.IsStale(handle));
+	CHECK_EQ(**slotMap.Get(reused), 2);
+
+	// 既定値のハンドルと範囲外のハンドルは、削除済みではなく無効として扱う
+	const SlotMap<std::unique_ptr<int>>::Handle invalid;
+	CHECK(!invalid.IsValid());
+	CHECK(slotMap.Get(invalid) == nullptr);
+	CHECK(!slotMap.IsStale(invalid));
+	CHECK(slotMap.Get({ 100, 1 }) == nullptr);
+
+	// Clearで全てのハンドルが古いものになる
+	slotMap.Clear();
+	CHECK(slotMap.IsEmpty());
+	CHECK(slotMap.Get(reused) == nullptr);
+	CHECK(slotMap.IsStale(reused));
+}
+
+TEST_CASE(SlotMap_DenseIterationAfterErase) {
+	SlotMap<int> slotMap;
+	std::vector<SlotMap<int>::Handle> handles;
+	for (int i = 0; i < 10; ++i) {
+		handles.push_back(slotMap.Insert(i));
+	}
+
+	// 先頭・途中・末尾を消しても、残りは隙間なく詰まっている
+	for (int i : { 0, 4, 5, 9 }) {
+		CHECK(slotMap.Erase(handles[i]));
+	}
+	CHECK_EQ(slotMap.GetSize(), 6u);
+	std::vector<int> values(slotMap.begin(), slotMap.end());
+	std::sort(values.begin(), values.end());
+	CHECK((values == std::vector<int>{ 1, 2, 3, 6, 7, 8 }));
+
+	// 詰めた配列の位置から引いたハンドルは、その位置の要素を指す
+	for (size_t i = 0; i < slotMap.GetSize(); ++i) {
+		const SlotMap<int>::Handle handle = slotMap.GetHandle(i);
+		CHECK(slotMap.Get(handle) == &*(slotMap.begin() + i));
+		CHECK(handle == handles[*slotMap.Get(handle)]);
+	}
+
+	// 動かした要素も元のハンドルから引ける
+	for (int i : { 1, 2, 3, 6, 7, 8 }) {
+		CHECK_EQ(*slotMap.Get(handles[i]), i);
+	}
+}
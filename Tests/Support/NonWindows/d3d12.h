@@ -0,0 +1,213 @@
+#pragma once
+// Windows以外でテストをビルドするための最小限のd3d12.h
+// GPUを使わないコード（PSODescriptorなど）が参照する型と定数だけを、Windows SDKと同じ値で定義する
+// Windowsでは使わない（CMakeLists.txtでWindows以外の時だけインクルードパスに入れる）
+#include <cstdint>
+
+typedef int BOOL;
+typedef int INT;
+typedef unsigned int UINT;
+typedef unsigned char UINT8;
+typedef float FLOAT;
+typedef const char* LPCSTR;
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+enum DXGI_FORMAT {
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+	DXGI_FORMAT_R32G32B32_FLOAT = 6,
+	DXGI_FORMAT_R16G16B16A16_FLOAT = 10,
+	DXGI_FORMAT_R32G32_FLOAT = 16,
+	DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+	DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29,
+	DXGI_FORMAT_R32_FLOAT = 41,
+	DXGI_FORMAT_R32_UINT = 42,
+	DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+	DXGI_FORMAT_R24_UNORM_X8_TYPELESS = 46,
+};
+
+#define D3D12_APPEND_ALIGNED_ELEMENT (0xffffffff)
+#define D3D12_DEFAULT_DEPTH_BIAS (0)
+#define D3D12_DEFAULT_DEPTH_BIAS_CLAMP (0.0f)
+#define D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS (0.0f)
+#define D3D12_DEFAULT_STENCIL_READ_MASK (0xff)
+#define D3D12_DEFAULT_STENCIL_WRITE_MASK (0xff)
+
+enum D3D12_INPUT_CLASSIFICATION {
+	D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA = 0,
+	D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA = 1,
+};
+
+enum D3D12_FILL_MODE {
+	D3D12_FILL_MODE_WIREFRAME = 2,
+	D3D12_FILL_MODE_SOLID = 3,
+};
+
+enum D3D12_CULL_MODE {
+	D3D12_CULL_MODE_NONE = 1,
+	D3D12_CULL_MODE_FRONT = 2,
+	D3D12_CULL_MODE_BACK = 3,
+};
+
+enum D3D12_CONSERVATIVE_RASTERIZATION_MODE {
+	D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF = 0,
+	D3D12_CONSERVATIVE_RASTERIZATION_MODE_ON = 1,
+};
+
+enum D3D12_COMPARISON_FUNC {
+	D3D12_COMPARISON_FUNC_NEVER = 1,
+	D3D12_COMPARISON_FUNC_LESS = 2,
+	D3D12_COMPARISON_FUNC_EQUAL = 3,
+	D3D12_COMPARISON_FUNC_LESS_EQUAL = 4,
+	D3D12_COMPARISON_FUNC_GREATER = 5,
+	D3D12_COMPARISON_FUNC_NOT_EQUAL = 6,
+	D3D12_COMPARISON_FUNC_GREATER_EQUAL = 7,
+	D3D12_COMPARISON_FUNC_ALWAYS = 8,
+};
+
+enum D3D12_PRIMITIVE_TOPOLOGY_TYPE {
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE_UNDEFINED = 0,
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT = 1,
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE = 2,
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE = 3,
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH = 4,
+};
+
+enum D3D12_BLEND {
+	D3D12_BLEND_ZERO = 1,
+	D3D12_BLEND_ONE = 2,
+	D3D12_BLEND_SRC_COLOR = 3,
+	D3D12_BLEND_INV_SRC_COLOR = 4,
+	D3D12_BLEND_SRC_ALPHA = 5,
+	D3D12_BLEND_INV_SRC_ALPHA = 6,
+	D3D12_BLEND_DEST_ALPHA = 7,
+	D3D12_BLEND_INV_DEST_ALPHA = 8,
+	D3D12_BLEND_DEST_COLOR = 9,
+	D3D12_BLEND_INV_DEST_COLOR = 10,
+};
+
+enum D3D12_BLEND_OP {
+	D3D12_BLEND_OP_ADD = 1,
+	D3D12_BLEND_OP_SUBTRACT = 2,
+	D3D12_BLEND_OP_REV_SUBTRACT = 3,
+	D3D12_BLEND_OP_MIN = 4,
+	D3D12_BLEND_OP_MAX = 5,
+};
+
+enum D3D12_LOGIC_OP {
+	D3D12_LOGIC_OP_CLEAR = 0,
+	D3D12_LOGIC_OP_NOOP = 4,
+};
+
+enum D3D12_COLOR_WRITE_ENABLE {
+	D3D12_COLOR_WRITE_ENABLE_ALL = 15,
+};
+
+enum D3D12_DEPTH_WRITE_MASK {
+	D3D12_DEPTH_WRITE_MASK_ZERO = 0,
+	D3D12_DEPTH_WRITE_MASK_ALL = 1,
+};
+
+enum D3D12_STENCIL_OP {
+	D3D12_STENCIL_OP_KEEP = 1,
+	D3D12_STENCIL_OP_ZERO = 2,
+	D3D12_STENCIL_OP_REPLACE = 3,
+};
+
+struct D3D12_RENDER_TARGET_BLEND_DESC {
+	BOOL BlendEnable;
+	BOOL LogicOpEnable;
+	D3D12_BLEND SrcBlend;
+	D3D12_BLEND DestBlend;
+	D3D12_BLEND_OP BlendOp;
+	D3D12_BLEND SrcBlendAlpha;
+	D3D12_BLEND DestBlendAlpha;
+	D3D12_BLEND_OP BlendOpAlpha;
+	D3D12_LOGIC_OP LogicOp;
+	UINT8 RenderTargetWriteMask;
+};
+
+struct D3D12_BLEND_DESC {
+	BOOL AlphaToCoverageEnable;
+	BOOL IndependentBlendEnable;
+	D3D12_RENDER_TARGET_BLEND_DESC RenderTarget[8];
+};
+
+struct D3D12_RASTERIZER_DESC {
+	D3D12_FILL_MODE FillMode;
+	D3D12_CULL_MODE CullMode;
+	BOOL FrontCounterClockwise;
+	INT DepthBias;
+	FLOAT DepthBiasClamp;
+	FLOAT SlopeScaledDepthBias;
+	BOOL DepthClipEnable;
+	BOOL MultisampleEnable;
+	BOOL AntialiasedLineEnable;
+	UINT ForcedSampleCount;
+	D3D12_CONSERVATIVE_RASTERIZATION_MODE ConservativeRaster;
+};
+
+struct D3D12_DEPTH_STENCILOP_DESC {
+	D3D12_STENCIL_OP StencilFailOp;
+	D3D12_STENCIL_OP StencilDepthFailOp;
+	D3D12_STENCIL_OP StencilPassOp;
+	D3D12_COMPARISON_FUNC StencilFunc;
+};
+
+struct D3D12_DEPTH_STENCIL_DESC {
+	BOOL DepthEnable;
+	D3D12_DEPTH_WRITE_MASK DepthWriteMask;
+	D3D12_COMPARISON_FUNC DepthFunc;
+	BOOL StencilEnable;
+	UINT8 StencilReadMask;
+	UINT8 StencilWriteMask;
+	D3D12_DEPTH_STENCILOP_DESC FrontFace;
+	D3D12_DEPTH_STENCILOP_DESC BackFace;
+};
+
+struct D3D12_INPUT_ELEMENT_DESC {
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	DXGI_FORMAT Format;
+	UINT InputSlot;
+	UINT AlignedByteOffset;
+	D3D12_INPUT_CLASSIFICATION InputSlotClass;
+	UINT InstanceDataStepRate;
+};
+
+// コマンドリストに渡す型（GraphicsStateCache・RenderCommandListが参照する）
+typedef uint64_t D3D12_GPU_VIRTUAL_ADDRESS;
+
+struct ID3D12RootSignature;
+struct ID3D12PipelineState;
+
+enum D3D_PRIMITIVE_TOPOLOGY {
+	D3D_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+	D3D_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+	D3D_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+	D3D_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+	D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+	D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
+typedef D3D_PRIMITIVE_TOPOLOGY D3D12_PRIMITIVE_TOPOLOGY;
+
+struct D3D12_GPU_DESCRIPTOR_HANDLE {
+	uint64_t ptr;
+};
+
+struct D3D12_VERTEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+
+struct D3D12_INDEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
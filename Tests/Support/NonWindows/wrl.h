@@ -0,0 +1,2 @@
+#pragma once
+// Windows以外でテストをビルドするための空のwrl.h（テストするコードはComPtrを使わない）
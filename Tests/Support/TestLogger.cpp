@@ -0,0 +1,22 @@
+#include "BaseSystem/Logger/Logger.h"
+#include <iostream>
+
+// テストではファイルやデバッガに出さず、標準エラーに出す（Logger.cppはWindowsに依存するのでこちらをリンクする）
+std::ofstream Logger::logFileStream_;
+std::mutex Logger::mutex_;
+bool Logger::isEnabled_ = false;
+
+void Logger::Initalize() {}
+
+void Logger::Finalize() {}
+
+void Logger::Log(const std::string& message) {
+	if (isEnabled_) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::cerr << message;
+	}
+}
+
+void Logger::Log(std::ostream&, const std::string& message) {
+	Log(message);
+}
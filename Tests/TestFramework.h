@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// GPUを使わない部分の単体テストの小さな枠組み（外部のライブラリに依存しない）
+/// TEST_CASEで登録し、CHECKが失敗したものを数える。テストの実行ファイルごとにTestMain.cppをリンクする
+/// </summary>
+class TestRegistry {
+public:
+	struct TestCase {
+		const char* name;
+		std::function<void()> function;
+	};
+
+	static TestRegistry& GetInstance() {
+		static TestRegistry instance;
+		return instance;
+	}
+
+	void Add(const char* name, std::function<void()> function) { testCases_.push_back({ name, std::move(function) }); }
+
+	/// <summary>
+	/// 失敗を記録する（CHECKから呼ぶ）
+	/// </summary>
+	void Fail(const char* file, int line, const std::string& message) {
+		++failureCount_;
+		std::fprintf(stderr, "%s(%d): FAILED: %s\n", file, line, message.c_str());
+	}
+
+	/// <summary>
+	/// 登録した全てのテストを実行
+	/// </summary>
+	/// <returns>失敗したCHECKの数</returns>
+	int RunAll() {
+		for (const TestCase& testCase : testCases_) {
+			const int failureCountBefore = failureCount_;
+			testCase.function();
+			std::printf("[%s] %s\n", failureCount_ == failureCountBefore ? "  OK  " : "FAILED", testCase.name);
+		}
+		std::printf("%zu tests, %d failures\n", testCases_.size(), failureCount_);
+		return failureCount_;
+	}
+
+private:
+	TestRegistry() = default;
+
+	std::vector<TestCase> testCases_;
+	int failureCount_ = 0;
+};
+
+/// <summary>
+/// テストを静的に登録する
+/// </summary>
+struct TestRegistrar {
+	TestRegistrar(const char* name, std::function<void()> function) { TestRegistry::GetInstance().Add(name, std::move(function)); }
+};
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+// テストを定義する（TEST_CASE(AtlasPacker_NoOverlap) { ... }）
+#define TEST_CASE(name) \
+	static void name(); \
+	static TestRegistrar TEST_CONCAT(name, _registrar)(#name, &name); \
+	static void name()
+
+// 条件が偽なら失敗を記録して続ける
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			TestRegistry::GetInstance().Fail(__FILE__, __LINE__, #condition); \
+		} \
+	} while (false)
+
+// 2つの値が等しくなければ失敗を記録して続ける（値は整数か浮動小数点数）
+#define CHECK_EQ(actual, expected) \
+	do { \
+		const auto actualValue = (actual); \
+		const auto expectedValue = (expected); \
+		if (!(actualValue == expectedValue)) { \
+			TestRegistry::GetInstance().Fail(__FILE__, __LINE__, \
+				std::string(#actual " == " #expected " (actual ") + std::to_string(actualValue) + \
+				", expected " + std::to_string(expectedValue) + ")"); \
+		} \
+	} while (false)
@@ -0,0 +1,5 @@
+#include "TestFramework.h"
+
+int main() {
+	return TestRegistry::GetInstance().RunAll() == 0 ? 0 : 1;
+}
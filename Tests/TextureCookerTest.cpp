@@ -0,0 +1,162 @@
+#include "TestFramework.h"
+#include "Managers/Texture/TextureCooker.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+using Format = BlockCompressor::Format;
+
+/// <summary>
+/// テスト用の書き出し先のフォルダ（テストごとに作り直す）
+/// </summary>
+class CookDirectory {
+public:
+	CookDirectory() {
+		root_ = std::filesystem::temp_directory_path() / "CG2_2025_TextureCookerTest";
+		std::filesystem::remove_all(root_);
+		std::filesystem::create_directories(root_);
+	}
+
+	~CookDirectory() {
+		std::error_code errorCode;
+		std::filesystem::remove_all(root_, errorCode);
+	}
+
+	std::string GetPath(const std::string& name) const { return (root_ / name).generic_string(); }
+
+private:
+	std::filesystem::path root_;
+};
+
+/// <summary>
+/// 市松模様にグラデーションを重ねた画像
+/// </summary>
+std::vector<uint8_t> MakeImage(uint32_t width, uint32_t height) {
+	std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			uint8_t* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+			const uint8_t checker = ((x / 8 + y / 8) % 2) ? 64 : 0;
+			pixel[0] = static_cast<uint8_t>(x * 255 / width);
+			pixel[1] = static_cast<uint8_t>(y * 255 / height);
+			pixel[2] = static_cast<uint8_t>(128 + checker);
+			pixel[3] = 255;
+		}
+	}
+	return pixels;
+}
+
+/// <summary>
+/// ファイルを丸ごと読む
+/// </summary>
+std::vector<uint8_t> ReadAll(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// <summary>
+/// ファイルの先頭からindex番目の32bitの値を読む
+/// </summary>
+uint32_t ReadWord(const std::vector<uint8_t>& data, size_t index) {
+	uint32_t value = 0;
+	std::memcpy(&value, data.data() + index * 4, 4);
+	return value;
+}
+
+} // namespace
+
+TEST_CASE(TextureCooker_WritesDDSHeaderAndMipChain) {
+	CookDirectory directory;
+	const uint32_t width = 64;
+	const uint32_t height = 32;
+	const std::vector<uint8_t> pixels = MakeImage(width, height);
+	const TextureCooker::SourceImage source{ pixels.data(), width, height, width * 4 };
+
+	for (Format format : { Format::BC1, Format::BC3, Format::BC5, Format::BC7 }) {
+		TextureCooker::Settings settings;
+		settings.format = format;
+		const std::string path = directory.GetPath(std::string("Cooked/") + TextureCooker::GetFormatName(format) + ".dds");
+		TextureCooker::Result result;
+		CHECK(TextureCooker::Cook(source, settings, path, result));
+		CHECK(result.isSucceeded);
+		CHECK(result.psnr >= 28.0);
+
+		// 64x32から1x1まで7段
+		CHECK_EQ(result.mipLevels, 7u);
+		size_t blocksSize = 0;
+		for (uint32_t level = 0; level < result.mipLevels; ++level) {
+			blocksSize += BlockCompressor::ComputeCompressedSize(format, (std::max)(width >> level, 1u), (std::max)(height >> level, 1u));
+		}
+
+		// マジック・ヘッダー・DX10の拡張ヘッダーの後に、全ての段のブロックが並ぶ
+		const std::vector<uint8_t> file = ReadAll(path);
+		const size_t headerSize = 4 + 124 + 20;
+		CHECK_EQ(file.size(), headerSize + blocksSize);
+		CHECK_EQ(result.cookedBytes, static_cast<uint64_t>(file.size()));
+		CHECK(file.size() >= headerSize);
+		CHECK_EQ(ReadWord(file, 0), 0x20534444u);		// "DDS "
+		CHECK_EQ(ReadWord(file, 1), 124u);
+		CHECK_EQ(ReadWord(file, 3), height);
+		CHECK_EQ(ReadWord(file, 4), width);
+		CHECK_EQ(ReadWord(file, 5), static_cast<uint32_t>(BlockCompressor::ComputeCompressedSize(format, width, height)));
+		CHECK_EQ(ReadWord(file, 7), result.mipLevels);
+		CHECK_EQ(ReadWord(file, 1 + 18), 32u);
+		CHECK_EQ(ReadWord(file, 1 + 19), 0x4u);			// FourCC
+		CHECK_EQ(ReadWord(file, 1 + 20), 0x30315844u);	// "DX10"
+		const size_t dx10Header = 1 + 124 / 4;
+		CHECK_EQ(ReadWord(file, dx10Header), TextureCooker::GetDXGIFormat(format, format != Format::BC5));
+		CHECK_EQ(ReadWord(file, dx10Header + 1), 3u);	// TEXTURE2D
+		CHECK_EQ(ReadWord(file, dx10Header + 3), 1u);	// arraySize
+
+		// 途中のファイルは残らない
+		CHECK(!std::filesystem::exists(path + ".tmp"));
+	}
+}
+
+TEST_CASE(TextureCooker_RejectsInvalidSource) {
+	CookDirectory directory;
+	const std::vector<uint8_t> pixels = MakeImage(6, 8);
+	TextureCooker::Result result;
+
+	// 4の倍数でない大きさと空の画像は書き出さない
+	const TextureCooker::SourceImage odd{ pixels.data(), 6, 8, 6 * 4 };
+	CHECK(!TextureCooker::Cook(odd, {}, directory.GetPath("Odd.dds"), result));
+	CHECK(!result.isSucceeded);
+	CHECK(!result.message.empty());
+	CHECK(!std::filesystem::exists(directory.GetPath("Odd.dds")));
+
+	const TextureCooker::SourceImage empty{};
+	CHECK(!TextureCooker::Cook(empty, {}, directory.GetPath("Empty.dds"), result));
+	CHECK(!std::filesystem::exists(directory.GetPath("Empty.dds")));
+}
+
+TEST_CASE(TextureCooker_CookedPathAndUpToDate) {
+	CHECK(TextureCooker::GetCookedPath("resources/uvChecker.png") == "resources/Cooked/uvChecker.dds");
+	CHECK(TextureCooker::GetDXGIFormat(Format::BC5, true) == TextureCooker::GetDXGIFormat(Format::BC5, false));
+
+	CookDirectory directory;
+	const std::string sourcePath = directory.GetPath("Source.png");
+	const std::string cookedPath = TextureCooker::GetCookedPath(sourcePath);
+
+	// クックしたファイルがなければ古い扱い
+	std::ofstream(sourcePath) << "png";
+	CHECK(!TextureCooker::IsCookedFileUpToDate(sourcePath, cookedPath));
+
+	// 元の画像より新しければそのまま使い、元の画像の方が新しければ作り直す
+	const std::vector<uint8_t> pixels = MakeImage(8, 8);
+	TextureCooker::Result result;
+	CHECK(TextureCooker::Cook({ pixels.data(), 8, 8, 8 * 4 }, {}, cookedPath, result));
+	const auto cookedTime = std::filesystem::last_write_time(cookedPath);
+	std::filesystem::last_write_time(sourcePath, cookedTime - std::chrono::seconds(10));
+	CHECK(TextureCooker::IsCookedFileUpToDate(sourcePath, cookedPath));
+	std::filesystem::last_write_time(sourcePath, cookedTime + std::chrono::seconds(10));
+	CHECK(!TextureCooker::IsCookedFileUpToDate(sourcePath, cookedPath));
+
+	// 元の画像がなければクックしたものを使う
+	std::filesystem::remove(sourcePath);
+	CHECK(TextureCooker::IsCookedFileUpToDate(sourcePath, cookedPath));
+}
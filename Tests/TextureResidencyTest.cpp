@@ -0,0 +1,156 @@
+#include "TestFramework.h"
+#include "Managers/Texture/TextureResidency.h"
+
+namespace {
+
+/// <summary>
+/// 正方形のRGBA8テクスチャのミップごとのバイト数
+/// </summary>
+std::vector<uint64_t> CreateMipSizes(uint32_t size) {
+	std::vector<uint64_t> mipSizes;
+	while (true) {
+		mipSizes.push_back(static_cast<uint64_t>(size) * size * 4);
+		if (size == 1) {
+			break;
+		}
+		size /= 2;
+	}
+	return mipSizes;
+}
+
+uint64_t Sum(const std::vector<uint64_t>& values) {
+	uint64_t sum = 0;
+	for (uint64_t value : values) {
+		sum += value;
+	}
+	return sum;
+}
+
+const uint32_t kTailMip = 4;	// 1024の末尾のミップ（64x64）
+
+} // namespace
+
+TEST_CASE(TextureResidency_TailMipClamping) {
+	// 長辺が64以下になる最初のミップ
+	CHECK_EQ(TextureResidency::ComputeTailMip(1024, 1024, 11, 64), 4u);
+	CHECK_EQ(TextureResidency::ComputeTailMip(1024, 256, 11, 64), 4u);
+	CHECK_EQ(TextureResidency::ComputeTailMip(65, 65, 7, 64), 1u);
+	// 元から小さいものは0（落とせない）
+	CHECK_EQ(TextureResidency::ComputeTailMip(64, 64, 7, 64), 0u);
+	CHECK_EQ(TextureResidency::ComputeTailMip(32, 32, 6, 64), 0u);
+	// ミップが足りなければ最後のミップまで
+	CHECK_EQ(TextureResidency::ComputeTailMip(1024, 1024, 3, 64), 2u);
+	CHECK_EQ(TextureResidency::ComputeTailMip(1024, 1024, 1, 64), 0u);
+
+	// 予算が0でも末尾のミップより粗くはしない
+	const std::vector<uint64_t> mipSizes = CreateMipSizes(1024);
+	TextureResidency residency;
+	residency.SetBudget(0);
+	const TextureResidency::Handle handle = residency.Register(1, mipSizes, kTailMip);
+	CHECK_EQ(residency.GetResidentMip(handle), kTailMip);
+	residency.Touch(handle, 1);
+	CHECK(residency.Update(2).empty());
+	CHECK_EQ(residency.GetResidentMip(handle), kTailMip);
+
+	// tailMipが0のものは予算を超えても全て常駐させる
+	const TextureResidency::Handle pinned = residency.Register(2, mipSizes, 0);
+	CHECK_EQ(residency.GetResidentMip(pinned), 0u);
+	CHECK(residency.Update(3).empty());
+	CHECK_EQ(residency.GetResidentBytes(), Sum(mipSizes) + Sum(std::vector<uint64_t>(mipSizes.begin() + kTailMip, mipSizes.end())));
+}
+
+TEST_CASE(TextureResidency_EvictsLeastRecentlyUsedFirst) {
+	const std::vector<uint64_t> mipSizes = CreateMipSizes(1024);
+	const uint64_t fullBytes = Sum(mipSizes);
+	TextureResidency residency;
+	// 全て常駐できるのは2枚まで
+	residency.SetBudget(fullBytes * 2 + 30000);
+	const TextureResidency::Handle a = residency.Register(1, mipSizes, kTailMip);
+	const TextureResidency::Handle b = residency.Register(2, mipSizes, kTailMip);
+	const TextureResidency::Handle c = residency.Register(3, mipSizes, kTailMip);
+	CHECK_EQ(residency.GetResidentMip(a), 0u);
+	CHECK_EQ(residency.GetResidentMip(b), 0u);
+	CHECK_EQ(residency.GetResidentMip(c), kTailMip);
+	CHECK(residency.GetResidentBytes() <= residency.GetBudget());
+
+	// cを使うと、一番長く使われていないb（一度も使われていない）を落としてcを読み込む
+	residency.Touch(a, 5);
+	residency.Touch(c, 9);
+	const std::vector<TextureResidency::Change>& changes = residency.Update(10);
+	CHECK_EQ(changes.size(), 2u);
+	CHECK_EQ(changes[0].key, 2u);
+	CHECK_EQ(changes[0].residentMip, kTailMip);
+	CHECK_EQ(changes[1].key, 3u);
+	CHECK_EQ(changes[1].residentMip, 0u);
+	CHECK(residency.GetResidentBytes() <= residency.GetBudget());
+
+	// 次はbを使うと、aとcのうち古いaが落ちる
+	residency.Touch(b, 20);
+	residency.Touch(c, 19);
+	const std::vector<TextureResidency::Change>& nextChanges = residency.Update(20);
+	CHECK_EQ(nextChanges.size(), 2u);
+	CHECK_EQ(nextChanges[0].key, 1u);
+	CHECK_EQ(nextChanges[0].residentMip, kTailMip);
+	CHECK_EQ(nextChanges[1].key, 2u);
+	CHECK_EQ(residency.GetResidentMip(c), 0u);
+
+	const TextureResidency::Statistics statistics = residency.GetStatistics();
+	CHECK_EQ(statistics.textureCount, 3u);
+	CHECK_EQ(statistics.reducedCount, 1u);
+	CHECK_EQ(statistics.streamedInCount, 1u);
+	CHECK_EQ(statistics.evictedCount, 1u);
+
+	residency.Unregister(a);
+	residency.Unregister(b);
+	residency.Unregister(c);
+	CHECK_EQ(residency.GetResidentBytes(), 0u);
+}
+
+TEST_CASE(TextureResidency_BudgetOverflow) {
+	const std::vector<uint64_t> mipSizes = CreateMipSizes(1024);
+	const uint64_t fullBytes = Sum(mipSizes);
+	TextureResidency residency;
+	const TextureResidency::Handle a = residency.Register(1, mipSizes, kTailMip);
+	const TextureResidency::Handle c = residency.Register(3, mipSizes, kTailMip);
+	CHECK_EQ(residency.GetResidentBytes(), fullBytes * 2);
+
+	// 予算を縮めると、使っていないものは全て末尾のミップに落ちる
+	residency.SetBudget(fullBytes / 2);
+	CHECK_EQ(residency.Update(100).size(), 2u);
+	CHECK_EQ(residency.GetResidentMip(a), kTailMip);
+	CHECK_EQ(residency.GetResidentMip(c), kTailMip);
+
+	// 使っているものは、落とせるものを落としても全ては入らないので、入る中で一番詳細なミップにする
+	residency.Touch(a, 100);
+	const std::vector<TextureResidency::Change>& changes = residency.Update(101);
+	CHECK_EQ(changes.size(), 1u);
+	CHECK_EQ(changes[0].key, 1u);
+	CHECK_EQ(changes[0].residentMip, 1u);
+	CHECK(residency.GetResidentBytes() <= residency.GetBudget());
+
+	// 作り直しに失敗したら呼び出し側が戻す
+	residency.SetResidentMip(a, kTailMip);
+	CHECK_EQ(residency.GetResidentMip(a), kTailMip);
+	CHECK_EQ(residency.GetStatistics().reducedCount, 2u);
+}
+
+TEST_CASE(TextureResidency_StreamInIsRateLimited) {
+	const std::vector<uint64_t> mipSizes = CreateMipSizes(1024);
+	TextureResidency residency;
+	residency.SetBudget(0);
+	std::vector<TextureResidency::Handle> handles;
+	for (uint64_t key = 0; key < 5; ++key) {
+		handles.push_back(residency.Register(key, mipSizes, kTailMip));
+	}
+
+	// 予算が空いても、1回のUpdateで読み込むのは既定の2枚まで
+	residency.SetBudget(UINT64_MAX);
+	for (const TextureResidency::Handle& handle : handles) {
+		residency.Touch(handle, 7);
+	}
+	CHECK_EQ(residency.Update(8).size(), 2u);
+	CHECK_EQ(residency.Update(8).size(), 2u);
+	CHECK_EQ(residency.Update(8).size(), 1u);
+	CHECK(residency.Update(8).empty());
+	CHECK_EQ(residency.GetStatistics().reducedCount, 0u);
+}
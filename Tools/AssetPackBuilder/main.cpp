@@ -0,0 +1,200 @@
+///*-----------------------------------------------------------------------*///
+//	アーカイブ（.pak）を作るコマンドラインツール（エンジンのプロジェクトには含めない）
+//
+//	使い方：AssetPackBuilder <出力.pak> <フォルダ|ファイル>... [--align <バイト数>] [--compress fast|high] [--block <KB>]
+//		例）AssetPackBuilder resources.pak resources --compress fast
+//	速度の計測：AssetPackBuilder --benchmark <フォルダ|ファイル>... [--block <KB>]
+//		各ファイルをFast/Highで圧縮し、圧縮・展開（1スレッドとブロック並列）の速度と圧縮率を表示する
+//	ビルド：Engine/BaseSystem/FileSystem/AssetPackBuilder.cppと一緒にC++20でビルドする
+//		g++ -std=c++20 -O2 -IEngine Tools/AssetPackBuilder/main.cpp Engine/BaseSystem/FileSystem/AssetPackBuilder.cpp
+//			Engine/BaseSystem/FileSystem/AssetPack.cpp Engine/BaseSystem/FileSystem/MappedFile.cpp
+//			Engine/BaseSystem/FileSystem/LZCompressor.cpp -lpthread -o AssetPackBuilder
+///*-----------------------------------------------------------------------*///
+#include "BaseSystem/FileSystem/AssetPackBuilder.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+	/// <summary>
+	/// [0, count)をハードウェアのスレッド数で並列に処理する（エンジンのThreadPoolの代わり）
+	/// </summary>
+	void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function) {
+		std::atomic<uint32_t> nextIndex = 0;
+		auto work = [&]() {
+			for (uint32_t i = nextIndex++; i < count; i = nextIndex++) {
+				function(i);
+			}
+		};
+		const uint32_t threadCount = (std::min)((std::max)(std::thread::hardware_concurrency(), 1u), count);
+		std::vector<std::thread> threads;
+		for (uint32_t i = 1; i < threadCount; ++i) {
+			threads.emplace_back(work);
+		}
+		work();
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	}
+
+	double GetMegaBytesPerSecond(uint64_t bytes, double seconds) {
+		return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+	}
+
+	/// <summary>
+	/// 圧縮・展開の速度と圧縮率を計る
+	/// </summary>
+	int RunBenchmark(const std::vector<std::string>& paths, uint32_t blockSize) {
+		using Clock = std::chrono::steady_clock;
+		const int kRepeatCount = 5;
+
+		// 先に全て読んでおく（ディスクの速さを含めない）
+		std::vector<std::vector<uint8_t>> files;
+		uint64_t totalBytes = 0;
+		for (const std::string& path : paths) {
+			std::ifstream input(path, std::ios::binary);
+			files.emplace_back(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+			totalBytes += files.back().size();
+		}
+		std::printf("%zu files, %.2f MB, block %u KB, %u threads\n", files.size(), static_cast<double>(totalBytes) / (1024.0 * 1024.0),
+			blockSize / 1024, (std::max)(std::thread::hardware_concurrency(), 1u));
+
+		for (LZCompressor::Level level : { LZCompressor::Level::Fast, LZCompressor::Level::High }) {
+			uint64_t compressedBytes = 0;
+			double compressSeconds = 0.0;
+			double decompressSeconds = 0.0;
+			double parallelDecompressSeconds = 0.0;
+			std::vector<uint8_t> frame;
+			std::vector<uint8_t> decompressed;
+			for (const std::vector<uint8_t>& file : files) {
+				const auto compressStart = Clock::now();
+				LZCompressor::Compress(file.data(), file.size(), level, blockSize, frame);
+				compressSeconds += std::chrono::duration<double>(Clock::now() - compressStart).count();
+				compressedBytes += frame.size();
+
+				decompressed.assign(file.size(), 0);
+				for (int parallel = 0; parallel < 2; ++parallel) {
+					const auto decompressStart = Clock::now();
+					for (int repeat = 0; repeat < kRepeatCount; ++repeat) {
+						if (!LZCompressor::Decompress(frame.data(), frame.size(), decompressed.data(), decompressed.size(),
+							parallel ? LZCompressor::ParallelFor(ParallelFor) : nullptr)) {
+							std::fprintf(stderr, "decompression failed\n");
+							return 1;
+						}
+					}
+					const double seconds = std::chrono::duration<double>(Clock::now() - decompressStart).count() / kRepeatCount;
+					(parallel ? parallelDecompressSeconds : decompressSeconds) += seconds;
+				}
+				if (decompressed != file) {
+					std::fprintf(stderr, "round trip mismatch\n");
+					return 1;
+				}
+			}
+			std::printf("%s: ratio %.1f%%, compress %.1f MB/s, decompress %.1f MB/s (1 thread) / %.1f MB/s (parallel blocks)\n",
+				LZCompressor::GetLevelName(level),
+				totalBytes > 0 ? 100.0 * static_cast<double>(compressedBytes) / static_cast<double>(totalBytes) : 0.0,
+				GetMegaBytesPerSecond(totalBytes, compressSeconds),
+				GetMegaBytesPerSecond(totalBytes, decompressSeconds),
+				GetMegaBytesPerSecond(totalBytes, parallelDecompressSeconds));
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::fprintf(stderr, "usage: %s <output.pak> <directory|file>... [--align <bytes>] [--compress fast|high] [--block <KB>]\n", argv[0]);
+		std::fprintf(stderr, "       %s --benchmark <directory|file>... [--block <KB>]\n", argv[0]);
+		return 1;
+	}
+
+	const bool isBenchmark = std::strcmp(argv[1], "--benchmark") == 0;
+	const std::string outputPath = argv[1];
+	AssetPackBuilder builder;
+	AssetPackBuilder::Settings settings;
+	settings.parallelFor = ParallelFor;
+	std::vector<std::string> benchmarkPaths;
+	for (int i = 2; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--align") == 0 && i + 1 < argc) {
+			settings.alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			continue;
+		}
+		if (std::strcmp(argv[i], "--compress") == 0 && i + 1 < argc) {
+			++i;
+			settings.compression = AssetPack::Compression::LZ;
+			settings.level = std::strcmp(argv[i], "high") == 0 ? LZCompressor::Level::High : LZCompressor::Level::Fast;
+			continue;
+		}
+		if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+			settings.blockSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)) * 1024;
+			continue;
+		}
+
+		if (isBenchmark) {
+			std::error_code errorCode;
+			if (std::filesystem::is_directory(argv[i], errorCode)) {
+				for (std::filesystem::recursive_directory_iterator it(argv[i], errorCode), end; !errorCode && it != end; it.increment(errorCode)) {
+					if (it->is_regular_file(errorCode)) {
+						benchmarkPaths.push_back(it->path().generic_string());
+					}
+				}
+			} else {
+				benchmarkPaths.push_back(argv[i]);
+			}
+			continue;
+		}
+
+		std::error_code errorCode;
+		if (std::filesystem::is_directory(argv[i], errorCode)) {
+			const uint32_t count = builder.AddDirectory(argv[i]);
+			std::printf("%s: %u files\n", argv[i], count);
+		} else if (std::filesystem::is_regular_file(argv[i], errorCode)) {
+			builder.AddFile(argv[i], argv[i]);
+		} else {
+			std::fprintf(stderr, "not found: %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (isBenchmark) {
+		return RunBenchmark(benchmarkPaths, std::clamp(settings.blockSize, LZCompressor::kMinBlockSize, LZCompressor::kMaxBlockSize));
+	}
+
+	AssetPackBuilder::Result result;
+	if (!builder.Build(outputPath, settings, result)) {
+		std::fprintf(stderr, "failed: %s\n", result.message.c_str());
+		return 1;
+	}
+
+	// 作ったものを開き直して、全ての項目が引けて、圧縮したものは元に戻せることを確かめる
+	AssetPack pack;
+	std::string message;
+	if (!pack.Open(outputPath, message)) {
+		std::fprintf(stderr, "verification failed: %s\n", message.c_str());
+		return 1;
+	}
+	for (uint32_t i = 0; i < pack.GetEntryCount(); ++i) {
+		const AssetPack::Entry& entry = pack.GetEntries()[i];
+		if (pack.Find(pack.GetPath(entry)) != &entry) {
+			std::fprintf(stderr, "verification failed: %.*s\n", static_cast<int>(entry.pathLength), pack.GetPath(entry).data());
+			return 1;
+		}
+		if (entry.compression == static_cast<uint32_t>(AssetPack::Compression::LZ)) {
+			std::vector<uint8_t> decompressed(static_cast<size_t>(entry.size));
+			if (!LZCompressor::Decompress(pack.GetStoredData(entry), static_cast<size_t>(entry.storedSize), decompressed.data(), decompressed.size(), ParallelFor)) {
+				std::fprintf(stderr, "verification failed (decompress): %.*s\n", static_cast<int>(entry.pathLength), pack.GetPath(entry).data());
+				return 1;
+			}
+		}
+	}
+
+	std::printf("%s: %u files (%u compressed), %llu KB -> %llu KB (align %u)\n", outputPath.c_str(), result.fileCount, result.compressedFileCount,
+		static_cast<unsigned long long>(result.sourceBytes / 1024), static_cast<unsigned long long>(result.packBytes / 1024), settings.alignment);
+	return 0;
+}
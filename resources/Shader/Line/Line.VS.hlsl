@@ -10,10 +10,8 @@ ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
 
 struct VertexShaderInput
 {
-    float32_t4 position : POSITION0;
-    float32_t4 color : COLOR0; // 頂点色を追加
-    float32_t2 texcoord : TEXCOORD0; // 使用しないが構造体の互換性のため
-    float32_t3 normal : NORMAL0; // 使用しないが構造体の互換性のため
+    float32_t3 position : POSITION0;
+    float32_t4 color : COLOR0; // 頂点色（R8G8B8A8_UNORMで0～1になって届く）
 };
 
 VertexShaderOutput main(VertexShaderInput input)
@@ -21,7 +19,7 @@ VertexShaderOutput main(VertexShaderInput input)
     VertexShaderOutput output;
     
     // 位置変換
-    output.position = mul(input.position, gTransformationMatrix.WVP);
+    output.position = mul(float32_t4(input.position, 1.0f), gTransformationMatrix.WVP);
     
     // 頂点色をPixel Shaderに渡す
     output.color = input.color;
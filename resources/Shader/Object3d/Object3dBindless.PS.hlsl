@@ -0,0 +1,83 @@
+#include "resources/Shader/Object3d/Object3d.hlsli"
+
+// SRVヒープの持ち続ける範囲の数（GraphicsConfig::kSRVHeapSizeをDirectXCommon::CompileShaderが-Dで渡す）
+#ifndef SRV_HEAP_SIZE
+#error SRV_HEAP_SIZE is not defined
+#endif
+static const uint32_t kTextureCount = SRV_HEAP_SIZE;
+
+struct Material
+{
+    float32_t4 color; //色
+    int32_t enableLighting; //ライティングするか否か
+    int32_t useLambertianReflectance; //ランバート反射を利用するかどうか
+    uint32_t textureIndex; //SRVヒープ内のテクスチャの番号
+    uint32_t padding;
+    float32_t4x4 uvTransform; //uvTransform
+};
+//全てのマテリアル（描画ごとにgDrawConstants.materialIndexで選ぶ）
+StructuredBuffer<Material> gMaterials : register(t0, space1);
+
+struct DrawConstants
+{
+    uint32_t materialIndex; //このドローのマテリアルの番号
+};
+ConstantBuffer<DrawConstants> gDrawConstants : register(b2);
+
+struct DirectionalLight
+{
+    float32_t4 color; //色
+    float32_t3 direction; //方向
+    float32_t intensity; //強度
+};
+ConstantBuffer<DirectionalLight> gDirectionalLight : register(b1);
+
+Texture2D<float32_t4> gTextures[kTextureCount] : register(t0); //SRVヒープ全体
+SamplerState gSampler : register(s0); //Samplerはs
+
+struct PixelShaderOutput
+{
+    float32_t4 color : SV_TARGET0;
+};
+
+PixelShaderOutput main(VertexShaderOutput input)
+{
+    PixelShaderOutput output;
+
+    //番号はドロー内で共通なのでNonUniformResourceIndexは不要
+    Material material = gMaterials[gDrawConstants.materialIndex];
+
+    //UV座標を変換する
+    float4 transformedUV = mul(float32_t4(input.texcoord, 0.0f, 1.0f), material.uvTransform);
+    float32_t4 textureColor = gTextures[material.textureIndex].Sample(gSampler, transformedUV.xy);
+
+    if (material.enableLighting != 0)//Lightingする場合
+    {
+        float cos = 0;
+
+        //ランバート反射を使うかどうか
+        if (material.useLambertianReflectance != 0)
+        {
+            cos = saturate(dot(normalize(input.normal), -gDirectionalLight.direction));
+        }
+        else
+        {
+            float NdotL = dot(normalize(input.normal), -gDirectionalLight.direction);
+            cos = pow(NdotL * 0.5 + 0.5f, 2.0f);
+        }
+        output.color.rgb = material.color.rgb * textureColor.rgb * gDirectionalLight.color.rgb * cos * gDirectionalLight.intensity;
+    }
+    else
+    { ////Lightingしない場合
+        output.color.rgb = material.color.rgb * textureColor.rgb;
+    }
+
+    output.color.a = material.color.a; // アルファはマテリアルの値をそのまま使用
+
+    //output.colorのa値が0のときPixelを破棄(空白で塗りつぶされないように)
+    if (output.color.a == 0.0)
+    {
+        discard;
+    }
+    return output;
+}
@@ -0,0 +1,20 @@
+#include "resources/Shader/SpriteBatch/SpriteBatch.hlsli"
+
+Texture2D<float32_t4> gTexture : register(t0); //SRVのregisterはt
+
+SamplerState gSampler : register(s0); //Samplerはs
+
+struct PixelShaderOutput
+{
+    float32_t4 color : SV_TARGET0;
+};
+
+PixelShaderOutput main(VertexShaderOutput input)
+{
+    PixelShaderOutput output;
+
+    float32_t4 textureColor = gTexture.Sample(gSampler, input.texcoord);
+    output.color = input.color * textureColor;
+
+    return output;
+}
@@ -0,0 +1,18 @@
+#include "resources/Shader/SpriteBatch/SpriteBatch.hlsli"
+
+//頂点はCPU側でWVPとUV変換を済ませてあるのでそのまま渡す
+struct VertexShaderInput
+{
+    float32_t4 position : POSITION0;
+    float32_t2 texcoord : TEXCOORD0;
+    float32_t4 color : COLOR0;
+};
+
+VertexShaderOutput main(VertexShaderInput input)
+{
+    VertexShaderOutput output;
+    output.position = input.position;
+    output.texcoord = input.texcoord;
+    output.color = input.color;
+    return output;
+}